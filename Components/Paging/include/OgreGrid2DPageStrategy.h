@@ -31,6 +31,7 @@ THE SOFTWARE.
 
 #include "OgrePagingPrerequisites.h"
 #include "OgrePageStrategy.h"
+#include "OgrePagePrefetchPredictor.h"
 #include "OgreVector2.h"
 #include "OgreVector3.h"
 #include "OgreQuaternion.h"
@@ -138,6 +139,8 @@ namespace Ogre
         int32 mMinCellY;
         int32 mMaxCellX;
         int32 mMaxCellY;
+        /// Predictive prefetching settings and state (not saved)
+        PagePrefetchPredictor mPrefetchPredictor;
 
         void updateDerivedMetrics();
 
@@ -194,6 +197,12 @@ namespace Ogre
         /// get the index range of all cells (values outside this will be ignored)
         virtual int32 getCellRangeMaxY() const { return mMaxCellY; }
 
+        /** Get the predictor used to prefetch pages ahead of the camera.
+        @remarks
+            Prefetching is disabled until a lookahead time is set on it.
+        */
+        virtual PagePrefetchPredictor& getPrefetchPredictor() { return mPrefetchPredictor; }
+
         /// Load this data from a stream (returns true if successful)
         bool load(StreamSerialiser& stream);
         /// Save this data to a stream
@@ -236,11 +245,15 @@ namespace Ogre
         ~Grid2DPageStrategy();
 
         // Overridden members
+        void frameStart(Real timeSinceLastFrame, PagedWorldSection* section);
         void notifyCamera(Camera* cam, PagedWorldSection* section);
         PageStrategyData* createData();
         void destroyData(PageStrategyData* d);
         void updateDebugDisplay(Page* p, SceneNode* sn);
         PageID getPageID(const Vector3& worldPos, PagedWorldSection* section);
+    protected:
+        /// Request pages around the predicted future positions of a camera
+        void prefetchPages(Camera* cam, PagedWorldSection* section, Grid2DPageStrategyData* stratData);
     };
 
     /** @} */
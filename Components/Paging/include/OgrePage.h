@@ -58,6 +58,10 @@ namespace Ogre
 		uint16 mWorkQueueChannel;
 		bool mDeferredProcessInProgress;
 		bool mModified;
+		/// Whether this page holds one of the PageManager's background prepare slots
+		bool mPrepareSlotHeld;
+		/// Whether the current load was requested synchronously
+		bool mSynchronousLoad;
 
 		SceneNode* mDebugNode;
 		void updateDebugDisplay();
@@ -85,11 +89,15 @@ namespace Ogre
 			PageResponse() : pageData(0) {}
 		};
 
+		/// Data prepared in the background, waiting for its turn to be loaded
+		PageData* mPreparedData;
 
 
 		virtual bool prepareImpl(PageData* dataToPopulate);
 		virtual bool prepareImpl(StreamSerialiser& str, PageData* dataToPopulate);
 		virtual void loadImpl();
+		/// Destroy the content collections held by some prepared page data
+		void destroyPreparedData(PageData* data);
 
 		String generateFilename() const;
 
@@ -129,6 +137,20 @@ namespace Ogre
 		*/
 		virtual void unload();
 
+		/** Issue the background prepare request for this page.
+		@remarks
+			You should not call this method directly; it is called either from
+			load() or by the PageManager once a prepare slot becomes free.
+		*/
+		void _dispatchPrepare();
+		/** Perform the main-thread load of data previously prepared in the background.
+		@remarks
+			You should not call this method directly; it is called either on 
+			receipt of the background response or by the PageManager once the 
+			per-frame load budget allows it.
+		*/
+		void _finaliseLoad();
+
 
 		/** Returns whether this page was 'held' in the last frame, that is
 			was it either directly needed, or requested to stay in memory (held - as
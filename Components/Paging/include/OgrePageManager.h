@@ -433,6 +433,70 @@ namespace Ogre
 		/** Get whether paging operations are currently allowed to happen. */
 		bool getPagingOperationsEnabled() const { return mPagingEnabled; }
 
+		/** Set the maximum number of pages which may be preparing in the 
+			background at any one time.
+		@remarks
+			Page loading is a pipeline: the prepare stage (I/O, decompression
+			and CPU-side building) runs through the WorkQueue, and the load 
+			stage (GPU resource creation) runs in the main thread. When the 
+			camera moves quickly, a large number of pages can be requested
+			at once; limiting the number in flight means that further pages 
+			are queued here and only dispatched as earlier ones complete,
+			and any queued page that goes out of range before its turn is 
+			dropped without ever being read. 
+		@param maxPrepares The maximum number of concurrent prepares, or 0 for 
+			no limit (the default). Synchronous loads are never held back.
+		*/
+		void setMaxConcurrentPagePrepares(size_t maxPrepares) { mMaxConcurrentPrepares = maxPrepares; }
+		/** Get the maximum number of pages which may be preparing in the background at once. */
+		size_t getMaxConcurrentPagePrepares() const { return mMaxConcurrentPrepares; }
+
+		/** Set the maximum number of prepared pages which may be loaded in the
+			main thread each frame.
+		@remarks
+			Pages which have finished preparing beyond this budget wait in a 
+			queue and are loaded in subsequent frames, spreading GPU upload
+			cost over several frames rather than hitching on one.
+		@param maxLoads The maximum number of page loads per frame, or 0 for 
+			no limit (the default). 
+		*/
+		void setMaxPageLoadsPerFrame(size_t maxLoads) { mMaxLoadsPerFrame = maxLoads; }
+		/** Get the maximum number of prepared pages which may be loaded each frame. */
+		size_t getMaxPageLoadsPerFrame() const { return mMaxLoadsPerFrame; }
+
+		/// Get the number of pages currently preparing in the background
+		size_t getPagePreparesInProgress() const { return mPreparesInProgress; }
+		/// Get the number of pages waiting for a background prepare slot
+		size_t getPendingPagePrepareCount() const { return mPendingPrepareQueue.size(); }
+		/// Get the number of prepared pages waiting to be loaded in the main thread
+		size_t getPendingPageLoadCount() const { return mPendingLoadQueue.size(); }
+
+		/** Ask permission to start preparing a page in the background.
+		@remarks
+			You should not call this method directly. If false is returned the
+			page has been queued and will be dispatched later. Queued pages are
+			dispatched strictly in request order, so a page is also queued while
+			earlier ones are still waiting, even if a slot is free.
+		*/
+		bool _requestPagePrepare(Page* page);
+		/** Notify the manager that a page has finished its background prepare. 
+		@remarks
+			You should not call this method directly.
+		*/
+		void _notifyPagePrepareComplete(Page* page);
+		/** Ask permission to load a prepared page in the main thread this frame.
+		@remarks
+			You should not call this method directly. If false is returned the
+			page has been queued and will be loaded in a later frame, after any
+			pages queued before it.
+		*/
+		bool _requestPageFinalise(Page* page);
+		/** Remove any queued work for a page which is being destroyed. 
+		@remarks
+			You should not call this method directly.
+		*/
+		void _cancelPageRequests(Page* page);
+
 
 	protected:
 
@@ -454,6 +518,8 @@ namespace Ogre
 
 		void createStandardStrategies();
 		void createStandardContentFactories();
+		/// Dispatch queued page work within the configured limits, called at frame start
+		void processPageQueues();
 
 		WorldMap mWorlds;
 		StrategyMap mStrategies;
@@ -468,6 +534,14 @@ namespace Ogre
 		uint8 mDebugDisplayLvl;
 		bool mPagingEnabled;
 
+		typedef deque<Page*>::type PageQueue;
+		PageQueue mPendingPrepareQueue;
+		PageQueue mPendingLoadQueue;
+		size_t mMaxConcurrentPrepares;
+		size_t mMaxLoadsPerFrame;
+		size_t mPreparesInProgress;
+		size_t mLoadsThisFrame;
+
 		Grid2DPageStrategy* mGrid2DPageStrategy;
 		Grid3DPageStrategy* mGrid3DPageStrategy;
 		SimplePageContentCollectionFactory* mSimpleCollectionFactory;
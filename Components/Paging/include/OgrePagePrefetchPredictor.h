@@ -0,0 +1,185 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#ifndef __Ogre_PagePrefetchPredictor_H__
+#define __Ogre_PagePrefetchPredictor_H__
+
+#include "OgrePagingPrerequisites.h"
+#include "OgreVector3.h"
+
+
+namespace Ogre
+{
+	/** \addtogroup Optional Components
+	*  @{
+	*/
+	/** \addtogroup Paging
+	*  Some details on paging component
+	*  @{
+	*/
+
+	/** Predicts where tracked cameras will be in the near future, so that
+		a PageStrategy can request pages before they are actually in range.
+	@remarks
+		The prediction is built from the velocity of each camera, measured 
+		between successive notifications, extrapolated over a lookahead time.
+		If the application knows the route a camera will take (for example a 
+		vehicle following a road), it can supply waypoints for that camera 
+		instead, in which case the predicted path follows those waypoints for 
+		the same distance that the current speed would cover over the lookahead time.
+	@par
+		Prediction is disabled by default (lookahead time of 0).
+	*/
+	class _OgrePagingExport PagePrefetchPredictor : public PageAlloc
+	{
+	public:
+		typedef vector<Vector3>::type PositionList;
+		typedef vector<PageID>::type PageIDList;
+
+		/** Supplies the pages within the load range of a world position.
+		@remarks
+			Implemented by each PageStrategy so that the predictor can request
+			pages without knowing how the strategy divides up space.
+		*/
+		class PageRange
+		{
+		public:
+			virtual ~PageRange() {}
+			/// Append the IDs of the pages within load range of a world position
+			virtual void getPagesInLoadRange(const Vector3& worldPos, PageIDList& outPages) = 0;
+		};
+
+		PagePrefetchPredictor();
+		~PagePrefetchPredictor();
+
+		/** Set how far into the future, in seconds, camera motion is predicted. 
+		@remarks
+			A value of 0 disables prefetching.
+		*/
+		void setLookaheadTime(Real seconds) { mLookaheadTime = seconds; }
+		/// Get how far into the future, in seconds, camera motion is predicted
+		Real getLookaheadTime() const { return mLookaheadTime; }
+		/// Returns whether prediction is enabled
+		bool isEnabled() const { return mLookaheadTime > 0; }
+
+		/** Set the maximum number of prefetched pages which may be loading at once.
+		@remarks
+			Only pages which were requested by prefetchPages, and which have not 
+			finished loading yet, count towards this limit. Pages inside the 
+			regular load radius are neither limited nor counted.
+		*/
+		void setMaxPrefetchRequests(size_t maxRequests) { mMaxPrefetchRequests = maxRequests; }
+		/// Get the maximum number of prefetched pages which may be loading at once
+		size_t getMaxPrefetchRequests() const { return mMaxPrefetchRequests; }
+
+		/** Add a world position that a camera is expected to pass through.
+		@remarks
+			Waypoints are followed in the order added, and are discarded once
+			the camera comes within the spacing used to sample the path. Other
+			cameras are not affected.
+		*/
+		void addWaypoint(const Camera* cam, const Vector3& worldPos);
+		/// Remove all waypoints of a camera, reverting to velocity extrapolation
+		void clearWaypoints(const Camera* cam);
+		/// Get the current list of waypoints of a camera
+		const PositionList& getWaypoints(const Camera* cam) const;
+
+		/// Stop tracking a camera, for example because it is about to be destroyed
+		void removeCamera(const Camera* cam);
+
+		/// Advance the internal clock used to measure camera velocity
+		void advanceTime(Real timeSinceLastFrame) { mTime += timeSinceLastFrame; }
+
+		/** Update the motion of a camera from its current position.
+		@param cam The camera; only used as a key.
+		@param worldPos The current derived position of the camera
+		*/
+		void updateCamera(const Camera* cam, const Vector3& worldPos);
+
+		/// Get the velocity last measured for a camera (world units per second)
+		Vector3 getVelocity(const Camera* cam) const;
+
+		/** Get a list of predicted future positions for a camera.
+		@param cam The camera, which must have been passed to updateCamera
+		@param spacing The maximum distance between successive positions
+		@param outPositions List to which positions are appended, nearest first.
+			The current position of the camera is not included.
+		*/
+		void getPredictedPath(const Camera* cam, Real spacing, PositionList& outPositions);
+
+		/** Update a camera and request the pages around its predicted path.
+		@remarks
+			Pages which already exist are held, missing pages are loaded nearest
+			first until getMaxPrefetchRequests prefetched pages are loading.
+		@param cam The camera to predict the motion of; only used as a key
+		@param worldPos The current derived position of the camera
+		@param section The section in which pages are requested
+		@param spacing The maximum distance between successive predicted positions
+		@param range Supplies the pages around each predicted position
+		*/
+		void prefetchPages(const Camera* cam, const Vector3& worldPos, PagedWorldSection* section, 
+			Real spacing, PageRange& range);
+
+		/// Get the number of prefetched pages which are still loading
+		size_t getPrefetchRequestsInProgress() const { return mPrefetchedPages.size(); }
+
+	protected:
+		struct CameraTrack
+		{
+			Vector3 lastPosition;
+			Vector3 velocity;
+			Real lastTime;
+			/// False until the position has been read once
+			bool tracked;
+			PositionList waypoints;
+
+			CameraTrack() : lastPosition(Vector3::ZERO), velocity(Vector3::ZERO), lastTime(0), tracked(false) {}
+		};
+		typedef map<const Camera*, CameraTrack>::type CameraTrackMap;
+		/// Pages requested by prefetchPages, with the instance created for them
+		typedef map<PageID, Page*>::type PrefetchedPageMap;
+
+		CameraTrackMap mCameraTracks;
+		PrefetchedPageMap mPrefetchedPages;
+		Real mLookaheadTime;
+		size_t mMaxPrefetchRequests;
+		Real mTime;
+
+		/// Forget prefetched pages which have finished loading or were destroyed
+		void updatePrefetchedPages(PagedWorldSection* section);
+
+		/// Append positions every 'spacing' along a segment, up to a remaining length
+		static void samplePath(const Vector3& from, const Vector3& to, Real spacing, 
+			Real& remaining, PositionList& outPositions);
+	};
+
+	/** @} */
+	/** @} */
+}
+
+#endif
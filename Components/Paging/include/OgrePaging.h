@@ -38,6 +38,7 @@ THE SOFTWARE.
 #include "OgrePagedWorld.h"
 #include "OgrePagedWorldSection.h"
 #include "OgrePageManager.h"
+#include "OgrePagePrefetchPredictor.h"
 #include "OgrePageStrategy.h"
 #include "OgreSimplePageContentCollection.h"
 
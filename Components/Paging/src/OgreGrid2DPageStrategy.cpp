@@ -278,6 +278,40 @@ namespace Ogre
 		ser.writeChunkEnd(CHUNK_ID);
 	}
 	//---------------------------------------------------------------------
+	namespace
+	{
+		/// Pages within the load radius of a position on a 2D grid
+		class Grid2DPrefetchRange : public PagePrefetchPredictor::PageRange
+		{
+		public:
+			Grid2DPrefetchRange(Grid2DPageStrategyData* stratData)
+				: mStratData(stratData)
+				, mRadius((int32)Math::Ceil(stratData->getLoadRadiusInCells()))
+			{
+			}
+
+			void getPagesInLoadRange(const Vector3& worldPos, PagePrefetchPredictor::PageIDList& outPages)
+			{
+				Vector2 gridpos;
+				mStratData->convertWorldToGridSpace(worldPos, gridpos);
+				int32 x, y;
+				mStratData->determineGridLocation(gridpos, &x, &y);
+
+				int32 xmin = std::max(x - mRadius, mStratData->getCellRangeMinX());
+				int32 xmax = std::min(x + mRadius, mStratData->getCellRangeMaxX());
+				int32 ymin = std::max(y - mRadius, mStratData->getCellRangeMinY());
+				int32 ymax = std::min(y + mRadius, mStratData->getCellRangeMaxY());
+
+				for (int32 cy = ymin; cy <= ymax; ++cy)
+					for (int32 cx = xmin; cx <= xmax; ++cx)
+						outPages.push_back(mStratData->calculatePageID(cx, cy));
+			}
+
+		protected:
+			Grid2DPageStrategyData* mStratData;
+			int32 mRadius;
+		};
+	}
 	//---------------------------------------------------------------------
 	Grid2DPageStrategy::Grid2DPageStrategy(PageManager* manager)
 		: PageStrategy("Grid2D", manager)
@@ -348,8 +382,24 @@ namespace Ogre
 			}
 		}	
 		
+		// speculative requests along the predicted path
+		if (stratData->getPrefetchPredictor().isEnabled())
+			prefetchPages(cam, section, stratData);
 
-
+	}
+	//---------------------------------------------------------------------
+	void Grid2DPageStrategy::frameStart(Real timeSinceLastFrame, PagedWorldSection* section)
+	{
+		Grid2DPageStrategyData* stratData = static_cast<Grid2DPageStrategyData*>(section->getStrategyData());
+		stratData->getPrefetchPredictor().advanceTime(timeSinceLastFrame);
+	}
+	//---------------------------------------------------------------------
+	void Grid2DPageStrategy::prefetchPages(Camera* cam, PagedWorldSection* section, 
+		Grid2DPageStrategyData* stratData)
+	{
+		Grid2DPrefetchRange range(stratData);
+		stratData->getPrefetchPredictor().prefetchPages(cam, cam->getDerivedPosition(), section, 
+			stratData->getCellSize(), range);
 	}
 	//---------------------------------------------------------------------
 	PageStrategyData* Grid2DPageStrategy::createData()
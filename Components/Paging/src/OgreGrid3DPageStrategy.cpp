@@ -229,6 +229,45 @@ namespace Ogre
 		ser.writeChunkEnd(CHUNK_ID);
 	}
 	//---------------------------------------------------------------------
+	namespace
+	{
+		/// Pages within the load radius of a position on a 3D grid
+		class Grid3DPrefetchRange : public PagePrefetchPredictor::PageRange
+		{
+		public:
+			Grid3DPrefetchRange(Grid3DPageStrategyData* stratData)
+				: mStratData(stratData)
+			{
+				const Vector3& cellSize = stratData->getCellSize();
+				Real loadRadius = stratData->getLoadRadius();
+				mRadiusX = (int32)Math::Ceil(loadRadius / cellSize.x);
+				mRadiusY = (int32)Math::Ceil(loadRadius / cellSize.y);
+				mRadiusZ = (int32)Math::Ceil(loadRadius / cellSize.z);
+			}
+
+			void getPagesInLoadRange(const Vector3& worldPos, PagePrefetchPredictor::PageIDList& outPages)
+			{
+				int32 x, y, z;
+				mStratData->determineGridLocation(worldPos, &x, &y, &z);
+
+				int32 xmin = std::max(x - mRadiusX, mStratData->getCellRangeMinX());
+				int32 xmax = std::min(x + mRadiusX, mStratData->getCellRangeMaxX());
+				int32 ymin = std::max(y - mRadiusY, mStratData->getCellRangeMinY());
+				int32 ymax = std::min(y + mRadiusY, mStratData->getCellRangeMaxY());
+				int32 zmin = std::max(z - mRadiusZ, mStratData->getCellRangeMinZ());
+				int32 zmax = std::min(z + mRadiusZ, mStratData->getCellRangeMaxZ());
+
+				for (int32 cz = zmin; cz <= zmax; ++cz)
+					for (int32 cy = ymin; cy <= ymax; ++cy)
+						for (int32 cx = xmin; cx <= xmax; ++cx)
+							outPages.push_back(mStratData->calculatePageID(cx, cy, cz));
+			}
+
+		protected:
+			Grid3DPageStrategyData* mStratData;
+			int32 mRadiusX, mRadiusY, mRadiusZ;
+		};
+	}
 	//---------------------------------------------------------------------
 	Grid3DPageStrategy::Grid3DPageStrategy(PageManager* manager)
 		: PageStrategy("Grid3D", manager)
@@ -318,6 +357,25 @@ namespace Ogre
 			    }
 		    }
         }
+
+		// speculative requests along the predicted path
+		if (stratData->getPrefetchPredictor().isEnabled())
+			prefetchPages(cam, section, stratData);
+	}
+	//---------------------------------------------------------------------
+	void Grid3DPageStrategy::frameStart(Real timeSinceLastFrame, PagedWorldSection* section)
+	{
+		Grid3DPageStrategyData* stratData = static_cast<Grid3DPageStrategyData*>(section->getStrategyData());
+		stratData->getPrefetchPredictor().advanceTime(timeSinceLastFrame);
+	}
+	//---------------------------------------------------------------------
+	void Grid3DPageStrategy::prefetchPages(Camera* cam, PagedWorldSection* section, 
+		Grid3DPageStrategyData* stratData)
+	{
+		const Vector3& cellSize = stratData->getCellSize();
+		Grid3DPrefetchRange range(stratData);
+		stratData->getPrefetchPredictor().prefetchPages(cam, cam->getDerivedPosition(), section, 
+			std::min(cellSize.x, std::min(cellSize.y, cellSize.z)), range);
 	}
 	//---------------------------------------------------------------------
 	PageStrategyData* Grid3DPageStrategy::createData()
@@ -56,7 +56,10 @@ namespace Ogre
 		, mParent(parent)
 		, mDeferredProcessInProgress(false)
 		, mModified(false)
+		, mPrepareSlotHeld(false)
+		, mSynchronousLoad(false)
 		, mDebugNode(0)
+		, mPreparedData(0)
 	{
 		WorkQueue* wq = Root::getSingleton().getWorkQueue();
 		mWorkQueueChannel = wq->getChannel("Ogre/Page");
@@ -71,6 +74,17 @@ namespace Ogre
 		wq->removeRequestHandler(mWorkQueueChannel, this);
 		wq->removeResponseHandler(mWorkQueueChannel, this);
 
+		// make sure the manager forgets about any queued or in-flight work
+		PageManager* mgr = getManager();
+		if (mPrepareSlotHeld)
+			mgr->_notifyPagePrepareComplete(this);
+		mgr->_cancelPageRequests(this);
+		if (mPreparedData)
+		{
+			destroyPreparedData(mPreparedData);
+			mPreparedData = 0;
+		}
+
 		destroyAllContentCollections();
 		if (mDebugNode)
 		{
@@ -95,6 +109,16 @@ namespace Ogre
 		mContentCollections.clear();
 	}
 	//---------------------------------------------------------------------
+	void Page::destroyPreparedData(PageData* data)
+	{
+		for (ContentCollectionList::iterator i = data->collectionsToAdd.begin(); 
+			i != data->collectionsToAdd.end(); ++i)
+		{
+			delete *i;
+		}
+		OGRE_DELETE data;
+	}
+	//---------------------------------------------------------------------
 	PageManager* Page::getManager() const
 	{
 		return mParent->getManager();
@@ -184,14 +208,24 @@ namespace Ogre
 		if (!mDeferredProcessInProgress)
 		{
 			destroyAllContentCollections();
-			PageRequest req(this);
 			mDeferredProcessInProgress = true;
-			Root::getSingleton().getWorkQueue()->addRequest(mWorkQueueChannel, WORKQUEUE_PREPARE_REQUEST, 
-				Any(req), 0, synchronous);
+			mSynchronousLoad = synchronous;
+			// Synchronous loads bypass the pipeline limits, otherwise the 
+			// manager may hold the request back until a prepare slot is free
+			if (synchronous || getManager()->_requestPagePrepare(this))
+				_dispatchPrepare();
 		}
 
 	}
 	//---------------------------------------------------------------------
+	void Page::_dispatchPrepare()
+	{
+		mPrepareSlotHeld = !mSynchronousLoad;
+		PageRequest req(this);
+		Root::getSingleton().getWorkQueue()->addRequest(mWorkQueueChannel, WORKQUEUE_PREPARE_REQUEST, 
+			Any(req), 0, mSynchronousLoad);
+	}
+	//---------------------------------------------------------------------
 	void Page::unload()
 	{
 		destroyAllContentCollections();
@@ -258,17 +292,41 @@ namespace Ogre
 		if (preq.srcPage!= this)
 			return;
 
+		// background stage is over, let the next page through
+		if (mPrepareSlotHeld)
+		{
+			mPrepareSlotHeld = false;
+			getManager()->_notifyPagePrepareComplete(this);
+		}
+
 		// final loading behaviour
 		if (res->succeeded())
 		{
-			std::swap(mContentCollections, pres.pageData->collectionsToAdd);
-			loadImpl();
+			mPreparedData = pres.pageData;
+			// if the per-frame budget is used up, the manager will call us back
+			if (mSynchronousLoad || getManager()->_requestPageFinalise(this))
+				_finaliseLoad();
 		}
+		else
+		{
+			destroyPreparedData(pres.pageData);
+			mDeferredProcessInProgress = false;
+		}
+
+	}
+	//---------------------------------------------------------------------
+	void Page::_finaliseLoad()
+	{
+		if (mPreparedData)
+		{
+			std::swap(mContentCollections, mPreparedData->collectionsToAdd);
+			loadImpl();
 
-		OGRE_DELETE pres.pageData;
+			OGRE_DELETE mPreparedData;
+			mPreparedData = 0;
+		}
 
 		mDeferredProcessInProgress = false;
-
 	}
 	//---------------------------------------------------------------------
 	bool Page::prepareImpl(PageData* dataToPopulate)
@@ -41,6 +41,7 @@ THE SOFTWARE.
 #include "OgreStreamSerialiser.h"
 #include "OgreRoot.h"
 #include "OgrePageContent.h"
+#include "OgrePage.h"
 
 namespace Ogre
 {
@@ -51,6 +52,10 @@ namespace Ogre
 		, mPageResourceGroup(ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME)
 		, mDebugDisplayLvl(0)
 		, mPagingEnabled(true)
+		, mMaxConcurrentPrepares(0)
+		, mMaxLoadsPerFrame(0)
+		, mPreparesInProgress(0)
+		, mLoadsThisFrame(0)
 		, mGrid2DPageStrategy(0)
 		, mGrid3DPageStrategy(0)
 		, mSimpleCollectionFactory(0)
@@ -503,6 +508,75 @@ namespace Ogre
 		return mCameraList;
 	}
 	//---------------------------------------------------------------------
+	bool PageManager::_requestPagePrepare(Page* page)
+	{
+		// Pages already waiting go first, a free slot is theirs until the next frame start
+		if (mPendingPrepareQueue.empty() && 
+			(!mMaxConcurrentPrepares || mPreparesInProgress < mMaxConcurrentPrepares))
+		{
+			++mPreparesInProgress;
+			return true;
+		}
+
+		mPendingPrepareQueue.push_back(page);
+		return false;
+	}
+	//---------------------------------------------------------------------
+	void PageManager::_notifyPagePrepareComplete(Page* page)
+	{
+		if (mPreparesInProgress)
+			--mPreparesInProgress;
+	}
+	//---------------------------------------------------------------------
+	bool PageManager::_requestPageFinalise(Page* page)
+	{
+		// Likewise, never load ahead of pages still waiting from earlier frames
+		if (mPendingLoadQueue.empty() && 
+			(!mMaxLoadsPerFrame || mLoadsThisFrame < mMaxLoadsPerFrame))
+		{
+			++mLoadsThisFrame;
+			return true;
+		}
+
+		mPendingLoadQueue.push_back(page);
+		return false;
+	}
+	//---------------------------------------------------------------------
+	void PageManager::_cancelPageRequests(Page* page)
+	{
+		mPendingPrepareQueue.erase(
+			std::remove(mPendingPrepareQueue.begin(), mPendingPrepareQueue.end(), page), 
+			mPendingPrepareQueue.end());
+		mPendingLoadQueue.erase(
+			std::remove(mPendingLoadQueue.begin(), mPendingLoadQueue.end(), page), 
+			mPendingLoadQueue.end());
+	}
+	//---------------------------------------------------------------------
+	void PageManager::processPageQueues()
+	{
+		mLoadsThisFrame = 0;
+
+		// Pages already prepared have been waiting longest, so load those first
+		while (!mPendingLoadQueue.empty() && 
+			(!mMaxLoadsPerFrame || mLoadsThisFrame < mMaxLoadsPerFrame))
+		{
+			Page* page = mPendingLoadQueue.front();
+			mPendingLoadQueue.pop_front();
+			++mLoadsThisFrame;
+			page->_finaliseLoad();
+		}
+
+		// Then refill the background stage
+		while (!mPendingPrepareQueue.empty() && 
+			(!mMaxConcurrentPrepares || mPreparesInProgress < mMaxConcurrentPrepares))
+		{
+			Page* page = mPendingPrepareQueue.front();
+			mPendingPrepareQueue.pop_front();
+			++mPreparesInProgress;
+			page->_dispatchPrepare();
+		}
+	}
+	//---------------------------------------------------------------------
 	//---------------------------------------------------------------------
 	void PageManager::EventRouter::cameraPreRenderScene(Camera* cam)
 	{
@@ -515,6 +589,7 @@ namespace Ogre
 	//---------------------------------------------------------------------
 	bool PageManager::EventRouter::frameStarted(const FrameEvent& evt)
 	{
+		pManager->processPageQueues();
 
 		for(WorldMap::iterator i = pWorldMap->begin(); i != pWorldMap->end(); ++i)
 		{
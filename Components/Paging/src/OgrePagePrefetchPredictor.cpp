@@ -0,0 +1,213 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgrePagePrefetchPredictor.h"
+#include "OgrePagedWorldSection.h"
+#include "OgrePage.h"
+
+namespace Ogre
+{
+	//---------------------------------------------------------------------
+	PagePrefetchPredictor::PagePrefetchPredictor()
+		: mLookaheadTime(0)
+		, mMaxPrefetchRequests(4)
+		, mTime(0)
+	{
+	}
+	//---------------------------------------------------------------------
+	PagePrefetchPredictor::~PagePrefetchPredictor()
+	{
+	}
+	//---------------------------------------------------------------------
+	void PagePrefetchPredictor::addWaypoint(const Camera* cam, const Vector3& worldPos)
+	{
+		mCameraTracks[cam].waypoints.push_back(worldPos);
+	}
+	//---------------------------------------------------------------------
+	void PagePrefetchPredictor::clearWaypoints(const Camera* cam)
+	{
+		CameraTrackMap::iterator i = mCameraTracks.find(cam);
+		if (i != mCameraTracks.end())
+			i->second.waypoints.clear();
+	}
+	//---------------------------------------------------------------------
+	const PagePrefetchPredictor::PositionList& PagePrefetchPredictor::getWaypoints(
+		const Camera* cam) const
+	{
+		static const PositionList emptyList;
+		CameraTrackMap::const_iterator i = mCameraTracks.find(cam);
+		if (i == mCameraTracks.end())
+			return emptyList;
+		else
+			return i->second.waypoints;
+	}
+	//---------------------------------------------------------------------
+	void PagePrefetchPredictor::removeCamera(const Camera* cam)
+	{
+		mCameraTracks.erase(cam);
+	}
+	//---------------------------------------------------------------------
+	void PagePrefetchPredictor::updateCamera(const Camera* cam, const Vector3& pos)
+	{
+		CameraTrack& track = mCameraTracks[cam];
+		if (!track.tracked)
+		{
+			// first sighting, no velocity yet
+			track.lastPosition = pos;
+			track.lastTime = mTime;
+			track.tracked = true;
+			return;
+		}
+
+		Real dt = mTime - track.lastTime;
+		// several notifications in the same frame carry no new information
+		if (dt <= 0)
+			return;
+
+		Vector3 instantVelocity = (pos - track.lastPosition) / dt;
+		// light smoothing so that a single irregular frame doesn't swing the prediction
+		track.velocity = (track.velocity + instantVelocity) * 0.5f;
+		track.lastPosition = pos;
+		track.lastTime = mTime;
+	}
+	//---------------------------------------------------------------------
+	Vector3 PagePrefetchPredictor::getVelocity(const Camera* cam) const
+	{
+		CameraTrackMap::const_iterator i = mCameraTracks.find(cam);
+		if (i == mCameraTracks.end())
+			return Vector3::ZERO;
+		else
+			return i->second.velocity;
+	}
+	//---------------------------------------------------------------------
+	void PagePrefetchPredictor::getPredictedPath(const Camera* cam, Real spacing, 
+		PositionList& outPositions)
+	{
+		CameraTrackMap::iterator i = mCameraTracks.find(cam);
+		if (!isEnabled() || spacing <= 0 || i == mCameraTracks.end() || !i->second.tracked)
+			return;
+
+		const Vector3& pos = i->second.lastPosition;
+		const Vector3& velocity = i->second.velocity;
+		PositionList& waypoints = i->second.waypoints;
+		Real remaining = velocity.length() * mLookaheadTime;
+		if (remaining < spacing)
+			return;
+
+		// drop waypoints we have already reached
+		while (!waypoints.empty() && 
+			pos.squaredDistance(waypoints.front()) <= spacing * spacing)
+		{
+			waypoints.erase(waypoints.begin());
+		}
+
+		if (waypoints.empty())
+		{
+			samplePath(pos, pos + velocity * mLookaheadTime, spacing, remaining, outPositions);
+		}
+		else
+		{
+			Vector3 from = pos;
+			for (PositionList::iterator w = waypoints.begin(); 
+				w != waypoints.end() && remaining > 0; ++w)
+			{
+				samplePath(from, *w, spacing, remaining, outPositions);
+				from = *w;
+			}
+		}
+	}
+	//---------------------------------------------------------------------
+	void PagePrefetchPredictor::prefetchPages(const Camera* cam, const Vector3& worldPos, 
+		PagedWorldSection* section, Real spacing, PageRange& range)
+	{
+		updateCamera(cam, worldPos);
+		updatePrefetchedPages(section);
+
+		PositionList path;
+		getPredictedPath(cam, spacing, path);
+		if (path.empty())
+			return;
+
+		set<PageID>::type visited;
+		PageIDList pages;
+		// nearest predicted positions first, so the cap favours the most urgent pages
+		for (PositionList::iterator p = path.begin(); p != path.end(); ++p)
+		{
+			pages.clear();
+			range.getPagesInLoadRange(*p, pages);
+			for (PageIDList::iterator i = pages.begin(); i != pages.end(); ++i)
+			{
+				PageID pageID = *i;
+				if (!visited.insert(pageID).second)
+					continue;
+
+				if (section->getPage(pageID))
+				{
+					// keep it around until we get there
+					section->holdPage(pageID);
+				}
+				else if (mPrefetchedPages.size() < mMaxPrefetchRequests)
+				{
+					section->loadPage(pageID);
+					// only count it if the load is actually pending
+					Page* page = section->getPage(pageID);
+					if (page && page->isDeferredProcessInProgress())
+						mPrefetchedPages[pageID] = page;
+				}
+			}
+		}
+	}
+	//---------------------------------------------------------------------
+	void PagePrefetchPredictor::updatePrefetchedPages(PagedWorldSection* section)
+	{
+		PrefetchedPageMap::iterator i = mPrefetchedPages.begin();
+		while (i != mPrefetchedPages.end())
+		{
+			// a different instance means ours was unloaded and the ID reused
+			Page* page = section->getPage(i->first);
+			if (page != i->second || !page->isDeferredProcessInProgress())
+				mPrefetchedPages.erase(i++);
+			else
+				++i;
+		}
+	}
+	//---------------------------------------------------------------------
+	void PagePrefetchPredictor::samplePath(const Vector3& from, const Vector3& to, 
+		Real spacing, Real& remaining, PositionList& outPositions)
+	{
+		Vector3 dir = to - from;
+		Real len = dir.normalise();
+		Real travel = std::min(len, remaining);
+		Real d = spacing;
+		for (; d <= travel; d += spacing)
+			outPositions.push_back(from + dir * d);
+		// always include the end of the travelled part of the segment
+		if (d - spacing < travel)
+			outPositions.push_back(from + dir * travel);
+		remaining -= travel;
+	}
+}
@@ -588,15 +588,33 @@ namespace Ogre
 				uint16 minBatchSize);
 
 		protected:
-			typedef list<HardwareVertexBufferSharedPtr>::type VBufList;
+			/// Free vertex buffers, grouped by their size in bytes so reuse is a lookup, not a scan
+			typedef multimap<size_t, HardwareVertexBufferSharedPtr>::type VBufList;
 			VBufList mFreePosBufList;
 			VBufList mFreeDeltaBufList;
-			typedef map<uint32, HardwareIndexBufferSharedPtr>::type IBufMap;
+
+			/** Full description of a shared index buffer.
+			@remarks
+				All nodes with the same LOD / skirt layout produce identical
+				indexes, so this is what decides whether a buffer can be shared.
+				The complete key is used rather than a hash of it so that two 
+				different layouts can never end up sharing the same buffer.
+			*/
+			struct SharedIndexBufferKey
+			{
+				uint16 batchSize;
+				uint16 vdatasize;
+				size_t vertexIncrement;
+				uint16 xoffset;
+				uint16 yoffset;
+				uint16 numSkirtRowsCols;
+				uint16 skirtRowColSkip;
+
+				bool operator<(const SharedIndexBufferKey& rhs) const;
+			};
+			typedef map<SharedIndexBufferKey, HardwareIndexBufferSharedPtr>::type IBufMap;
 			IBufMap mSharedIBufMap;
 
-			uint32 hashIndexBuffer(uint16 batchSize, 
-				uint16 vdatasize, size_t vertexIncrement, uint16 xoffset, uint16 yoffset, uint16 numSkirtRowsCols, 
-				uint16 skirtRowColSkip);
 			HardwareVertexBufferSharedPtr getVertexBuffer(VBufList& list, size_t vertexSize, size_t numVertices);
 
 		};
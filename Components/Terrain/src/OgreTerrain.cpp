@@ -4581,14 +4581,12 @@ namespace Ogre
 		VBufList& list, size_t vertexSize, size_t numVertices)
 	{
 		size_t sz = vertexSize * numVertices;
-		for (VBufList::iterator i = list.begin(); i != list.end(); ++i)
+		VBufList::iterator i = list.find(sz);
+		if (i != list.end())
 		{
-			if ((*i)->getSizeInBytes() == sz)
-			{
-				HardwareVertexBufferSharedPtr ret = *i;
-				list.erase(i);
-				return ret;
-			}
+			HardwareVertexBufferSharedPtr ret = i->second;
+			list.erase(i);
+			return ret;
 		}
 		// Didn't find one?
 		return HardwareBufferManager::getSingleton()
@@ -4600,18 +4598,24 @@ namespace Ogre
 	void Terrain::DefaultGpuBufferAllocator::freeVertexBuffers(
 		const HardwareVertexBufferSharedPtr& posbuf, const HardwareVertexBufferSharedPtr& deltabuf)
 	{
-		mFreePosBufList.push_back(posbuf);
-		mFreeDeltaBufList.push_back(deltabuf);
+		mFreePosBufList.insert(VBufList::value_type(posbuf->getSizeInBytes(), posbuf));
+		mFreeDeltaBufList.insert(VBufList::value_type(deltabuf->getSizeInBytes(), deltabuf));
 	}
 	//---------------------------------------------------------------------
 	HardwareIndexBufferSharedPtr Terrain::DefaultGpuBufferAllocator::getSharedIndexBuffer(uint16 batchSize, 
 		uint16 vdatasize, size_t vertexIncrement, uint16 xoffset, uint16 yoffset, uint16 numSkirtRowsCols, 
 		uint16 skirtRowColSkip)
 	{
-		uint32 hsh = hashIndexBuffer(batchSize, vdatasize, vertexIncrement, xoffset, yoffset, 
-			numSkirtRowsCols, skirtRowColSkip);
+		SharedIndexBufferKey key;
+		key.batchSize = batchSize;
+		key.vdatasize = vdatasize;
+		key.vertexIncrement = vertexIncrement;
+		key.xoffset = xoffset;
+		key.yoffset = yoffset;
+		key.numSkirtRowsCols = numSkirtRowsCols;
+		key.skirtRowColSkip = skirtRowColSkip;
 
-		IBufMap::iterator i = mSharedIBufMap.find(hsh);
+		IBufMap::iterator i = mSharedIBufMap.find(key);
 		if (i == mSharedIBufMap.end())
 		{
 			// create new
@@ -4623,7 +4627,7 @@ namespace Ogre
 			Terrain::_populateIndexBuffer(pI, batchSize, vdatasize, vertexIncrement, xoffset, yoffset, numSkirtRowsCols, skirtRowColSkip);
 			ret->unlock();
 
-			mSharedIBufMap[hsh] = ret;
+			mSharedIBufMap[key] = ret;
 			return ret;
 		}
 		else
@@ -4645,20 +4649,22 @@ namespace Ogre
 
 	}
 	//---------------------------------------------------------------------
-	uint32 Terrain::DefaultGpuBufferAllocator::hashIndexBuffer(uint16 batchSize, 
-		uint16 vdatasize, size_t vertexIncrement, uint16 xoffset, uint16 yoffset, uint16 numSkirtRowsCols, 
-		uint16 skirtRowColSkip)
+	bool Terrain::DefaultGpuBufferAllocator::SharedIndexBufferKey::operator<(
+		const SharedIndexBufferKey& rhs) const
 	{
-		uint32 ret = 0;
-		ret = HashCombine(ret, batchSize);
-		ret = HashCombine(ret, vdatasize);
-		ret = HashCombine(ret, vertexIncrement);
-		ret = HashCombine(ret, xoffset);
-		ret = HashCombine(ret, yoffset);
-		ret = HashCombine(ret, numSkirtRowsCols);
-		ret = HashCombine(ret, skirtRowColSkip);
-		return ret;
-
+		if (batchSize != rhs.batchSize)
+			return batchSize < rhs.batchSize;
+		if (vdatasize != rhs.vdatasize)
+			return vdatasize < rhs.vdatasize;
+		if (vertexIncrement != rhs.vertexIncrement)
+			return vertexIncrement < rhs.vertexIncrement;
+		if (xoffset != rhs.xoffset)
+			return xoffset < rhs.xoffset;
+		if (yoffset != rhs.yoffset)
+			return yoffset < rhs.yoffset;
+		if (numSkirtRowsCols != rhs.numSkirtRowsCols)
+			return numSkirtRowsCols < rhs.numSkirtRowsCols;
+		return skirtRowColSkip < rhs.skirtRowColSkip;
 	}
 	//---------------------------------------------------------------------
 	void Terrain::increaseLodLevel(bool synchronous /* = false */)
@@ -55,40 +55,53 @@ namespace Volume {
     */
     bool _OgreVolumeExport operator<(const Vector3& a, const Vector3& b);
 
-    /** A caching Source.
+    /** A caching Source. It can be shared by several threads splitting the same volume.
     */
     class _OgreVolumeExport CacheSource : public Source
     {
     protected:
         
+        /// Orders positions by their bytes, Vector3::operator< is no strict weak ordering.
+        struct PositionLess
+        {
+            bool operator()(const Vector3& a, const Vector3& b) const
+            {
+                return Volume::operator<(a, b);
+            }
+        };
+
         /// Map for the cache
-        typedef map<Vector3, Vector4>::type UMapPositionValue;
-        mutable UMapPositionValue mCache;
+        typedef map<Vector3, Vector4, PositionLess>::type UMapPositionValue;
+
+        /// Amount of independently locked cache shards.
+        static const size_t CACHE_SHARD_COUNT = 16;
+
+        /** One part of the cache. The position hash decides which shard holds a value so
+            concurrent octree splits mostly don't contend for the same lock.
+        */
+        typedef struct CacheShard
+        {
+            /// The cached values of this shard.
+            UMapPositionValue cache;
+
+            /// Guards the cached values.
+            OGRE_MUTEX(mutex)
+        } CacheShard;
+
+        /// The cache shards.
+        mutable CacheShard mShards[CACHE_SHARD_COUNT];
 
         /// The source to cache.
         const Source *mSrc;
         
-        /** Gets a density value and gradient from the cache.
+        /** Gets a density value and gradient from the cache. Thread safe as long as the cached
+            source is.
         @param position
             The position of the density value and gradient.
         @return
             The density value (w-component) and the gradient (x, y and z component).
         */
-        inline Vector4 getFromCache(const Vector3 &position) const
-        {
-            Vector4 result;
-            map<Vector3, Vector4>::iterator it = mCache.find(position);
-            if (it == mCache.end())
-            {
-                result = mSrc->getValueAndGradient(position);
-                mCache[position] = result;
-            }
-            else
-            {
-                result = it->second;
-            }
-            return result;
-        }
+        Vector4 getFromCache(const Vector3 &position) const;
 
     public:
         
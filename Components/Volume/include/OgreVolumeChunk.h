@@ -84,11 +84,18 @@ namespace Volume {
         /// The first LOD level to create geometry for. For scenarios where the lower levels won't be visible anyway. 0 is the default and switches this off.
         size_t createGeometryFromLevel;
 
+        /** The amount of threads splitting the octree of a single chunk with 1 as default. Worthwhile for
+            big chunks or expensive sources, the chunks themselves are already loaded in parallel by the WorkQueue.
+            Only the octree split uses these threads, the dual grid and the triangles are generated serially.
+            Wrap the source in a CacheSource to share the density samples between the threads.
+        */
+        size_t splitThreadCount;
+
         /** Constructor.
         */
         ChunkParameters(void) :
             sceneManager(0), src(0), baseError((Real)0.0), errorMultiplicator((Real)1.0), createOctreeVisualization(false),
-            createDualGridVisualization(false), lodCallback(0), lodCallbackLod(0), scale((Real)1.0), createGeometryFromLevel(0)
+            createDualGridVisualization(false), lodCallback(0), lodCallbackLod(0), scale((Real)1.0), createGeometryFromLevel(0), splitThreadCount(1)
         {
         }
     } ChunkParameters;
@@ -102,6 +102,18 @@ namespace Volume {
         */
         virtual void setVolumeGridValue(int x, int y, int z, float value) = 0;
 
+        /** Gets the trilinearly interpolated value of a position in grid space.
+        @param scaledPosition
+            The position, already scaled to grid space.
+        */
+        Real getTrilinearValue(const Vector3 &scaledPosition) const;
+
+        /** Gets the trilinearly interpolated gradient of a position in grid space.
+        @param scaledPosition
+            The position, already scaled to grid space.
+        */
+        Vector3 getTrilinearGradient(const Vector3 &scaledPosition) const;
+
         /** Gets a gradient of a point with optional sobel blurring.
         @param x
             The x coordinate of the point.
@@ -149,6 +161,14 @@ namespace Volume {
         */
         virtual Real getValue(const Vector3 &position) const;
 
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Real *x, const Real *y, const Real *z, Vector4 *results, size_t count) const;
+
         /** Gets the width of the texture.
         @return
             The width of the texture.
@@ -76,10 +76,23 @@ namespace Volume {
             The manual object to add the lines to if this is a leaf in the octree.
         */
         void buildOctreeGridLines(ManualObject *manual) const;
+
+        /** Creates the eight children of this node without splitting them further.
+        */
+        void createChildren(void);
+
+        /** Evaluates the density and gradient of the center if this hasn't happened yet.
+        @param src
+            The volume source.
+        */
+        void evaluateCenterValue(const Source *src);
     public:
 
         /// Even in an OCtree, the amount of children should not be hardcoded.
         static const size_t OCTREE_CHILDREN_COUNT;
+
+        /// Minimum amount of subtrees per thread splitParallel splits down to before handing them out.
+        static const size_t SPLIT_SUBTREES_PER_THREAD;
         
         /** Gets the center and width / height / depth vector of the children of a node.
         @param from
@@ -142,6 +155,26 @@ namespace Volume {
         */
         void split(const OctreeNodeSplitPolicy *splitPolicy, const Source *src, const Real geometricError);
 
+        /** Splits this cell like split, but distributes the subtrees over several threads.
+            The upper levels are split on the calling thread until there are at least
+            SPLIT_SUBTREES_PER_THREAD subtrees per thread, or nothing is left to split, so
+            threads getting empty space and threads getting the surface even out. The source
+            and the split policy must be thread safe for this, which is the case for the
+            sources of this component. Without thread support the subtrees are split one
+            after the other on the calling thread. Only the octree is
+            built in parallel, the dual grid and the marching cubes triangles of a chunk are
+            still generated on one thread.
+        @param splitPolicy
+            Defines the policy deciding whether to split this node or not.
+        @param src
+            The volume source.
+        @param geometricError
+            The accepted geometric error.
+        @param threadCount
+            The amount of threads to use including the calling one, 1 splits serially.
+        */
+        void splitParallel(const OctreeNodeSplitPolicy *splitPolicy, const Source *src, const Real geometricError, size_t threadCount);
+
         /** Getter for the octree debug visualization of the octree starting with
             this node.
         @param sceneManager
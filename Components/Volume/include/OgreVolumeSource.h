@@ -74,6 +74,9 @@ namespace Volume {
 
         /// The amount of items being written as one chunk during serialization.
         static const size_t SERIALIZATION_CHUNK_SIZE;
+
+        /// The amount of positions composite sources evaluate at once in their temporary buffers.
+        static const size_t BATCH_SIZE = 64;
         
         /** Destructor.
         */
@@ -95,6 +98,37 @@ namespace Volume {
         */
         virtual Real getValue(const Vector3 &position) const = 0;
 
+        /** Gets the density values of several positions at once. The positions are given as
+            separate coordinate arrays so implementations can work on them in tight loops. The
+            default implementation calls getValue per position, the CSG sources override it to
+            evaluate each node once per batch instead of walking the tree for every position.
+        @param x
+            The x coordinates of the positions.
+        @param y
+            The y coordinates of the positions.
+        @param z
+            The z coordinates of the positions.
+        @param values
+            Receives the densities, must hold count entries.
+        @param count
+            The amount of positions.
+        */
+        virtual void getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const;
+
+        /** Gets the density values and gradients of several positions at once, like getValues.
+        @param x
+            The x coordinates of the positions.
+        @param y
+            The y coordinates of the positions.
+        @param z
+            The z coordinates of the positions.
+        @param results
+            Receives the gradients (x, y and z component) and the densities (w-component), must hold count entries.
+        @param count
+            The amount of positions.
+        */
+        virtual void getValuesAndGradients(const Real *x, const Real *y, const Real *z, Vector4 *results, size_t count) const;
+
         /** Serializes a volume source to a discrete grid file with deflated
         compression. To achieve better compression, all density values are clamped
         within a maximum absolute value of (to - from).length() / 16.0. The values
@@ -49,13 +49,14 @@ namespace Volume {
 
     Vector4 CSGSphereSource::getValueAndGradient(const Vector3 &position) const
     {
-        Vector3 pMinCenter = position- mCenter;
-        Vector3 gradient = pMinCenter;
+        Vector3 gradient = position - mCenter;
+        // Normalise before reading the components, the argument order of the constructor isn't defined
+        const Real distance = gradient.normalise();
         return Vector4(
             gradient.x,
             gradient.y,
             gradient.z,
-            mR - gradient.normalise()
+            mR - distance
             );
     }
     
@@ -69,6 +70,35 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void CSGSphereSource::getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            const Real dX = x[i] - mCenter.x;
+            const Real dY = y[i] - mCenter.y;
+            const Real dZ = z[i] - mCenter.z;
+            values[i] = mR - Math::Sqrt(dX * dX + dY * dY + dZ * dZ);
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void CSGSphereSource::getValuesAndGradients(const Real *x, const Real *y, const Real *z, Vector4 *results, size_t count) const
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            const Real dX = x[i] - mCenter.x;
+            const Real dY = y[i] - mCenter.y;
+            const Real dZ = z[i] - mCenter.z;
+            const Real distance = Math::Sqrt(dX * dX + dY * dY + dZ * dZ);
+            // Like Vector3::normalise, leave a zero vector alone
+            const Real invDistance = distance > (Real)0.0 ? (Real)1.0 / distance : (Real)1.0;
+            results[i] = Vector4(dX * invDistance, dY * invDistance, dZ * invDistance, mR - distance);
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
     CSGPlaneSource::CSGPlaneSource(const Real d, const Vector3 &normal) : mD(d)
     {
         mNormal = normal.normalisedCopy();
@@ -97,6 +127,26 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void CSGPlaneSource::getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            values[i] = mD - (mNormal.x * x[i] + mNormal.y * y[i] + mNormal.z * z[i]);
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void CSGPlaneSource::getValuesAndGradients(const Real *x, const Real *y, const Real *z, Vector4 *results, size_t count) const
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            results[i] = Vector4(mNormal.x, mNormal.y, mNormal.z, mD - (mNormal.x * x[i] + mNormal.y * y[i] + mNormal.z * z[i]));
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
     CSGCubeSource::CSGCubeSource(const Vector3 &min, const Vector3 &max)
     {
         mBox.setExtents(min, max);
@@ -128,6 +178,32 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void CSGCubeSource::getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            values[i] = distanceTo(Vector3(x[i], y[i], z[i]));
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void CSGCubeSource::getValuesAndGradients(const Real *x, const Real *y, const Real *z, Vector4 *results, size_t count) const
+    {
+        // Same Prewitt approximation as getValueAndGradient, without the virtual calls
+        for (size_t i = 0; i < count; ++i)
+        {
+            const Vector3 position(x[i], y[i], z[i]);
+            Vector3 gradient(distanceTo(Vector3(position.x + (Real)1.0, position.y, position.z)) - distanceTo(Vector3(position.x - (Real)1.0, position.y, position.z)),
+                distanceTo(Vector3(position.x, position.y + (Real)1.0, position.z)) - distanceTo(Vector3(position.x, position.y - (Real)1.0, position.z)),
+                distanceTo(Vector3(position.x, position.y, position.z + (Real)1.0)) - distanceTo(Vector3(position.x, position.y, position.z - (Real)1.0)));
+            gradient.normalise();
+            results[i] = Vector4(-gradient.x, -gradient.y, -gradient.z, distanceTo(position));
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
     CSGOperationSource::CSGOperationSource(const Source *a, const Source *b) : mA(a), mB(b)
     {
     }
@@ -206,6 +282,50 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void CSGIntersectionSource::getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const
+    {
+        Real valuesB[BATCH_SIZE];
+        for (size_t offset = 0; offset < count; offset += BATCH_SIZE)
+        {
+            const size_t batchCount = std::min(count - offset, (size_t)BATCH_SIZE);
+            Real *valuesA = values + offset;
+            mA->getValues(x + offset, y + offset, z + offset, valuesA, batchCount);
+            mB->getValues(x + offset, y + offset, z + offset, valuesB, batchCount);
+            for (size_t i = 0; i < batchCount; ++i)
+            {
+                const Real valueB = valuesB[i];
+                if (!(valuesA[i] < valueB))
+                {
+                    valuesA[i] = valueB;
+                }
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void CSGIntersectionSource::getValuesAndGradients(const Real *x, const Real *y, const Real *z, Vector4 *results, size_t count) const
+    {
+        Vector4 resultsB[BATCH_SIZE];
+        for (size_t offset = 0; offset < count; offset += BATCH_SIZE)
+        {
+            const size_t batchCount = std::min(count - offset, (size_t)BATCH_SIZE);
+            Vector4 *resultsA = results + offset;
+            mA->getValuesAndGradients(x + offset, y + offset, z + offset, resultsA, batchCount);
+            mB->getValuesAndGradients(x + offset, y + offset, z + offset, resultsB, batchCount);
+            for (size_t i = 0; i < batchCount; ++i)
+            {
+                const Vector4 resultB = resultsB[i];
+                if (!(resultsA[i].w < resultB.w))
+                {
+                    resultsA[i] = resultB;
+                }
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
     CSGUnionSource::CSGUnionSource(const Source *a, const Source *b) : CSGOperationSource(a, b)
     {
     }
@@ -244,6 +364,50 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void CSGUnionSource::getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const
+    {
+        Real valuesB[BATCH_SIZE];
+        for (size_t offset = 0; offset < count; offset += BATCH_SIZE)
+        {
+            const size_t batchCount = std::min(count - offset, (size_t)BATCH_SIZE);
+            Real *valuesA = values + offset;
+            mA->getValues(x + offset, y + offset, z + offset, valuesA, batchCount);
+            mB->getValues(x + offset, y + offset, z + offset, valuesB, batchCount);
+            for (size_t i = 0; i < batchCount; ++i)
+            {
+                const Real valueB = valuesB[i];
+                if (!(valuesA[i] > valueB))
+                {
+                    valuesA[i] = valueB;
+                }
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void CSGUnionSource::getValuesAndGradients(const Real *x, const Real *y, const Real *z, Vector4 *results, size_t count) const
+    {
+        Vector4 resultsB[BATCH_SIZE];
+        for (size_t offset = 0; offset < count; offset += BATCH_SIZE)
+        {
+            const size_t batchCount = std::min(count - offset, (size_t)BATCH_SIZE);
+            Vector4 *resultsA = results + offset;
+            mA->getValuesAndGradients(x + offset, y + offset, z + offset, resultsA, batchCount);
+            mB->getValuesAndGradients(x + offset, y + offset, z + offset, resultsB, batchCount);
+            for (size_t i = 0; i < batchCount; ++i)
+            {
+                const Vector4 resultB = resultsB[i];
+                if (!(resultsA[i].w > resultB.w))
+                {
+                    resultsA[i] = resultB;
+                }
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
     CSGDifferenceSource::CSGDifferenceSource(const Source *a, const Source *b) : CSGOperationSource(a, b)
     {
     }
@@ -282,6 +446,50 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void CSGDifferenceSource::getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const
+    {
+        Real valuesB[BATCH_SIZE];
+        for (size_t offset = 0; offset < count; offset += BATCH_SIZE)
+        {
+            const size_t batchCount = std::min(count - offset, (size_t)BATCH_SIZE);
+            Real *valuesA = values + offset;
+            mA->getValues(x + offset, y + offset, z + offset, valuesA, batchCount);
+            mB->getValues(x + offset, y + offset, z + offset, valuesB, batchCount);
+            for (size_t i = 0; i < batchCount; ++i)
+            {
+                const Real valueB = -valuesB[i];
+                if (!(valuesA[i] < valueB))
+                {
+                    valuesA[i] = valueB;
+                }
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void CSGDifferenceSource::getValuesAndGradients(const Real *x, const Real *y, const Real *z, Vector4 *results, size_t count) const
+    {
+        Vector4 resultsB[BATCH_SIZE];
+        for (size_t offset = 0; offset < count; offset += BATCH_SIZE)
+        {
+            const size_t batchCount = std::min(count - offset, (size_t)BATCH_SIZE);
+            Vector4 *resultsA = results + offset;
+            mA->getValuesAndGradients(x + offset, y + offset, z + offset, resultsA, batchCount);
+            mB->getValuesAndGradients(x + offset, y + offset, z + offset, resultsB, batchCount);
+            for (size_t i = 0; i < batchCount; ++i)
+            {
+                const Vector4 resultB = (Real)-1.0 * resultsB[i];
+                if (!(resultsA[i].w < resultB.w))
+                {
+                    resultsA[i] = resultB;
+                }
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
     CSGUnarySource::CSGUnarySource(const Source *src) : mSrc(src)
     {
     }
@@ -334,6 +542,28 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void CSGNegateSource::getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const
+    {
+        mSrc->getValues(x, y, z, values, count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            values[i] *= (Real)-1.0;
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void CSGNegateSource::getValuesAndGradients(const Real *x, const Real *y, const Real *z, Vector4 *results, size_t count) const
+    {
+        mSrc->getValuesAndGradients(x, y, z, results, count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            results[i] = (Real)-1.0 * results[i];
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
     CSGScaleSource::CSGScaleSource(const Source *src, const Real scale) : CSGUnarySource(src), mScale(scale)
     {
     }
@@ -354,6 +584,52 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void CSGScaleSource::getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const
+    {
+        Real scaledX[BATCH_SIZE], scaledY[BATCH_SIZE], scaledZ[BATCH_SIZE];
+        const Real invScale = 1.0f / mScale;
+        for (size_t offset = 0; offset < count; offset += BATCH_SIZE)
+        {
+            const size_t batchCount = std::min(count - offset, (size_t)BATCH_SIZE);
+            for (size_t i = 0; i < batchCount; ++i)
+            {
+                scaledX[i] = x[offset + i] * invScale;
+                scaledY[i] = y[offset + i] * invScale;
+                scaledZ[i] = z[offset + i] * invScale;
+            }
+            mSrc->getValues(scaledX, scaledY, scaledZ, values + offset, batchCount);
+            for (size_t i = 0; i < batchCount; ++i)
+            {
+                values[offset + i] *= mScale;
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void CSGScaleSource::getValuesAndGradients(const Real *x, const Real *y, const Real *z, Vector4 *results, size_t count) const
+    {
+        Real scaledX[BATCH_SIZE], scaledY[BATCH_SIZE], scaledZ[BATCH_SIZE];
+        const Real invScale = 1.0f / mScale;
+        for (size_t offset = 0; offset < count; offset += BATCH_SIZE)
+        {
+            const size_t batchCount = std::min(count - offset, (size_t)BATCH_SIZE);
+            for (size_t i = 0; i < batchCount; ++i)
+            {
+                scaledX[i] = x[offset + i] * invScale;
+                scaledY[i] = y[offset + i] * invScale;
+                scaledZ[i] = z[offset + i] * invScale;
+            }
+            mSrc->getValuesAndGradients(scaledX, scaledY, scaledZ, results + offset, batchCount);
+            for (size_t i = 0; i < batchCount; ++i)
+            {
+                results[offset + i] = results[offset + i] * mScale;
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
     void CSGNoiseSource::setData(void)
     {
         mGradientOff = fabs(mFrequencies[0]);
@@ -404,6 +680,67 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void CSGNoiseSource::getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const
+    {
+        mSrc->getValues(x, y, z, values, count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            Real toAdd = (Real)0.0;
+            for (size_t j = 0; j < mNumOctaves; ++j)
+            {
+                toAdd += mNoise.noise(x[i] * mFrequencies[j], y[i] * mFrequencies[j], z[i] * mFrequencies[j]) * mAmplitudes[j];
+            }
+            values[i] += toAdd;
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void CSGNoiseSource::getValuesAndGradients(const Real *x, const Real *y, const Real *z, Vector4 *results, size_t count) const
+    {
+        // The positions themselves followed by the six neighbours for the central differences,
+        // so the source below is evaluated once for all seven per batch.
+        const size_t samples = 7;
+        Real sampleX[BATCH_SIZE * samples], sampleY[BATCH_SIZE * samples], sampleZ[BATCH_SIZE * samples];
+        Real values[BATCH_SIZE * samples];
+        const Real offsets[samples][3] = {
+            {(Real)0.0, (Real)0.0, (Real)0.0},
+            {mGradientOff, (Real)0.0, (Real)0.0}, {-mGradientOff, (Real)0.0, (Real)0.0},
+            {(Real)0.0, mGradientOff, (Real)0.0}, {(Real)0.0, -mGradientOff, (Real)0.0},
+            {(Real)0.0, (Real)0.0, mGradientOff}, {(Real)0.0, (Real)0.0, -mGradientOff}};
+        for (size_t offset = 0; offset < count; offset += BATCH_SIZE)
+        {
+            const size_t batchCount = std::min(count - offset, (size_t)BATCH_SIZE);
+            for (size_t s = 0; s < samples; ++s)
+            {
+                Real *dstX = sampleX + s * batchCount;
+                Real *dstY = sampleY + s * batchCount;
+                Real *dstZ = sampleZ + s * batchCount;
+                for (size_t i = 0; i < batchCount; ++i)
+                {
+                    dstX[i] = x[offset + i] + offsets[s][0];
+                    dstY[i] = y[offset + i] + offsets[s][1];
+                    dstZ[i] = z[offset + i] + offsets[s][2];
+                }
+            }
+            CSGNoiseSource::getValues(sampleX, sampleY, sampleZ, values, batchCount * samples);
+            const Real *value = values;
+            const Real *posX = values + batchCount, *negX = values + 2 * batchCount;
+            const Real *posY = values + 3 * batchCount, *negY = values + 4 * batchCount;
+            const Real *posZ = values + 5 * batchCount, *negZ = values + 6 * batchCount;
+            for (size_t i = 0; i < batchCount; ++i)
+            {
+                results[offset + i] = Vector4(
+                    -(posX[i] - negX[i]),
+                    -(posY[i] - negY[i]),
+                    -(posZ[i] - negZ[i]),
+                    value[i]);
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
     long CSGNoiseSource::getSeed(void) const
     {
         return mSeed;
@@ -26,6 +26,7 @@ THE SOFTWARE.
 */
 #include "OgreVolumeCacheSource.h"
 
+#include "OgreCommon.h"
 namespace Ogre {
 namespace Volume {
     
@@ -51,6 +52,26 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    Vector4 CacheSource::getFromCache(const Vector3 &position) const
+    {
+        CacheShard &shard = mShards[FastHash((const char*)&position, sizeof(Vector3)) % CACHE_SHARD_COUNT];
+        {
+            OGRE_LOCK_MUTEX(shard.mutex);
+            UMapPositionValue::const_iterator it = shard.cache.find(position);
+            if (it != shard.cache.end())
+            {
+                return it->second;
+            }
+        }
+        // Evaluate the source outside of the lock, a concurrent duplicate evaluation yields the same value.
+        Vector4 result = mSrc->getValueAndGradient(position);
+        OGRE_LOCK_MUTEX(shard.mutex);
+        shard.cache[position] = result;
+        return result;
+    }
+    
+    //-----------------------------------------------------------------------
+
     Vector4 CacheSource::getValueAndGradient(const Vector3 &position) const
     {
         return getFromCache(position);
@@ -128,7 +128,7 @@ namespace Volume {
     {
         OctreeNodeSplitPolicy policy(chunkRequest->parameters->src, chunkRequest->parameters->errorMultiplicator * chunkRequest->parameters->baseError);
         mError = (Real)chunkRequest->level * chunkRequest->parameters->errorMultiplicator * chunkRequest->parameters->baseError;
-        chunkRequest->root->split(&policy, chunkRequest->parameters->src, mError);
+        chunkRequest->root->splitParallel(&policy, chunkRequest->parameters->src, mError, chunkRequest->parameters->splitThreadCount);
         Real maxMSDistance = (Real)chunkRequest->level * chunkRequest->parameters->errorMultiplicator * chunkRequest->parameters->baseError * chunkRequest->parameters->skirtFactor;
         IsoSurface *is = OGRE_NEW IsoSurfaceMC(chunkRequest->parameters->src);
         chunkRequest->dualGridGenerator->generateDualGrid(chunkRequest->root, is, chunkRequest->mb, maxMSDistance,
@@ -299,6 +299,11 @@ namespace Volume {
         parameters.createOctreeVisualization = StringConverter::parseBool(config.getSetting("createOctreeVisualization"));
         parameters.createDualGridVisualization = StringConverter::parseBool(config.getSetting("createDualGridVisualization"));
         parameters.skirtFactor = StringConverter::parseReal(config.getSetting("skirtFactor"));
+        String splitThreadCount = config.getSetting("splitThreadCount");
+        if (!splitThreadCount.empty())
+        {
+            parameters.splitThreadCount = StringConverter::parseUnsignedInt(splitThreadCount);
+        }
     
         load(parent, from, to, level, &parameters);
         
@@ -91,47 +91,93 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
     
-    Vector4 GridSource::getValueAndGradient(const Vector3 &position) const
+    Vector3 GridSource::getTrilinearGradient(const Vector3 &scaledPosition) const
     {
-        Vector3 scaledPosition(position.x * mPosXScale, position.y * mPosYScale, position.z * mPosZScale);
-        Vector3 normal;
-        if (mTrilinearGradient)
-        {
-            size_t x0 = (size_t)scaledPosition.x;
-            size_t x1 = (size_t)ceil(scaledPosition.x);
-            size_t y0 = (size_t)scaledPosition.y;
-            size_t y1 = (size_t)ceil(scaledPosition.y);
-            size_t z0 = (size_t)scaledPosition.z;
-            size_t z1 = (size_t)ceil(scaledPosition.z);
+        size_t x0 = (size_t)scaledPosition.x;
+        size_t x1 = (size_t)ceil(scaledPosition.x);
+        size_t y0 = (size_t)scaledPosition.y;
+        size_t y1 = (size_t)ceil(scaledPosition.y);
+        size_t z0 = (size_t)scaledPosition.z;
+        size_t z1 = (size_t)ceil(scaledPosition.z);
         
-            Real dX = scaledPosition.x - (Real)x0;
-            Real dY = scaledPosition.y - (Real)y0;
-            Real dZ = scaledPosition.z - (Real)z0;
+        Real dX = scaledPosition.x - (Real)x0;
+        Real dY = scaledPosition.y - (Real)y0;
+        Real dZ = scaledPosition.z - (Real)z0;
         
-            Vector3 f000 = getGradient(x0, y0, z0);
-            Vector3 f100 = getGradient(x1, y0, z0);
-            Vector3 f010 = getGradient(x0, y1, z0);
-            Vector3 f001 = getGradient(x0, y0, z1);
-            Vector3 f101 = getGradient(x1, y0, z1);
-            Vector3 f011 = getGradient(x0, y1, z1);
-            Vector3 f110 = getGradient(x1, y1, z0);
-            Vector3 f111 = getGradient(x1, y1, z1);
+        Vector3 f000 = getGradient(x0, y0, z0);
+        Vector3 f100 = getGradient(x1, y0, z0);
+        Vector3 f010 = getGradient(x0, y1, z0);
+        Vector3 f001 = getGradient(x0, y0, z1);
+        Vector3 f101 = getGradient(x1, y0, z1);
+        Vector3 f011 = getGradient(x0, y1, z1);
+        Vector3 f110 = getGradient(x1, y1, z0);
+        Vector3 f111 = getGradient(x1, y1, z1);
 
-            Real oneMinX = (Real)1.0 - dX;
-            Real oneMinY = (Real)1.0 - dY;
-            Real oneMinZ = (Real)1.0 - dZ;
-            Real oneMinXoneMinY = oneMinX * oneMinY;
-            Real dXOneMinY = dX * oneMinY;
+        Real oneMinX = (Real)1.0 - dX;
+        Real oneMinY = (Real)1.0 - dY;
+        Real oneMinZ = (Real)1.0 - dZ;
+        Real oneMinXoneMinY = oneMinX * oneMinY;
+        Real dXOneMinY = dX * oneMinY;
 
-            normal = oneMinZ * (f000 * oneMinXoneMinY
-                + f100 * dXOneMinY
-                + f010 * oneMinX * dY)
-                + dZ * (f001 * oneMinXoneMinY
-                + f101 * dXOneMinY
-                + f011 * oneMinX * dY)
-                + dX * dY * (f110 * oneMinZ
-                + f111 * dZ);
+        return oneMinZ * (f000 * oneMinXoneMinY
+            + f100 * dXOneMinY
+            + f010 * oneMinX * dY)
+            + dZ * (f001 * oneMinXoneMinY
+            + f101 * dXOneMinY
+            + f011 * oneMinX * dY)
+            + dX * dY * (f110 * oneMinZ
+            + f111 * dZ);
+    }
+    
+    //-----------------------------------------------------------------------
+    
+    Real GridSource::getTrilinearValue(const Vector3 &scaledPosition) const
+    {
+        size_t x0 = (size_t)scaledPosition.x;
+        size_t x1 = (size_t)ceil(scaledPosition.x);
+        size_t y0 = (size_t)scaledPosition.y;
+        size_t y1 = (size_t)ceil(scaledPosition.y);
+        size_t z0 = (size_t)scaledPosition.z;
+        size_t z1 = (size_t)ceil(scaledPosition.z);
+
+        Real dX = scaledPosition.x - (Real)x0;
+        Real dY = scaledPosition.y - (Real)y0;
+        Real dZ = scaledPosition.z - (Real)z0;
+
+        Real f000 = getVolumeGridValue(x0, y0, z0);
+        Real f100 = getVolumeGridValue(x1, y0, z0);
+        Real f010 = getVolumeGridValue(x0, y1, z0);
+        Real f001 = getVolumeGridValue(x0, y0, z1);
+        Real f101 = getVolumeGridValue(x1, y0, z1);
+        Real f011 = getVolumeGridValue(x0, y1, z1);
+        Real f110 = getVolumeGridValue(x1, y1, z0);
+        Real f111 = getVolumeGridValue(x1, y1, z1);
 
+        Real oneMinX = (Real)1.0 - dX;
+        Real oneMinY = (Real)1.0 - dY;
+        Real oneMinZ = (Real)1.0 - dZ;
+        Real oneMinXoneMinY = oneMinX * oneMinY;
+        Real dXOneMinY = dX * oneMinY;
+
+        return oneMinZ * (f000 * oneMinXoneMinY
+            + f100 * dXOneMinY
+            + f010 * oneMinX * dY)
+            + dZ * (f001 * oneMinXoneMinY
+            + f101 * dXOneMinY
+            + f011 * oneMinX * dY)
+            + dX * dY * (f110 * oneMinZ
+            + f111 * dZ);
+    }
+    
+    //-----------------------------------------------------------------------
+    
+    Vector4 GridSource::getValueAndGradient(const Vector3 &position) const
+    {
+        Vector3 scaledPosition(position.x * mPosXScale, position.y * mPosYScale, position.z * mPosZScale);
+        Vector3 normal;
+        if (mTrilinearGradient)
+        {
+            normal = getTrilinearGradient(scaledPosition);
             normal *= (Real)-1.0;
         }
         else
@@ -150,41 +196,7 @@ namespace Volume {
         Real value;
         if (mTrilinearValue)
         {
-            size_t x0 = (size_t)scaledPosition.x;
-            size_t x1 = (size_t)ceil(scaledPosition.x);
-            size_t y0 = (size_t)scaledPosition.y;
-            size_t y1 = (size_t)ceil(scaledPosition.y);
-            size_t z0 = (size_t)scaledPosition.z;
-            size_t z1 = (size_t)ceil(scaledPosition.z);
-
-            Real dX = scaledPosition.x - (Real)x0;
-            Real dY = scaledPosition.y - (Real)y0;
-            Real dZ = scaledPosition.z - (Real)z0;
-
-            Real f000 = getVolumeGridValue(x0, y0, z0);
-            Real f100 = getVolumeGridValue(x1, y0, z0);
-            Real f010 = getVolumeGridValue(x0, y1, z0);
-            Real f001 = getVolumeGridValue(x0, y0, z1);
-            Real f101 = getVolumeGridValue(x1, y0, z1);
-            Real f011 = getVolumeGridValue(x0, y1, z1);
-            Real f110 = getVolumeGridValue(x1, y1, z0);
-            Real f111 = getVolumeGridValue(x1, y1, z1);
-
-            Real oneMinX = (Real)1.0 - dX;
-            Real oneMinY = (Real)1.0 - dY;
-            Real oneMinZ = (Real)1.0 - dZ;
-            Real oneMinXoneMinY = oneMinX * oneMinY;
-            Real dXOneMinY = dX * oneMinY;
-
-            value = oneMinZ * (f000 * oneMinXoneMinY
-                + f100 * dXOneMinY
-                + f010 * oneMinX * dY)
-                + dZ * (f001 * oneMinXoneMinY
-                + f101 * dXOneMinY
-                + f011 * oneMinX * dY)
-                + dX * dY * (f110 * oneMinZ
-                + f111 * dZ);
-        
+            value = getTrilinearValue(scaledPosition);
         }
         else
         {
@@ -199,6 +211,61 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
     
+    void GridSource::getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const
+    {
+        // Decide on the filtering once per batch, the grid lookup is the only virtual call left per sample.
+        if (mTrilinearValue)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                values[i] = getTrilinearValue(Vector3(x[i] * mPosXScale, y[i] * mPosYScale, z[i] * mPosZScale));
+            }
+        }
+        else
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                values[i] = (Real)getVolumeGridValue((size_t)(x[i] * mPosXScale + (Real)0.5),
+                    (size_t)(y[i] * mPosYScale + (Real)0.5), (size_t)(z[i] * mPosZScale + (Real)0.5));
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+    
+    void GridSource::getValuesAndGradients(const Real *x, const Real *y, const Real *z, Vector4 *results, size_t count) const
+    {
+        Real values[BATCH_SIZE];
+        for (size_t offset = 0; offset < count; offset += BATCH_SIZE)
+        {
+            const size_t batchCount = std::min(count - offset, (size_t)BATCH_SIZE);
+            const Real *batchX = x + offset;
+            const Real *batchY = y + offset;
+            const Real *batchZ = z + offset;
+            Vector4 *batchResults = results + offset;
+            GridSource::getValues(batchX, batchY, batchZ, values, batchCount);
+            if (mTrilinearGradient)
+            {
+                for (size_t i = 0; i < batchCount; ++i)
+                {
+                    const Vector3 normal = getTrilinearGradient(Vector3(batchX[i] * mPosXScale, batchY[i] * mPosYScale, batchZ[i] * mPosZScale));
+                    batchResults[i] = Vector4(-normal.x, -normal.y, -normal.z, values[i]);
+                }
+            }
+            else
+            {
+                for (size_t i = 0; i < batchCount; ++i)
+                {
+                    const Vector3 normal = getGradient((size_t)(batchX[i] * mPosXScale + (Real)0.5),
+                        (size_t)(batchY[i] * mPosYScale + (Real)0.5), (size_t)(batchZ[i] * mPosZScale + (Real)0.5));
+                    batchResults[i] = Vector4(-normal.x, -normal.y, -normal.z, values[i]);
+                }
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+    
     size_t GridSource::getWidth(void) const
     {
         return mWidth;
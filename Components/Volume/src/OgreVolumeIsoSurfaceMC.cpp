@@ -44,17 +44,28 @@ namespace Volume {
         unsigned char cubeIndex = 0;
         Vector4 values[8];
 
-        // Find out the case.
-        for (size_t i = 0; i < 8; ++i)
+        if (volumeValues)
         {
-            if (volumeValues)
+            for (size_t i = 0; i < 8; ++i)
             {
                 values[i] = volumeValues[i];
             }
-            else
+        }
+        else
+        {
+            Real x[8], y[8], z[8];
+            for (size_t i = 0; i < 8; ++i)
             {
-                values[i] = mSrc->getValueAndGradient(corners[i]);
+                x[i] = corners[i].x;
+                y[i] = corners[i].y;
+                z[i] = corners[i].z;
             }
+            mSrc->getValuesAndGradients(x, y, z, values, 8);
+        }
+
+        // Find out the case.
+        for (size_t i = 0; i < 8; ++i)
+        {
             if (values[i].w >= ISO_LEVEL)
             {
                 cubeIndex |= 1 << i;
@@ -137,18 +148,34 @@ namespace Volume {
     {
         unsigned char squareIndex = 0;
         Vector4 values[4];
-
-        // Find out the case.
+        Vector4 innerValues[4];
+        Real x[4], y[4], z[4];
         for (size_t i = 0; i < 4; ++i)
         {
-            if (volumeValues)
+            x[i] = corners[indices[i]].x;
+            y[i] = corners[indices[i]].y;
+            z[i] = corners[indices[i]].z;
+        }
+        if (volumeValues)
+        {
+            for (size_t i = 0; i < 4; ++i)
             {
                 values[i] = volumeValues[indices[i]].w;
             }
-            else
+        }
+        else
+        {
+            // The corner values double as the values for the inner normals below.
+            mSrc->getValuesAndGradients(x, y, z, innerValues, 4);
+            for (size_t i = 0; i < 4; ++i)
             {
-                values[i] = mSrc->getValueAndGradient(corners[indices[i]]);
+                values[i] = innerValues[i];
             }
+        }
+
+        // Find out the case.
+        for (size_t i = 0; i < 4; ++i)
+        {
             if (values[i].w >= ISO_LEVEL)
             {
                 squareIndex |= 1 << i;
@@ -171,30 +198,19 @@ namespace Volume {
         intersectionPoints[4] = corners[indices[2]];
         intersectionPoints[6] = corners[indices[3]];
 
-        Vector4 innerVal = mSrc->getValueAndGradient(intersectionPoints[0]);
-        intersectionNormals[0].x = innerVal.x;
-        intersectionNormals[0].y = innerVal.y;
-        intersectionNormals[0].z = innerVal.z;
-        intersectionNormals[0].normalise();
-        intersectionNormals[0] *= innerVal.w + (Real)1.0;
-        innerVal = mSrc->getValueAndGradient(intersectionPoints[2]);
-        intersectionNormals[2].x = innerVal.x;
-        intersectionNormals[2].y = innerVal.y;
-        intersectionNormals[2].z = innerVal.z;
-        intersectionNormals[2].normalise();
-        intersectionNormals[2] *= innerVal.w + (Real)1.0;
-        innerVal = mSrc->getValueAndGradient(intersectionPoints[4]);
-        intersectionNormals[4].x = innerVal.x;
-        intersectionNormals[4].y = innerVal.y;
-        intersectionNormals[4].z = innerVal.z;
-        intersectionNormals[4].normalise();
-        intersectionNormals[4] *= innerVal.w + (Real)1.0;
-        innerVal = mSrc->getValueAndGradient(intersectionPoints[6]);
-        intersectionNormals[6].x = innerVal.x;
-        intersectionNormals[6].y = innerVal.y;
-        intersectionNormals[6].z = innerVal.z;
-        intersectionNormals[6].normalise();
-        intersectionNormals[6] *= innerVal.w + (Real)1.0;
+        if (volumeValues)
+        {
+            mSrc->getValuesAndGradients(x, y, z, innerValues, 4);
+        }
+        for (size_t i = 0; i < 4; ++i)
+        {
+            Vector3 &normal = intersectionNormals[i * 2];
+            normal.x = innerValues[i].x;
+            normal.y = innerValues[i].y;
+            normal.z = innerValues[i].z;
+            normal.normalise();
+            normal *= innerValues[i].w + (Real)1.0;
+        }
 
         if (edge & 1)
         {
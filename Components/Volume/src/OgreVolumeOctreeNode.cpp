@@ -27,6 +27,7 @@ THE SOFTWARE.
 #include "OgreVolumeOctreeNode.h"
 
 #include "OgreVolumeMeshBuilder.h"
+#include "OgreParallelFor.h"
 
 
 namespace Ogre {
@@ -34,6 +35,7 @@ namespace Volume {
     
     const Real OctreeNode::NEAR_FACTOR = (Real)2.0;
     const size_t OctreeNode::OCTREE_CHILDREN_COUNT = 8;
+    const size_t OctreeNode::SPLIT_SUBTREES_PER_THREAD = 16;
     size_t OctreeNode::mGridPositionCount = 0;
     size_t OctreeNode::mNodeI = 0;
     
@@ -101,45 +103,129 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void OctreeNode::createChildren(void)
+    {
+        Vector3 newCenter, xWidth, yWidth, zWidth;
+        OctreeNode::getChildrenDimensions(mFrom, mTo, newCenter, xWidth, yWidth, zWidth);
+        /*
+           4 5
+          7 6
+           0 1
+          3 2
+          0 == from
+          6 == to
+        */
+        mChildren = new OctreeNode*[OCTREE_CHILDREN_COUNT];
+        mChildren[0] = createInstance(mFrom, newCenter);
+        mChildren[1] = createInstance(mFrom + xWidth, newCenter + xWidth);
+        mChildren[2] = createInstance(mFrom + xWidth + zWidth, newCenter + xWidth + zWidth);
+        mChildren[3] = createInstance(mFrom + zWidth, newCenter + zWidth);
+        mChildren[4] = createInstance(mFrom + yWidth, newCenter + yWidth);
+        mChildren[5] = createInstance(mFrom + yWidth + xWidth, newCenter + yWidth + xWidth);
+        mChildren[6] = createInstance(mFrom + yWidth + xWidth + zWidth, newCenter + yWidth + xWidth + zWidth);
+        mChildren[7] = createInstance(mFrom + yWidth + zWidth, newCenter + yWidth + zWidth);
+    }
+    
+    //-----------------------------------------------------------------------
+
     void OctreeNode::split(const OctreeNodeSplitPolicy *splitPolicy, const Source *src, const Real geometricError)
     {
         if (splitPolicy->doSplit(this, geometricError))
         {
-            Vector3 newCenter, xWidth, yWidth, zWidth;
-            OctreeNode::getChildrenDimensions(mFrom, mTo, newCenter, xWidth, yWidth, zWidth);
-            /*
-               4 5
-              7 6
-               0 1
-              3 2
-              0 == from
-              6 == to
-            */
-            mChildren = new OctreeNode*[OCTREE_CHILDREN_COUNT];
-            mChildren[0] = createInstance(mFrom, newCenter);
-            mChildren[0]->split(splitPolicy, src, geometricError);
-            mChildren[1] = createInstance(mFrom + xWidth, newCenter + xWidth);
-            mChildren[1]->split(splitPolicy, src, geometricError);
-            mChildren[2] = createInstance(mFrom + xWidth + zWidth, newCenter + xWidth + zWidth);
-            mChildren[2]->split(splitPolicy, src, geometricError);
-            mChildren[3] = createInstance(mFrom + zWidth, newCenter + zWidth);
-            mChildren[3]->split(splitPolicy, src, geometricError);
-            mChildren[4] = createInstance(mFrom + yWidth, newCenter + yWidth);
-            mChildren[4]->split(splitPolicy, src, geometricError);
-            mChildren[5] = createInstance(mFrom + yWidth + xWidth, newCenter + yWidth + xWidth);
-            mChildren[5]->split(splitPolicy, src, geometricError);
-            mChildren[6] = createInstance(mFrom + yWidth + xWidth + zWidth, newCenter + yWidth + xWidth + zWidth);
-            mChildren[6]->split(splitPolicy, src, geometricError);
-            mChildren[7] = createInstance(mFrom + yWidth + zWidth, newCenter + yWidth + zWidth);
-            mChildren[7]->split(splitPolicy, src, geometricError);
+            createChildren();
+            for (size_t i = 0; i < OCTREE_CHILDREN_COUNT; ++i)
+            {
+                mChildren[i]->split(splitPolicy, src, geometricError);
+            }
         }
         else
         {
-            if (mCenterValue.x == (Real)0.0 && mCenterValue.y == (Real)0.0 && mCenterValue.z == (Real)0.0 && mCenterValue.w == (Real)0.0)
+            evaluateCenterValue(src);
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void OctreeNode::evaluateCenterValue(const Source *src)
+    {
+        if (mCenterValue.x == (Real)0.0 && mCenterValue.y == (Real)0.0 && mCenterValue.z == (Real)0.0 && mCenterValue.w == (Real)0.0)
+        {
+            setCenterValue(src->getValueAndGradient(getCenter()));
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    /** Splits every n-th subtree of a list, run by one thread of splitParallel.
+    */
+    struct SplitWorker
+    {
+        const vector<OctreeNode*>::type *subtrees;
+        const OctreeNodeSplitPolicy *splitPolicy;
+        const Source *src;
+        Real geometricError;
+        size_t first;
+        size_t stride;
+
+        SplitWorker(const vector<OctreeNode*>::type *nodes, const OctreeNodeSplitPolicy *policy, const Source *source, Real error, size_t firstNode, size_t nodeStride) :
+            subtrees(nodes), splitPolicy(policy), src(source), geometricError(error), first(firstNode), stride(nodeStride)
+        {
+        }
+
+        void run()
+        {
+            for (size_t i = first; i < subtrees->size(); i += stride)
             {
-                setCenterValue(src->getValueAndGradient(getCenter()));
+                (*subtrees)[i]->split(splitPolicy, src, geometricError);
             }
         }
+    };
+
+    //-----------------------------------------------------------------------
+
+    void OctreeNode::splitParallel(const OctreeNodeSplitPolicy *splitPolicy, const Source *src, const Real geometricError, size_t threadCount)
+    {
+        if (threadCount <= 1)
+        {
+            split(splitPolicy, src, geometricError);
+            return;
+        }
+
+        // Split level by level on this thread until there are enough subtrees for the
+        // threads to even out their different sizes
+        vector<OctreeNode*>::type subtrees(1, this);
+        vector<OctreeNode*>::type nextLevel;
+        while (!subtrees.empty() && subtrees.size() < threadCount * SPLIT_SUBTREES_PER_THREAD)
+        {
+            nextLevel.clear();
+            for (vector<OctreeNode*>::type::iterator it = subtrees.begin(); it != subtrees.end(); ++it)
+            {
+                OctreeNode *node = *it;
+                if (splitPolicy->doSplit(node, geometricError))
+                {
+                    node->createChildren();
+                    nextLevel.insert(nextLevel.end(), node->mChildren, node->mChildren + OCTREE_CHILDREN_COUNT);
+                }
+                else
+                {
+                    node->evaluateCenterValue(src);
+                }
+            }
+            subtrees.swap(nextLevel);
+        }
+        if (subtrees.empty())
+        {
+            return;
+        }
+
+        threadCount = std::min(threadCount, subtrees.size());
+        vector<SplitWorker>::type workers;
+        workers.reserve(threadCount);
+        for (size_t i = 0; i < threadCount; ++i)
+        {
+            workers.push_back(SplitWorker(&subtrees, splitPolicy, src, geometricError, i, threadCount));
+        }
+        ParallelFor::runWorkers(workers);
     }
     
     //-----------------------------------------------------------------------
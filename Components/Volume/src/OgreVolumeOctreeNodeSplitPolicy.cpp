@@ -59,14 +59,25 @@ namespace Volume {
         }
 
         // Error metric of http://www.andrew.cmu.edu/user/jessicaz/publication/meshing/
-        Real f000 = mSrc->getValue(from);
-        Real f001 = mSrc->getValue(node->getCorner3());
-        Real f010 = mSrc->getValue(node->getCorner4());
-        Real f011 = mSrc->getValue(node->getCorner7());
-        Real f100 = mSrc->getValue(node->getCorner1());
-        Real f101 = mSrc->getValue(node->getCorner2());
-        Real f110 = mSrc->getValue(node->getCorner5());
-        Real f111 = mSrc->getValue(to);
+        const Vector3 corners[8] = {from, node->getCorner3(), node->getCorner4(), node->getCorner7(),
+            node->getCorner1(), node->getCorner2(), node->getCorner5(), to};
+        Real x[19], y[19], z[19];
+        for (size_t i = 0; i < 8; ++i)
+        {
+            x[i] = corners[i].x;
+            y[i] = corners[i].y;
+            z[i] = corners[i].z;
+        }
+        Real cornerValues[8];
+        mSrc->getValues(x, y, z, cornerValues, 8);
+        Real f000 = cornerValues[0];
+        Real f001 = cornerValues[1];
+        Real f010 = cornerValues[2];
+        Real f011 = cornerValues[3];
+        Real f100 = cornerValues[4];
+        Real f101 = cornerValues[5];
+        Real f110 = cornerValues[6];
+        Real f111 = cornerValues[7];
     
         Vector3 gradients[19];
         gradients[9] = Vector3(centerValue.x, centerValue.y, centerValue.z);
@@ -96,13 +107,22 @@ namespace Volume {
         };
 
     
+        for (size_t i = 0; i < 19; ++i)
+        {
+            x[i] = positions[i][0].x;
+            y[i] = positions[i][0].y;
+            z[i] = positions[i][0].z;
+        }
+        Vector4 values[19];
+        mSrc->getValuesAndGradients(x, y, z, values, 19);
+    
         Real error = (Real)0.0;
         Real interpolated, gradientMagnitude;
         Vector4 value;
         Vector3 gradient;
         for (size_t i = 0; i < 19; ++i)
         {
-            value = mSrc->getValueAndGradient(positions[i][0]);
+            value = values[i];
             gradient.x = value.x;
             gradient.y = value.y;
             gradient.z = value.z;
@@ -38,6 +38,7 @@ namespace Ogre {
 	*/
 
 	// Forward declarations
+	struct DDSHeader;
 	struct DXTColourBlock;
 	struct DXTExplicitAlphaBlock;
 	struct DXTInterpolatedAlphaBlock;
@@ -67,6 +68,16 @@ namespace Ogre {
 		/// Unpack DXT alphas into array of 16 colour values
 		void unpackDXTAlpha(const DXTInterpolatedAlphaBlock& block, ColourValue* pCol) const;
 
+		/// Read the header and work out the format the image decodes to
+		void decodeHeader(DataStreamPtr& stream, DDSHeader& header, ImageData& imgData,
+			size_t& numFaces, PixelFormat& sourceFormat, bool& decompressDXT) const;
+		/// Read one level of one face stored in its final format
+		void readLevel(DataStreamPtr& stream, const DDSHeader& header, size_t mip, 
+			const PixelBox& dest) const;
+		/// Gets the number of bytes one level of one face takes up in the file
+		size_t getLevelSize(const DDSHeader& header, size_t mip, size_t width, size_t height,
+			size_t depth, PixelFormat format) const;
+
 		/// Single registered codec instance
 		static DDSCodec* msInstance;
 	public:
@@ -79,6 +90,10 @@ namespace Ogre {
         void codeToFile(MemoryDataStreamPtr& input, const String& outFileName, CodecDataPtr& pData) const;
         /// @copydoc Codec::decode
         DecodeResult decode(DataStreamPtr& input) const;
+        /// @copydoc ImageCodec::canDecodeTo
+        bool canDecodeTo(void) const { return true; }
+        /// @copydoc ImageCodec::decodeTo
+        bool decodeTo(DataStreamPtr& input, DecodeTarget& target) const;
 		/// @copydoc Codec::magicNumberToFileExt
 		String magicNumberToFileExt(const char *magicNumberPtr, size_t maxbytes) const;
         
@@ -279,6 +279,17 @@ namespace Ogre {
 		/** Skip a defined number of bytes. This can also be a negative value, in which case
 		the file pointer rewinds a defined number of bytes. */
 		virtual void skip(long count) = 0;
+
+		/** Gets the next count bytes in place, for streams which hold their data in memory.
+		@remarks
+			This lets loaders hand stream contents straight to their destination (for example
+			HardwareBuffer::writeData) instead of reading them into an intermediate buffer
+			first. The read position is not advanced, skip past the data when done with it.
+		@param count Number of bytes which must be available from the current position
+		@return Pointer to the data at the current position, or 0 if the stream
+			can't provide count bytes in place
+		*/
+		virtual const void* peek(size_t count) { return 0; }
 	
 		/** Repositions the read point to a specified byte.
 	    */
@@ -457,6 +468,10 @@ namespace Ogre {
 		/** @copydoc DataStream::skip
 		*/
 		void skip(long count);
+
+		/** @copydoc DataStream::peek
+		*/
+		const void* peek(size_t count);
 	
 		/** @copydoc DataStream::seek
 		*/
@@ -657,6 +672,78 @@ namespace Ogre {
         */
         void close(void);
 
+	};
+
+	/** Read-only DataStream over a file mapped into memory.
+	@remarks
+		The file contents are paged in by the operating system as they are
+		touched, instead of being read into a heap copy. getPtr and peek give
+		direct access to them, so loaders which can use memory in place (for
+		instance the mesh serializer, image codecs or the script lexer) don't
+		allocate a buffer for the file at all.
+	@par
+		The file must not be changed while it is mapped. Only available on
+		platforms with memory mapped files (Windows desktop, Linux, Apple,
+		Android); the constructor throws on the others.
+	*/
+	class _OgreExport MmapDataStream : public DataStream
+	{
+	protected:
+		uchar* mData;
+		uchar* mPos;
+		uchar* mEnd;
+		/// File and file mapping handles, only used on Windows
+		void* mFileHandle;
+		void* mMappingHandle;
+	public:
+		/** Maps a file.
+		@param name The name to give the stream
+		@param path Path of the file to map
+		*/
+		MmapDataStream(const String& name, const String& path);
+		~MmapDataStream();
+
+		/** Get a pointer to the start of the mapped file, 0 for an empty file. */
+		const uchar* getPtr(void) const { return mData; }
+
+		/** Get a pointer to the current position in the mapped file. */
+		const uchar* getCurrentPtr(void) const { return mPos; }
+
+		/** @copydoc DataStream::read
+		*/
+		size_t read(void* buf, size_t count);
+
+		/** @copydoc DataStream::readLine
+		*/
+		size_t readLine(char* buf, size_t maxCount, const String& delim = "\n");
+
+		/** @copydoc DataStream::skipLine
+		*/
+		size_t skipLine(const String& delim = "\n");
+
+		/** @copydoc DataStream::skip
+		*/
+		void skip(long count);
+
+		/** @copydoc DataStream::peek
+		*/
+		const void* peek(size_t count);
+
+		/** @copydoc DataStream::seek
+		*/
+	    void seek( size_t pos );
+
+		/** @copydoc DataStream::tell
+		*/
+	    size_t tell(void) const;
+
+		/** @copydoc DataStream::eof
+		*/
+	    bool eof(void) const;
+
+        /** @copydoc DataStream::close
+        */
+        void close(void);
 	};
 	/** @} */
 	/** @} */
@@ -227,43 +227,70 @@ namespace Ogre {
                 return a.indexSet < b.indexSet;
             }
         };
-        /** Comparator for unique vertex list */
-        struct vectorLess {
-            bool operator()(const Vector3& a, const Vector3& b) const
+        /** One side of a triangle, used to match the triangles sharing an edge.
+        @remarks
+            Half edges are keyed on the ordered pair of shared vertices, so both
+            windings of an edge sort next to each other. 'seq' is triangleIndex * 3
+            plus the side, which is the order the edges are emitted in.
+        */
+        struct HalfEdge {
+            size_t sharedVertIndex[2]; // lowest shared vertex index first
+            size_t seq;
+            bool reversed;             // true if the triangle runs from [1] to [0]
+        };
+        /** Comparator for sorting half edges by key, then by emission order */
+        struct halfEdgeLess {
+            bool operator()(const HalfEdge& a, const HalfEdge& b) const
             {
-                if (a.x < b.x) return true;
-                if (a.x > b.x) return false;
-                if (a.y < b.y) return true;
-                if (a.y > b.y) return false;
-                return a.z < b.z;
+                if (a.sharedVertIndex[0] < b.sharedVertIndex[0]) return true;
+                if (a.sharedVertIndex[0] > b.sharedVertIndex[0]) return false;
+                if (a.sharedVertIndex[1] < b.sharedVertIndex[1]) return true;
+                if (a.sharedVertIndex[1] > b.sharedVertIndex[1]) return false;
+                return a.seq < b.seq;
             }
         };
+        struct FaceWorker;
+        struct EdgeMatchWorker;
 
         typedef vector<const VertexData*>::type VertexDataList;
         typedef vector<Geometry>::type GeometryList;
         typedef vector<CommonVertex>::type CommonVertexList;
+        typedef vector<HalfEdge>::type HalfEdgeList;
 
         GeometryList mGeometryList;
         VertexDataList mVertexDataList;
         CommonVertexList mVertices;
         EdgeData* mEdgeData;
-		/// Map for identifying common vertices
-		typedef map<Vector3, size_t, vectorLess>::type CommonVertexMap;
-		CommonVertexMap mCommonVertexMap;
-        /** Edge map, used to connect edges. Note we allow many triangles on an edge,
-        after connected an existing edge, we will remove it and never used again.
+        /** Open addressing hash table of indexes into mVertices, keyed on position.
+            The size is a power of two, empty slots hold ~0.
         */
-        typedef multimap< std::pair<size_t, size_t>, std::pair<size_t, size_t> >::type EdgeMap;
-        EdgeMap mEdgeMap;
+        vector<size_t>::type mCommonVertexHash;
+        /** Common vertex index of each original vertex, per vertex set, so every
+            original vertex is only looked up in the hash table once.
+        */
+        vector< vector<size_t>::type >::type mCommonVertexLookup;
+        /// Half edges of all triangles, grouped by bucket once matching starts
+        HalfEdgeList mHalfEdges;
+        /** Matching result per half edge, indexed by seq. Either the index of the
+            triangle on the other side, ~0 for an open edge, or EDGE_CONNECTED if
+            this half edge closed an edge created by an earlier triangle.
+        */
+        vector<size_t>::type mEdgePartners;
+
+        static const size_t EDGE_CONNECTED;
 
-        void buildTrianglesEdges(const Geometry &geometry);
+        /// Reads the triangles of a geometry and welds their vertices
+        void buildTriangles(const Geometry &geometry);
+        /// Computes face normals and half edges of triangles [begin, end)
+        void buildFaces(size_t begin, size_t end);
+        /// Pairs up the half edges of a sorted range, see build()
+        void matchEdges(HalfEdgeList::iterator begin, HalfEdgeList::iterator end);
+        /// Creates the edges in triangle order from the matching results
+        void emitEdges(void);
 
         /// Finds an existing common vertex, or inserts a new one
         size_t findOrCreateCommonVertex(const Vector3& vec, size_t vertexSet, 
             size_t indexSet, size_t originalIndex);
-        /// Connect existing edge or create a new edge - utility method during building
-        void connectOrCreateEdge(size_t vertexSet, size_t triangleIndex, size_t vertIndex0, size_t vertIndex1, 
-            size_t sharedVertIndex0, size_t sharedVertIndex1);
     };
 	/** @} */
 	/** @} */
@@ -225,6 +225,8 @@ namespace Ogre {
         bool mSkipAnimStateUpdates;
         /// Flag indicating whether to update the main entity skeleton even when an LOD is displayed.
         bool mAlwaysUpdateMainSkeleton;
+        /// Flag indicating whether triangle clusters of the SubMeshes are culled per camera.
+        bool mClusterCulling;
 
 
         /// The LOD number of the mesh to use, calculated by _notifyCurrentCamera.
@@ -298,6 +300,8 @@ namespace Ogre {
         bool tempVertexAnimBuffersBound(void) const;
         /// Are software skeleton animation temp buffers bound?
         bool tempSkelAnimBuffersBound(bool requestNormals) const;
+        /// Culls the triangle clusters of each SubEntity against the given camera.
+        void updateClusterCulling(Camera* cam);
 
     public:
         /// Contains the child objects (attached to bones) indexed by name.
@@ -854,6 +858,23 @@ namespace Ogre {
             return mAlwaysUpdateMainSkeleton;
         }
 
+        /** Sets whether the triangle clusters of the mesh are culled for each camera.
+        @remarks
+            SubMeshes with clusters (see SubMesh::buildClusters) then only render the
+            clusters which intersect the view frustum and, when the material culls back
+            faces, don't face away from the camera. The visible clusters are copied into a
+            dynamic index buffer per SubEntity, so this pays off for large meshes which are
+            often seen only in part, like terrain pieces or buildings.
+        @par
+            Clusters are only culled at full detail, for entities which are neither
+            skeletally nor vertex animated, and when the index buffer has a shadow buffer
+            to read the clusters from.
+        */
+        void setClusterCulling(bool enabled);
+
+        /// Gets whether the triangle clusters of the mesh are culled for each camera.
+        bool getClusterCulling(void) const { return mClusterCulling; }
+
         
     };
 
@@ -119,7 +119,26 @@ namespace Ogre {
             return msIgnoreHidden;
         }
 
+        /** Set whether files opened read-only are memory mapped (see MmapDataStream).
+        @remarks
+            Mapped files are read straight from the operating system's page cache
+            rather than through a stream buffer, and loaders which can use their
+            contents in place avoid copying them to the heap. Files which can't be
+            mapped are opened as usual. The default is false.
+        */
+        static void setUseMemoryMapping(bool mmap)
+        {
+            msUseMemoryMapping = mmap;
+        }
+
+        /// Get whether files opened read-only are memory mapped.
+        static bool getUseMemoryMapping()
+        {
+            return msUseMemoryMapping;
+        }
+
         static bool msIgnoreHidden;
+        static bool msUseMemoryMapping;
     };
 
     /** Specialisation of ArchiveFactory for FileSystem files. */
@@ -36,6 +36,7 @@ THE SOFTWARE.
 #include "OgreHardwareIndexBuffer.h"
 #include "OgreHardwareUniformBuffer.h"
 #include "OgreHardwareVertexBuffer.h"
+#include "OgreHardwarePixelBuffer.h"
 #include "OgreRenderToVertexBuffer.h"
 #include "OgreHeaderPrefix.h"
 
@@ -114,6 +115,9 @@ namespace Ogre {
     {
         friend class HardwareVertexBufferSharedPtr;
         friend class HardwareIndexBufferSharedPtr;
+    public:
+        /// Identifies an upload queued with queueUpload.
+        typedef size_t UploadTicket;
     protected:
         /** WARNING: The following two members should place before all other members.
             Members destruct order is very important here, because destructing other
@@ -211,6 +215,46 @@ namespace Ogre {
         OGRE_MUTEX(mTempBuffersMutex)
 
 
+        /// A write into a hardware buffer waiting for _flushUploads, both destinations are null once cancelled
+        struct QueuedUpload
+        {
+            UploadTicket ticket;
+            /// Destination when writing a vertex, index or other plain buffer
+            SharedPtr<HardwareBuffer> buffer;
+            size_t offset;
+            size_t length;
+            const void* data;
+            /// Destination when writing a pixel buffer
+            HardwarePixelBufferSharedPtr pixelBuffer;
+            PixelBox src;
+            Image::Box dstBox;
+        };
+        typedef deque<QueuedUpload>::type UploadQueue;
+        UploadQueue mUploads;
+
+        /// Part of the staging ring handed out by reserveUploadStaging
+        struct StagingReservation
+        {
+            size_t start;
+            size_t size;
+            /// Set by releaseUploadStaging, the memory is then reused once
+            /// the uploads queued up to releaseTicket are done
+            bool released;
+            UploadTicket releaseTicket;
+        };
+        typedef deque<StagingReservation>::type StagingReservationList;
+        StagingReservationList mStagingReservations;
+        uchar* mStagingRing;
+        size_t mStagingSize;
+        size_t mUploadBytesPerFrame;
+        /// Ticket of the next upload queued, and of the last one done
+        UploadTicket mNextUploadTicket;
+        UploadTicket mCompletedUploadTicket;
+        OGRE_MUTEX(mUploadMutex)
+
+        /// Reuses the staging memory of the released reservations whose uploads are done
+        void retireStagingReservations(void);
+
         /// Creates a new buffer as a copy of the source, does not copy data.
         virtual HardwareVertexBufferSharedPtr makeBufferCopy(
             const HardwareVertexBufferSharedPtr& source, 
@@ -415,6 +459,76 @@ namespace Ogre {
         */
         virtual void _forceReleaseBufferCopies(HardwareVertexBuffer* sourceBuffer);
 
+        /** Sets the size of the ring of memory reserveUploadStaging hands out.
+        @remarks
+            The ring is allocated on first use and can only be resized while no
+            staging memory is reserved. 16MB by default.
+        */
+        virtual void setUploadStagingSize(size_t bytes);
+        /** Gets the size of the ring of staging memory for uploads. */
+        virtual size_t getUploadStagingSize(void) const { return mStagingSize; }
+        /** Sets how many bytes _flushUploads writes into buffers each frame at most.
+        @remarks
+            Uploads beyond that wait for the next frame, which spreads the cost of
+            large loads over several frames. At least one upload is done per frame
+            whatever its size. Unlimited by default.
+        */
+        virtual void setUploadBytesPerFrame(size_t bytes);
+        /** Gets how many bytes _flushUploads writes into buffers each frame at most. */
+        virtual size_t getUploadBytesPerFrame(void) const { return mUploadBytesPerFrame; }
+
+        /** Reserves staging memory for data to upload into hardware buffers.
+        @remarks
+            Thread safe, meant for worker threads preparing resources to fill with
+            the data they load, which is then passed to queueUpload. The memory
+            stays reserved until releaseUploadStaging, and is reused once the
+            uploads queued before that are done.
+        @return 0 if the ring has no room for this many bytes until more uploads
+            are done, the caller should then use memory of its own
+        */
+        virtual void* reserveUploadStaging(size_t bytes);
+        /** Hands back staging memory from reserveUploadStaging. Thread safe.
+        @remarks
+            Call it once every upload of the memory is queued; it's only reused
+            when those uploads are done.
+        */
+        virtual void releaseUploadStaging(void* staging);
+
+        /** Queues a write of data into part of a vertex, index or other buffer.
+        @remarks
+            Thread safe. The write is done on the render thread by _flushUploads
+            at the end of a frame, in the order uploads are queued. The data must
+            stay valid until then, which staging memory does until released.
+        @par
+            Within OGRE only texture streaming queues uploads, see
+            TextureManager::setStreamingBudget; other resources still write
+            their buffers as they load.
+        @return ticket to check whether the upload is done with isUploadComplete
+        */
+        virtual UploadTicket queueUpload(const SharedPtr<HardwareBuffer>& buffer, size_t offset, 
+            size_t length, const void* data);
+        /** Queues a write of pixels into part of a pixel buffer, such as a texture level.
+            Otherwise as queueUpload for other buffers.
+        */
+        virtual UploadTicket queueUpload(const HardwarePixelBufferSharedPtr& buffer, const PixelBox& src,
+            const Image::Box& dstBox);
+        /** Returns whether an upload is done. Thread safe. */
+        virtual bool isUploadComplete(UploadTicket ticket) const;
+        /** Drops the queued uploads into a buffer which is about to be destroyed. Thread safe.
+        @remarks
+            Their tickets complete with the next _flushUploads as if they were made.
+        */
+        virtual void _cancelUploads(const HardwareBuffer* buffer);
+        /** Gets the number of uploads waiting for _flushUploads. */
+        virtual size_t getPendingUploadCount(void) const;
+
+        /** Does the queued uploads into hardware buffers.
+        @remarks
+            Called by Root at the end of each frame, must be called from the render thread.
+        @param all Whether to do all of them regardless of setUploadBytesPerFrame
+        */
+        virtual void _flushUploads(bool all = false);
+
         /// Notification that a hardware vertex buffer has been destroyed.
         void _notifyVertexBufferDestroyed(HardwareVertexBuffer* buf);
         /// Notification that a hardware index buffer has been destroyed.
@@ -543,6 +657,68 @@ namespace Ogre {
         {
             mImpl->_forceReleaseBufferCopies(sourceBuffer);
         }
+        /** @copydoc HardwareBufferManagerBase::setUploadStagingSize */
+        virtual void setUploadStagingSize(size_t bytes)
+        {
+            mImpl->setUploadStagingSize(bytes);
+        }
+        /** @copydoc HardwareBufferManagerBase::getUploadStagingSize */
+        virtual size_t getUploadStagingSize(void) const
+        {
+            return mImpl->getUploadStagingSize();
+        }
+        /** @copydoc HardwareBufferManagerBase::setUploadBytesPerFrame */
+        virtual void setUploadBytesPerFrame(size_t bytes)
+        {
+            mImpl->setUploadBytesPerFrame(bytes);
+        }
+        /** @copydoc HardwareBufferManagerBase::getUploadBytesPerFrame */
+        virtual size_t getUploadBytesPerFrame(void) const
+        {
+            return mImpl->getUploadBytesPerFrame();
+        }
+        /** @copydoc HardwareBufferManagerBase::reserveUploadStaging */
+        virtual void* reserveUploadStaging(size_t bytes)
+        {
+            return mImpl->reserveUploadStaging(bytes);
+        }
+        /** @copydoc HardwareBufferManagerBase::releaseUploadStaging */
+        virtual void releaseUploadStaging(void* staging)
+        {
+            mImpl->releaseUploadStaging(staging);
+        }
+        /** @copydoc HardwareBufferManagerBase::queueUpload(const SharedPtr<HardwareBuffer>&, size_t, size_t, const void*) */
+        virtual UploadTicket queueUpload(const SharedPtr<HardwareBuffer>& buffer, size_t offset, 
+            size_t length, const void* data)
+        {
+            return mImpl->queueUpload(buffer, offset, length, data);
+        }
+        /** @copydoc HardwareBufferManagerBase::queueUpload(const HardwarePixelBufferSharedPtr&, const PixelBox&, const Image::Box&) */
+        virtual UploadTicket queueUpload(const HardwarePixelBufferSharedPtr& buffer, const PixelBox& src,
+            const Image::Box& dstBox)
+        {
+            return mImpl->queueUpload(buffer, src, dstBox);
+        }
+        /** @copydoc HardwareBufferManagerBase::isUploadComplete */
+        virtual bool isUploadComplete(UploadTicket ticket) const
+        {
+            return mImpl->isUploadComplete(ticket);
+        }
+        /** @copydoc HardwareBufferManagerBase::_cancelUploads */
+        virtual void _cancelUploads(const HardwareBuffer* buffer)
+        {
+            mImpl->_cancelUploads(buffer);
+        }
+        /** @copydoc HardwareBufferManagerBase::getPendingUploadCount */
+        virtual size_t getPendingUploadCount(void) const
+        {
+            return mImpl->getPendingUploadCount();
+        }
+        /** @copydoc HardwareBufferManagerBase::_flushUploads */
+        virtual void _flushUploads(bool all = false)
+        {
+            mImpl->_flushUploads(all);
+        }
         /** @copydoc HardwareBufferManagerBase::_notifyVertexBufferDestroyed */
         void _notifyVertexBufferDestroyed(HardwareVertexBuffer* buf)
         {
@@ -152,7 +152,15 @@ namespace Ogre {
         VET_UINT1 = 24,
         VET_UINT2 = 25,
         VET_UINT3 = 26,
-        VET_UINT4 = 27
+        VET_UINT4 = 27,
+        /// Half precision floats, read as float2 by shaders
+        VET_HALF2 = 28,
+        /// Half precision floats, read as float4 by shaders
+        VET_HALF4 = 29,
+        /// Signed shorts normalised to [-1, 1], read as float2 by shaders
+        VET_SHORT2_SNORM = 30,
+        /// Signed shorts normalised to [-1, 1], read as float4 by shaders
+        VET_SHORT4_SNORM = 31
     };
 
     /** This class declares the usage of a single vertex buffer as a component
@@ -454,7 +454,9 @@ namespace Ogre {
 			FILTER_BILINEAR,
 			FILTER_BOX,
 			FILTER_TRIANGLE,
-			FILTER_BICUBIC
+			FILTER_BICUBIC,
+			/// Kaiser windowed sinc, only used by generateMipmaps
+			FILTER_KAISER
 		};
 		/** Scale a 1D, 2D or 3D image volume. 
 			@param 	src			PixelBox containing the source pointer, dimensions and format
@@ -467,6 +469,33 @@ namespace Ogre {
 		
 		/** Resize a 2D image, applying the appropriate filter. */
 		void resize(ushort width, ushort height, Filter filter = FILTER_BILINEAR);
+
+		/** Generate the mipmaps of this image on the CPU, replacing any it already has.
+			@param 	numMipmaps	How many mipmaps to generate below the top level, clamped to a full chain
+			@param 	filter		FILTER_KAISER for a Kaiser windowed sinc, anything else averages 2x2 blocks
+			@param 	gammaCorrect	Treat the colour channels as sRGB and filter them in linear space
+			@return	false if the format can't be filtered (compressed formats)
+			@remarks
+				Each level is filtered from the one above in bands of rows, on as many threads
+				as the hardware has when Ogre is built with thread support. 3D images average
+				pairs of slices, cube maps are filtered face by face. A dynamic image gets a
+				buffer of its own; the buffer it was given is not touched.
+		*/
+		bool generateMipmaps(size_t numMipmaps, Filter filter = FILTER_BOX, bool gammaCorrect = false);
+
+		/** Compress this image to a block compressed format on the CPU, mipmaps and faces included.
+			@param 	format		The block compressed format, see PixelUtil::canCompressTo
+			@param 	quality		Speed against quality trade-off
+			@return	false if the image is compressed already, is 3D or there is no encoder for the format
+			@remarks
+				Generate the mipmaps first if they are wanted, compressed images can't be filtered.
+		*/
+		bool compress(PixelFormat format, CompressionQuality quality = CQ_NORMAL);
+
+		/** Copy the levels of this image from the given mipmap down into another image,
+			which then has that mipmap as its top level. All faces are copied.
+		*/
+		void copyMipmapTail(size_t mipmap, Image& dest) const;
 		
         /// Static function to calculate size in bytes from the number of mipmaps, faces and the dimensions
         static size_t calculateSize(size_t mipmaps, size_t faces, size_t width, size_t height, size_t depth, PixelFormat format);
@@ -75,11 +75,50 @@ namespace Ogre {
             }
         };
 
+        /** Destination which decodeTo writes the levels of an image into.
+        @remarks
+            Lets a codec write straight into memory the caller provides, such as a
+            locked hardware pixel buffer, rather than into the buffer decode returns.
+        */
+        class _OgreExport DecodeTarget
+        {
+        public:
+            virtual ~DecodeTarget() {}
+            /** Called once the image is described, before any pixel data is read.
+            @param data The size, format, flags and mipmaps of the image
+            @param numFaces The number of faces, 6 for a cube map and 1 otherwise
+            @return false to decline, decodeTo then returns false too
+            */
+            virtual bool begin(const ImageData& data, size_t numFaces) = 0;
+            /** Gets the memory to decode one level of one face into, in the format
+                of the image and with the size of that level. */
+            virtual PixelBox lock(size_t face, size_t mipmap) = 0;
+            /** Called once the level given to lock has been written. */
+            virtual void unlock(size_t face, size_t mipmap) = 0;
+            /** Returns whether one level of one face is not needed. The codec then
+                seeks past it in the file instead of locking it. */
+            virtual bool skip(size_t face, size_t mipmap) { (void)face; (void)mipmap; return false; }
+        };
+
     public:
         String getDataType() const
         {
             return "ImageData";
         }
+
+        /** Returns whether this codec implements decodeTo. */
+        virtual bool canDecodeTo(void) const { return false; }
+
+        /** Decodes an image straight into memory provided by a target, saving the
+            copy through the buffer decode returns.
+        @remarks
+            Only possible when the stored data needs no conversion, so a codec may
+            refuse depending on the format of the image, as may the target.
+        @return true if the image was decoded, false if it was refused. The stream
+            is then back where it was and the image can still be read with decode.
+        */
+        virtual bool decodeTo(DataStreamPtr& input, DecodeTarget& target) const
+        { (void)input; (void)target; return false; }
     };
 
 	/** @} */
@@ -102,10 +102,39 @@ struct LodLevel {
 };
 
 struct LodConfig {
+	/**
+	 * @brief The way ProgressiveMeshGenerator measures the error of collapsing an edge.
+	 */
+	enum ErrorMetric {
+		/**
+		 * @brief Curvature heuristic based on the normals of the surrounding faces.
+		 */
+		EM_CURVATURE,
+
+		/**
+		 * @brief Quadric error metric: squared distance to the planes of the original surface
+		 * around the vertex, relative to the mesh radius.
+		 *
+		 * Cheaper to evaluate than curvature and more even at aggressive reduction.
+		 * Mesh borders are held in place by constraint planes and vertices on texture
+		 * or normal seams are collapsed last, so attribute discontinuities survive.
+		 */
+		EM_QUADRIC
+	};
+
 	MeshPtr mesh;
 	LodStrategy* strategy;
 	typedef std::vector<LodLevel> LodLevelList;
 	LodLevelList levels;
+
+	/**
+	 * @brief Error metric used to order the collapses, EM_CURVATURE by default.
+	 *
+	 * Collapse costs of VRM_COLLAPSE_COST levels are interpreted in this metric.
+	 */
+	ErrorMetric errorMetric;
+
+	LodConfig() : strategy(0), errorMetric(EM_CURVATURE) { }
 };
 }
 #endif
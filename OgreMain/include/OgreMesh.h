@@ -160,6 +160,11 @@ namespace Ogre {
 
         const LodStrategy *mLodStrategy;
         bool mIsLodManual;
+        bool mLodStreaming;
+        /// Set while the geometry of LOD 0 is streamed out
+        bool mFullDetailEvicted;
+        /// Mesh the geometry of LOD 0 is streamed in through, created when first needed
+        mutable ResourcePtr mFullDetailMesh;
         ushort mNumLods;
         MeshLodUsageList mMeshLodUsageList;
 
@@ -206,6 +211,9 @@ namespace Ogre {
         /// @copydoc Resource::calculateSize
         size_t calculateSize(void) const;
 
+        /// Notifies the MeshManager that a streamed level is needed, returns whether it's in memory
+        bool touchLodLevel(ushort index) const;
+
 		void mergeAdjacentTexcoords( unsigned short finalTexCoordSet,
 									 unsigned short texCoordSetToDestroy, VertexData *vertexData );
 
@@ -482,6 +490,49 @@ namespace Ogre {
         */
         bool isLodManual(void) const { return mIsLodManual; }
 
+        /** Sets whether the manual LOD levels of this mesh are streamed.
+        @remarks
+            By default every manual LOD mesh is loaded as soon as an Entity is 
+            created from this mesh. When streaming, only the coarsest level is 
+            loaded up front, and it stays in memory. The finer levels, including 
+            the geometry of this mesh itself which is LOD 0, are loaded through 
+            the ResourceBackgroundQueue once an Entity actually needs them. Until 
+            they are in memory the nearest coarser level in memory is displayed. 
+            Levels not displayed for a while are unloaded again when the 
+            MeshManager's LOD streaming budget is exceeded.
+        @par
+            This only applies to manual LOD; generated LOD levels share the 
+            vertex data of the full mesh and are always resident. The geometry 
+            of LOD 0 also stays resident if the mesh can't be reloaded, from its 
+            file or its ManualResourceLoader, or if it's animated.
+        */
+        void setLodStreaming(bool stream);
+        /** Gets whether the manual LOD levels of this mesh are streamed. */
+        bool isLodStreaming(void) const { return mLodStreaming; }
+        /** Gets whether the geometry of LOD 0 is streamed, see setLodStreaming. */
+        bool isFullDetailStreamed(void) const;
+
+        /** Returns whether the given LOD level can be displayed right now. */
+        bool isLodLevelResident(ushort index) const;
+
+        /** Returns the LOD level to display when the given one is wanted.
+        @remarks
+            Without LOD streaming this is the given level. Otherwise the level is
+            requested if it is not loaded yet, and the nearest coarser level in 
+            memory is returned meanwhile. Internal method used by Entity.
+        */
+        ushort _requestLodLevel(ushort index) const;
+
+        /** Takes over the geometry of a mesh loaded from the same source, making 
+            LOD 0 resident again. Internal method used by MeshManager.
+        @return false if the geometry doesn't match this mesh
+        */
+        bool _adoptFullDetail(Mesh* source);
+        /** Releases the geometry of LOD 0. Internal method used by MeshManager. */
+        void _evictFullDetail(void);
+        /** Gets the memory used by the geometry of LOD 0, 0 while streamed out. */
+        size_t _getFullDetailSize(void) const;
+
         /** Internal methods for loading LOD, do not use. */
         void _setLodInfo(unsigned short numLevels, bool isManual);
         /** Internal methods for loading LOD, do not use. */
@@ -672,6 +723,40 @@ namespace Ogre {
         /** Destroys and frees the edge lists this mesh has built. */
         void freeEdgeList(void);
 
+        /** Reorders the geometry of this mesh for the post-transform vertex cache.
+        @remarks
+            Reorders the triangle lists of every SubMesh and generated LOD level, then
+            renumbers shared and dedicated vertices in first-use order so vertex fetches
+            become sequential. Bone assignments are updated and edge lists rebuilt
+            accordingly. Meant to be run offline, e.g. by the MeshUpgrader tool, as it
+            locks every buffer in normal mode.
+        @param reorderVertices
+            Whether vertices may be reordered as well. Vertex data used by morph or pose
+            animation, by shadow volumes or without indices keeps its order regardless.
+        */
+        void optimiseVertexCache(bool reorderVertices = true);
+
+        /** Converts the vertex data of this mesh to compact formats, see VertexData::quantise.
+        @remarks
+            Roughly halves the size of typical vertices. Vertex programs read quantised
+            positions through the custom parameters described by
+            SubEntity::CUSTOM_PARAM_POSITION_SCALE, so positions are only quantised where
+            every pass of every technique of the materials using them has a vertex program
+            binding both the scale and the bias; they stay float otherwise. Meshes with a
+            skeleton or poses, vertex data with morph animation and meshes prepared for
+            shadow volumes are left alone since their CPU paths read floats. Edge lists and
+            Lod generation decode quantised positions, tangent generation needs float normals.
+        @return
+            True if any vertex data was converted.
+        */
+        bool quantiseVertexData(bool positions = true, bool normals = true,
+            bool textureCoordinates = true);
+
+        /** Whether every pass of the named material applies the position scale and bias
+            of quantised vertex data, see quantiseVertexData.
+        */
+        bool materialDequantisesPositions(const String& materialName) const;
+
         /** This method prepares the mesh for generating a renderable shadow volume. 
         @remarks
             Preparing a mesh to generate a shadow volume involves firstly ensuring that the 
@@ -83,6 +83,17 @@ namespace Ogre {
                 M_SUBMESH_TEXTURE_ALIAS = 0x4200, // Repeating section
                     // char* aliasName;
                     // char* textureName;
+				// Optional chunk describing triangle clusters (see SubMesh::buildClusters), v1.10+
+				// the index buffer is already ordered so each cluster is contiguous
+                M_SUBMESH_CLUSTERS = 0x4300,
+                    // unsigned int clusterCount
+                    // repeated clusterCount times:
+                    // unsigned int indexStart;
+                    // unsigned int indexCount;
+                    // float center[3];
+                    // float radius;
+                    // float coneAxis[3];
+                    // float coneCutoff;
 
             M_GEOMETRY          = 0x5000, // NB this chunk is embedded within M_MESH and M_SUBMESH
                 // unsigned int vertexCount
@@ -98,6 +109,9 @@ namespace Ogre {
 					// unsigned short vertexSize;	// Per-vertex size, must agree with declaration at this index
 					M_GEOMETRY_VERTEX_BUFFER_DATA = 0x5210,
 						// raw buffer data
+				M_GEOMETRY_VERTEX_QUANTISATION = 0x5300, // Optional, present if positions are quantised (v1.10+)
+					// float positionScale[3];
+					// float positionBias[3];
             M_MESH_SKELETON_LINK = 0x6000,
                 // Optional link to skeleton
                 // char* skeletonName           : name of .skeleton to use
@@ -36,6 +36,7 @@ THE SOFTWARE.
 #include "OgreHardwareBuffer.h"
 #include "OgreMesh.h"
 #include "OgrePatchMesh.h"
+#include "OgreResourceBackgroundQueue.h"
 #include "OgreHeaderPrefix.h"
 
 namespace Ogre {
@@ -421,10 +422,67 @@ namespace Ogre {
 		*/
 		MeshSerializerListener *getListener();
 
+        /** Sets the memory budget for streamed LOD levels.
+        @remarks
+            When meshes stream their manual LOD levels (see Mesh::setLodStreaming), 
+            the LOD meshes which have not been displayed recently are unloaded 
+            again, least recently used first, whenever the LOD meshes in memory 
+            use more than this many bytes. The budget is checked every frame. 
+            Unlimited by default.
+        @par
+            Only LOD meshes which were loaded by streaming count against the budget
+            and are unloaded; a LOD mesh which was already loaded when it was first
+            streamed is left alone.
+        */
+        void setLodStreamingBudget(size_t bytes);
+        /** Gets the memory budget for streamed LOD levels. */
+        size_t getLodStreamingBudget(void) const { return mLodStreamingBudget; }
+        /** Gets the memory used by the streamed LOD levels currently loaded. */
+        size_t getLodStreamingMemoryUsage(void) const;
+
+        /** Returns whether any LOD meshes are streamed. */
+        bool _hasStreamedLods(void) const { return !mStreamedLods.empty(); }
+        /** Picks up finished background loads and enforces the LOD streaming budget.
+        @remarks
+            Called by Root once per frame.
+        */
+        void _updateLodStreaming(void);
+        /** Registers an Entity built from a streamed LOD mesh.
+        @remarks
+            The entity is deinitialised before its mesh is unloaded, and initialised
+            again by its parent Entity when the level is displayed. Internal method
+            used by Entity.
+        */
+        void _addStreamedLodEntity(Entity* lodEntity);
+        /** Unregisters an Entity registered with _addStreamedLodEntity. */
+        void _removeStreamedLodEntity(Entity* lodEntity);
+
+        /** Creates the mesh through which the geometry of LOD 0 of a mesh is streamed.
+        @remarks
+            The mesh is loaded from the same file as the given mesh, or by the 
+            given loader if that is not 0. Once loaded, its geometry is handed 
+            over to the given mesh. Internal method used by Mesh.
+        */
+        MeshPtr _createFullDetailMesh(Mesh* mesh, ManualResourceLoader* loader);
+
+        /** Notifies the manager that a streamed LOD mesh is needed this frame.
+        @remarks
+            If the mesh is not loaded yet, it is queued for loading through the
+            ResourceBackgroundQueue. Internal method used by Mesh.
+        @return true if the mesh is loaded and can be displayed now
+        */
+        bool _touchStreamedLod(const MeshPtr& lodMesh);
+
         /** @see ManualResourceLoader::loadResource */
         void loadResource(Resource* res);
 
+        /** @copydoc ResourceManager::removeAll */
+        void removeAll(void);
+
     protected:
+        /// @copydoc ResourceManager::removeImpl
+        void removeImpl(ResourcePtr& res);
+
         /// @copydoc ResourceManager::createImpl
         Resource* createImpl(const String& name, ResourceHandle handle, 
             const String& group, bool isManual, ManualResourceLoader* loader, 
@@ -488,6 +546,45 @@ namespace Ogre {
 
 		// The listener to pass to serializers
 		MeshSerializerListener *mListener;
+
+		/// Bookkeeping for a LOD mesh which is streamed in and out
+		struct StreamedLod
+		{
+			MeshPtr mesh;
+			/// Frame number in which the mesh was last needed
+			unsigned long lastUsedFrame;
+			/// Pending background load, 0 if none
+			BackgroundProcessTicket ticket;
+			/// Set if a load completed without loading the mesh, it's not retried
+			bool failed;
+			/// Set while the mesh is loaded because it was streamed in, only then it's unloaded again
+			bool streamedIn;
+			/// LOD entities built from the mesh
+			set<Entity*>::type entities;
+			/// Mesh taking over the geometry once loaded, for meshes streaming LOD 0
+			Mesh* fullDetailOf;
+		};
+		typedef map<ResourceHandle, StreamedLod>::type StreamedLodMap;
+		StreamedLodMap mStreamedLods;
+		size_t mLodStreamingBudget;
+
+		/// Gets the bookkeeping for a streamed LOD mesh, starting it if needed
+		StreamedLod& getStreamedLod(const MeshPtr& lodMesh);
+		/// Picks up the background load of a LOD mesh if it's done, returns whether it was
+		bool checkStreamedLodLoad(StreamedLod& lod);
+		/// Takes a LOD mesh which finished loading into use
+		void finishStreamedLodLoad(StreamedLod& lod);
+		/// Returns whether the streamed geometry is in memory and can be unloaded again
+		bool isStreamedLodResident(const StreamedLod& lod) const;
+		/// Gets the memory used by the streamed geometry
+		size_t getStreamedLodSize(const StreamedLod& lod) const;
+
+		/// Files the geometry of LOD 0 is streamed from, by the mesh loading it
+		typedef map<Resource*, std::pair<String, String> >::type FullDetailSourceMap;
+		FullDetailSourceMap mFullDetailSources;
+		OGRE_MUTEX(mFullDetailSourcesMutex)
+		/// Unloads the least recently used streamed LOD meshes until within budget
+		void enforceLodStreamingBudget(void);
     };
 
 	/** @} */
@@ -55,7 +55,7 @@ namespace Ogre {
     will remain to load the latest version.
 
 	 @note
-		This mesh format was used from Ogre v1.8.
+		This mesh format was used from Ogre v1.10.
 
     */
     class _OgrePrivate MeshSerializerImpl : public Serializer
@@ -91,6 +91,7 @@ namespace Ogre {
         virtual void writeSubMesh(const SubMesh* s);
         virtual void writeSubMeshOperation(const SubMesh* s);
         virtual void writeSubMeshTextureAliases(const SubMesh* s);
+        virtual void writeSubMeshClusters(const SubMesh* s);
         virtual void writeGeometry(const VertexData* pGeom);
         virtual void writeSkeletonLink(const String& skelName);
         virtual void writeMeshBoneAssignment(const VertexBoneAssignment& assign);
@@ -132,6 +133,7 @@ namespace Ogre {
 		virtual size_t calcPoseKeyframePoseRefSize(void);
 		virtual size_t calcPoseVertexSize(const Pose* pose);
         virtual size_t calcSubMeshTextureAliasesSize(const SubMesh* pSub);
+        virtual size_t calcSubMeshClustersSize(const SubMesh* pSub);
 
 
         virtual void readTextureLayer(DataStreamPtr& stream, Mesh* pMesh, MaterialPtr& pMat);
@@ -140,10 +142,12 @@ namespace Ogre {
         virtual void readSubMesh(DataStreamPtr& stream, Mesh* pMesh, MeshSerializerListener *listener);
         virtual void readSubMeshOperation(DataStreamPtr& stream, Mesh* pMesh, SubMesh* sub);
         virtual void readSubMeshTextureAlias(DataStreamPtr& stream, Mesh* pMesh, SubMesh* sub);
+        virtual void readSubMeshClusters(DataStreamPtr& stream, Mesh* pMesh, SubMesh* sub);
         virtual void readGeometry(DataStreamPtr& stream, Mesh* pMesh, VertexData* dest);
         virtual void readGeometryVertexDeclaration(DataStreamPtr& stream, Mesh* pMesh, VertexData* dest);
         virtual void readGeometryVertexElement(DataStreamPtr& stream, Mesh* pMesh, VertexData* dest);
         virtual void readGeometryVertexBuffer(DataStreamPtr& stream, Mesh* pMesh, VertexData* dest);
+        virtual void readGeometryVertexQuantisation(DataStreamPtr& stream, Mesh* pMesh, VertexData* dest);
 
         virtual void readSkeletonLink(DataStreamPtr& stream, Mesh* pMesh, MeshSerializerListener *listener);
         virtual void readMeshBoneAssignment(DataStreamPtr& stream, Mesh* pMesh);
@@ -157,6 +161,43 @@ namespace Ogre {
         virtual void readBoundsInfo(DataStreamPtr& stream, Mesh* pMesh);
         virtual void readEdgeList(DataStreamPtr& stream, Mesh* pMesh);
         virtual void readEdgeListLodInfo(DataStreamPtr& stream, EdgeData* edgeData);
+
+        /// One LOD level of an edge list chunk, located in memory for concurrent decoding
+        struct EdgeListLodJob
+        {
+            unsigned short lodIndex;
+            const uchar* data;
+            size_t size;
+            EdgeData* edgeData;
+            bool succeeded;
+        };
+        typedef vector<EdgeListLodJob>::type EdgeListLodJobList;
+
+        /// Decodes every stride-th job of a list, run by one thread of readEdgeListParallel
+        struct EdgeListLodDecoder
+        {
+            MeshSerializerImpl* serializer;
+            EdgeListLodJobList* jobs;
+            size_t first;
+            size_t stride;
+
+            EdgeListLodDecoder(MeshSerializerImpl* s, EdgeListLodJobList* j, size_t f, size_t st)
+                : serializer(s), jobs(j), first(f), stride(st) {}
+            void run();
+        };
+
+        /** Reads the LOD levels of an edge list chunk on several threads. The chunk lengths
+            serve as table of contents, so this needs the whole chunk to be in memory.
+        @remarks
+            Only pays off for meshes with at least two generated LOD levels; for other
+            meshes it reads nothing.
+        @return false if nothing was read and the levels have to be read serially
+        */
+        virtual bool readEdgeListParallel(DataStreamPtr& stream, Mesh* pMesh);
+        /// Decodes a single located LOD level, safe to run concurrently
+        virtual void decodeEdgeListLod(EdgeListLodJob& job);
+        /// Points the edge groups of a LOD level at the vertex data they refer to
+        virtual void resolveEdgeGroupVertexData(Mesh* pMesh, EdgeData* edgeData);
 		virtual void readPoses(DataStreamPtr& stream, Mesh* pMesh);
 		virtual void readPose(DataStreamPtr& stream, Mesh* pMesh);
 		virtual void readAnimations(DataStreamPtr& stream, Mesh* pMesh);
@@ -167,6 +208,68 @@ namespace Ogre {
 		virtual void readPoseKeyFrame(DataStreamPtr& stream, VertexAnimationTrack* track);
 		virtual void readExtremes(DataStreamPtr& stream, Mesh *pMesh);
 
+        /** A vertex, index, morph keyframe or pose payload located in the stream memory.
+        @remarks
+            When the whole mesh is in memory, readMesh only records where the payloads
+            are. Once it is done they are decoded on several threads into system memory,
+            after which the hardware buffers are created on the loading thread.
+        */
+        struct PayloadJob
+        {
+            enum Type
+            {
+                PT_VERTEX_BUFFER,
+                PT_INDEX_BUFFER,
+                PT_MORPH_KEYFRAME,
+                PT_POSE
+            };
+            Type type;
+            const uchar* data;
+            size_t size;
+            /// Vertex data to bind the buffer to, or whose vertex count a keyframe covers
+            VertexData* vertexData;
+            unsigned short bindIndex;
+            IndexData* indexData;
+            VertexMorphKeyFrame* keyFrame;
+            Pose* pose;
+            /// 32 bit indexes, or normals included in a keyframe or pose
+            bool wideOrNormals;
+            /// Decoded copy, or 0 if the payload needed no conversion and is used in place
+            void* staging;
+        };
+        typedef vector<PayloadJob>::type PayloadJobList;
+
+        /// Decodes every stride-th job of a list, run by one thread of decodePayloads
+        struct PayloadDecoder
+        {
+            MeshSerializerImpl* serializer;
+            PayloadJobList* jobs;
+            size_t first;
+            size_t stride;
+
+            PayloadDecoder(MeshSerializerImpl* s, PayloadJobList* j, size_t f, size_t st)
+                : serializer(s), jobs(j), first(f), stride(st) {}
+            void run();
+        };
+
+        /** Records a payload of the given size at the current stream position and skips it.
+            Only valid while mDeferPayloads is set.
+        */
+        virtual PayloadJob& deferPayload(DataStreamPtr& stream, PayloadJob::Type type, size_t size);
+        /// Decodes the recorded payloads concurrently and creates their hardware buffers
+        virtual void decodePayloads(Mesh* pMesh);
+        /// Decodes a single recorded payload, safe to run concurrently
+        virtual void decodePayload(PayloadJob& job);
+        /// Frees the decoded copies and forgets the recorded payloads
+        virtual void clearPayloads(void);
+        /// Converts packed colours of vertex data on the loading thread
+        virtual void convertPackedColours(VertexData* dest);
+
+        /// Set while readMesh records payloads instead of decoding them
+        bool mDeferPayloads;
+        PayloadJobList mPayloadJobs;
+        /// Vertex data whose colours are converted once the deferred buffers exist
+        vector<VertexData*>::type mColourConversions;
 
         /// Flip an entire vertex buffer from little endian
         virtual void flipFromLittleEndian(void* pData, size_t vertexCount, size_t vertexSize, const VertexDeclaration::VertexElementList& elems);
@@ -180,10 +283,25 @@ namespace Ogre {
 
     };
 
+    /** Class for providing backwards-compatibility for loading version 1.8 of the .mesh format. 
+	 This mesh format was used from Ogre v1.8.
+	 */
+    class _OgrePrivate MeshSerializerImpl_v1_8 : public MeshSerializerImpl
+    {
+    public:
+        MeshSerializerImpl_v1_8();
+        ~MeshSerializerImpl_v1_8();
+    protected:
+		/// Rejects the vertex element types this version does not know
+		size_t calcGeometrySize(const VertexData* pGeom);
+		void writeSubMeshClusters(const SubMesh* s);
+		size_t calcSubMeshClustersSize(const SubMesh* pSub);
+    };
+
     /** Class for providing backwards-compatibility for loading version 1.41 of the .mesh format. 
 	 This mesh format was used from Ogre v1.7.
 	 */
-    class _OgrePrivate MeshSerializerImpl_v1_41 : public MeshSerializerImpl
+    class _OgrePrivate MeshSerializerImpl_v1_41 : public MeshSerializerImpl_v1_8
     {
     public:
         MeshSerializerImpl_v1_41();
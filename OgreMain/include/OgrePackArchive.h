@@ -0,0 +1,246 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __PackArchive_H__
+#define __PackArchive_H__
+
+#include "OgrePrerequisites.h"
+
+#include "OgreArchive.h"
+#include "OgreArchiveFactory.h"
+#include "OgreHeaderPrefix.h"
+
+namespace Ogre {
+
+	/** \addtogroup Core
+	*  @{
+	*/
+	/** \addtogroup Resources
+	*  @{
+	*/
+	/** Specialisation of the Archive class to read OGRE pack files.
+    @remarks
+        A pack is a single file holding many resources, built with PackArchiveWriter
+        (or the OgrePackBuilder tool). It is laid out for fast loading of archives
+        with a great number of small files:
+        <ul>
+        <li>A table of contents sorted by name is read in one go when the archive
+            loads, there is no directory to scan. Files are found by binary search.</li>
+        <li>Files may be compressed in the LZ4 block format, which decompresses
+            several times faster than zip's deflate.</li>
+        <li>Uncompressed files are aligned to pages. The pack is memory mapped where
+            possible (see MmapDataStream), and streams of uncompressed files read
+            straight from the mapping without a copy.</li>
+        </ul>
+        All values are little endian. The file starts with a PackHeader, followed
+        by the file data, the names of all files, and the PackEntry table. Packs
+        hold files only, no directory entries; names are case sensitive.
+    */
+    class _OgreExport PackArchive : public Archive 
+    {
+    public:
+        /// How the data of a pack entry is stored
+        enum Compression
+        {
+            COMPRESSION_NONE = 0,
+            COMPRESSION_LZ4 = 1
+        };
+
+        /// Header at the start of a pack file
+        struct PackHeader
+        {
+            uint32 magic;
+            uint32 version;
+            uint32 entryCount;
+            /// Alignment of uncompressed file data
+            uint32 alignment;
+            /// Offset of the PackEntry table
+            uint64 entriesOffset;
+            /// Offset and size of the names, which are not terminated
+            uint64 namesOffset;
+            uint64 namesSize;
+        };
+
+        /// Table of contents entry of a pack file, entries are sorted by name
+        struct PackEntry
+        {
+            uint64 offset;
+            uint64 compressedSize;
+            uint64 size;
+            uint64 modifiedTime;
+            /// Position of the name in the names
+            uint32 nameOffset;
+            uint32 nameLength;
+            /// Compression value
+            uint32 compression;
+            uint32 reserved;
+        };
+
+        static const uint32 PACK_MAGIC;
+        static const uint32 PACK_VERSION;
+
+        /// Largest size compressLz4 can produce from srcSize bytes
+        static size_t getLz4Bound(size_t srcSize);
+        /** Compresses data in the LZ4 block format.
+        @return The compressed size, or 0 if it doesn't fit in destCapacity
+        */
+        static size_t compressLz4(const void* src, size_t srcSize, void* dest, size_t destCapacity);
+        /** Decompresses data in the LZ4 block format.
+        @return Whether the data was valid and decompressed to exactly destSize bytes
+        */
+        static bool decompressLz4(const void* src, size_t srcSize, void* dest, size_t destSize);
+
+    protected:
+        typedef vector<PackEntry>::type PackEntryList;
+        /// Table of contents, sorted by name
+        PackEntryList mEntries;
+        /// Names of all entries
+        String mNames;
+        /// File list for list / find, in table of contents order
+        FileInfoList mFileList;
+        /// Mapping of the whole pack, null if it couldn't be mapped
+        DataStreamPtr mMapping;
+        bool mLoaded;
+
+        /// Finds the entry of a file, null if the pack doesn't have it
+        const PackEntry* findEntry(const String& filename) const;
+        /// Reads the stored data of an entry into memory allocated with MEMCATEGORY_GENERAL
+        uchar* readEntryData(const PackEntry& entry) const;
+
+		OGRE_AUTO_MUTEX
+    public:
+        PackArchive(const String& name, const String& archType);
+        ~PackArchive();
+        /// @copydoc Archive::isCaseSensitive
+        bool isCaseSensitive(void) const { return true; }
+
+        /// @copydoc Archive::load
+        void load();
+        /// @copydoc Archive::unload
+        void unload();
+
+        /// @copydoc Archive::open
+        DataStreamPtr open(const String& filename, bool readOnly = true) const;
+
+		/// @copydoc Archive::create
+		DataStreamPtr create(const String& filename) const;
+
+		/// @copydoc Archive::remove
+		void remove(const String& filename) const;
+
+        /// @copydoc Archive::list
+        StringVectorPtr list(bool recursive = true, bool dirs = false);
+
+        /// @copydoc Archive::listFileInfo
+        FileInfoListPtr listFileInfo(bool recursive = true, bool dirs = false);
+
+        /// @copydoc Archive::find
+        StringVectorPtr find(const String& pattern, bool recursive = true,
+            bool dirs = false);
+
+        /// @copydoc Archive::findFileInfo
+        FileInfoListPtr findFileInfo(const String& pattern, bool recursive = true,
+            bool dirs = false) const;
+
+        /// @copydoc Archive::exists
+        bool exists(const String& filename);
+
+		/// @copydoc Archive::getModifiedTime
+		time_t getModifiedTime(const String& filename);
+    };
+
+    /** Specialisation of ArchiveFactory for pack files. */
+    class _OgrePrivate PackArchiveFactory : public ArchiveFactory
+    {
+    public:
+        virtual ~PackArchiveFactory() {}
+        /// @copydoc FactoryObj::getType
+        const String& getType(void) const;
+        /// @copydoc FactoryObj::createInstance
+        Archive *createInstance( const String& name, bool readOnly ) 
+        {
+			if(!readOnly)
+				return NULL;
+
+            return OGRE_NEW PackArchive(name, "Pack");
+        }
+        /// @copydoc FactoryObj::destroyInstance
+        void destroyInstance( Archive* ptr) { OGRE_DELETE ptr; }
+    };
+
+    /** Writes pack files for PackArchive.
+    @remarks
+        Files are written as they are added, the table of contents when the pack
+        is finished.
+    */
+    class _OgreExport PackArchiveWriter : public ArchiveAlloc
+    {
+    protected:
+        std::ofstream* mFile;
+        String mFileName;
+        uint32 mAlignment;
+        uint64 mOffset;
+        /// Entries and names in the order added
+        vector<PackArchive::PackEntry>::type mEntries;
+        StringVector mNames;
+
+        void writeData(const void* data, size_t size);
+        void pad(uint32 alignment);
+    public:
+        /** Creates a pack file.
+        @param filename The pack file to write
+        @param alignment Alignment of uncompressed file data, normally the page size
+        */
+        PackArchiveWriter(const String& filename, uint32 alignment = 4096);
+        /// Finishes the pack if it wasn't already
+        ~PackArchiveWriter();
+
+        /** Adds a file to the pack.
+        @param name Name of the file in the pack, which must be unique
+        @param stream Contents of the file, read from the current position to the end
+        @param modifiedTime Modification time to report for the file
+        @param compress Whether to compress the file; it's still stored uncompressed
+            unless that saves at least an eighth of its size
+        */
+        void addFile(const String& name, const DataStreamPtr& stream, time_t modifiedTime,
+            bool compress = true);
+
+        /// Writes the table of contents and closes the pack
+        void finish(void);
+
+        /// Gets the number of files added so far
+        size_t getFileCount(void) const { return mEntries.size(); }
+    };
+
+	/** @} */
+	/** @} */
+
+}
+
+#include "OgreHeaderSuffix.h"
+
+#endif
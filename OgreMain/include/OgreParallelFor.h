@@ -0,0 +1,101 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __ParallelFor_H__
+#define __ParallelFor_H__
+
+#include "OgrePrerequisites.h"
+
+namespace Ogre {
+	/** \addtogroup Core
+	*  @{
+	*/
+	/** \addtogroup General
+	*  @{
+	*/
+
+	/** Runs a number of independent pieces of work on several threads and waits
+		for all of them to finish.
+	@remarks
+		With the TBB thread provider item 0 runs on the calling thread and the
+		others as tasks of a tbb::task_group. With Boost and Poco the items are
+		shared between the calling thread and a pool of threads started on first
+		use, which stays for the lifetime of the process; items may start runs of
+		their own. Without thread support all run one after the other on the
+		calling thread.
+	@par
+		If items throw, the first exception is rethrown on the calling thread
+		once every item has finished. Ogre's and the standard library's exceptions
+		keep their type, others become an InternalErrorException.
+	*/
+	class _OgreExport ParallelFor
+	{
+	public:
+		/// Work split into items which may run concurrently
+		class _OgreExport Task
+		{
+		public:
+			virtual ~Task() {}
+			/// Does the item of the given index
+			virtual void run(size_t index) = 0;
+		};
+
+		/// Runs task.run(0) to task.run(count - 1) and waits for them all
+		static void run(Task& task, size_t count);
+
+		/** Runs workers[i].run() for every element of a random access container
+			of workers, which is how most callers split their work.
+		*/
+		template <typename WorkerList>
+		static void runWorkers(WorkerList& workers)
+		{
+			WorkerListTask<WorkerList> task(workers);
+			run(task, workers.size());
+		}
+
+		/** Gets the number of threads it is worth splitting work between,
+			1 when built without thread support.
+		*/
+		static size_t getHardwareThreadCount(void);
+
+	protected:
+		template <typename WorkerList>
+		class WorkerListTask : public Task
+		{
+		public:
+			WorkerListTask(WorkerList& workers) : mWorkers(workers) {}
+			void run(size_t index) { mWorkers[index].run(); }
+		protected:
+			WorkerList& mWorkers;
+		};
+	};
+	/** @} */
+	/** @} */
+
+}
+
+#endif
@@ -283,6 +283,19 @@ namespace Ogre {
         PCT_UINT = 5,   /// Unsigned integer per component
         PCT_COUNT = 6    /// Number of pixel types
     };
+
+    /** Speed against quality trade-off for the CPU block compressor.
+    @see PixelUtil::compressPixels
+    */
+    enum CompressionQuality
+    {
+        /// Bounding box endpoints, no refinement. For content regenerated every frame or so
+        CQ_FASTEST = 0,
+        /// Principal axis endpoints refined once. Good for most generated textures
+        CQ_NORMAL = 1,
+        /// Several refinement passes and alternative block modes
+        CQ_BEST = 2
+    };
     
 	/** A primitive describing a volume (3D), image (2D) or line (1D) of pixels in memory.
      	In case of a rectangle, depth must be 1. 
@@ -601,6 +614,52 @@ namespace Ogre {
          	dimensions. In case the source and destination format match, a plain copy is done.
         */
         static void bulkPixelConversion(const PixelBox &src, const PixelBox &dst);
+
+        /** Returns whether compressPixels can encode to the given format.
+        @remarks
+            PF_DXT1 to PF_DXT5, PF_BC4_*, PF_BC5_* and PF_BC7_* are supported. There
+            is no encoder for the HDR PF_BC6H_* formats.
+        */
+        static bool canCompressTo(PixelFormat format);
+
+        /** Compress pixels to a block compressed format on the CPU.
+            @param	src			PixelBox containing the source pixels, pitches and format.
+                                Any uncompressed format bulkPixelConversion can read is accepted.
+            @param	dst			PixelBox for the compressed data, which is always consecutive
+            @param	quality		Speed against quality trade-off
+        @remarks
+            The image is encoded in 4x4 blocks, partial blocks at the right and bottom edges
+            repeat the last column or row. 3D boxes are encoded slice by slice. Large boxes
+            are encoded on several threads, see setBulkConversionThreads.
+        @par
+            Signed formats (PF_BC4_SNORM, PF_BC5_SNORM) map the 0..1 range of the source
+            onto -1..1, the usual convention for normal maps. DXT2 and DXT4 store the
+            colours as given, premultiplying alpha is up to the caller.
+            bulkPixelConversion uses this with CQ_NORMAL when the destination is compressed.
+        */
+        static void compressPixels(const PixelBox &src, const PixelBox &dst,
+            CompressionQuality quality = CQ_NORMAL);
+
+        /** Set how many threads bulkPixelConversion may use for large boxes.
+        @remarks
+            Large boxes are split into bands of rows (or slices for 3D boxes) which
+            are converted in parallel. Small boxes are always converted on the calling
+            thread. 0, the default, means one thread per hardware thread and 1 turns
+            splitting off. Has no effect when Ogre is built without thread support.
+        */
+        static void setBulkConversionThreads(size_t threads)
+        {
+            msBulkConversionThreads = threads;
+        }
+
+        /// Get how many threads bulkPixelConversion may use for large boxes.
+        static size_t getBulkConversionThreads()
+        {
+            return msBulkConversionThreads;
+        }
+
+    protected:
+        static size_t msBulkConversionThreads;
     };
 	/** @} */
 	/** @} */
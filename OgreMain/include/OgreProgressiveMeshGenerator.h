@@ -80,6 +80,16 @@ public:
 	/// @copydoc ProgressiveMeshGeneratorBase::generateLodLevels
 	void generateLodLevels(LodConfig& lodConfig);
 
+	/**
+	 * @brief Sets how many threads compute the initial collapse costs.
+	 *
+	 * @param threads 0, the default, uses one thread per hardware thread for meshes with
+	 * several thousand vertices per thread. 1 computes every cost on the calling thread.
+	 * The generated Lod levels are the same either way.
+	 */
+	void setCostThreadCount(size_t threads) { mCostThreadCount = threads; }
+	size_t getCostThreadCount() const { return mCostThreadCount; }
+
 protected:
 
 	// VectorSet is basically a helper to use a vector as a small set container.
@@ -110,16 +120,20 @@ protected:
 	struct PMCollapseCostLess;
 	struct PMCollapsedEdge;
 	struct PMIndexBufferInfo;
+	struct PMCollapseCostHeap;
+	struct PMCostWorker;
+	struct PMQuadric;
 
 	typedef vector<PMVertex>::type VertexList;
 	typedef vector<PMTriangle>::type TriangleList;
 	typedef HashSet<PMVertex*, PMVertexHash, PMVertexEqual> UniqueVertexSet;
-	typedef multimap<Real, PMVertex*>::type CollapseCostHeap;
+	typedef PMCollapseCostHeap CollapseCostHeap;
 	typedef vector<PMVertex*>::type VertexLookupList;
 
 	typedef VectorSet<PMEdge, 8> VEdges;
 	typedef VectorSet<PMTriangle*, 7> VTriangles;
 
+	typedef vector<PMQuadric>::type QuadricList;
 	typedef vector<PMCollapsedEdge>::type CollapsedEdges;
 	typedef vector<PMIndexBufferInfo>::type IndexBufferInfoList;
 
@@ -157,7 +171,42 @@ protected:
 
 		PMVertex* collapseTo;
 		bool seam;
-		CollapseCostHeap::iterator costHeapPosition; // Iterator pointing to the position in the mCollapseCostSet, which allows fast remove.
+		size_t costHeapPosition; // Index in mCollapseCostHeap, which allows fast update and remove.
+	};
+
+	// Binary min-heap of vertices ordered by collapse cost.
+	// Each vertex knows its index in the heap, so costs can be changed or removed
+	// in O(log N) without the node allocations of a multimap.
+	// Not private like the other helpers, as the unit tests use it directly.
+	struct PMCollapseCostHeap {
+		struct Entry {
+			Real cost;
+			PMVertex* vertex;
+		};
+		typedef vector<Entry>::type EntryList;
+
+		static const size_t NOT_IN_HEAP = ~static_cast<size_t>(0);
+
+		void clear() { mEntries.clear(); }
+		bool empty() const { return mEntries.empty(); }
+		size_t size() const { return mEntries.size(); }
+		const Entry& top() const { return mEntries.front(); }
+		const EntryList& getEntries() const { return mEntries; }
+		Real getCost(const PMVertex* v) const { return mEntries[v->costHeapPosition].cost; }
+
+		void push(PMVertex* v, Real cost); // Complexity: O(log N)
+		void update(PMVertex* v, Real cost); // Complexity: O(log N)
+		void erase(PMVertex* v); // Complexity: O(log N)
+		// Appends without keeping the heap order, call build() before using the heap.
+		void pushUnordered(PMVertex* v, Real cost); // Complexity: O(1)
+		void build(); // Complexity: O(N)
+
+	private:
+		EntryList mEntries;
+
+		void place(size_t pos, const Entry& entry);
+		void siftUp(size_t pos);
+		void siftDown(size_t pos);
 	};
 
 	struct _OgrePrivate PMTriangle {
@@ -173,6 +222,16 @@ protected:
 		bool isMalformed();
 	};
 
+	// Symmetric 4x4 error quadric of a set of weighted planes, upper triangle only.
+	struct _OgrePrivate PMQuadric {
+		Real m[10];
+
+		PMQuadric();
+		void addPlane(const Vector3& normal, Real d, Real weight);
+		PMQuadric& operator+= (const PMQuadric& other);
+		Real evaluate(const Vector3& v) const; // Weighted sum of squared distances to the planes.
+	};
+
 	struct _OgrePrivate PMIndexBufferInfo {
 		size_t indexSize;
 		size_t indexCount;
@@ -195,6 +254,7 @@ protected:
 	TriangleList mTriangleList;
 	UniqueVertexSet mUniqueVertexSet;
 	CollapseCostHeap mCollapseCostHeap;
+	QuadricList mQuadricList; // Indexed like mVertexList, only used with LodConfig::EM_QUADRIC.
 	CollapsedEdges tmpCollapsedEdges; // Tmp container used in collapse().
 	IndexBufferInfoList mIndexBufferInfoList;
 
@@ -210,6 +270,8 @@ protected:
 #endif
 	Real mMeshBoundingSphereRadius;
 	Real mCollapseCostLimit;
+	LodConfig::ErrorMetric mErrorMetric;
+	size_t mCostThreadCount;
 
 	size_t calcLodVertexCount(const LodLevel& lodConfig);
 	void tuneContainerSize();
@@ -221,8 +283,11 @@ protected:
 	void computeCosts();
 	bool isBorderVertex(const PMVertex* vertex) const;
 	PMEdge* getPointer(VEdges::iterator it);
-	void computeVertexCollapseCost(PMVertex* vertex);
+	Real computeVertexCollapseCost(PMVertex* vertex);
 	Real computeEdgeCollapseCost(PMVertex* src, PMEdge* dstEdge);
+	void computeQuadrics();
+	Real computeQuadricCollapseCost(PMVertex* src, PMEdge* dstEdge);
+	PMQuadric& getQuadric(const PMVertex* v) { return mQuadricList[v - &mVertexList[0]]; }
 	virtual void bakeLods();
 	void collapse(PMVertex* vertex);
 	void initialize();
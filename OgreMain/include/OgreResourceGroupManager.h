@@ -35,6 +35,8 @@ THE SOFTWARE.
 #include "OgreResource.h"
 #include "OgreArchive.h"
 #include "OgreIteratorWrappers.h"
+#include "OgreAtomicWrappers.h"
+#include "OgreWorkQueue.h"
 #include <ctime>
 #include "OgreHeaderPrefix.h"
 
@@ -248,7 +250,8 @@ namespace Ogre {
 		@see ResourceGroupManager::unloadResourceGroup
 		@see ResourceGroupManager::clearResourceGroup
     */
-    class _OgreExport ResourceGroupManager : public Singleton<ResourceGroupManager>, public ResourceAlloc
+    class _OgreExport ResourceGroupManager : public Singleton<ResourceGroupManager>, public ResourceAlloc,
+		public WorkQueue::RequestHandler
     {
     public:
 		OGRE_AUTO_MUTEX // public to allow external locking
@@ -282,6 +285,22 @@ namespace Ogre {
 		};
 		/// List of possible file locations
 		typedef list<ResourceLocation*>::type LocationList;
+		/// Counters of resource name lookups, see getResourceLookupStats
+		struct ResourceLookupStats
+		{
+			/// Names resolved to an archive (opening, existence and modified time checks)
+			size_t lookups;
+			/// Lookups which missed both indexes and asked every archive in turn
+			size_t archiveSearches;
+			/// Archives asked by those searches, the main cost of a slow lookup
+			size_t archiveProbes;
+			/// Lookups which had to wait for a resource location change to publish its index
+			size_t contendedLookups;
+			/// Index changes made by resource location or file changes
+			size_t indexUpdates;
+			/// Those of the changes which had to copy the index, because lookups were using it
+			size_t indexCopies;
+		};
 
     protected:
 		/// Map of resource types (strings) to ResourceManagers, used to notify them to load / unload group contents
@@ -297,7 +316,45 @@ namespace Ogre {
 		ResourceLoadingListener *mLoadingListener;
 
         /// Resource index entry, resourcename->location 
-        typedef map<String, Archive*>::type ResourceLocationIndex;
+        typedef HashMap<String, Archive*> ResourceLocationIndex;
+
+		/** The resource names of a group mapped to the archives holding them.
+		@remarks
+			Name lookups only hold mResourceIndexMutex long enough to take a reference
+			to the current index of a group, and never see it change while they hold
+			that reference. Adding or removing locations or files therefore changes the
+			index in place when no lookup holds it, and otherwise changes a copy which
+			is then swapped in.
+		*/
+		struct ResourceIndex : public ResourceAlloc
+		{
+			/// Index of resource names to locations, built for speedy access (case sensitive archives)
+			ResourceLocationIndex caseSensitive;
+			/// Index of lower case resource names to locations (case insensitive archives)
+			ResourceLocationIndex caseInsensitive;
+			/// Archives of the group in search order, for names missing from the indexes
+			vector<Archive*>::type archives;
+
+			/// Kinds of change made to an index, see ResourceGroupManager::updateResourceIndex
+			enum Change
+			{
+				/// Append the archive to the search order and index its files
+				ADD_ARCHIVE,
+				/// Remove the archive and all its files
+				REMOVE_ARCHIVE,
+				/// Index files of an archive
+				ADD_FILES,
+				/// Remove files of an archive
+				REMOVE_FILES
+			};
+
+			void add(const String& filename, Archive* arch);
+			void remove(const String& filename, Archive* arch);
+			void remove(Archive* arch);
+			/// Applies a whole change at once
+			void apply(Change change, Archive* arch, const StringVector& files);
+		};
+		typedef SharedPtr<ResourceIndex> ResourceIndexPtr;
 
 		/// List of resources which can be loaded / unloaded
 		typedef list<ResourcePtr>::type LoadUnloadResourceList;
@@ -322,10 +379,8 @@ namespace Ogre {
 			Status groupStatus;
 			/// List of possible locations to search
 			LocationList locationList;
-			/// Index of resource names to locations, built for speedy access (case sensitive archives)
-			ResourceLocationIndex resourceIndexCaseSensitive;
-            /// Index of resource names to locations, built for speedy access (case insensitive archives)
-            ResourceLocationIndex resourceIndexCaseInsensitive;
+			/// Current index of resource names, replaced with the group mutex and mResourceIndexMutex held
+			ResourceIndexPtr resourceIndex;
 			/// Pre-declared resources, ready to be created
 			ResourceDeclarationList resourceDeclarations;
 			/// Created resources which are ready to be loaded / unloaded
@@ -339,16 +394,37 @@ namespace Ogre {
             SceneManager* worldGeometrySceneManager;
 			// in global pool flag - if true the resource will be loaded even a different	group was requested in the load method as a parameter.
 			bool inGlobalPool;
-
-			void addToIndex(const String& filename, Archive* arch);
-			void removeFromIndex(const String& filename, Archive* arch);
-			void removeFromIndex(Archive* arch);
-
 		};
         /// Map from resource group names to groups
         typedef map<String, ResourceGroup*>::type ResourceGroupMap;
         ResourceGroupMap mResourceGroupMap;
 
+		/// Guards changes to mResourceGroupMap and to the index of each group
+		OGRE_RW_MUTEX(mResourceIndexMutex);
+		/// Number of index changes waiting for or holding mResourceIndexMutex
+		AtomicScalar<size_t> mIndexWriters;
+		/// Lookup counters, see ResourceLookupStats
+		AtomicScalar<size_t> mLookupCount;
+		AtomicScalar<size_t> mArchiveSearchCount;
+		AtomicScalar<size_t> mArchiveProbeCount;
+		AtomicScalar<size_t> mContendedLookupCount;
+		AtomicScalar<size_t> mIndexUpdateCount;
+		AtomicScalar<size_t> mIndexCopyCount;
+
+		/// Gets the current index of a group, null if there is no such group
+		ResourceIndexPtr getResourceIndex(const String& groupName);
+		/// Gets the current index of a group
+		ResourceIndexPtr getResourceIndex(ResourceGroup* grp);
+		/** Applies a change to the index of a group.
+		@remarks
+			The caller holds the group mutex. The index is changed in place if no lookup
+			holds a reference to it, otherwise a changed copy replaces it.
+		*/
+		void updateResourceIndex(ResourceGroup* grp, ResourceIndex::Change change, 
+			Archive* arch, const StringVector& files);
+		/// Finds the archive holding a resource, null if no archive of the index has it
+		Archive* findArchive(const ResourceIndex& index, const String& resourceName);
+
         /// Group name for world resources
         String mWorldGroupName;
 
@@ -400,6 +476,22 @@ namespace Ogre {
 
 		/// Stored current group - optimisation for when bulk loading a group
 		ResourceGroup* mCurrentGroup;
+		/// Number of threads preparing resources in loadResourceGroup, 1 prepares them as they load
+		size_t mPrepareThreads;
+		/// The WorkQueue this handles prepare requests of, 0 until the first parallel prepare
+		WorkQueue* mPrepareWorkQueue;
+		/// WorkQueue channel of the prepare requests
+		uint16 mPrepareChannel;
+
+		/** Prepares the unloaded resources of a group on mPrepareThreads threads.
+		@remarks
+			Called by loadResourceGroup before it takes any mutex, so resources
+			preparing on the worker threads can open files and create or regroup
+			other resources. The calling thread prepares resources as well and
+			the Root's WorkQueue supplies the other threads. Failures are logged
+			and left for the load that follows to raise.
+		*/
+		void prepareResourcesInParallel(const String& groupName);
     public:
         ResourceGroupManager();
         virtual ~ResourceGroupManager();
@@ -526,6 +618,7 @@ namespace Ogre {
 			to just load world geometry in bulk)
 		@param loadWorldGeom If true, loads any linked world geometry
 			@see ResourceGroupManager::linkWorldGeometryToResourceGroup
+			@see ResourceGroupManager::setResourcePrepareThreads
         */
         void loadResourceGroup(const String& name, bool loadMainResources = true, 
 			bool loadWorldGeom = true);
@@ -1050,6 +1143,41 @@ namespace Ogre {
 		/// Returns the current loading listener
 		ResourceLoadingListener *getLoadingListener();
 
+		/** Sets how many threads loadResourceGroup prepares resources on.
+		@remarks
+			Preparing a resource (see Resource::prepare) reads and decodes its data
+			without touching the render system. With more than one thread,
+			loadResourceGroup first prepares every unloaded resource of the group
+			concurrently, then loads them on the calling thread in the usual order,
+			which only leaves the render system work to that thread. Resource
+			prepare events are not fired for this stage, load events are.
+		@par
+			The calling thread is one of the preparing threads, the others are
+			requests to the WorkQueue of Root, so this needs a Root. The number
+			bounds how many files are read at the same time, set it to what the
+			storage holding the resources copes with. 0 uses one thread per
+			hardware thread; 1, the default, prepares each resource as it loads.
+			Without thread support the WorkQueue runs the requests right away.
+		*/
+		void setResourcePrepareThreads(size_t threads);
+		/// Gets the number of threads loadResourceGroup prepares resources on
+		size_t getResourcePrepareThreads(void) const { return mPrepareThreads; }
+
+		/// Prepares resources for loadResourceGroup, see setResourcePrepareThreads
+		WorkQueue::Response* handleRequest(const WorkQueue::Request* req, const WorkQueue* srcQ);
+
+		/** Gets counters of the resource name lookups done so far.
+		@remarks
+			Lookups (openResource, resourceExists, resourceModifiedTime and the search
+			through all groups) don't take the manager or group mutexes, they resolve
+			names against an immutable index of each group. These counters tell how
+			often names were not indexed and archives had to be searched, and how often
+			lookups ran into a change of resource locations.
+		*/
+		ResourceLookupStats getResourceLookupStats(void) const;
+		/// Sets all resource lookup counters back to zero
+		void resetResourceLookupStats(void);
+
 		/** Override standard Singleton retrieval.
         @remarks
         Why do we do this? Well, it's because the Singleton
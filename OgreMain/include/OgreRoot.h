@@ -99,6 +99,7 @@ namespace Ogre
         ArchiveFactory *mZipArchiveFactory;
         ArchiveFactory *mEmbeddedZipArchiveFactory;
         ArchiveFactory *mFileSystemArchiveFactory;
+        ArchiveFactory *mPackArchiveFactory;
         
 #if OGRE_PLATFORM == OGRE_PLATFORM_ANDROID
         AndroidLogListener* mAndroidLogger;
@@ -83,7 +83,13 @@ namespace Ogre {
 
 		/** Tokenizes the given input and returns the list of tokens found */
 		ScriptTokenListPtr tokenize(const String &str, const String &source);
+		/** Tokenizes the characters from begin up to end, which need not be terminated.
+			Lets scripts be read in place from memory backed streams, without a String copy.
+		*/
+		ScriptTokenListPtr tokenize(const char *begin, const char *end, const String &source);
 	private: // Private utility operations
+		template <typename Iterator>
+		ScriptTokenListPtr tokenizeRange(Iterator i, Iterator end, const String &source);
 		void setToken(const String &lexeme, uint32 line, const String &source, ScriptTokenList *tokens);
 		bool isWhitespace(Ogre::String::value_type c) const;
 		bool isNewline(Ogre::String::value_type c) const;
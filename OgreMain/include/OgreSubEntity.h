@@ -121,11 +121,44 @@ namespace Ogre {
 		mutable Real mCachedCameraDist;
 		/// The camera for which the cached distance is valid
 		mutable const Camera *mCachedCamera;
+		/// Index data holding the clusters which passed the last culling, see Entity::setClusterCulling
+		IndexData* mClusterIndexData;
+		/// Visible index ranges of the last culling, as start / count pairs
+		vector<uint32>::type mVisibleClusterRanges;
+		/// Index ranges gathered by the current culling, swapped with mVisibleClusterRanges
+		vector<uint32>::type mClusterRangesScratch;
+		/// Whether mClusterIndexData is rendered in place of the SubMesh index data
+		bool mClusterIndexDataActive;
+		/// Whether the last culling left no cluster visible
+		bool mAllClustersCulled;
 
         /** Internal method for preparing this Entity for use in animation. */
         void prepareTempBlendBuffers(void);
 
+		/** Culls the triangle clusters of the SubMesh and updates the index data to render.
+		@param planes
+			Normalised culling planes in mesh space.
+		@param planeCount
+			Number of culling planes.
+		@param coneTest
+			Whether clusters facing away from the camera may be culled.
+		@param cameraPosition
+			Position of the camera in mesh space.
+		*/
+		void updateClusterCulling(const Plane* planes, size_t planeCount, bool coneTest,
+			const Vector3& cameraPosition);
+		/// Renders the whole SubMesh again, after culling has stopped
+		void resetClusterCulling(void);
+
     public:
+        /** Index of the custom parameter holding VertexData::positionScale, set when the
+            SubMesh has quantised positions (see Mesh::quantiseVertexData). Bind it with
+            'param_named_auto <name> custom <index>'.
+        */
+        static const size_t CUSTOM_PARAM_POSITION_SCALE = 0xFFF0;
+        /// Index of the custom parameter holding VertexData::positionBias
+        static const size_t CUSTOM_PARAM_POSITION_BIAS = 0xFFF1;
+
         /** Gets the name of the Material in use by this instance.
         */
         const String& getMaterialName() const;
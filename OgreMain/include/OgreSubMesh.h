@@ -255,6 +255,64 @@ namespace Ogre {
 		bool isBuildEdgesEnabled(void) const { return mBuildEdgesEnabled; }
 		void setBuildEdgesEnabled(bool b);
 
+		/** Reorders the geometry of this SubMesh for the post-transform vertex cache.
+		@remarks
+			The triangle lists of every LOD level are reordered with
+			IndexData::optimiseVertexCacheTriList. If the SubMesh has dedicated vertex
+			data, its vertices are then renumbered in the order the triangles first use
+			them (see VertexData::optimiseVertexFetch) and the bone assignments are
+			updated to match. Shared vertex data is left alone since other SubMeshes
+			index it as well; use Mesh::optimiseVertexCache to reorder it too.
+			Edge lists of the parent mesh are rebuilt if they had been built.
+		@param reorderVertices
+			Whether dedicated vertices may be reordered as well. Vertices are never
+			reordered when the data is morph / pose animated or used non-indexed.
+		*/
+		void optimiseVertexCache(bool reorderVertices = true);
+
+		/** A group of nearby triangles of the triangle list, with the data needed to
+			cull them as a whole (see buildClusters).
+		*/
+		struct TriangleCluster
+		{
+			/// First index of the cluster, relative to indexData->indexStart
+			uint32 indexStart;
+			/// Number of indexes in the cluster (3 per triangle)
+			uint32 indexCount;
+			/// Bounding sphere of the cluster, in mesh space
+			Vector3 center;
+			Real radius;
+			/// Average facing of the triangles
+			Vector3 coneAxis;
+			/** Sine of the half angle of the normal cone, or 1 if the triangles face too
+				many directions for the cluster to ever be entirely back facing.
+			*/
+			Real coneCutoff;
+		};
+		typedef vector<TriangleCluster>::type TriangleClusterList;
+
+		/** Splits the triangle list of this SubMesh into clusters of neighbouring triangles.
+		@remarks
+			Triangles are gathered greedily over shared vertices, preferring those adding the
+			fewest new vertices, and the index buffer is reordered so every cluster is a
+			contiguous range of it. Each cluster records a bounding sphere and a cone bounding
+			its face normals, which lets entities skip clusters lying outside the view
+			frustum or facing away from the camera (see Entity::setClusterCulling).
+		@par
+			Only the full detail index data is clustered; LOD levels are left alone.
+			Clusters are saved along with the mesh. Edge lists of the parent mesh are rebuilt
+			if they had been built, since the triangle order changes.
+		@param maxTriangles
+			Upper limit of triangles per cluster.
+		*/
+		void buildClusters(size_t maxTriangles = 128);
+
+		/// Removes the clusters built by buildClusters, the triangle order is kept
+		void clearClusters(void) { mClusters.clear(); }
+
+		/// Gets the clusters of the triangle list, empty if none were built
+		const TriangleClusterList& getClusters(void) const { return mClusters; }
+
     protected:
 
         /// Name of the material this SubMesh uses.
@@ -280,9 +338,31 @@ namespace Ogre {
 		/// Is Build Edges Enabled
 		bool mBuildEdgesEnabled;
 
+		/// Triangle clusters of indexData, see buildClusters
+		TriangleClusterList mClusters;
+
         /// Internal method for removing LOD data
         void removeLodLevels(void);
 
+		/** Internal method doing the work of optimiseVertexCache, without touching edge lists
+		@param reorderVertices
+			Whether dedicated vertices may be reordered after the triangles.
+		*/
+		void optimiseVertexCacheImpl(bool reorderVertices);
+
+		/// Internal method doing the work of buildClusters, without touching edge lists
+		void buildClustersImpl(size_t maxTriangles);
+
+		/** Internal method gathering the index data of every LOD level
+		@return
+			False if some LOD level renders its vertex data without indices.
+		*/
+		bool getIndexDataForAllLods(vector<IndexData*>::type& outList) const;
+
+		/// Internal method renumbering bone assignments after a vertex reorder
+		static void remapBoneAssignments(VertexBoneAssignmentList& assignments,
+			const vector<uint32>::type& vertexRemap);
+
 
     };
 	/** @} */
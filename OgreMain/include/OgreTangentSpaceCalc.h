@@ -211,6 +211,34 @@ namespace Ogre
 		typedef vector<VertexInfo>::type VertexInfoArray;
 		VertexInfoArray mVertexArray;
 
+		/// Tangent space of a face, calculated for all faces before they are added to vertices
+		struct FaceInfo
+		{
+			// Index data set and face within it, for index remapping
+			size_t indexSet;
+			size_t faceIndex;
+			// Vertex indexes, in anticlockwise order
+			size_t vertInd[3];
+			// Tangent and binormal weighted by UV area, and normalised face normal
+			Vector3 tangent;
+			Vector3 binormal;
+			Vector3 norm;
+			// Angle the face makes at each of its vertices
+			Real angleWeight[3];
+			// Which way the tangent space is oriented (+1 / -1), 0 if the face has no UV area
+			int parity;
+		};
+		typedef vector<FaceInfo>::type FaceInfoArray;
+		FaceInfoArray mFaceArray;
+		/** Faces using each vertex, stored as face * 3 + corner in face order.
+			Those of vertex v are at [mVertexFaceStart[v], mVertexFaceStart[v+1]).
+		*/
+		vector<size_t>::type mVertexFaceStart;
+		vector<size_t>::type mVertexFaceCorners;
+
+		struct FaceWorker;
+		struct VertexWorker;
+
 		void extendBuffers(VertexSplits& splits);
 		void insertTangents(Result& res,
 			VertexElementSemantic targetSemantic, 
@@ -218,13 +246,21 @@ namespace Ogre
 
 		void populateVertexArray(unsigned short sourceTexCoordSet);
 		void processFaces(Result& result);
+		/// Read the faces of all index data into mFaceArray
+		void readFaces();
+		/// Calculate the tangent space of faces [begin, end) of mFaceArray
+		void calculateFaces(size_t begin, size_t end);
+		/// Sum the faces using vertices [begin, end), only when no vertices are split
+		void accumulateVertices(size_t begin, size_t end);
 		/// Calculate face tangent space, U and V are weighted by UV area, N is normalised
 		void calculateFaceTangentSpace(const size_t* vertInd, Vector3& tsU, Vector3& tsV, Vector3& tsN);
 		Real calculateAngleWeight(size_t v0, size_t v1, size_t v2);
 		int calculateParity(const Vector3& u, const Vector3& v, const Vector3& n);
-		void addFaceTangentSpaceToVertices(size_t indexSet, size_t faceIndex, size_t *localVertInd, 
-			const Vector3& faceTsU, const Vector3& faceTsV, const Vector3& faceNorm, Result& result);
+		void addFaceTangentSpaceToVertices(const FaceInfo& face, Result& result);
 		void normaliseVertices();
+		void normaliseVertices(size_t begin, size_t end);
+		/// Number of threads worth using for the given number of items
+		size_t getThreadCount(size_t itemCount) const;
 		void remapIndexes(Result& res);
 		template <typename T>
 		void remapIndexes(T* ibuf, size_t indexSet, Result& res)
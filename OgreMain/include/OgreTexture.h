@@ -386,6 +386,63 @@ namespace Ogre {
 		 @param pData Pointer to memory matching the type of data you want to retrieve.
 		*/
 		virtual void getCustomAttribute(const String& name, void* pData) {}
+
+		/** Sets whether the mipmaps of this texture are streamed. Must be set before loading.
+		@remarks
+			A streamed texture loads only the levels of its mip chain no larger than
+			TextureManager::getStreamingInitialSize at first. Finer levels are read from the
+			file again in the background once the renderer reports they are needed on screen
+			(see _notifyStreamingDemand), and dropped again when the TextureManager's
+			streaming budget is exceeded. Only the levels which are not resident yet are
+			read, the resident ones are copied over by the GPU. The hardware texture is
+			rebuilt whenever its size changes, so getWidth, getHeight and getNumMipmaps
+			describe the resident levels.
+		@par
+			Only textures loaded from a single file carrying its own mipmaps, such as DDS,
+			are streamed. Others load in full as usual.
+		*/
+		void setStreaming(bool stream) { mStreaming = stream; }
+		/** Gets whether the mipmaps of this texture are streamed. */
+		bool isStreaming(void) const { return mStreaming; }
+		/** Gets the level of the source mip chain the texture currently starts at,
+			0 if the full resolution is resident. */
+		size_t getStreamingTopMip(void) const { return mStreamingTopMip; }
+		/** Gets the number of mipmaps, below the top level, of the source file. */
+		size_t getStreamingSourceMipmaps(void) const { return mStreamingSourceMipmaps; }
+		/** Gets the size in bytes of all faces of the source mip chain from the given level down. */
+		size_t getStreamingSize(size_t topMip) const;
+
+		/** Reports how many texels across the texture is needed on screen this frame.
+		@remarks
+			Does nothing unless the texture is streamed. Internal method used by Entity,
+			may be called several times per frame, the largest demand wins.
+		*/
+		void _notifyStreamingDemand(Real texels);
+		/** Replaces the resident levels by those of an image holding the source mip chain
+			from the given level down. Internal method used by TextureManager.
+		*/
+		void _setStreamedImage(const Image& img, size_t topMip);
+		/** Replaces the resident levels by copies of those of another texture holding the
+			source mip chain from the given level down. Internal method used by TextureManager.
+		@remarks
+			The copy is made by the GPU, the levels are expected to be uploaded already.
+			The hardware texture is kept if they have its size and number of mipmaps.
+		*/
+		void _setStreamedLevels(Texture* levels, size_t topMip);
+
+		/** Loads the texture from a stream holding an image file, decoding it straight
+			into the hardware buffers.
+		@remarks
+			Only done when the codec supports it (see ImageCodec::decodeTo) and the image
+			needs no conversion, scaling, gamma correction or generated mipmaps on the way.
+			Internal method used by render systems in loadImpl.
+		@return false if the texture has to be loaded through an Image instead, the
+			stream is then left where it was
+		*/
+		bool _loadFromStream(DataStreamPtr& stream, const String& type);
+		/** Returns whether _loadFromStream may succeed for files of the given type, so
+			a render system can keep them undecoded when preparing. */
+		static bool _canLoadFromStream(const String& type);
 		
 
 
@@ -416,6 +473,13 @@ namespace Ogre {
 
 		bool mInternalResourcesCreated;
 
+		bool mStreaming;
+		/// Level of the source mip chain at the top of the texture
+		size_t mStreamingTopMip;
+		/// Dimensions of the full resolution source, for streamed textures
+		size_t mStreamingSourceWidth, mStreamingSourceHeight, mStreamingSourceDepth;
+		size_t mStreamingSourceMipmaps;
+
 		/// @copydoc Resource::calculateSize
 		size_t calculateSize(void) const;
 		
@@ -436,6 +500,20 @@ namespace Ogre {
 		*/
 		String getSourceFileType() const;
 
+		/** Whether the render system can generate mipmaps. If it can't, _loadImages
+			generates them with Image::generateMipmaps (gamma correct for sRGB textures).
+		*/
+		bool renderSystemGeneratesMipmaps(void) const;
+
+		/** Creates the texture from images which carry all the levels to load.
+			Called by _loadImages once streaming and mipmap generation are dealt with.
+		*/
+		void loadImagesImpl(const ConstImagePtrList& images);
+
+		/// Target for ImageCodec::decodeTo locking the buffers of the texture
+		class DirectDecodeTarget;
+		friend class DirectDecodeTarget;
+
     };
 
     /** Specialisation of SharedPtr to allow SharedPtr to be assigned to TexturePtr 
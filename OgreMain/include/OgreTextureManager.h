@@ -33,7 +33,10 @@ THE SOFTWARE.
 
 #include "OgreResourceManager.h"
 #include "OgreTexture.h"
+#include "OgreImage.h"
 #include "OgreSingleton.h"
+#include "OgreWorkQueue.h"
+#include "OgreHardwareBufferManager.h"
 
 
 namespace Ogre {
@@ -57,7 +60,8 @@ namespace Ogre {
             created at least one window - this may be done at the
             same time as part a if you allow Ogre to autocreate one.
      */
-    class _OgreExport TextureManager : public ResourceManager, public Singleton<TextureManager>
+    class _OgreExport TextureManager : public ResourceManager, public Singleton<TextureManager>,
+		public WorkQueue::RequestHandler, public WorkQueue::ResponseHandler
     {
     public:
 
@@ -462,6 +466,76 @@ namespace Ogre {
             return mDefaultNumMipmaps;
         }
 
+		/** Sets whether textures created from now on stream their mipmaps, as with
+			Texture::setStreaming. Off by default.
+		*/
+		void setDefaultStreaming(bool stream) { mDefaultStreaming = stream; }
+		/** Gets whether new textures stream their mipmaps. */
+		bool getDefaultStreaming(void) const { return mDefaultStreaming; }
+
+		/** Sets the memory budget for the mipmaps of streamed textures.
+		@remarks
+			When textures stream their mipmaps (see Texture::setStreaming), finer levels
+			are only loaded while they fit in this many bytes, counting all the levels
+			resident for every streamed texture. If they don't, the textures which have
+			not been displayed recently drop back to their initial levels, least recently
+			used first. Unlimited by default.
+		*/
+		void setStreamingBudget(size_t bytes);
+		/** Gets the memory budget for the mipmaps of streamed textures. */
+		size_t getStreamingBudget(void) const { return mStreamingBudget; }
+
+		/** Sets the largest dimension, in texels, of the top level streamed textures
+			start with when they are loaded. The default is 64.
+		*/
+		void setStreamingInitialSize(size_t texels) { mStreamingInitialSize = texels; }
+		/** Gets the largest dimension of the top level streamed textures start with. */
+		size_t getStreamingInitialSize(void) const { return mStreamingInitialSize; }
+
+		/// Summary of the state of texture streaming
+		struct StreamingStatistics
+		{
+			/// Number of textures streaming their mipmaps
+			size_t streamedTextures;
+			/// Bytes taken by the levels currently loaded
+			size_t residentBytes;
+			/// Bytes the levels most recently needed on screen would take
+			size_t requestedBytes;
+			/// Number of background loads in progress
+			size_t pendingRequests;
+		};
+		/** Gets the current state of texture streaming. */
+		StreamingStatistics getStreamingStatistics(void) const;
+
+		/** Returns whether any loaded texture streams its mipmaps. */
+		bool _hasStreamedTextures(void) const { return !mStreamedTextures.empty(); }
+		/** Starts tracking a streamed texture once it's loaded. Internal method used by Texture.
+		@param tex The texture
+		@param initialLevels The levels the texture was loaded with, which it reverts to when evicted
+		*/
+		void _registerStreamedTexture(Texture* tex, const Image& initialLevels);
+		/** Stops tracking a streamed texture when it's unloaded. Internal method used by Texture. */
+		void _unregisterStreamedTexture(Texture* tex);
+		/** Notifies the manager that a streamed texture is needed this frame down to
+			the given level of its source mip chain. Queues a background load if the
+			level is not resident and fits in the budget. Internal method used by Texture.
+		*/
+		void _requestStreamedMip(Texture* tex, size_t mip);
+		/** Switches streamed textures to the levels whose uploads are done.
+		@remarks
+			Called by Root once HardwareBufferManager has flushed the uploads of the frame.
+			Until then textures keep their previous levels, so they are never shown half
+			uploaded when setUploadBytesPerFrame spreads the uploads over several frames.
+		*/
+		void _updateStreamedUploads(void);
+
+		/// Implementation for WorkQueue::RequestHandler
+		WorkQueue::Response* handleRequest(const WorkQueue::Request* req, const WorkQueue* srcQ);
+		/// Implementation for WorkQueue::ResponseHandler, hands back the staging memory of aborted loads
+		bool canHandleResponse(const WorkQueue::Response* res, const WorkQueue* srcQ);
+		/// Implementation for WorkQueue::ResponseHandler
+		void handleResponse(const WorkQueue::Response* res, const WorkQueue* srcQ);
+
         /** Override standard Singleton retrieval.
         @remarks
         Why do we do this? Well, it's because the Singleton
@@ -500,6 +574,84 @@ namespace Ogre {
         ushort mPreferredIntegerBitDepth;
         ushort mPreferredFloatBitDepth;
         size_t mDefaultNumMipmaps;
+
+		/// Bookkeeping for a texture which streams its mipmaps
+		struct StreamedTexture
+		{
+			Texture* texture;
+			/// The levels the texture was loaded with
+			Image initialLevels;
+			size_t initialMip;
+			/// Frame number in which the texture was last needed
+			unsigned long lastUsedFrame;
+			/// Finest level needed in that frame
+			size_t wantedMip;
+			/// Pending background load, 0 if none
+			WorkQueue::RequestID ticket;
+			/// Top level of the pending load
+			size_t pendingMip;
+			/// Texture of its own the pending levels are uploaded into, null if none
+			TexturePtr uploadLevels;
+			/// Last upload into uploadLevels, they replace the resident levels once it is done
+			HardwareBufferManager::UploadTicket uploadTicket;
+			/// Set if a load failed, it's not retried
+			bool failed;
+		};
+		typedef map<ResourceHandle, StreamedTexture>::type StreamedTextureMap;
+		StreamedTextureMap mStreamedTextures;
+		bool mDefaultStreaming;
+		size_t mStreamingBudget;
+		size_t mStreamingInitialSize;
+		uint16 mStreamingChannel;
+		bool mStreamingChannelRegistered;
+
+		/// Work item loading part of the mip chain of a texture file in the background
+		struct StreamingRequest
+		{
+			ResourceHandle handle;
+			String name;
+			String group;
+			String type;
+			size_t topMip;
+			/// Top level of the resident levels, the load stops above it
+			size_t residentMip;
+			/// Gamma adjustment of the texture, applied to the loaded levels
+			Real gamma;
+			_OgreExport friend std::ostream& operator<<(std::ostream& o, const StreamingRequest& r)
+			{ (void)r; return o; }
+		};
+		struct StreamingResponse
+		{
+			/// The levels from the top level of the request down to the resident ones
+			SharedPtr<Image> image;
+			/// Upload staging memory holding the image data, 0 if it is on the heap
+			void* staging;
+			StreamingResponse() : staging(0) {}
+			_OgreExport friend std::ostream& operator<<(std::ostream& o, const StreamingResponse& r)
+			{ (void)r; return o; }
+		};
+
+		/// Upload staging memory reserved by background loads, by request. Aborting a
+		/// request destroys its response data, so it's handed back from here.
+		typedef map<WorkQueue::RequestID, void*>::type StreamingStagingMap;
+		StreamingStagingMap mStreamingStaging;
+		OGRE_MUTEX(mStreamingStagingMutex)
+
+		/// Target for ImageCodec::decodeTo keeping only the levels a background load asked for
+		class StreamingDecodeTarget;
+		friend class StreamingDecodeTarget;
+
+		/// Hands back the staging memory reserved by a background load, if any
+		void releaseStreamingStaging(WorkQueue::RequestID id);
+		/// Drops the pending background load of a streamed texture
+		void abortStreamedLoad(StreamedTexture& st);
+		/// Gets the memory the streamed textures use, or will once pending loads complete
+		size_t getStreamingCommittedMemory(void) const;
+		/// Destroys the texture the levels of a finished load are uploaded into, with its queued uploads
+		void dropStreamedUpload(StreamedTexture& st);
+		/// Reverts the least recently used streamed textures to their initial levels until
+		/// they fit in the budget along with reserve more bytes
+		void enforceStreamingBudget(size_t reserve = 0);
     };
 	/** @} */
 	/** @} */
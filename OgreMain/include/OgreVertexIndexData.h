@@ -31,6 +31,7 @@ THE SOFTWARE.
 #include "OgrePrerequisites.h"
 #include "OgreHardwareVertexBuffer.h"
 #include "OgreHardwareIndexBuffer.h"
+#include "OgreVector3.h"
 #include "OgreHeaderPrefix.h"
 
 namespace Ogre {
@@ -101,6 +102,16 @@ namespace Ogre {
 		HardwareAnimationDataList hwAnimationDataList;
 		/// Number of hardware animation data items used
 		size_t hwAnimDataItemsUsed;
+
+		/** Scale to apply to quantised positions, see quantise.
+		@remarks
+			A VET_SHORT4_SNORM position is read as [-1, 1] by shaders, which have
+			to compute position.xyz * positionScale + positionBias to get the
+			original value back. Unit scale and zero bias otherwise.
+		*/
+		Vector3 positionScale;
+		/// Bias to apply to quantised positions after positionScale
+		Vector3 positionBias;
 		
 		/** Clones this vertex data, potentially including replicating any vertex buffers.
 		@param copyData Whether to create new vertex buffers too or just reference the existing ones
@@ -216,6 +227,44 @@ namespace Ogre {
 		*/
 		void convertPackedColour(VertexElementType srcType, VertexElementType destType);
 
+		/** Converts float vertex elements to smaller formats to save memory and bandwidth.
+		@remarks
+			Positions become VET_SHORT4_SNORM relative to their bounding box, with
+			positionScale and positionBias holding the transform back. Normals, binormals
+			and tangents become VET_SHORT4_SNORM and texture coordinates become VET_HALF2
+			or VET_HALF4. Four component tangents keep their parity in w, three component
+			ones get a w of 1. Every buffer using a converted element is recreated with a
+			tighter layout.
+		@par
+			Only vertex programs read the compact formats, the fixed function pipelines
+			do not take them for positions and normals; on D3D9 for instance only float
+			positions and three component normals are accepted without a vertex shader.
+			Quantised positions in particular need a vertex program applying the scale
+			and bias, and software skinning, morph animation and shadow volume extrusion,
+			which read positions as floats, must not be used on the result. Meshes holding
+			these formats can only be written as MESH_VERSION_1_10 or later.
+		@param positions Whether to quantise VET_FLOAT3 positions
+		@param normals Whether to quantise VET_FLOAT3 / VET_FLOAT4 normals, binormals and tangents
+		@param textureCoordinates Whether to convert VET_FLOAT2 to VET_FLOAT4 texture coordinates to halfs
+		@return True if any element was converted
+		*/
+		bool quantise(bool positions = true, bool normals = true, bool textureCoordinates = true);
+
+		/** Reads the position of one vertex, decoding quantised formats.
+		@remarks
+			CPU side consumers of positions (edge lists, tangents, Lod generation) use this
+			so they work on quantised vertex data as well. VET_FLOAT3 positions are read
+			as they are, VET_SHORT4_SNORM and VET_HALF4 positions get positionScale and
+			positionBias applied. Other formats cause an exception, check them with
+			canReadPosition before locking any buffers.
+		@param posElem The position element of this vertex data
+		@param pBaseVertex Pointer to the start of the vertex in the buffer holding posElem
+		*/
+		Vector3 readPosition(const VertexElement* posElem, const void* pBaseVertex) const;
+		/// Whether readPosition can decode positions of the given type
+		static bool canReadPosition(VertexElementType type)
+		{ return type == VET_FLOAT3 || type == VET_SHORT4_SNORM || type == VET_HALF4; }
+
 
 		/** Allocate elements to serve a holder of morph / pose target data 
 			for hardware morphing / pose blending.
@@ -234,6 +283,18 @@ namespace Ogre {
 		*/
 		ushort allocateHardwareAnimationElements(ushort count, bool animateNormals);
 
+		/** Reorders the vertices in the order the given index data first reference them,
+			which improves the locality of vertex fetches, and remaps the index data to match.
+		@remarks
+			Vertices which aren't referenced at all are moved to the end. Anything else
+			addressing these vertices by index (bone assignments, poses, vertex animation)
+			has to be remapped by the caller, using outVertexRemap.
+		@param indexDataList All index data referencing this vertex data, in rendering order
+		@param outVertexRemap Receives the new index of each vertex, indexed by the old one
+		*/
+		void optimiseVertexFetch(const vector<IndexData*>::type& indexDataList,
+			vector<uint32>::type& outVertexRemap);
+
 
 
 	};
@@ -272,8 +333,16 @@ namespace Ogre {
 			Can only be used for index data which consists of triangle lists.
 			It would in fact be pointless to use it on triangle strips or fans
 			in any case.
+		@par
+			Uses Tom Forsyth's linear-speed vertex cache optimisation, which does not
+			depend on the exact cache size of the hardware.
 		*/
 		void optimiseVertexCacheTriList(void);
+
+		/** Replaces every index by its entry in a vertex remap table.
+		@param vertexRemap The new index of each vertex, indexed by the old one
+		*/
+		void remapIndexes(const vector<uint32>::type& vertexRemap);
 	
 	};
 
@@ -301,12 +370,25 @@ namespace Ogre {
 			}
 
 			void profile(const HardwareIndexBufferSharedPtr& indexBuffer);
+			/// Profiles the range of the index buffer used by the index data
+			void profile(const IndexData* indexData);
 			void reset() { hit = 0; miss = 0; tail = 0; buffersize = 0; }
 			void flush() { tail = 0; buffersize = 0; }
 
 			unsigned int getHits() { return hit; }
 			unsigned int getMisses() { return miss; }
 			unsigned int getSize() { return size; }
+
+			/** Average cache miss ratio, the transformed vertices per triangle. Around 0.5 to 0.7
+				is good for regular meshes, 3 means the cache didn't help at all.
+			*/
+			Real getACMR(size_t triangleCount) const
+			{ return triangleCount ? (Real)miss / (Real)triangleCount : 0; }
+			/** Average transform to vertex ratio, the transformed vertices per referenced
+				vertex. 1 is the optimum.
+			*/
+			Real getATVR(size_t vertexCount) const
+			{ return vertexCount ? (Real)miss / (Real)vertexCount : 0; }
 		private:
 			unsigned int size;
 			uint32 *cache;
@@ -0,0 +1,906 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgrePixelFormat.h"
+#include "OgreException.h"
+#include "OgrePlatformInformation.h"
+#include "OgreParallelFor.h"
+
+// SSE2 is needed for the integer distance kernel, 32 bit gcc builds only get -msse
+#if __OGRE_HAVE_SSE && (OGRE_COMPILER == OGRE_COMPILER_MSVC || defined(__SSE2__))
+#   define OGRE_BLOCKCOMPRESSION_SSE2 1
+#   include <emmintrin.h>
+#else
+#   define OGRE_BLOCKCOMPRESSION_SSE2 0
+#endif
+
+namespace Ogre {
+
+    namespace
+    {
+#if OGRE_BLOCKCOMPRESSION_SSE2
+        const bool gBlockCompressionHasSSE2 = (PlatformInformation::getCpuFeatures() &
+            PlatformInformation::CPU_FEATURE_SSE2) != 0;
+#endif
+
+        inline int clampInt(int v, int lo, int hi)
+        {
+            return v < lo ? lo : (v > hi ? hi : v);
+        }
+        inline int roundToInt(float v)
+        {
+            return static_cast<int>(v < 0 ? v - 0.5f : v + 0.5f);
+        }
+        //-----------------------------------------------------------------------
+        // RGB565 endpoints as a BC1 decoder expands them
+        inline int expand5(int v) { return (v << 3) | (v >> 2); }
+        inline int expand6(int v) { return (v << 2) | (v >> 4); }
+
+        inline uint16 quantiseRGB565(const float* rgb)
+        {
+            const int r = clampInt(roundToInt(rgb[0] * (31.0f / 255.0f)), 0, 31);
+            const int g = clampInt(roundToInt(rgb[1] * (63.0f / 255.0f)), 0, 63);
+            const int b = clampInt(roundToInt(rgb[2] * (31.0f / 255.0f)), 0, 31);
+            return static_cast<uint16>((r << 11) | (g << 5) | b);
+        }
+        //-----------------------------------------------------------------------
+        /** Endpoint pairs whose 2/3 interpolant reproduces a single 8 bit value as closely
+            as 565 allows. Used for blocks of one flat colour, which are common in generated
+            content and come out noticeably off when both endpoints are just rounded.
+        */
+        struct SingleColourTables
+        {
+            uint8 five[256][2];
+            uint8 six[256][2];
+
+            SingleColourTables()
+            {
+                build(five, 5);
+                build(six, 6);
+            }
+            static void build(uint8 (*table)[2], int bits)
+            {
+                const int levels = 1 << bits;
+                for(int v = 0; v < 256; ++v)
+                {
+                    int bestError = 256;
+                    for(int e0 = 0; e0 < levels && bestError; ++e0)
+                    {
+                        const int v0 = bits == 5 ? expand5(e0) : expand6(e0);
+                        // Try the levels either side of the ideal second endpoint
+                        const int ideal = (3 * v - 2 * v0) * (levels - 1) / 255;
+                        for(int e1 = std::max(ideal - 1, 0); e1 <= std::min(ideal + 1, levels - 1); ++e1)
+                        {
+                            const int v1 = bits == 5 ? expand5(e1) : expand6(e1);
+                            const int error = std::abs((2 * v0 + v1) / 3 - v);
+                            if(error < bestError)
+                            {
+                                bestError = error;
+                                table[v][0] = static_cast<uint8>(e0);
+                                table[v][1] = static_cast<uint8>(e1);
+                            }
+                        }
+                    }
+                }
+            }
+        };
+        const SingleColourTables gSingleColourTables;
+        //-----------------------------------------------------------------------
+        /** Find the nearest palette entry for each pixel.
+            @param pixels       RGBA bytes
+            @param palette      RGBA bytes
+            @param channels     3 to ignore alpha, 4 to include it
+            @returns the summed squared error
+        */
+        uint32 matchPalette(const uint8* pixels, size_t count, const uint8* palette,
+            size_t paletteSize, size_t channels, uint8* indices)
+        {
+            uint32 total = 0;
+            size_t i = 0;
+#if OGRE_BLOCKCOMPRESSION_SSE2
+            if(gBlockCompressionHasSSE2)
+            {
+                // Four pixels at a time, widened to 16 bits so madd sums the squared
+                // differences of two channels in each 32 bit lane
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i mask = _mm_set1_epi32(channels == 4 ? -1 : 0x00FFFFFF);
+                for(; i + 4 <= count; i += 4)
+                {
+                    const __m128i px = _mm_and_si128(
+                        _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i * 4)), mask);
+                    const __m128i pxLo = _mm_unpacklo_epi8(px, zero);
+                    const __m128i pxHi = _mm_unpackhi_epi8(px, zero);
+                    __m128i best = _mm_set1_epi32(0x7FFFFFFF);
+                    __m128i bestIndex = zero;
+                    for(size_t j = 0; j < paletteSize; ++j)
+                    {
+                        int colour;
+                        memcpy(&colour, palette + j * 4, 4);
+                        const __m128i c = _mm_unpacklo_epi8(_mm_and_si128(_mm_set1_epi32(colour), mask), zero);
+                        __m128i lo = _mm_sub_epi16(pxLo, c);
+                        __m128i hi = _mm_sub_epi16(pxHi, c);
+                        lo = _mm_madd_epi16(lo, lo);
+                        hi = _mm_madd_epi16(hi, hi);
+                        const __m128 loF = _mm_castsi128_ps(lo), hiF = _mm_castsi128_ps(hi);
+                        const __m128i dist = _mm_add_epi32(
+                            _mm_castps_si128(_mm_shuffle_ps(loF, hiF, _MM_SHUFFLE(2, 0, 2, 0))),
+                            _mm_castps_si128(_mm_shuffle_ps(loF, hiF, _MM_SHUFFLE(3, 1, 3, 1))));
+                        const __m128i closer = _mm_cmplt_epi32(dist, best);
+                        best = _mm_or_si128(_mm_and_si128(closer, dist), _mm_andnot_si128(closer, best));
+                        bestIndex = _mm_or_si128(_mm_and_si128(closer, _mm_set1_epi32(static_cast<int>(j))),
+                            _mm_andnot_si128(closer, bestIndex));
+                    }
+                    uint32 distances[4], bestIndices[4];
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(distances), best);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(bestIndices), bestIndex);
+                    for(size_t k = 0; k < 4; ++k)
+                    {
+                        indices[i + k] = static_cast<uint8>(bestIndices[k]);
+                        total += distances[k];
+                    }
+                }
+            }
+#endif
+            for(; i < count; ++i)
+            {
+                const uint8* p = pixels + i * 4;
+                uint32 best = 0xFFFFFFFF;
+                for(size_t j = 0; j < paletteSize; ++j)
+                {
+                    const uint8* c = palette + j * 4;
+                    uint32 dist = 0;
+                    for(size_t ch = 0; ch < channels; ++ch)
+                    {
+                        const int d = int(p[ch]) - int(c[ch]);
+                        dist += d * d;
+                    }
+                    if(dist < best)
+                    {
+                        best = dist;
+                        indices[i] = static_cast<uint8>(j);
+                    }
+                }
+                total += best;
+            }
+            return total;
+        }
+        //-----------------------------------------------------------------------
+        /** Endpoints spanning the bounding box of the pixels, picking the diagonal
+            that follows the sign of each channel's covariance with the widest one.
+        */
+        void boundingBoxEndpoints(const uint8* pixels, size_t count, size_t channels,
+            float* e0, float* e1)
+        {
+            float mean[4] = { 0, 0, 0, 0 };
+            int lo[4] = { 255, 255, 255, 255 }, hi[4] = { 0, 0, 0, 0 };
+            for(size_t i = 0; i < count; ++i)
+            {
+                for(size_t ch = 0; ch < channels; ++ch)
+                {
+                    const int v = pixels[i * 4 + ch];
+                    lo[ch] = std::min(lo[ch], v);
+                    hi[ch] = std::max(hi[ch], v);
+                    mean[ch] += v;
+                }
+            }
+            size_t widest = 0;
+            for(size_t ch = 0; ch < channels; ++ch)
+            {
+                mean[ch] /= count;
+                if(hi[ch] - lo[ch] > hi[widest] - lo[widest])
+                    widest = ch;
+            }
+            for(size_t ch = 0; ch < channels; ++ch)
+            {
+                float covariance = 0;
+                for(size_t i = 0; i < count; ++i)
+                    covariance += (pixels[i * 4 + ch] - mean[ch]) * (pixels[i * 4 + widest] - mean[widest]);
+                // Inset by 1/16th of the range, the extremes are rarely worth a whole palette entry
+                const float inset = (hi[ch] - lo[ch]) / 16.0f;
+                const float top = hi[ch] - inset, bottom = lo[ch] + inset;
+                e0[ch] = covariance < 0 ? bottom : top;
+                e1[ch] = covariance < 0 ? top : bottom;
+            }
+        }
+        //-----------------------------------------------------------------------
+        /** Endpoints at the extremes of the pixels' projection on their principal axis,
+            found with a few power iterations on the covariance matrix.
+        */
+        void principalAxisEndpoints(const uint8* pixels, size_t count, size_t channels,
+            size_t iterations, float* e0, float* e1)
+        {
+            float mean[4] = { 0, 0, 0, 0 };
+            for(size_t i = 0; i < count; ++i)
+                for(size_t ch = 0; ch < channels; ++ch)
+                    mean[ch] += pixels[i * 4 + ch];
+            for(size_t ch = 0; ch < channels; ++ch)
+                mean[ch] /= count;
+
+            float covariance[4][4] = { { 0 } };
+            for(size_t i = 0; i < count; ++i)
+            {
+                float d[4];
+                for(size_t ch = 0; ch < channels; ++ch)
+                    d[ch] = pixels[i * 4 + ch] - mean[ch];
+                for(size_t r = 0; r < channels; ++r)
+                    for(size_t c = r; c < channels; ++c)
+                        covariance[r][c] += d[r] * d[c];
+            }
+            for(size_t r = 0; r < channels; ++r)
+                for(size_t c = 0; c < r; ++c)
+                    covariance[r][c] = covariance[c][r];
+
+            // Start from the row of the channel that varies most
+            size_t widest = 0;
+            for(size_t ch = 1; ch < channels; ++ch)
+                if(covariance[ch][ch] > covariance[widest][widest])
+                    widest = ch;
+            float axis[4];
+            for(size_t ch = 0; ch < channels; ++ch)
+                axis[ch] = covariance[widest][ch];
+            for(size_t it = 0; it < iterations; ++it)
+            {
+                float next[4], largest = 0;
+                for(size_t r = 0; r < channels; ++r)
+                {
+                    next[r] = 0;
+                    for(size_t c = 0; c < channels; ++c)
+                        next[r] += covariance[r][c] * axis[c];
+                    largest = std::max(largest, std::abs(next[r]));
+                }
+                if(largest == 0)
+                    break;
+                for(size_t ch = 0; ch < channels; ++ch)
+                    axis[ch] = next[ch] / largest;
+            }
+
+            float tMin = 0, tMax = 0;
+            for(size_t i = 0; i < count; ++i)
+            {
+                float t = 0;
+                for(size_t ch = 0; ch < channels; ++ch)
+                    t += (pixels[i * 4 + ch] - mean[ch]) * axis[ch];
+                tMin = std::min(tMin, t);
+                tMax = std::max(tMax, t);
+            }
+            float lengthSq = 0;
+            for(size_t ch = 0; ch < channels; ++ch)
+                lengthSq += axis[ch] * axis[ch];
+            if(lengthSq > 0)
+            {
+                tMin /= lengthSq;
+                tMax /= lengthSq;
+            }
+            for(size_t ch = 0; ch < channels; ++ch)
+            {
+                e0[ch] = mean[ch] + axis[ch] * tMax;
+                e1[ch] = mean[ch] + axis[ch] * tMin;
+            }
+        }
+        //-----------------------------------------------------------------------
+        /** Least squares endpoints for the pixels, given how far along from e0 to e1
+            each of them was placed. Returns false if the weights cannot determine them.
+        */
+        bool fitEndpoints(const uint8* pixels, size_t count, size_t channels,
+            const float* weights, float* e0, float* e1)
+        {
+            float a = 0, b = 0, c = 0;
+            float x0[4] = { 0, 0, 0, 0 }, x1[4] = { 0, 0, 0, 0 };
+            for(size_t i = 0; i < count; ++i)
+            {
+                const float t = weights[i], s = 1 - t;
+                a += s * s;
+                b += s * t;
+                c += t * t;
+                for(size_t ch = 0; ch < channels; ++ch)
+                {
+                    x0[ch] += s * pixels[i * 4 + ch];
+                    x1[ch] += t * pixels[i * 4 + ch];
+                }
+            }
+            const float det = a * c - b * b;
+            if(std::abs(det) < 1e-4f)
+                return false;
+            for(size_t ch = 0; ch < channels; ++ch)
+            {
+                e0[ch] = std::min(std::max((c * x0[ch] - b * x1[ch]) / det, 0.0f), 255.0f);
+                e1[ch] = std::min(std::max((a * x1[ch] - b * x0[ch]) / det, 0.0f), 255.0f);
+            }
+            return true;
+        }
+        //-----------------------------------------------------------------------
+        size_t refinementPasses(CompressionQuality quality)
+        {
+            return quality == CQ_FASTEST ? 0 : (quality == CQ_NORMAL ? 1 : 4);
+        }
+        //-----------------------------------------------------------------------
+        /// The palette a BC1 decoder derives from two endpoints, as RGBA bytes
+        void bc1Palette(uint16 c0, uint16 c1, bool fourColour, uint8* palette)
+        {
+            const int a[3] = { expand5(c0 >> 11), expand6((c0 >> 5) & 63), expand5(c0 & 31) };
+            const int b[3] = { expand5(c1 >> 11), expand6((c1 >> 5) & 63), expand5(c1 & 31) };
+            for(size_t ch = 0; ch < 3; ++ch)
+            {
+                palette[ch] = static_cast<uint8>(a[ch]);
+                palette[4 + ch] = static_cast<uint8>(b[ch]);
+                palette[8 + ch] = static_cast<uint8>(fourColour ? (2 * a[ch] + b[ch]) / 3 : (a[ch] + b[ch]) / 2);
+                palette[12 + ch] = static_cast<uint8>(fourColour ? (a[ch] + 2 * b[ch]) / 3 : 0);
+            }
+            palette[3] = palette[7] = palette[11] = palette[15] = 255;
+        }
+        //-----------------------------------------------------------------------
+        /** Encode the colour of a 4x4 block as BC1.
+            @param block            16 RGBA pixels
+            @param allowTransparent Use the 3 colour mode for pixels with alpha below 128 (DXT1)
+        */
+        void encodeBC1Colour(const uint8* block, bool allowTransparent, CompressionQuality quality, uint8* out)
+        {
+            // Transparent pixels are left out of the fit and get index 3
+            uint8 pixels[64], positions[16];
+            size_t count = 0;
+            for(size_t i = 0; i < 16; ++i)
+            {
+                if(allowTransparent && block[i * 4 + 3] < 128)
+                    continue;
+                memcpy(pixels + count * 4, block + i * 4, 4);
+                positions[count++] = static_cast<uint8>(i);
+            }
+            const bool fourColour = count == 16;
+            const size_t paletteSize = fourColour ? 4 : 3;
+
+            uint16 c0 = 0, c1 = 0;
+            uint8 indices[16] = { 0 };
+            bool flat = true;
+            for(size_t i = 1; i < count && flat; ++i)
+                flat = memcmp(pixels, pixels + i * 4, 3) == 0;
+
+            if(count == 0)
+            {
+                // Fully transparent, c0 == c1 selects the 3 colour mode
+            }
+            else if(flat && fourColour)
+            {
+                const SingleColourTables& t = gSingleColourTables;
+                c0 = static_cast<uint16>((t.five[pixels[0]][0] << 11) | (t.six[pixels[1]][0] << 5) | t.five[pixels[2]][0]);
+                c1 = static_cast<uint16>((t.five[pixels[0]][1] << 11) | (t.six[pixels[1]][1] << 5) | t.five[pixels[2]][1]);
+                for(size_t i = 0; i < count; ++i)
+                    indices[i] = 2;
+            }
+            else
+            {
+                float e0[3], e1[3];
+                if(quality == CQ_FASTEST)
+                    boundingBoxEndpoints(pixels, count, 3, e0, e1);
+                else
+                    principalAxisEndpoints(pixels, count, 3, quality == CQ_BEST ? 8 : 4, e0, e1);
+                c0 = quantiseRGB565(e0);
+                c1 = quantiseRGB565(e1);
+                uint8 palette[16];
+                bc1Palette(c0, c1, fourColour, palette);
+                uint32 error = matchPalette(pixels, count, palette, paletteSize, 3, indices);
+
+                // Palette position of each index, from c0 (0) to c1 (1)
+                const float fourWeights[4] = { 0, 1, 1.0f / 3, 2.0f / 3 };
+                const float threeWeights[3] = { 0, 1, 0.5f };
+                const float* positionOf = fourColour ? fourWeights : threeWeights;
+                const size_t passes = refinementPasses(quality);
+                for(size_t pass = 0; pass < passes && error; ++pass)
+                {
+                    float weights[16];
+                    for(size_t i = 0; i < count; ++i)
+                        weights[i] = positionOf[indices[i]];
+                    if(!fitEndpoints(pixels, count, 3, weights, e0, e1))
+                        break;
+                    const uint16 n0 = quantiseRGB565(e0), n1 = quantiseRGB565(e1);
+                    if(n0 == c0 && n1 == c1)
+                        break;
+                    uint8 newIndices[16];
+                    bc1Palette(n0, n1, fourColour, palette);
+                    const uint32 newError = matchPalette(pixels, count, palette, paletteSize, 3, newIndices);
+                    if(newError >= error)
+                        break;
+                    error = newError;
+                    c0 = n0;
+                    c1 = n1;
+                    memcpy(indices, newIndices, count);
+                }
+            }
+
+            // The endpoint order selects the mode, 4 colours need c0 > c1
+            if(fourColour ? c0 < c1 : c0 > c1)
+            {
+                std::swap(c0, c1);
+                for(size_t i = 0; i < count; ++i)
+                    indices[i] = static_cast<uint8>(indices[i] < 2 || fourColour ? indices[i] ^ 1 : indices[i]);
+            }
+            else if(fourColour && c0 == c1)
+            {
+                // That would decode as the 3 colour mode, every index but 3 gives c0 though
+                memset(indices, 0, sizeof(indices));
+            }
+
+            uint32 bits = fourColour ? 0 : 0xFFFFFFFF;
+            for(size_t i = 0; i < count; ++i)
+            {
+                const size_t shift = 2 * (fourColour ? i : positions[i]);
+                bits = (bits & ~(3u << shift)) | (uint32(indices[i]) << shift);
+            }
+            out[0] = static_cast<uint8>(c0);
+            out[1] = static_cast<uint8>(c0 >> 8);
+            out[2] = static_cast<uint8>(c1);
+            out[3] = static_cast<uint8>(c1 >> 8);
+            for(size_t i = 0; i < 4; ++i)
+                out[4 + i] = static_cast<uint8>(bits >> (8 * i));
+        }
+        //-----------------------------------------------------------------------
+        /// Encode the alpha of a 4x4 block as the explicit 4 bit alpha of DXT2 and DXT3
+        void encodeExplicitAlpha(const uint8* block, uint8* out)
+        {
+            memset(out, 0, 8);
+            for(size_t i = 0; i < 16; ++i)
+            {
+                const int a = (block[i * 4 + 3] * 15 + 127) / 255;
+                out[i / 2] |= static_cast<uint8>(a << (4 * (i & 1)));
+            }
+        }
+        //-----------------------------------------------------------------------
+        /// The palette a BC4 decoder derives from two endpoints
+        void bc4Palette(int a0, int a1, int high, int* palette)
+        {
+            palette[0] = a0;
+            palette[1] = a1;
+            if(a0 > a1)
+            {
+                for(int i = 2; i < 8; ++i)
+                    palette[i] = ((8 - i) * a0 + (i - 1) * a1 + 3) / 7;
+            }
+            else
+            {
+                for(int i = 2; i < 6; ++i)
+                    palette[i] = ((6 - i) * a0 + (i - 1) * a1 + 2) / 5;
+                palette[6] = 0;
+                palette[7] = high;
+            }
+        }
+        uint32 matchBC4Palette(const int* values, const int* palette, uint8* indices)
+        {
+            uint32 total = 0;
+            for(size_t i = 0; i < 16; ++i)
+            {
+                uint32 best = 0xFFFFFFFF;
+                for(size_t j = 0; j < 8; ++j)
+                {
+                    const int d = values[i] - palette[j];
+                    if(uint32(d * d) < best)
+                    {
+                        best = d * d;
+                        indices[i] = static_cast<uint8>(j);
+                    }
+                }
+                total += best;
+            }
+            return total;
+        }
+        //-----------------------------------------------------------------------
+        /** Encode 16 single channel values as a BC4 block, also the alpha half of DXT4/5.
+            @param values   First value, the others follow every stride bytes
+            @param high     What the 6 value mode's 1.0 decodes to, 255 or 254 for signed
+                            data offset by 127
+        */
+        void encodeBC4Block(const uint8* values, size_t stride, int high, CompressionQuality quality, uint8* out)
+        {
+            int v[16], lo = 255, hi = 0;
+            for(size_t i = 0; i < 16; ++i)
+            {
+                v[i] = values[i * stride];
+                lo = std::min(lo, v[i]);
+                hi = std::max(hi, v[i]);
+            }
+
+            int a0 = hi, a1 = lo;
+            int palette[8];
+            uint8 indices[16] = { 0 };
+            uint32 error = 0;
+            if(lo != hi)
+            {
+                bc4Palette(a0, a1, high, palette);
+                error = matchBC4Palette(v, palette, indices);
+
+                // Pull the endpoints in where that reduces the error
+                const float positionOf[8] = { 0, 1, 1 / 7.0f, 2 / 7.0f, 3 / 7.0f, 4 / 7.0f, 5 / 7.0f, 6 / 7.0f };
+                const size_t passes = refinementPasses(quality);
+                for(size_t pass = 0; pass < passes && error; ++pass)
+                {
+                    float a = 0, b = 0, c = 0, x0 = 0, x1 = 0;
+                    for(size_t i = 0; i < 16; ++i)
+                    {
+                        const float t = positionOf[indices[i]], s = 1 - t;
+                        a += s * s; b += s * t; c += t * t;
+                        x0 += s * v[i]; x1 += t * v[i];
+                    }
+                    const float det = a * c - b * b;
+                    if(std::abs(det) < 1e-4f)
+                        break;
+                    const int n0 = clampInt(roundToInt((c * x0 - b * x1) / det), 0, high);
+                    const int n1 = clampInt(roundToInt((a * x1 - b * x0) / det), 0, high);
+                    if(n0 <= n1 || (n0 == a0 && n1 == a1))
+                        break;
+                    int newPalette[8];
+                    uint8 newIndices[16];
+                    bc4Palette(n0, n1, high, newPalette);
+                    const uint32 newError = matchBC4Palette(v, newPalette, newIndices);
+                    if(newError >= error)
+                        break;
+                    error = newError;
+                    a0 = n0;
+                    a1 = n1;
+                    memcpy(indices, newIndices, sizeof(indices));
+                }
+
+                // Blocks holding the extremes and some values in between may do better with
+                // the 6 value mode, which has 0 and 1 for free
+                if(quality != CQ_FASTEST && error && (lo == 0 || hi == high))
+                {
+                    int innerLo = high, innerHi = 0;
+                    for(size_t i = 0; i < 16; ++i)
+                    {
+                        if(v[i] != 0 && v[i] != high)
+                        {
+                            innerLo = std::min(innerLo, v[i]);
+                            innerHi = std::max(innerHi, v[i]);
+                        }
+                    }
+                    if(innerLo > innerHi)
+                        innerLo = innerHi = 0;
+                    int sixPalette[8];
+                    uint8 sixIndices[16];
+                    bc4Palette(innerLo, innerHi, high, sixPalette);
+                    const uint32 sixError = matchBC4Palette(v, sixPalette, sixIndices);
+                    if(sixError < error)
+                    {
+                        a0 = innerLo;
+                        a1 = innerHi;
+                        memcpy(indices, sixIndices, sizeof(indices));
+                    }
+                }
+            }
+
+            out[0] = static_cast<uint8>(a0);
+            out[1] = static_cast<uint8>(a1);
+            uint64 bits = 0;
+            for(size_t i = 0; i < 16; ++i)
+                bits |= uint64(indices[i]) << (3 * i);
+            for(size_t i = 0; i < 6; ++i)
+                out[2 + i] = static_cast<uint8>(bits >> (8 * i));
+        }
+        //-----------------------------------------------------------------------
+        /// BC4 for signed formats, mapping 0..255 onto -127..127
+        void encodeSignedBC4Block(const uint8* values, size_t stride, CompressionQuality quality, uint8* out)
+        {
+            // Work on the values offset by 127, which keeps them and the palette in 0..254
+            uint8 offset[16];
+            for(size_t i = 0; i < 16; ++i)
+                offset[i] = static_cast<uint8>((values[i * stride] * 254 + 127) / 255);
+            encodeBC4Block(offset, 1, 254, quality, out);
+            out[0] = static_cast<uint8>(out[0] - 127);
+            out[1] = static_cast<uint8>(out[1] - 127);
+        }
+        //-----------------------------------------------------------------------
+        /// Writes a block a few bits at a time, least significant bit first
+        struct BlockBitWriter
+        {
+            uint8* out;
+            size_t position;
+
+            BlockBitWriter(uint8* block) : out(block), position(0) {}
+            void write(uint32 value, size_t bits)
+            {
+                for(size_t i = 0; i < bits; ++i, ++position)
+                    out[position >> 3] |= static_cast<uint8>(((value >> i) & 1) << (position & 7));
+            }
+        };
+        //-----------------------------------------------------------------------
+        /// The palette a BC7 decoder derives from two 8 bit endpoints with 4 bit indices
+        void bc7Palette(const uint8* e0, const uint8* e1, uint8* palette)
+        {
+            static const int weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+            for(size_t i = 0; i < 16; ++i)
+                for(size_t ch = 0; ch < 4; ++ch)
+                    palette[i * 4 + ch] = static_cast<uint8>(((64 - weights[i]) * e0[ch] + weights[i] * e1[ch] + 32) >> 6);
+        }
+        /// Quantise an endpoint to 7 bits per channel plus the shared lowest bit
+        void quantiseBC7Endpoint(const float* e, uint8* quantised, uint8* pBit)
+        {
+            int bestError = 0x7FFFFFFF;
+            for(int p = 0; p < 2; ++p)
+            {
+                uint8 candidate[4];
+                int error = 0;
+                for(size_t ch = 0; ch < 4; ++ch)
+                {
+                    const int q = clampInt(roundToInt((e[ch] - p) * 0.5f), 0, 127);
+                    candidate[ch] = static_cast<uint8>((q << 1) | p);
+                    const int d = roundToInt(e[ch]) - candidate[ch];
+                    error += d * d;
+                }
+                if(error < bestError)
+                {
+                    bestError = error;
+                    memcpy(quantised, candidate, 4);
+                    *pBit = static_cast<uint8>(p);
+                }
+            }
+        }
+        //-----------------------------------------------------------------------
+        /** Encode a 4x4 block as BC7. Only mode 6 is used: one RGBA endpoint pair and
+            16 interpolation steps, which is cheap to search and handles alpha well.
+        */
+        void encodeBC7Block(const uint8* block, CompressionQuality quality, uint8* out)
+        {
+            float e0[4], e1[4];
+            if(quality == CQ_FASTEST)
+                boundingBoxEndpoints(block, 16, 4, e0, e1);
+            else
+                principalAxisEndpoints(block, 16, 4, quality == CQ_BEST ? 8 : 4, e0, e1);
+
+            uint8 q0[4], q1[4], p0, p1, palette[64], indices[16];
+            quantiseBC7Endpoint(e0, q0, &p0);
+            quantiseBC7Endpoint(e1, q1, &p1);
+            bc7Palette(q0, q1, palette);
+            uint32 error = matchPalette(block, 16, palette, 16, 4, indices);
+
+            const size_t passes = refinementPasses(quality);
+            for(size_t pass = 0; pass < passes && error; ++pass)
+            {
+                static const float positionOf[16] = { 0, 4 / 64.0f, 9 / 64.0f, 13 / 64.0f,
+                    17 / 64.0f, 21 / 64.0f, 26 / 64.0f, 30 / 64.0f, 34 / 64.0f, 38 / 64.0f,
+                    43 / 64.0f, 47 / 64.0f, 51 / 64.0f, 55 / 64.0f, 60 / 64.0f, 1 };
+                float weights[16];
+                for(size_t i = 0; i < 16; ++i)
+                    weights[i] = positionOf[indices[i]];
+                if(!fitEndpoints(block, 16, 4, weights, e0, e1))
+                    break;
+                uint8 n0[4], n1[4], np0, np1, newIndices[16];
+                quantiseBC7Endpoint(e0, n0, &np0);
+                quantiseBC7Endpoint(e1, n1, &np1);
+                bc7Palette(n0, n1, palette);
+                const uint32 newError = matchPalette(block, 16, palette, 16, 4, newIndices);
+                if(newError >= error)
+                    break;
+                error = newError;
+                memcpy(q0, n0, 4);
+                memcpy(q1, n1, 4);
+                p0 = np0;
+                p1 = np1;
+                memcpy(indices, newIndices, sizeof(indices));
+            }
+
+            // The first index is stored without its top bit, so it must be below 8
+            if(indices[0] >= 8)
+            {
+                for(size_t ch = 0; ch < 4; ++ch)
+                    std::swap(q0[ch], q1[ch]);
+                std::swap(p0, p1);
+                for(size_t i = 0; i < 16; ++i)
+                    indices[i] = static_cast<uint8>(15 - indices[i]);
+            }
+
+            memset(out, 0, 16);
+            BlockBitWriter writer(out);
+            writer.write(1 << 6, 7);
+            for(size_t ch = 0; ch < 4; ++ch)
+            {
+                writer.write(q0[ch] >> 1, 7);
+                writer.write(q1[ch] >> 1, 7);
+            }
+            writer.write(p0, 1);
+            writer.write(p1, 1);
+            writer.write(indices[0], 3);
+            for(size_t i = 1; i < 16; ++i)
+                writer.write(indices[i], 4);
+        }
+        //-----------------------------------------------------------------------
+        size_t getBlockBytes(PixelFormat format)
+        {
+            return (format == PF_DXT1 || format == PF_BC4_UNORM || format == PF_BC4_SNORM) ? 8 : 16;
+        }
+        //-----------------------------------------------------------------------
+        void encodeBlock(const uint8* block, PixelFormat format, CompressionQuality quality, uint8* out)
+        {
+            switch(format)
+            {
+            case PF_DXT1:
+                encodeBC1Colour(block, true, quality, out);
+                break;
+            case PF_DXT2:
+            case PF_DXT3:
+                encodeExplicitAlpha(block, out);
+                encodeBC1Colour(block, false, quality, out + 8);
+                break;
+            case PF_DXT4:
+            case PF_DXT5:
+                encodeBC4Block(block + 3, 4, 255, quality, out);
+                encodeBC1Colour(block, false, quality, out + 8);
+                break;
+            case PF_BC4_UNORM:
+                encodeBC4Block(block, 4, 255, quality, out);
+                break;
+            case PF_BC4_SNORM:
+                encodeSignedBC4Block(block, 4, quality, out);
+                break;
+            case PF_BC5_UNORM:
+                encodeBC4Block(block, 4, 255, quality, out);
+                encodeBC4Block(block + 1, 4, 255, quality, out + 8);
+                break;
+            case PF_BC5_SNORM:
+                encodeSignedBC4Block(block, 4, quality, out);
+                encodeSignedBC4Block(block + 1, 4, quality, out + 8);
+                break;
+            case PF_BC7_UNORM:
+            case PF_BC7_UNORM_SRGB:
+                encodeBC7Block(block, quality, out);
+                break;
+            default:
+                break;
+            }
+        }
+        //-----------------------------------------------------------------------
+        /// A range of block rows of a PixelBox, counted across all its slices
+        struct BlockCompressionJob
+        {
+            PixelBox src;
+            uint8* dst;
+            PixelFormat format;
+            CompressionQuality quality;
+            size_t first;
+            size_t last;
+        };
+        //-----------------------------------------------------------------------
+        void compressBlockRows(const BlockCompressionJob& job)
+        {
+            const PixelBox& src = job.src;
+            const size_t width = src.getWidth(), height = src.getHeight();
+            const size_t blocksWide = (width + 3) / 4, blocksHigh = (height + 3) / 4;
+            const size_t blockBytes = getBlockBytes(job.format);
+            const size_t sliceBytes = PixelUtil::getMemorySize(width, height, 1, job.format);
+
+            // Four rows of the source as RGBA bytes
+            vector<uint8>::type rows(width * 4 * 4);
+            uint8 block[64];
+            for(size_t r = job.first; r < job.last; ++r)
+            {
+                const size_t z = r / blocksHigh, by = r % blocksHigh;
+                const size_t rowCount = std::min<size_t>(4, height - by * 4);
+                for(size_t y = 0; y < rowCount; ++y)
+                {
+                    // One row at a time keeps bulkPixelConversion from going wide itself
+                    PixelBox srcRow = src;
+                    srcRow.front = src.front + z;
+                    srcRow.back = srcRow.front + 1;
+                    srcRow.top = src.top + by * 4 + y;
+                    srcRow.bottom = srcRow.top + 1;
+                    PixelUtil::bulkPixelConversion(srcRow,
+                        PixelBox(width, 1, 1, PF_BYTE_RGBA, &rows[y * width * 4]));
+                }
+
+                uint8* out = job.dst + z * sliceBytes + by * blocksWide * blockBytes;
+                for(size_t bx = 0; bx < blocksWide; ++bx, out += blockBytes)
+                {
+                    // Partial blocks repeat the last column and row
+                    for(size_t y = 0; y < 4; ++y)
+                    {
+                        const uint8* row = &rows[std::min(y, rowCount - 1) * width * 4];
+                        for(size_t x = 0; x < 4; ++x)
+                            memcpy(block + (y * 4 + x) * 4, row + std::min(bx * 4 + x, width - 1) * 4, 4);
+                    }
+                    encodeBlock(block, job.format, job.quality, out);
+                }
+            }
+        }
+        //-----------------------------------------------------------------------
+        /// Compresses one band of block rows, see PixelUtil::compressPixels
+        struct BlockCompressionWorker
+        {
+            BlockCompressionJob job;
+
+            BlockCompressionWorker(const BlockCompressionJob& j) : job(j) {}
+
+            void run() { compressBlockRows(job); }
+        };
+    }
+    //-----------------------------------------------------------------------
+    bool PixelUtil::canCompressTo(PixelFormat format)
+    {
+        switch(format)
+        {
+        case PF_DXT1:
+        case PF_DXT2:
+        case PF_DXT3:
+        case PF_DXT4:
+        case PF_DXT5:
+        case PF_BC4_UNORM:
+        case PF_BC4_SNORM:
+        case PF_BC5_UNORM:
+        case PF_BC5_SNORM:
+        case PF_BC7_UNORM:
+        case PF_BC7_UNORM_SRGB:
+            return true;
+        default:
+            return false;
+        }
+    }
+    //-----------------------------------------------------------------------
+    void PixelUtil::compressPixels(const PixelBox &src, const PixelBox &dst, CompressionQuality quality)
+    {
+        assert(src.getWidth() == dst.getWidth() &&
+               src.getHeight() == dst.getHeight() &&
+               src.getDepth() == dst.getDepth());
+
+        if(!canCompressTo(dst.format))
+        {
+            OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED,
+                "There is no encoder for " + getFormatName(dst.format),
+                "PixelUtil::compressPixels");
+        }
+        if(isCompressed(src.format))
+        {
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+                "The source pixels are compressed already",
+                "PixelUtil::compressPixels");
+        }
+
+        BlockCompressionJob job;
+        job.src = src;
+        job.dst = static_cast<uint8*>(dst.data);
+        job.format = dst.format;
+        job.quality = quality;
+        job.first = 0;
+        job.last = ((src.getHeight() + 3) / 4) * src.getDepth();
+
+        const size_t blockRowTotal = job.last;
+        const size_t blockCount = ((src.getWidth() + 3) / 4) * blockRowTotal;
+        size_t threadCount = msBulkConversionThreads ? msBulkConversionThreads : ParallelFor::getHardwareThreadCount();
+        // Encoding costs far more per pixel than converting, so bands can be smaller
+        threadCount = std::min(threadCount, blockCount / 1024);
+        threadCount = std::min(threadCount, blockRowTotal);
+        if(threadCount > 1)
+        {
+            const size_t bandSize = (blockRowTotal + threadCount - 1) / threadCount;
+            vector<BlockCompressionWorker>::type workers;
+            for(size_t first = 0; first < blockRowTotal; first += bandSize)
+            {
+                job.first = first;
+                job.last = std::min(first + bandSize, blockRowTotal);
+                workers.push_back(BlockCompressionWorker(job));
+            }
+            ParallelFor::runWorkers(workers);
+            return;
+        }
+        compressBlockRows(job);
+    }
+}
@@ -619,8 +619,9 @@ namespace Ogre {
 
 	}
     //---------------------------------------------------------------------
-    Codec::DecodeResult DDSCodec::decode(DataStreamPtr& stream) const
-    {
+	void DDSCodec::decodeHeader(DataStreamPtr& stream, DDSHeader& header, ImageData& imgData,
+		size_t& numFaces, PixelFormat& sourceFormat, bool& decompressDXT) const
+	{
 		// Read 4 character code
 		uint32 fileType;
 		stream->read(&fileType, sizeof(uint32));
@@ -633,7 +634,6 @@ namespace Ogre {
 		}
 		
 		// Read header in full
-		DDSHeader header;
 		stream->read(&header, sizeof(DDSHeader));
 
 		// Endian flip if required, all 32-bit values
@@ -651,38 +651,35 @@ namespace Ogre {
 				"DDS header size mismatch!", "DDSCodec::decode");
 		}
 
-		ImageData* imgData = OGRE_NEW ImageData();
-		MemoryDataStreamPtr output;
-
-		imgData->depth = 1; // (deal with volume later)
-		imgData->width = header.width;
-		imgData->height = header.height;
-		size_t numFaces = 1; // assume one face until we know otherwise
+		imgData.depth = 1; // (deal with volume later)
+		imgData.width = header.width;
+		imgData.height = header.height;
+		numFaces = 1; // assume one face until we know otherwise
 
 		if (header.caps.caps1 & DDSCAPS_MIPMAP)
 		{
-	        imgData->num_mipmaps = static_cast<ushort>(header.mipMapCount - 1);
+	        imgData.num_mipmaps = static_cast<ushort>(header.mipMapCount - 1);
 		}
 		else
 		{
-			imgData->num_mipmaps = 0;
+			imgData.num_mipmaps = 0;
 		}
-		imgData->flags = 0;
+		imgData.flags = 0;
 
-		bool decompressDXT = false;
+		decompressDXT = false;
 		// Figure out basic image type
 		if (header.caps.caps2 & DDSCAPS2_CUBEMAP)
 		{
-			imgData->flags |= IF_CUBEMAP;
+			imgData.flags |= IF_CUBEMAP;
 			numFaces = 6;
 		}
 		else if (header.caps.caps2 & DDSCAPS2_VOLUME)
 		{
-			imgData->flags |= IF_3D_TEXTURE;
-			imgData->depth = header.depth;
+			imgData.flags |= IF_3D_TEXTURE;
+			imgData.depth = header.depth;
 		}
 		// Pixel format
-		PixelFormat sourceFormat = PF_UNKNOWN;
+		sourceFormat = PF_UNKNOWN;
 
 		if (header.pixelFormat.flags & DDPF_FOURCC)
 		{
@@ -737,11 +734,11 @@ namespace Ogre {
 					// colour_0 <= colour_1 means transparency in DXT1
 					if (block.colour_0 <= block.colour_1)
 					{
-						imgData->format = PF_BYTE_RGBA;
+						imgData.format = PF_BYTE_RGBA;
 					}
 					else
 					{
-						imgData->format = PF_BYTE_RGB;
+						imgData.format = PF_BYTE_RGB;
 					}
 					break;
 				case PF_DXT2:
@@ -749,7 +746,7 @@ namespace Ogre {
 				case PF_DXT4:
 				case PF_DXT5:
 					// full alpha present, formats vary only in encoding 
-					imgData->format = PF_BYTE_RGBA;
+					imgData.format = PF_BYTE_RGBA;
 					break;
                 default:
                     // all other cases need no special format handling
@@ -759,21 +756,34 @@ namespace Ogre {
 			else
 			{
 				// Use original format
-				imgData->format = sourceFormat;
+				imgData.format = sourceFormat;
 				// Keep DXT data compressed
-				imgData->flags |= IF_COMPRESSED;
+				imgData.flags |= IF_COMPRESSED;
 			}
 		}
 		else // not compressed
 		{
 			// Don't test against DDPF_RGB since greyscale DDS doesn't set this
 			// just derive any other kind of format
-			imgData->format = sourceFormat;
+			imgData.format = sourceFormat;
 		}
 
 		// Calculate total size from number of mipmaps, faces and size
-		imgData->size = Image::calculateSize(imgData->num_mipmaps, numFaces, 
-			imgData->width, imgData->height, imgData->depth, imgData->format);
+		imgData.size = Image::calculateSize(imgData.num_mipmaps, numFaces, 
+			imgData.width, imgData.height, imgData.depth, imgData.format);
+	}
+    //---------------------------------------------------------------------
+    Codec::DecodeResult DDSCodec::decode(DataStreamPtr& stream) const
+    {
+		DDSHeader header;
+		ImageData data;
+		size_t numFaces;
+		PixelFormat sourceFormat;
+		bool decompressDXT;
+		decodeHeader(stream, header, data, numFaces, sourceFormat, decompressDXT);
+
+		ImageData* imgData = OGRE_NEW ImageData(data);
+		MemoryDataStreamPtr output;
 
 		// Bind output buffer
 		output.bind(OGRE_NEW MemoryDataStream(imgData->size));
@@ -793,127 +803,90 @@ namespace Ogre {
 			{
 				size_t dstPitch = width * PixelUtil::getNumElemBytes(imgData->format);
 
-				if (PixelUtil::isCompressed(sourceFormat))
+				if (decompressDXT)
 				{
-					// Compressed data
-					if (decompressDXT)
+					DXTColourBlock col;
+					DXTInterpolatedAlphaBlock iAlpha;
+					DXTExplicitAlphaBlock eAlpha;
+					// 4x4 block of decompressed colour
+					ColourValue tempColours[16];
+					size_t destBpp = PixelUtil::getNumElemBytes(imgData->format);
+					size_t sx = std::min(width, (size_t)4);
+					size_t sy = std::min(height, (size_t)4);
+					size_t destPitchMinus4 = dstPitch - destBpp * sx;
+					// slices are done individually
+					for(size_t z = 0; z < depth; ++z)
 					{
-						DXTColourBlock col;
-						DXTInterpolatedAlphaBlock iAlpha;
-						DXTExplicitAlphaBlock eAlpha;
-						// 4x4 block of decompressed colour
-						ColourValue tempColours[16];
-						size_t destBpp = PixelUtil::getNumElemBytes(imgData->format);
-						size_t sx = std::min(width, (size_t)4);
-						size_t sy = std::min(height, (size_t)4);
-						size_t destPitchMinus4 = dstPitch - destBpp * sx;
-						// slices are done individually
-						for(size_t z = 0; z < depth; ++z)
+						// 4x4 blocks in x/y
+						for (size_t y = 0; y < height; y += 4)
 						{
-							// 4x4 blocks in x/y
-							for (size_t y = 0; y < height; y += 4)
+							for (size_t x = 0; x < width; x += 4)
 							{
-								for (size_t x = 0; x < width; x += 4)
+								if (sourceFormat == PF_DXT2 || 
+									sourceFormat == PF_DXT3)
 								{
-									if (sourceFormat == PF_DXT2 || 
-										sourceFormat == PF_DXT3)
-									{
-										// explicit alpha
-										stream->read(&eAlpha, sizeof(DXTExplicitAlphaBlock));
-										flipEndian(eAlpha.alphaRow, sizeof(uint16), 4);
-										unpackDXTAlpha(eAlpha, tempColours) ;
-									}
-									else if (sourceFormat == PF_DXT4 || 
-										sourceFormat == PF_DXT5)
-									{
-										// interpolated alpha
-										stream->read(&iAlpha, sizeof(DXTInterpolatedAlphaBlock));
-										flipEndian(&(iAlpha.alpha_0), sizeof(uint16), 1);
-										flipEndian(&(iAlpha.alpha_1), sizeof(uint16), 1);
-										unpackDXTAlpha(iAlpha, tempColours) ;
-									}
-									// always read colour
-									stream->read(&col, sizeof(DXTColourBlock));
-									flipEndian(&(col.colour_0), sizeof(uint16), 1);
-									flipEndian(&(col.colour_1), sizeof(uint16), 1);
-									unpackDXTColour(sourceFormat, col, tempColours);
-
-									// write 4x4 block to uncompressed version
-									for (size_t by = 0; by < sy; ++by)
-									{
-										for (size_t bx = 0; bx < sx; ++bx)
-										{
-											PixelUtil::packColour(tempColours[by*4+bx],
-												imgData->format, destPtr);
-											destPtr = static_cast<void*>(
-												static_cast<uchar*>(destPtr) + destBpp);
-										}
-										// advance to next row
-										destPtr = static_cast<void*>(
-											static_cast<uchar*>(destPtr) + destPitchMinus4);
-									}
-									// next block. Our dest pointer is 4 lines down
-									// from where it started
-									if (x + 4 >= width)
-									{
-										// Jump back to the start of the line
-										destPtr = static_cast<void*>(
-											static_cast<uchar*>(destPtr) - destPitchMinus4);
-									}
-									else
+									// explicit alpha
+									stream->read(&eAlpha, sizeof(DXTExplicitAlphaBlock));
+									flipEndian(eAlpha.alphaRow, sizeof(uint16), 4);
+									unpackDXTAlpha(eAlpha, tempColours) ;
+								}
+								else if (sourceFormat == PF_DXT4 || 
+									sourceFormat == PF_DXT5)
+								{
+									// interpolated alpha
+									stream->read(&iAlpha, sizeof(DXTInterpolatedAlphaBlock));
+									flipEndian(&(iAlpha.alpha_0), sizeof(uint16), 1);
+									flipEndian(&(iAlpha.alpha_1), sizeof(uint16), 1);
+									unpackDXTAlpha(iAlpha, tempColours) ;
+								}
+								// always read colour
+								stream->read(&col, sizeof(DXTColourBlock));
+								flipEndian(&(col.colour_0), sizeof(uint16), 1);
+								flipEndian(&(col.colour_1), sizeof(uint16), 1);
+								unpackDXTColour(sourceFormat, col, tempColours);
+
+								// write 4x4 block to uncompressed version
+								for (size_t by = 0; by < sy; ++by)
+								{
+									for (size_t bx = 0; bx < sx; ++bx)
 									{
-										// Jump back up 4 rows and 4 pixels to the
-										// right to be at the next block to the right
+										PixelUtil::packColour(tempColours[by*4+bx],
+											imgData->format, destPtr);
 										destPtr = static_cast<void*>(
-											static_cast<uchar*>(destPtr) - dstPitch * sy + destBpp * sx);
-
+											static_cast<uchar*>(destPtr) + destBpp);
 									}
+									// advance to next row
+									destPtr = static_cast<void*>(
+										static_cast<uchar*>(destPtr) + destPitchMinus4);
+								}
+								// next block. Our dest pointer is 4 lines down
+								// from where it started
+								if (x + 4 >= width)
+								{
+									// Jump back to the start of the line
+									destPtr = static_cast<void*>(
+										static_cast<uchar*>(destPtr) - destPitchMinus4);
+								}
+								else
+								{
+									// Jump back up 4 rows and 4 pixels to the
+									// right to be at the next block to the right
+									destPtr = static_cast<void*>(
+										static_cast<uchar*>(destPtr) - dstPitch * sy + destBpp * sx);
 
 								}
 
 							}
-						}
 
-					}
-					else
-					{
-						// load directly
-						// DDS format lies! sizeOrPitch is not always set for DXT!!
-						size_t dxtSize = PixelUtil::getMemorySize(width, height, depth, imgData->format);
-						stream->read(destPtr, dxtSize);
-						destPtr = static_cast<void*>(static_cast<uchar*>(destPtr) + dxtSize);
+						}
 					}
 
 				}
 				else
 				{
-					// Final data - trim incoming pitch
-					size_t srcPitch;
-					if (header.flags & DDSD_PITCH)
-					{
-						srcPitch = header.sizeOrPitch / 
-							std::max((size_t)1, mip * 2);
-					}
-					else
-					{
-						// assume same as final pitch
-						srcPitch = dstPitch;
-					}
-					assert (dstPitch <= srcPitch);
-					long srcAdvance = static_cast<long>(srcPitch) - static_cast<long>(dstPitch);
-
-					for (size_t z = 0; z < imgData->depth; ++z)
-					{
-						for (size_t y = 0; y < imgData->height; ++y)
-						{
-							stream->read(destPtr, dstPitch);
-							if (srcAdvance > 0)
-								stream->skip(srcAdvance);
-
-							destPtr = static_cast<void*>(static_cast<uchar*>(destPtr) + dstPitch);
-						}
-					}
-
+					PixelBox level(width, height, depth, imgData->format, destPtr);
+					readLevel(stream, header, mip, level);
+					destPtr = static_cast<void*>(static_cast<uchar*>(destPtr) + level.getConsecutiveSize());
 				}
 
 				
@@ -933,6 +906,121 @@ namespace Ogre {
 
 
     }
+    //---------------------------------------------------------------------
+	void DDSCodec::readLevel(DataStreamPtr& stream, const DDSHeader& header, size_t mip, 
+		const PixelBox& dest) const
+	{
+		if (PixelUtil::isCompressed(dest.format))
+		{
+			// DDS format lies! sizeOrPitch is not always set for DXT!!
+			if (!dest.isConsecutive())
+			{
+				OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, 
+					"Compressed data can only be read into consecutive memory", "DDSCodec::readLevel");
+			}
+			stream->read(dest.data, dest.getConsecutiveSize());
+			return;
+		}
+
+		// Final data - trim incoming pitch
+		size_t bpp = PixelUtil::getNumElemBytes(dest.format);
+		size_t dstPitch = dest.getWidth() * bpp;
+		size_t srcPitch;
+		if (header.flags & DDSD_PITCH)
+		{
+			srcPitch = header.sizeOrPitch / 
+				std::max((size_t)1, mip * 2);
+		}
+		else
+		{
+			// assume same as final pitch
+			srcPitch = dstPitch;
+		}
+		assert (dstPitch <= srcPitch);
+		long srcAdvance = static_cast<long>(srcPitch) - static_cast<long>(dstPitch);
+
+		uchar* slice = static_cast<uchar*>(dest.data) + 
+			(dest.front * dest.slicePitch + dest.top * dest.rowPitch + dest.left) * bpp;
+		for (size_t z = 0; z < dest.getDepth(); ++z)
+		{
+			uchar* row = slice;
+			for (size_t y = 0; y < dest.getHeight(); ++y)
+			{
+				stream->read(row, dstPitch);
+				if (srcAdvance > 0)
+					stream->skip(srcAdvance);
+				row += dest.rowPitch * bpp;
+			}
+			slice += dest.slicePitch * bpp;
+		}
+	}
+    //---------------------------------------------------------------------
+	size_t DDSCodec::getLevelSize(const DDSHeader& header, size_t mip, size_t width, size_t height,
+		size_t depth, PixelFormat format) const
+	{
+		if (PixelUtil::isCompressed(format))
+			return PixelUtil::getMemorySize(width, height, depth, format);
+
+		// Rows are padded to the pitch of the file, as readLevel reads them
+		size_t srcPitch = width * PixelUtil::getNumElemBytes(format);
+		if (header.flags & DDSD_PITCH)
+			srcPitch = std::max(srcPitch, header.sizeOrPitch / std::max((size_t)1, mip * 2));
+		return srcPitch * height * depth;
+	}
+    //---------------------------------------------------------------------
+	bool DDSCodec::decodeTo(DataStreamPtr& stream, DecodeTarget& target) const
+	{
+		size_t start = stream->tell();
+
+		DDSHeader header;
+		ImageData data;
+		size_t numFaces;
+		PixelFormat sourceFormat;
+		bool decompressDXT;
+		decodeHeader(stream, header, data, numFaces, sourceFormat, decompressDXT);
+
+		// Decompressing goes through every texel anyway, leave it to decode
+		if (decompressDXT || !target.begin(data, numFaces))
+		{
+			stream->seek(start);
+			return false;
+		}
+
+		// all mips for a face, then each face
+		for (size_t face = 0; face < numFaces; ++face)
+		{
+			size_t width = data.width;
+			size_t height = data.height;
+			size_t depth = data.depth;
+
+			for (size_t mip = 0; mip <= data.num_mipmaps; ++mip)
+			{
+				if (target.skip(face, mip))
+				{
+					stream->skip(static_cast<long>(getLevelSize(header, mip, width, height, depth, data.format)));
+				}
+				else
+				{
+					PixelBox level = target.lock(face, mip);
+					if (level.format != data.format || level.getWidth() != width ||
+						level.getHeight() != height || level.getDepth() != depth)
+					{
+						target.unlock(face, mip);
+						OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, 
+							"Decode target doesn't match the image", "DDSCodec::decodeTo");
+					}
+					readLevel(stream, header, mip, level);
+					target.unlock(face, mip);
+				}
+
+				/// Next mip
+				if(width!=1) width /= 2;
+				if(height!=1) height /= 2;
+				if(depth!=1) depth /= 2;
+			}
+		}
+		return true;
+	}
     //---------------------------------------------------------------------    
     String DDSCodec::getType() const 
     {
@@ -30,6 +30,22 @@ THE SOFTWARE.
 #include "OgreLogManager.h"
 #include "OgreException.h"
 
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+#  define WIN32_LEAN_AND_MEAN
+#  if !defined(NOMINMAX) && defined(_MSC_VER)
+#	define NOMINMAX // required to stop windows.h messing up std::min
+#  endif
+#  include <windows.h>
+#elif OGRE_PLATFORM == OGRE_PLATFORM_LINUX || OGRE_PLATFORM == OGRE_PLATFORM_APPLE || \
+    OGRE_PLATFORM == OGRE_PLATFORM_APPLE_IOS || OGRE_PLATFORM == OGRE_PLATFORM_ANDROID
+#  include <sys/types.h>
+#  include <sys/stat.h>
+#  include <sys/mman.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#  define OGRE_POSIX_MMAP 1
+#endif
+
 namespace Ogre {
 
     //-----------------------------------------------------------------------
@@ -442,6 +458,13 @@ namespace Ogre {
         mPos = mData + newpos;
     }
     //-----------------------------------------------------------------------
+    const void* MemoryDataStream::peek(size_t count)
+    {
+        if (count > (size_t)(mEnd - mPos))
+            return 0;
+        return mPos;
+    }
+    //-----------------------------------------------------------------------
     void MemoryDataStream::seek( size_t pos )
     {
         assert( mData + pos <= mEnd );
@@ -762,5 +785,206 @@ namespace Ogre {
 		}
     }
     //-----------------------------------------------------------------------
+    //-----------------------------------------------------------------------
+    MmapDataStream::MmapDataStream(const String& name, const String& path)
+        : DataStream(name, READ), mData(0), mPos(0), mEnd(0), mFileHandle(0), mMappingHandle(0)
+    {
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, 0,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, 0);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            OGRE_EXCEPT(Exception::ERR_FILE_NOT_FOUND,
+                "Cannot open file: " + path, "MmapDataStream::MmapDataStream");
+        }
+        mFileHandle = file;
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize))
+        {
+            close();
+            OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
+                "Cannot get the size of file: " + path, "MmapDataStream::MmapDataStream");
+        }
+        mSize = static_cast<size_t>(fileSize.QuadPart);
+
+        // Empty files can't be mapped, there is nothing to map anyway
+        if (mSize)
+        {
+            mMappingHandle = CreateFileMappingA(file, 0, PAGE_READONLY, 0, 0, 0);
+            if (mMappingHandle)
+                mData = static_cast<uchar*>(MapViewOfFile(mMappingHandle, FILE_MAP_READ, 0, 0, 0));
+            if (!mData)
+            {
+                close();
+                OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
+                    "Cannot map file: " + path, "MmapDataStream::MmapDataStream");
+            }
+        }
+#elif OGRE_POSIX_MMAP
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            OGRE_EXCEPT(Exception::ERR_FILE_NOT_FOUND,
+                "Cannot open file: " + path, "MmapDataStream::MmapDataStream");
+        }
+
+        struct stat fileStat;
+        if (fstat(fd, &fileStat) != 0)
+        {
+            ::close(fd);
+            OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
+                "Cannot get the size of file: " + path, "MmapDataStream::MmapDataStream");
+        }
+        mSize = static_cast<size_t>(fileStat.st_size);
+
+        // Empty files can't be mapped, there is nothing to map anyway
+        if (mSize)
+        {
+            void* data = mmap(0, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED)
+            {
+                ::close(fd);
+                OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
+                    "Cannot map file: " + path, "MmapDataStream::MmapDataStream");
+            }
+            mData = static_cast<uchar*>(data);
+        }
+        // The mapping keeps the file alive
+        ::close(fd);
+#else
+        OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED,
+            "Memory mapped files are not supported on this platform",
+            "MmapDataStream::MmapDataStream");
+#endif
+        mPos = mData;
+        mEnd = mData + mSize;
+    }
+    //-----------------------------------------------------------------------
+    MmapDataStream::~MmapDataStream()
+    {
+        close();
+    }
+    //-----------------------------------------------------------------------
+    size_t MmapDataStream::read(void* buf, size_t count)
+    {
+        size_t cnt = count;
+        // Read over end of memory?
+        if (mPos + cnt > mEnd)
+            cnt = mEnd - mPos;
+        if (cnt == 0)
+            return 0;
+
+        assert (cnt<=count);
+
+        memcpy(buf, mPos, cnt);
+        mPos += cnt;
+        return cnt;
+    }
+    //-----------------------------------------------------------------------
+    size_t MmapDataStream::readLine(char* buf, size_t maxCount, 
+        const String& delim)
+    {
+        // Deal with both Unix & Windows LFs
+		bool trimCR = false;
+		if (delim.find_first_of('\n') != String::npos)
+		{
+			trimCR = true;
+		}
+
+        size_t pos = 0;
+
+        // Make sure pos can never go past the end of the data 
+        while (pos < maxCount && mPos < mEnd)
+        {
+            if (delim.find(*mPos) != String::npos)
+            {
+                // Trim off trailing CR if this was a CR/LF entry
+                if (trimCR && pos && buf[pos-1] == '\r')
+                {
+                    // terminate 1 character early
+                    --pos;
+                }
+
+                // Found terminator, skip and break out
+                ++mPos;
+                break;
+            }
+
+            buf[pos++] = *mPos++;
+        }
+
+        // terminate
+        buf[pos] = '\0';
+
+        return pos;
+    }
+    //-----------------------------------------------------------------------
+    size_t MmapDataStream::skipLine(const String& delim)
+    {
+        size_t pos = 0;
+
+        // Make sure pos can never go past the end of the data 
+        while (mPos < mEnd)
+        {
+            ++pos;
+            if (delim.find(*mPos++) != String::npos)
+            {
+                // Found terminator, break out
+                break;
+            }
+        }
+
+        return pos;
+    }
+    //-----------------------------------------------------------------------
+    void MmapDataStream::skip(long count)
+    {
+        size_t newpos = (size_t)( ( mPos - mData ) + count );
+        assert( mData + newpos <= mEnd );        
+
+        mPos = mData + newpos;
+    }
+    //-----------------------------------------------------------------------
+    const void* MmapDataStream::peek(size_t count)
+    {
+        if (count > (size_t)(mEnd - mPos))
+            return 0;
+        return mPos;
+    }
+    //-----------------------------------------------------------------------
+    void MmapDataStream::seek( size_t pos )
+    {
+        assert( mData + pos <= mEnd );
+        mPos = mData + pos;
+    }
+    //-----------------------------------------------------------------------
+    size_t MmapDataStream::tell(void) const
+	{
+		return mPos - mData;
+	}
+    //-----------------------------------------------------------------------
+    bool MmapDataStream::eof(void) const
+    {
+        return mPos >= mEnd;
+    }
+    //-----------------------------------------------------------------------
+    void MmapDataStream::close(void)
+    {
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+        if (mData)
+            UnmapViewOfFile(mData);
+        if (mMappingHandle)
+            CloseHandle(mMappingHandle);
+        if (mFileHandle)
+            CloseHandle(mFileHandle);
+#elif OGRE_POSIX_MMAP
+        if (mData)
+            munmap(mData, mSize);
+#endif
+        mData = mPos = mEnd = 0;
+        mFileHandle = mMappingHandle = 0;
+    }
+    //-----------------------------------------------------------------------
 
 }
@@ -32,9 +32,25 @@ THE SOFTWARE.
 #include "OgreVertexIndexData.h"
 #include "OgreException.h"
 #include "OgreOptimisedUtil.h"
+#include "OgreCommon.h"
+#include "OgreParallelFor.h"
 
 namespace Ogre {
 
+	namespace
+	{
+		/// Hashes a position for common vertex lookup, -0 and +0 compare equal so they hash equal
+		size_t hashPosition(const Vector3& vec)
+		{
+			Real key[3] = {
+				vec.x == 0 ? Real(0) : vec.x,
+				vec.y == 0 ? Real(0) : vec.y,
+				vec.z == 0 ? Real(0) : vec.z };
+			return FastHash(reinterpret_cast<const char*>(key), sizeof(key));
+		}
+	}
+
+
 	EdgeData::EdgeData() : isClosed(false){}
 	
     void EdgeData::log(Log* l)
@@ -118,6 +134,40 @@ namespace Ogre {
         mGeometryList.push_back(geometry);
     }
     //---------------------------------------------------------------------
+    // Computes the face normals and half edges of a range of triangles.
+    // Each triangle only writes its own normal and half edges.
+    struct EdgeListBuilder::FaceWorker
+    {
+        EdgeListBuilder* builder;
+        size_t begin;
+        size_t end;
+
+        FaceWorker(EdgeListBuilder* b, size_t first, size_t last)
+            : builder(b), begin(first), end(last) {}
+
+        void run() { builder->buildFaces(begin, end); }
+    };
+    //---------------------------------------------------------------------
+    // Matches the half edges of one bucket, which holds every half edge of the
+    // edges it touches. Only the partners of those half edges are written.
+    struct EdgeListBuilder::EdgeMatchWorker
+    {
+        EdgeListBuilder* builder;
+        HalfEdgeList::iterator begin;
+        HalfEdgeList::iterator end;
+
+        EdgeMatchWorker(EdgeListBuilder* b, HalfEdgeList::iterator first, HalfEdgeList::iterator last)
+            : builder(b), begin(first), end(last) {}
+
+        void run()
+        {
+            std::sort(begin, end, halfEdgeLess());
+            builder->matchEdges(begin, end);
+        }
+    };
+    //---------------------------------------------------------------------
+    const size_t EdgeListBuilder::EDGE_CONNECTED = static_cast<size_t>(~0) - 1;
+    //---------------------------------------------------------------------
     EdgeData* EdgeListBuilder::build(void)
     {
         /* Ok, here's the algorithm:
@@ -172,6 +222,15 @@ namespace Ogre {
         the mesh, not the valid hull for the mesh.
         */
 
+        /*
+        The edges are not connected while the triangles are read. Instead every
+        triangle side becomes a half edge keyed on its 2 common vertices, the
+        half edges are sorted by key, and each run of equal keys is paired up
+        in triangle order. This gives the same edges as connecting them one by
+        one above, but sorting flat arrays is much cheaper than a tree lookup
+        per side, and separate runs can be matched on separate threads.
+        */
+
         // Sort the geometries in the order of vertex set, so we can grouping
         // triangles by vertex set easy.
         std::sort(mGeometryList.begin(), mGeometryList.end(), geometryLess());
@@ -180,32 +239,101 @@ namespace Ogre {
         // resize the edge group list to equal the number of vertex sets
         mEdgeData->edgeGroups.resize(mVertexDataList.size());
         // Initialise edge group data
+        size_t totalVertexCount = 0;
+        mCommonVertexLookup.resize(mVertexDataList.size());
         for (unsigned short vSet = 0; vSet < mVertexDataList.size(); ++vSet)
         {
             mEdgeData->edgeGroups[vSet].vertexSet = vSet;
             mEdgeData->edgeGroups[vSet].vertexData = mVertexDataList[vSet];
             mEdgeData->edgeGroups[vSet].triStart = 0;
             mEdgeData->edgeGroups[vSet].triCount = 0;
+
+            size_t vertexCount = mVertexDataList[vSet]->vertexCount;
+            mCommonVertexLookup[vSet].assign(vertexCount, static_cast<size_t>(~0));
+            totalVertexCount += vertexCount;
         }
 
-        // Build triangles and edge list
+        // Keep the hash table at most half full even if no vertices get welded
+        size_t hashSize = 16;
+        while (hashSize < totalVertexCount * 2)
+            hashSize <<= 1;
+        mCommonVertexHash.assign(hashSize, static_cast<size_t>(~0));
+        mVertices.reserve(totalVertexCount);
+
+        // Build triangles and common vertices
         GeometryList::const_iterator i, iend;
         iend = mGeometryList.end();
         for (i = mGeometryList.begin(); i != iend; ++i)
         {
-            buildTrianglesEdges(*i);
+            buildTriangles(*i);
         }
+        // Welding is done, release the lookup tables
+        vector<size_t>::type().swap(mCommonVertexHash);
+        mCommonVertexLookup.clear();
+
+        size_t triangleCount = mEdgeData->triangles.size();
+        mEdgeData->triangleFaceNormals.resize(triangleCount);
+        mHalfEdges.resize(triangleCount * 3);
+        mEdgePartners.resize(triangleCount * 3);
+
+        // Below some thousands of triangles per thread, spawning them costs more than it saves.
+        size_t threadCount = std::max<size_t>(1,
+            std::min(ParallelFor::getHardwareThreadCount(), triangleCount / 16384));
+
+        // Face normals and half edges, on contiguous triangle ranges
+        size_t rangeSize = (triangleCount + threadCount - 1) / threadCount;
+        vector<FaceWorker>::type faceWorkers;
+        faceWorkers.reserve(threadCount);
+        for (size_t t = 0; t < threadCount; ++t)
+        {
+            size_t first = std::min(t * rangeSize, triangleCount);
+            faceWorkers.push_back(FaceWorker(this, first, std::min(first + rangeSize, triangleCount)));
+        }
+        ParallelFor::runWorkers(faceWorkers);
+
+        // Both sides of an edge share their lowest common vertex, so distributing
+        // the half edges on it gives buckets which can be matched independently.
+        vector<size_t>::type bucketStart(threadCount + 1, 0);
+        if (threadCount > 1)
+        {
+            HalfEdgeList::const_iterator h, hend = mHalfEdges.end();
+            for (h = mHalfEdges.begin(); h != hend; ++h)
+                ++bucketStart[h->sharedVertIndex[0] % threadCount + 1];
+            for (size_t b = 0; b < threadCount; ++b)
+                bucketStart[b + 1] += bucketStart[b];
+
+            HalfEdgeList bucketed(mHalfEdges.size());
+            vector<size_t>::type bucketPos(bucketStart.begin(), bucketStart.end() - 1);
+            for (h = mHalfEdges.begin(); h != hend; ++h)
+                bucketed[bucketPos[h->sharedVertIndex[0] % threadCount]++] = *h;
+            mHalfEdges.swap(bucketed);
+        }
+        else
+        {
+            bucketStart[1] = mHalfEdges.size();
+        }
+
+        vector<EdgeMatchWorker>::type matchWorkers;
+        matchWorkers.reserve(threadCount);
+        for (size_t b = 0; b < threadCount; ++b)
+        {
+            matchWorkers.push_back(EdgeMatchWorker(this,
+                mHalfEdges.begin() + bucketStart[b], mHalfEdges.begin() + bucketStart[b + 1]));
+        }
+        ParallelFor::runWorkers(matchWorkers);
+
+        // Create the edges, this also records whether the mesh is closed
+        emitEdges();
+        HalfEdgeList().swap(mHalfEdges);
+        vector<size_t>::type().swap(mEdgePartners);
 
         // Allocate memory for light facing calculate
         mEdgeData->triangleLightFacings.resize(mEdgeData->triangles.size());
 
-        // Record closed, ie the mesh is manifold
-        mEdgeData->isClosed = mEdgeMap.empty();
-
         return mEdgeData;
     }
     //---------------------------------------------------------------------
-    void EdgeListBuilder::buildTrianglesEdges(const Geometry &geometry)
+    void EdgeListBuilder::buildTriangles(const Geometry &geometry)
     {
         size_t indexSet = geometry.indexSet;
         size_t vertexSet = geometry.vertexSet;
@@ -213,7 +341,7 @@ namespace Ogre {
         RenderOperation::OperationType opType = geometry.opType;
 
         size_t iterations;
-        
+
         switch (opType)
         {
         case RenderOperation::OT_TRIANGLE_LIST:
@@ -229,11 +357,19 @@ namespace Ogre {
 
         // The edge group now we are dealing with.
         EdgeData::EdgeGroup& eg = mEdgeData->edgeGroups[vertexSet];
+        // Common vertices already found for this vertex set
+        vector<size_t>::type& commonLookup = mCommonVertexLookup[vertexSet];
 
 		// locate position element & the buffer to go with it
         const VertexData* vertexData = mVertexDataList[vertexSet];
 		const VertexElement* posElem = vertexData->vertexDeclaration->findElementBySemantic(VES_POSITION);
-		HardwareVertexBufferSharedPtr vbuf = 
+		if (!VertexData::canReadPosition(posElem->getType()))
+		{
+			OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+				"Unsupported position format, cannot build edge list.",
+				"EdgeListBuilder::buildTriangles");
+		}
+		HardwareVertexBufferSharedPtr vbuf =
 			vertexData->vertexBufferBinding->getBuffer(posElem->getSource());
 		// lock the buffer for reading
 		unsigned char* pBaseVertex = static_cast<unsigned char*>(
@@ -273,7 +409,6 @@ namespace Ogre {
         }
         // Pre-reserve memory for less thrashing
         mEdgeData->triangles.reserve(triangleIndex + iterations);
-        mEdgeData->triangleFaceNormals.reserve(triangleIndex + iterations);
         for (size_t t = 0; t < iterations; ++t)
         {
             EdgeData::Triangle tri;
@@ -314,22 +449,25 @@ namespace Ogre {
                     index[2] = *p16Idx++;
             }
 
-            Vector3 v[3];
             for (size_t i = 0; i < 3; ++i)
             {
                 // Populate tri original vertex index
                 tri.vertIndex[i] = index[i];
 
-                // Retrieve the vertex position
-                unsigned char* pVertex = pBaseVertex + (index[i] * vbuf->getVertexSize());
-                float* pFloat;
-                posElem->baseVertexPointerToElement(pVertex, &pFloat);
-                v[i].x = *pFloat++;
-                v[i].y = *pFloat++;
-                v[i].z = *pFloat++;
-                // find this vertex in the existing vertex map, or create it
-                tri.sharedVertIndex[i] = 
-                    findOrCreateCommonVertex(v[i], vertexSet, indexSet, index[i]);
+                // Vertices referenced before already know their common vertex
+                bool cacheable = index[i] < commonLookup.size();
+                size_t sharedIndex = cacheable ? commonLookup[index[i]] : static_cast<size_t>(~0);
+                if (sharedIndex == static_cast<size_t>(~0))
+                {
+                    // Retrieve the vertex position
+                    unsigned char* pVertex = pBaseVertex + (index[i] * vbuf->getVertexSize());
+                    Vector3 v = vertexData->readPosition(posElem, pVertex);
+                    // find this vertex in the existing vertex map, or create it
+                    sharedIndex = findOrCreateCommonVertex(v, vertexSet, indexSet, index[i]);
+                    if (cacheable)
+                        commonLookup[index[i]] = sharedIndex;
+                }
+                tri.sharedVertIndex[i] = sharedIndex;
             }
 
             // Ignore degenerate triangle
@@ -337,22 +475,9 @@ namespace Ogre {
                 tri.sharedVertIndex[1] != tri.sharedVertIndex[2] &&
                 tri.sharedVertIndex[2] != tri.sharedVertIndex[0])
             {
-                // Calculate triangle normal (NB will require recalculation for 
-                // skeletally animated meshes)
-                mEdgeData->triangleFaceNormals.push_back(
-                    Math::calculateFaceNormalWithoutNormalize(v[0], v[1], v[2]));
-                // Add triangle to list
+                // Add triangle to list, normals and edges are built later for all
+                // triangles at once
                 mEdgeData->triangles.push_back(tri);
-                // Connect or create edges from common list
-                connectOrCreateEdge(vertexSet, triangleIndex, 
-                    tri.vertIndex[0], tri.vertIndex[1], 
-                    tri.sharedVertIndex[0], tri.sharedVertIndex[1]);
-                connectOrCreateEdge(vertexSet, triangleIndex, 
-                    tri.vertIndex[1], tri.vertIndex[2], 
-                    tri.sharedVertIndex[1], tri.sharedVertIndex[2]);
-                connectOrCreateEdge(vertexSet, triangleIndex, 
-                    tri.vertIndex[2], tri.vertIndex[0], 
-                    tri.sharedVertIndex[2], tri.sharedVertIndex[0]);
                 ++triangleIndex;
             }
         }
@@ -365,56 +490,126 @@ namespace Ogre {
         vbuf->unlock();
     }
     //---------------------------------------------------------------------
-    void EdgeListBuilder::connectOrCreateEdge(size_t vertexSet, size_t triangleIndex, 
-        size_t vertIndex0, size_t vertIndex1, size_t sharedVertIndex0, 
-        size_t sharedVertIndex1)
+    void EdgeListBuilder::buildFaces(size_t begin, size_t end)
     {
-        // Find the existing edge (should be reversed order) on shared vertices
-        EdgeMap::iterator emi = mEdgeMap.find(std::pair<size_t, size_t>(sharedVertIndex1, sharedVertIndex0));
-        if (emi != mEdgeMap.end())
+        for (size_t t = begin; t < end; ++t)
         {
-            // The edge already exist, connect it
-            EdgeData::Edge& e = mEdgeData->edgeGroups[emi->second.first].edges[emi->second.second];
-            // update with second side
-            e.triIndex[1] = triangleIndex;
-            e.degenerate = false;
-
-            // Remove from the edge map, so we never supplied to connect edge again
-            mEdgeMap.erase(emi);
+            const EdgeData::Triangle& tri = mEdgeData->triangles[t];
+
+            // Calculate triangle normal (NB will require recalculation for
+            // skeletally animated meshes). Welded vertices have the exact same
+            // position, so the common vertex will do.
+            mEdgeData->triangleFaceNormals[t] = Math::calculateFaceNormalWithoutNormalize(
+                mVertices[tri.sharedVertIndex[0]].position,
+                mVertices[tri.sharedVertIndex[1]].position,
+                mVertices[tri.sharedVertIndex[2]].position);
+
+            for (size_t side = 0; side < 3; ++side)
+            {
+                size_t v0 = tri.sharedVertIndex[side];
+                size_t v1 = tri.sharedVertIndex[(side + 1) % 3];
+                HalfEdge& h = mHalfEdges[t * 3 + side];
+                h.reversed = v0 > v1;
+                h.sharedVertIndex[0] = h.reversed ? v1 : v0;
+                h.sharedVertIndex[1] = h.reversed ? v0 : v1;
+                h.seq = t * 3 + side;
+            }
         }
-        else
+    }
+    //---------------------------------------------------------------------
+    void EdgeListBuilder::matchEdges(HalfEdgeList::iterator begin, HalfEdgeList::iterator end)
+    {
+        // Half edges which created an edge that is still waiting for its second
+        // triangle, per winding. These are queues, so like before an edge always
+        // connects to the earliest open edge running the other way.
+        vector<size_t>::type open[2];
+        size_t openHead[2];
+
+        HalfEdgeList::iterator runStart = begin;
+        while (runStart != end)
         {
-            // Not found, create new edge
-            mEdgeMap.insert(EdgeMap::value_type(
-                std::pair<size_t, size_t>(sharedVertIndex0, sharedVertIndex1),
-                std::pair<size_t, size_t>(vertexSet, mEdgeData->edgeGroups[vertexSet].edges.size())));
+            HalfEdgeList::iterator runEnd = runStart + 1;
+            while (runEnd != end &&
+                runEnd->sharedVertIndex[0] == runStart->sharedVertIndex[0] &&
+                runEnd->sharedVertIndex[1] == runStart->sharedVertIndex[1])
+            {
+                ++runEnd;
+            }
+
+            open[0].clear();
+            open[1].clear();
+            openHead[0] = openHead[1] = 0;
+            for (HalfEdgeList::iterator h = runStart; h != runEnd; ++h)
+            {
+                size_t other = h->reversed ? 0 : 1;
+                if (openHead[other] < open[other].size())
+                {
+                    // The edge already exist, connect it
+                    size_t creator = open[other][openHead[other]++];
+                    mEdgePartners[creator] = h->seq / 3;
+                    mEdgePartners[h->seq] = EDGE_CONNECTED;
+                }
+                else
+                {
+                    // Not found, this half edge will create a new edge
+                    open[1 - other].push_back(h->seq);
+                    mEdgePartners[h->seq] = static_cast<size_t>(~0);
+                }
+            }
+            runStart = runEnd;
+        }
+    }
+    //---------------------------------------------------------------------
+    void EdgeListBuilder::emitEdges(void)
+    {
+        bool closed = true;
+        size_t halfEdgeCount = mEdgePartners.size();
+        for (size_t seq = 0; seq < halfEdgeCount; ++seq)
+        {
+            size_t partner = mEdgePartners[seq];
+            if (partner == EDGE_CONNECTED)
+                continue;
+
+            const EdgeData::Triangle& tri = mEdgeData->triangles[seq / 3];
+            size_t v0 = seq % 3;
+            size_t v1 = (v0 + 1) % 3;
+
             EdgeData::Edge e;
-            e.degenerate = true; // initialise as degenerate
-
-            // Set only first tri, the other will be completed in connect existing edge
-            e.triIndex[0] = triangleIndex;
-            e.triIndex[1] = static_cast<size_t>(~0);
-            e.sharedVertIndex[0] = sharedVertIndex0;
-            e.sharedVertIndex[1] = sharedVertIndex1;
-            e.vertIndex[0] = vertIndex0;
-            e.vertIndex[1] = vertIndex1;
-            mEdgeData->edgeGroups[vertexSet].edges.push_back(e);
+            e.triIndex[0] = seq / 3;
+            e.triIndex[1] = partner;
+            e.degenerate = partner == static_cast<size_t>(~0);
+            e.sharedVertIndex[0] = tri.sharedVertIndex[v0];
+            e.sharedVertIndex[1] = tri.sharedVertIndex[v1];
+            e.vertIndex[0] = tri.vertIndex[v0];
+            e.vertIndex[1] = tri.vertIndex[v1];
+            mEdgeData->edgeGroups[tri.vertexSet].edges.push_back(e);
+
+            closed = closed && !e.degenerate;
         }
+
+        // Record closed, ie the mesh is manifold
+        mEdgeData->isClosed = closed;
     }
     //---------------------------------------------------------------------
-    size_t EdgeListBuilder::findOrCreateCommonVertex(const Vector3& vec, 
+    size_t EdgeListBuilder::findOrCreateCommonVertex(const Vector3& vec,
         size_t vertexSet, size_t indexSet, size_t originalIndex)
     {
         // Because the algorithm doesn't care about manifold or not, we just identifying
         // the common vertex by EXACT same position.
         // Hint: We can use quantize method for welding almost same position vertex fastest.
-        std::pair<CommonVertexMap::iterator, bool> inserted =
-            mCommonVertexMap.insert(CommonVertexMap::value_type(vec, mVertices.size()));
-        if (!inserted.second)
+        size_t mask = mCommonVertexHash.size() - 1;
+        size_t slot = hashPosition(vec) & mask;
+        while (mCommonVertexHash[slot] != static_cast<size_t>(~0))
         {
-            // Already existing, return old one
-            return inserted.first->second;
+            size_t existing = mCommonVertexHash[slot];
+            if (mVertices[existing].position == vec)
+            {
+                // Already existing, return old one
+                return existing;
+            }
+            slot = (slot + 1) & mask;
         }
+
         // Not found, insert
         CommonVertex newCommon;
         newCommon.index = mVertices.size();
@@ -423,6 +618,23 @@ namespace Ogre {
         newCommon.indexSet = indexSet;
         newCommon.originalIndex = originalIndex;
         mVertices.push_back(newCommon);
+        mCommonVertexHash[slot] = newCommon.index;
+
+        // Indexes past the vertex count are not cached and may add more common
+        // vertices than the table was sized for, grow it to stay half empty.
+        if (mVertices.size() * 2 > mCommonVertexHash.size())
+        {
+            mCommonVertexHash.assign(mCommonVertexHash.size() * 2, static_cast<size_t>(~0));
+            mask = mCommonVertexHash.size() - 1;
+            CommonVertexList::const_iterator ci, ciend = mVertices.end();
+            for (ci = mVertices.begin(); ci != ciend; ++ci)
+            {
+                slot = hashPosition(ci->position) & mask;
+                while (mCommonVertexHash[slot] != static_cast<size_t>(~0))
+                    slot = (slot + 1) & mask;
+                mCommonVertexHash[slot] = ci->index;
+            }
+        }
         return newCommon.index;
     }
     //---------------------------------------------------------------------
@@ -493,14 +705,13 @@ namespace Ogre {
             // lock the buffer for reading
             unsigned char* pBaseVertex = static_cast<unsigned char*>(
                 vbuf->lock(HardwareBuffer::HBL_READ_ONLY));
-            float* pFloat;
             for (j = 0; j < vData->vertexCount; ++j)
             {
-                posElem->baseVertexPointerToElement(pBaseVertex, &pFloat);
+                Vector3 pos = vData->readPosition(posElem, pBaseVertex);
                 l->logMessage("Vertex " + StringConverter::toString(j) + 
-                    ": (" + StringConverter::toString(pFloat[0]) + 
-                    ", " + StringConverter::toString(pFloat[1]) + 
-                    ", " + StringConverter::toString(pFloat[2]) + ")");
+                    ": (" + StringConverter::toString(pos.x) + 
+                    ", " + StringConverter::toString(pos.y) + 
+                    ", " + StringConverter::toString(pos.z) + ")");
                 pBaseVertex += vbuf->getVertexSize();
             }
             vbuf->unlock();
@@ -53,6 +53,9 @@ THE SOFTWARE.
 #include "OgreLodStrategy.h"
 #include "OgreLodListener.h"
 #include "OgreMaterialManager.h"
+#include "OgrePixelCountLodStrategy.h"
+#include "OgreTextureManager.h"
+#include "OgreTextureUnitState.h"
 
 namespace Ogre {
     //-----------------------------------------------------------------------
@@ -76,6 +79,7 @@ namespace Ogre {
 		  mSoftwareAnimationNormalsRequests(0),
           mSkipAnimStateUpdates(false),
 		  mAlwaysUpdateMainSkeleton(false),
+		  mClusterCulling(false),
 		  mMeshLodIndex(0),
 		  mMeshLodFactorTransformed(1.0f),
 		  mMinMeshLodIndex(99),
@@ -113,6 +117,7 @@ namespace Ogre {
 		mSoftwareAnimationNormalsRequests(0),
         mSkipAnimStateUpdates(false),
 		mAlwaysUpdateMainSkeleton(false),
+		mClusterCulling(false),
 		mMeshLodIndex(0),
 		mMeshLodFactorTransformed(1.0f),
 		mMinMeshLodIndex(99),
@@ -185,6 +190,9 @@ namespace Ogre {
 				Entity* lodEnt = OGRE_NEW Entity(mName + "Lod" + StringConverter::toString(i),
 					usage.manualMesh);
 				mLodEntityList.push_back(lodEnt);
+				// Its mesh may be unloaded again when out of the streaming budget
+				if (mMesh->isLodStreaming())
+					MeshManager::getSingleton()._addStreamedLodEntity(lodEnt);
 			}
 		}
 
@@ -234,10 +242,13 @@ namespace Ogre {
 		mSubEntityList.clear();
 		
 		// Delete LOD entities
+		MeshManager* meshManager = MeshManager::getSingletonPtr();
 		LODEntityList::iterator li, liend;
 		liend = mLodEntityList.end();
 		for (li = mLodEntityList.begin(); li != liend; ++li)
 		{
+			if (meshManager && meshManager->_hasStreamedLods())
+				meshManager->_removeStreamedLodEntity(*li);
 			// Delete
 			OGRE_DELETE *li;
             *li = 0;
@@ -424,6 +435,21 @@ namespace Ogre {
             // Change lod index
             mMeshLodIndex = evt.newLodIndex;
 
+            // Streamed LOD levels are requested when needed, and the nearest
+            // coarser level in memory is displayed until they arrive
+            if (mMesh->isLodStreaming())
+            {
+                mMeshLodIndex = mMesh->_requestLodLevel(mMeshLodIndex);
+                if (mMeshLodIndex > 0 && mMesh->isLodManual() &&
+                    static_cast<size_t>(mMeshLodIndex - 1) < mLodEntityList.size())
+                {
+                    // The LOD mesh may have been (re)loaded since its entity was built
+                    Entity* lodEnt = mLodEntityList[mMeshLodIndex - 1];
+                    if (!lodEnt->mInitialised || lodEnt->mMeshStateCount != lodEnt->mMesh->getStateCount())
+                        lodEnt->_initialise(true);
+                }
+            }
+
             // Now do material LOD
             lodValue *= mMaterialLodFactorTransformed;
 
@@ -471,6 +497,35 @@ namespace Ogre {
 				(*i)->_invalidateCameraCache ();
             }
 
+            if (mClusterCulling)
+                updateClusterCulling(cam);
+
+            // Tell streamed textures how many texels across they are displayed with
+            if (TextureManager::getSingletonPtr() && TextureManager::getSingleton()._hasStreamedTextures())
+            {
+                Real pixelCount = PixelCountLodStrategy::getSingleton().getValue(this, cam);
+                Real diameter = 2 * Math::Sqrt(pixelCount / Math::PI);
+                for (i = mSubEntityList.begin(); i != iend; ++i)
+                {
+                    Technique* tech = (*i)->getTechnique();
+                    if (!tech)
+                        continue;
+                    for (unsigned short p = 0; p < tech->getNumPasses(); ++p)
+                    {
+                        Pass* pass = tech->getPass(p);
+                        for (unsigned short t = 0; t < pass->getNumTextureUnitStates(); ++t)
+                        {
+                            TextureUnitState* tus = pass->getTextureUnitState(t);
+                            const TexturePtr& tex = tus->_getTexturePtr();
+                            if (!tex.isNull() && tex->isStreaming())
+                            {
+                                Real scale = std::max(Math::Abs(tus->getTextureUScale()), Real(1e-3f));
+                                tex->_notifyStreamingDemand(diameter / scale);
+                            }
+                        }
+                    }
+                }
+            }
 
         }
         // Notify any child objects
@@ -590,7 +645,7 @@ namespace Ogre {
         iend = displayEntity->mSubEntityList.end();
         for (i = displayEntity->mSubEntityList.begin(); i != iend; ++i)
         {
-            if((*i)->isVisible())
+            if((*i)->isVisible() && !(*i)->mAllClustersCulled)
             {
                 // Order: first use subentity queue settings, if available
                 //        if not then use entity queue settings, if available
@@ -1431,7 +1486,80 @@ namespace Ogre {
             (*i)->setPolygonModeOverrideable(overrideable);
         }
     }
+    //-----------------------------------------------------------------------
+    void Entity::setClusterCulling(bool enabled)
+    {
+        mClusterCulling = enabled;
+        if (!enabled)
+        {
+            SubEntityList::iterator i, iend;
+            iend = mSubEntityList.end();
+            for (i = mSubEntityList.begin(); i != iend; ++i)
+                (*i)->resetClusterCulling();
+        }
+    }
+    //-----------------------------------------------------------------------
+    void Entity::updateClusterCulling(Camera* cam)
+    {
+        // Clusters describe the full detail geometry at rest
+        if (mMeshLodIndex > 0 || hasSkeleton() || hasVertexAnimation())
+        {
+            SubEntityList::iterator i, iend;
+            iend = mSubEntityList.end();
+            for (i = mSubEntityList.begin(); i != iend; ++i)
+                (*i)->resetClusterCulling();
+            return;
+        }
 
+        // Bring the culling planes and the camera into mesh space
+        const Matrix4& world = _getParentNodeFullTransform();
+        const Frustum* frustum = cam->getCullingFrustum() ? cam->getCullingFrustum() : cam;
+        const Plane* worldPlanes = frustum->getFrustumPlanes();
+        Plane planes[6];
+        size_t planeCount = 0;
+        for (size_t p = 0; p < 6; ++p)
+        {
+            // Skip the far plane if it's infinite
+            if (p == FRUSTUM_PLANE_FAR && frustum->getFarClipDistance() == 0)
+                continue;
+            Vector4 local = Vector4(worldPlanes[p].normal.x, worldPlanes[p].normal.y,
+                worldPlanes[p].normal.z, worldPlanes[p].d) * world;
+            planes[planeCount].normal = Vector3(local.x, local.y, local.z);
+            planes[planeCount].d = local.w;
+            planes[planeCount].normalise();
+            ++planeCount;
+        }
+
+        // Back facing clusters are culled only when the transform keeps normal angles
+        // and winding, and not for shadow casters which may render back faces
+        const Vector3& scale = mParentNode->_getDerivedScale();
+        const bool coneTest = frustum->getProjectionType() == PT_PERSPECTIVE &&
+            !cam->isReflected() && scale.x > 0 &&
+            Math::RealEqual(scale.x, scale.y, scale.x * 1e-3f) &&
+            Math::RealEqual(scale.x, scale.z, scale.x * 1e-3f) &&
+            cam->getSceneManager()->_getCurrentRenderStage() != SceneManager::IRS_RENDER_TO_TEXTURE;
+        const Vector3 cameraPosition = world.inverseAffine().transformAffine(cam->getDerivedPosition());
+
+        SubEntityList::iterator i, iend;
+        iend = mSubEntityList.end();
+        for (i = mSubEntityList.begin(); i != iend; ++i)
+        {
+            bool subEntityConeTest = coneTest;
+            if (coneTest)
+            {
+                Technique* tech = (*i)->getTechnique();
+                for (unsigned short p = 0; tech && p < tech->getNumPasses(); ++p)
+                {
+                    if (tech->getPass(p)->getCullingMode() != CULL_CLOCKWISE)
+                    {
+                        subEntityConeTest = false;
+                        break;
+                    }
+                }
+            }
+            (*i)->updateClusterCulling(planes, planeCount, subEntityConeTest, cameraPosition);
+        }
+    }
     //-----------------------------------------------------------------------
     TagPoint* Entity::attachObjectToBone(const String &boneName, MovableObject *pMovable, const Quaternion &offsetOrientation, const Vector3 &offsetPosition)
     {
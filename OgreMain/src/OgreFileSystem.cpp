@@ -58,6 +58,7 @@ THE SOFTWARE.
 namespace Ogre {
 
 	bool FileSystemArchive::msIgnoreHidden = true;
+	bool FileSystemArchive::msUseMemoryMapping = false;
 
     //-----------------------------------------------------------------------
     FileSystemArchive::FileSystemArchive(const String& name, const String& archType, bool readOnly )
@@ -228,6 +229,18 @@ namespace Ogre {
                         "FileSystemArchive::open");
         }
 
+		if (readOnly && msUseMemoryMapping && tagStat.st_size > 0)
+		{
+			try
+			{
+				return DataStreamPtr(OGRE_NEW MmapDataStream(filename, full_path));
+			}
+			catch (Exception&)
+			{
+				// Not mappable, read it through a file stream instead
+			}
+		}
+
 		if (!readOnly)
 		{
 			mode |= std::ios::out;
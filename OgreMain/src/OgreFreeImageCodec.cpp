@@ -405,11 +405,20 @@ namespace Ogre {
     //---------------------------------------------------------------------
     Codec::DecodeResult FreeImageCodec::decode(DataStreamPtr& input) const
     {
-		// Buffer stream into memory (TODO: override IO functions instead?)
-		MemoryDataStream memStream(input, true);
+		// Decode memory backed (e.g. mapped) streams in place, buffer others into memory
+		// (TODO: override IO functions instead?)
+		size_t inSize = input->size() > input->tell() ? input->size() - input->tell() : 0;
+		uchar* inData = inSize ? static_cast<uchar*>(const_cast<void*>(input->peek(inSize))) : 0;
+		MemoryDataStreamPtr memStream;
+		if (!inData)
+		{
+			memStream.bind(OGRE_NEW MemoryDataStream(input, true));
+			inData = memStream->getPtr();
+			inSize = memStream->size();
+		}
 
 		FIMEMORY* fiMem = 
-			FreeImage_OpenMemory(memStream.getPtr(), static_cast<DWORD>(memStream.size()));
+			FreeImage_OpenMemory(inData, static_cast<DWORD>(inSize));
 
 		FIBITMAP* fiBitmap = FreeImage_LoadFromMemory(
 			(FREE_IMAGE_FORMAT)mFreeImageType, fiMem);
@@ -62,11 +62,20 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     HardwareBufferManagerBase::HardwareBufferManagerBase()
         : mUnderUsedFrameCount(0)
+        , mStagingRing(0)
+        , mStagingSize(16 * 1024 * 1024)
+        , mUploadBytesPerFrame(std::numeric_limits<size_t>::max())
+        , mNextUploadTicket(1)
+        , mCompletedUploadTicket(0)
     {
     }
     //-----------------------------------------------------------------------
     HardwareBufferManagerBase::~HardwareBufferManagerBase()
     {
+        // Uploads still queued hold on to their buffers
+        mUploads.clear();
+        OGRE_FREE(mStagingRing, MEMCATEGORY_GEOMETRY);
+
         // Clear vertex/index buffer list first, avoid destroyed notify do
         // unnecessary work, and we'll destroy everything here.
 		mVertexBuffers.clear();
@@ -389,6 +398,195 @@ namespace Ogre {
 
             // holdForDelayDestroy will destroy auto.
         }
+    }
+    //-----------------------------------------------------------------------
+    void HardwareBufferManagerBase::setUploadStagingSize(size_t bytes)
+    {
+        OGRE_LOCK_MUTEX(mUploadMutex)
+        if (!mStagingReservations.empty())
+        {
+            OGRE_EXCEPT(Exception::ERR_INVALID_STATE,
+                "Cannot resize the upload staging memory while some of it is reserved",
+                "HardwareBufferManagerBase::setUploadStagingSize");
+        }
+        OGRE_FREE(mStagingRing, MEMCATEGORY_GEOMETRY);
+        mStagingRing = 0;
+        mStagingSize = bytes;
+    }
+    //-----------------------------------------------------------------------
+    void HardwareBufferManagerBase::setUploadBytesPerFrame(size_t bytes)
+    {
+        OGRE_LOCK_MUTEX(mUploadMutex)
+        mUploadBytesPerFrame = bytes;
+    }
+    //-----------------------------------------------------------------------
+    void* HardwareBufferManagerBase::reserveUploadStaging(size_t bytes)
+    {
+        OGRE_LOCK_MUTEX(mUploadMutex)
+
+        // Keep every reservation aligned for SIMD copies
+        size_t size = (bytes + 15) & ~(size_t)15;
+        if (bytes == 0 || size > mStagingSize)
+            return 0;
+        if (!mStagingRing)
+            mStagingRing = OGRE_ALLOC_T(uchar, mStagingSize, MEMCATEGORY_GEOMETRY);
+
+        // Reservations are handed out and reused in order, the free space is
+        // after the last one and, once that has wrapped around, before the first
+        size_t start = 0;
+        if (!mStagingReservations.empty())
+        {
+            const StagingReservation& first = mStagingReservations.front();
+            const StagingReservation& last = mStagingReservations.back();
+            size_t end = last.start + last.size;
+            if (last.start >= first.start)
+            {
+                if (mStagingSize - end >= size)
+                    start = end;
+                else if (first.start >= size)
+                    start = 0;
+                else
+                    return 0;
+            }
+            else if (first.start - end >= size)
+                start = end;
+            else
+                return 0;
+        }
+
+        StagingReservation reservation;
+        reservation.start = start;
+        reservation.size = size;
+        reservation.released = false;
+        reservation.releaseTicket = 0;
+        mStagingReservations.push_back(reservation);
+        return mStagingRing + start;
+    }
+    //-----------------------------------------------------------------------
+    void HardwareBufferManagerBase::releaseUploadStaging(void* staging)
+    {
+        OGRE_LOCK_MUTEX(mUploadMutex)
+        size_t start = static_cast<uchar*>(staging) - mStagingRing;
+        StagingReservationList::iterator i = mStagingReservations.begin();
+        while (i != mStagingReservations.end() && i->start != start)
+            ++i;
+        if (!mStagingRing || i == mStagingReservations.end() || i->released)
+        {
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+                "Memory was not reserved with reserveUploadStaging",
+                "HardwareBufferManagerBase::releaseUploadStaging");
+        }
+        i->released = true;
+        i->releaseTicket = mNextUploadTicket - 1;
+        retireStagingReservations();
+    }
+    //-----------------------------------------------------------------------
+    void HardwareBufferManagerBase::retireStagingReservations(void)
+    {
+        while (!mStagingReservations.empty() && mStagingReservations.front().released &&
+            mStagingReservations.front().releaseTicket <= mCompletedUploadTicket)
+        {
+            mStagingReservations.pop_front();
+        }
+    }
+    //-----------------------------------------------------------------------
+    HardwareBufferManagerBase::UploadTicket HardwareBufferManagerBase::queueUpload(
+        const SharedPtr<HardwareBuffer>& buffer, size_t offset, size_t length, const void* data)
+    {
+        QueuedUpload upload;
+        upload.buffer = buffer;
+        upload.offset = offset;
+        upload.length = length;
+        upload.data = data;
+
+        OGRE_LOCK_MUTEX(mUploadMutex)
+        upload.ticket = mNextUploadTicket++;
+        mUploads.push_back(upload);
+        return upload.ticket;
+    }
+    //-----------------------------------------------------------------------
+    HardwareBufferManagerBase::UploadTicket HardwareBufferManagerBase::queueUpload(
+        const HardwarePixelBufferSharedPtr& buffer, const PixelBox& src, const Image::Box& dstBox)
+    {
+        QueuedUpload upload;
+        upload.offset = 0;
+        upload.length = src.getConsecutiveSize();
+        upload.data = src.data;
+        upload.pixelBuffer = buffer;
+        upload.src = src;
+        upload.dstBox = dstBox;
+
+        OGRE_LOCK_MUTEX(mUploadMutex)
+        upload.ticket = mNextUploadTicket++;
+        mUploads.push_back(upload);
+        return upload.ticket;
+    }
+    //-----------------------------------------------------------------------
+    bool HardwareBufferManagerBase::isUploadComplete(UploadTicket ticket) const
+    {
+        OGRE_LOCK_MUTEX(mUploadMutex)
+        return ticket <= mCompletedUploadTicket;
+    }
+    //-----------------------------------------------------------------------
+    void HardwareBufferManagerBase::_cancelUploads(const HardwareBuffer* buffer)
+    {
+        OGRE_LOCK_MUTEX(mUploadMutex)
+        for (UploadQueue::iterator i = mUploads.begin(); i != mUploads.end(); ++i)
+        {
+            if (i->buffer.get() == buffer || i->pixelBuffer.get() == buffer)
+            {
+                // Kept in the queue so that its ticket completes in order
+                i->buffer.setNull();
+                i->pixelBuffer.setNull();
+                i->length = 0;
+            }
+        }
+    }
+    //-----------------------------------------------------------------------
+    size_t HardwareBufferManagerBase::getPendingUploadCount(void) const
+    {
+        OGRE_LOCK_MUTEX(mUploadMutex)
+        return mUploads.size();
+    }
+    //-----------------------------------------------------------------------
+    void HardwareBufferManagerBase::_flushUploads(bool all)
+    {
+        // Take this frame's share of the queue, the copies are then made without
+        // holding the lock so that workers can keep queueing
+        UploadQueue batch;
+        {
+            OGRE_LOCK_MUTEX(mUploadMutex)
+            size_t bytes = 0;
+            while (!mUploads.empty())
+            {
+                size_t length = mUploads.front().length;
+                if (!all && !batch.empty() && bytes + length > mUploadBytesPerFrame)
+                    break;
+                bytes += length;
+                batch.push_back(mUploads.front());
+                mUploads.pop_front();
+            }
+        }
+        if (batch.empty())
+            return;
+
+        for (UploadQueue::iterator i = batch.begin(); i != batch.end(); ++i)
+        {
+            if (!i->pixelBuffer.isNull())
+            {
+                i->pixelBuffer->blitFromMemory(i->src, i->dstBox);
+            }
+            else if (!i->buffer.isNull())
+            {
+                bool wholeBuffer = i->offset == 0 && i->length == i->buffer->getSizeInBytes();
+                i->buffer->writeData(i->offset, i->length, i->data, wholeBuffer);
+            }
+        }
+
+        // The copies are done once the calls return, the staging memory can be reused
+        OGRE_LOCK_MUTEX(mUploadMutex)
+        mCompletedUploadTicket = batch.back().ticket;
+        retireStagingReservations();
     }
 	//-----------------------------------------------------------------------
 	void HardwareBufferManagerBase::_notifyVertexBufferDestroyed(HardwareVertexBuffer* buf)
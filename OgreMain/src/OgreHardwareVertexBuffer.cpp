@@ -186,6 +186,12 @@ namespace Ogre {
             return sizeof(unsigned int)*4;
         case VET_UBYTE4:
             return sizeof(unsigned char)*4;
+        case VET_HALF2:
+        case VET_SHORT2_SNORM:
+            return sizeof(short)*2;
+        case VET_HALF4:
+        case VET_SHORT4_SNORM:
+            return sizeof(short)*4;
 		}
 		return 0;
 	}
@@ -210,6 +216,8 @@ namespace Ogre {
         case VET_UINT2:
         case VET_INT2:
         case VET_DOUBLE2:
+        case VET_HALF2:
+        case VET_SHORT2_SNORM:
 			return 2;
         case VET_FLOAT3:
         case VET_SHORT3:
@@ -225,6 +233,8 @@ namespace Ogre {
         case VET_INT4:
         case VET_DOUBLE4:
         case VET_UBYTE4:
+        case VET_HALF4:
+        case VET_SHORT4_SNORM:
             return 4;
 		}
 		OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Invalid type", 
@@ -266,6 +276,28 @@ namespace Ogre {
                 break;
 			}
 			break;
+		case VET_HALF2:
+			switch(count)
+			{
+			case 2:
+				return VET_HALF2;
+			case 4:
+				return VET_HALF4;
+            default:
+                break;
+			}
+			break;
+		case VET_SHORT2_SNORM:
+			switch(count)
+			{
+			case 2:
+				return VET_SHORT2_SNORM;
+			case 4:
+				return VET_SHORT4_SNORM;
+            default:
+                break;
+			}
+			break;
         default:
             break;
 		}
@@ -365,6 +397,12 @@ namespace Ogre {
 				return VET_USHORT1;
 			case VET_UBYTE4:
 				return VET_UBYTE4;
+			case VET_HALF2:
+			case VET_HALF4:
+				return VET_HALF2;
+			case VET_SHORT2_SNORM:
+			case VET_SHORT4_SNORM:
+				return VET_SHORT2_SNORM;
 		};
         // To keep compiler happy
         return VET_FLOAT1;
@@ -32,6 +32,11 @@ THE SOFTWARE.
 #include "OgreImageCodec.h"
 #include "OgreColourValue.h"
 #include "OgreMath.h"
+#include "OgrePlatformInformation.h"
+#include "OgreParallelFor.h"
+#if __OGRE_HAVE_SSE
+#include <xmmintrin.h>
+#endif
 #include "OgreImageResampler.h"
 
 namespace Ogre {
@@ -591,6 +596,264 @@ namespace Ogre {
 		// scale the image from temp into our resized buffer
 		Image::scale(temp.getPixelBox(), getPixelBox(), filter);
 	}
+	//-----------------------------------------------------------------------------
+	namespace
+	{
+		/// sRGB transfer curves; 8 bit channels decode through a table, the
+		/// encoding interpolates a table for values in [0, 1]
+		struct SrgbTables
+		{
+			float toLinear[256];
+			float toSrgb[4097];
+
+			SrgbTables()
+			{
+				for (int i = 0; i < 256; ++i)
+					toLinear[i] = decode(i / 255.0f);
+				for (int i = 0; i <= 4096; ++i)
+					toSrgb[i] = encode(i / 4096.0f);
+			}
+
+			static float decode(float v)
+			{
+				return v <= 0.04045f ? v / 12.92f : std::pow((v + 0.055f) / 1.055f, 2.4f);
+			}
+
+			static float encode(float v)
+			{
+				return v <= 0.0031308f ? v * 12.92f : 1.055f * std::pow(v, 1.0f / 2.4f) - 0.055f;
+			}
+		};
+		const SrgbTables gSrgbTables;
+
+		/// Converts the colour channels of a row of PF_FLOAT32_RGBA to linear
+		void decodeSrgbRow(float* row, size_t width, bool eightBit)
+		{
+			for (size_t i = 0; i < width * 4; ++i)
+			{
+				if ((i & 3) == 3)
+					continue; // alpha is linear already
+				const float v = row[i];
+				if (!(v > 0))
+					row[i] = 0; // also catches NaN, which A8 unpacks to
+				else if (eightBit && v <= 1)
+					row[i] = gSrgbTables.toLinear[(int)(v * 255.0f + 0.5f)];
+				else
+					row[i] = SrgbTables::decode(v);
+			}
+		}
+
+		/// Converts the colour channels of a row of PF_FLOAT32_RGBA back to sRGB
+		void encodeSrgbRow(float* row, size_t width)
+		{
+			for (size_t i = 0; i < width * 4; ++i)
+			{
+				if ((i & 3) == 3)
+					continue;
+				const float v = row[i];
+				if (!(v > 0))
+					row[i] = 0;
+				else if (v < 1)
+				{
+					const float f = v * 4096.0f;
+					const int j = (int)f;
+					row[i] = gSrgbTables.toSrgb[j] + (f - j) * (gSrgbTables.toSrgb[j + 1] - gSrgbTables.toSrgb[j]);
+				}
+				else
+					row[i] = SrgbTables::encode(v);
+			}
+		}
+
+		/// A band of rows of one slice of one face, to be filtered from the level above
+		struct MipmapBand
+		{
+			PixelBox src;
+			PixelBox dst;
+			size_t z;
+			size_t first;
+			size_t last;
+		};
+
+		/// Settings shared by all bands of a mipmap chain
+		struct MipmapSettings
+		{
+			MipmapKernel kernel;
+			bool gammaCorrect;
+			bool eightBit;
+			bool sse;
+		};
+
+		/// Filters one band: rows are unpacked to float, halved horizontally,
+		/// then the destination rows are summed vertically (and across the two
+		/// source slices of 3D images) and packed again
+		void filterMipmapBand(const MipmapBand& band, const MipmapSettings& settings,
+			vector<float>::type& scratch)
+		{
+			const MipmapKernel& kernel = settings.kernel;
+			const size_t srcWidth = band.src.getWidth(), srcHeight = band.src.getHeight();
+			const size_t dstWidth = band.dst.getWidth();
+			const size_t bandRows = band.last - band.first;
+
+			// Source rows needed by the band, clamped to the image
+			const ptrdiff_t lastRow = (ptrdiff_t)srcHeight - 1;
+			const ptrdiff_t firstNeeded = std::max((ptrdiff_t)(2 * band.first) + kernel.offset, (ptrdiff_t)0);
+			const ptrdiff_t lastNeeded = std::min((ptrdiff_t)(2 * (band.last - 1)) + kernel.offset + kernel.taps - 1, lastRow);
+			const size_t neededRows = (size_t)(lastNeeded - firstNeeded + 1);
+
+			scratch.resize(srcWidth * 4 + (neededRows + bandRows) * dstWidth * 4);
+			float* srcRow = &scratch[0];
+			float* halved = srcRow + srcWidth * 4;
+			float* accum = halved + neededRows * dstWidth * 4;
+			std::fill(accum, accum + bandRows * dstWidth * 4, 0.0f);
+
+			// 3D images average two source slices, there is no filtering along z
+			size_t slices[2] = { 2 * band.z, std::min(2 * band.z + 1, band.src.getDepth() - 1) };
+			const size_t sliceCount = band.src.getDepth() > 1 ? 2 : 1;
+			if (sliceCount == 1)
+				slices[0] = 0;
+
+			for (size_t s = 0; s < sliceCount; ++s)
+			{
+				for (size_t r = 0; r < neededRows; ++r)
+				{
+					PixelBox srcBox = band.src;
+					srcBox.top = band.src.top + firstNeeded + r;
+					srcBox.bottom = srcBox.top + 1;
+					srcBox.front = band.src.front + slices[s];
+					srcBox.back = srcBox.front + 1;
+					PixelUtil::bulkPixelConversion(srcBox, PixelBox(srcWidth, 1, 1, PF_FLOAT32_RGBA, srcRow));
+					if (settings.gammaCorrect)
+						decodeSrgbRow(srcRow, srcWidth, settings.eightBit);
+					mipmapFilterRow(srcRow, srcWidth, halved + r * dstWidth * 4, dstWidth, kernel, settings.sse);
+				}
+
+				for (size_t y = band.first; y < band.last; ++y)
+				{
+					const float* rows[8];
+					for (int k = 0; k < kernel.taps; ++k)
+					{
+						const ptrdiff_t sy = std::min(std::max((ptrdiff_t)(2 * y) + kernel.offset + k, (ptrdiff_t)0), lastRow);
+						rows[k] = halved + (sy - firstNeeded) * dstWidth * 4;
+					}
+					mipmapFilterColumns(rows, kernel, 1.0f / sliceCount,
+						accum + (y - band.first) * dstWidth * 4, dstWidth, settings.sse);
+				}
+			}
+
+			for (size_t y = band.first; y < band.last; ++y)
+			{
+				float* row = accum + (y - band.first) * dstWidth * 4;
+				if (settings.gammaCorrect)
+					encodeSrgbRow(row, dstWidth);
+				PixelBox dstBox = band.dst;
+				dstBox.top = band.dst.top + y;
+				dstBox.bottom = dstBox.top + 1;
+				dstBox.front = band.dst.front + band.z;
+				dstBox.back = dstBox.front + 1;
+				PixelUtil::bulkPixelConversion(PixelBox(dstWidth, 1, 1, PF_FLOAT32_RGBA, row), dstBox);
+			}
+		}
+
+		/// Takes bands off a shared list until there are none left
+		struct MipmapWorker
+		{
+			const vector<MipmapBand>::type* bands;
+			const MipmapSettings* settings;
+			AtomicScalar<size_t>* next;
+
+			MipmapWorker(const vector<MipmapBand>::type* b, const MipmapSettings* s, AtomicScalar<size_t>* n)
+				: bands(b), settings(s), next(n) {}
+
+			void run()
+			{
+				vector<float>::type scratch;
+				size_t i;
+				while ((i = (*next)++) < bands->size())
+					filterMipmapBand((*bands)[i], *settings, scratch);
+			}
+		};
+
+		void initMipmapSettings(MipmapSettings& settings, PixelFormat format, Image::Filter filter, bool gammaCorrect)
+		{
+			settings.kernel = filter == Image::FILTER_KAISER ? MipmapKernel::kaiser() : MipmapKernel::box();
+			settings.gammaCorrect = gammaCorrect;
+			int bits[4];
+			PixelUtil::getBitDepths(format, bits);
+			settings.eightBit = !PixelUtil::isFloatingPoint(format);
+			for (int i = 0; i < 4; ++i)
+				settings.eightBit = settings.eightBit && (bits[i] == 0 || bits[i] == 8);
+			settings.sse = false;
+#if __OGRE_HAVE_SSE
+			settings.sse = (PlatformInformation::getCpuFeatures() & PlatformInformation::CPU_FEATURE_SSE) != 0;
+#endif
+		}
+
+		/// Splits every slice of dst into bands of about 16K destination pixels
+		void addMipmapBands(vector<MipmapBand>::type& bands, const PixelBox& src, const PixelBox& dst)
+		{
+			MipmapBand band;
+			band.src = src;
+			band.dst = dst;
+			const size_t rowsPerBand = std::max<size_t>(1, 16384 / dst.getWidth());
+			for (band.z = 0; band.z < dst.getDepth(); ++band.z)
+			{
+				for (band.first = 0; band.first < dst.getHeight(); band.first += rowsPerBand)
+				{
+					band.last = std::min(band.first + rowsPerBand, dst.getHeight());
+					bands.push_back(band);
+				}
+			}
+		}
+
+		void filterMipmapBands(const vector<MipmapBand>::type& bands, const MipmapSettings& settings)
+		{
+			size_t threadCount = std::max<size_t>(1,
+				std::min(ParallelFor::getHardwareThreadCount(), bands.size()));
+			AtomicScalar<size_t> next(0);
+			vector<MipmapWorker>::type workers(threadCount, MipmapWorker(&bands, &settings, &next));
+			ParallelFor::runWorkers(workers);
+		}
+
+		typedef void (*ResampleFunc)(const PixelBox& src, const PixelBox& dst, size_t first, size_t last);
+
+		/// Takes bands of destination rows off a shared counter and resamples them
+		struct ResampleWorker
+		{
+			ResampleFunc func;
+			const PixelBox* src;
+			const PixelBox* dst;
+			size_t rowsPerBand;
+			AtomicScalar<size_t>* next;
+
+			ResampleWorker(ResampleFunc f, const PixelBox* s, const PixelBox* d, size_t rows, AtomicScalar<size_t>* n)
+				: func(f), src(s), dst(d), rowsPerBand(rows), next(n) {}
+
+			void run()
+			{
+				const size_t height = dst->getHeight();
+				size_t i;
+				while ((i = (*next)++) * rowsPerBand < height)
+					func(*src, *dst, i * rowsPerBand, std::min(height, (i + 1) * rowsPerBand));
+			}
+		};
+
+		/// Resamples src into dst in bands of about 64K destination pixels, using
+		/// as many threads as bulkPixelConversion may
+		void resample(ResampleFunc func, const PixelBox& src, const PixelBox& dst)
+		{
+			const size_t height = dst.getHeight();
+			const size_t rowsPerBand = std::max<size_t>(1, 65536 / (dst.getWidth() * dst.getDepth()));
+			const size_t bandCount = (height + rowsPerBand - 1) / rowsPerBand;
+			size_t threadCount = PixelUtil::getBulkConversionThreads();
+			if (threadCount == 0)
+				threadCount = ParallelFor::getHardwareThreadCount();
+			threadCount = std::max<size_t>(1, std::min(threadCount, bandCount));
+
+			AtomicScalar<size_t> next(0);
+			vector<ResampleWorker>::type workers(threadCount, ResampleWorker(func, &src, &dst, rowsPerBand, &next));
+			ParallelFor::runWorkers(workers);
+		}
+	}
 	//-----------------------------------------------------------------------
 	void Image::scale(const PixelBox &src, const PixelBox &scaled, Filter filter) 
 	{
@@ -617,14 +880,14 @@ namespace Ogre {
 			// super-optimized: no conversion
 			switch (PixelUtil::getNumElemBytes(src.format)) 
 			{
-			case 1: NearestResampler<1>::scale(src, temp); break;
-			case 2: NearestResampler<2>::scale(src, temp); break;
-			case 3: NearestResampler<3>::scale(src, temp); break;
-			case 4: NearestResampler<4>::scale(src, temp); break;
-			case 6: NearestResampler<6>::scale(src, temp); break;
-			case 8: NearestResampler<8>::scale(src, temp); break;
-			case 12: NearestResampler<12>::scale(src, temp); break;
-			case 16: NearestResampler<16>::scale(src, temp); break;
+			case 1: resample(NearestResampler<1>::scale, src, temp); break;
+			case 2: resample(NearestResampler<2>::scale, src, temp); break;
+			case 3: resample(NearestResampler<3>::scale, src, temp); break;
+			case 4: resample(NearestResampler<4>::scale, src, temp); break;
+			case 6: resample(NearestResampler<6>::scale, src, temp); break;
+			case 8: resample(NearestResampler<8>::scale, src, temp); break;
+			case 12: resample(NearestResampler<12>::scale, src, temp); break;
+			case 16: resample(NearestResampler<16>::scale, src, temp); break;
 			default:
 				// never reached
 				assert(false);
@@ -638,6 +901,20 @@ namespace Ogre {
 
 		case FILTER_LINEAR:
 		case FILTER_BILINEAR:
+			if (scaled.getWidth() * 2 == src.getWidth() && scaled.getHeight() * 2 == src.getHeight() &&
+				src.getDepth() == 1 && scaled.getDepth() == 1 &&
+				src.left == 0 && src.top == 0 && src.front == 0 &&
+				scaled.left == 0 && scaled.top == 0 && scaled.front == 0)
+			{
+				// Bilinear halving averages 2x2 blocks, which the mipmap row kernels
+				// do vectorised and with the conversion to the destination format fused
+				MipmapSettings settings;
+				initMipmapSettings(settings, src.format, FILTER_BOX, false);
+				vector<MipmapBand>::type bands;
+				addMipmapBands(bands, src, scaled);
+				filterMipmapBands(bands, settings);
+				break;
+			}
 			switch (src.format) 
 			{
 			case PF_L8: case PF_A8: case PF_BYTE_LA:
@@ -660,10 +937,10 @@ namespace Ogre {
 				// super-optimized: byte-oriented math, no conversion
 				switch (PixelUtil::getNumElemBytes(src.format)) 
 				{
-				case 1: LinearResampler_Byte<1>::scale(src, temp); break;
-				case 2: LinearResampler_Byte<2>::scale(src, temp); break;
-				case 3: LinearResampler_Byte<3>::scale(src, temp); break;
-				case 4: LinearResampler_Byte<4>::scale(src, temp); break;
+				case 1: resample(LinearResampler_Byte<1>::scale, src, temp); break;
+				case 2: resample(LinearResampler_Byte<2>::scale, src, temp); break;
+				case 3: resample(LinearResampler_Byte<3>::scale, src, temp); break;
+				case 4: resample(LinearResampler_Byte<4>::scale, src, temp); break;
 				default:
 					// never reached
 					assert(false);
@@ -679,18 +956,115 @@ namespace Ogre {
 				if (scaled.format == PF_FLOAT32_RGB || scaled.format == PF_FLOAT32_RGBA)
 				{
 					// float32 to float32, avoid unpack/repack overhead
-					LinearResampler_Float32::scale(src, scaled);
+					resample(LinearResampler_Float32::scale, src, scaled);
 					break;
 				}
 				// else, fall through
 			default:
 				// non-optimized: floating-point math, performs conversion but always works
-				LinearResampler::scale(src, scaled);
+				resample(LinearResampler::scale, src, scaled);
 			}
 			break;
 		}
 	}
 
+	//-----------------------------------------------------------------------------
+	bool Image::generateMipmaps(size_t numMipmaps, Filter filter, bool gammaCorrect)
+	{
+		if (!mBuffer || PixelUtil::isCompressed(mFormat) || !PixelUtil::isAccessible(mFormat))
+			return false;
+
+		// Clamp to a full chain
+		size_t fullChain = 0;
+		for (size_t w = mWidth, h = mHeight, d = mDepth; w > 1 || h > 1 || d > 1; ++fullChain)
+		{
+			w = std::max<size_t>(1, w / 2);
+			h = std::max<size_t>(1, h / 2);
+			d = std::max<size_t>(1, d / 2);
+		}
+		numMipmaps = std::min(numMipmaps, fullChain);
+
+		// Converting a pixel both ways here makes unsupported formats throw on this thread
+		uint8 probe[16];
+		float probeFloat[4];
+		PixelUtil::bulkPixelConversion(mBuffer, mFormat, probeFloat, PF_FLOAT32_RGBA, 1);
+		PixelUtil::bulkPixelConversion(probeFloat, PF_FLOAT32_RGBA, probe, mFormat, 1);
+
+		// Copy the top level of every face into a buffer with room for the chain
+		const size_t faces = getNumFaces();
+		const size_t topSize = PixelUtil::getMemorySize(mWidth, mHeight, mDepth, mFormat);
+		const size_t oldFaceSize = calculateSize(mNumMipmaps, 1, mWidth, mHeight, mDepth, mFormat);
+		const size_t newFaceSize = calculateSize(numMipmaps, 1, mWidth, mHeight, mDepth, mFormat);
+		uchar* buffer = OGRE_ALLOC_T(uchar, newFaceSize * faces, MEMCATEGORY_GENERAL);
+		for (size_t face = 0; face < faces; ++face)
+			memcpy(buffer + face * newFaceSize, mBuffer + face * oldFaceSize, topSize);
+		freeMemory();
+		mBuffer = buffer;
+		mBufSize = newFaceSize * faces;
+		mNumMipmaps = numMipmaps;
+		mAutoDelete = true;
+
+		MipmapSettings settings;
+		initMipmapSettings(settings, mFormat, filter, gammaCorrect);
+
+		for (size_t mip = 1; mip <= numMipmaps; ++mip)
+		{
+			vector<MipmapBand>::type bands;
+			for (size_t face = 0; face < faces; ++face)
+				addMipmapBands(bands, getPixelBox(face, mip - 1), getPixelBox(face, mip));
+			filterMipmapBands(bands, settings);
+		}
+		return true;
+	}
+	//-----------------------------------------------------------------------------
+	bool Image::compress(PixelFormat format, CompressionQuality quality)
+	{
+		if (!mBuffer || PixelUtil::isCompressed(mFormat) || !PixelUtil::canCompressTo(format) || mDepth > 1)
+			return false;
+
+		const size_t faces = getNumFaces();
+		const size_t size = calculateSize(mNumMipmaps, faces, mWidth, mHeight, mDepth, format);
+		uchar* buffer = OGRE_ALLOC_T(uchar, size, MEMCATEGORY_GENERAL);
+		for (size_t face = 0; face < faces; ++face)
+		{
+			// Compressed levels are laid out like uncompressed ones, just smaller
+			size_t offset = face * calculateSize(mNumMipmaps, 1, mWidth, mHeight, mDepth, format);
+			for (size_t mip = 0; mip <= mNumMipmaps; ++mip)
+			{
+				PixelBox src = getPixelBox(face, mip);
+				PixelBox dst(src.getWidth(), src.getHeight(), src.getDepth(), format, buffer + offset);
+				PixelUtil::compressPixels(src, dst, quality);
+				offset += PixelUtil::getMemorySize(dst.getWidth(), dst.getHeight(), dst.getDepth(), format);
+			}
+		}
+
+		freeMemory();
+		mBuffer = buffer;
+		mBufSize = size;
+		mFormat = format;
+		mPixelSize = static_cast<uchar>(PixelUtil::getNumElemBytes(mFormat));
+		mFlags |= IF_COMPRESSED;
+		mAutoDelete = true;
+		return true;
+	}
+	//-----------------------------------------------------------------------------
+	void Image::copyMipmapTail(size_t mipmap, Image& dest) const
+	{
+		if (mipmap > mNumMipmaps)
+			OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Mipmap index out of range",
+				"Image::copyMipmapTail");
+
+		const PixelBox top = getPixelBox(0, mipmap);
+		const size_t faces = getNumFaces();
+		const size_t numMipmaps = mNumMipmaps - mipmap;
+		const size_t tailSize = calculateSize(numMipmaps, 1, top.getWidth(), top.getHeight(), top.getDepth(), mFormat);
+		uchar* buffer = OGRE_ALLOC_T(uchar, tailSize * faces, MEMCATEGORY_GENERAL);
+		// The levels of each face are consecutive, so the tail is one block per face
+		for (size_t face = 0; face < faces; ++face)
+			memcpy(buffer + face * tailSize, getPixelBox(face, mipmap).data, tailSize);
+		dest.loadDynamicImage(buffer, top.getWidth(), top.getHeight(), top.getDepth(), mFormat,
+			true, faces, numMipmaps);
+	}
 	//-----------------------------------------------------------------------------    
 
 	ColourValue Image::getColourAt(size_t x, size_t y, size_t z) const
@@ -47,17 +47,19 @@ namespace Ogre {
 // sx2 = upper-bound integer x-position in source
 // sxf = fractional weight between sx1 and sx2
 // x,y,z = location of output pixel in destination
+//
+// every resampler fills destination rows [first, last) of each slice, so
+// that Image::scale can split large boxes into bands of rows
 
 // nearest-neighbor resampler, does not convert formats.
 // templated on bytes-per-pixel to allow compiler optimizations, such
 // as simplifying memcpy() and replacing multiplies with bitshifts
 template<unsigned int elemsize> struct NearestResampler {
-	static void scale(const PixelBox& src, const PixelBox& dst) {
+	static void scale(const PixelBox& src, const PixelBox& dst, size_t first, size_t last) {
 		// assert(src.format == dst.format);
 
 		// srcdata stays at beginning, pdst is a moving pointer
 		uchar* srcdata = (uchar*)src.data;
-		uchar* pdst = (uchar*)dst.data;
 
 		// sx_48,sy_48,sz_48 represent current position in source
 		// using 16/48-bit fixed precision, incremented by steps
@@ -70,9 +72,10 @@ template<unsigned int elemsize> struct NearestResampler {
 		uint64 sz_48 = (stepz >> 1) - 1;
 		for (size_t z = dst.front; z < dst.back; z++, sz_48 += stepz) {
 			size_t srczoff = (size_t)(sz_48 >> 48) * src.slicePitch;
+			uchar* pdst = (uchar*)dst.data + elemsize*((z - dst.front)*dst.slicePitch + first*dst.rowPitch);
 			
-			uint64 sy_48 = (stepy >> 1) - 1;
-			for (size_t y = dst.top; y < dst.bottom; y++, sy_48 += stepy) {
+			uint64 sy_48 = (stepy >> 1) - 1 + first*stepy;
+			for (size_t y = first; y < last; y++, sy_48 += stepy) {
 				size_t srcyoff = (size_t)(sy_48 >> 48) * src.rowPitch;
 			
 				uint64 sx_48 = (stepx >> 1) - 1;
@@ -84,7 +87,6 @@ template<unsigned int elemsize> struct NearestResampler {
 				}
 				pdst += elemsize*dst.getRowSkip();
 			}
-			pdst += elemsize*dst.getSliceSkip();
 		}
 	}
 };
@@ -92,13 +94,12 @@ template<unsigned int elemsize> struct NearestResampler {
 
 // default floating-point linear resampler, does format conversion
 struct LinearResampler {
-	static void scale(const PixelBox& src, const PixelBox& dst) {
+	static void scale(const PixelBox& src, const PixelBox& dst, size_t first, size_t last) {
 		size_t srcelemsize = PixelUtil::getNumElemBytes(src.format);
 		size_t dstelemsize = PixelUtil::getNumElemBytes(dst.format);
 
 		// srcdata stays at beginning, pdst is a moving pointer
 		uchar* srcdata = (uchar*)src.data;
-		uchar* pdst = (uchar*)dst.data;
 		
 		// sx_48,sy_48,sz_48 represent current position in source
 		// using 16/48-bit fixed precision, incremented by steps
@@ -121,9 +122,10 @@ struct LinearResampler {
 			size_t sz1 = temp >> 16;				 // src z, sample #1
 			size_t sz2 = std::min(sz1+1,src.getDepth()-1);// src z, sample #2
 			float szf = (temp & 0xFFFF) / 65536.f; // weight of sample #2
+			uchar* pdst = (uchar*)dst.data + dstelemsize*((z - dst.front)*dst.slicePitch + first*dst.rowPitch);
 
-			uint64 sy_48 = (stepy >> 1) - 1;
-			for (size_t y = dst.top; y < dst.bottom; y++, sy_48+=stepy) {
+			uint64 sy_48 = (stepy >> 1) - 1 + first*stepy;
+			for (size_t y = first; y < last; y++, sy_48+=stepy) {
 				temp = static_cast<unsigned int>(sy_48 >> 32);
 				temp = (temp > 0x8000)? temp - 0x8000 : 0;
 				size_t sy1 = temp >> 16;					// src y #1
@@ -166,7 +168,6 @@ struct LinearResampler {
 				}
 				pdst += dstelemsize*dst.getRowSkip();
 			}
-			pdst += dstelemsize*dst.getSliceSkip();
 		}
 	}
 };
@@ -175,7 +176,7 @@ struct LinearResampler {
 // float32 linear resampler, converts FLOAT32_RGB/FLOAT32_RGBA only.
 // avoids overhead of pixel unpack/repack function calls
 struct LinearResampler_Float32 {
-	static void scale(const PixelBox& src, const PixelBox& dst) {
+	static void scale(const PixelBox& src, const PixelBox& dst, size_t first, size_t last) {
 		size_t srcchannels = PixelUtil::getNumElemBytes(src.format) / sizeof(float);
 		size_t dstchannels = PixelUtil::getNumElemBytes(dst.format) / sizeof(float);
 		// assert(srcchannels == 3 || srcchannels == 4);
@@ -183,7 +184,6 @@ struct LinearResampler_Float32 {
 
 		// srcdata stays at beginning, pdst is a moving pointer
 		float* srcdata = (float*)src.data;
-		float* pdst = (float*)dst.data;
 		
 		// sx_48,sy_48,sz_48 represent current position in source
 		// using 16/48-bit fixed precision, incremented by steps
@@ -206,9 +206,10 @@ struct LinearResampler_Float32 {
 			size_t sz1 = temp >> 16;				 // src z, sample #1
 			size_t sz2 = std::min(sz1+1,src.getDepth()-1);// src z, sample #2
 			float szf = (temp & 0xFFFF) / 65536.f; // weight of sample #2
+			float* pdst = (float*)dst.data + dstchannels*((z - dst.front)*dst.slicePitch + first*dst.rowPitch);
 
-			uint64 sy_48 = (stepy >> 1) - 1;
-			for (size_t y = dst.top; y < dst.bottom; y++, sy_48+=stepy) {
+			uint64 sy_48 = (stepy >> 1) - 1 + first*stepy;
+			for (size_t y = first; y < last; y++, sy_48+=stepy) {
 				temp = static_cast<unsigned int>(sy_48 >> 32);
 				temp = (temp > 0x8000)? temp - 0x8000 : 0;
 				size_t sy1 = temp >> 16;					// src y #1
@@ -270,7 +271,6 @@ struct LinearResampler_Float32 {
 				}
 				pdst += dstchannels*dst.getRowSkip();
 			}
-			pdst += dstchannels*dst.getSliceSkip();
 		}
 	}
 };
@@ -283,18 +283,18 @@ struct LinearResampler_Float32 {
 // templated on bytes-per-pixel to allow compiler optimizations, such
 // as unrolling loops and replacing multiplies with bitshifts
 template<unsigned int channels> struct LinearResampler_Byte {
-	static void scale(const PixelBox& src, const PixelBox& dst) {
+	static void scale(const PixelBox& src, const PixelBox& dst, size_t first, size_t last) {
 		// assert(src.format == dst.format);
 
 		// only optimized for 2D
 		if (src.getDepth() > 1 || dst.getDepth() > 1) {
-			LinearResampler::scale(src, dst);
+			LinearResampler::scale(src, dst, first, last);
 			return;
 		}
 
 		// srcdata stays at beginning of slice, pdst is a moving pointer
 		uchar* srcdata = (uchar*)src.data;
-		uchar* pdst = (uchar*)dst.data;
+		uchar* pdst = (uchar*)dst.data + channels*first*dst.rowPitch;
 
 		// sx_48,sy_48 represent current position in source
 		// using 16/48-bit fixed precision, incremented by steps
@@ -307,8 +307,8 @@ template<unsigned int channels> struct LinearResampler_Byte {
 		// fractional bits are the blend weight of the second sample
 		unsigned int temp;
 		
-		uint64 sy_48 = (stepy >> 1) - 1;
-		for (size_t y = dst.top; y < dst.bottom; y++, sy_48+=stepy) {
+		uint64 sy_48 = (stepy >> 1) - 1 + first*stepy;
+		for (size_t y = first; y < last; y++, sy_48+=stepy) {
 			temp = static_cast<unsigned int>(sy_48 >> 36);
 			temp = (temp > 0x800)? temp - 0x800: 0;
 			unsigned int syf = temp & 0xFFF;
@@ -341,6 +341,114 @@ template<unsigned int channels> struct LinearResampler_Byte {
 		}
 	}
 };
+
+// mipmap filters: separable kernels which halve one axis of rows of
+// PF_FLOAT32_RGBA pixels. Destination pixel i is the weighted sum of source
+// pixels 2*i+offset .. 2*i+offset+taps-1, clamped to the edges of the row.
+struct MipmapKernel {
+	int offset;
+	int taps;
+	float weights[8];
+
+	// the plain 2x2 average
+	static MipmapKernel box() {
+		MipmapKernel k;
+		k.offset = 0;
+		k.taps = 2;
+		k.weights[0] = k.weights[1] = 0.5f;
+		return k;
+	}
+
+	// Kaiser windowed sinc, 2 destination pixels wide with alpha 4; keeps
+	// more detail than the box filter in the smaller mipmaps
+	static MipmapKernel kaiser() {
+		MipmapKernel k;
+		k.offset = -3;
+		k.taps = 8;
+		const float width = 2.0f, alpha = 4.0f;
+		float sum = 0;
+		for (int i = 0; i < k.taps; i++) {
+			// distance between the centres, in destination pixels
+			float d = (k.offset + i - 0.5f) * 0.5f;
+			float pd = Math::PI * d;
+			float sinc = std::sin(pd) / pd;
+			float w = d / width;
+			k.weights[i] = sinc * besselI0(alpha * std::sqrt(std::max(0.0f, 1.0f - w * w))) / besselI0(alpha);
+			sum += k.weights[i];
+		}
+		for (int i = 0; i < k.taps; i++)
+			k.weights[i] /= sum;
+		return k;
+	}
+
+	static float besselI0(float x) {
+		// power series, converges quickly for the arguments used here
+		float sum = 1, term = 1, halfx = x * 0.5f;
+		for (int i = 1; i < 16; i++) {
+			term *= (halfx / i) * (halfx / i);
+			sum += term;
+		}
+		return sum;
+	}
+};
+
+// halves a row of srcwidth pixels into dstwidth pixels
+inline void mipmapFilterRow(const float* src, size_t srcwidth, float* dst, size_t dstwidth,
+	const MipmapKernel& kernel, bool sse) {
+	const ptrdiff_t last = (ptrdiff_t)srcwidth - 1;
+	for (size_t x = 0; x < dstwidth; x++, dst += 4) {
+		const ptrdiff_t first = (ptrdiff_t)(2 * x) + kernel.offset;
+#if __OGRE_HAVE_SSE
+		if (sse) {
+			__m128 accum = _mm_setzero_ps();
+			for (int k = 0; k < kernel.taps; k++) {
+				const ptrdiff_t sx = std::min(std::max(first + k, (ptrdiff_t)0), last);
+				accum = _mm_add_ps(accum, _mm_mul_ps(_mm_set1_ps(kernel.weights[k]), _mm_loadu_ps(src + sx * 4)));
+			}
+			_mm_storeu_ps(dst, accum);
+			continue;
+		}
+#endif
+		float r = 0, g = 0, b = 0, a = 0;
+		for (int k = 0; k < kernel.taps; k++) {
+			const float* psrc = src + std::min(std::max(first + k, (ptrdiff_t)0), last) * 4;
+			r += kernel.weights[k] * psrc[0];
+			g += kernel.weights[k] * psrc[1];
+			b += kernel.weights[k] * psrc[2];
+			a += kernel.weights[k] * psrc[3];
+		}
+		dst[0] = r; dst[1] = g; dst[2] = b; dst[3] = a;
+	}
+}
+
+// adds scale times the weighted sum of rows (one per tap, already clamped
+// by the caller) to a row of width pixels
+inline void mipmapFilterColumns(const float* const* rows, const MipmapKernel& kernel, float scale,
+	float* dst, size_t width, bool sse) {
+	float weights[8];
+	for (int k = 0; k < kernel.taps; k++)
+		weights[k] = kernel.weights[k] * scale;
+
+	const size_t count = width * 4;
+	size_t i = 0;
+#if __OGRE_HAVE_SSE
+	if (sse) {
+		for (; i < count; i += 4) {
+			__m128 accum = _mm_loadu_ps(dst + i);
+			for (int k = 0; k < kernel.taps; k++)
+				accum = _mm_add_ps(accum, _mm_mul_ps(_mm_set1_ps(weights[k]), _mm_loadu_ps(rows[k] + i)));
+			_mm_storeu_ps(dst + i, accum);
+		}
+	}
+#endif
+	for (; i < count; i++) {
+		float accum = dst[i];
+		for (int k = 0; k < kernel.taps; k++)
+			accum += weights[k] * rows[k][i];
+		dst[i] = accum;
+	}
+}
+
 /** @} */
 /** @} */
 
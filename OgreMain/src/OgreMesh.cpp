@@ -45,6 +45,10 @@ THE SOFTWARE.
 #include "OgreLodStrategyManager.h"
 #include "OgreLodConfig.h"
 #include "OgrePixelCountLodStrategy.h"
+#include "OgreMaterialManager.h"
+#include "OgreTechnique.h"
+#include "OgrePass.h"
+#include "OgreSubEntity.h"
 
 namespace Ogre {
     //-----------------------------------------------------------------------
@@ -104,6 +108,8 @@ namespace Ogre {
         mBoundRadius(0.0f),
         mBoneAssignmentsOutOfDate(false),
         mIsLodManual(false),
+        mLodStreaming(false),
+        mFullDetailEvicted(false),
         mNumLods(1),
         mVertexBufferUsage(HardwareBuffer::HBU_STATIC_WRITE_ONLY),
         mIndexBufferUsage(HardwareBuffer::HBU_STATIC_WRITE_ONLY),
@@ -266,6 +272,10 @@ namespace Ogre {
         // Transform user lod values (starting at index 1, no need to transform base value)
 		for (MeshLodUsageList::iterator i = mMeshLodUsageList.begin(); i != mMeshLodUsageList.end(); ++i)
             i->value = mLodStrategy->transformUserValue(i->userValue);
+
+        // LOD 0 is streamed in once it's displayed
+        if (isFullDetailStreamed())
+            _evictFullDetail();
 	}
 	//-----------------------------------------------------------------------
     void Mesh::prepareImpl()
@@ -278,8 +288,12 @@ namespace Ogre {
             ResourceGroupManager::getSingleton().openResource(
 				mName, mGroup, true, this);
  
-        // fully prebuffer into host RAM
-        mFreshFromDisk = DataStreamPtr(OGRE_NEW MemoryDataStream(mName,mFreshFromDisk));
+        // Fully prebuffer into host RAM, unless the stream is there already. Only
+        // FileSystem archives with memory mapping enabled provide such streams; plain
+        // FileSystem and Zip streams are copied here, so their loads are not zero-copy
+        // and only save the serializer's intermediate lock.
+        if (!mFreshFromDisk->size() || !mFreshFromDisk->peek(mFreshFromDisk->size()))
+            mFreshFromDisk = DataStreamPtr(OGRE_NEW MemoryDataStream(mName,mFreshFromDisk));
     }
     //-----------------------------------------------------------------------
     void Mesh::unprepareImpl()
@@ -343,6 +357,7 @@ namespace Ogre {
 
         // Removes reference to skeleton
         setSkeletonName(StringUtil::BLANK);
+        mFullDetailEvicted = false;
     }
 
     //-----------------------------------------------------------------------
@@ -374,6 +389,7 @@ namespace Ogre {
             newSub->operationType = (*subi)->operationType;
             newSub->useSharedVertices = (*subi)->useSharedVertices;
             newSub->extremityPoints = (*subi)->extremityPoints;
+            newSub->mClusters = (*subi)->mClusters;
 
             if (!(*subi)->useSharedVertices)
             {
@@ -419,6 +435,7 @@ namespace Ogre {
 
         newMesh->mLodStrategy = mLodStrategy;
 		newMesh->mIsLodManual = mIsLodManual;
+		newMesh->mLodStreaming = mLodStreaming;
 		newMesh->mNumLods = mNumLods;
 		newMesh->mMeshLodUsageList = mMeshLodUsageList;
         newMesh->mAutoBuildEdgeLists = mAutoBuildEdgeLists;
@@ -926,7 +943,20 @@ namespace Ogre {
     const MeshLodUsage& Mesh::getLodLevel(ushort index) const
     {
         index = std::min(index, (ushort)(mMeshLodUsageList.size() - 1));
-        if (mIsLodManual && index > 0 && mMeshLodUsageList[index].manualMesh.isNull())
+        if (mIsLodManual && index > 0 && index + 1u < mMeshLodUsageList.size() &&
+            mMeshLodUsageList[index].manualMesh.isNull() && mLodStreaming)
+        {
+            // Only create the mesh, it's loaded in the background when displayed.
+            // The coarsest level is the fallback for all others, it's loaded now.
+            String groupName = mMeshLodUsageList[index].manualGroup.empty() ? 
+                mGroup : mMeshLodUsageList[index].manualGroup;
+            MeshPtr lodMesh = MeshManager::getSingleton().createOrRetrieve(
+                mMeshLodUsageList[index].manualName, groupName).first;
+            if (!lodMesh->isLoaded())
+                lodMesh->setBackgroundLoaded(true);
+            mMeshLodUsageList[index].manualMesh = lodMesh;
+        }
+        else if (mIsLodManual && index > 0 && mMeshLodUsageList[index].manualMesh.isNull())
         {
             // Load the mesh now
 			try {
@@ -955,6 +985,175 @@ namespace Ogre {
         }
         return mMeshLodUsageList[index];
     }
+    //---------------------------------------------------------------------
+    void Mesh::setLodStreaming(bool stream)
+    {
+        if (stream && !mLodStreaming)
+        {
+            // Edge lists of streamed levels belong to meshes which may be unloaded,
+            // so they're fetched from the LOD mesh each time instead of cached
+            for (size_t i = 1; mIsLodManual && i < mMeshLodUsageList.size(); ++i)
+                mMeshLodUsageList[i].edgeData = 0;
+        }
+        mLodStreaming = stream;
+
+        if (!isLoaded())
+            return;
+        if (isFullDetailStreamed())
+            _evictFullDetail();
+        else if (mFullDetailEvicted)
+            reload();
+    }
+    //---------------------------------------------------------------------
+    bool Mesh::isFullDetailStreamed(void) const
+    {
+        // Animation and shadow volume data refer to the geometry
+        return mLodStreaming && mIsLodManual && mMeshLodUsageList.size() > 1 &&
+            (!mIsManual || mLoader) && !hasSkeleton() && 
+            mAnimationsList.empty() && mPoseList.empty();
+    }
+    //---------------------------------------------------------------------
+    bool Mesh::isLodLevelResident(ushort index) const
+    {
+        index = std::min(index, (ushort)(mMeshLodUsageList.size() - 1));
+        if (index == 0)
+            return !mFullDetailEvicted;
+        if (!mIsLodManual)
+            return true;
+        const MeshPtr& lodMesh = mMeshLodUsageList[index].manualMesh;
+        return !lodMesh.isNull() && lodMesh->isLoaded();
+    }
+    //---------------------------------------------------------------------
+    bool Mesh::touchLodLevel(ushort index) const
+    {
+        if (index == 0)
+        {
+            if (!isFullDetailStreamed())
+                return !mFullDetailEvicted;
+            if (mFullDetailMesh.isNull())
+            {
+                mFullDetailMesh = MeshManager::getSingleton()._createFullDetailMesh(
+                    const_cast<Mesh*>(this), mIsManual ? mLoader : 0);
+            }
+            return MeshManager::getSingleton()._touchStreamedLod(mFullDetailMesh);
+        }
+
+        // The coarsest level is loaded by getLodLevel and never streamed out
+        const MeshLodUsage& usage = getLodLevel(index);
+        if (index + 1u == mMeshLodUsageList.size())
+            return true;
+        return MeshManager::getSingleton()._touchStreamedLod(usage.manualMesh);
+    }
+    //---------------------------------------------------------------------
+    ushort Mesh::_requestLodLevel(ushort index) const
+    {
+        index = std::min(index, (ushort)(mMeshLodUsageList.size() - 1));
+        if (!mLodStreaming || !mIsLodManual || touchLodLevel(index))
+            return index;
+
+        // Display the nearest coarser level in memory meanwhile, the coarsest
+        // level always is
+        ushort coarsest = static_cast<ushort>(mMeshLodUsageList.size() - 1);
+        for (ushort i = index + 1; i < coarsest; ++i)
+        {
+            if (isLodLevelResident(i) && touchLodLevel(i))
+                return i;
+        }
+        touchLodLevel(coarsest);
+        return coarsest;
+    }
+    //---------------------------------------------------------------------
+    bool Mesh::_adoptFullDetail(Mesh* source)
+    {
+        if (!mFullDetailEvicted)
+            return true;
+
+        bool matches = source->mSubMeshList.size() == mSubMeshList.size() &&
+            (source->sharedVertexData != 0) == (sharedVertexData != 0);
+        for (size_t i = 0; matches && i < mSubMeshList.size(); ++i)
+            matches = source->mSubMeshList[i]->useSharedVertices == mSubMeshList[i]->useSharedVertices;
+        if (!matches)
+        {
+            LogManager::getSingleton().logMessage("Mesh: Streamed geometry of " + mName +
+                " doesn't match the mesh, LOD 0 will not be rendered.");
+            return false;
+        }
+
+        // What's left in the source is unloaded with it
+        std::swap(sharedVertexData, source->sharedVertexData);
+        SubMeshList::iterator i, iend;
+        iend = mSubMeshList.end();
+        for (i = mSubMeshList.begin(); i != iend; ++i)
+        {
+            SubMesh* s = *i;
+            SubMesh* sourceSub = source->mSubMeshList[i - mSubMeshList.begin()];
+            if (!s->useSharedVertices)
+                std::swap(s->vertexData, sourceSub->vertexData);
+            std::swap(s->indexData, sourceSub->indexData);
+        }
+        mFullDetailEvicted = false;
+
+        // Redo what was done to the geometry at load time
+        if (mPreparedForShadowVolumes && !source->mPreparedForShadowVolumes)
+        {
+            mPreparedForShadowVolumes = false;
+            prepareForShadowVolume();
+        }
+        if (mEdgeListsBuilt)
+        {
+            if (source->mEdgeListsBuilt)
+            {
+                std::swap(mMeshLodUsageList[0].edgeData, source->mMeshLodUsageList[0].edgeData);
+            }
+            else
+            {
+                mEdgeListsBuilt = false;
+                buildEdgeList();
+            }
+        }
+        _dirtyState();
+        return true;
+    }
+    //---------------------------------------------------------------------
+    void Mesh::_evictFullDetail(void)
+    {
+        if (mFullDetailEvicted)
+            return;
+
+        // The edge list refers to the geometry, it comes back with it
+        if (mEdgeListsBuilt)
+        {
+            OGRE_DELETE mMeshLodUsageList[0].edgeData;
+            mMeshLodUsageList[0].edgeData = 0;
+        }
+        if (sharedVertexData)
+        {
+            OGRE_DELETE sharedVertexData;
+            sharedVertexData = OGRE_NEW VertexData();
+        }
+        SubMeshList::iterator i, iend;
+        iend = mSubMeshList.end();
+        for (i = mSubMeshList.begin(); i != iend; ++i)
+        {
+            SubMesh* s = *i;
+            if (!s->useSharedVertices)
+            {
+                OGRE_DELETE s->vertexData;
+                s->vertexData = OGRE_NEW VertexData();
+            }
+            OGRE_DELETE s->indexData;
+            s->indexData = OGRE_NEW IndexData();
+        }
+        mFullDetailEvicted = true;
+
+        // Entities let go of the geometry
+        _dirtyState();
+    }
+    //---------------------------------------------------------------------
+    size_t Mesh::_getFullDetailSize(void) const
+    {
+        return mFullDetailEvicted ? 0 : calculateSize();
+    }
     //---------------------------------------------------------------------
 	void Mesh::createManualLodLevel(Real lodValue, const String& meshName, const String& groupName)
 	{
@@ -1488,13 +1687,17 @@ namespace Ogre {
             // use getLodLevel to enforce loading of manual mesh lods
             MeshLodUsage& usage = const_cast<MeshLodUsage&>(getLodLevel(lodIndex));
 
+            // Built once the geometry is streamed in
+            if (lodIndex == 0 && mFullDetailEvicted)
+                continue;
+
 			bool atLeastOneIndexSet = false;
 
             if (mIsLodManual && lodIndex != 0)
             {
                 // Delegate edge building to manual mesh
                 // It should have already built it's own edge list while loading
-				if (!usage.manualMesh.isNull())
+				if (!usage.manualMesh.isNull() && !mLodStreaming)
 				{
 					usage.edgeData = usage.manualMesh->getEdgeList(0);
 				}
@@ -1606,11 +1809,132 @@ namespace Ogre {
         mEdgeListsBuilt = false;
     }
     //---------------------------------------------------------------------
+    void Mesh::optimiseVertexCache(bool reorderVertices)
+    {
+        bool rebuildEdges = mEdgeListsBuilt;
+        freeEdgeList();
+
+        // Dedicated geometry first, collecting every user of the shared vertices
+        vector<IndexData*>::type sharedIndexData;
+        bool sharedIndexed = true;
+        SubMeshList::iterator i, iend;
+        iend = mSubMeshList.end();
+        for (i = mSubMeshList.begin(); i != iend; ++i)
+        {
+            SubMesh* sm = *i;
+            sm->optimiseVertexCacheImpl(reorderVertices);
+            if (sm->useSharedVertices)
+                sharedIndexed = sm->getIndexDataForAllLods(sharedIndexData) && sharedIndexed;
+        }
+
+        if (reorderVertices && sharedVertexData && sharedIndexed && !sharedIndexData.empty() &&
+            getSharedVertexDataAnimationType() == VAT_NONE && mPoseList.empty() &&
+            !mPreparedForShadowVolumes)
+        {
+            vector<uint32>::type vertexRemap;
+            sharedVertexData->optimiseVertexFetch(sharedIndexData, vertexRemap);
+            SubMesh::remapBoneAssignments(mBoneAssignments, vertexRemap);
+        }
+
+        if (rebuildEdges)
+            buildEdgeList();
+    }
+    //---------------------------------------------------------------------
+    namespace
+    {
+        /// Whether a vertex program parameter set binds the given custom parameter
+        bool bindsCustomParameter(const GpuProgramParametersSharedPtr& params, size_t index)
+        {
+            GpuProgramParameters::AutoConstantIterator ai = params->getAutoConstantIterator();
+            while (ai.hasMoreElements())
+            {
+                const GpuProgramParameters::AutoConstantEntry& entry = ai.getNext();
+                if (entry.paramType == GpuProgramParameters::ACT_CUSTOM && entry.data == index)
+                    return true;
+            }
+            return false;
+        }
+    }
+    //---------------------------------------------------------------------
+    bool Mesh::materialDequantisesPositions(const String& materialName) const
+    {
+        MaterialPtr material = MaterialManager::getSingleton().getByName(materialName, mGroup);
+        if (material.isNull() || material->getNumTechniques() == 0)
+            return false;
+
+        // Every technique may end up being used, fixed function fallbacks included
+        for (unsigned short t = 0; t < material->getNumTechniques(); ++t)
+        {
+            Technique* tech = material->getTechnique(t);
+            for (unsigned short p = 0; p < tech->getNumPasses(); ++p)
+            {
+                const Pass* pass = tech->getPass(p);
+                if (!pass->hasVertexProgram())
+                    return false;
+                GpuProgramParametersSharedPtr params = pass->getVertexProgramParameters();
+                if (!bindsCustomParameter(params, SubEntity::CUSTOM_PARAM_POSITION_SCALE) ||
+                    !bindsCustomParameter(params, SubEntity::CUSTOM_PARAM_POSITION_BIAS))
+                    return false;
+            }
+        }
+        return true;
+    }
+    //---------------------------------------------------------------------
+    bool Mesh::quantiseVertexData(bool positions, bool normals, bool textureCoordinates)
+    {
+        // Software skinning, keyframes and shadow volume extrusion all work on floats
+        if (hasSkeleton() || !mPoseList.empty() || mPreparedForShadowVolumes)
+            return false;
+
+        // Positions stay float unless every material drawing them undoes the quantisation
+        bool sharedPositions = positions;
+        SubMeshList::iterator i, iend;
+        iend = mSubMeshList.end();
+        for (i = mSubMeshList.begin(); i != iend; ++i)
+        {
+            SubMesh* sm = *i;
+            if (sm->useSharedVertices && sharedPositions && !materialDequantisesPositions(sm->getMaterialName()))
+            {
+                LogManager::getSingleton().logMessage("Mesh " + mName + ": keeping float positions, material " +
+                    sm->getMaterialName() + " doesn't apply the position scale and bias in every pass.");
+                sharedPositions = false;
+            }
+        }
+
+        bool converted = false;
+        if (sharedVertexData && getSharedVertexDataAnimationType() == VAT_NONE)
+            converted = sharedVertexData->quantise(sharedPositions, normals, textureCoordinates);
+
+        for (i = mSubMeshList.begin(); i != iend; ++i)
+        {
+            SubMesh* sm = *i;
+            if (!sm->useSharedVertices && sm->vertexData && sm->getVertexAnimationType() == VAT_NONE)
+            {
+                bool subMeshPositions = positions;
+                if (subMeshPositions && !materialDequantisesPositions(sm->getMaterialName()))
+                {
+                    LogManager::getSingleton().logMessage("Mesh " + mName + ": keeping float positions, material " +
+                        sm->getMaterialName() + " doesn't apply the position scale and bias in every pass.");
+                    subMeshPositions = false;
+                }
+                converted = sm->vertexData->quantise(subMeshPositions, normals, textureCoordinates) || converted;
+            }
+        }
+        return converted;
+    }
+    //---------------------------------------------------------------------
     void Mesh::prepareForShadowVolume(void)
     {
         if (mPreparedForShadowVolumes)
             return;
 
+        // The geometry is prepared once it's streamed in
+        if (mFullDetailEvicted)
+        {
+            mPreparedForShadowVolumes = true;
+            return;
+        }
+
         if (sharedVertexData)
         {
             sharedVertexData->prepareForShadowVolume();
@@ -1639,12 +1963,21 @@ namespace Ogre {
             buildEdgeList();
         }
 
-        return getLodLevel(lodIndex).edgeData;
+        const MeshLodUsage& usage = getLodLevel(lodIndex);
+        if (mLodStreaming && mIsLodManual && lodIndex > 0)
+            return isLodLevelResident(lodIndex) ? usage.manualMesh->getEdgeList(0) : 0;
+        return usage.edgeData;
     }
     //---------------------------------------------------------------------
     const EdgeData* Mesh::getEdgeList(unsigned short lodIndex) const
     {
-        return getLodLevel(lodIndex).edgeData;
+        const MeshLodUsage& usage = getLodLevel(lodIndex);
+        if (mLodStreaming && mIsLodManual && lodIndex > 0)
+        {
+            return isLodLevelResident(lodIndex) ?
+                static_cast<const Mesh*>(usage.manualMesh.get())->getEdgeList(0) : 0;
+        }
+        return usage.edgeData;
     }
     //---------------------------------------------------------------------
     void Mesh::prepareMatricesForVertexBlend(const Matrix4** blendMatrices,
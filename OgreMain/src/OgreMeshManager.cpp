@@ -40,6 +40,10 @@ THE SOFTWARE.
 #include "OgreException.h"
 
 #include "OgrePrefabFactory.h"
+#include "OgreRoot.h"
+#include "OgreLogManager.h"
+#include "OgreEntity.h"
+#include "OgreMeshSerializer.h"
 
 namespace Ogre
 {
@@ -55,7 +59,8 @@ namespace Ogre
     }
     //-----------------------------------------------------------------------
     MeshManager::MeshManager():
-    mBoundsPaddingFactor(0.01), mListener(0)
+    mBoundsPaddingFactor(0.01), mListener(0),
+    mLodStreamingBudget(std::numeric_limits<size_t>::max())
     {
         mPrepAllMeshesForShadowVolumes = false;
 
@@ -68,6 +73,8 @@ namespace Ogre
     //-----------------------------------------------------------------------
     MeshManager::~MeshManager()
     {
+        // Release the streamed LOD meshes before the resources are removed
+        mStreamedLods.clear();
         ResourceGroupManager::getSingleton()._unregisterResourceManager(mResourceType);
     }
     //-----------------------------------------------------------------------
@@ -386,6 +393,26 @@ namespace Ogre
 	{
 		Mesh* msh = static_cast<Mesh*>(res);
 
+		// Geometry of LOD 0 of a streamed mesh, read from the mesh's own file
+		std::pair<String, String> fullDetailSource;
+		{
+			OGRE_LOCK_MUTEX(mFullDetailSourcesMutex)
+			FullDetailSourceMap::iterator src = mFullDetailSources.find(res);
+			if (src != mFullDetailSources.end())
+				fullDetailSource = src->second;
+		}
+		if (!fullDetailSource.first.empty())
+		{
+			DataStreamPtr stream = ResourceGroupManager::getSingleton().openResource(
+				fullDetailSource.first, fullDetailSource.second, true, msh);
+			if (!stream->size() || !stream->peek(stream->size()))
+				stream = DataStreamPtr(OGRE_NEW MemoryDataStream(fullDetailSource.first, stream));
+			MeshSerializer serializer;
+			serializer.setListener(mListener);
+			serializer.importMesh(stream, msh);
+			return;
+		}
+
 		// attempt to create a prefab mesh
 		bool createdPrefab = PrefabFactory::createPrefab(msh);
 
@@ -964,6 +991,228 @@ namespace Ogre
         mBoundsPaddingFactor = paddingFactor;
     }
     //-----------------------------------------------------------------------
+    void MeshManager::removeAll(void)
+    {
+        // The streamed LOD meshes must not outlive the other managers
+        mStreamedLods.clear();
+        {
+            OGRE_LOCK_MUTEX(mFullDetailSourcesMutex)
+            mFullDetailSources.clear();
+        }
+        ResourceManager::removeAll();
+    }
+    //-----------------------------------------------------------------------
+    void MeshManager::removeImpl(ResourcePtr& res)
+    {
+        // The mesh LOD 0 is streamed through goes along
+        ResourcePtr fullDetailMesh;
+        for (StreamedLodMap::iterator i = mStreamedLods.begin(); i != mStreamedLods.end(); ++i)
+        {
+            if (i->second.fullDetailOf == res.get())
+            {
+                fullDetailMesh = i->second.mesh;
+                break;
+            }
+        }
+
+        mStreamedLods.erase(res->getHandle());
+        {
+            OGRE_LOCK_MUTEX(mFullDetailSourcesMutex)
+            mFullDetailSources.erase(res.get());
+        }
+        ResourceManager::removeImpl(res);
+
+        if (!fullDetailMesh.isNull())
+            removeImpl(fullDetailMesh);
+    }
+    //-----------------------------------------------------------------------
+    void MeshManager::setLodStreamingBudget(size_t bytes)
+    {
+        mLodStreamingBudget = bytes;
+        enforceLodStreamingBudget();
+    }
+    //-----------------------------------------------------------------------
+    size_t MeshManager::getLodStreamingMemoryUsage(void) const
+    {
+        size_t usage = 0;
+        for (StreamedLodMap::const_iterator i = mStreamedLods.begin(); i != mStreamedLods.end(); ++i)
+        {
+            if (i->second.streamedIn && isStreamedLodResident(i->second))
+                usage += getStreamedLodSize(i->second);
+        }
+        return usage;
+    }
+    //-----------------------------------------------------------------------
+    void MeshManager::_updateLodStreaming(void)
+    {
+        for (StreamedLodMap::iterator i = mStreamedLods.begin(); i != mStreamedLods.end(); ++i)
+            checkStreamedLodLoad(i->second);
+        enforceLodStreamingBudget();
+    }
+    //-----------------------------------------------------------------------
+    void MeshManager::_addStreamedLodEntity(Entity* lodEntity)
+    {
+        getStreamedLod(lodEntity->getMesh()).entities.insert(lodEntity);
+    }
+    //-----------------------------------------------------------------------
+    void MeshManager::_removeStreamedLodEntity(Entity* lodEntity)
+    {
+        StreamedLodMap::iterator i = mStreamedLods.find(lodEntity->getMesh()->getHandle());
+        if (i != mStreamedLods.end())
+            i->second.entities.erase(lodEntity);
+    }
+    //-----------------------------------------------------------------------
+    MeshManager::StreamedLod& MeshManager::getStreamedLod(const MeshPtr& lodMesh)
+    {
+        StreamedLodMap::iterator i = mStreamedLods.find(lodMesh->getHandle());
+        if (i == mStreamedLods.end())
+        {
+            StreamedLod lod;
+            lod.mesh = lodMesh;
+            lod.lastUsedFrame = 0;
+            lod.ticket = 0;
+            lod.failed = false;
+            lod.streamedIn = false;
+            lod.fullDetailOf = 0;
+            i = mStreamedLods.insert(StreamedLodMap::value_type(lodMesh->getHandle(), lod)).first;
+        }
+        return i->second;
+    }
+    //-----------------------------------------------------------------------
+    bool MeshManager::checkStreamedLodLoad(StreamedLod& lod)
+    {
+        // The mesh may be loaded before the response comes back
+        if (!lod.ticket || (!lod.mesh->isLoaded() &&
+            !ResourceBackgroundQueue::getSingleton().isProcessComplete(lod.ticket)))
+            return false;
+
+        lod.ticket = 0;
+        finishStreamedLodLoad(lod);
+        return true;
+    }
+    //-----------------------------------------------------------------------
+    void MeshManager::finishStreamedLodLoad(StreamedLod& lod)
+    {
+        bool loaded = lod.mesh->isLoaded();
+        if (loaded && lod.fullDetailOf)
+        {
+            // The geometry moves over to the mesh displaying it
+            loaded = lod.fullDetailOf->_adoptFullDetail(lod.mesh.get());
+            lod.mesh->unload();
+        }
+
+        if (loaded)
+        {
+            lod.streamedIn = true;
+        }
+        else
+        {
+            lod.failed = true;
+            LogManager::getSingleton().stream()
+                << "Error while streaming LOD mesh " << lod.mesh->getName()
+                << " - this LOD level will not be rendered.";
+        }
+    }
+    //-----------------------------------------------------------------------
+    bool MeshManager::isStreamedLodResident(const StreamedLod& lod) const
+    {
+        if (!lod.fullDetailOf)
+            return lod.mesh->isLoaded();
+        return lod.fullDetailOf->isLoaded() && lod.fullDetailOf->isFullDetailStreamed() &&
+            lod.fullDetailOf->isLodLevelResident(0);
+    }
+    //-----------------------------------------------------------------------
+    size_t MeshManager::getStreamedLodSize(const StreamedLod& lod) const
+    {
+        return lod.fullDetailOf ? lod.fullDetailOf->_getFullDetailSize() : lod.mesh->getSize();
+    }
+    //-----------------------------------------------------------------------
+    MeshPtr MeshManager::_createFullDetailMesh(Mesh* mesh, ManualResourceLoader* loader)
+    {
+        // Without a loader of its own the mesh comes from a file, which is read again
+        MeshPtr fullDetailMesh = createManual(mesh->getName() + "/FullDetail", mesh->getGroup(),
+            loader ? loader : this);
+        if (!loader)
+        {
+            OGRE_LOCK_MUTEX(mFullDetailSourcesMutex)
+            mFullDetailSources[fullDetailMesh.get()] = std::make_pair(mesh->getName(), mesh->getGroup());
+        }
+        // Edge lists are built by the mesh taking over the geometry, if it uses them
+        fullDetailMesh->setAutoBuildEdgeLists(false);
+        getStreamedLod(fullDetailMesh).fullDetailOf = mesh;
+        return fullDetailMesh;
+    }
+    //-----------------------------------------------------------------------
+    bool MeshManager::_touchStreamedLod(const MeshPtr& lodMesh)
+    {
+        StreamedLod& lod = getStreamedLod(lodMesh);
+        Root* root = Root::getSingletonPtr();
+        lod.lastUsedFrame = root ? root->getNextFrameNumber() : 0;
+
+        // Loaded memory has grown
+        if (checkStreamedLodLoad(lod))
+            enforceLodStreamingBudget();
+
+        if (isStreamedLodResident(lod))
+            return true;
+
+        if (!lod.ticket && !lod.failed)
+        {
+            lod.ticket = ResourceBackgroundQueue::getSingleton().load(
+                mResourceType, lodMesh->getName(), lodMesh->getGroup());
+            // Loaded right away without thread support
+            if (!lod.ticket && lodMesh->isLoaded())
+            {
+                finishStreamedLodLoad(lod);
+                enforceLodStreamingBudget();
+                return isStreamedLodResident(lod);
+            }
+        }
+        return false;
+    }
+    //-----------------------------------------------------------------------
+    void MeshManager::enforceLodStreamingBudget(void)
+    {
+        size_t usage = getLodStreamingMemoryUsage();
+        if (usage <= mLodStreamingBudget)
+            return;
+
+        // Never evict what was needed in this or the previous frame, it's on screen
+        Root* root = Root::getSingletonPtr();
+        unsigned long frame = root ? root->getNextFrameNumber() : 0;
+        typedef std::pair<unsigned long, StreamedLod*> Candidate;
+        vector<Candidate>::type candidates;
+        for (StreamedLodMap::iterator i = mStreamedLods.begin(); i != mStreamedLods.end(); ++i)
+        {
+            StreamedLod& lod = i->second;
+            if (lod.streamedIn && isStreamedLodResident(lod) && lod.lastUsedFrame + 1 < frame)
+                candidates.push_back(Candidate(lod.lastUsedFrame, &lod));
+        }
+        std::sort(candidates.begin(), candidates.end());
+
+        for (vector<Candidate>::type::iterator c = candidates.begin();
+            c != candidates.end() && usage > mLodStreamingBudget; ++c)
+        {
+            StreamedLod& lod = *c->second;
+            size_t size = getStreamedLodSize(lod);
+            if (lod.fullDetailOf)
+            {
+                // Its entities are initialised again without the geometry
+                lod.fullDetailOf->_evictFullDetail();
+            }
+            else
+            {
+                // The entities must let go of the submeshes first, their parent
+                // entities initialise them again once the level is displayed
+                for (set<Entity*>::type::iterator e = lod.entities.begin(); e != lod.entities.end(); ++e)
+                    (*e)->_deinitialise();
+                lod.mesh->unload();
+            }
+            lod.streamedIn = false;
+            usage -= std::min(usage, size);
+        }
+    }
+    //-----------------------------------------------------------------------
     Resource* MeshManager::createImpl(const String& name, ResourceHandle handle, 
         const String& group, bool isManual, ManualResourceLoader* loader, 
         const NameValuePairList* createParams)
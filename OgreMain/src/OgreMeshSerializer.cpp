@@ -48,9 +48,13 @@ namespace Ogre {
 		
 		// Note MUST be added in reverse order so latest is first in the list
 		mVersionData.push_back(OGRE_NEW MeshVersionData(
-			MESH_VERSION_1_8, "[MeshSerializer_v1.8]", 
+			MESH_VERSION_1_10, "[MeshSerializer_v1.100]", 
 			OGRE_NEW MeshSerializerImpl()));
 
+		mVersionData.push_back(OGRE_NEW MeshVersionData(
+			MESH_VERSION_1_8, "[MeshSerializer_v1.8]", 
+			OGRE_NEW MeshSerializerImpl_v1_8()));
+
 		mVersionData.push_back(OGRE_NEW MeshVersionData(
 			MESH_VERSION_1_7, "[MeshSerializer_v1.41]", 
 			OGRE_NEW MeshSerializerImpl_v1_41()));
@@ -45,6 +45,7 @@ THE SOFTWARE.
 #include "OgreRoot.h"
 #include "OgreLodStrategyManager.h"
 #include "OgreDistanceLodStrategy.h"
+#include "OgreParallelFor.h"
 
 #if OGRE_COMPILER == OGRE_COMPILER_MSVC
 // Disable conversion warnings, we do a lot of them, intentionally
@@ -58,10 +59,11 @@ namespace Ogre {
     const long MSTREAM_OVERHEAD_SIZE = sizeof(uint16) + sizeof(uint32);
     //---------------------------------------------------------------------
     MeshSerializerImpl::MeshSerializerImpl()
+        : mDeferPayloads(false)
     {
 
         // Version number
-        mVersion = "[MeshSerializer_v1.8]";
+        mVersion = "[MeshSerializer_v1.100]";
     }
     //---------------------------------------------------------------------
     MeshSerializerImpl::~MeshSerializerImpl()
@@ -110,18 +112,32 @@ namespace Ogre {
         // Check header
         readFileHeader(stream);
 
-        unsigned short streamID;
-        while(!stream->eof())
+        // With the whole mesh in memory the buffer payloads are only located while
+        // reading, and decoded concurrently afterwards
+        mDeferPayloads = stream->peek(stream->size() - stream->tell()) != 0;
+        try
         {
-            streamID = readChunk(stream);
-            switch (streamID)
+            unsigned short streamID;
+            while(!stream->eof())
             {
-            case M_MESH:
-                readMesh(stream, pMesh, listener);
-                break;
-			}
+                streamID = readChunk(stream);
+                switch (streamID)
+                {
+                case M_MESH:
+                    readMesh(stream, pMesh, listener);
+                    break;
+                }
 
+            }
+            decodePayloads(pMesh);
         }
+        catch (...)
+        {
+            clearPayloads();
+            mDeferPayloads = false;
+            throw;
+        }
+        mDeferPayloads = false;
     }
     //---------------------------------------------------------------------
     void MeshSerializerImpl::writeMesh(const Mesh* pMesh)
@@ -281,6 +297,9 @@ namespace Ogre {
         // Operation type
         writeSubMeshOperation(s);
 
+        // Triangle clusters (optional)
+        writeSubMeshClusters(s);
+
         // Bone assignments
         if (!s->mBoneAssignments.empty())
         {
@@ -363,6 +382,34 @@ namespace Ogre {
 		LogManager::getSingleton().logMessage("Submesh texture aliases exported.");
     }
 
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl::writeSubMeshClusters(const SubMesh* s)
+    {
+        const SubMesh::TriangleClusterList& clusters = s->getClusters();
+        if (clusters.empty())
+            return;
+
+        writeChunkHeader(M_SUBMESH_CLUSTERS, calcSubMeshClustersSize(s));
+
+        // unsigned int clusterCount
+        unsigned int clusterCount = static_cast<unsigned int>(clusters.size());
+        writeInts(&clusterCount, 1);
+
+        for (SubMesh::TriangleClusterList::const_iterator i = clusters.begin();
+             i != clusters.end(); ++i)
+        {
+            // unsigned int indexStart, indexCount
+            uint32 range[2] = { i->indexStart, i->indexCount };
+            writeInts(range, 2);
+            // float center[3], radius, coneAxis[3], coneCutoff
+            float bounds[8] = {
+                static_cast<float>(i->center.x), static_cast<float>(i->center.y),
+                static_cast<float>(i->center.z), static_cast<float>(i->radius),
+                static_cast<float>(i->coneAxis.x), static_cast<float>(i->coneAxis.y),
+                static_cast<float>(i->coneAxis.z), static_cast<float>(i->coneCutoff) };
+            writeFloats(bounds, 8);
+        }
+    }
     //---------------------------------------------------------------------
     void MeshSerializerImpl::writeSubMeshOperation(const SubMesh* sm)
     {
@@ -391,6 +438,10 @@ namespace Ogre {
 			const HardwareVertexBufferSharedPtr& vbuf = vbi->second;
 			size += (MSTREAM_OVERHEAD_SIZE * 2) + (sizeof(unsigned short) * 2) + vbuf->getSizeInBytes();
 		}
+		const VertexElement* posElem = vertexData->vertexDeclaration->findElementBySemantic(VES_POSITION);
+		const bool quantised = posElem && posElem->getType() == VET_SHORT4_SNORM;
+		if (quantised)
+			size += MSTREAM_OVERHEAD_SIZE + sizeof(float) * 6;
 
 		// Header
         writeChunkHeader(M_GEOMETRY, size);
@@ -468,6 +519,13 @@ namespace Ogre {
             vbuf->unlock();
 		}
 
+		// Transform back from quantised positions
+		if (quantised)
+		{
+			writeChunkHeader(M_GEOMETRY_VERTEX_QUANTISATION, MSTREAM_OVERHEAD_SIZE + sizeof(float) * 6);
+			writeFloats(vertexData->positionScale.ptr(), 3);
+			writeFloats(vertexData->positionBias.ptr(), 3);
+		}
 
     }
     //---------------------------------------------------------------------
@@ -564,6 +622,7 @@ namespace Ogre {
 
         size += calcSubMeshTextureAliasesSize(pSub);
         size += calcSubMeshOperationSize(pSub);
+        size += calcSubMeshClustersSize(pSub);
 
         // Bone assignments
         if (!pSub->mBoneAssignments.empty())
@@ -599,6 +658,16 @@ namespace Ogre {
         return chunkSize;
     }
     //---------------------------------------------------------------------
+    size_t MeshSerializerImpl::calcSubMeshClustersSize(const SubMesh* pSub)
+    {
+        const size_t clusterCount = pSub->getClusters().size();
+        if (clusterCount == 0)
+            return 0;
+
+        return MSTREAM_OVERHEAD_SIZE + sizeof(unsigned int) +
+            clusterCount * (sizeof(uint32) * 2 + sizeof(float) * 8);
+    }
+    //---------------------------------------------------------------------
     size_t MeshSerializerImpl::calcGeometrySize(const VertexData* vertexData)
     {
         size_t size = MSTREAM_OVERHEAD_SIZE;
@@ -623,6 +692,10 @@ namespace Ogre {
             // Vertex element
             size += VertexElement::getTypeSize(elem.getType()) * vertexData->vertexCount;
         }
+
+        const VertexElement* posElem = vertexData->vertexDeclaration->findElementBySemantic(VES_POSITION);
+        if (posElem && posElem->getType() == VET_SHORT4_SNORM)
+            size += MSTREAM_OVERHEAD_SIZE + sizeof(float) * 6;
         return size;
     }
     //---------------------------------------------------------------------
@@ -642,7 +715,8 @@ namespace Ogre {
             unsigned short streamID = readChunk(stream);
             while(!stream->eof() &&
                 (streamID == M_GEOMETRY_VERTEX_DECLARATION ||
-                 streamID == M_GEOMETRY_VERTEX_BUFFER ))
+                 streamID == M_GEOMETRY_VERTEX_BUFFER ||
+                 streamID == M_GEOMETRY_VERTEX_QUANTISATION ))
             {
                 switch (streamID)
                 {
@@ -652,6 +726,9 @@ namespace Ogre {
                 case M_GEOMETRY_VERTEX_BUFFER:
                     readGeometryVertexBuffer(stream, pMesh, dest);
                     break;
+                case M_GEOMETRY_VERTEX_QUANTISATION:
+                    readGeometryVertexQuantisation(stream, pMesh, dest);
+                    break;
                 }
                 // Get next stream
                 if (!stream->eof())
@@ -666,7 +743,16 @@ namespace Ogre {
             }
         }
 
-		// Perform any necessary colour conversion for an active rendersystem
+		// Perform any necessary colour conversion for an active rendersystem,
+		// which needs the buffers filled
+		if (mDeferPayloads)
+			mColourConversions.push_back(dest);
+		else
+			convertPackedColours(dest);
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl::convertPackedColours(VertexData* dest)
+    {
 		if (Root::getSingletonPtr() && Root::getSingleton().getRenderSystem())
 		{
 			// We don't know the source type if it's VET_COLOUR, but assume ARGB
@@ -677,6 +763,15 @@ namespace Ogre {
 		}
     }
     //---------------------------------------------------------------------
+    void MeshSerializerImpl::readGeometryVertexQuantisation(DataStreamPtr& stream,
+        Mesh* pMesh, VertexData* dest)
+    {
+        // float positionScale[3];
+        readFloats(stream, dest->positionScale.ptr(), 3);
+        // float positionBias[3];
+        readFloats(stream, dest->positionBias.ptr(), 3);
+    }
+    //---------------------------------------------------------------------
     void MeshSerializerImpl::readGeometryVertexDeclaration(DataStreamPtr& stream,
         Mesh* pMesh, VertexData* dest)
     {
@@ -763,6 +858,15 @@ namespace Ogre {
             	"MeshSerializerImpl::readGeometryVertexBuffer");
 		}
 
+		if (mDeferPayloads)
+		{
+			PayloadJob& job = deferPayload(stream, PayloadJob::PT_VERTEX_BUFFER,
+				dest->vertexCount * vertexSize);
+			job.vertexData = dest;
+			job.bindIndex = bindIndex;
+			return;
+		}
+
 		// Create / populate vertex buffer
 		HardwareVertexBufferSharedPtr vbuf;
         vbuf = HardwareBufferManager::getSingleton().createVertexBuffer(
@@ -958,7 +1062,14 @@ namespace Ogre {
         // bool indexes32Bit
         bool idx32bit;
         readBools(stream, &idx32bit, 1);
-        if (indexCount > 0)
+        if (indexCount > 0 && mDeferPayloads)
+        {
+            PayloadJob& job = deferPayload(stream, PayloadJob::PT_INDEX_BUFFER,
+                indexCount * (idx32bit ? sizeof(uint32) : sizeof(uint16)));
+            job.indexData = sm->indexData;
+            job.wideOrNormals = idx32bit;
+        }
+        else if (indexCount > 0)
         {
             if (idx32bit)
             {
@@ -1015,10 +1126,14 @@ namespace Ogre {
             while(!stream->eof() &&
                 (streamID == M_SUBMESH_BONE_ASSIGNMENT ||
                  streamID == M_SUBMESH_OPERATION ||
-                 streamID == M_SUBMESH_TEXTURE_ALIAS))
+                 streamID == M_SUBMESH_TEXTURE_ALIAS ||
+                 streamID == M_SUBMESH_CLUSTERS))
             {
                 switch(streamID)
                 {
+                case M_SUBMESH_CLUSTERS:
+                    readSubMeshClusters(stream, pMesh, sm);
+                    break;
                 case M_SUBMESH_OPERATION:
                     readSubMeshOperation(stream, pMesh, sm);
                     break;
@@ -1062,6 +1177,29 @@ namespace Ogre {
         sub->addTextureAlias(aliasName, textureName);
     }
     //---------------------------------------------------------------------
+    void MeshSerializerImpl::readSubMeshClusters(DataStreamPtr& stream, Mesh* pMesh, SubMesh* sub)
+    {
+        // unsigned int clusterCount
+        unsigned int clusterCount = 0;
+        readInts(stream, &clusterCount, 1);
+
+        sub->mClusters.resize(clusterCount);
+        for (unsigned int c = 0; c < clusterCount; ++c)
+        {
+            SubMesh::TriangleCluster& cluster = sub->mClusters[c];
+            uint32 range[2];
+            readInts(stream, range, 2);
+            cluster.indexStart = range[0];
+            cluster.indexCount = range[1];
+            float bounds[8];
+            readFloats(stream, bounds, 8);
+            cluster.center = Vector3(bounds[0], bounds[1], bounds[2]);
+            cluster.radius = bounds[3];
+            cluster.coneAxis = Vector3(bounds[4], bounds[5], bounds[6]);
+            cluster.coneCutoff = bounds[7];
+        }
+    }
+    //---------------------------------------------------------------------
     void MeshSerializerImpl::writeSkeletonLink(const String& skelName)
     {
         writeChunkHeader(M_MESH_SKELETON_LINK, calcSkeletonLinkSize(skelName));
@@ -1478,7 +1616,14 @@ namespace Ogre {
             bool idx32Bit;
             readBools(stream, &idx32Bit, 1);
             // unsigned short*/int* faceIndexes;  ((v1, v2, v3) * numFaces)
-            if (idx32Bit)
+            if (mDeferPayloads)
+            {
+                PayloadJob& job = deferPayload(stream, PayloadJob::PT_INDEX_BUFFER,
+                    indexData->indexCount * (idx32Bit ? sizeof(uint32) : sizeof(uint16)));
+                job.indexData = indexData;
+                job.wideOrNormals = idx32Bit;
+            }
+            else if (idx32Bit)
             {
                 indexData->indexBuffer = HardwareBufferManager::getSingleton().
                     createIndexBuffer(HardwareIndexBuffer::IT_32BIT, indexData->indexCount,
@@ -1511,6 +1656,197 @@ namespace Ogre {
 		}
 	}
     //---------------------------------------------------------------------
+    MeshSerializerImpl::PayloadJob& MeshSerializerImpl::deferPayload(DataStreamPtr& stream,
+        PayloadJob::Type type, size_t size)
+    {
+        const void* pSrc = stream->peek(size);
+        if (!pSrc)
+        {
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+                "Buffer data runs past the end of " + stream->getName(),
+                "MeshSerializerImpl::deferPayload");
+        }
+
+        PayloadJob job;
+        job.type = type;
+        job.data = static_cast<const uchar*>(pSrc);
+        job.size = size;
+        job.vertexData = 0;
+        job.bindIndex = 0;
+        job.indexData = 0;
+        job.keyFrame = 0;
+        job.pose = 0;
+        job.wideOrNormals = false;
+        job.staging = 0;
+        mPayloadJobs.push_back(job);
+        stream->skip(static_cast<long>(size));
+        return mPayloadJobs.back();
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl::decodePayloads(Mesh* pMesh)
+    {
+        // Without endian conversion only the poses have anything to decode
+        size_t decodeCount = 0;
+        for (PayloadJobList::iterator i = mPayloadJobs.begin(); i != mPayloadJobs.end(); ++i)
+        {
+            if (mFlipEndian || i->type == PayloadJob::PT_POSE)
+                ++decodeCount;
+        }
+        if (decodeCount > 1)
+        {
+            const size_t threadCount = std::max((size_t)1,
+                std::min(ParallelFor::getHardwareThreadCount(), decodeCount));
+            vector<PayloadDecoder>::type decoders;
+            decoders.reserve(threadCount);
+            for (size_t t = 0; t < threadCount; ++t)
+            {
+                decoders.push_back(PayloadDecoder(this, &mPayloadJobs, t, threadCount));
+            }
+            ParallelFor::runWorkers(decoders);
+        }
+        else if (decodeCount)
+        {
+            for (PayloadJobList::iterator i = mPayloadJobs.begin(); i != mPayloadJobs.end(); ++i)
+            {
+                decodePayload(*i);
+            }
+        }
+
+        // Hardware buffers are created on the loading thread, from the decoded copy
+        // or straight from the stream memory
+        HardwareBufferManager& bufferMgr = HardwareBufferManager::getSingleton();
+        for (PayloadJobList::iterator i = mPayloadJobs.begin(); i != mPayloadJobs.end(); ++i)
+        {
+            const void* pSrc = i->staging ? i->staging : i->data;
+            switch (i->type)
+            {
+            case PayloadJob::PT_VERTEX_BUFFER:
+                {
+                    HardwareVertexBufferSharedPtr vbuf = bufferMgr.createVertexBuffer(
+                        i->vertexData->vertexDeclaration->getVertexSize(i->bindIndex),
+                        i->vertexData->vertexCount,
+                        pMesh->mVertexBufferUsage,
+                        pMesh->mVertexBufferShadowBuffer);
+                    vbuf->writeData(0, i->size, pSrc, true);
+                    i->vertexData->vertexBufferBinding->setBinding(i->bindIndex, vbuf);
+                }
+                break;
+            case PayloadJob::PT_INDEX_BUFFER:
+                i->indexData->indexBuffer = bufferMgr.createIndexBuffer(
+                    i->wideOrNormals ? HardwareIndexBuffer::IT_32BIT : HardwareIndexBuffer::IT_16BIT,
+                    i->indexData->indexCount,
+                    pMesh->mIndexBufferUsage,
+                    pMesh->mIndexBufferShadowBuffer);
+                i->indexData->indexBuffer->writeData(0, i->size, pSrc, true);
+                break;
+            case PayloadJob::PT_MORPH_KEYFRAME:
+                {
+                    // Allow read and use shadow buffer
+                    HardwareVertexBufferSharedPtr vbuf = bufferMgr.createVertexBuffer(
+                        sizeof(float) * (i->wideOrNormals ? 6 : 3),
+                        i->vertexData->vertexCount,
+                        HardwareBuffer::HBU_STATIC, true);
+                    vbuf->writeData(0, i->size, pSrc, true);
+                    i->keyFrame->setVertexBuffer(vbuf);
+                }
+                break;
+            case PayloadJob::PT_POSE:
+                // Decoded straight into the pose
+                break;
+            }
+        }
+
+        for (vector<VertexData*>::type::iterator i = mColourConversions.begin();
+            i != mColourConversions.end(); ++i)
+        {
+            convertPackedColours(*i);
+        }
+        clearPayloads();
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl::decodePayload(PayloadJob& job)
+    {
+        DataStreamPtr view(OGRE_NEW MemoryDataStream(const_cast<uchar*>(job.data), job.size, false, true));
+        switch (job.type)
+        {
+        case PayloadJob::PT_VERTEX_BUFFER:
+            if (mFlipEndian)
+            {
+                job.staging = OGRE_MALLOC(job.size, MEMCATEGORY_GEOMETRY);
+                view->read(job.staging, job.size);
+                flipFromLittleEndian(
+                    job.staging,
+                    job.vertexData->vertexCount,
+                    job.vertexData->vertexDeclaration->getVertexSize(job.bindIndex),
+                    job.vertexData->vertexDeclaration->findElementsBySource(job.bindIndex));
+            }
+            break;
+        case PayloadJob::PT_INDEX_BUFFER:
+            if (mFlipEndian)
+            {
+                job.staging = OGRE_MALLOC(job.size, MEMCATEGORY_GEOMETRY);
+                if (job.wideOrNormals)
+                    readInts(view, static_cast<uint32*>(job.staging), job.size / sizeof(uint32));
+                else
+                    readShorts(view, static_cast<uint16*>(job.staging), job.size / sizeof(uint16));
+            }
+            break;
+        case PayloadJob::PT_MORPH_KEYFRAME:
+            if (mFlipEndian)
+            {
+                job.staging = OGRE_MALLOC(job.size, MEMCATEGORY_GEOMETRY);
+                readFloats(view, static_cast<float*>(job.staging), job.size / sizeof(float));
+            }
+            break;
+        case PayloadJob::PT_POSE:
+            {
+                // M_POSE_VERTEX chunks, all of the size checked by readPose
+                const size_t vertexChunkSize = MSTREAM_OVERHEAD_SIZE + sizeof(uint32) +
+                    sizeof(float) * (job.wideOrNormals ? 6 : 3);
+                const size_t vertexCount = job.size / vertexChunkSize;
+                for (size_t v = 0; v < vertexCount; ++v)
+                {
+                    view->skip(MSTREAM_OVERHEAD_SIZE);
+                    uint32 vertIndex;
+                    Vector3 offset, normal;
+                    // unsigned long vertexIndex
+                    readInts(view, &vertIndex, 1);
+                    // float xoffset, yoffset, zoffset
+                    readFloats(view, offset.ptr(), 3);
+                    if (job.wideOrNormals)
+                    {
+                        readFloats(view, normal.ptr(), 3);
+                        job.pose->addVertex(vertIndex, offset, normal);
+                    }
+                    else
+                    {
+                        job.pose->addVertex(vertIndex, offset);
+                    }
+                }
+            }
+            break;
+        }
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl::PayloadDecoder::run()
+    {
+        for (size_t i = first; i < jobs->size(); i += stride)
+        {
+            serializer->decodePayload((*jobs)[i]);
+        }
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl::clearPayloads(void)
+    {
+        for (PayloadJobList::iterator i = mPayloadJobs.begin(); i != mPayloadJobs.end(); ++i)
+        {
+            if (i->staging)
+                OGRE_FREE(i->staging, MEMCATEGORY_GEOMETRY);
+        }
+        mPayloadJobs.clear();
+        mColourConversions.clear();
+    }
+    //---------------------------------------------------------------------
     void MeshSerializerImpl::flipFromLittleEndian(void* pData, size_t vertexCount,
         size_t vertexSize, const VertexDeclaration::VertexElementList& elems)
 	{
@@ -1556,6 +1892,8 @@ namespace Ogre {
 						typeSize = sizeof(short);
 						break;
 					case VET_USHORT1:
+					case VET_HALF2:
+					case VET_SHORT2_SNORM:
 						typeSize = sizeof(unsigned short);
 						break;
 					case VET_INT1:
@@ -1771,7 +2109,7 @@ namespace Ogre {
     //---------------------------------------------------------------------
 	void MeshSerializerImpl::readEdgeList(DataStreamPtr& stream, Mesh* pMesh)
 	{
-        if (!stream->eof())
+        if (!readEdgeListParallel(stream, pMesh) && !stream->eof())
         {
             unsigned short streamID = readChunk(stream);
             while(!stream->eof() &&
@@ -1797,32 +2135,7 @@ namespace Ogre {
                     readEdgeListLodInfo(stream, usage.edgeData);
 
                     // Postprocessing edge groups
-                    EdgeData::EdgeGroupList::iterator egi, egend;
-                    egend = usage.edgeData->edgeGroups.end();
-                    for (egi = usage.edgeData->edgeGroups.begin(); egi != egend; ++egi)
-                    {
-                        EdgeData::EdgeGroup& edgeGroup = *egi;
-                        // Populate edgeGroup.vertexData pointers
-                        // If there is shared vertex data, vertexSet 0 is that,
-                        // otherwise 0 is first dedicated
-                        if (pMesh->sharedVertexData)
-                        {
-                            if (edgeGroup.vertexSet == 0)
-                            {
-                                edgeGroup.vertexData = pMesh->sharedVertexData;
-                            }
-                            else
-                            {
-                                edgeGroup.vertexData = pMesh->getSubMesh(
-                                    (unsigned short)edgeGroup.vertexSet-1)->vertexData;
-                            }
-                        }
-                        else
-                        {
-                            edgeGroup.vertexData = pMesh->getSubMesh(
-                                (unsigned short)edgeGroup.vertexSet)->vertexData;
-                        }
-                    }
+                    resolveEdgeGroupVertexData(pMesh, usage.edgeData);
                 }
 
                 if (!stream->eof())
@@ -1841,6 +2154,143 @@ namespace Ogre {
         pMesh->mEdgeListsBuilt = true;
 	}
 	//---------------------------------------------------------------------
+	void MeshSerializerImpl::resolveEdgeGroupVertexData(Mesh* pMesh, EdgeData* edgeData)
+	{
+        EdgeData::EdgeGroupList::iterator egi, egend;
+        egend = edgeData->edgeGroups.end();
+        for (egi = edgeData->edgeGroups.begin(); egi != egend; ++egi)
+        {
+            EdgeData::EdgeGroup& edgeGroup = *egi;
+            // Populate edgeGroup.vertexData pointers
+            // If there is shared vertex data, vertexSet 0 is that,
+            // otherwise 0 is first dedicated
+            if (pMesh->sharedVertexData)
+            {
+                if (edgeGroup.vertexSet == 0)
+                {
+                    edgeGroup.vertexData = pMesh->sharedVertexData;
+                }
+                else
+                {
+                    edgeGroup.vertexData = pMesh->getSubMesh(
+                        (unsigned short)edgeGroup.vertexSet-1)->vertexData;
+                }
+            }
+            else
+            {
+                edgeGroup.vertexData = pMesh->getSubMesh(
+                    (unsigned short)edgeGroup.vertexSet)->vertexData;
+            }
+        }
+	}
+	//---------------------------------------------------------------------
+	bool MeshSerializerImpl::readEdgeListParallel(DataStreamPtr& stream, Mesh* pMesh)
+	{
+        // mCurrentstreamLen still holds the length of the M_EDGE_LISTS chunk
+        if (mCurrentstreamLen < MSTREAM_OVERHEAD_SIZE)
+            return false;
+        const size_t chunkSize = mCurrentstreamLen - MSTREAM_OVERHEAD_SIZE;
+        const uchar* pChunk = static_cast<const uchar*>(stream->peek(chunkSize));
+        if (!pChunk)
+            return false;
+
+        // Locate the LOD levels by their chunk lengths
+        EdgeListLodJobList jobs;
+        DataStreamPtr scan(OGRE_NEW MemoryDataStream(const_cast<uchar*>(pChunk), chunkSize, false, true));
+        while (!scan->eof())
+        {
+            const size_t start = scan->tell();
+            unsigned short streamID;
+            uint32 streamLen;
+            readShorts(scan, &streamID, 1);
+            readInts(scan, &streamLen, 1);
+            if (streamID != M_EDGE_LIST_LOD || streamLen < MSTREAM_OVERHEAD_SIZE || start + streamLen > chunkSize)
+                return false;
+
+            unsigned short lodIndex;
+            bool isManual;
+            readShorts(scan, &lodIndex, 1);
+            readBools(scan, &isManual, 1);
+            if (scan->tell() > start + streamLen || lodIndex >= pMesh->getNumLodLevels())
+                return false;
+            if (!isManual)
+            {
+                EdgeListLodJob job;
+                job.lodIndex = lodIndex;
+                job.data = pChunk + scan->tell();
+                job.size = start + streamLen - scan->tell();
+                job.edgeData = 0;
+                job.succeeded = false;
+                jobs.push_back(job);
+            }
+            scan->seek(start + streamLen);
+        }
+        // A single level gains nothing over the serial path
+        if (jobs.size() < 2)
+            return false;
+
+        for (EdgeListLodJobList::iterator i = jobs.begin(); i != jobs.end(); ++i)
+        {
+            i->edgeData = OGRE_NEW EdgeData();
+        }
+
+        const size_t threadCount = std::max((size_t)1,
+            std::min(ParallelFor::getHardwareThreadCount(), jobs.size()));
+        vector<EdgeListLodDecoder>::type decoders;
+        decoders.reserve(threadCount);
+        for (size_t t = 0; t < threadCount; ++t)
+        {
+            decoders.push_back(EdgeListLodDecoder(this, &jobs, t, threadCount));
+        }
+        ParallelFor::runWorkers(decoders);
+
+        bool succeeded = true;
+        for (EdgeListLodJobList::iterator i = jobs.begin(); i != jobs.end(); ++i)
+        {
+            succeeded = succeeded && i->succeeded;
+        }
+        if (!succeeded)
+        {
+            // Chunk lengths didn't match the contents, let the serial path report the problem
+            for (EdgeListLodJobList::iterator i = jobs.begin(); i != jobs.end(); ++i)
+            {
+                OGRE_DELETE i->edgeData;
+            }
+            return false;
+        }
+
+        for (EdgeListLodJobList::iterator i = jobs.begin(); i != jobs.end(); ++i)
+        {
+            MeshLodUsage& usage = const_cast<MeshLodUsage&>(pMesh->getLodLevel(i->lodIndex));
+            usage.edgeData = i->edgeData;
+            resolveEdgeGroupVertexData(pMesh, usage.edgeData);
+        }
+        stream->skip(static_cast<long>(chunkSize));
+        return true;
+	}
+	//---------------------------------------------------------------------
+	void MeshSerializerImpl::decodeEdgeListLod(EdgeListLodJob& job)
+	{
+        DataStreamPtr view(OGRE_NEW MemoryDataStream(const_cast<uchar*>(job.data), job.size, false, true));
+        try
+        {
+            readEdgeListLodInfo(view, job.edgeData);
+            job.succeeded = view->tell() == job.size;
+        }
+        catch (Exception&)
+        {
+            job.succeeded = false;
+        }
+	}
+	//---------------------------------------------------------------------
+	void MeshSerializerImpl::EdgeListLodDecoder::run()
+	{
+        for (size_t i = first; i < jobs->size(); i += stride)
+        {
+            serializer->decodeEdgeListLod((*jobs)[i]);
+        }
+	}
+	//---------------------------------------------------------------------
     void MeshSerializerImpl::readEdgeListLodInfo(DataStreamPtr& stream,
         EdgeData* edgeData)
     {
@@ -1886,7 +2336,12 @@ namespace Ogre {
 
         for (uint32 eg = 0; eg < numEdgeGroups; ++eg)
         {
-            unsigned short streamID = readChunk(stream);
+            // Read the header by hand, readChunk stores the length in a member and LOD
+            // levels may be decoded concurrently
+            unsigned short streamID;
+            uint32 streamLen;
+            readShorts(stream, &streamID, 1);
+            readInts(stream, &streamLen, 1);
             if (streamID != M_EDGE_GROUP)
             {
                 OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
@@ -2293,6 +2748,34 @@ namespace Ogre {
 		
 		Pose* pose = pMesh->createPose(target, name);
 
+		if (mDeferPayloads)
+		{
+			// Locate the run of M_POSE_VERTEX chunks, which is decoded later if they
+			// all have the expected size
+			const size_t vertexChunkSize = MSTREAM_OVERHEAD_SIZE + sizeof(uint32) +
+				sizeof(float) * (includesNormals ? 6 : 3);
+			const size_t start = stream->tell();
+			size_t vertexCount = 0;
+			bool uniform = true;
+			while (uniform && !stream->eof())
+			{
+				if (readChunk(stream) != M_POSE_VERTEX)
+					break;
+				uniform = mCurrentstreamLen == vertexChunkSize;
+				stream->skip(static_cast<long>(vertexChunkSize - MSTREAM_OVERHEAD_SIZE));
+				++vertexCount;
+			}
+			stream->seek(start);
+			if (uniform && vertexCount)
+			{
+				PayloadJob& job = deferPayload(stream, PayloadJob::PT_POSE,
+					vertexCount * vertexChunkSize);
+				job.pose = pose;
+				job.wideOrNormals = includesNormals;
+				return;
+			}
+		}
+
 		// Find all substreams
 		if (!stream->eof())
 		{
@@ -2493,6 +2976,15 @@ namespace Ogre {
 		// Create buffer, allow read and use shadow buffer
 		size_t vertexCount = track->getAssociatedVertexData()->vertexCount;
 		size_t vertexSize = sizeof(float) * (includesNormals ? 6 : 3);
+		if (mDeferPayloads)
+		{
+			PayloadJob& job = deferPayload(stream, PayloadJob::PT_MORPH_KEYFRAME,
+				vertexCount * vertexSize);
+			job.vertexData = track->getAssociatedVertexData();
+			job.keyFrame = kf;
+			job.wideOrNormals = includesNormals;
+			return;
+		}
 		HardwareVertexBufferSharedPtr vbuf =
 			HardwareBufferManager::getSingleton().createVertexBuffer(
 				vertexSize, vertexCount,
@@ -2572,6 +3064,54 @@ namespace Ogre {
 	}
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
+    //---------------------------------------------------------------------
+	MeshSerializerImpl_v1_8::MeshSerializerImpl_v1_8()
+	{
+        // Version number
+        mVersion = "[MeshSerializer_v1.8]";
+	}
+    //---------------------------------------------------------------------
+	MeshSerializerImpl_v1_8::~MeshSerializerImpl_v1_8()
+	{
+	}
+    //---------------------------------------------------------------------
+	size_t MeshSerializerImpl_v1_8::calcGeometrySize(const VertexData* vertexData)
+	{
+		// Sizes are calculated before the geometry is written, so this stops an export early
+		const VertexDeclaration::VertexElementList& elems =
+			vertexData->vertexDeclaration->getElements();
+		VertexDeclaration::VertexElementList::const_iterator i, iend;
+		iend = elems.end();
+		for (i = elems.begin(); i != iend; ++i)
+		{
+			switch (i->getType())
+			{
+			case VET_HALF2:
+			case VET_HALF4:
+			case VET_SHORT2_SNORM:
+			case VET_SHORT4_SNORM:
+				OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+					"Quantised vertex data can not be written to this mesh version, "
+					"export it as MESH_VERSION_1_10 or later instead.",
+					"MeshSerializerImpl_v1_8::calcGeometrySize");
+			default:
+				break;
+			}
+		}
+		return MeshSerializerImpl::calcGeometrySize(vertexData);
+	}
+    //---------------------------------------------------------------------
+	void MeshSerializerImpl_v1_8::writeSubMeshClusters(const SubMesh* s)
+	{
+		// Clusters are not part of this version, the triangle order is kept though
+	}
+    //---------------------------------------------------------------------
+	size_t MeshSerializerImpl_v1_8::calcSubMeshClustersSize(const SubMesh* pSub)
+	{
+		return 0;
+	}
+    //---------------------------------------------------------------------
+    //---------------------------------------------------------------------
     //---------------------------------------------------------------------
 	MeshSerializerImpl_v1_41::MeshSerializerImpl_v1_41()
 	{
@@ -2995,7 +3535,12 @@ namespace Ogre {
 
         for (uint32 eg = 0; eg < numEdgeGroups; ++eg)
         {
-            unsigned short streamID = readChunk(stream);
+            // Read the header by hand, readChunk stores the length in a member and LOD
+            // levels may be decoded concurrently
+            unsigned short streamID;
+            uint32 streamLen;
+            readShorts(stream, &streamID, 1);
+            readInts(stream, &streamLen, 1);
             if (streamID != M_EDGE_GROUP)
             {
                 OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
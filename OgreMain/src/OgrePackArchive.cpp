@@ -0,0 +1,759 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+
+#include "OgrePackArchive.h"
+#include "OgreLogManager.h"
+#include "OgreException.h"
+#include "OgreStringVector.h"
+#include "OgreStringConverter.h"
+#include "OgreDataStream.h"
+
+namespace Ogre {
+
+	const uint32 PackArchive::PACK_MAGIC = 0x4B415030; // "0PAK"
+	const uint32 PackArchive::PACK_VERSION = 1;
+
+	namespace
+	{
+		/// Stream of an uncompressed file, read in place from the mapped pack
+		class PackMappedDataStream : public MemoryDataStream
+		{
+		protected:
+			/// Keeps the mapping alive, even if the archive is unloaded
+			DataStreamPtr mMapping;
+		public:
+			PackMappedDataStream(const String& name, const uchar* data, size_t size, const DataStreamPtr& mapping)
+				: MemoryDataStream(name, const_cast<uchar*>(data), size, false, true), mMapping(mapping) {}
+		};
+
+		template <typename T>
+		void flipFromLittleEndian(T& value)
+		{
+#if OGRE_ENDIAN == OGRE_ENDIAN_BIG
+			uchar* bytes = reinterpret_cast<uchar*>(&value);
+			std::reverse(bytes, bytes + sizeof(T));
+#else
+			(void)value;
+#endif
+		}
+
+		void flipFromLittleEndian(PackArchive::PackHeader& header)
+		{
+			flipFromLittleEndian(header.magic);
+			flipFromLittleEndian(header.version);
+			flipFromLittleEndian(header.entryCount);
+			flipFromLittleEndian(header.alignment);
+			flipFromLittleEndian(header.entriesOffset);
+			flipFromLittleEndian(header.namesOffset);
+			flipFromLittleEndian(header.namesSize);
+		}
+
+		void flipFromLittleEndian(PackArchive::PackEntry& entry)
+		{
+			flipFromLittleEndian(entry.offset);
+			flipFromLittleEndian(entry.compressedSize);
+			flipFromLittleEndian(entry.size);
+			flipFromLittleEndian(entry.modifiedTime);
+			flipFromLittleEndian(entry.nameOffset);
+			flipFromLittleEndian(entry.nameLength);
+			flipFromLittleEndian(entry.compression);
+			flipFromLittleEndian(entry.reserved);
+		}
+
+		/// Orders entries by name, for sorting and binary search
+		struct PackEntryNameLess
+		{
+			const String* names;
+			PackEntryNameLess(const String* n) : names(n) {}
+
+			bool operator()(const PackArchive::PackEntry& a, const PackArchive::PackEntry& b) const
+			{
+				return names->compare(a.nameOffset, a.nameLength, *names, b.nameOffset, b.nameLength) < 0;
+			}
+			bool operator()(const PackArchive::PackEntry& a, const String& b) const
+			{
+				return names->compare(a.nameOffset, a.nameLength, b) < 0;
+			}
+			bool operator()(const String& a, const PackArchive::PackEntry& b) const
+			{
+				return names->compare(b.nameOffset, b.nameLength, a) > 0;
+			}
+		};
+
+		/// Orders indexes into a list of names by name
+		struct NameIndexLess
+		{
+			const StringVector* names;
+			NameIndexLess(const StringVector* n) : names(n) {}
+
+			bool operator()(size_t a, size_t b) const { return (*names)[a] < (*names)[b]; }
+		};
+
+		// LZ4 block format constants
+		const size_t LZ4_MIN_MATCH = 4;
+		/// The last literals of a block, which no match may cover
+		const size_t LZ4_LAST_LITERALS = 5;
+		/// No match may start closer than this to the end of a block
+		const size_t LZ4_MF_LIMIT = 12;
+		const size_t LZ4_MAX_DISTANCE = 65535;
+		/// A compressed byte never decompresses to more than this many bytes
+		const uint64 LZ4_MAX_RATIO = 255;
+		const size_t LZ4_HASH_BITS = 12;
+
+		inline uint32 readUint32(const uchar* p)
+		{
+			uint32 v;
+			memcpy(&v, p, sizeof(v));
+			return v;
+		}
+
+		inline uint32 lz4Hash(uint32 sequence)
+		{
+			return (sequence * 2654435761U) >> (32 - LZ4_HASH_BITS);
+		}
+
+		inline uchar* writeLz4Length(uchar* op, size_t length)
+		{
+			while (length >= 255)
+			{
+				*op++ = 255;
+				length -= 255;
+			}
+			*op++ = static_cast<uchar>(length);
+			return op;
+		}
+	}
+	//-----------------------------------------------------------------------
+	size_t PackArchive::getLz4Bound(size_t srcSize)
+	{
+		return srcSize + srcSize / 255 + 16;
+	}
+	//-----------------------------------------------------------------------
+	size_t PackArchive::compressLz4(const void* src, size_t srcSize, void* dest, size_t destCapacity)
+	{
+		const uchar* in = static_cast<const uchar*>(src);
+		uchar* out = static_cast<uchar*>(dest);
+		uchar* op = out;
+		uchar* const opEnd = out + destCapacity;
+		size_t anchor = 0;
+
+		if (srcSize > LZ4_MF_LIMIT)
+		{
+			const size_t matchLimit = srcSize - LZ4_LAST_LITERALS;
+			const size_t ipLimit = srcSize - LZ4_MF_LIMIT;
+			const uint32 noPos = 0xFFFFFFFF;
+			vector<uint32>::type table(1 << LZ4_HASH_BITS, noPos);
+
+			size_t ip = 0;
+			while (ip <= ipLimit)
+			{
+				uint32 sequence = readUint32(in + ip);
+				uint32 h = lz4Hash(sequence);
+				size_t ref = table[h];
+				table[h] = static_cast<uint32>(ip);
+
+				if (ref == noPos || ip - ref > LZ4_MAX_DISTANCE || readUint32(in + ref) != sequence)
+				{
+					++ip;
+					continue;
+				}
+
+				size_t matchLength = LZ4_MIN_MATCH;
+				while (ip + matchLength < matchLimit && in[ref + matchLength] == in[ip + matchLength])
+					++matchLength;
+
+				size_t literals = ip - anchor;
+				// Token, worst case length bytes, literals and offset
+				if (static_cast<size_t>(opEnd - op) < 1 + literals / 255 + 1 + literals + 2 + matchLength / 255 + 1)
+					return 0;
+
+				uchar* token = op++;
+				size_t matchCode = matchLength - LZ4_MIN_MATCH;
+				*token = static_cast<uchar>((std::min(literals, (size_t)15) << 4) | std::min(matchCode, (size_t)15));
+				if (literals >= 15)
+					op = writeLz4Length(op, literals - 15);
+				memcpy(op, in + anchor, literals);
+				op += literals;
+				size_t distance = ip - ref;
+				*op++ = static_cast<uchar>(distance & 0xFF);
+				*op++ = static_cast<uchar>(distance >> 8);
+				if (matchCode >= 15)
+					op = writeLz4Length(op, matchCode - 15);
+
+				ip += matchLength;
+				anchor = ip;
+				// Keep the table useful within long matches
+				if (ip - 2 <= ipLimit)
+					table[lz4Hash(readUint32(in + ip - 2))] = static_cast<uint32>(ip - 2);
+			}
+		}
+
+		// Last literals
+		size_t literals = srcSize - anchor;
+		if (static_cast<size_t>(opEnd - op) < 1 + literals / 255 + 1 + literals)
+			return 0;
+		*op++ = static_cast<uchar>(std::min(literals, (size_t)15) << 4);
+		if (literals >= 15)
+			op = writeLz4Length(op, literals - 15);
+		memcpy(op, in + anchor, literals);
+		op += literals;
+
+		return op - out;
+	}
+	//-----------------------------------------------------------------------
+	bool PackArchive::decompressLz4(const void* src, size_t srcSize, void* dest, size_t destSize)
+	{
+		const uchar* ip = static_cast<const uchar*>(src);
+		const uchar* const ipEnd = ip + srcSize;
+		uchar* const out = static_cast<uchar*>(dest);
+		uchar* op = out;
+		uchar* const opEnd = out + destSize;
+
+		while (ip < ipEnd)
+		{
+			uchar token = *ip++;
+
+			size_t literals = token >> 4;
+			if (literals == 15)
+			{
+				uchar b;
+				do
+				{
+					if (ip == ipEnd)
+						return false;
+					b = *ip++;
+					literals += b;
+				} while (b == 255);
+			}
+			if (literals > static_cast<size_t>(ipEnd - ip) || literals > static_cast<size_t>(opEnd - op))
+				return false;
+			memcpy(op, ip, literals);
+			ip += literals;
+			op += literals;
+
+			// The last sequence has no match
+			if (ip == ipEnd)
+				break;
+
+			if (ipEnd - ip < 2)
+				return false;
+			size_t distance = ip[0] | (ip[1] << 8);
+			ip += 2;
+			if (distance == 0 || distance > static_cast<size_t>(op - out))
+				return false;
+
+			size_t matchLength = token & 15;
+			if (matchLength == 15)
+			{
+				uchar b;
+				do
+				{
+					if (ip == ipEnd)
+						return false;
+					b = *ip++;
+					matchLength += b;
+				} while (b == 255);
+			}
+			matchLength += LZ4_MIN_MATCH;
+			if (matchLength > static_cast<size_t>(opEnd - op))
+				return false;
+
+			// Matches may overlap what they write, copy bytewise
+			const uchar* match = op - distance;
+			for (size_t i = 0; i < matchLength; ++i)
+				op[i] = match[i];
+			op += matchLength;
+		}
+
+		return op == opEnd;
+	}
+    //-----------------------------------------------------------------------
+    PackArchive::PackArchive(const String& name, const String& archType)
+        : Archive(name, archType), mLoaded(false)
+    {
+    }
+    //-----------------------------------------------------------------------
+    PackArchive::~PackArchive()
+    {
+        unload();
+    }
+    //-----------------------------------------------------------------------
+    void PackArchive::load()
+    {
+		OGRE_LOCK_AUTO_MUTEX
+        if (mLoaded)
+            return;
+
+        // Map the pack if possible, streams of uncompressed files then need no copy
+        try
+        {
+            mMapping.bind(OGRE_NEW MmapDataStream(mName, mName));
+        }
+        catch (Exception&)
+        {
+            mMapping.setNull();
+        }
+
+        DataStreamPtr stream = mMapping;
+        if (stream.isNull())
+        {
+            std::ifstream* file = OGRE_NEW_T(std::ifstream, MEMCATEGORY_GENERAL)(
+                mName.c_str(), std::ios::in | std::ios::binary);
+            if (file->fail())
+            {
+                OGRE_DELETE_T(file, basic_ifstream, MEMCATEGORY_GENERAL);
+                OGRE_EXCEPT(Exception::ERR_FILE_NOT_FOUND,
+                    "Cannot open pack file: " + mName, "PackArchive::load");
+            }
+            stream.bind(OGRE_NEW FileStreamDataStream(mName, file, true));
+        }
+
+        PackHeader header;
+        if (stream->read(&header, sizeof(header)) != sizeof(header))
+            header.magic = 0;
+        flipFromLittleEndian(header);
+        if (header.magic != PACK_MAGIC || header.version != PACK_VERSION)
+        {
+            mMapping.setNull();
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+                mName + " is not a pack file of version " + StringConverter::toString(PACK_VERSION),
+                "PackArchive::load");
+        }
+
+        // Every range is checked as size <= packSize - offset, which can't overflow
+        uint64 packSize = stream->size();
+        bool valid = header.namesSize <= packSize &&
+            header.namesOffset <= packSize - header.namesSize &&
+            header.entryCount <= packSize / sizeof(PackEntry) &&
+            header.entriesOffset <= packSize - (uint64)header.entryCount * sizeof(PackEntry);
+        if (valid)
+        {
+            mNames.resize(static_cast<size_t>(header.namesSize));
+            stream->seek(static_cast<size_t>(header.namesOffset));
+            if (!mNames.empty())
+                valid = stream->read(&mNames[0], mNames.size()) == mNames.size();
+
+            mEntries.resize(header.entryCount);
+            stream->seek(static_cast<size_t>(header.entriesOffset));
+            if (valid && !mEntries.empty())
+            {
+                size_t entriesSize = mEntries.size() * sizeof(PackEntry);
+                valid = stream->read(&mEntries[0], entriesSize) == entriesSize;
+            }
+        }
+        if (valid)
+        {
+            mFileList.reserve(mEntries.size());
+            PackEntryNameLess nameLess(&mNames);
+            for (PackEntryList::iterator i = mEntries.begin(); i != mEntries.end(); ++i)
+            {
+                flipFromLittleEndian(*i);
+                // open allocates the uncompressed size, so it must be one the data can
+                // really decompress to
+                valid = (uint64)i->nameOffset + i->nameLength <= mNames.size() &&
+                    i->offset <= packSize && i->compressedSize <= packSize - i->offset &&
+                    i->size <= std::numeric_limits<size_t>::max() &&
+                    ((i->compression == COMPRESSION_LZ4 && i->size <= i->compressedSize * LZ4_MAX_RATIO) ||
+                    (i->compression == COMPRESSION_NONE && i->compressedSize == i->size));
+                // findEntry searches by name, which needs the entries sorted and unique
+                valid = valid && (i == mEntries.begin() || nameLess(*(i - 1), *i));
+                if (!valid)
+                    break;
+
+                FileInfo info;
+                info.archive = this;
+                info.filename = mNames.substr(i->nameOffset, i->nameLength);
+                StringUtil::splitFilename(info.filename, info.basename, info.path);
+                info.compressedSize = static_cast<size_t>(i->compressedSize);
+                info.uncompressedSize = static_cast<size_t>(i->size);
+                mFileList.push_back(info);
+            }
+        }
+        if (!valid)
+        {
+            mMapping.setNull();
+            mEntries.clear();
+            mNames.clear();
+            mFileList.clear();
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+                mName + " is a damaged pack file", "PackArchive::load");
+        }
+
+        mLoaded = true;
+    }
+    //-----------------------------------------------------------------------
+    void PackArchive::unload()
+    {
+		OGRE_LOCK_AUTO_MUTEX
+        // Streams still open keep the mapping alive
+        mMapping.setNull();
+        mEntries.clear();
+        mNames.clear();
+        mFileList.clear();
+        mLoaded = false;
+    }
+    //-----------------------------------------------------------------------
+    const PackArchive::PackEntry* PackArchive::findEntry(const String& filename) const
+    {
+        PackEntryList::const_iterator i = std::lower_bound(
+            mEntries.begin(), mEntries.end(), filename, PackEntryNameLess(&mNames));
+        if (i == mEntries.end() || mNames.compare(i->nameOffset, i->nameLength, filename) != 0)
+            return 0;
+        return &*i;
+    }
+    //-----------------------------------------------------------------------
+    uchar* PackArchive::readEntryData(const PackEntry& entry) const
+    {
+        size_t size = static_cast<size_t>(entry.compressedSize);
+        uchar* data = OGRE_ALLOC_T(uchar, size, MEMCATEGORY_GENERAL);
+        if (!mMapping.isNull())
+        {
+            memcpy(data, static_cast<MmapDataStream*>(mMapping.get())->getPtr() + entry.offset, size);
+            return data;
+        }
+
+        // One file handle per read, so reads from several threads don't share a position
+        std::ifstream file(mName.c_str(), std::ios::in | std::ios::binary);
+        file.seekg(static_cast<std::streamoff>(entry.offset));
+        file.read(reinterpret_cast<char*>(data), static_cast<std::streamsize>(size));
+        if (file.fail())
+        {
+            OGRE_FREE(data, MEMCATEGORY_GENERAL);
+            OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
+                "Cannot read from pack file: " + mName, "PackArchive::readEntryData");
+        }
+        return data;
+    }
+    //-----------------------------------------------------------------------
+	DataStreamPtr PackArchive::open(const String& filename, bool readOnly) const
+    {
+        const PackEntry* entry = findEntry(filename);
+        if (!entry)
+        {
+            OGRE_EXCEPT(Exception::ERR_FILE_NOT_FOUND,
+                "Cannot find file " + filename + " in pack " + mName, "PackArchive::open");
+        }
+        size_t size = static_cast<size_t>(entry->size);
+
+        if (entry->compression == COMPRESSION_NONE)
+        {
+            if (!mMapping.isNull())
+            {
+                const uchar* data = static_cast<MmapDataStream*>(mMapping.get())->getPtr() + entry->offset;
+                return DataStreamPtr(OGRE_NEW PackMappedDataStream(filename, data, size, mMapping));
+            }
+            return DataStreamPtr(OGRE_NEW MemoryDataStream(filename, readEntryData(*entry), size, true, true));
+        }
+
+        uchar* data = OGRE_ALLOC_T(uchar, size, MEMCATEGORY_GENERAL);
+        bool decompressed;
+        if (!mMapping.isNull())
+        {
+            const uchar* src = static_cast<MmapDataStream*>(mMapping.get())->getPtr() + entry->offset;
+            decompressed = decompressLz4(src, static_cast<size_t>(entry->compressedSize), data, size);
+        }
+        else
+        {
+            uchar* src = readEntryData(*entry);
+            decompressed = decompressLz4(src, static_cast<size_t>(entry->compressedSize), data, size);
+            OGRE_FREE(src, MEMCATEGORY_GENERAL);
+        }
+        if (!decompressed)
+        {
+            OGRE_FREE(data, MEMCATEGORY_GENERAL);
+            OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
+                "Damaged data for file " + filename + " in pack " + mName, "PackArchive::open");
+        }
+        return DataStreamPtr(OGRE_NEW MemoryDataStream(filename, data, size, true, true));
+    }
+	//---------------------------------------------------------------------
+	DataStreamPtr PackArchive::create(const String& filename) const
+	{
+		OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED, 
+			"Modification of pack archives is not supported, use PackArchiveWriter", 
+			"PackArchive::create");
+	}
+	//---------------------------------------------------------------------
+	void PackArchive::remove(const String& filename) const
+	{
+	}
+    //-----------------------------------------------------------------------
+    StringVectorPtr PackArchive::list(bool recursive, bool dirs)
+    {
+        StringVectorPtr ret = StringVectorPtr(OGRE_NEW_T(StringVector, MEMCATEGORY_GENERAL)(), SPFM_DELETE_T);
+        if (dirs)
+            return ret;
+
+        FileInfoList::iterator i, iend;
+        iend = mFileList.end();
+        for (i = mFileList.begin(); i != iend; ++i)
+            if (recursive || i->path.empty())
+                ret->push_back(i->filename);
+
+        return ret;
+    }
+    //-----------------------------------------------------------------------
+    FileInfoListPtr PackArchive::listFileInfo(bool recursive, bool dirs)
+    {
+        FileInfoList* fil = OGRE_NEW_T(FileInfoList, MEMCATEGORY_GENERAL)();
+        if (!dirs)
+        {
+            FileInfoList::const_iterator i, iend;
+            iend = mFileList.end();
+            for (i = mFileList.begin(); i != iend; ++i)
+                if (recursive || i->path.empty())
+                    fil->push_back(*i);
+        }
+
+        return FileInfoListPtr(fil, SPFM_DELETE_T);
+    }
+    //-----------------------------------------------------------------------
+    StringVectorPtr PackArchive::find(const String& pattern, bool recursive, bool dirs)
+    {
+        StringVectorPtr ret = StringVectorPtr(OGRE_NEW_T(StringVector, MEMCATEGORY_GENERAL)(), SPFM_DELETE_T);
+        if (dirs)
+            return ret;
+        // If pattern contains a directory name, do a full match
+        bool full_match = (pattern.find ('/') != String::npos) ||
+                          (pattern.find ('\\') != String::npos);
+
+        FileInfoList::iterator i, iend;
+        iend = mFileList.end();
+        for (i = mFileList.begin(); i != iend; ++i)
+            if (recursive || full_match || i->path.empty())
+                if (StringUtil::match(full_match ? i->filename : i->basename, pattern, true))
+                    ret->push_back(i->filename);
+
+        return ret;
+    }
+    //-----------------------------------------------------------------------
+	FileInfoListPtr PackArchive::findFileInfo(const String& pattern, 
+        bool recursive, bool dirs) const
+    {
+        FileInfoListPtr ret = FileInfoListPtr(OGRE_NEW_T(FileInfoList, MEMCATEGORY_GENERAL)(), SPFM_DELETE_T);
+        if (dirs)
+            return ret;
+        // If pattern contains a directory name, do a full match
+        bool full_match = (pattern.find ('/') != String::npos) ||
+                          (pattern.find ('\\') != String::npos);
+
+        FileInfoList::const_iterator i, iend;
+        iend = mFileList.end();
+        for (i = mFileList.begin(); i != iend; ++i)
+            if (recursive || full_match || i->path.empty())
+                if (StringUtil::match(full_match ? i->filename : i->basename, pattern, true))
+                    ret->push_back(*i);
+
+        return ret;
+    }
+    //-----------------------------------------------------------------------
+	bool PackArchive::exists(const String& filename)
+	{
+		return findEntry(filename) != 0;
+	}
+	//---------------------------------------------------------------------
+	time_t PackArchive::getModifiedTime(const String& filename)
+	{
+		const PackEntry* entry = findEntry(filename);
+		return entry ? static_cast<time_t>(entry->modifiedTime) : 0;
+	}
+    //-----------------------------------------------------------------------
+    const String& PackArchiveFactory::getType(void) const
+    {
+        static String name = "Pack";
+        return name;
+    }
+    //-----------------------------------------------------------------------
+    //-----------------------------------------------------------------------
+    PackArchiveWriter::PackArchiveWriter(const String& filename, uint32 alignment)
+        : mFile(0), mFileName(filename), mAlignment(std::max(alignment, (uint32)1)), mOffset(0)
+    {
+        mFile = OGRE_NEW_T(std::ofstream, MEMCATEGORY_GENERAL)(
+            filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        if (mFile->fail())
+        {
+            OGRE_DELETE_T(mFile, basic_ofstream, MEMCATEGORY_GENERAL);
+            mFile = 0;
+            OGRE_EXCEPT(Exception::ERR_CANNOT_WRITE_TO_FILE,
+                "Cannot create pack file: " + filename, "PackArchiveWriter::PackArchiveWriter");
+        }
+
+        // Space for the header, written by finish
+        PackArchive::PackHeader header;
+        memset(&header, 0, sizeof(header));
+        writeData(&header, sizeof(header));
+    }
+    //-----------------------------------------------------------------------
+    PackArchiveWriter::~PackArchiveWriter()
+    {
+        if (mFile)
+        {
+            try
+            {
+                finish();
+            }
+            catch (Exception& e)
+            {
+                LogManager::getSingleton().logMessage(e.getFullDescription());
+            }
+        }
+    }
+    //-----------------------------------------------------------------------
+    void PackArchiveWriter::writeData(const void* data, size_t size)
+    {
+        mFile->write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        if (mFile->fail())
+        {
+            OGRE_EXCEPT(Exception::ERR_CANNOT_WRITE_TO_FILE,
+                "Cannot write to pack file: " + mFileName, "PackArchiveWriter::writeData");
+        }
+        mOffset += size;
+    }
+    //-----------------------------------------------------------------------
+    void PackArchiveWriter::pad(uint32 alignment)
+    {
+        static const char zeros[256] = {0};
+        size_t padding = static_cast<size_t>((alignment - mOffset % alignment) % alignment);
+        while (padding)
+        {
+            size_t n = std::min(padding, sizeof(zeros));
+            writeData(zeros, n);
+            padding -= n;
+        }
+    }
+    //-----------------------------------------------------------------------
+    void PackArchiveWriter::addFile(const String& name, const DataStreamPtr& stream,
+        time_t modifiedTime, bool compress)
+    {
+        if (!mFile)
+        {
+            OGRE_EXCEPT(Exception::ERR_INVALID_STATE,
+                "Pack " + mFileName + " is already finished", "PackArchiveWriter::addFile");
+        }
+
+        DataStreamPtr source = stream;
+        MemoryDataStream contents(source);
+        size_t size = contents.size();
+
+        PackArchive::PackEntry entry;
+        memset(&entry, 0, sizeof(entry));
+        entry.size = size;
+        entry.modifiedTime = static_cast<uint64>(modifiedTime);
+        entry.compression = PackArchive::COMPRESSION_NONE;
+
+        if (compress && size)
+        {
+            size_t capacity = size - size / 8;
+            uchar* compressed = OGRE_ALLOC_T(uchar, capacity, MEMCATEGORY_GENERAL);
+            size_t compressedSize = PackArchive::compressLz4(contents.getPtr(), size, compressed, capacity);
+            if (compressedSize)
+            {
+                entry.offset = mOffset;
+                entry.compressedSize = compressedSize;
+                entry.compression = PackArchive::COMPRESSION_LZ4;
+                try
+                {
+                    writeData(compressed, compressedSize);
+                }
+                catch (Exception&)
+                {
+                    OGRE_FREE(compressed, MEMCATEGORY_GENERAL);
+                    throw;
+                }
+            }
+            OGRE_FREE(compressed, MEMCATEGORY_GENERAL);
+        }
+
+        if (entry.compression == PackArchive::COMPRESSION_NONE)
+        {
+            pad(mAlignment);
+            entry.offset = mOffset;
+            entry.compressedSize = size;
+            writeData(contents.getPtr(), size);
+        }
+
+        mEntries.push_back(entry);
+        mNames.push_back(name);
+    }
+    //-----------------------------------------------------------------------
+    void PackArchiveWriter::finish(void)
+    {
+        if (!mFile)
+            return;
+
+        // Sort the table of contents by name
+        vector<size_t>::type order(mEntries.size());
+        for (size_t i = 0; i < order.size(); ++i)
+            order[i] = i;
+        std::sort(order.begin(), order.end(), NameIndexLess(&mNames));
+
+        String names;
+        vector<PackArchive::PackEntry>::type entries;
+        entries.reserve(order.size());
+        for (size_t i = 0; i < order.size(); ++i)
+        {
+            const String& name = mNames[order[i]];
+            if (i && name == mNames[order[i - 1]])
+            {
+                OGRE_EXCEPT(Exception::ERR_DUPLICATE_ITEM,
+                    "File " + name + " was added to pack " + mFileName + " twice",
+                    "PackArchiveWriter::finish");
+            }
+            PackArchive::PackEntry entry = mEntries[order[i]];
+            entry.nameOffset = static_cast<uint32>(names.size());
+            entry.nameLength = static_cast<uint32>(name.size());
+            names += name;
+            flipFromLittleEndian(entry);
+            entries.push_back(entry);
+        }
+
+        PackArchive::PackHeader header;
+        header.magic = PackArchive::PACK_MAGIC;
+        header.version = PackArchive::PACK_VERSION;
+        header.entryCount = static_cast<uint32>(entries.size());
+        header.alignment = mAlignment;
+        header.namesOffset = mOffset;
+        header.namesSize = names.size();
+        if (!names.empty())
+            writeData(names.data(), names.size());
+        pad(8);
+        header.entriesOffset = mOffset;
+        if (!entries.empty())
+            writeData(&entries[0], entries.size() * sizeof(PackArchive::PackEntry));
+
+        flipFromLittleEndian(header);
+        mFile->seekp(0);
+        writeData(&header, sizeof(header));
+
+        mFile->close();
+        OGRE_DELETE_T(mFile, basic_ofstream, MEMCATEGORY_GENERAL);
+        mFile = 0;
+    }
+
+}
@@ -0,0 +1,321 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreParallelFor.h"
+#include "OgreException.h"
+#include <stdexcept>
+#include <typeinfo>
+
+namespace Ogre {
+
+	namespace
+	{
+		/// Copy of an exception thrown by an item, kept to rethrow it with its original type
+		class CaughtError : public GeneralAllocatedObject
+		{
+		public:
+			virtual ~CaughtError() {}
+			virtual void rethrow() const = 0;
+		};
+
+		template <typename T>
+		class TypedCaughtError : public CaughtError
+		{
+		public:
+			TypedCaughtError(const T& e) : mError(e) {}
+			void rethrow() const { throw mError; }
+		protected:
+			T mError;
+		};
+
+		/// State shared by the items of one ParallelFor::run call
+		struct ParallelRun
+		{
+			ParallelFor::Task* task;
+			CaughtError* error;
+			/// Number of items, the next one to start and how many have finished
+			size_t count;
+			size_t next;
+			size_t finished;
+			OGRE_MUTEX(mutex)
+
+			ParallelRun(ParallelFor::Task* t, size_t c)
+				: task(t), error(0), count(c), next(0), finished(0) {}
+			~ParallelRun()
+			{
+				OGRE_DELETE error;
+			}
+
+			/// Runs one item, keeping the first exception thrown to rethrow on the calling thread
+			void runItem(size_t index)
+			{
+				try
+				{
+					task->run(index);
+				}
+				// Most derived types first, so each is caught and copied as what it is
+				catch (UnimplementedException& e) { setError(e); }
+				catch (FileNotFoundException& e) { setError(e); }
+				catch (IOException& e) { setError(e); }
+				catch (InvalidStateException& e) { setError(e); }
+				catch (InvalidParametersException& e) { setError(e); }
+				catch (ItemIdentityException& e) { setError(e); }
+				catch (InternalErrorException& e) { setError(e); }
+				catch (RenderingAPIException& e) { setError(e); }
+				catch (RuntimeAssertionException& e) { setError(e); }
+				catch (Exception& e) { setError(e); }
+				catch (std::bad_alloc& e) { setError(e); }
+				catch (std::bad_cast& e) { setError(e); }
+				catch (std::domain_error& e) { setError(e); }
+				catch (std::invalid_argument& e) { setError(e); }
+				catch (std::length_error& e) { setError(e); }
+				catch (std::out_of_range& e) { setError(e); }
+				catch (std::logic_error& e) { setError(e); }
+				catch (std::range_error& e) { setError(e); }
+				catch (std::overflow_error& e) { setError(e); }
+				catch (std::underflow_error& e) { setError(e); }
+				catch (std::runtime_error& e) { setError(e); }
+				catch (std::exception& e)
+				{
+					setError(InternalErrorException(Exception::ERR_INTERNAL_ERROR, e.what(),
+						"ParallelFor::run", __FILE__, __LINE__));
+				}
+				catch (...)
+				{
+					setError(InternalErrorException(Exception::ERR_INTERNAL_ERROR, "Unknown exception",
+						"ParallelFor::run", __FILE__, __LINE__));
+				}
+			}
+
+			template <typename T>
+			void setError(const T& e)
+			{
+				OGRE_LOCK_MUTEX(mutex)
+				if (!error)
+					error = OGRE_NEW TypedCaughtError<T>(e);
+			}
+		};
+
+#if OGRE_THREAD_SUPPORT && OGRE_THREAD_PROVIDER != 3
+		/** Threads started on first use and kept until shutdown, which take the items
+			of all runs in progress. The thread calling run takes items of its own run
+			too, so runs started from within items can't starve.
+		*/
+		class ParallelPool
+		{
+		public:
+			ParallelPool() : mStarted(false), mShuttingDown(false) {}
+			~ParallelPool()
+			{
+				{
+					OGRE_LOCK_MUTEX(mMutex)
+					mShuttingDown = true;
+					OGRE_THREAD_NOTIFY_ALL(mWorkAvailable)
+				}
+				for (ThreadList::iterator i = mThreads.begin(); i != mThreads.end(); ++i)
+				{
+					(*i)->join();
+					OGRE_THREAD_DESTROY(*i);
+				}
+			}
+
+			/// Runs every item of a run and returns once they have all finished
+			void run(ParallelRun& parallelRun)
+			{
+				{
+					OGRE_LOCK_MUTEX(mMutex)
+					startThreads();
+					mRuns.push_back(&parallelRun);
+					OGRE_THREAD_NOTIFY_ALL(mWorkAvailable)
+				}
+
+				size_t index;
+				while (takeItem(parallelRun, index))
+				{
+					parallelRun.runItem(index);
+					finishItem(parallelRun);
+				}
+
+				// Wait for the items taken by the pool threads
+				OGRE_LOCK_MUTEX_NAMED(mMutex, runLock)
+				while (parallelRun.finished < parallelRun.count)
+					OGRE_THREAD_WAIT(mItemFinished, mMutex, runLock);
+			}
+
+			/// Body of each pool thread
+			void work()
+			{
+				for (;;)
+				{
+					ParallelRun* parallelRun = 0;
+					size_t index = 0;
+					{
+						OGRE_LOCK_MUTEX_NAMED(mMutex, workLock)
+						while (mRuns.empty() && !mShuttingDown)
+							OGRE_THREAD_WAIT(mWorkAvailable, mMutex, workLock);
+						if (mRuns.empty())
+							return;
+						parallelRun = mRuns.front();
+						index = parallelRun->next++;
+						if (parallelRun->next == parallelRun->count)
+							mRuns.pop_front();
+					}
+					parallelRun->runItem(index);
+					finishItem(*parallelRun);
+				}
+			}
+
+		protected:
+			/// Runs the body of a pool thread
+			struct Worker OGRE_THREAD_WORKER_INHERIT
+			{
+				ParallelPool* pool;
+
+				Worker(ParallelPool* p) : pool(p) {}
+				void operator()() const { pool->work(); }
+				void run() { pool->work(); }
+			};
+
+			/// Starts one thread less than there are cores, the caller being the last; mMutex must be held
+			void startThreads(void)
+			{
+				if (mStarted)
+					return;
+				mStarted = true;
+				size_t threadCount = ParallelFor::getHardwareThreadCount();
+				try
+				{
+					// Poco runs the workers by reference, so they must not move
+					mWorkers.reserve(threadCount);
+					for (size_t i = 1; i < threadCount; ++i)
+					{
+						mWorkers.push_back(Worker(this));
+						OGRE_THREAD_CREATE(t, mWorkers.back());
+						mThreads.push_back(t);
+					}
+				}
+				catch (...)
+				{
+					// Carry on with the threads there are; the callers take the remaining items
+				}
+			}
+
+			/// Takes the next item of a run if there is one left to start
+			bool takeItem(ParallelRun& parallelRun, size_t& index)
+			{
+				OGRE_LOCK_MUTEX(mMutex)
+				if (parallelRun.next == parallelRun.count)
+					return false;
+				index = parallelRun.next++;
+				if (parallelRun.next == parallelRun.count)
+					mRuns.remove(&parallelRun);
+				return true;
+			}
+
+			void finishItem(ParallelRun& parallelRun)
+			{
+				OGRE_LOCK_MUTEX(mMutex)
+				if (++parallelRun.finished == parallelRun.count)
+					OGRE_THREAD_NOTIFY_ALL(mItemFinished)
+			}
+
+			typedef list<ParallelRun*>::type RunList;
+			typedef vector<OGRE_THREAD_TYPE*>::type ThreadList;
+			/// Runs with items left to start
+			RunList mRuns;
+			vector<Worker>::type mWorkers;
+			ThreadList mThreads;
+			bool mStarted;
+			bool mShuttingDown;
+			OGRE_MUTEX(mMutex)
+			OGRE_THREAD_SYNCHRONISER(mWorkAvailable)
+			OGRE_THREAD_SYNCHRONISER(mItemFinished)
+		};
+
+		ParallelPool gParallelPool;
+#elif OGRE_THREAD_SUPPORT
+		/// Runs one item as a TBB task
+		struct ParallelItem
+		{
+			ParallelRun* parallelRun;
+			size_t index;
+
+			ParallelItem(ParallelRun* r, size_t i) : parallelRun(r), index(i) {}
+			void operator()() const { parallelRun->runItem(index); }
+		};
+#endif
+	}
+	//---------------------------------------------------------------------
+	void ParallelFor::run(Task& task, size_t count)
+	{
+		ParallelRun parallelRun(&task, count);
+#if OGRE_THREAD_SUPPORT && OGRE_THREAD_PROVIDER == 3
+		if (count > 1)
+		{
+			tbb::task_group group;
+			try
+			{
+				for (size_t i = 1; i < count; ++i)
+					group.run(ParallelItem(&parallelRun, i));
+			}
+			catch (...)
+			{
+				// The tasks already queued refer to parallelRun
+				group.wait();
+				throw;
+			}
+			parallelRun.runItem(0);
+			group.wait();
+		}
+		else if (count)
+			parallelRun.runItem(0);
+#elif OGRE_THREAD_SUPPORT
+		if (count > 1)
+			gParallelPool.run(parallelRun);
+		else if (count)
+			parallelRun.runItem(0);
+#else
+		for (size_t i = 0; i < count; ++i)
+			parallelRun.runItem(i);
+#endif
+
+		if (parallelRun.error)
+			parallelRun.error->rethrow();
+	}
+	//---------------------------------------------------------------------
+	size_t ParallelFor::getHardwareThreadCount(void)
+	{
+#if OGRE_THREAD_SUPPORT
+		size_t threads = OGRE_THREAD_HARDWARE_CONCURRENCY;
+		return threads ? threads : 1;
+#else
+		return 1;
+#endif
+	}
+
+}
@@ -39,6 +39,23 @@ THE SOFTWARE.
 *  @{
 */
 
+/**
+ * Convert one row of pixels from one type to another.
+ *
+ * @param   U       Policy class as described for PixelBoxConverter. Converters that have
+ *    a faster way of doing a whole row (usually SIMD) specialise this template.
+ */
+template <class U> struct PixelRowConverter
+{
+    static inline void conversion(const typename U::SrcType *srcptr, typename U::DstType *dstptr, size_t count)
+    {
+        for(size_t x=0; x<count; x++)
+        {
+            dstptr[x] = U::pixelConvert(srcptr[x]);
+        }
+    }
+};
+
 /**
  * Convert a box of pixel from one type to another. Who needs automatic code 
  * generation when we have C++ templates and the policy design pattern.
@@ -64,10 +81,7 @@ template <class U> struct PixelBoxConverter
         {
             for(size_t y=src.top; y<src.bottom; y++)
             {
-                for(size_t x=0; x<k; x++)
-                {
-                    dstptr[x] = U::pixelConvert(srcptr[x]);
-                }
+                PixelRowConverter<U>::conversion(srcptr, dstptr, k);
                 srcptr += src.rowPitch;
                 dstptr += dst.rowPitch;
             }
@@ -104,6 +118,18 @@ struct Col4f {
 		r(inR), g(inG), b(inB), a(inA) { }
 	float r,g,b,a;
 };
+/** Type for PF_FLOAT16_RGBA */
+struct Col4h {
+	Col4h(Ogre::uint16 inR, Ogre::uint16 inG, Ogre::uint16 inB, Ogre::uint16 inA):
+		r(inR), g(inG), b(inB), a(inA) { }
+	Ogre::uint16 r,g,b,a;
+};
+/** Type for PF_BYTE_LA */
+struct Col2b {
+	Col2b(unsigned int inL, unsigned int inA):
+		l((Ogre::uint8)inL), a((Ogre::uint8)inA) { }
+	Ogre::uint8 l,a;
+};
 
 struct A8R8G8B8toA8B8G8R8: public PixelConverter <Ogre::uint32, Ogre::uint32, FMTCONVERTERID(Ogre::PF_A8R8G8B8, Ogre::PF_A8B8G8R8)>
 {
@@ -379,6 +405,382 @@ struct X8B8G8R8toR8G8B8A8: public PixelConverter <Ogre::uint32, Ogre::uint32, FM
 };
 
 
+struct L8toR8G8B8A8: public PixelConverter <Ogre::uint8, Ogre::uint32, FMTCONVERTERID(Ogre::PF_L8, Ogre::PF_R8G8B8A8)>
+{
+    inline static DstType pixelConvert(SrcType inp)
+    {
+        return 0x000000FF|(((unsigned int)inp)<<8)|(((unsigned int)inp)<<16)|(((unsigned int)inp)<<24);
+    }
+};
+
+// A8 to formats with colour, the colour channels are black
+struct A8toA8R8G8B8: public PixelConverter <Ogre::uint8, Ogre::uint32, FMTCONVERTERID(Ogre::PF_A8, Ogre::PF_A8R8G8B8)>
+{
+    inline static DstType pixelConvert(SrcType inp)
+    {
+        return ((unsigned int)inp)<<24;
+    }
+};
+struct A8toA8B8G8R8: public PixelConverter <Ogre::uint8, Ogre::uint32, FMTCONVERTERID(Ogre::PF_A8, Ogre::PF_A8B8G8R8)>
+{
+    inline static DstType pixelConvert(SrcType inp)
+    {
+        return ((unsigned int)inp)<<24;
+    }
+};
+struct A8toB8G8R8A8: public PixelConverter <Ogre::uint8, Ogre::uint32, FMTCONVERTERID(Ogre::PF_A8, Ogre::PF_B8G8R8A8)>
+{
+    inline static DstType pixelConvert(SrcType inp)
+    {
+        return (unsigned int)inp;
+    }
+};
+struct A8toR8G8B8A8: public PixelConverter <Ogre::uint8, Ogre::uint32, FMTCONVERTERID(Ogre::PF_A8, Ogre::PF_R8G8B8A8)>
+{
+    inline static DstType pixelConvert(SrcType inp)
+    {
+        return (unsigned int)inp;
+    }
+};
+
+struct ByteLAtoA8B8G8R8: public PixelConverter <Col2b, Ogre::uint32, FMTCONVERTERID(Ogre::PF_BYTE_LA, Ogre::PF_A8B8G8R8)>
+{
+    inline static DstType pixelConvert(const SrcType &inp)
+    {
+        return (((unsigned int)inp.a)<<24)|(((unsigned int)inp.l)<<16)|(((unsigned int)inp.l)<<8)|((unsigned int)inp.l);
+    }
+};
+struct ByteLAtoA8R8G8B8: public PixelConverter <Col2b, Ogre::uint32, FMTCONVERTERID(Ogre::PF_BYTE_LA, Ogre::PF_A8R8G8B8)>
+{
+    inline static DstType pixelConvert(const SrcType &inp)
+    {
+        return (((unsigned int)inp.a)<<24)|(((unsigned int)inp.l)<<16)|(((unsigned int)inp.l)<<8)|((unsigned int)inp.l);
+    }
+};
+
+// 8 bit channels at rshift, gshift, bshift, ashift <-> PF_FLOAT32_RGBA
+// These round exactly like PixelUtil::packColour and unpackColour do.
+template <int id, unsigned int rshift, unsigned int gshift, unsigned int bshift, unsigned int ashift> struct Uint32toCol4f:
+    public PixelConverter <Ogre::uint32, Col4f, id>
+{
+    inline static Col4f pixelConvert(Ogre::uint32 inp)
+    {
+        return Col4f(Ogre::Bitwise::fixedToFloat((inp>>rshift)&0xFF, 8),
+            Ogre::Bitwise::fixedToFloat((inp>>gshift)&0xFF, 8),
+            Ogre::Bitwise::fixedToFloat((inp>>bshift)&0xFF, 8),
+            Ogre::Bitwise::fixedToFloat((inp>>ashift)&0xFF, 8));
+    }
+};
+template <int id, unsigned int rshift, unsigned int gshift, unsigned int bshift, unsigned int ashift> struct Col4ftoUint32:
+    public PixelConverter <Col4f, Ogre::uint32, id>
+{
+    inline static Ogre::uint32 pixelConvert(const Col4f &inp)
+    {
+        return ((Ogre::Bitwise::floatToFixed(inp.r, 8)&0xFF)<<rshift) |
+            ((Ogre::Bitwise::floatToFixed(inp.g, 8)&0xFF)<<gshift) |
+            ((Ogre::Bitwise::floatToFixed(inp.b, 8)&0xFF)<<bshift) |
+            ((Ogre::Bitwise::floatToFixed(inp.a, 8)&0xFF)<<ashift);
+    }
+};
+
+struct A8R8G8B8toFloat32RGBA: public Uint32toCol4f<FMTCONVERTERID(Ogre::PF_A8R8G8B8, Ogre::PF_FLOAT32_RGBA), 16, 8, 0, 24> { };
+struct A8B8G8R8toFloat32RGBA: public Uint32toCol4f<FMTCONVERTERID(Ogre::PF_A8B8G8R8, Ogre::PF_FLOAT32_RGBA), 0, 8, 16, 24> { };
+struct B8G8R8A8toFloat32RGBA: public Uint32toCol4f<FMTCONVERTERID(Ogre::PF_B8G8R8A8, Ogre::PF_FLOAT32_RGBA), 8, 16, 24, 0> { };
+struct R8G8B8A8toFloat32RGBA: public Uint32toCol4f<FMTCONVERTERID(Ogre::PF_R8G8B8A8, Ogre::PF_FLOAT32_RGBA), 24, 16, 8, 0> { };
+struct Float32RGBAtoA8R8G8B8: public Col4ftoUint32<FMTCONVERTERID(Ogre::PF_FLOAT32_RGBA, Ogre::PF_A8R8G8B8), 16, 8, 0, 24> { };
+struct Float32RGBAtoA8B8G8R8: public Col4ftoUint32<FMTCONVERTERID(Ogre::PF_FLOAT32_RGBA, Ogre::PF_A8B8G8R8), 0, 8, 16, 24> { };
+struct Float32RGBAtoB8G8R8A8: public Col4ftoUint32<FMTCONVERTERID(Ogre::PF_FLOAT32_RGBA, Ogre::PF_B8G8R8A8), 8, 16, 24, 0> { };
+struct Float32RGBAtoR8G8B8A8: public Col4ftoUint32<FMTCONVERTERID(Ogre::PF_FLOAT32_RGBA, Ogre::PF_R8G8B8A8), 24, 16, 8, 0> { };
+
+// 8 bit channels at rshift, gshift, bshift, ashift <-> PF_FLOAT16_RGBA
+template <int id, unsigned int rshift, unsigned int gshift, unsigned int bshift, unsigned int ashift> struct Uint32toCol4h:
+    public PixelConverter <Ogre::uint32, Col4h, id>
+{
+    inline static Col4h pixelConvert(Ogre::uint32 inp)
+    {
+        return Col4h(Ogre::Bitwise::floatToHalf(Ogre::Bitwise::fixedToFloat((inp>>rshift)&0xFF, 8)),
+            Ogre::Bitwise::floatToHalf(Ogre::Bitwise::fixedToFloat((inp>>gshift)&0xFF, 8)),
+            Ogre::Bitwise::floatToHalf(Ogre::Bitwise::fixedToFloat((inp>>bshift)&0xFF, 8)),
+            Ogre::Bitwise::floatToHalf(Ogre::Bitwise::fixedToFloat((inp>>ashift)&0xFF, 8)));
+    }
+};
+template <int id, unsigned int rshift, unsigned int gshift, unsigned int bshift, unsigned int ashift> struct Col4htoUint32:
+    public PixelConverter <Col4h, Ogre::uint32, id>
+{
+    inline static Ogre::uint32 pixelConvert(const Col4h &inp)
+    {
+        return ((Ogre::Bitwise::floatToFixed(Ogre::Bitwise::halfToFloat(inp.r), 8)&0xFF)<<rshift) |
+            ((Ogre::Bitwise::floatToFixed(Ogre::Bitwise::halfToFloat(inp.g), 8)&0xFF)<<gshift) |
+            ((Ogre::Bitwise::floatToFixed(Ogre::Bitwise::halfToFloat(inp.b), 8)&0xFF)<<bshift) |
+            ((Ogre::Bitwise::floatToFixed(Ogre::Bitwise::halfToFloat(inp.a), 8)&0xFF)<<ashift);
+    }
+};
+
+struct A8R8G8B8toFloat16RGBA: public Uint32toCol4h<FMTCONVERTERID(Ogre::PF_A8R8G8B8, Ogre::PF_FLOAT16_RGBA), 16, 8, 0, 24> { };
+struct A8B8G8R8toFloat16RGBA: public Uint32toCol4h<FMTCONVERTERID(Ogre::PF_A8B8G8R8, Ogre::PF_FLOAT16_RGBA), 0, 8, 16, 24> { };
+struct B8G8R8A8toFloat16RGBA: public Uint32toCol4h<FMTCONVERTERID(Ogre::PF_B8G8R8A8, Ogre::PF_FLOAT16_RGBA), 8, 16, 24, 0> { };
+struct R8G8B8A8toFloat16RGBA: public Uint32toCol4h<FMTCONVERTERID(Ogre::PF_R8G8B8A8, Ogre::PF_FLOAT16_RGBA), 24, 16, 8, 0> { };
+struct Float16RGBAtoA8R8G8B8: public Col4htoUint32<FMTCONVERTERID(Ogre::PF_FLOAT16_RGBA, Ogre::PF_A8R8G8B8), 16, 8, 0, 24> { };
+struct Float16RGBAtoA8B8G8R8: public Col4htoUint32<FMTCONVERTERID(Ogre::PF_FLOAT16_RGBA, Ogre::PF_A8B8G8R8), 0, 8, 16, 24> { };
+struct Float16RGBAtoB8G8R8A8: public Col4htoUint32<FMTCONVERTERID(Ogre::PF_FLOAT16_RGBA, Ogre::PF_B8G8R8A8), 8, 16, 24, 0> { };
+struct Float16RGBAtoR8G8B8A8: public Col4htoUint32<FMTCONVERTERID(Ogre::PF_FLOAT16_RGBA, Ogre::PF_R8G8B8A8), 24, 16, 8, 0> { };
+
+// PF_BYTE_RGB/PF_BYTE_BGR <-> PF_FLOAT32_RGB, Col3b is in memory order
+struct ByteRGBtoFloat32RGB: public PixelConverter <Col3b, Col3f, FMTCONVERTERID(Ogre::PF_BYTE_RGB, Ogre::PF_FLOAT32_RGB)>
+{
+    inline static DstType pixelConvert(const SrcType &inp)
+    {
+        return Col3f(Ogre::Bitwise::fixedToFloat(inp.x, 8), Ogre::Bitwise::fixedToFloat(inp.y, 8),
+            Ogre::Bitwise::fixedToFloat(inp.z, 8));
+    }
+};
+struct ByteBGRtoFloat32RGB: public PixelConverter <Col3b, Col3f, FMTCONVERTERID(Ogre::PF_BYTE_BGR, Ogre::PF_FLOAT32_RGB)>
+{
+    inline static DstType pixelConvert(const SrcType &inp)
+    {
+        return Col3f(Ogre::Bitwise::fixedToFloat(inp.z, 8), Ogre::Bitwise::fixedToFloat(inp.y, 8),
+            Ogre::Bitwise::fixedToFloat(inp.x, 8));
+    }
+};
+struct Float32RGBtoByteRGB: public PixelConverter <Col3f, Col3b, FMTCONVERTERID(Ogre::PF_FLOAT32_RGB, Ogre::PF_BYTE_RGB)>
+{
+    inline static DstType pixelConvert(const SrcType &inp)
+    {
+        return Col3b(Ogre::Bitwise::floatToFixed(inp.r, 8), Ogre::Bitwise::floatToFixed(inp.g, 8),
+            Ogre::Bitwise::floatToFixed(inp.b, 8));
+    }
+};
+struct Float32RGBtoByteBGR: public PixelConverter <Col3f, Col3b, FMTCONVERTERID(Ogre::PF_FLOAT32_RGB, Ogre::PF_BYTE_BGR)>
+{
+    inline static DstType pixelConvert(const SrcType &inp)
+    {
+        return Col3b(Ogre::Bitwise::floatToFixed(inp.b, 8), Ogre::Bitwise::floatToFixed(inp.g, 8),
+            Ogre::Bitwise::floatToFixed(inp.r, 8));
+    }
+};
+
+#if OGRE_PIXELCONVERSION_SSE2
+/*
+ * SSE2 row converters. All of them work on four 32 bit pixels at a time and leave
+ * whatever does not fill a whole vector to U::pixelConvert. x86 is little endian,
+ * so byte n of a 32 bit lane is byte n of the pixel in memory.
+ */
+
+/// Looked up once during static initialisation, before any conversion thread runs
+const bool gPixelConversionHasSSE2 = (Ogre::PlatformInformation::getCpuFeatures() &
+    Ogre::PlatformInformation::CPU_FEATURE_SSE2) != 0;
+
+/// Moves byte S of every 32 bit lane to byte D and clears the others
+template <int S, int D> inline __m128i moveByte32SSE2(__m128i v)
+{
+    if(D > S)
+        v = _mm_slli_epi32(v, (D > S ? D - S : 0) * 8);
+    else if(S > D)
+        v = _mm_srli_epi32(v, (S > D ? S - D : 0) * 8);
+    return _mm_and_si128(v, _mm_set1_epi32((int)(0xFFu << (D * 8))));
+}
+
+/// Moves bytes 0, 1, 2 and 3 of every 32 bit lane to bytes D0, D1, D2 and D3
+template <int D0, int D1, int D2, int D3> inline __m128i swizzleBytes32SSE2(__m128i v)
+{
+    if(D0 == 0 && D1 == 1 && D2 == 2 && D3 == 3)
+        return v;
+    return _mm_or_si128(
+        _mm_or_si128(moveByte32SSE2<0, D0>(v), moveByte32SSE2<1, D1>(v)),
+        _mm_or_si128(moveByte32SSE2<2, D2>(v), moveByte32SSE2<3, D3>(v)));
+}
+
+/// 32 bit to 32 bit formats: swizzle the bytes, then set orMask
+template <class U, int D0, int D1, int D2, int D3, Ogre::uint32 orMask> struct Uint32SwizzleRowConverter
+{
+    static inline void conversion(const Ogre::uint32 *srcptr, Ogre::uint32 *dstptr, size_t count)
+    {
+        size_t x = 0;
+        if(gPixelConversionHasSSE2)
+        {
+            const __m128i orBits = _mm_set1_epi32((int)orMask);
+            for(; x + 4 <= count; x += 4)
+            {
+                const __m128i v = _mm_loadu_si128((const __m128i*)(srcptr + x));
+                _mm_storeu_si128((__m128i*)(dstptr + x), _mm_or_si128(swizzleBytes32SSE2<D0, D1, D2, D3>(v), orBits));
+            }
+        }
+        for(; x < count; x++)
+        {
+            dstptr[x] = U::pixelConvert(srcptr[x]);
+        }
+    }
+};
+
+/// 8 bit to 32 bit formats: copy the byte to all four bytes, keep keepMask, then set orMask
+template <class U, Ogre::uint32 keepMask, Ogre::uint32 orMask> struct Uint8ExpandRowConverter
+{
+    static inline void conversion(const Ogre::uint8 *srcptr, Ogre::uint32 *dstptr, size_t count)
+    {
+        size_t x = 0;
+        if(gPixelConversionHasSSE2)
+        {
+            const __m128i keepBits = _mm_set1_epi32((int)keepMask);
+            const __m128i orBits = _mm_set1_epi32((int)orMask);
+            for(; x + 16 <= count; x += 16)
+            {
+                const __m128i v = _mm_loadu_si128((const __m128i*)(srcptr + x));
+                const __m128i lo = _mm_unpacklo_epi8(v, v);
+                const __m128i hi = _mm_unpackhi_epi8(v, v);
+                _mm_storeu_si128((__m128i*)(dstptr + x),
+                    _mm_or_si128(_mm_and_si128(_mm_unpacklo_epi16(lo, lo), keepBits), orBits));
+                _mm_storeu_si128((__m128i*)(dstptr + x + 4),
+                    _mm_or_si128(_mm_and_si128(_mm_unpackhi_epi16(lo, lo), keepBits), orBits));
+                _mm_storeu_si128((__m128i*)(dstptr + x + 8),
+                    _mm_or_si128(_mm_and_si128(_mm_unpacklo_epi16(hi, hi), keepBits), orBits));
+                _mm_storeu_si128((__m128i*)(dstptr + x + 12),
+                    _mm_or_si128(_mm_and_si128(_mm_unpackhi_epi16(hi, hi), keepBits), orBits));
+            }
+        }
+        for(; x < count; x++)
+        {
+            dstptr[x] = U::pixelConvert(srcptr[x]);
+        }
+    }
+};
+
+/// 24 bit to 32 bit formats: bytes 0, 1 and 2 go to D0, D1 and D2, byte DA becomes 0xFF
+template <class U, int D0, int D1, int D2, int DA> struct Col3bExpandRowConverter
+{
+    static inline void conversion(const Col3b *srcptr, Ogre::uint32 *dstptr, size_t count)
+    {
+        size_t x = 0;
+        if(gPixelConversionHasSSE2)
+        {
+            const Ogre::uint8 *src = reinterpret_cast<const Ogre::uint8*>(srcptr);
+            const __m128i alpha = _mm_set1_epi32((int)(0xFFu << (DA * 8)));
+            // Each load reads 16 bytes to use 12, so stop while that stays inside the row
+            for(; x + 6 <= count; x += 4)
+            {
+                const __m128i v = _mm_loadu_si128((const __m128i*)(src + x * 3));
+                const __m128i p01 = _mm_unpacklo_epi32(v, _mm_srli_si128(v, 3));
+                const __m128i p23 = _mm_unpacklo_epi32(_mm_srli_si128(v, 6), _mm_srli_si128(v, 9));
+                const __m128i p = _mm_unpacklo_epi64(p01, p23);
+                _mm_storeu_si128((__m128i*)(dstptr + x), _mm_or_si128(swizzleBytes32SSE2<D0, D1, D2, DA>(p), alpha));
+            }
+        }
+        for(; x < count; x++)
+        {
+            dstptr[x] = U::pixelConvert(srcptr[x]);
+        }
+    }
+};
+
+/// 32 bit formats to PF_FLOAT32_RGBA: bytes 0, 1, 2 and 3 hold channel D0, D1, D2 and D3 (r = 0, a = 3)
+template <class U, int D0, int D1, int D2, int D3> struct Col4fUnpackRowConverter
+{
+    static inline void conversion(const Ogre::uint32 *srcptr, Col4f *dstptr, size_t count)
+    {
+        size_t x = 0;
+        if(gPixelConversionHasSSE2)
+        {
+            float *dst = reinterpret_cast<float*>(dstptr);
+            const __m128i zero = _mm_setzero_si128();
+            const __m128 scale = _mm_set1_ps(255.0f);
+            for(; x + 4 <= count; x += 4)
+            {
+                const __m128i v = swizzleBytes32SSE2<D0, D1, D2, D3>(_mm_loadu_si128((const __m128i*)(srcptr + x)));
+                const __m128i lo = _mm_unpacklo_epi8(v, zero);
+                const __m128i hi = _mm_unpackhi_epi8(v, zero);
+                // A real division, to give the same result as Bitwise::fixedToFloat
+                _mm_storeu_ps(dst + x * 4, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), scale));
+                _mm_storeu_ps(dst + x * 4 + 4, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), scale));
+                _mm_storeu_ps(dst + x * 4 + 8, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), scale));
+                _mm_storeu_ps(dst + x * 4 + 12, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), scale));
+            }
+        }
+        for(; x < count; x++)
+        {
+            dstptr[x] = U::pixelConvert(srcptr[x]);
+        }
+    }
+};
+
+/// PF_FLOAT32_RGBA to 32 bit formats: r, g, b and a go to bytes DR, DG, DB and DA
+template <class U, int DR, int DG, int DB, int DA> struct Col4fPackRowConverter
+{
+    static inline void conversion(const Col4f *srcptr, Ogre::uint32 *dstptr, size_t count)
+    {
+        size_t x = 0;
+        if(gPixelConversionHasSSE2)
+        {
+            const float *src = reinterpret_cast<const float*>(srcptr);
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 one = _mm_set1_ps(1.0f);
+            const __m128 scale = _mm_set1_ps(256.0f);
+            for(; x + 4 <= count; x += 4)
+            {
+                // Clamp, scale by 256 and truncate like Bitwise::floatToFixed; 1.0 gives 256,
+                // which the unsigned saturation turns into 255. maxps returns 0 for NaN.
+                __m128i c[4];
+                for(size_t i = 0; i < 4; ++i)
+                {
+                    const __m128 v = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + (x + i) * 4), zero), one);
+                    c[i] = _mm_cvttps_epi32(_mm_mul_ps(v, scale));
+                }
+                const __m128i bytes = _mm_packus_epi16(_mm_packs_epi32(c[0], c[1]), _mm_packs_epi32(c[2], c[3]));
+                _mm_storeu_si128((__m128i*)(dstptr + x), swizzleBytes32SSE2<DR, DG, DB, DA>(bytes));
+            }
+        }
+        for(; x < count; x++)
+        {
+            dstptr[x] = U::pixelConvert(srcptr[x]);
+        }
+    }
+};
+
+template <> struct PixelRowConverter<A8R8G8B8toA8B8G8R8>: public Uint32SwizzleRowConverter<A8R8G8B8toA8B8G8R8, 2, 1, 0, 3, 0> { };
+template <> struct PixelRowConverter<A8R8G8B8toB8G8R8A8>: public Uint32SwizzleRowConverter<A8R8G8B8toB8G8R8A8, 3, 2, 1, 0, 0> { };
+template <> struct PixelRowConverter<A8R8G8B8toR8G8B8A8>: public Uint32SwizzleRowConverter<A8R8G8B8toR8G8B8A8, 1, 2, 3, 0, 0> { };
+template <> struct PixelRowConverter<A8B8G8R8toA8R8G8B8>: public Uint32SwizzleRowConverter<A8B8G8R8toA8R8G8B8, 2, 1, 0, 3, 0> { };
+template <> struct PixelRowConverter<A8B8G8R8toB8G8R8A8>: public Uint32SwizzleRowConverter<A8B8G8R8toB8G8R8A8, 1, 2, 3, 0, 0> { };
+template <> struct PixelRowConverter<A8B8G8R8toR8G8B8A8>: public Uint32SwizzleRowConverter<A8B8G8R8toR8G8B8A8, 3, 2, 1, 0, 0> { };
+template <> struct PixelRowConverter<B8G8R8A8toA8R8G8B8>: public Uint32SwizzleRowConverter<B8G8R8A8toA8R8G8B8, 3, 2, 1, 0, 0> { };
+template <> struct PixelRowConverter<B8G8R8A8toA8B8G8R8>: public Uint32SwizzleRowConverter<B8G8R8A8toA8B8G8R8, 3, 0, 1, 2, 0> { };
+template <> struct PixelRowConverter<B8G8R8A8toR8G8B8A8>: public Uint32SwizzleRowConverter<B8G8R8A8toR8G8B8A8, 0, 3, 2, 1, 0> { };
+template <> struct PixelRowConverter<R8G8B8A8toA8R8G8B8>: public Uint32SwizzleRowConverter<R8G8B8A8toA8R8G8B8, 3, 0, 1, 2, 0> { };
+template <> struct PixelRowConverter<R8G8B8A8toA8B8G8R8>: public Uint32SwizzleRowConverter<R8G8B8A8toA8B8G8R8, 3, 2, 1, 0, 0> { };
+template <> struct PixelRowConverter<R8G8B8A8toB8G8R8A8>: public Uint32SwizzleRowConverter<R8G8B8A8toB8G8R8A8, 0, 3, 2, 1, 0> { };
+template <> struct PixelRowConverter<X8R8G8B8toA8R8G8B8>: public Uint32SwizzleRowConverter<X8R8G8B8toA8R8G8B8, 0, 1, 2, 3, 0xFF000000> { };
+template <> struct PixelRowConverter<X8R8G8B8toA8B8G8R8>: public Uint32SwizzleRowConverter<X8R8G8B8toA8B8G8R8, 2, 1, 0, 3, 0xFF000000> { };
+template <> struct PixelRowConverter<X8R8G8B8toB8G8R8A8>: public Uint32SwizzleRowConverter<X8R8G8B8toB8G8R8A8, 3, 2, 1, 0, 0x000000FF> { };
+template <> struct PixelRowConverter<X8R8G8B8toR8G8B8A8>: public Uint32SwizzleRowConverter<X8R8G8B8toR8G8B8A8, 1, 2, 3, 0, 0x000000FF> { };
+template <> struct PixelRowConverter<X8B8G8R8toA8R8G8B8>: public Uint32SwizzleRowConverter<X8B8G8R8toA8R8G8B8, 2, 1, 0, 3, 0xFF000000> { };
+template <> struct PixelRowConverter<X8B8G8R8toA8B8G8R8>: public Uint32SwizzleRowConverter<X8B8G8R8toA8B8G8R8, 0, 1, 2, 3, 0xFF000000> { };
+template <> struct PixelRowConverter<X8B8G8R8toB8G8R8A8>: public Uint32SwizzleRowConverter<X8B8G8R8toB8G8R8A8, 1, 2, 3, 0, 0x000000FF> { };
+template <> struct PixelRowConverter<X8B8G8R8toR8G8B8A8>: public Uint32SwizzleRowConverter<X8B8G8R8toR8G8B8A8, 3, 2, 1, 0, 0x000000FF> { };
+
+template <> struct PixelRowConverter<L8toA8B8G8R8>: public Uint8ExpandRowConverter<L8toA8B8G8R8, 0x00FFFFFF, 0xFF000000> { };
+template <> struct PixelRowConverter<L8toA8R8G8B8>: public Uint8ExpandRowConverter<L8toA8R8G8B8, 0x00FFFFFF, 0xFF000000> { };
+template <> struct PixelRowConverter<L8toB8G8R8A8>: public Uint8ExpandRowConverter<L8toB8G8R8A8, 0xFFFFFF00, 0x000000FF> { };
+template <> struct PixelRowConverter<L8toR8G8B8A8>: public Uint8ExpandRowConverter<L8toR8G8B8A8, 0xFFFFFF00, 0x000000FF> { };
+template <> struct PixelRowConverter<A8toA8R8G8B8>: public Uint8ExpandRowConverter<A8toA8R8G8B8, 0xFF000000, 0> { };
+template <> struct PixelRowConverter<A8toA8B8G8R8>: public Uint8ExpandRowConverter<A8toA8B8G8R8, 0xFF000000, 0> { };
+template <> struct PixelRowConverter<A8toB8G8R8A8>: public Uint8ExpandRowConverter<A8toB8G8R8A8, 0x000000FF, 0> { };
+template <> struct PixelRowConverter<A8toR8G8B8A8>: public Uint8ExpandRowConverter<A8toR8G8B8A8, 0x000000FF, 0> { };
+
+template <> struct PixelRowConverter<R8G8B8toA8R8G8B8>: public Col3bExpandRowConverter<R8G8B8toA8R8G8B8, 0, 1, 2, 3> { };
+template <> struct PixelRowConverter<B8G8R8toA8R8G8B8>: public Col3bExpandRowConverter<B8G8R8toA8R8G8B8, 2, 1, 0, 3> { };
+template <> struct PixelRowConverter<R8G8B8toA8B8G8R8>: public Col3bExpandRowConverter<R8G8B8toA8B8G8R8, 2, 1, 0, 3> { };
+template <> struct PixelRowConverter<B8G8R8toA8B8G8R8>: public Col3bExpandRowConverter<B8G8R8toA8B8G8R8, 0, 1, 2, 3> { };
+template <> struct PixelRowConverter<R8G8B8toB8G8R8A8>: public Col3bExpandRowConverter<R8G8B8toB8G8R8A8, 3, 2, 1, 0> { };
+template <> struct PixelRowConverter<B8G8R8toB8G8R8A8>: public Col3bExpandRowConverter<B8G8R8toB8G8R8A8, 1, 2, 3, 0> { };
+
+template <> struct PixelRowConverter<A8R8G8B8toFloat32RGBA>: public Col4fUnpackRowConverter<A8R8G8B8toFloat32RGBA, 2, 1, 0, 3> { };
+template <> struct PixelRowConverter<A8B8G8R8toFloat32RGBA>: public Col4fUnpackRowConverter<A8B8G8R8toFloat32RGBA, 0, 1, 2, 3> { };
+template <> struct PixelRowConverter<B8G8R8A8toFloat32RGBA>: public Col4fUnpackRowConverter<B8G8R8A8toFloat32RGBA, 3, 0, 1, 2> { };
+template <> struct PixelRowConverter<R8G8B8A8toFloat32RGBA>: public Col4fUnpackRowConverter<R8G8B8A8toFloat32RGBA, 3, 2, 1, 0> { };
+template <> struct PixelRowConverter<Float32RGBAtoA8R8G8B8>: public Col4fPackRowConverter<Float32RGBAtoA8R8G8B8, 2, 1, 0, 3> { };
+template <> struct PixelRowConverter<Float32RGBAtoA8B8G8R8>: public Col4fPackRowConverter<Float32RGBAtoA8B8G8R8, 0, 1, 2, 3> { };
+template <> struct PixelRowConverter<Float32RGBAtoB8G8R8A8>: public Col4fPackRowConverter<Float32RGBAtoB8G8R8A8, 1, 2, 3, 0> { };
+template <> struct PixelRowConverter<Float32RGBAtoR8G8B8A8>: public Col4fPackRowConverter<Float32RGBAtoR8G8B8A8, 3, 2, 1, 0> { };
+#endif // OGRE_PIXELCONVERSION_SSE2
+
 #define CASECONVERTER(type) case type::ID : PixelBoxConverter<type>::conversion(src, dst); return 1;
 
 inline int doOptimizedConversion(const Ogre::PixelBox &src, const Ogre::PixelBox &dst)
@@ -424,6 +826,33 @@ inline int doOptimizedConversion(const Ogre::PixelBox &src, const Ogre::PixelBox
 		CASECONVERTER(X8B8G8R8toA8B8G8R8);
 		CASECONVERTER(X8B8G8R8toB8G8R8A8);
 		CASECONVERTER(X8B8G8R8toR8G8B8A8);
+        CASECONVERTER(L8toR8G8B8A8);
+        CASECONVERTER(A8toA8R8G8B8);
+        CASECONVERTER(A8toA8B8G8R8);
+        CASECONVERTER(A8toB8G8R8A8);
+        CASECONVERTER(A8toR8G8B8A8);
+        CASECONVERTER(ByteLAtoA8B8G8R8);
+        CASECONVERTER(ByteLAtoA8R8G8B8);
+        CASECONVERTER(A8R8G8B8toFloat32RGBA);
+        CASECONVERTER(A8B8G8R8toFloat32RGBA);
+        CASECONVERTER(B8G8R8A8toFloat32RGBA);
+        CASECONVERTER(R8G8B8A8toFloat32RGBA);
+        CASECONVERTER(Float32RGBAtoA8R8G8B8);
+        CASECONVERTER(Float32RGBAtoA8B8G8R8);
+        CASECONVERTER(Float32RGBAtoB8G8R8A8);
+        CASECONVERTER(Float32RGBAtoR8G8B8A8);
+        CASECONVERTER(A8R8G8B8toFloat16RGBA);
+        CASECONVERTER(A8B8G8R8toFloat16RGBA);
+        CASECONVERTER(B8G8R8A8toFloat16RGBA);
+        CASECONVERTER(R8G8B8A8toFloat16RGBA);
+        CASECONVERTER(Float16RGBAtoA8R8G8B8);
+        CASECONVERTER(Float16RGBAtoA8B8G8R8);
+        CASECONVERTER(Float16RGBAtoB8G8R8A8);
+        CASECONVERTER(Float16RGBAtoR8G8B8A8);
+        CASECONVERTER(ByteRGBtoFloat32RGB);
+        CASECONVERTER(ByteBGRtoFloat32RGB);
+        CASECONVERTER(Float32RGBtoByteRGB);
+        CASECONVERTER(Float32RGBtoByteBGR);
 
         default:
             return 0;
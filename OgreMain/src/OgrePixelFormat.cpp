@@ -30,7 +30,16 @@ THE SOFTWARE.
 #include "OgreBitwise.h"
 #include "OgreColourValue.h"
 #include "OgreException.h"
+#include "OgrePlatformInformation.h"
+#include "OgreParallelFor.h"
 
+// SSE2 row converters in OgrePixelConversions.h. 32 bit gcc builds only get -msse.
+#if __OGRE_HAVE_SSE && (OGRE_COMPILER == OGRE_COMPILER_MSVC || defined(__SSE2__))
+#   define OGRE_PIXELCONVERSION_SSE2 1
+#   include <emmintrin.h>
+#else
+#   define OGRE_PIXELCONVERSION_SSE2 0
+#endif
 
 namespace {
 #include "OgrePixelConversions.h"
@@ -1907,6 +1916,73 @@ namespace Ogre {
         }
     }
     //-----------------------------------------------------------------------
+    namespace
+    {
+        /// Converts with an optimised converter if there is one, otherwise pixel by pixel
+        void convertPixels(const PixelBox &src, const PixelBox &dst)
+        {
+// NB VC6 can't handle the templates required for optimised conversion, tough
+#if OGRE_COMPILER != OGRE_COMPILER_MSVC || OGRE_COMP_VER >= 1300
+            // Is there a specialized, inlined, conversion?
+            if(doOptimizedConversion(src, dst))
+            {
+                // If so, good
+                return;
+            }
+#endif
+
+            const size_t srcPixelSize = PixelUtil::getNumElemBytes(src.format);
+            const size_t dstPixelSize = PixelUtil::getNumElemBytes(dst.format);
+            uint8 *srcptr = static_cast<uint8*>(src.data)
+                + (src.left + src.top * src.rowPitch + src.front * src.slicePitch) * srcPixelSize;
+            uint8 *dstptr = static_cast<uint8*>(dst.data)
+                + (dst.left + dst.top * dst.rowPitch + dst.front * dst.slicePitch) * dstPixelSize;
+
+            // Old way, not taking into account box dimensions
+            //uint8 *srcptr = static_cast<uint8*>(src.data), *dstptr = static_cast<uint8*>(dst.data);
+
+            // Calculate pitches+skips in bytes
+            const size_t srcRowSkipBytes = src.getRowSkip()*srcPixelSize;
+            const size_t srcSliceSkipBytes = src.getSliceSkip()*srcPixelSize;
+            const size_t dstRowSkipBytes = dst.getRowSkip()*dstPixelSize;
+            const size_t dstSliceSkipBytes = dst.getSliceSkip()*dstPixelSize;
+
+            // The brute force fallback
+            float r = 0, g = 0, b = 0, a = 1;
+            for(size_t z=src.front; z<src.back; z++)
+            {
+                for(size_t y=src.top; y<src.bottom; y++)
+                {
+                    for(size_t x=src.left; x<src.right; x++)
+                    {
+                        PixelUtil::unpackColour(&r, &g, &b, &a, src.format, srcptr);
+                        PixelUtil::packColour(r, g, b, a, dst.format, dstptr);
+                        srcptr += srcPixelSize;
+                        dstptr += dstPixelSize;
+                    }
+                    srcptr += srcRowSkipBytes;
+                    dstptr += dstRowSkipBytes;
+                }
+                srcptr += srcSliceSkipBytes;
+                dstptr += dstSliceSkipBytes;
+            }
+        }
+        //-----------------------------------------------------------------------
+        /// Converts one band of a large PixelBox, see PixelUtil::bulkPixelConversion
+        struct PixelConversionWorker
+        {
+            PixelBox src;
+            PixelBox dst;
+
+            PixelConversionWorker(const PixelBox &s, const PixelBox &d)
+                : src(s), dst(d) {}
+
+            void run() { convertPixels(src, dst); }
+        };
+    }
+    //-----------------------------------------------------------------------
+    size_t PixelUtil::msBulkConversionThreads = 0;
+    //-----------------------------------------------------------------------
     /* Convert pixels from one format to another */
     void PixelUtil::bulkPixelConversion(void *srcp, PixelFormat srcFormat,
         void *destp, PixelFormat dstFormat, unsigned int count)
@@ -1923,7 +1999,7 @@ namespace Ogre {
 			   src.getHeight() == dst.getHeight() &&
 			   src.getDepth() == dst.getDepth());
 
-		// Check for compressed formats, we don't support decompression, compression or recoding
+		// Check for compressed formats, we don't support decompression or recoding
 		if(PixelUtil::isCompressed(src.format) || PixelUtil::isCompressed(dst.format))
 		{
 			if(src.format == dst.format)
@@ -1931,10 +2007,15 @@ namespace Ogre {
 				memcpy(dst.data, src.data, src.getConsecutiveSize());
 				return;
 			}
+			else if(!PixelUtil::isCompressed(src.format) && canCompressTo(dst.format))
+			{
+				compressPixels(src, dst);
+				return;
+			}
 			else
 			{
 				OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED,
-					"This method can not be used to compress or decompress images",
+					"This method can not be used to decompress images or compress to this format",
 					"PixelUtil::bulkPixelConversion");
 			}
 		}
@@ -2002,51 +2083,38 @@ namespace Ogre {
 			return;
 		}
 
-// NB VC6 can't handle the templates required for optimised conversion, tough
-#if OGRE_COMPILER != OGRE_COMPILER_MSVC || OGRE_COMP_VER >= 1300
-        // Is there a specialized, inlined, conversion?
-        if(doOptimizedConversion(src, dst))
-        {
-            // If so, good
-            return;
-        }
-#endif
-
-        const size_t srcPixelSize = PixelUtil::getNumElemBytes(src.format);
-        const size_t dstPixelSize = PixelUtil::getNumElemBytes(dst.format);
-        uint8 *srcptr = static_cast<uint8*>(src.data)
-            + (src.left + src.top * src.rowPitch + src.front * src.slicePitch) * srcPixelSize;
-        uint8 *dstptr = static_cast<uint8*>(dst.data)
-            + (dst.left + dst.top * dst.rowPitch + dst.front * dst.slicePitch) * dstPixelSize;
-		
-		// Old way, not taking into account box dimensions
-		//uint8 *srcptr = static_cast<uint8*>(src.data), *dstptr = static_cast<uint8*>(dst.data);
-
-        // Calculate pitches+skips in bytes
-        const size_t srcRowSkipBytes = src.getRowSkip()*srcPixelSize;
-        const size_t srcSliceSkipBytes = src.getSliceSkip()*srcPixelSize;
-        const size_t dstRowSkipBytes = dst.getRowSkip()*dstPixelSize;
-        const size_t dstSliceSkipBytes = dst.getSliceSkip()*dstPixelSize;
-
-        // The brute force fallback
-        float r = 0, g = 0, b = 0, a = 1;
-        for(size_t z=src.front; z<src.back; z++)
+        // Large boxes are split into bands of slices, or rows for 2D boxes
+        const size_t pixelCount = src.getWidth() * src.getHeight() * src.getDepth();
+        const bool bySlice = src.getDepth() > 1;
+        const size_t bandTotal = bySlice ? src.getDepth() : src.getHeight();
+        size_t threadCount = msBulkConversionThreads ? msBulkConversionThreads : ParallelFor::getHardwareThreadCount();
+        // Below this many pixels per band, starting a thread costs more than it saves
+        threadCount = std::min(threadCount, pixelCount / 65536);
+        threadCount = std::min(threadCount, bandTotal);
+        if(threadCount > 1)
         {
-            for(size_t y=src.top; y<src.bottom; y++)
+            const size_t bandSize = (bandTotal + threadCount - 1) / threadCount;
+            vector<PixelConversionWorker>::type workers;
+            for(size_t first = 0; first < bandTotal; first += bandSize)
             {
-                for(size_t x=src.left; x<src.right; x++)
+                const size_t last = std::min(first + bandSize, bandTotal);
+                PixelBox srcBand = src, dstBand = dst;
+                if(bySlice)
                 {
-                    unpackColour(&r, &g, &b, &a, src.format, srcptr);
-                    packColour(r, g, b, a, dst.format, dstptr);
-                    srcptr += srcPixelSize;
-                    dstptr += dstPixelSize;
+                    srcBand.front = src.front + first; srcBand.back = src.front + last;
+                    dstBand.front = dst.front + first; dstBand.back = dst.front + last;
                 }
-                srcptr += srcRowSkipBytes;
-                dstptr += dstRowSkipBytes;
+                else
+                {
+                    srcBand.top = src.top + first; srcBand.bottom = src.top + last;
+                    dstBand.top = dst.top + first; dstBand.bottom = dst.top + last;
+                }
+                workers.push_back(PixelConversionWorker(srcBand, dstBand));
             }
-            srcptr += srcSliceSkipBytes;
-            dstptr += dstSliceSkipBytes;
+            ParallelFor::runWorkers(workers);
+            return;
         }
+        convertPixels(src, dst);
     }
 
     ColourValue PixelBox::getColourAt(size_t x, size_t y, size_t z)
@@ -47,6 +47,7 @@
 #include "OgreLodStrategy.h"
 #include "OgreLogManager.h"
 #include "OgrePixelCountLodStrategy.h"
+#include "OgreParallelFor.h"
 
 namespace Ogre
 {
@@ -96,7 +97,9 @@ void ProgressiveMeshGeneratorBase::generateAutoconfiguredLodLevels( MeshPtr& mes
 ProgressiveMeshGenerator::ProgressiveMeshGenerator() :
     mUniqueVertexSet((UniqueVertexSet::size_type) 0, (const UniqueVertexSet::hasher&) PMVertexHash(this)),
     mMesh(NULL), mMeshBoundingSphereRadius(0.0f),
-    mCollapseCostLimit(NEVER_COLLAPSE_COST)
+    mCollapseCostLimit(NEVER_COLLAPSE_COST),
+    mErrorMetric(LodConfig::EM_CURVATURE),
+    mCostThreadCount(0)
 {
 	OgreAssert(NEVER_COLLAPSE_COST < UNINITIALIZED_COLLAPSE_COST && NEVER_COLLAPSE_COST != UNINITIALIZED_COLLAPSE_COST, "");
 }
@@ -178,8 +181,12 @@ void ProgressiveMeshGenerator::addVertexData(VertexData* vertexData, bool useSha
 	// Locate position element and the buffer to go with it.
 	const VertexElement* elem = vertexData->vertexDeclaration->findElementBySemantic(VES_POSITION);
 
-	// Only float supported.
-	OgreAssert(elem->getSize() == 12, "");
+	// Float and quantised positions are supported.
+	if (!VertexData::canReadPosition(elem->getType())) {
+		OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+		            "Unsupported position format in mesh " + mMeshName + ", cannot generate Lod levels.",
+		            "ProgressiveMeshGenerator::addVertexData");
+	}
 
 	HardwareVertexBufferSharedPtr vbuf = vertexData->vertexBufferBinding->getBuffer(elem->getSource());
 
@@ -194,13 +201,9 @@ void ProgressiveMeshGenerator::addVertexData(VertexData* vertexData, bool useSha
 
 	// Loop through all vertices and insert them to the Unordered Map.
 	for (; vertex < vEnd; vertex += vSize) {
-		float* pFloat;
-		elem->baseVertexPointerToElement(vertex, &pFloat);
 		mVertexList.push_back(PMVertex());
 		PMVertex* v = &mVertexList.back();
-		v->position.x = pFloat[0];
-		v->position.y = pFloat[1];
-		v->position.z = pFloat[2];
+		v->position = vertexData->readPosition(elem, vertex);
 		std::pair<UniqueVertexSet::iterator, bool> ret;
 		ret = mUniqueVertexSet.insert(v);
 		if (!ret.second) {
@@ -209,10 +212,7 @@ void ProgressiveMeshGenerator::addVertexData(VertexData* vertexData, bool useSha
 			v = *ret.first; // Point to the existing vertex.
 			v->seam = true;
 		} else {
-#if OGRE_DEBUG_MODE
-			// Needed for an assert, don't remove it.
-			v->costHeapPosition = mCollapseCostHeap.end();
-#endif
+			v->costHeapPosition = CollapseCostHeap::NOT_IN_HEAP;
 			v->seam = false;
 		}
 		lookup.push_back(v);
@@ -450,29 +450,144 @@ ProgressiveMeshGenerator::PMEdge* ProgressiveMeshGenerator::getPointer(VEdges::i
 	return &*it;
 }
 
+// Computes the collapse costs of a range of vertices.
+// Each vertex only writes its own edges and collapseTo, the rest of the mesh is read only.
+struct ProgressiveMeshGenerator::PMCostWorker
+{
+	ProgressiveMeshGenerator* gen;
+	Real* costs;
+	size_t begin;
+	size_t end;
+
+	PMCostWorker(ProgressiveMeshGenerator* generator, Real* outCosts, size_t first, size_t last) :
+		gen(generator), costs(outCosts), begin(first), end(last) { }
+
+	void run()
+	{
+		for (size_t i = begin; i < end; i++) {
+			PMVertex* vertex = &gen->mVertexList[i];
+			if (!vertex->edges.empty()) {
+				costs[i] = gen->computeVertexCollapseCost(vertex);
+			}
+		}
+	}
+};
+
 void ProgressiveMeshGenerator::computeCosts()
 {
 	mCollapseCostHeap.clear();
-	VertexList::iterator it = mVertexList.begin();
-	VertexList::iterator itEnd = mVertexList.end();
-	for (; it != itEnd; it++) {
-		if (!it->edges.empty()) {
+	size_t vertexCount = mVertexList.size();
+	if (vertexCount == 0) {
+		return;
+	}
+	if (mErrorMetric == LodConfig::EM_QUADRIC) {
+		computeQuadrics();
+	}
+	vector<Real>::type costs(vertexCount, UNINITIALIZED_COLLAPSE_COST);
+
+	size_t threadCount = std::min(mCostThreadCount, vertexCount);
+	if (threadCount == 0) {
+		// Below a few thousand vertices per thread, starting them costs more than it saves.
+		threadCount = std::max<size_t>(1, std::min(ParallelFor::getHardwareThreadCount(), vertexCount / 4096));
+	}
+	size_t rangeSize = (vertexCount + threadCount - 1) / threadCount;
+	vector<PMCostWorker>::type workers;
+	workers.reserve(threadCount);
+	for (size_t i = 0; i < threadCount; i++) {
+		size_t first = i * rangeSize;
+		workers.push_back(PMCostWorker(this, &costs[0], first, std::min(first + rangeSize, vertexCount)));
+	}
+	ParallelFor::runWorkers(workers);
 
-			computeVertexCollapseCost(&*it);
+	// Building the heap at once is O(N), instead of O(N log N) for inserting one by one.
+	for (size_t i = 0; i < vertexCount; i++) {
+		PMVertex* vertex = &mVertexList[i];
+		if (!vertex->edges.empty()) {
+			mCollapseCostHeap.pushUnordered(vertex, costs[i]);
 		} else {
 #if OGRE_DEBUG_MODE
-			LogManager::getSingleton().stream() << "In " << mMeshName << " never used vertex found with ID: " << mCollapseCostHeap.size() << ". "
+			LogManager::getSingleton().stream() << "In " << mMeshName << " never used vertex found with ID: " << i << ". "
 			    << "Vertex position: ("
-			    << it->position.x << ", "
-			    << it->position.y << ", "
-			    << it->position.z << ") "
+			    << vertex->position.x << ", "
+			    << vertex->position.y << ", "
+			    << vertex->position.z << ") "
 			    << "It will be excluded from Lod level calculations.";
 #endif
 		}
 	}
+	mCollapseCostHeap.build();
+}
+
+// Weight of the planes holding border edges in place, relative to the surface planes.
+static const Real QUADRIC_BORDER_WEIGHT = 1000.0f;
+
+void ProgressiveMeshGenerator::computeQuadrics()
+{
+	mQuadricList.assign(mVertexList.size(), PMQuadric());
+	TriangleList::iterator it = mTriangleList.begin();
+	TriangleList::iterator itEnd = mTriangleList.end();
+	for (; it != itEnd; it++) {
+		PMTriangle* triangle = &*it;
+		if (triangle->isRemoved) {
+			continue;
+		}
+		const Vector3& p0 = triangle->vertex[0]->position;
+		Vector3 normal = (triangle->vertex[1]->position - p0).crossProduct(triangle->vertex[2]->position - p0);
+		Real doubleArea = normal.length();
+		if (doubleArea <= 0.0f) {
+			continue; // Degenerate, has no plane.
+		}
+		normal /= doubleArea;
+		Real d = -normal.dotProduct(p0);
+		for (int i = 0; i < 3; i++) {
+			getQuadric(triangle->vertex[i]).addPlane(normal, d, doubleArea * 0.5f);
+		}
+
+		// An edge used by a single triangle is on the border.
+		for (int i = 0; i < 3; i++) {
+			PMVertex* a = triangle->vertex[i];
+			PMVertex* b = triangle->vertex[(i + 1) % 3];
+			VEdges::iterator edge = a->edges.find(PMEdge(b));
+			if (edge == a->edges.end() || edge->refCount != 1) {
+				continue;
+			}
+			Vector3 edgeDir = b->position - a->position;
+			Real edgeLength = edgeDir.length();
+			if (edgeLength <= 0.0f) {
+				continue;
+			}
+			Vector3 borderNormal = edgeDir.crossProduct(normal);
+			borderNormal.normalise();
+			Real borderD = -borderNormal.dotProduct(a->position);
+			Real weight = QUADRIC_BORDER_WEIGHT * edgeLength * edgeLength;
+			getQuadric(a).addPlane(borderNormal, borderD, weight);
+			getQuadric(b).addPlane(borderNormal, borderD, weight);
+		}
+	}
 }
 
-void ProgressiveMeshGenerator::computeVertexCollapseCost(PMVertex* vertex)
+Real ProgressiveMeshGenerator::computeQuadricCollapseCost(PMVertex* src, PMEdge* dstEdge)
+{
+	PMVertex* dst = dstEdge->dst;
+	PMQuadric quadric = getQuadric(src);
+	quadric += getQuadric(dst);
+
+	// Relative to the mesh size, so collapse cost limits work on any scale.
+	Real radiusSquared = mMeshBoundingSphereRadius * mMeshBoundingSphereRadius;
+	Real cost = std::max<Real>(0.0f, quadric.evaluate(dst->position));
+	if (radiusSquared > 0.0f) {
+		cost /= radiusSquared;
+	}
+
+	// dst keeps its own attributes, so moving a seam vertex off the seam tears the texture
+	// or normals apart. Leave those for last.
+	if (src->seam && !dst->seam) {
+		cost += 1.0f;
+	}
+	return cost;
+}
+
+Real ProgressiveMeshGenerator::computeVertexCollapseCost(PMVertex* vertex)
 {
 	Real collapseCost = UNINITIALIZED_COLLAPSE_COST;
 	OgreAssert(!vertex->edges.empty(), "");
@@ -485,8 +600,7 @@ void ProgressiveMeshGenerator::computeVertexCollapseCost(PMVertex* vertex)
 		}
 	}
 	OgreAssert(collapseCost != UNINITIALIZED_COLLAPSE_COST, "");
-	vertex->costHeapPosition = mCollapseCostHeap.insert(std::make_pair(collapseCost, vertex));
-
+	return collapseCost;
 }
 
 Real ProgressiveMeshGenerator::computeEdgeCollapseCost(PMVertex* src, PMEdge* dstEdge)
@@ -535,6 +649,10 @@ Real ProgressiveMeshGenerator::computeEdgeCollapseCost(PMVertex* src, PMEdge* ds
 	}
 #endif
 
+	if (mErrorMetric == LodConfig::EM_QUADRIC) {
+		return computeQuadricCollapseCost(src, dstEdge);
+	}
+
 	Real cost;
 
 	// Special cases
@@ -676,17 +794,16 @@ void ProgressiveMeshGenerator::updateVertexCollapseCost(PMVertex* vertex)
 			collapseTo = it->dst;
 		}
 	}
-	if (vertex->collapseTo != collapseTo || collapseCost != vertex->costHeapPosition->first) {
+	if (vertex->collapseTo != collapseTo || collapseCost != mCollapseCostHeap.getCost(vertex)) {
 		OgreAssert(vertex->collapseTo != NULL, "");
-		OgreAssert(vertex->costHeapPosition != mCollapseCostHeap.end(), "");
-		mCollapseCostHeap.erase(vertex->costHeapPosition);
+		OgreAssert(vertex->costHeapPosition != CollapseCostHeap::NOT_IN_HEAP, "");
 		if (collapseCost != UNINITIALIZED_COLLAPSE_COST) {
 			vertex->collapseTo = collapseTo;
-			vertex->costHeapPosition = mCollapseCostHeap.insert(std::make_pair(collapseCost, vertex));
+			mCollapseCostHeap.update(vertex, collapseCost);
 		} else {
+			mCollapseCostHeap.erase(vertex);
 #if OGRE_DEBUG_MODE
 			vertex->collapseTo = NULL;
-			vertex->costHeapPosition = mCollapseCostHeap.end();
 #endif
 		}
 	}
@@ -711,6 +828,7 @@ void ProgressiveMeshGenerator::generateLodLevels(LodConfig& lodConfig)
 #endif
 	mMesh = lodConfig.mesh;
 	mMeshBoundingSphereRadius = mMesh->getBoundingSphereRadius();
+	mErrorMetric = lodConfig.errorMetric;
 	mMesh->removeLodLevels();
 	tuneContainerSize();
 	initialize(); // Load vertices and triangles
@@ -732,9 +850,8 @@ void ProgressiveMeshGenerator::computeLods(LodConfig& lodConfigs)
 	for (unsigned short curLod = 0; curLod < lodCount; curLod++) {
 		size_t neededVertexCount = calcLodVertexCount(lodConfigs.levels[curLod]);
 		for (; neededVertexCount < vertexCount; vertexCount--) {
-			CollapseCostHeap::iterator nextVertex = mCollapseCostHeap.begin();
-			if (nextVertex != mCollapseCostHeap.end() && nextVertex->first < mCollapseCostLimit) {
-				collapse(nextVertex->second);
+			if (!mCollapseCostHeap.empty() && mCollapseCostHeap.top().cost < mCollapseCostLimit) {
+				collapse(mCollapseCostHeap.top().vertex);
 			} else {
 				break;
 			}
@@ -788,10 +905,10 @@ void ProgressiveMeshGenerator::assertValidMesh()
 	// Allows to find bugs in collapsing.
 //	size_t s1 = mUniqueVertexSet.size();
 //	size_t s2 = mCollapseCostHeap.size();
-	CollapseCostHeap::iterator it = mCollapseCostHeap.begin();
-	CollapseCostHeap::iterator itEnd = mCollapseCostHeap.end();
+	CollapseCostHeap::EntryList::const_iterator it = mCollapseCostHeap.getEntries().begin();
+	CollapseCostHeap::EntryList::const_iterator itEnd = mCollapseCostHeap.getEntries().end();
 	while (it != itEnd) {
-		assertValidVertex(it->second);
+		assertValidVertex(it->vertex);
 		it++;
 	}
 }
@@ -804,7 +921,7 @@ void ProgressiveMeshGenerator::assertValidVertex(PMVertex* v)
 	for (; it != itEnd; it++) {
 		PMTriangle* t = *it;
 		for (int i = 0; i < 3; i++) {
-			OgreAssert(t->vertex[i]->costHeapPosition != mCollapseCostHeap.end(), "");
+			OgreAssert(t->vertex[i]->costHeapPosition != CollapseCostHeap::NOT_IN_HEAP, "");
 			t->vertex[i]->edges.findExists(PMEdge(t->vertex[i]->collapseTo));
 			for (int n = 0; n < 3; n++) {
 				if (i != n) {
@@ -826,8 +943,8 @@ void ProgressiveMeshGenerator::collapse(PMVertex* src)
 	assertValidVertex(dst);
 	assertValidVertex(src);
 #endif // ifndef NDEBUG
-	OgreAssert(src->costHeapPosition->first != NEVER_COLLAPSE_COST, "");
-	OgreAssert(src->costHeapPosition->first != UNINITIALIZED_COLLAPSE_COST, "");
+	OgreAssert(mCollapseCostHeap.getCost(src) != NEVER_COLLAPSE_COST, "");
+	OgreAssert(mCollapseCostHeap.getCost(src) != UNINITIALIZED_COLLAPSE_COST, "");
 	OgreAssert(!src->edges.empty(), "");
 	OgreAssert(!src->triangles.empty(), "");
 	OgreAssert(src->edges.find(PMEdge(dst)) != src->edges.end(), "");
@@ -902,6 +1019,9 @@ void ProgressiveMeshGenerator::collapse(PMVertex* src)
 	}
 	
 	dst->seam |= src->seam; // Inherit seam property
+	if (mErrorMetric == LodConfig::EM_QUADRIC) {
+		getQuadric(dst) += getQuadric(src); // dst stands in for the surface around src too.
+	}
 
 #ifndef PM_BEST_QUALITY
 	VEdges::iterator it3 = src->edges.begin();
@@ -948,11 +1068,10 @@ void ProgressiveMeshGenerator::collapse(PMVertex* src)
 	assertOutdatedCollapseCost(dst);
 #endif // ifndef NDEBUG
 #endif // ifndef PM_BEST_QUALITY
-	mCollapseCostHeap.erase(src->costHeapPosition); // Remove src from collapse costs.
+	mCollapseCostHeap.erase(src); // Remove src from collapse costs.
 	src->edges.clear(); // Free memory
 	src->triangles.clear(); // Free memory
 #if OGRE_DEBUG_MODE
-	src->costHeapPosition = mCollapseCostHeap.end();
 	assertValidVertex(dst);
 #endif
 }
@@ -1108,6 +1227,7 @@ void ProgressiveMeshGenerator::removeEdge(PMVertex* v, const PMEdge& edge)
 void ProgressiveMeshGenerator::cleanupMemory()
 {
 	this->mCollapseCostHeap.clear();
+	this->mQuadricList.clear();
 	this->mIndexBufferInfoList.clear();
 	this->mSharedVertexLookup.clear();
 	this->mVertexLookup.clear();
@@ -1116,6 +1236,141 @@ void ProgressiveMeshGenerator::cleanupMemory()
 	this->mTriangleList.clear();
 }
 
+ProgressiveMeshGenerator::PMQuadric::PMQuadric()
+{
+	for (int i = 0; i < 10; i++) {
+		m[i] = 0.0f;
+	}
+}
+
+void ProgressiveMeshGenerator::PMQuadric::addPlane(const Vector3& normal, Real d, Real weight)
+{
+	// Outer product of the plane (a, b, c, d) with itself.
+	m[0] += weight * normal.x * normal.x;
+	m[1] += weight * normal.x * normal.y;
+	m[2] += weight * normal.x * normal.z;
+	m[3] += weight * normal.x * d;
+	m[4] += weight * normal.y * normal.y;
+	m[5] += weight * normal.y * normal.z;
+	m[6] += weight * normal.y * d;
+	m[7] += weight * normal.z * normal.z;
+	m[8] += weight * normal.z * d;
+	m[9] += weight * d * d;
+}
+
+ProgressiveMeshGenerator::PMQuadric& ProgressiveMeshGenerator::PMQuadric::operator+= (const PMQuadric& other)
+{
+	for (int i = 0; i < 10; i++) {
+		m[i] += other.m[i];
+	}
+	return *this;
+}
+
+Real ProgressiveMeshGenerator::PMQuadric::evaluate(const Vector3& v) const
+{
+	// v^T Q v with v = (x, y, z, 1).
+	return v.x * v.x * m[0] + 2.0f * v.x * v.y * m[1] + 2.0f * v.x * v.z * m[2] + 2.0f * v.x * m[3]
+	       + v.y * v.y * m[4] + 2.0f * v.y * v.z * m[5] + 2.0f * v.y * m[6]
+	       + v.z * v.z * m[7] + 2.0f * v.z * m[8]
+	       + m[9];
+}
+
+const size_t ProgressiveMeshGenerator::PMCollapseCostHeap::NOT_IN_HEAP;
+
+void ProgressiveMeshGenerator::PMCollapseCostHeap::place(size_t pos, const Entry& entry)
+{
+	mEntries[pos] = entry;
+	entry.vertex->costHeapPosition = pos;
+}
+
+void ProgressiveMeshGenerator::PMCollapseCostHeap::siftUp(size_t pos)
+{
+	Entry entry = mEntries[pos];
+	while (pos > 0) {
+		size_t parent = (pos - 1) / 2;
+		if (!(entry.cost < mEntries[parent].cost)) {
+			break;
+		}
+		place(pos, mEntries[parent]);
+		pos = parent;
+	}
+	place(pos, entry);
+}
+
+void ProgressiveMeshGenerator::PMCollapseCostHeap::siftDown(size_t pos)
+{
+	Entry entry = mEntries[pos];
+	size_t count = mEntries.size();
+	for (;;) {
+		size_t child = pos * 2 + 1;
+		if (child >= count) {
+			break;
+		}
+		if (child + 1 < count && mEntries[child + 1].cost < mEntries[child].cost) {
+			child++;
+		}
+		if (!(mEntries[child].cost < entry.cost)) {
+			break;
+		}
+		place(pos, mEntries[child]);
+		pos = child;
+	}
+	place(pos, entry);
+}
+
+void ProgressiveMeshGenerator::PMCollapseCostHeap::push(PMVertex* v, Real cost)
+{
+	pushUnordered(v, cost);
+	siftUp(mEntries.size() - 1);
+}
+
+void ProgressiveMeshGenerator::PMCollapseCostHeap::pushUnordered(PMVertex* v, Real cost)
+{
+	Entry entry;
+	entry.cost = cost;
+	entry.vertex = v;
+	v->costHeapPosition = mEntries.size();
+	mEntries.push_back(entry);
+}
+
+void ProgressiveMeshGenerator::PMCollapseCostHeap::build()
+{
+	for (size_t pos = mEntries.size() / 2; pos > 0; pos--) {
+		siftDown(pos - 1);
+	}
+}
+
+void ProgressiveMeshGenerator::PMCollapseCostHeap::update(PMVertex* v, Real cost)
+{
+	size_t pos = v->costHeapPosition;
+	OgreAssert(pos < mEntries.size() && mEntries[pos].vertex == v, "");
+	Real oldCost = mEntries[pos].cost;
+	mEntries[pos].cost = cost;
+	if (cost < oldCost) {
+		siftUp(pos);
+	} else {
+		siftDown(pos);
+	}
+}
+
+void ProgressiveMeshGenerator::PMCollapseCostHeap::erase(PMVertex* v)
+{
+	size_t pos = v->costHeapPosition;
+	OgreAssert(pos < mEntries.size() && mEntries[pos].vertex == v, "");
+	v->costHeapPosition = NOT_IN_HEAP;
+	Entry last = mEntries.back();
+	mEntries.pop_back();
+	if (pos < mEntries.size()) {
+		// Move the last entry into the hole, then restore the order in whichever direction it breaks.
+		place(pos, last);
+		if (pos > 0 && last.cost < mEntries[(pos - 1) / 2].cost) {
+			siftUp(pos);
+		} else {
+			siftDown(pos);
+		}
+	}
+}
+
 bool ProgressiveMeshGenerator::PMVertexEqual::operator() (const PMVertex* lhs, const PMVertex* rhs) const
 {
 	return lhs->position == rhs->position;
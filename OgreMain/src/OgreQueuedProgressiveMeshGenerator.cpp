@@ -123,6 +123,7 @@ void PMWorker::buildRequest(LodConfig& lodConfigs)
 	mMeshName = mRequest->meshName;
 #endif
 	mMeshBoundingSphereRadius = lodConfigs.mesh->getBoundingSphereRadius();
+	mErrorMetric = lodConfigs.errorMetric;
 	cleanupMemory();
 	tuneContainerSize();
 	initialize(); // Load vertices and triangles.
@@ -209,9 +210,7 @@ void PMWorker::addVertexBuffer(const PMGenRequest::VertexBuffer& vertexBuffer, b
 			v = *ret.first; // Point to the existing vertex.
 			v->seam = true;
 		} else {
-#if OGRE_DEBUG_MODE
-			v->costHeapPosition = mCollapseCostHeap.end();
-#endif
+			v->costHeapPosition = CollapseCostHeap::NOT_IN_HEAP;
 			v->seam = false;
 		}
 		lookup.push_back(v);
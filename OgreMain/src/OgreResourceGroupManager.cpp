@@ -33,9 +33,95 @@ THE SOFTWARE.
 #include "OgreLogManager.h"
 #include "OgreScriptLoader.h"
 #include "OgreSceneManager.h"
+#include "OgreRoot.h"
+#include "OgreParallelFor.h"
 
 namespace Ogre {
 
+	namespace
+	{
+		/// Resources of a group being prepared, shared by the calling thread and the WorkQueue
+		struct ResourcePrepareBatch
+		{
+			vector<ResourcePtr>::type resources;
+			AtomicScalar<size_t> next;
+			AtomicScalar<size_t> done;
+#if OGRE_THREAD_SUPPORT && OGRE_THREAD_PROVIDER != 3
+			OGRE_MUTEX(mutex)
+			/// Signalled once every resource is done
+			OGRE_THREAD_SYNCHRONISER(finished)
+#endif
+
+			ResourcePrepareBatch() : next(0), done(0) {}
+
+			/// Prepares the next unclaimed resource until none are left
+			void run()
+			{
+				size_t i;
+				while ((i = next++) < resources.size())
+				{
+					try
+					{
+						resources[i]->prepare();
+					}
+					catch (Exception& e)
+					{
+						// The resource is unloaded again and loading it raises the error, but
+						// that happens later on another thread, so say what went wrong here
+						LogManager::getSingleton().logMessage("Preparing resource '" +
+							resources[i]->getName() + "' failed: " + e.getFullDescription(), LML_CRITICAL);
+					}
+					catch (std::exception& e)
+					{
+						LogManager::getSingleton().logMessage("Preparing resource '" +
+							resources[i]->getName() + "' failed: " + e.what(), LML_CRITICAL);
+					}
+					catch (...)
+					{
+						LogManager::getSingleton().logMessage("Preparing resource '" +
+							resources[i]->getName() + "' failed", LML_CRITICAL);
+					}
+					if (++done == resources.size())
+					{
+#if OGRE_THREAD_SUPPORT && OGRE_THREAD_PROVIDER != 3
+						OGRE_LOCK_MUTEX(mutex)
+						OGRE_THREAD_NOTIFY_ALL(finished)
+#endif
+					}
+				}
+			}
+
+			/// Waits until every resource is done
+			void wait()
+			{
+#if OGRE_THREAD_SUPPORT && OGRE_THREAD_PROVIDER != 3
+				OGRE_LOCK_MUTEX_NAMED(mutex, lock)
+				while (done.get() < resources.size())
+				{
+					OGRE_THREAD_WAIT(finished, mutex, lock);
+				}
+#else
+				// The TBB threading macros have no condition variable
+				while (done.get() < resources.size())
+				{
+					OGRE_THREAD_SLEEP(1);
+				}
+#endif
+			}
+		};
+
+		/// The data of a prepare request, a batch outlives requests still queued when it is done
+		struct ResourcePrepareRequest
+		{
+			SharedPtr<ResourcePrepareBatch> batch;
+
+			friend std::ostream& operator<<(std::ostream& o, const ResourcePrepareRequest& r)
+			{
+				(void)r;
+				return o;
+			}
+		};
+	}
     //-----------------------------------------------------------------------
     template<> ResourceGroupManager* Singleton<ResourceGroupManager>::msSingleton = 0;
     ResourceGroupManager* ResourceGroupManager::getSingletonPtr(void)
@@ -55,7 +141,8 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     //-----------------------------------------------------------------------
     ResourceGroupManager::ResourceGroupManager()
-        : mLoadingListener(0), mCurrentGroup(0)
+        : mLoadingListener(0), mIndexWriters(0), mLookupCount(0), mArchiveSearchCount(0),
+		mArchiveProbeCount(0), mContendedLookupCount(0), mIndexUpdateCount(0), mIndexCopyCount(0), mCurrentGroup(0), mPrepareThreads(1), mPrepareWorkQueue(0), mPrepareChannel(0)
     {
         // Create the 'General' group
         createResourceGroup(DEFAULT_RESOURCE_GROUP_NAME);
@@ -69,6 +156,14 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     ResourceGroupManager::~ResourceGroupManager()
     {
+		// The WorkQueue may have been replaced since, then it is gone already
+		Root* root = Root::getSingletonPtr();
+		if (mPrepareWorkQueue && root && root->getWorkQueue() == mPrepareWorkQueue)
+		{
+			mPrepareWorkQueue->abortRequestsByChannel(mPrepareChannel);
+			mPrepareWorkQueue->removeRequestHandler(mPrepareChannel, this);
+		}
+
         // delete all resource groups
         ResourceGroupMap::iterator i, iend;
         iend = mResourceGroupMap.end();
@@ -95,6 +190,9 @@ namespace Ogre {
         grp->name = name;
 		grp->inGlobalPool = inGlobalPool;
         grp->worldGeometrySceneManager = 0;
+		grp->resourceIndex = ResourceIndexPtr(OGRE_NEW ResourceIndex());
+
+		OGRE_LOCK_RW_MUTEX_WRITE(mResourceIndexMutex);
         mResourceGroupMap.insert(
             ResourceGroupMap::value_type(name, grp));
     }
@@ -256,6 +354,9 @@ namespace Ogre {
     void ResourceGroupManager::loadResourceGroup(const String& name, 
 		bool loadMainResources, bool loadWorldGeom)
     {
+		if (loadMainResources && mPrepareThreads != 1)
+			prepareResourcesInParallel(name);
+
 		// Can only bulk-load one group at a time (reasonable limitation I think)
 		OGRE_LOCK_AUTO_MUTEX
 
@@ -352,6 +453,76 @@ namespace Ogre {
 		
 		LogManager::getSingleton().logMessage("Finished loading resource group " + name);
     }
+	//-----------------------------------------------------------------------
+	void ResourceGroupManager::prepareResourcesInParallel(const String& groupName)
+	{
+		Root* root = Root::getSingletonPtr();
+		WorkQueue* wq = root ? root->getWorkQueue() : 0;
+		if (!wq)
+			return;
+
+		SharedPtr<ResourcePrepareBatch> batch(OGRE_NEW_T(ResourcePrepareBatch, MEMCATEGORY_GENERAL)(),
+			SPFM_DELETE_T);
+		{
+			OGRE_LOCK_AUTO_MUTEX
+			ResourceGroup* grp = getResourceGroup(groupName);
+			if (!grp)
+				return; // loadResourceGroup reports it
+
+			OGRE_LOCK_MUTEX(grp->OGRE_AUTO_MUTEX_NAME)
+			for (ResourceGroup::LoadResourceOrderMap::iterator oi = grp->loadResourceOrderMap.begin();
+				oi != grp->loadResourceOrderMap.end(); ++oi)
+			{
+				for (LoadUnloadResourceList::iterator l = oi->second->begin(); l != oi->second->end(); ++l)
+				{
+					if ((*l)->getLoadingState() == Resource::LOADSTATE_UNLOADED)
+						batch->resources.push_back(*l);
+				}
+			}
+		}
+
+		size_t threadCount = mPrepareThreads;
+		if (threadCount == 0)
+			threadCount = ParallelFor::getHardwareThreadCount();
+		threadCount = std::min(threadCount, batch->resources.size());
+		if (threadCount < 2)
+			return;
+
+		if (wq != mPrepareWorkQueue)
+		{
+			mPrepareWorkQueue = wq;
+			mPrepareChannel = wq->getChannel("Ogre/ResourcePrepare");
+			wq->addRequestHandler(mPrepareChannel, this);
+		}
+
+		LogManager::getSingleton().stream()
+			<< "Preparing " << batch->resources.size() << " resources of group '" << groupName
+			<< "' on " << threadCount << " threads";
+
+		ResourcePrepareRequest req;
+		req.batch = batch;
+		for (size_t i = 1; i < threadCount; ++i)
+			wq->addRequest(mPrepareChannel, 0, Any(req));
+
+		// This thread takes a share as well, so the group gets prepared even if the
+		// WorkQueue is busy, paused or this is one of its threads
+		batch->run();
+
+		// Requests picked up later find nothing left to do
+		batch->wait();
+	}
+	//-----------------------------------------------------------------------
+	WorkQueue::Response* ResourceGroupManager::handleRequest(const WorkQueue::Request* req, const WorkQueue* srcQ)
+	{
+		if (!req->getAborted())
+			any_cast<ResourcePrepareRequest>(req->getData()).batch->run();
+		return OGRE_NEW WorkQueue::Response(req, true, Any());
+	}
+	//-----------------------------------------------------------------------
+	void ResourceGroupManager::setResourcePrepareThreads(size_t threads)
+	{
+		mPrepareThreads = threads;
+	}
     //-----------------------------------------------------------------------
     void ResourceGroupManager::unloadResourceGroup(const String& name, bool reloadableOnly)
     {
@@ -479,8 +650,12 @@ namespace Ogre {
 		mCurrentGroup = grp;
         unloadResourceGroup(name, false); // will throw an exception if name not valid
 		dropGroupContents(grp);
+		{
+			// Out of reach of lookups before it goes
+			OGRE_LOCK_RW_MUTEX_WRITE(mResourceIndexMutex);
+			mResourceGroupMap.erase(mResourceGroupMap.find(name));
+		}
 		deleteGroup(grp);
-        mResourceGroupMap.erase(mResourceGroupMap.find(name));
 		// reset current group
 		mCurrentGroup = 0;
     }
@@ -563,8 +738,7 @@ namespace Ogre {
         grp->locationList.push_back(loc);
         // Index resources
         StringVectorPtr vec = pArch->find("*", recursive);
-        for( StringVector::iterator it = vec->begin(); it != vec->end(); ++it )
-			grp->addToIndex(*it, pArch);
+		updateResourceIndex(grp, ResourceIndex::ADD_ARCHIVE, pArch, *vec);
 		
 		StringUtil::StrStreamType msg;
 		msg << "Added resource location '" << name << "' of type '" << locType
@@ -596,7 +770,7 @@ namespace Ogre {
 			Archive* pArch = (*li)->archive;
 			if (pArch->getName() == name)
 			{
-				grp->removeFromIndex(pArch);
+				updateResourceIndex(grp, ResourceIndex::REMOVE_ARCHIVE, pArch, StringVector());
 				// Erase list entry
 				OGRE_DELETE_T(*li, ResourceLocation, MEMCATEGORY_RESOURCE);
 				grp->locationList.erase(li);
@@ -669,18 +843,20 @@ namespace Ogre {
         const String& resourceName, const String& groupName, 
 		bool searchGroupsIfNotFound, Resource* resourceBeingLoaded)
     {
-		OGRE_LOCK_AUTO_MUTEX
-
-		if(mLoadingListener)
+		// Listeners are called one at a time, as they always were
 		{
-			DataStreamPtr stream = mLoadingListener->resourceLoading(resourceName, groupName, resourceBeingLoaded);
-			if(!stream.isNull())
-				return stream;
+			OGRE_LOCK_AUTO_MUTEX
+			if(mLoadingListener)
+			{
+				DataStreamPtr stream = mLoadingListener->resourceLoading(resourceName, groupName, resourceBeingLoaded);
+				if(!stream.isNull())
+					return stream;
+			}
 		}
 
-		// Try to find in resource index first
-		ResourceGroup* grp = getResourceGroup(groupName);
-		if (!grp)
+		// The index is all we need to find the archive, no mutex is held while opening
+		ResourceIndexPtr index = getResourceIndex(groupName);
+		if (index.isNull())
 		{
 			OGRE_EXCEPT(Exception::ERR_ITEM_NOT_FOUND, 
 				"Cannot locate a resource group called '" + groupName + 
@@ -688,54 +864,16 @@ namespace Ogre {
 				"ResourceGroupManager::openResource");
 		}
 
-		OGRE_LOCK_MUTEX(grp->OGRE_AUTO_MUTEX_NAME) // lock group mutex
-
-		Archive* pArch = 0;
-		ResourceLocationIndex::iterator rit = grp->resourceIndexCaseSensitive.find(resourceName);
-		if (rit != grp->resourceIndexCaseSensitive.end())
+		Archive* pArch = findArchive(*index, resourceName);
+		if (pArch)
 		{
-			// Found in the index
-			pArch = rit->second;
 			DataStreamPtr stream = pArch->open(resourceName);
+			OGRE_LOCK_AUTO_MUTEX
 			if (mLoadingListener)
 				mLoadingListener->resourceStreamOpened(resourceName, groupName, resourceBeingLoaded, stream);
 			return stream;
 		}
-        else 
-        {
-            // try case insensitive
-            String lcResourceName = resourceName;
-            StringUtil::toLowerCase(lcResourceName);
-            rit = grp->resourceIndexCaseInsensitive.find(lcResourceName);
-            if (rit != grp->resourceIndexCaseInsensitive.end())
-            {
-                // Found in the index
-                pArch = rit->second;
-				DataStreamPtr stream = pArch->open(resourceName);
-				if (mLoadingListener)
-					mLoadingListener->resourceStreamOpened(resourceName, groupName, resourceBeingLoaded, stream);
-				return stream;
-            }
-		    else
-		    {
-			    // Search the hard way
-			    LocationList::iterator li, liend;
-			    liend = grp->locationList.end();
-			    for (li = grp->locationList.begin(); li != liend; ++li)
-			    {
-				    Archive* arch = (*li)->archive;
-                    if (arch->exists(resourceName))
-				    {
-                        DataStreamPtr ptr = arch->open(resourceName);
-						if (mLoadingListener)
-							mLoadingListener->resourceStreamOpened(resourceName, groupName, resourceBeingLoaded, ptr);
-					    return ptr;
-				    }
-			    }
-		    }
-        }
 
-		
 		// Not found
 		if (searchGroupsIfNotFound)
 		{
@@ -833,7 +971,7 @@ namespace Ogre {
 				
 				// create it
 				DataStreamPtr ret = arch->create(filename);
-				grp->addToIndex(filename, arch);
+				updateResourceIndex(grp, ResourceIndex::ADD_FILES, arch, StringVector(1, filename));
 
 
 				return ret;
@@ -872,7 +1010,7 @@ namespace Ogre {
 				if (arch->exists(filename))
 				{
 					arch->remove(filename);
-					grp->removeFromIndex(filename, arch);
+					updateResourceIndex(grp, ResourceIndex::REMOVE_FILES, arch, StringVector(1, filename));
 
 					// only remove one file
 					break;
@@ -896,7 +1034,6 @@ namespace Ogre {
 
 		OGRE_LOCK_MUTEX(grp->OGRE_AUTO_MUTEX_NAME) // lock group mutex
 
-		
 		for (LocationList::iterator li = grp->locationList.begin(); 
 			li != grp->locationList.end(); ++li)
 		{
@@ -909,9 +1046,9 @@ namespace Ogre {
 				for (StringVector::iterator f = matchingFiles->begin(); f != matchingFiles->end(); ++f)
 				{
 					arch->remove(*f);
-					grp->removeFromIndex(*f, arch);
-
 				}
+				// one index change per archive
+				updateResourceIndex(grp, ResourceIndex::REMOVE_FILES, arch, *matchingFiles);
 			}
 		}
 
@@ -1638,136 +1775,55 @@ namespace Ogre {
     //-----------------------------------------------------------------------
 	bool ResourceGroupManager::resourceExists(const String& groupName, const String& resourceName)
 	{
-        OGRE_LOCK_AUTO_MUTEX
-
-		// Try to find in resource index first
-        ResourceGroup* grp = getResourceGroup(groupName);
-        if (!grp)
+		ResourceIndexPtr index = getResourceIndex(groupName);
+        if (index.isNull())
         {
             OGRE_EXCEPT(Exception::ERR_ITEM_NOT_FOUND, 
                 "Cannot locate a resource group called '" + groupName + "'", 
                 "ResourceGroupManager::resourceExists");
         }
 
-		return resourceExists(grp, resourceName);
+		return findArchive(*index, resourceName) != 0;
 	}
     //-----------------------------------------------------------------------
 	bool ResourceGroupManager::resourceExists(ResourceGroup* grp, const String& resourceName)
 	{
-
-		OGRE_LOCK_MUTEX(grp->OGRE_AUTO_MUTEX_NAME) // lock group mutex
-
-		// Try indexes first
-		ResourceLocationIndex::iterator rit = grp->resourceIndexCaseSensitive.find(resourceName);
-		if (rit != grp->resourceIndexCaseSensitive.end())
-		{
-			// Found in the index
-			return true;
-		}
-        else 
-        {
-            // try case insensitive
-            String lcResourceName = resourceName;
-            StringUtil::toLowerCase(lcResourceName);
-            rit = grp->resourceIndexCaseInsensitive.find(lcResourceName);
-            if (rit != grp->resourceIndexCaseInsensitive.end())
-            {
-                // Found in the index
-                return true;
-            }
-		    else
-		    {
-			    // Search the hard way
-			    LocationList::iterator li, liend;
-			    liend = grp->locationList.end();
-			    for (li = grp->locationList.begin(); li != liend; ++li)
-			    {
-				    Archive* arch = (*li)->archive;
-                    if (arch->exists(resourceName))
-				    {
-						return true;
-				    }
-			    }
-		    }
-        }
-
-		return false;
-
+		return findArchive(*getResourceIndex(grp), resourceName) != 0;
 	}
 	//-----------------------------------------------------------------------
 	time_t ResourceGroupManager::resourceModifiedTime(const String& groupName, const String& resourceName)
 	{
-		OGRE_LOCK_AUTO_MUTEX
-
-		// Try to find in resource index first
-		ResourceGroup* grp = getResourceGroup(groupName);
-		if (!grp)
+		ResourceIndexPtr index = getResourceIndex(groupName);
+		if (index.isNull())
 		{
 			OGRE_EXCEPT(Exception::ERR_ITEM_NOT_FOUND, 
 				"Cannot locate a resource group called '" + groupName + "'", 
 				"ResourceGroupManager::resourceModifiedTime");
 		}
 
-		return resourceModifiedTime(grp, resourceName);
-
+		Archive* arch = findArchive(*index, resourceName);
+		return arch ? arch->getModifiedTime(resourceName) : 0;
 	}
 	//-----------------------------------------------------------------------
 	time_t ResourceGroupManager::resourceModifiedTime(ResourceGroup* grp, const String& resourceName)
 	{
-		OGRE_LOCK_MUTEX(grp->OGRE_AUTO_MUTEX_NAME) // lock group mutex
-
-		// Try indexes first
-		ResourceLocationIndex::iterator rit = grp->resourceIndexCaseSensitive.find(resourceName);
-		if (rit != grp->resourceIndexCaseSensitive.end())
-		{
-			return rit->second->getModifiedTime(resourceName);
-		}
-        else 
-        {
-            // try case insensitive
-            String lcResourceName = resourceName;
-            StringUtil::toLowerCase(lcResourceName);
-            rit = grp->resourceIndexCaseInsensitive.find(lcResourceName);
-            if (rit != grp->resourceIndexCaseInsensitive.end())
-            {
-				return rit->second->getModifiedTime(resourceName);
-            }
-		    else
-		    {
-			    // Search the hard way
-			    LocationList::iterator li, liend;
-			    liend = grp->locationList.end();
-			    for (li = grp->locationList.begin(); li != liend; ++li)
-			    {
-				    Archive* arch = (*li)->archive;
-					time_t testTime = arch->getModifiedTime(resourceName);
-
-                    if (testTime > 0)
-				    {
-						return testTime;
-				    }
-			    }
-		    }
-        }
-
-		return 0;
+		Archive* arch = findArchive(*getResourceIndex(grp), resourceName);
+		return arch ? arch->getModifiedTime(resourceName) : 0;
 	}
 	//-----------------------------------------------------------------------
 	ResourceGroupManager::ResourceGroup* 
 	ResourceGroupManager::findGroupContainingResourceImpl(const String& filename)
 	{
-        OGRE_LOCK_AUTO_MUTEX
+		if (mIndexWriters.get() > 0)
+			++mContendedLookupCount;
+		OGRE_LOCK_RW_MUTEX_READ(mResourceIndexMutex);
 
-			// Iterate over resource groups and find
+		// Iterate over resource groups and find
 		for (ResourceGroupMap::iterator i = mResourceGroupMap.begin();
 			i != mResourceGroupMap.end(); ++i)
 		{
-	        ResourceGroup* grp = i->second;
-
-			OGRE_LOCK_MUTEX(grp->OGRE_AUTO_MUTEX_NAME) // lock group mutex
-				
-			if (resourceExists(grp, filename))
-				return grp;
+			if (findArchive(*i->second->resourceIndex, filename))
+				return i->second;
 		}
 		// Not found
 		return 0;
@@ -1949,69 +2005,171 @@ namespace Ogre {
 	//-------------------------------------------------------------------------
 	void ResourceGroupManager::setLoadingListener(ResourceLoadingListener *listener)
 	{
+		OGRE_LOCK_AUTO_MUTEX
 		mLoadingListener = listener;
 	}
 	//-------------------------------------------------------------------------
 	ResourceLoadingListener *ResourceGroupManager::getLoadingListener()
 	{
+		OGRE_LOCK_AUTO_MUTEX
 		return mLoadingListener;
 	}
 	//---------------------------------------------------------------------
 	//---------------------------------------------------------------------
-	void ResourceGroupManager::ResourceGroup::addToIndex(const String& filename, Archive* arch)
+	ResourceGroupManager::ResourceIndexPtr ResourceGroupManager::getResourceIndex(const String& groupName)
 	{
-		// internal, assumes mutex lock has already been obtained
-		this->resourceIndexCaseSensitive[filename] = arch;
+		if (mIndexWriters.get() > 0)
+			++mContendedLookupCount;
+		OGRE_LOCK_RW_MUTEX_READ(mResourceIndexMutex);
+
+		ResourceGroupMap::iterator i = mResourceGroupMap.find(groupName);
+		if (i == mResourceGroupMap.end())
+			return ResourceIndexPtr();
+		return i->second->resourceIndex;
+	}
+	//---------------------------------------------------------------------
+	ResourceGroupManager::ResourceIndexPtr ResourceGroupManager::getResourceIndex(ResourceGroup* grp)
+	{
+		if (mIndexWriters.get() > 0)
+			++mContendedLookupCount;
+		OGRE_LOCK_RW_MUTEX_READ(mResourceIndexMutex);
+		return grp->resourceIndex;
+	}
+	//---------------------------------------------------------------------
+	void ResourceGroupManager::updateResourceIndex(ResourceGroup* grp, ResourceIndex::Change change, 
+		Archive* arch, const StringVector& files)
+	{
+		++mIndexUpdateCount;
+		++mIndexWriters;
+		{
+			OGRE_LOCK_RW_MUTEX_WRITE(mResourceIndexMutex);
+			// Lookups take references with the lock held, so with none left none will appear
+			if (grp->resourceIndex.unique())
+			{
+				grp->resourceIndex->apply(change, arch, files);
+				--mIndexWriters;
+				return;
+			}
+		}
+
+		// Lookups are using it, which keeps it unchanged while it is copied. Other 
+		// changes are kept out by the group mutex.
+		++mIndexCopyCount;
+		ResourceIndexPtr newIndex(OGRE_NEW ResourceIndex(*grp->resourceIndex));
+		newIndex->apply(change, arch, files);
+		// Released once the lock is, lookups may still be using it
+		ResourceIndexPtr oldIndex;
+		{
+			OGRE_LOCK_RW_MUTEX_WRITE(mResourceIndexMutex);
+			oldIndex = grp->resourceIndex;
+			grp->resourceIndex = newIndex;
+		}
+		--mIndexWriters;
+	}
+	//---------------------------------------------------------------------
+	Archive* ResourceGroupManager::findArchive(const ResourceIndex& index, const String& resourceName)
+	{
+		++mLookupCount;
+
+		ResourceLocationIndex::const_iterator rit = index.caseSensitive.find(resourceName);
+		if (rit != index.caseSensitive.end())
+			return rit->second;
+
+		if (!index.caseInsensitive.empty())
+		{
+			String lcResourceName = resourceName;
+			StringUtil::toLowerCase(lcResourceName);
+			rit = index.caseInsensitive.find(lcResourceName);
+			if (rit != index.caseInsensitive.end())
+				return rit->second;
+		}
+
+		// Search the hard way
+		++mArchiveSearchCount;
+		for (vector<Archive*>::type::const_iterator a = index.archives.begin();
+			a != index.archives.end(); ++a)
+		{
+			++mArchiveProbeCount;
+			if ((*a)->exists(resourceName))
+				return *a;
+		}
+		return 0;
+	}
+	//---------------------------------------------------------------------
+	ResourceGroupManager::ResourceLookupStats ResourceGroupManager::getResourceLookupStats(void) const
+	{
+		ResourceLookupStats stats;
+		stats.lookups = mLookupCount.get();
+		stats.archiveSearches = mArchiveSearchCount.get();
+		stats.archiveProbes = mArchiveProbeCount.get();
+		stats.contendedLookups = mContendedLookupCount.get();
+		stats.indexUpdates = mIndexUpdateCount.get();
+		stats.indexCopies = mIndexCopyCount.get();
+		return stats;
+	}
+	//---------------------------------------------------------------------
+	void ResourceGroupManager::resetResourceLookupStats(void)
+	{
+		mLookupCount.set(0);
+		mArchiveSearchCount.set(0);
+		mArchiveProbeCount.set(0);
+		mContendedLookupCount.set(0);
+		mIndexUpdateCount.set(0);
+		mIndexCopyCount.set(0);
+	}
+	//---------------------------------------------------------------------
+	void ResourceGroupManager::ResourceIndex::add(const String& filename, Archive* arch)
+	{
+		caseSensitive[filename] = arch;
 
 		if (!arch->isCaseSensitive())
 		{
 			String lcase = filename;
 			StringUtil::toLowerCase(lcase);
-			this->resourceIndexCaseInsensitive[lcase] = arch;
+			caseInsensitive[lcase] = arch;
 		}
 	}
 	//---------------------------------------------------------------------
-	void ResourceGroupManager::ResourceGroup::removeFromIndex(const String& filename, Archive* arch)
+	void ResourceGroupManager::ResourceIndex::remove(const String& filename, Archive* arch)
 	{
-		// internal, assumes mutex lock has already been obtained
-		ResourceLocationIndex::iterator i = this->resourceIndexCaseSensitive.find(filename);
-		if (i != this->resourceIndexCaseSensitive.end() && i->second == arch)
-			this->resourceIndexCaseSensitive.erase(i);
+		ResourceLocationIndex::iterator i = caseSensitive.find(filename);
+		if (i != caseSensitive.end() && i->second == arch)
+			caseSensitive.erase(i);
 
 		if (!arch->isCaseSensitive())
 		{
 			String lcase = filename;
 			StringUtil::toLowerCase(lcase);
-			i = this->resourceIndexCaseInsensitive.find(filename);
-			if (i != this->resourceIndexCaseInsensitive.end() && i->second == arch)
-				this->resourceIndexCaseInsensitive.erase(i);
+			i = caseInsensitive.find(lcase);
+			if (i != caseInsensitive.end() && i->second == arch)
+				caseInsensitive.erase(i);
 		}
 	}
 	//---------------------------------------------------------------------
-	void ResourceGroupManager::ResourceGroup::removeFromIndex(Archive* arch)
+	void ResourceGroupManager::ResourceIndex::remove(Archive* arch)
 	{
 		// Delete indexes
 		ResourceLocationIndex::iterator rit, ritend;
-		ritend = this->resourceIndexCaseInsensitive.end();
-		for (rit = this->resourceIndexCaseInsensitive.begin(); rit != ritend;)
+		ritend = caseInsensitive.end();
+		for (rit = caseInsensitive.begin(); rit != ritend;)
 		{
 			if (rit->second == arch)
 			{
 				ResourceLocationIndex::iterator del = rit++;
-				this->resourceIndexCaseInsensitive.erase(del);
+				caseInsensitive.erase(del);
 			}
 			else
 			{
 				++rit;
 			}
 		}
-		ritend = this->resourceIndexCaseSensitive.end();
-		for (rit = this->resourceIndexCaseSensitive.begin(); rit != ritend;)
+		ritend = caseSensitive.end();
+		for (rit = caseSensitive.begin(); rit != ritend;)
 		{
 			if (rit->second == arch)
 			{
 				ResourceLocationIndex::iterator del = rit++;
-				this->resourceIndexCaseSensitive.erase(del);
+				caseSensitive.erase(del);
 			}
 			else
 			{
@@ -2019,6 +2177,31 @@ namespace Ogre {
 			}
 		}
 
+		vector<Archive*>::type::iterator a = std::find(archives.begin(), archives.end(), arch);
+		if (a != archives.end())
+			archives.erase(a);
+	}
+	//---------------------------------------------------------------------
+	void ResourceGroupManager::ResourceIndex::apply(Change change, Archive* arch, 
+		const StringVector& files)
+	{
+		switch (change)
+		{
+		case ADD_ARCHIVE:
+			archives.push_back(arch);
+			// fall through
+		case ADD_FILES:
+			for (StringVector::const_iterator f = files.begin(); f != files.end(); ++f)
+				add(*f, arch);
+			break;
+		case REMOVE_ARCHIVE:
+			remove(arch);
+			break;
+		case REMOVE_FILES:
+			for (StringVector::const_iterator f = files.begin(); f != files.end(); ++f)
+				remove(*f, arch);
+			break;
+		}
 	}
 	//---------------------------------------------------------------------
 	//-----------------------------------------------------------------------
@@ -52,6 +52,7 @@ THE SOFTWARE.
 #include "OgreArchiveManager.h"
 #include "OgrePlugin.h"
 #include "OgreFileSystem.h"
+#include "OgrePackArchive.h"
 #include "OgreShadowVolumeExtrudeProgram.h"
 #include "OgreResourceBackgroundQueue.h"
 #include "OgreEntity.h"
@@ -221,6 +222,8 @@ namespace Ogre {
 
         mFileSystemArchiveFactory = OGRE_NEW FileSystemArchiveFactory();
         ArchiveManager::getSingleton().addArchiveFactory( mFileSystemArchiveFactory );        
+        mPackArchiveFactory = OGRE_NEW PackArchiveFactory();
+        ArchiveManager::getSingleton().addArchiveFactory( mPackArchiveFactory );
 #   if OGRE_NO_ZIP_ARCHIVE == 0
         mZipArchiveFactory = OGRE_NEW ZipArchiveFactory();
         ArchiveManager::getSingleton().addArchiveFactory( mZipArchiveFactory );
@@ -320,6 +323,7 @@ namespace Ogre {
         OGRE_DELETE mZipArchiveFactory;
         OGRE_DELETE mEmbeddedZipArchiveFactory;
 #   endif
+        OGRE_DELETE mPackArchiveFactory;
         OGRE_DELETE mFileSystemArchiveFactory;
         
         OGRE_DELETE mSkeletonManager;
@@ -885,6 +889,18 @@ namespace Ogre {
 		// Tell the queue to process responses
 		mWorkQueue->processResponses();
 
+		// Copy the uploads queued by the responses and background loads
+		if (HardwareBufferManager::getSingletonPtr())
+			HardwareBufferManager::getSingleton()._flushUploads();
+		// Streamed textures switch to the levels uploaded by now
+		TextureManager* textureMgr = TextureManager::getSingletonPtr();
+		if (textureMgr && textureMgr->_hasStreamedTextures())
+			textureMgr->_updateStreamedUploads();
+		// Streamed LOD meshes which finished loading count against the budget now
+		MeshManager* meshMgr = MeshManager::getSingletonPtr();
+		if (meshMgr && meshMgr->_hasStreamedLods())
+			meshMgr->_updateLodStreaming();
+
 		OgreProfileEndGroup("Frame", OGREPROF_GENERAL);
 
         return ret;
@@ -34,6 +34,20 @@ THE SOFTWARE.
 
 namespace Ogre
 {
+	namespace
+	{
+		/// Tokenizes a whole script stream, in place if it is memory backed (e.g. mapped)
+		ScriptTokenListPtr tokenizeStream(ScriptLexer &lexer, DataStreamPtr &stream, const String &source)
+		{
+			size_t size = stream->size();
+			stream->seek(0);
+			const char *data = size ? static_cast<const char*>(stream->peek(size)) : 0;
+			if(data)
+				return lexer.tokenize(data, data + size, source);
+			return lexer.tokenize(stream->getAsString(), source);
+		}
+	}
+
 	// AbstractNode
 	AbstractNode::AbstractNode(AbstractNode *ptr)
 		:line(0), type(ANT_UNKNOWN), parent(ptr)
@@ -594,7 +608,7 @@ namespace Ogre
 			if(!stream.isNull())
 			{
 				ScriptLexer lexer;
-				ScriptTokenListPtr tokens = lexer.tokenize(stream->getAsString(), name);
+				ScriptTokenListPtr tokens = tokenizeStream(lexer, stream, name);
 				ScriptParser parser;
 				nodes = parser.parse(tokens);
 			}
@@ -1674,7 +1688,10 @@ namespace Ogre
 			OGRE_LOCK_AUTO_MUTEX
 			OGRE_THREAD_POINTER_GET(mScriptCompiler)->setListener(mListener);
 		}
-        OGRE_THREAD_POINTER_GET(mScriptCompiler)->compile(stream->getAsString(), stream->getName(), groupName);
+		ScriptLexer lexer;
+		ScriptParser parser;
+		ConcreteNodeListPtr nodes = parser.parse(tokenizeStream(lexer, stream, stream->getName()));
+        OGRE_THREAD_POINTER_GET(mScriptCompiler)->compile(nodes, groupName);
     }
 
 	//-------------------------------------------------------------------------
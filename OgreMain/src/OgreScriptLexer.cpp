@@ -36,6 +36,17 @@ namespace Ogre{
 	}
 
 	ScriptTokenListPtr ScriptLexer::tokenize(const String &str, const String &source)
+	{
+		return tokenizeRange(str.begin(), str.end(), source);
+	}
+
+	ScriptTokenListPtr ScriptLexer::tokenize(const char *begin, const char *end, const String &source)
+	{
+		return tokenizeRange(begin, end, source);
+	}
+
+	template <typename Iterator>
+	ScriptTokenListPtr ScriptLexer::tokenizeRange(Iterator i, Iterator end, const String &source)
 	{
 		// State enums
 		enum{ READY = 0, COMMENT, MULTICOMMENT, WORD, QUOTE, VAR, POSSIBLECOMMENT };
@@ -54,7 +65,6 @@ namespace Ogre{
 		ScriptTokenListPtr tokens(OGRE_NEW_T(ScriptTokenList, MEMCATEGORY_GENERAL)(), SPFM_DELETE_T);
 
 		// Iterate over the input
-		String::const_iterator i = str.begin(), end = str.end();
 		while(i != end)
 		{
 			lastc = c;
@@ -43,7 +43,8 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     SubEntity::SubEntity (Entity* parent, SubMesh* subMeshBasis)
         : Renderable(), mParentEntity(parent), mMaterialName("BaseWhite"),
-		mSubMesh(subMeshBasis), mCachedCamera(0)
+		mSubMesh(subMeshBasis), mCachedCamera(0), mClusterIndexData(0),
+		mClusterIndexDataActive(false), mAllClustersCulled(false)
     {
         mMaterial = MaterialManager::getSingleton().getByName(mMaterialName, subMeshBasis->parent->getGroup());
         mMaterialLodIndex = 0;
@@ -55,8 +56,18 @@ namespace Ogre {
 		mHardwareVertexAnimVertexData = 0;
 		mHardwarePoseCount = 0;
 
-
-
+		// Let vertex programs undo position quantisation
+		const VertexData* vertexData = subMeshBasis->useSharedVertices ?
+			subMeshBasis->parent->sharedVertexData : subMeshBasis->vertexData;
+		const VertexElement* posElem = vertexData ?
+			vertexData->vertexDeclaration->findElementBySemantic(VES_POSITION) : 0;
+		if (posElem && posElem->getType() == VET_SHORT4_SNORM)
+		{
+			setCustomParameter(CUSTOM_PARAM_POSITION_SCALE, Vector4(vertexData->positionScale.x,
+				vertexData->positionScale.y, vertexData->positionScale.z, 1));
+			setCustomParameter(CUSTOM_PARAM_POSITION_BIAS, Vector4(vertexData->positionBias.x,
+				vertexData->positionBias.y, vertexData->positionBias.z, 0));
+		}
     }
     //-----------------------------------------------------------------------
     SubEntity::~SubEntity()
@@ -67,6 +78,8 @@ namespace Ogre {
 			OGRE_DELETE mHardwareVertexAnimVertexData;
 		if (mSoftwareVertexAnimVertexData)
 			OGRE_DELETE mSoftwareVertexAnimVertexData;
+		if (mClusterIndexData)
+			OGRE_DELETE mClusterIndexData;
     }
     //-----------------------------------------------------------------------
     SubMesh* SubEntity::getSubMesh(void)
@@ -155,8 +168,104 @@ namespace Ogre {
         mSubMesh->_getRenderOperation(op, mParentEntity->mMeshLodIndex);
 		// Deal with any vertex data overrides
 		op.vertexData = getVertexDataForBinding();
+		// Only the clusters which passed culling
+		if (mClusterIndexDataActive)
+			op.indexData = mClusterIndexData;
 
     }
+	//-----------------------------------------------------------------------
+	void SubEntity::updateClusterCulling(const Plane* planes, size_t planeCount,
+		bool coneTest, const Vector3& cameraPosition)
+	{
+		const SubMesh::TriangleClusterList& clusters = mSubMesh->getClusters();
+		const IndexData* source = mSubMesh->indexData;
+		if (clusters.empty() || source->indexBuffer.isNull() ||
+			!source->indexBuffer->hasShadowBuffer())
+		{
+			resetClusterCulling();
+			return;
+		}
+
+		// Gather the visible clusters, merging neighbours into one range
+		mClusterRangesScratch.clear();
+		size_t visibleIndexCount = 0;
+		bool anyCulled = false;
+		SubMesh::TriangleClusterList::const_iterator c, cend;
+		cend = clusters.end();
+		for (c = clusters.begin(); c != cend; ++c)
+		{
+			bool visible = true;
+			for (size_t p = 0; p < planeCount && visible; ++p)
+				visible = planes[p].getDistance(c->center) >= -c->radius;
+			if (visible && coneTest)
+			{
+				Vector3 toCluster = c->center - cameraPosition;
+				visible = toCluster.dotProduct(c->coneAxis) < c->coneCutoff * toCluster.length() + c->radius;
+			}
+			if (!visible)
+			{
+				anyCulled = true;
+				continue;
+			}
+
+			visibleIndexCount += c->indexCount;
+			const size_t n = mClusterRangesScratch.size();
+			if (n && mClusterRangesScratch[n - 2] + mClusterRangesScratch[n - 1] == c->indexStart)
+				mClusterRangesScratch[n - 1] += c->indexCount;
+			else
+			{
+				mClusterRangesScratch.push_back(c->indexStart);
+				mClusterRangesScratch.push_back(c->indexCount);
+			}
+		}
+
+		mAllClustersCulled = visibleIndexCount == 0;
+		if (!anyCulled || mAllClustersCulled)
+		{
+			mClusterIndexDataActive = false;
+			mVisibleClusterRanges.clear();
+			return;
+		}
+		// Same clusters as last time, the index buffer holds them already
+		if (mClusterIndexDataActive && mClusterRangesScratch == mVisibleClusterRanges)
+			return;
+		mVisibleClusterRanges.swap(mClusterRangesScratch);
+
+		const HardwareIndexBufferSharedPtr& srcBuf = source->indexBuffer;
+		if (!mClusterIndexData)
+		{
+			mClusterIndexData = OGRE_NEW IndexData();
+			mClusterIndexData->indexBuffer = HardwareBufferManager::getSingleton().createIndexBuffer(
+				srcBuf->getType(), source->indexCount,
+				HardwareBuffer::HBU_DYNAMIC_WRITE_ONLY_DISCARDABLE, false);
+		}
+
+		const size_t indexSize = srcBuf->getIndexSize();
+		const uint8* pSrc = static_cast<const uint8*>(srcBuf->lock(
+			source->indexStart * indexSize, source->indexCount * indexSize,
+			HardwareBuffer::HBL_READ_ONLY));
+		uint8* pDst = static_cast<uint8*>(mClusterIndexData->indexBuffer->lock(
+			0, visibleIndexCount * indexSize, HardwareBuffer::HBL_DISCARD));
+		for (size_t r = 0; r < mVisibleClusterRanges.size(); r += 2)
+		{
+			const size_t bytes = mVisibleClusterRanges[r + 1] * indexSize;
+			memcpy(pDst, pSrc + mVisibleClusterRanges[r] * indexSize, bytes);
+			pDst += bytes;
+		}
+		mClusterIndexData->indexBuffer->unlock();
+		srcBuf->unlock();
+
+		mClusterIndexData->indexStart = 0;
+		mClusterIndexData->indexCount = visibleIndexCount;
+		mClusterIndexDataActive = true;
+	}
+	//-----------------------------------------------------------------------
+	void SubEntity::resetClusterCulling(void)
+	{
+		mClusterIndexDataActive = false;
+		mAllClustersCulled = false;
+		mVisibleClusterRanges.clear();
+	}
 	//-----------------------------------------------------------------------
 	VertexData* SubEntity::getVertexDataForBinding(void)
 	{
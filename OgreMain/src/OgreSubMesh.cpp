@@ -33,6 +33,7 @@ THE SOFTWARE.
 #include "OgreMeshManager.h"
 #include "OgreMaterialManager.h"
 #include "OgreStringConverter.h"
+#include "OgreLogManager.h"
 
 namespace Ogre {
     //-----------------------------------------------------------------------
@@ -444,6 +445,324 @@ namespace Ogre {
 
         vbuf->unlock ();
     }
+    //---------------------------------------------------------------------
+	void SubMesh::optimiseVertexCache(bool reorderVertices)
+	{
+		bool rebuildEdges = parent->isEdgeListBuilt();
+		parent->freeEdgeList();
+
+		optimiseVertexCacheImpl(reorderVertices);
+
+		if (rebuildEdges)
+			parent->buildEdgeList();
+	}
+    //---------------------------------------------------------------------
+	void SubMesh::optimiseVertexCacheImpl(bool reorderVertices)
+	{
+		if (operationType == RenderOperation::OT_TRIANGLE_LIST)
+		{
+			if (indexData->indexCount > 0)
+				indexData->optimiseVertexCacheTriList();
+			if (!mClusters.empty())
+			{
+				// The new triangle order breaks the clusters up, gather them again
+				uint32 clusterTriangles = 0;
+				for (TriangleClusterList::const_iterator c = mClusters.begin(); c != mClusters.end(); ++c)
+					clusterTriangles = std::max(clusterTriangles, c->indexCount / 3);
+				buildClustersImpl(clusterTriangles);
+			}
+			for (LODFaceList::iterator i = mLodFaceList.begin(); i != mLodFaceList.end(); ++i)
+			{
+				if (*i && (*i)->indexCount > 0)
+					(*i)->optimiseVertexCacheTriList();
+			}
+		}
+
+		// Morph and pose keyframes address vertices by position in the buffer, and
+		// shadow volume buffers hold a second copy which we would not move
+		if (!reorderVertices || useSharedVertices || !vertexData ||
+			getVertexAnimationType() != VAT_NONE || parent->getPoseCount() > 0 ||
+			parent->isPreparedForShadowVolumes())
+			return;
+
+		vector<IndexData*>::type indexDataList;
+		if (!getIndexDataForAllLods(indexDataList))
+			return;
+
+		vector<uint32>::type vertexRemap;
+		vertexData->optimiseVertexFetch(indexDataList, vertexRemap);
+		remapBoneAssignments(mBoneAssignments, vertexRemap);
+	}
+    //---------------------------------------------------------------------
+	bool SubMesh::getIndexDataForAllLods(vector<IndexData*>::type& outList) const
+	{
+		if (indexData->indexBuffer.isNull() || indexData->indexCount == 0)
+			return false;
+		outList.push_back(indexData);
+
+		for (LODFaceList::const_iterator i = mLodFaceList.begin(); i != mLodFaceList.end(); ++i)
+		{
+			if (!*i)
+				continue;
+			if ((*i)->indexBuffer.isNull() || (*i)->indexCount == 0)
+				return false;
+			outList.push_back(*i);
+		}
+		return true;
+	}
+    //---------------------------------------------------------------------
+	void SubMesh::remapBoneAssignments(VertexBoneAssignmentList& assignments,
+		const vector<uint32>::type& vertexRemap)
+	{
+		VertexBoneAssignmentList remapped;
+		for (VertexBoneAssignmentList::const_iterator i = assignments.begin(); i != assignments.end(); ++i)
+		{
+			VertexBoneAssignment vba = i->second;
+			vba.vertexIndex = vertexRemap[vba.vertexIndex];
+			remapped.insert(VertexBoneAssignmentList::value_type(vba.vertexIndex, vba));
+		}
+		assignments.swap(remapped);
+	}
+    //---------------------------------------------------------------------
+	// Local utilities for SubMesh::buildClusters
+	namespace
+	{
+		/** Reads the first count positions of a vertex data, undoing quantisation
+		@return
+			False if positions are in a format we don't read.
+		*/
+		bool readClusterPositions(const VertexData* vertexData, size_t count,
+			vector<Vector3>::type& positions)
+		{
+			const VertexElement* posElem =
+				vertexData->vertexDeclaration->findElementBySemantic(VES_POSITION);
+			if (!posElem || count > vertexData->vertexCount ||
+				!VertexData::canReadPosition(posElem->getType()))
+				return false;
+
+			HardwareVertexBufferSharedPtr vbuf =
+				vertexData->vertexBufferBinding->getBuffer(posElem->getSource());
+			const size_t vertexSize = vbuf->getVertexSize();
+			const uint8* pVert = static_cast<const uint8*>(vbuf->lock(
+				vertexData->vertexStart * vertexSize, count * vertexSize,
+				HardwareBuffer::HBL_READ_ONLY));
+
+			positions.resize(count);
+			for (size_t v = 0; v < count; ++v, pVert += vertexSize)
+				positions[v] = vertexData->readPosition(posElem, pVert);
+			vbuf->unlock();
+			return true;
+		}
+
+		/// Calculates the bounding sphere and normal cone of a cluster
+		void calculateClusterBounds(const uint32* indexes, size_t indexCount,
+			const vector<Vector3>::type& positions, SubMesh::TriangleCluster& cluster)
+		{
+			Vector3 minimum = positions[indexes[0]];
+			Vector3 maximum = minimum;
+			for (size_t i = 1; i < indexCount; ++i)
+			{
+				minimum.makeFloor(positions[indexes[i]]);
+				maximum.makeCeil(positions[indexes[i]]);
+			}
+			cluster.center = (minimum + maximum) * 0.5f;
+			Real radiusSq = 0;
+			for (size_t i = 0; i < indexCount; ++i)
+				radiusSq = std::max(radiusSq, (positions[indexes[i]] - cluster.center).squaredLength());
+			cluster.radius = Math::Sqrt(radiusSq);
+
+			// The cone axis is the average unit face normal, the cutoff follows from the
+			// face bending away from it the most
+			Vector3 axis = Vector3::ZERO;
+			for (size_t i = 0; i < indexCount; i += 3)
+			{
+				const Vector3& p0 = positions[indexes[i]];
+				Vector3 normal = (positions[indexes[i + 1]] - p0).crossProduct(positions[indexes[i + 2]] - p0);
+				Real length = normal.length();
+				if (length > 0)
+					axis += normal / length;
+			}
+			cluster.coneAxis = Vector3::UNIT_Z;
+			cluster.coneCutoff = 1;
+			Real axisLength = axis.length();
+			if (axisLength <= 0)
+				return;
+			axis /= axisLength;
+			cluster.coneAxis = axis;
+
+			Real minDot = 1;
+			for (size_t i = 0; i < indexCount; i += 3)
+			{
+				const Vector3& p0 = positions[indexes[i]];
+				Vector3 normal = (positions[indexes[i + 1]] - p0).crossProduct(positions[indexes[i + 2]] - p0);
+				Real length = normal.length();
+				if (length > 0)
+					minDot = std::min(minDot, normal.dotProduct(axis) / length);
+			}
+			// Nearly a half sphere of normals or more, the cluster always shows some face
+			if (minDot > 0.1f)
+				cluster.coneCutoff = Math::Sqrt(1 - minDot * minDot);
+		}
+	}
+    //---------------------------------------------------------------------
+	void SubMesh::buildClusters(size_t maxTriangles)
+	{
+		bool rebuildEdges = parent->isEdgeListBuilt();
+		parent->freeEdgeList();
+
+		buildClustersImpl(maxTriangles);
+
+		if (rebuildEdges)
+			parent->buildEdgeList();
+	}
+    //---------------------------------------------------------------------
+	void SubMesh::buildClustersImpl(size_t maxTriangles)
+	{
+		mClusters.clear();
+
+		VertexData* vertData = useSharedVertices ? parent->sharedVertexData : vertexData;
+		if (operationType != RenderOperation::OT_TRIANGLE_LIST || !vertData ||
+			indexData->indexBuffer.isNull() || indexData->indexCount < 3 || maxTriangles == 0)
+			return;
+		if (indexData->indexBuffer->isLocked())
+			return;
+
+		const size_t nTriangles = indexData->indexCount / 3;
+		const size_t nIndexes = nTriangles * 3;
+		const HardwareIndexBufferSharedPtr& ibuf = indexData->indexBuffer;
+		const bool use32bit = ibuf->getType() == HardwareIndexBuffer::IT_32BIT;
+
+		vector<uint32>::type indexes(nIndexes);
+		uint32 nVertices = 0;
+		{
+			const void* buffer = ibuf->lock(indexData->indexStart * ibuf->getIndexSize(),
+				nIndexes * ibuf->getIndexSize(), HardwareBuffer::HBL_READ_ONLY);
+			for (size_t i = 0; i < nIndexes; ++i)
+			{
+				indexes[i] = use32bit ? static_cast<const uint32*>(buffer)[i] :
+					static_cast<const uint16*>(buffer)[i];
+				nVertices = std::max(nVertices, indexes[i] + 1);
+			}
+			ibuf->unlock();
+		}
+
+		vector<Vector3>::type positions;
+		if (!readClusterPositions(vertData, nVertices, positions))
+		{
+			LogManager::getSingleton().logMessage("WARNING: Can't build triangle clusters of a SubMesh of " +
+				parent->getName() + ", its positions are not float or quantised.");
+			return;
+		}
+
+		vector<Vector3>::type triangleCentres(nTriangles);
+		for (size_t t = 0; t < nTriangles; ++t)
+		{
+			triangleCentres[t] = (positions[indexes[t * 3]] + positions[indexes[t * 3 + 1]] +
+				positions[indexes[t * 3 + 2]]) / 3;
+		}
+
+		// Triangles per vertex, as ranges into one adjacency list
+		vector<uint32>::type adjacencyStart(nVertices + 1, 0);
+		for (size_t i = 0; i < nIndexes; ++i)
+			++adjacencyStart[indexes[i] + 1];
+		for (uint32 v = 0; v < nVertices; ++v)
+			adjacencyStart[v + 1] += adjacencyStart[v];
+		vector<uint32>::type adjacency(nIndexes);
+		{
+			vector<uint32>::type fill(adjacencyStart.begin(), adjacencyStart.end() - 1);
+			for (size_t i = 0; i < nIndexes; ++i)
+				adjacency[fill[indexes[i]]++] = static_cast<uint32>(i / 3);
+		}
+
+		// Grow each cluster from a seed over shared vertices. Stamps hold the number of the
+		// cluster which last used a vertex or listed a triangle, so nothing is reset in between
+		vector<uint32>::type vertexStamp(nVertices, 0);
+		vector<uint32>::type candidateStamp(nTriangles, 0);
+		vector<unsigned char>::type emitted(nTriangles, 0);
+		vector<uint32>::type candidates;
+		vector<uint32>::type clustered;
+		clustered.reserve(nIndexes);
+		size_t nextSeed = 0;
+		uint32 clusterNumber = 0;
+		while (clustered.size() < nIndexes)
+		{
+			++clusterNumber;
+			while (emitted[nextSeed])
+				++nextSeed;
+			candidates.clear();
+			candidates.push_back(static_cast<uint32>(nextSeed));
+			candidateStamp[nextSeed] = clusterNumber;
+
+			const size_t clusterBegin = clustered.size();
+			Vector3 centreSum = Vector3::ZERO;
+			size_t clusterTriangles = 0;
+			while (clusterTriangles < maxTriangles && !candidates.empty())
+			{
+				// Fewest new vertices first, then the triangle nearest the cluster centre
+				const Vector3 centre = clusterTriangles ? centreSum / Real(clusterTriangles) : Vector3::ZERO;
+				size_t best = 0;
+				int bestNewVertices = 4;
+				Real bestDistance = std::numeric_limits<Real>::max();
+				for (size_t c = 0; c < candidates.size(); ++c)
+				{
+					const uint32 t = candidates[c];
+					int newVertices = 0;
+					for (size_t k = 0; k < 3; ++k)
+						newVertices += vertexStamp[indexes[t * 3 + k]] != clusterNumber;
+					Real distance = (triangleCentres[t] - centre).squaredLength();
+					if (newVertices < bestNewVertices ||
+						(newVertices == bestNewVertices && distance < bestDistance))
+					{
+						best = c;
+						bestNewVertices = newVertices;
+						bestDistance = distance;
+					}
+				}
+
+				const uint32 t = candidates[best];
+				candidates[best] = candidates.back();
+				candidates.pop_back();
+				emitted[t] = 1;
+				++clusterTriangles;
+				centreSum += triangleCentres[t];
+
+				for (size_t k = 0; k < 3; ++k)
+				{
+					const uint32 v = indexes[t * 3 + k];
+					clustered.push_back(v);
+					if (vertexStamp[v] == clusterNumber)
+						continue;
+					vertexStamp[v] = clusterNumber;
+					for (uint32 a = adjacencyStart[v]; a < adjacencyStart[v + 1]; ++a)
+					{
+						const uint32 neighbour = adjacency[a];
+						if (!emitted[neighbour] && candidateStamp[neighbour] != clusterNumber)
+						{
+							candidateStamp[neighbour] = clusterNumber;
+							candidates.push_back(neighbour);
+						}
+					}
+				}
+			}
+
+			TriangleCluster cluster;
+			cluster.indexStart = static_cast<uint32>(clusterBegin);
+			cluster.indexCount = static_cast<uint32>(clustered.size() - clusterBegin);
+			calculateClusterBounds(&clustered[clusterBegin], cluster.indexCount, positions, cluster);
+			mClusters.push_back(cluster);
+		}
+
+		void* buffer = ibuf->lock(indexData->indexStart * ibuf->getIndexSize(),
+			nIndexes * ibuf->getIndexSize(), HardwareBuffer::HBL_NORMAL);
+		for (size_t i = 0; i < nIndexes; ++i)
+		{
+			if (use32bit)
+				static_cast<uint32*>(buffer)[i] = clustered[i];
+			else
+				static_cast<uint16*>(buffer)[i] = static_cast<uint16>(clustered[i]);
+		}
+		ibuf->unlock();
+	}
 	 //---------------------------------------------------------------------
 	void SubMesh::setBuildEdgesEnabled(bool b)
 	{
@@ -30,6 +30,7 @@ THE SOFTWARE.
 #include "OgreHardwareBufferManager.h"
 #include "OgreLogManager.h"
 #include "OgreException.h"
+#include "OgreParallelFor.h"
 
 namespace Ogre
 {
@@ -216,13 +217,69 @@ namespace Ogre
 
 	}
 	//---------------------------------------------------------------------
+	// Calculates the tangent space of a range of faces.
+	// Each face only writes its own FaceInfo, vertices are read only.
+	struct TangentSpaceCalc::FaceWorker
+	{
+		TangentSpaceCalc* calc;
+		size_t begin;
+		size_t end;
+
+		FaceWorker(TangentSpaceCalc* c, size_t first, size_t last)
+			: calc(c), begin(first), end(last) {}
+
+		void run() { calc->calculateFaces(begin, end); }
+	};
+	//---------------------------------------------------------------------
+	// Accumulates or normalises a range of vertices.
+	// Each vertex only writes its own VertexInfo.
+	struct TangentSpaceCalc::VertexWorker
+	{
+		TangentSpaceCalc* calc;
+		size_t begin;
+		size_t end;
+		bool accumulate;
+
+		VertexWorker(TangentSpaceCalc* c, size_t first, size_t last, bool accum)
+			: calc(c), begin(first), end(last), accumulate(accum) {}
+
+		void run()
+		{
+			if (accumulate)
+				calc->accumulateVertices(begin, end);
+			else
+				calc->normaliseVertices(begin, end);
+		}
+	};
+	//---------------------------------------------------------------------
+	size_t TangentSpaceCalc::getThreadCount(size_t itemCount) const
+	{
+		// Below a few thousand items per thread, spawning them costs more than it saves.
+		return std::max<size_t>(1, std::min(ParallelFor::getHardwareThreadCount(), itemCount / 4096));
+	}
+	//---------------------------------------------------------------------
 	void TangentSpaceCalc::normaliseVertices()
 	{
 		// Just run through our complete (possibly augmented) list of vertices
+		size_t vertexCount = mVertexArray.size();
+		size_t threadCount = getThreadCount(vertexCount);
+		size_t rangeSize = (vertexCount + threadCount - 1) / threadCount;
+		vector<VertexWorker>::type workers;
+		workers.reserve(threadCount);
+		for (size_t t = 0; t < threadCount; ++t)
+		{
+			size_t first = std::min(t * rangeSize, vertexCount);
+			workers.push_back(VertexWorker(this, first, std::min(first + rangeSize, vertexCount), false));
+		}
+		ParallelFor::runWorkers(workers);
+	}
+	//---------------------------------------------------------------------
+	void TangentSpaceCalc::normaliseVertices(size_t begin, size_t end)
+	{
 		// Normalise the tangents & binormals
-		for (VertexInfoArray::iterator i = mVertexArray.begin(); i != mVertexArray.end(); ++i)
+		for (size_t i = begin; i < end; ++i)
 		{
-			VertexInfo& v = *i;
+			VertexInfo& v = mVertexArray[i];
 
 			v.tangent.normalise();
 			v.binormal.normalise();
@@ -236,7 +293,7 @@ namespace Ogre
 			temp = v.binormal;
 			v.binormal = temp - (v.norm * v.norm.dotProduct(temp));
 
-			// renormalize 
+			// renormalize
 			v.tangent.normalise();
 			v.binormal.normalise();
 
@@ -256,6 +313,93 @@ namespace Ogre
 			}
 		}
 
+		readFaces();
+
+		// For each triangle
+		//   Calculate tangent & binormal per triangle
+		//   Note these are not normalised, are weighted by UV area
+		size_t faceCount = mFaceArray.size();
+		size_t threadCount = getThreadCount(faceCount);
+		size_t rangeSize = (faceCount + threadCount - 1) / threadCount;
+		vector<FaceWorker>::type faceWorkers;
+		faceWorkers.reserve(threadCount);
+		for (size_t t = 0; t < threadCount; ++t)
+		{
+			size_t first = std::min(t * rangeSize, faceCount);
+			faceWorkers.push_back(FaceWorker(this, first, std::min(first + rangeSize, faceCount)));
+		}
+		ParallelFor::runWorkers(faceWorkers);
+
+		if (mSplitMirrored || mSplitRotated)
+		{
+			// Whether a vertex splits depends on the faces added to it before,
+			// so this has to run in face order
+			for (FaceInfoArray::iterator f = mFaceArray.begin(); f != mFaceArray.end(); ++f)
+			{
+				// Skip invalid UV space triangles
+				if (f->parity)
+					addFaceTangentSpaceToVertices(*f, result);
+			}
+		}
+		else
+		{
+			// Nothing splits, so every vertex can sum its own faces. Listing them
+			// in face order adds them up in the same order as one face at a time.
+			size_t vertexCount = mVertexArray.size();
+			mVertexFaceStart.assign(vertexCount + 1, 0);
+			for (FaceInfoArray::iterator f = mFaceArray.begin(); f != mFaceArray.end(); ++f)
+			{
+				if (f->parity)
+				{
+					++mVertexFaceStart[f->vertInd[0] + 1];
+					++mVertexFaceStart[f->vertInd[1] + 1];
+					++mVertexFaceStart[f->vertInd[2] + 1];
+				}
+			}
+			for (size_t v = 0; v < vertexCount; ++v)
+				mVertexFaceStart[v + 1] += mVertexFaceStart[v];
+
+			mVertexFaceCorners.resize(mVertexFaceStart[vertexCount]);
+			vector<size_t>::type insertPos(mVertexFaceStart.begin(), mVertexFaceStart.end() - 1);
+			for (size_t f = 0; f < faceCount; ++f)
+			{
+				const FaceInfo& face = mFaceArray[f];
+				if (face.parity)
+				{
+					for (size_t v = 0; v < 3; ++v)
+						mVertexFaceCorners[insertPos[face.vertInd[v]]++] = f * 3 + v;
+				}
+			}
+
+			threadCount = getThreadCount(vertexCount);
+			rangeSize = (vertexCount + threadCount - 1) / threadCount;
+			vector<VertexWorker>::type vertexWorkers;
+			vertexWorkers.reserve(threadCount);
+			for (size_t t = 0; t < threadCount; ++t)
+			{
+				size_t first = std::min(t * rangeSize, vertexCount);
+				vertexWorkers.push_back(VertexWorker(this, first, std::min(first + rangeSize, vertexCount), true));
+			}
+			ParallelFor::runWorkers(vertexWorkers);
+
+			vector<size_t>::type().swap(mVertexFaceStart);
+			vector<size_t>::type().swap(mVertexFaceCorners);
+		}
+
+		FaceInfoArray().swap(mFaceArray);
+	}
+	//---------------------------------------------------------------------
+	void TangentSpaceCalc::readFaces()
+	{
+		size_t totalFaceCount = 0;
+		for (size_t i = 0; i < mIDataList.size(); ++i)
+		{
+			totalFaceCount += mOpTypes[i] == RenderOperation::OT_TRIANGLE_LIST ?
+				mIDataList[i]->indexCount / 3 : mIDataList[i]->indexCount - 2;
+		}
+		mFaceArray.clear();
+		mFaceArray.reserve(totalFaceCount);
+
 		for (size_t i = 0; i < mIDataList.size(); ++i)
 		{
 			IndexData* i_in = mIDataList[i];
@@ -283,7 +427,7 @@ namespace Ogre
 			// current triangle
 			size_t vertInd[3] = { 0, 0, 0 };
 			// loop through all faces to calculate the tangents and normals
-			size_t faceCount = opType == RenderOperation::OT_TRIANGLE_LIST ? 
+			size_t faceCount = opType == RenderOperation::OT_TRIANGLE_LIST ?
 				i_in->indexCount / 3 : i_in->indexCount - 2;
 			for (size_t f = 0; f < faceCount; ++f)
 			{
@@ -305,7 +449,7 @@ namespace Ogre
 				}
 				else if (opType == RenderOperation::OT_TRIANGLE_STRIP)
 				{
-					// Shunt everything down one, but also invert the ordering on 
+					// Shunt everything down one, but also invert the ordering on
 					// odd numbered triangles (== even numbered i's)
 					// we interpret front as anticlockwise all the time but strips alternate
 					if (f & 0x1)
@@ -314,64 +458,98 @@ namespace Ogre
 						invertOrdering = true;
 					}
 					vertInd[0] = vertInd[1];
-					vertInd[1] = vertInd[2];			
+					vertInd[1] = vertInd[2];
 					vertInd[2] = p32? *p32++ : *p16++;
 				}
 
 				// deal with strip inversion of winding
-				size_t localVertInd[3];
-				localVertInd[0] = vertInd[0];
+				FaceInfo face;
+				face.indexSet = i;
+				face.faceIndex = f;
+				face.vertInd[0] = vertInd[0];
 				if (invertOrdering)
 				{
-					localVertInd[1] = vertInd[2];
-					localVertInd[2] = vertInd[1];
+					face.vertInd[1] = vertInd[2];
+					face.vertInd[2] = vertInd[1];
 				}
 				else
 				{
-					localVertInd[1] = vertInd[1];
-					localVertInd[2] = vertInd[2];
+					face.vertInd[1] = vertInd[1];
+					face.vertInd[2] = vertInd[2];
 				}
+				face.parity = 0;
+				mFaceArray.push_back(face);
+			}
 
 
-				// For each triangle
-				//   Calculate tangent & binormal per triangle
-				//   Note these are not normalised, are weighted by UV area
-				Vector3 faceTsU, faceTsV, faceNorm;
-				calculateFaceTangentSpace(localVertInd, faceTsU, faceTsV, faceNorm);
-
-				// Skip invalid UV space triangles
-				if (faceTsU.isZeroLength() || faceTsV.isZeroLength())
-					continue;
+			ibuf->unlock();
+		}
 
-				addFaceTangentSpaceToVertices(i, f, localVertInd, faceTsU, faceTsV, faceNorm, result);
+	}
+	//---------------------------------------------------------------------
+	void TangentSpaceCalc::calculateFaces(size_t begin, size_t end)
+	{
+		for (size_t f = begin; f < end; ++f)
+		{
+			FaceInfo& face = mFaceArray[f];
+			calculateFaceTangentSpace(face.vertInd, face.tangent, face.binormal, face.norm);
 
+			// Skip invalid UV space triangles
+			if (face.tangent.isZeroLength() || face.binormal.isZeroLength())
+			{
+				face.parity = 0;
+				continue;
 			}
 
+			// Calculate parity for this triangle
+			face.parity = calculateParity(face.tangent, face.binormal, face.norm);
 
-			ibuf->unlock();
+			// We want to re-weight these by the angle the face makes with the vertex
+			// in order to obtain tesselation-independent results
+			for (int v = 0; v < 3; ++v)
+			{
+				face.angleWeight[v] = calculateAngleWeight(face.vertInd[v],
+					face.vertInd[(v+1)%3], face.vertInd[(v+2)%3]);
+			}
 		}
+	}
+	//---------------------------------------------------------------------
+	void TangentSpaceCalc::accumulateVertices(size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			VertexInfo& vertex = mVertexArray[i];
+			for (size_t c = mVertexFaceStart[i]; c < mVertexFaceStart[i + 1]; ++c)
+			{
+				size_t corner = mVertexFaceCorners[c];
+				const FaceInfo& face = mFaceArray[corner / 3];
+
+				// parity is set by the first face found (0 means not set)
+				if (!vertex.parity)
+					vertex.parity = face.parity;
 
+				// Add weighted tangent & binormal
+				Real angleWeight = face.angleWeight[corner % 3];
+				vertex.tangent += (face.tangent * angleWeight);
+				vertex.binormal += (face.binormal * angleWeight);
+			}
+		}
 	}
 	//---------------------------------------------------------------------
 	void TangentSpaceCalc::addFaceTangentSpaceToVertices(
-		size_t indexSet, size_t faceIndex, size_t *localVertInd, 
-		const Vector3& faceTsU, const Vector3& faceTsV, const Vector3& faceNorm, 
-		Result& result)
+		const FaceInfo& face, Result& result)
 	{
-		// Calculate parity for this triangle
-		int faceParity = calculateParity(faceTsU, faceTsV, faceNorm);
+		const Vector3& faceTsU = face.tangent;
+		const Vector3& faceTsV = face.binormal;
+		const Vector3& faceNorm = face.norm;
+		int faceParity = face.parity;
 		// Now add these to each vertex referenced by the face
 		for (int v = 0; v < 3; ++v)
 		{
 			// index 0 is vertex we're calculating, 1 and 2 are the others
+			Real angleWeight = face.angleWeight[v];
 
-			// We want to re-weight these by the angle the face makes with the vertex
-			// in order to obtain tesselation-independent results
-			Real angleWeight = calculateAngleWeight(localVertInd[v], 
-				localVertInd[(v+1)%3], localVertInd[(v+2)%3]);
-
-
-			VertexInfo* vertex = &(mVertexArray[localVertInd[v]]);
+			VertexInfo* vertex = &(mVertexArray[face.vertInd[v]]);
 
 			// check parity (0 means not set)
 			// Locate parity-version of vertex index, or create if doesn't exist
@@ -406,7 +584,7 @@ namespace Ogre
 						splitBecauseOfParity = true;
 
 						LogManager::getSingleton().stream(LML_TRIVIAL)
-							<< "TSC parity split - Vpar: " << vertex->parity 
+							<< "TSC parity split - Vpar: " << vertex->parity
 							<< " Fpar: " << faceParity
 							<< " faceTsU: " << faceTsU
 							<< " faceTsV: " << faceTsV
@@ -443,7 +621,7 @@ namespace Ogre
 			if (splitVertex)
 			{
 				size_t newVertexIndex = mVertexArray.size();
-				VertexSplit splitInfo(localVertInd[v], newVertexIndex);
+				VertexSplit splitInfo(face.vertInd[v], newVertexIndex);
 				result.vertexSplits.push_back(splitInfo);
 				// re-point opposite parity
 				if (splitBecauseOfParity)
@@ -456,7 +634,7 @@ namespace Ogre
 				locVertex.binormal = Vector3::ZERO;
 				locVertex.parity = faceParity;
 				mVertexArray.push_back(locVertex);
-				result.indexesRemapped.push_back(IndexRemap(indexSet, faceIndex, splitInfo));
+				result.indexesRemapped.push_back(IndexRemap(face.indexSet, face.faceIndex, splitInfo));
 
 				vertex = &(mVertexArray[newVertexIndex]);
 
@@ -464,8 +642,8 @@ namespace Ogre
 			else if (reusedOppositeParity)
 			{
 				// didn't split again, but we do need to record the re-used remapping
-				VertexSplit splitInfo(localVertInd[v], reusedOppositeParity);
-				result.indexesRemapped.push_back(IndexRemap(indexSet, faceIndex, splitInfo));
+				VertexSplit splitInfo(face.vertInd[v], reusedOppositeParity);
+				result.indexesRemapped.push_back(IndexRemap(face.indexSet, face.faceIndex, splitInfo));
 
 			}
 
@@ -568,6 +746,20 @@ namespace Ogre
 				"TangentSpaceCalc::build");
 		}
 
+		// Quantised positions are decoded, quantised normals are read by vertex programs only
+		const VertexElement *posElem = dcl->findElementBySemantic(VES_POSITION);
+		const VertexElement *normElem = dcl->findElementBySemantic(VES_NORMAL);
+		if (!normElem)
+			OGRE_EXCEPT(Exception::ERR_ITEM_NOT_FOUND, 
+			"No vertex normals found", 
+			"TangentSpaceCalc::build");
+		if (!VertexData::canReadPosition(posElem->getType()) || normElem->getType() != VET_FLOAT3)
+		{
+			OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+				"Positions must be float or quantised and normals float, cannot calculate tangents.",
+				"TangentSpaceCalc::build");
+		}
+
 		HardwareVertexBufferSharedPtr uvBuf, posBuf, normBuf;
 		unsigned char *pUvBase, *pPosBase, *pNormBase;
 		size_t uvInc, posInc, normInc;
@@ -580,7 +772,6 @@ namespace Ogre
 		pUvBase += mVData->vertexStart * uvInc;
 
 		// find position
-		const VertexElement *posElem = dcl->findElementBySemantic(VES_POSITION);
 		if (posElem->getSource() == uvElem->getSource())
 		{
 			pPosBase = pUvBase;
@@ -597,12 +788,6 @@ namespace Ogre
 			pPosBase += mVData->vertexStart * posInc;
 		}
 		// find a normal buffer
-		const VertexElement *normElem = dcl->findElementBySemantic(VES_NORMAL);
-		if (!normElem)
-			OGRE_EXCEPT(Exception::ERR_ITEM_NOT_FOUND, 
-			"No vertex normals found", 
-			"TangentSpaceCalc::build");
-
 		if (normElem->getSource() == uvElem->getSource())
 		{
 			pNormBase = pUvBase;
@@ -635,10 +820,7 @@ namespace Ogre
 		VertexInfo* vInfo = &(mVertexArray[0]);
 		for (size_t v = 0; v < mVData->vertexCount; ++v, ++vInfo)
 		{
-			posElem->baseVertexPointerToElement(pPosBase, &pFloat);
-			vInfo->pos.x = *pFloat++;
-			vInfo->pos.y = *pFloat++;
-			vInfo->pos.z = *pFloat++;
+			vInfo->pos = mVData->readPosition(posElem, pPosBase);
 			pPosBase += posInc;
 
 			normElem->baseVertexPointerToElement(pNormBase, &pFloat);
@@ -28,11 +28,16 @@ THE SOFTWARE.
 #include "OgreStableHeaders.h"
 #include "OgreLogManager.h"
 #include "OgreHardwarePixelBuffer.h"
+#include "OgreHardwareBufferManager.h"
 #include "OgreImage.h"
+#include "OgreImageCodec.h"
 #include "OgreTexture.h"
 #include "OgreException.h"
 #include "OgreResourceManager.h"
+#include "OgreResourceGroupManager.h"
 #include "OgreTextureManager.h"
+#include "OgreRoot.h"
+#include "OgreRenderSystem.h"
 
 namespace Ogre {
 	//--------------------------------------------------------------------------
@@ -61,7 +66,13 @@ namespace Ogre {
             mDesiredIntegerBitDepth(0),
             mDesiredFloatBitDepth(0),
             mTreatLuminanceAsAlpha(false),
-            mInternalResourcesCreated(false)
+            mInternalResourcesCreated(false),
+            mStreaming(false),
+            mStreamingTopMip(0),
+            mStreamingSourceWidth(0),
+            mStreamingSourceHeight(0),
+            mStreamingSourceDepth(0),
+            mStreamingSourceMipmaps(0)
     {
         if (createParamDictionary("Texture"))
         {
@@ -77,6 +88,7 @@ namespace Ogre {
 			TextureManager& tmgr = TextureManager::getSingleton();
 			setNumMipmaps(tmgr.getDefaultNumMipmaps());
 			setDesiredBitDepths(tmgr.getPreferredIntegerBitDepth(), tmgr.getPreferredFloatBitDepth());
+			setStreaming(tmgr.getDefaultStreaming());
 		}
 
         
@@ -189,7 +201,63 @@ namespace Ogre {
 		if(images.size() < 1)
 			OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Cannot load empty vector of images",
 			 "Texture::loadImages");
-        
+
+		// Without hardware mipmap generation, build the mipmaps here and load them
+		// as custom mipmaps rather than leaving it to the render system's fallback
+		if((mUsage & TU_AUTOMIPMAP) && mNumRequestedMipmaps > 0 && images[0]->getNumMipmaps() == 0 &&
+			!PixelUtil::isCompressed(images[0]->getFormat()) && !renderSystemGeneratesMipmaps())
+		{
+			vector<Image>::type mipmapped(images.size());
+			ConstImagePtrList mipmappedPtrs;
+			for(size_t i = 0; i < images.size(); ++i)
+			{
+				mipmapped[i] = *images[i];
+				if(!mipmapped[i].generateMipmaps(mNumRequestedMipmaps, Image::FILTER_BOX, mHwGamma))
+					break;
+				mipmappedPtrs.push_back(&mipmapped[i]);
+			}
+			// A 1x1 image has no mipmaps to generate
+			if(mipmappedPtrs.size() == images.size() && mipmapped[0].getNumMipmaps() > 0)
+			{
+				loadImagesImpl(mipmappedPtrs);
+				return;
+			}
+		}
+
+		// A streamed texture starts with the small end of the mip chain of its file,
+		// which is all it can read back later
+		if(mStreaming && images.size() == 1 && images[0]->getNumMipmaps() > 0 &&
+			!mIsManual && ResourceGroupManager::getSingleton().resourceExists(mGroup, mName))
+		{
+			const Image& source = *images[0];
+			mStreamingSourceWidth = source.getWidth();
+			mStreamingSourceHeight = source.getHeight();
+			mStreamingSourceDepth = source.getDepth();
+			mStreamingSourceMipmaps = source.getNumMipmaps();
+
+			const size_t initialSize = TextureManager::getSingleton().getStreamingInitialSize();
+			size_t topMip = 0;
+			while(topMip < mStreamingSourceMipmaps &&
+				std::max(std::max(mStreamingSourceWidth, mStreamingSourceHeight), mStreamingSourceDepth) >> topMip > initialSize)
+				++topMip;
+
+			Image tail;
+			source.copyMipmapTail(topMip, tail);
+			ConstImagePtrList tailPtrs;
+			tailPtrs.push_back(&tail);
+			mNumMipmaps = mNumRequestedMipmaps = tail.getNumMipmaps();
+			mUsage &= ~TU_AUTOMIPMAP;
+			loadImagesImpl(tailPtrs);
+			mStreamingTopMip = topMip;
+			TextureManager::getSingleton()._registerStreamedTexture(this, tail);
+			return;
+		}
+
+		loadImagesImpl(images);
+	}
+	//--------------------------------------------------------------------------
+	void Texture::loadImagesImpl( const ConstImagePtrList& images )
+	{
 		// Set desired texture size and properties from images[0]
 		mSrcWidth = mWidth = images[0]->getWidth();
 		mSrcHeight = mHeight = images[0]->getHeight();
@@ -335,6 +403,115 @@ namespace Ogre {
         mSize = getNumFaces() * PixelUtil::getMemorySize(mWidth, mHeight, mDepth, mFormat);
 
     }
+	//-----------------------------------------------------------------------------
+	class Texture::DirectDecodeTarget : public ImageCodec::DecodeTarget
+	{
+	public:
+		DirectDecodeTarget(Texture* tex) : mTexture(tex) {}
+
+		bool begin(const ImageCodec::ImageData& data, size_t numFaces)
+		{
+			Texture* t = mTexture;
+
+			// Anything which changes the texels has to go through an Image
+			PixelFormat format = t->mDesiredFormat != PF_UNKNOWN ? t->mDesiredFormat :
+				PixelUtil::getFormatForBitDepths(data.format, t->mDesiredIntegerBitDepth, t->mDesiredFloatBitDepth);
+			if (t->mStreaming || t->mGamma != 1.0f || format != data.format ||
+				(t->mTreatLuminanceAsAlpha && data.format == PF_L8))
+				return false;
+
+			// Take the texture type from the file like render systems do for images
+			if (numFaces == 6)
+				t->mTextureType = TEX_TYPE_CUBE_MAP;
+			else if (t->mTextureType == TEX_TYPE_CUBE_MAP)
+				return false;
+			else if (data.depth > 1 && t->mTextureType != TEX_TYPE_2D_ARRAY)
+				t->mTextureType = TEX_TYPE_3D;
+
+			if (data.num_mipmaps > 0 || PixelUtil::isCompressed(data.format))
+			{
+				// The custom mipmaps in the file have priority over everything
+				t->mNumMipmaps = t->mNumRequestedMipmaps = data.num_mipmaps;
+				t->mUsage &= ~TU_AUTOMIPMAP;
+			}
+			else if ((t->mUsage & TU_AUTOMIPMAP) && t->mNumRequestedMipmaps > 0 &&
+				!t->renderSystemGeneratesMipmaps())
+			{
+				// The mipmaps would be generated from an Image
+				return false;
+			}
+
+			t->mSrcWidth = t->mWidth = data.width;
+			t->mSrcHeight = t->mHeight = data.height;
+			t->mSrcDepth = t->mDepth = data.depth;
+			t->mSrcFormat = t->mFormat = data.format;
+			t->createInternalResources();
+
+			// The device may have picked another format or size
+			HardwarePixelBufferSharedPtr buf = t->getBuffer(0, 0);
+			if (buf->getFormat() != data.format || buf->getWidth() != data.width ||
+				buf->getHeight() != data.height || buf->getDepth() != data.depth ||
+				t->mNumMipmaps < data.num_mipmaps)
+			{
+				t->freeInternalResources();
+				return false;
+			}
+			return true;
+		}
+
+		PixelBox lock(size_t face, size_t mipmap)
+		{
+			HardwarePixelBufferSharedPtr buf = mTexture->getBuffer(face, mipmap);
+			return buf->lock(Image::Box(0, 0, 0, buf->getWidth(), buf->getHeight(), buf->getDepth()),
+				HardwareBuffer::HBL_DISCARD);
+		}
+
+		void unlock(size_t face, size_t mipmap)
+		{
+			mTexture->getBuffer(face, mipmap)->unlock();
+		}
+
+	private:
+		Texture* mTexture;
+	};
+	//-----------------------------------------------------------------------------
+	bool Texture::_loadFromStream(DataStreamPtr& stream, const String& type)
+	{
+		if (!_canLoadFromStream(type))
+			return false;
+
+		ImageCodec* codec = static_cast<ImageCodec*>(Codec::getCodec(type));
+		DirectDecodeTarget target(this);
+		if (!codec->decodeTo(stream, target))
+			return false;
+
+		mSize = getNumFaces() * PixelUtil::getMemorySize(mWidth, mHeight, mDepth, mFormat);
+		if (TextureManager::getSingleton().getVerbose())
+		{
+			LogManager::getSingleton().stream()
+				<< "Texture: " << mName << ": Decoded " << getNumFaces() << " faces ("
+				<< PixelUtil::getFormatName(mFormat) << "," << mWidth << "x" << mHeight << "x" << mDepth
+				<< ") with " << mNumMipmaps << " custom mipmaps straight into the hardware buffers.";
+		}
+		return true;
+	}
+	//-----------------------------------------------------------------------------
+	bool Texture::_canLoadFromStream(const String& type)
+	{
+		String lowerType = type;
+		StringUtil::toLowerCase(lowerType);
+		if (!Codec::isCodecRegistered(lowerType))
+			return false;
+		Codec* codec = Codec::getCodec(lowerType);
+		return codec->getDataType() == "ImageData" && static_cast<ImageCodec*>(codec)->canDecodeTo();
+	}
+	//-----------------------------------------------------------------------------
+	bool Texture::renderSystemGeneratesMipmaps(void) const
+	{
+		// Without a render system there is nothing to load into; assume it can
+		RenderSystem* rs = Root::getSingletonPtr() ? Root::getSingleton().getRenderSystem() : 0;
+		return !rs || !rs->getCapabilities() || rs->getCapabilities()->hasCapability(RSC_AUTOMIPMAP);
+	}
 	//-----------------------------------------------------------------------------
 	void Texture::createInternalResources(void)
 	{
@@ -349,6 +526,16 @@ namespace Ogre {
 	{
 		if (mInternalResourcesCreated)
 		{
+			// Uploads streaming levels in must not outlive the buffers
+			HardwareBufferManager* bufferMgr = HardwareBufferManager::getSingletonPtr();
+			if (bufferMgr && bufferMgr->getPendingUploadCount())
+			{
+				for (size_t face = 0; face < getNumFaces(); ++face)
+				{
+					for (size_t mip = 0; mip <= mNumMipmaps; ++mip)
+						bufferMgr->_cancelUploads(getBuffer(face, mip).get());
+				}
+			}
 			freeInternalResourcesImpl();
 			mInternalResourcesCreated = false;
 		}
@@ -356,7 +543,86 @@ namespace Ogre {
 	//-----------------------------------------------------------------------------
 	void Texture::unloadImpl(void)
 	{
+		if (mStreamingSourceMipmaps > 0)
+		{
+			TextureManager::getSingleton()._unregisterStreamedTexture(this);
+			mStreamingSourceMipmaps = 0;
+			mStreamingTopMip = 0;
+		}
+		freeInternalResources();
+	}
+	//-----------------------------------------------------------------------------
+	size_t Texture::getStreamingSize(size_t topMip) const
+	{
+		size_t size = 0;
+		for (size_t mip = topMip; mip <= mStreamingSourceMipmaps; ++mip)
+		{
+			size += PixelUtil::getMemorySize(std::max<size_t>(mStreamingSourceWidth >> mip, 1),
+				std::max<size_t>(mStreamingSourceHeight >> mip, 1),
+				std::max<size_t>(mStreamingSourceDepth >> mip, 1), mFormat);
+		}
+		return getNumFaces() * size;
+	}
+	//-----------------------------------------------------------------------------
+	void Texture::_notifyStreamingDemand(Real texels)
+	{
+		if (mStreamingSourceMipmaps == 0 || !isLoaded())
+			return;
+
+		// The coarsest level that still has as many texels as are shown
+		const size_t dim = std::max(mStreamingSourceWidth, mStreamingSourceHeight);
+		size_t mip = 0;
+		while (mip < mStreamingSourceMipmaps && Real(dim >> (mip + 1)) >= texels)
+			++mip;
+		TextureManager::getSingleton()._requestStreamedMip(this, mip);
+	}
+	//-----------------------------------------------------------------------------
+	void Texture::_setStreamedImage(const Image& img, size_t topMip)
+	{
+		OGRE_LOCK_AUTO_MUTEX
+
+		// The size of the resource changes along with the hardware texture
+		mCreator->_notifyResourceUnloaded(this);
 		freeInternalResources();
+
+		ConstImagePtrList imagePtrs;
+		imagePtrs.push_back(&img);
+		mNumMipmaps = mNumRequestedMipmaps = img.getNumMipmaps();
+		loadImagesImpl(imagePtrs);
+		mStreamingTopMip = topMip;
+
+		mCreator->_notifyResourceLoaded(this);
+	}
+	//-----------------------------------------------------------------------------
+	void Texture::_setStreamedLevels(Texture* levels, size_t topMip)
+	{
+		OGRE_LOCK_AUTO_MUTEX
+
+		// The hardware texture is only rebuilt if the levels don't fit it
+		const bool rebuild = !mInternalResourcesCreated || levels->getWidth() != mWidth ||
+			levels->getHeight() != mHeight || levels->getDepth() != mDepth ||
+			levels->getNumMipmaps() != mNumMipmaps;
+		if (rebuild)
+		{
+			mCreator->_notifyResourceUnloaded(this);
+			freeInternalResources();
+
+			mSrcWidth = mWidth = levels->getWidth();
+			mSrcHeight = mHeight = levels->getHeight();
+			mSrcDepth = mDepth = levels->getDepth();
+			mNumMipmaps = mNumRequestedMipmaps = levels->getNumMipmaps();
+			createInternalResources();
+		}
+
+		for (size_t face = 0; face < getNumFaces(); ++face)
+		{
+			for (size_t mip = 0; mip <= mNumMipmaps; ++mip)
+				getBuffer(face, mip)->blit(levels->getBuffer(face, mip));
+		}
+		mStreamingTopMip = topMip;
+
+		if (rebuild)
+			mCreator->_notifyResourceLoaded(this);
 	}
     //-----------------------------------------------------------------------------   
     void Texture::copyToTexture( TexturePtr& target )
@@ -31,6 +31,10 @@ THE SOFTWARE.
 #include "OgrePixelFormat.h"
 #include "OgreRoot.h"
 #include "OgreRenderSystem.h"
+#include "OgreResourceGroupManager.h"
+#include "OgreLogManager.h"
+#include "OgreHardwareBufferManager.h"
+#include "OgreImageCodec.h"
 
 namespace Ogre {
     //-----------------------------------------------------------------------
@@ -48,6 +52,11 @@ namespace Ogre {
          : mPreferredIntegerBitDepth(0)
          , mPreferredFloatBitDepth(0)
          , mDefaultNumMipmaps(MIP_UNLIMITED)
+         , mDefaultStreaming(false)
+         , mStreamingBudget(std::numeric_limits<size_t>::max())
+         , mStreamingInitialSize(64)
+         , mStreamingChannel(0)
+         , mStreamingChannelRegistered(false)
     {
         mResourceType = "Texture";
         mLoadOrder = 75.0f;
@@ -59,6 +68,19 @@ namespace Ogre {
     {
         // subclasses should unregister with resource group manager
 
+		if (mStreamingChannelRegistered && Root::getSingletonPtr() && Root::getSingleton().getWorkQueue())
+		{
+			WorkQueue* wq = Root::getSingleton().getWorkQueue();
+			wq->abortRequestsByChannel(mStreamingChannel);
+			wq->removeRequestHandler(mStreamingChannel, this);
+			wq->removeResponseHandler(mStreamingChannel, this);
+		}
+		// No responses come back any more to hand back the staging memory
+		if (HardwareBufferManager::getSingletonPtr())
+		{
+			for (StreamingStagingMap::iterator i = mStreamingStaging.begin(); i != mStreamingStaging.end(); ++i)
+				HardwareBufferManager::getSingleton().releaseUploadStaging(i->second);
+		}
     }
     //-----------------------------------------------------------------------
     TextureManager::ResourceCreateOrRetrieveResult TextureManager::createOrRetrieve(
@@ -279,4 +301,463 @@ namespace Ogre {
 		return PixelUtil::getNumElemBits(supportedFormat) >= PixelUtil::getNumElemBits(format);
 		
 	}
+    //-----------------------------------------------------------------------
+	void TextureManager::setStreamingBudget(size_t bytes)
+	{
+		mStreamingBudget = bytes;
+		enforceStreamingBudget();
+	}
+    //-----------------------------------------------------------------------
+	TextureManager::StreamingStatistics TextureManager::getStreamingStatistics(void) const
+	{
+		StreamingStatistics stats;
+		stats.streamedTextures = mStreamedTextures.size();
+		stats.residentBytes = 0;
+		stats.requestedBytes = 0;
+		stats.pendingRequests = 0;
+		for (StreamedTextureMap::const_iterator i = mStreamedTextures.begin(); i != mStreamedTextures.end(); ++i)
+		{
+			const StreamedTexture& st = i->second;
+			stats.residentBytes += st.texture->getStreamingSize(st.texture->getStreamingTopMip());
+			stats.requestedBytes += st.texture->getStreamingSize(st.wantedMip);
+			if (st.ticket || !st.uploadLevels.isNull())
+				++stats.pendingRequests;
+		}
+		return stats;
+	}
+    //-----------------------------------------------------------------------
+	void TextureManager::_registerStreamedTexture(Texture* tex, const Image& initialLevels)
+	{
+		if (!mStreamingChannelRegistered)
+		{
+			WorkQueue* wq = Root::getSingleton().getWorkQueue();
+			mStreamingChannel = wq->getChannel("Ogre/TextureStreaming");
+			wq->addRequestHandler(mStreamingChannel, this);
+			wq->addResponseHandler(mStreamingChannel, this);
+			mStreamingChannelRegistered = true;
+		}
+
+		StreamedTexture st;
+		st.texture = tex;
+		st.initialLevels = initialLevels;
+		st.initialMip = tex->getStreamingTopMip();
+		st.lastUsedFrame = 0;
+		st.wantedMip = st.initialMip;
+		st.ticket = 0;
+		st.pendingMip = 0;
+		st.uploadTicket = 0;
+		st.failed = false;
+		mStreamedTextures[tex->getHandle()] = st;
+	}
+    //-----------------------------------------------------------------------
+	void TextureManager::_unregisterStreamedTexture(Texture* tex)
+	{
+		StreamedTextureMap::iterator i = mStreamedTextures.find(tex->getHandle());
+		if (i == mStreamedTextures.end())
+			return;
+		abortStreamedLoad(i->second);
+		dropStreamedUpload(i->second);
+		mStreamedTextures.erase(i);
+	}
+    //-----------------------------------------------------------------------
+	void TextureManager::_requestStreamedMip(Texture* tex, size_t mip)
+	{
+		StreamedTextureMap::iterator i = mStreamedTextures.find(tex->getHandle());
+		if (i == mStreamedTextures.end())
+			return;
+		StreamedTexture& st = i->second;
+
+		// The finest level asked for during a frame is the one needed
+		Root* root = Root::getSingletonPtr();
+		unsigned long frame = root ? root->getNextFrameNumber() : 0;
+		if (st.lastUsedFrame != frame)
+		{
+			st.lastUsedFrame = frame;
+			st.wantedMip = mip;
+		}
+		else
+		{
+			st.wantedMip = std::min(st.wantedMip, mip);
+		}
+
+		size_t topMip = tex->getStreamingTopMip();
+		if (st.ticket || !st.uploadLevels.isNull() || st.failed || st.wantedMip >= topMip)
+			return;
+
+		// Settle for a coarser level if the wanted one doesn't fit
+		size_t target = st.wantedMip;
+		size_t residentSize = tex->getStreamingSize(topMip);
+		size_t committed = getStreamingCommittedMemory() - residentSize;
+		if (committed + tex->getStreamingSize(target) > mStreamingBudget)
+		{
+			// Make room by evicting textures out of use first
+			enforceStreamingBudget(tex->getStreamingSize(target) - residentSize);
+			committed = getStreamingCommittedMemory() - residentSize;
+			while (target < topMip && committed + tex->getStreamingSize(target) > mStreamingBudget)
+				++target;
+			if (target == topMip)
+				return;
+		}
+
+		StreamingRequest req;
+		req.handle = tex->getHandle();
+		req.name = tex->getName();
+		req.group = tex->getGroup();
+		String baseName;
+		StringUtil::splitBaseFilename(req.name, baseName, req.type);
+		req.topMip = target;
+		req.residentMip = topMip;
+		req.gamma = tex->getGamma();
+		st.pendingMip = target;
+#if OGRE_THREAD_SUPPORT
+		st.ticket = Root::getSingleton().getWorkQueue()->addRequest(mStreamingChannel, 0, Any(req));
+#else
+		// synchronous, the response has to match the ticket before the call returns
+		st.ticket = std::numeric_limits<WorkQueue::RequestID>::max();
+		WorkQueue::Response* response = handleRequest(
+			OGRE_NEW WorkQueue::Request(mStreamingChannel, 0, Any(req), 0, st.ticket), 0);
+		handleResponse(response, 0);
+		OGRE_DELETE response;
+#endif
+	}
+    //-----------------------------------------------------------------------
+	class TextureManager::StreamingDecodeTarget : public ImageCodec::DecodeTarget
+	{
+	public:
+		StreamingDecodeTarget(size_t topMip, size_t endMip)
+			: mTopMip(topMip), mEndMip(endMip), mData(0), mStaging(false) {}
+		~StreamingDecodeTarget()
+		{
+			if (mStaging)
+				HardwareBufferManager::getSingleton().releaseUploadStaging(mData);
+			else if (mData)
+				OGRE_FREE(mData, MEMCATEGORY_GENERAL);
+		}
+
+		bool begin(const ImageCodec::ImageData& data, size_t numFaces)
+		{
+			if (mTopMip >= mEndMip || mEndMip > size_t(data.num_mipmaps) + 1)
+			{
+				OGRE_EXCEPT(Exception::ERR_INVALID_STATE, "File has fewer mipmaps than when it was loaded",
+					"TextureManager::handleRequest");
+			}
+			mWidth = std::max<size_t>(data.width >> mTopMip, 1);
+			mHeight = std::max<size_t>(data.height >> mTopMip, 1);
+			mDepth = std::max<size_t>(data.depth >> mTopMip, 1);
+			mFormat = data.format;
+			mFaces = numFaces;
+			mFaceSize = Image::calculateSize(mEndMip - mTopMip - 1, 1, mWidth, mHeight, mDepth, mFormat);
+
+			// Upload staging memory if there is room, so the render thread only has to hand
+			// the levels to the buffers
+			mData = static_cast<uchar*>(
+				HardwareBufferManager::getSingleton().reserveUploadStaging(mFaceSize * mFaces));
+			mStaging = mData != 0;
+			if (!mStaging)
+				mData = OGRE_ALLOC_T(uchar, mFaceSize * mFaces, MEMCATEGORY_GENERAL);
+			return true;
+		}
+
+		bool skip(size_t face, size_t mipmap)
+		{
+			return mipmap < mTopMip || mipmap >= mEndMip;
+		}
+
+		PixelBox lock(size_t face, size_t mipmap)
+		{
+			uchar* level = mData + face * mFaceSize;
+			size_t width = mWidth, height = mHeight, depth = mDepth;
+			for (size_t mip = mTopMip; mip < mipmap; ++mip)
+			{
+				level += PixelUtil::getMemorySize(width, height, depth, mFormat);
+				width = std::max<size_t>(width / 2, 1);
+				height = std::max<size_t>(height / 2, 1);
+				depth = std::max<size_t>(depth / 2, 1);
+			}
+			return PixelBox(width, height, depth, mFormat, level);
+		}
+
+		void unlock(size_t face, size_t mipmap) {}
+
+		/** Hands the levels over to an image.
+		@return The staging memory holding them, 0 if the image owns them
+		*/
+		void* release(Image& img)
+		{
+			img.loadDynamicImage(mData, mWidth, mHeight, mDepth, mFormat, !mStaging, mFaces, mEndMip - mTopMip - 1);
+			void* staging = mStaging ? mData : 0;
+			mData = 0;
+			mStaging = false;
+			return staging;
+		}
+
+	private:
+		size_t mTopMip;
+		size_t mEndMip;
+		uchar* mData;
+		bool mStaging;
+		size_t mWidth, mHeight, mDepth;
+		PixelFormat mFormat;
+		size_t mFaces;
+		size_t mFaceSize;
+	};
+    //-----------------------------------------------------------------------
+	WorkQueue::Response* TextureManager::handleRequest(const WorkQueue::Request* req, const WorkQueue* srcQ)
+	{
+		StreamingRequest streamReq = any_cast<StreamingRequest>(req->getData());
+		StreamingResponse streamRes;
+		if (req->getAborted())
+			return OGRE_NEW WorkQueue::Response(req, false, Any(streamRes));
+
+		try
+		{
+			// Only the levels above the resident ones are read, the file is seeked past
+			// all others where the codec allows it
+			DataStreamPtr stream = ResourceGroupManager::getSingleton().openResource(
+				streamReq.name, streamReq.group, true);
+			StreamingDecodeTarget target(streamReq.topMip, streamReq.residentMip);
+			String type = streamReq.type;
+			StringUtil::toLowerCase(type);
+			if (!Texture::_canLoadFromStream(type) ||
+				!static_cast<ImageCodec*>(Codec::getCodec(type))->decodeTo(stream, target))
+			{
+				// Decode the whole file and keep the levels asked for
+				Image source;
+				source.load(stream, streamReq.type);
+				ImageCodec::ImageData data;
+				data.width = source.getWidth();
+				data.height = source.getHeight();
+				data.depth = source.getDepth();
+				data.num_mipmaps = static_cast<ushort>(source.getNumMipmaps());
+				data.format = source.getFormat();
+				target.begin(data, source.getNumFaces());
+				for (size_t face = 0; face < source.getNumFaces(); ++face)
+				{
+					for (size_t mip = streamReq.topMip; mip < streamReq.residentMip; ++mip)
+						PixelUtil::bulkPixelConversion(source.getPixelBox(face, mip), target.lock(face, mip));
+				}
+			}
+
+			streamRes.image.bind(OGRE_NEW Image());
+			streamRes.staging = target.release(*streamRes.image);
+			if (streamReq.gamma != 1.0f)
+			{
+				Image::applyGamma(streamRes.image->getData(), streamReq.gamma, streamRes.image->getSize(),
+					static_cast<uchar>(PixelUtil::getNumElemBits(streamRes.image->getFormat())));
+			}
+			if (streamRes.staging)
+			{
+				OGRE_LOCK_MUTEX(mStreamingStagingMutex)
+				mStreamingStaging[req->getID()] = streamRes.staging;
+			}
+		}
+		catch (Exception& e)
+		{
+			releaseStreamingStaging(req->getID());
+			streamRes.staging = 0;
+			return OGRE_NEW WorkQueue::Response(req, false, Any(streamRes), e.getFullDescription());
+		}
+		return OGRE_NEW WorkQueue::Response(req, true, Any(streamRes));
+	}
+    //-----------------------------------------------------------------------
+	bool TextureManager::canHandleResponse(const WorkQueue::Response* res, const WorkQueue* srcQ)
+	{
+		if (res->getRequest()->getAborted())
+		{
+			// Unloaded or evicted since the request was made
+			releaseStreamingStaging(res->getRequest()->getID());
+			return false;
+		}
+		return true;
+	}
+    //-----------------------------------------------------------------------
+	void TextureManager::handleResponse(const WorkQueue::Response* res, const WorkQueue* srcQ)
+	{
+		StreamingRequest streamReq = any_cast<StreamingRequest>(res->getRequest()->getData());
+		StreamingResponse streamRes = any_cast<StreamingResponse>(res->getData());
+		StreamedTextureMap::iterator i = mStreamedTextures.find(streamReq.handle);
+		// Unloaded since the request was made
+		if (i == mStreamedTextures.end() || i->second.ticket != res->getRequest()->getID())
+		{
+			releaseStreamingStaging(res->getRequest()->getID());
+			return;
+		}
+
+		StreamedTexture& st = i->second;
+		st.ticket = 0;
+		// The loaded levels only complete the resident ones they were asked for on top of
+		if (st.texture->getStreamingTopMip() != streamReq.residentMip)
+		{
+			releaseStreamingStaging(res->getRequest()->getID());
+			return;
+		}
+		if (!res->succeeded())
+		{
+			st.failed = true;
+			LogManager::getSingleton().stream()
+				<< "Error while streaming texture " << streamReq.name
+				<< " - it keeps its current mipmaps. " << res->getMessages();
+			return;
+		}
+
+		// Build the new levels in a texture of their own: the loaded ones on top, then the
+		// resident ones copied over by the GPU. With staging memory the uploads are queued
+		// and the resident levels stay in use until they are done, see _updateStreamedUploads
+		HardwareBufferManager& bufferMgr = HardwareBufferManager::getSingleton();
+		Texture* tex = st.texture;
+		try
+		{
+			const Image& img = *streamRes.image;
+			Texture* levels = static_cast<Texture*>(createImpl(tex->getName() + "/StreamingUpload",
+				getNextHandle(), tex->getGroup(), true, 0, 0));
+			st.uploadLevels = TexturePtr(levels);
+			levels->setTextureType(tex->getTextureType());
+			levels->setWidth(img.getWidth());
+			levels->setHeight(img.getHeight());
+			levels->setDepth(img.getDepth());
+			levels->setNumMipmaps(tex->getStreamingSourceMipmaps() - streamReq.topMip);
+			levels->setFormat(tex->getFormat());
+			levels->setUsage(tex->getUsage() & ~TU_AUTOMIPMAP);
+			levels->setHardwareGammaEnabled(tex->isHardwareGammaEnabled());
+			levels->createInternalResources();
+
+			const size_t loaded = img.getNumMipmaps() + 1;
+			for (size_t face = 0; face < img.getNumFaces(); ++face)
+			{
+				for (size_t mip = 0; mip < loaded; ++mip)
+				{
+					HardwarePixelBufferSharedPtr buf = levels->getBuffer(face, mip);
+					PixelBox src = img.getPixelBox(face, mip);
+					// Treated the way the texture treated its file, see Texture::loadImagesImpl
+					src.format = tex->getSrcFormat();
+					if (streamRes.staging)
+					{
+						st.uploadTicket = bufferMgr.queueUpload(buf, src,
+							Image::Box(0, 0, 0, buf->getWidth(), buf->getHeight(), buf->getDepth()));
+					}
+					else
+					{
+						buf->blitFromMemory(src);
+					}
+				}
+				for (size_t mip = loaded; mip <= levels->getNumMipmaps() && mip - loaded <= tex->getNumMipmaps(); ++mip)
+					levels->getBuffer(face, mip)->blit(tex->getBuffer(face, mip - loaded));
+			}
+		}
+		catch (Exception& e)
+		{
+			dropStreamedUpload(st);
+			st.failed = true;
+			LogManager::getSingleton().stream()
+				<< "Error while uploading streamed texture " << streamReq.name
+				<< " - it keeps its current mipmaps. " << e.getFullDescription();
+		}
+		// Released now, it is only reused once the uploads queued before this have been made
+		releaseStreamingStaging(res->getRequest()->getID());
+
+		if (!streamRes.staging && !st.uploadLevels.isNull())
+		{
+			tex->_setStreamedLevels(st.uploadLevels.get(), streamReq.topMip);
+			dropStreamedUpload(st);
+		}
+		// Loaded memory has grown
+		enforceStreamingBudget();
+	}
+    //-----------------------------------------------------------------------
+	void TextureManager::_updateStreamedUploads(void)
+	{
+		HardwareBufferManager* bufferMgr = HardwareBufferManager::getSingletonPtr();
+		for (StreamedTextureMap::iterator i = mStreamedTextures.begin(); i != mStreamedTextures.end(); ++i)
+		{
+			StreamedTexture& st = i->second;
+			if (st.uploadLevels.isNull() || !bufferMgr->isUploadComplete(st.uploadTicket))
+				continue;
+
+			st.texture->_setStreamedLevels(st.uploadLevels.get(), st.pendingMip);
+			dropStreamedUpload(st);
+		}
+	}
+    //-----------------------------------------------------------------------
+	void TextureManager::releaseStreamingStaging(WorkQueue::RequestID id)
+	{
+		void* staging = 0;
+		{
+			OGRE_LOCK_MUTEX(mStreamingStagingMutex)
+			StreamingStagingMap::iterator i = mStreamingStaging.find(id);
+			if (i == mStreamingStaging.end())
+				return;
+			staging = i->second;
+			mStreamingStaging.erase(i);
+		}
+		HardwareBufferManager::getSingleton().releaseUploadStaging(staging);
+	}
+    //-----------------------------------------------------------------------
+	void TextureManager::abortStreamedLoad(StreamedTexture& st)
+	{
+		// Its response is dropped and the staging memory handed back, see canHandleResponse
+		if (st.ticket)
+			Root::getSingleton().getWorkQueue()->abortRequest(st.ticket);
+		st.ticket = 0;
+	}
+    //-----------------------------------------------------------------------
+	void TextureManager::dropStreamedUpload(StreamedTexture& st)
+	{
+		// Freeing its buffers cancels the uploads still queued into them
+		st.uploadLevels.setNull();
+		st.uploadTicket = 0;
+	}
+    //-----------------------------------------------------------------------
+	size_t TextureManager::getStreamingCommittedMemory(void) const
+	{
+		size_t usage = 0;
+		for (StreamedTextureMap::const_iterator i = mStreamedTextures.begin(); i != mStreamedTextures.end(); ++i)
+		{
+			const StreamedTexture& st = i->second;
+			size_t topMip = st.texture->getStreamingTopMip();
+			if (st.ticket || !st.uploadLevels.isNull())
+				topMip = std::min(topMip, st.pendingMip);
+			usage += st.texture->getStreamingSize(topMip);
+		}
+		return usage;
+	}
+    //-----------------------------------------------------------------------
+	void TextureManager::enforceStreamingBudget(size_t reserve)
+	{
+		size_t usage = getStreamingCommittedMemory() + reserve;
+		if (usage <= mStreamingBudget)
+			return;
+
+		// Never evict what was needed in this or the previous frame, it's on screen
+		Root* root = Root::getSingletonPtr();
+		unsigned long frame = root ? root->getNextFrameNumber() : 0;
+		typedef std::pair<unsigned long, StreamedTexture*> Candidate;
+		vector<Candidate>::type candidates;
+		for (StreamedTextureMap::iterator i = mStreamedTextures.begin(); i != mStreamedTextures.end(); ++i)
+		{
+			StreamedTexture& st = i->second;
+			size_t topMip = st.texture->getStreamingTopMip();
+			if (st.ticket || !st.uploadLevels.isNull())
+				topMip = std::min(topMip, st.pendingMip);
+			if (topMip < st.initialMip && st.lastUsedFrame + 1 < frame)
+				candidates.push_back(Candidate(st.lastUsedFrame, &st));
+		}
+		std::sort(candidates.begin(), candidates.end());
+
+		for (vector<Candidate>::type::iterator c = candidates.begin();
+			c != candidates.end() && usage > mStreamingBudget; ++c)
+		{
+			StreamedTexture& st = *c->second;
+			size_t topMip = st.texture->getStreamingTopMip();
+			if (st.ticket || !st.uploadLevels.isNull())
+				topMip = std::min(topMip, st.pendingMip);
+			size_t freed = st.texture->getStreamingSize(topMip) - st.texture->getStreamingSize(st.initialMip);
+
+			abortStreamedLoad(st);
+			dropStreamedUpload(st);
+			if (st.texture->getStreamingTopMip() < st.initialMip)
+				st.texture->_setStreamedImage(st.initialLevels, st.initialMip);
+			st.wantedMip = st.initialMip;
+			usage -= std::min(usage, freed);
+		}
+	}
 }
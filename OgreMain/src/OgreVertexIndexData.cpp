@@ -35,6 +35,7 @@ THE SOFTWARE.
 #include "OgreRoot.h"
 #include "OgreRenderSystem.h" 
 #include "OgreException.h"
+#include "OgreBitwise.h"
 
 namespace Ogre {
 
@@ -48,6 +49,8 @@ namespace Ogre {
 		vertexCount = 0;
 		vertexStart = 0;
 		hwAnimDataItemsUsed = 0;
+		positionScale = Vector3::UNIT_SCALE;
+		positionBias = Vector3::ZERO;
 
 	}
 	//---------------------------------------------------------------------
@@ -61,6 +64,8 @@ namespace Ogre {
 		vertexCount = 0;
 		vertexStart = 0;
 		hwAnimDataItemsUsed = 0;
+		positionScale = Vector3::UNIT_SCALE;
+		positionBias = Vector3::ZERO;
 	}
     //-----------------------------------------------------------------------
 	VertexData::~VertexData()
@@ -132,6 +137,9 @@ namespace Ogre {
 		dest->hwAnimationDataList = hwAnimationDataList;
 		dest->hwAnimDataItemsUsed = hwAnimDataItemsUsed;
 
+		dest->positionScale = positionScale;
+		dest->positionBias = positionBias;
+
         
         return dest;
 	}
@@ -667,6 +675,240 @@ namespace Ogre {
 		} // each buffer
 
 
+	}
+	//-----------------------------------------------------------------------
+	// Local utilities for VertexData::quantise
+	namespace
+	{
+		VertexElementType getQuantisedType(const VertexElement& elem, bool positions,
+			bool normals, bool textureCoordinates)
+		{
+			const VertexElementType type = elem.getType();
+			switch (elem.getSemantic())
+			{
+			case VES_POSITION:
+				if (positions && type == VET_FLOAT3)
+					return VET_SHORT4_SNORM;
+				break;
+			case VES_NORMAL:
+			case VES_BINORMAL:
+			case VES_TANGENT:
+				if (normals && (type == VET_FLOAT3 || type == VET_FLOAT4))
+					return VET_SHORT4_SNORM;
+				break;
+			case VES_TEXTURE_COORDINATES:
+				if (textureCoordinates && type == VET_FLOAT2)
+					return VET_HALF2;
+				if (textureCoordinates && (type == VET_FLOAT3 || type == VET_FLOAT4))
+					return VET_HALF4;
+				break;
+			default:
+				break;
+			}
+			return type;
+		}
+
+		int16 floatToSnorm16(float value)
+		{
+			value = std::max(-1.0f, std::min(value, 1.0f)) * 32767.0f;
+			return static_cast<int16>(value >= 0.0f ? value + 0.5f : value - 0.5f);
+		}
+
+		void quantiseElement(const uchar* src, VertexElementType srcType, uchar* dst,
+			VertexElementType dstType, VertexElementSemantic semantic,
+			const Vector3& scale, const Vector3& bias)
+		{
+			if (srcType == dstType)
+			{
+				memcpy(dst, src, VertexElement::getTypeSize(srcType));
+				return;
+			}
+
+			float value[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+			memcpy(value, src, VertexElement::getTypeSize(srcType));
+			if (semantic == VES_POSITION)
+			{
+				for (size_t i = 0; i < 3; ++i)
+					value[i] = (value[i] - bias[i]) / scale[i];
+				value[3] = 1.0f;
+			}
+			else if (semantic == VES_TANGENT && srcType == VET_FLOAT3)
+			{
+				// Shaders reading the parity from w get the implied right handed one
+				value[3] = 1.0f;
+			}
+
+			if (dstType == VET_SHORT4_SNORM)
+			{
+				int16* pShort = reinterpret_cast<int16*>(dst);
+				for (size_t i = 0; i < 4; ++i)
+					pShort[i] = floatToSnorm16(value[i]);
+			}
+			else
+			{
+				uint16* pHalf = reinterpret_cast<uint16*>(dst);
+				for (unsigned short i = 0; i < VertexElement::getTypeCount(dstType); ++i)
+					pHalf[i] = Bitwise::floatToHalf(value[i]);
+			}
+		}
+	}
+	//-----------------------------------------------------------------------
+	Vector3 VertexData::readPosition(const VertexElement* posElem, const void* pBaseVertex) const
+	{
+		const uchar* pElem = static_cast<const uchar*>(pBaseVertex) + posElem->getOffset();
+		Vector3 position;
+		switch (posElem->getType())
+		{
+		case VET_FLOAT3:
+			{
+				float value[3];
+				memcpy(value, pElem, sizeof(value));
+				return Vector3(value[0], value[1], value[2]);
+			}
+		case VET_SHORT4_SNORM:
+			{
+				int16 value[4];
+				memcpy(value, pElem, sizeof(value));
+				for (size_t i = 0; i < 3; ++i)
+					position[i] = std::max(Real(-1), value[i] / Real(32767));
+				break;
+			}
+		case VET_HALF4:
+			{
+				uint16 value[4];
+				memcpy(value, pElem, sizeof(value));
+				for (size_t i = 0; i < 3; ++i)
+					position[i] = Bitwise::halfToFloat(value[i]);
+				break;
+			}
+		default:
+			OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+				"Positions must be VET_FLOAT3, VET_SHORT4_SNORM or VET_HALF4.",
+				"VertexData::readPosition");
+		}
+		return position * positionScale + positionBias;
+	}
+	//-----------------------------------------------------------------------
+	bool VertexData::quantise(bool positions, bool normals, bool textureCoordinates)
+	{
+		// Copy, the declaration is modified as we go
+		const VertexDeclaration::VertexElementList elems = vertexDeclaration->getElements();
+		vector<VertexElementType>::type newTypes;
+		newTypes.reserve(elems.size());
+		bool anyConverted = false;
+		VertexDeclaration::VertexElementList::const_iterator ei, eiend;
+		eiend = elems.end();
+		for (ei = elems.begin(); ei != eiend; ++ei)
+		{
+			newTypes.push_back(getQuantisedType(*ei, positions, normals, textureCoordinates));
+			anyConverted = anyConverted || newTypes.back() != ei->getType();
+		}
+		if (!anyConverted)
+			return false;
+
+		// Positions are stored relative to the bounds of the whole buffer
+		Vector3 newScale = positionScale;
+		Vector3 newBias = positionBias;
+		const VertexElement* posElem = vertexDeclaration->findElementBySemantic(VES_POSITION);
+		if (positions && posElem && posElem->getType() == VET_FLOAT3)
+		{
+			HardwareVertexBufferSharedPtr vbuf = vertexBufferBinding->getBuffer(posElem->getSource());
+			uchar* pBase = static_cast<uchar*>(vbuf->lock(HardwareBuffer::HBL_READ_ONLY));
+			AxisAlignedBox bounds;
+			for (size_t v = 0; v < vbuf->getNumVertices(); ++v, pBase += vbuf->getVertexSize())
+			{
+				float* pFloat;
+				posElem->baseVertexPointerToElement(pBase, &pFloat);
+				bounds.merge(Vector3(pFloat[0], pFloat[1], pFloat[2]));
+			}
+			vbuf->unlock();
+
+			newScale = Vector3::UNIT_SCALE;
+			newBias = Vector3::ZERO;
+			if (bounds.isFinite())
+			{
+				newBias = bounds.getCenter();
+				newScale = bounds.getHalfSize();
+				// Keep flat meshes invertible
+				for (size_t i = 0; i < 3; ++i)
+				{
+					if (newScale[i] <= 0)
+						newScale[i] = 1;
+				}
+			}
+		}
+
+		// Rebuild each buffer holding a converted element, packing its elements in their old order
+		vector<size_t>::type newOffsets(elems.size());
+		const unsigned short maxSource = vertexDeclaration->getMaxSource();
+		for (unsigned short source = 0; source <= maxSource; ++source)
+		{
+			if (!vertexBufferBinding->isBufferBound(source))
+				continue;
+
+			typedef std::pair<size_t, size_t> OffsetElementPair;
+			vector<OffsetElementPair>::type sourceElems;
+			bool sourceConverted = false;
+			size_t elemIndex = 0;
+			for (ei = elems.begin(); ei != eiend; ++ei, ++elemIndex)
+			{
+				if (ei->getSource() != source)
+					continue;
+				sourceElems.push_back(OffsetElementPair(ei->getOffset(), elemIndex));
+				newOffsets[elemIndex] = ei->getOffset();
+				sourceConverted = sourceConverted || newTypes[elemIndex] != ei->getType();
+			}
+			if (!sourceConverted)
+				continue;
+			std::sort(sourceElems.begin(), sourceElems.end());
+
+			vector<const VertexElement*>::type oldElems(elems.size());
+			size_t newVertexSize = 0;
+			for (size_t i = 0; i < sourceElems.size(); ++i)
+			{
+				ei = elems.begin();
+				std::advance(ei, sourceElems[i].second);
+				oldElems[sourceElems[i].second] = &(*ei);
+				newOffsets[sourceElems[i].second] = newVertexSize;
+				newVertexSize += VertexElement::getTypeSize(newTypes[sourceElems[i].second]);
+			}
+
+			HardwareVertexBufferSharedPtr srcBuf = vertexBufferBinding->getBuffer(source);
+			HardwareVertexBufferSharedPtr dstBuf = mMgr->createVertexBuffer(
+				newVertexSize, srcBuf->getNumVertices(), srcBuf->getUsage(),
+				srcBuf->hasShadowBuffer());
+
+			const uchar* pSrc = static_cast<const uchar*>(srcBuf->lock(HardwareBuffer::HBL_READ_ONLY));
+			uchar* pDst = static_cast<uchar*>(dstBuf->lock(HardwareBuffer::HBL_DISCARD));
+			for (size_t v = 0; v < srcBuf->getNumVertices(); ++v)
+			{
+				for (size_t i = 0; i < sourceElems.size(); ++i)
+				{
+					const size_t index = sourceElems[i].second;
+					const VertexElement* oldElem = oldElems[index];
+					quantiseElement(pSrc + oldElem->getOffset(), oldElem->getType(),
+						pDst + newOffsets[index], newTypes[index], oldElem->getSemantic(),
+						newScale, newBias);
+				}
+				pSrc += srcBuf->getVertexSize();
+				pDst += newVertexSize;
+			}
+			dstBuf->unlock();
+			srcBuf->unlock();
+
+			vertexBufferBinding->setBinding(source, dstBuf);
+		}
+
+		unsigned short elemIndex = 0;
+		for (ei = elems.begin(); ei != eiend; ++ei, ++elemIndex)
+		{
+			vertexDeclaration->modifyElement(elemIndex, ei->getSource(), newOffsets[elemIndex],
+				newTypes[elemIndex], ei->getSemantic(), ei->getIndex());
+		}
+
+		positionScale = newScale;
+		positionBias = newBias;
+		return true;
 	}
 	//-----------------------------------------------------------------------
 	ushort VertexData::allocateHardwareAnimationElements(ushort count, bool animateNormals)
@@ -732,206 +974,247 @@ namespace Ogre {
 		return dest;
 	}
     //-----------------------------------------------------------------------
-    //-----------------------------------------------------------------------
-	// Local Utility class for vertex cache optimizer
-	class Triangle
-    {
-    public:
-		enum EdgeMatchType {
-			AB, BC, CA, ANY, NONE
-		};
-
-		uint32 a, b, c;		
-
-		inline Triangle()
-		{
-		}
-
-		inline Triangle( uint32 ta, uint32 tb, uint32 tc ) 
-			: a( ta ), b( tb ), c( tc )
-		{
-		}
-
-		inline Triangle( uint32 t[3] )
-			: a( t[0] ), b( t[1] ), c( t[2] )
-		{
-		}
-
-		inline Triangle( const Triangle& t )
-			: a( t.a ), b( t.b ), c( t.c )
-		{
-		}
-
-		inline bool sharesEdge(const Triangle& t) const
-		{
-			return(	(a == t.a && b == t.c) ||
-					(a == t.b && b == t.a) ||
-					(a == t.c && b == t.b) ||
-					(b == t.a && c == t.c) ||
-					(b == t.b && c == t.a) ||
-					(b == t.c && c == t.b) ||
-					(c == t.a && a == t.c) ||
-					(c == t.b && a == t.a) ||
-					(c == t.c && a == t.b) );
-		}
-
-		inline bool sharesEdge(const uint32 ea, const uint32 eb, const Triangle& t) const
-		{
-			return(	(ea == t.a && eb == t.c) ||
-					(ea == t.b && eb == t.a) ||
-					(ea == t.c && eb == t.b) );	
-		}
-
-		inline bool sharesEdge(const EdgeMatchType edge, const Triangle& t) const
-		{
-			if (edge == AB)
-				return sharesEdge(a, b, t);
-			else if (edge == BC)
-				return sharesEdge(b, c, t);
-			else if (edge == CA)
-				return sharesEdge(c, a, t);
-			else
-				return (edge == ANY) == sharesEdge(t);
-		}
-
-		inline EdgeMatchType endoSharedEdge(const Triangle& t) const
-		{
-			if (sharesEdge(a, b, t)) return AB;
-			if (sharesEdge(b, c, t)) return BC;
-			if (sharesEdge(c, a, t)) return CA;
-			return NONE;
-		}
-
-		inline EdgeMatchType exoSharedEdge(const Triangle& t) const
-		{
-			return t.endoSharedEdge(*this);
-		}
+	// Local utilities for the vertex cache optimiser, see
+	// http://home.comcast.net/~tom_forsyth/papers/fast_vert_cache_opt.html
+	namespace
+	{
+		/// Size of the simulated LRU cache, larger than real caches on purpose
+		const int FORSYTH_CACHE_SIZE = 32;
 
-		inline void shiftClockwise()
+		float forsythVertexScore(int cachePosition, uint32 remainingTriangles)
 		{
-			uint32 t = a;
-			a = c;
-			c = b;
-			b = t;
-		}
+			// No triangle needs this vertex anymore
+			if (remainingTriangles == 0)
+				return -1.0f;
 
-		inline void shiftCounterClockwise()
-		{
-			uint32 t = a;
-			a = b;
-			b = c;
-			c = t;
+			float score = 0.0f;
+			if (cachePosition >= 0)
+			{
+				if (cachePosition < 3)
+				{
+					// Used by the last triangle, deliberately lower to avoid strip-like
+					// orders which bounce back and forth
+					score = 0.75f;
+				}
+				else
+				{
+					const float scaler = 1.0f / (FORSYTH_CACHE_SIZE - 3);
+					score = powf(1.0f - (cachePosition - 3) * scaler, 1.5f);
+				}
+			}
+			// Favour vertices with few triangles left, to get rid of lone triangles early
+			score += 2.0f * powf((float)remainingTriangles, -0.5f);
+			return score;
 		}
-	};
-    //-----------------------------------------------------------------------
+	}
     //-----------------------------------------------------------------------
 	void IndexData::optimiseVertexCacheTriList(void)
 	{
 		if (indexBuffer->isLocked()) return;
 
-		void *buffer = indexBuffer->lock(HardwareBuffer::HBL_NORMAL);
+		const size_t nTriangles = indexCount / 3;
+		if (nTriangles < 2) return;
+		const size_t nIndexes = nTriangles * 3;
+		const bool use32bit = indexBuffer->getType() == HardwareIndexBuffer::IT_32BIT;
 
-		Triangle* triangles;
-		uint32 *dest;
+		void *buffer = indexBuffer->lock(indexStart * indexBuffer->getIndexSize(),
+			nIndexes * indexBuffer->getIndexSize(), HardwareBuffer::HBL_NORMAL);
 
-		size_t nIndexes = indexCount;
-		size_t nTriangles = nIndexes / 3;
-		size_t i, j;
-		uint16 *source = 0;
-
-		if (indexBuffer->getType() == HardwareIndexBuffer::IT_16BIT)
+		vector<uint32>::type indexes(nIndexes);
+		uint32 nVertices = 0;
+		for (size_t i = 0; i < nIndexes; ++i)
 		{
-			triangles = OGRE_ALLOC_T(Triangle, nTriangles, MEMCATEGORY_GEOMETRY);
-			source = (uint16 *)buffer;
-			dest = (uint32 *)triangles;
-			for (i = 0; i < nIndexes; ++i) dest[i] = source[i];
+			indexes[i] = use32bit ? static_cast<uint32*>(buffer)[i] : static_cast<uint16*>(buffer)[i];
+			nVertices = std::max(nVertices, indexes[i] + 1);
 		}
-		else
-			triangles = (Triangle*)buffer;
 
-		// sort triangles based on shared edges
-		uint32 *destlist = OGRE_ALLOC_T(uint32, nTriangles, MEMCATEGORY_GEOMETRY);
-		unsigned char *visited = OGRE_ALLOC_T(unsigned char, nTriangles, MEMCATEGORY_GEOMETRY);
-
-		for (i = 0; i < nTriangles; ++i) visited[i] = 0;
+		// Triangles per vertex, as ranges into one adjacency list
+		vector<uint32>::type remaining(nVertices, 0);
+		for (size_t i = 0; i < nIndexes; ++i)
+			++remaining[indexes[i]];
+		vector<uint32>::type adjacencyStart(nVertices + 1, 0);
+		for (uint32 v = 0; v < nVertices; ++v)
+			adjacencyStart[v + 1] = adjacencyStart[v] + remaining[v];
+		vector<uint32>::type adjacency(nIndexes);
+		{
+			vector<uint32>::type fill(adjacencyStart.begin(), adjacencyStart.end() - 1);
+			for (size_t i = 0; i < nIndexes; ++i)
+				adjacency[fill[indexes[i]]++] = static_cast<uint32>(i / 3);
+		}
 
-		uint32 start = 0, ti = 0, destcount = 0;
+		vector<int>::type cachePosition(nVertices, -1);
+		vector<float>::type vertexScore(nVertices);
+		for (uint32 v = 0; v < nVertices; ++v)
+			vertexScore[v] = forsythVertexScore(-1, remaining[v]);
+		vector<float>::type triangleScore(nTriangles);
+		vector<unsigned char>::type emitted(nTriangles, 0);
+		size_t bestTriangle = 0;
+		for (size_t t = 0; t < nTriangles; ++t)
+		{
+			triangleScore[t] = vertexScore[indexes[t * 3]] + vertexScore[indexes[t * 3 + 1]] +
+				vertexScore[indexes[t * 3 + 2]];
+			if (triangleScore[t] > triangleScore[bestTriangle])
+				bestTriangle = t;
+		}
 
-		bool found = false;
-		for (i = 0; i < nTriangles; ++i)
+		int cache[FORSYTH_CACHE_SIZE + 3];
+		int cacheCount = 0;
+		size_t nextUnemitted = 0;
+		vector<uint32>::type order;
+		order.reserve(nTriangles);
+		for (size_t n = 0; n < nTriangles; ++n)
 		{
-			if (found)
-				found = false;
-			else
+			if (bestTriangle == nTriangles)
 			{
-				while (visited[start++]);
-				ti = start - 1;
+				// Nothing in the cache is connected to anything left, continue anywhere
+				while (emitted[nextUnemitted])
+					++nextUnemitted;
+				bestTriangle = nextUnemitted;
 			}
+			emitted[bestTriangle] = 1;
+			order.push_back(static_cast<uint32>(bestTriangle));
 
-			destlist[destcount++] = ti;
-			visited[ti] = 1;
+			// Push the vertices to the front of the cache and drop the triangle from them
+			int newCache[FORSYTH_CACHE_SIZE + 3];
+			int newCount = 0;
+			for (size_t c = 0; c < 3; ++c)
+			{
+				const uint32 v = indexes[bestTriangle * 3 + c];
+				uint32* first = &adjacency[adjacencyStart[v]];
+				uint32* last = first + remaining[v] - 1;
+				for (uint32* tri = first; tri <= last; ++tri)
+				{
+					if (*tri == bestTriangle)
+					{
+						std::swap(*tri, *last);
+						break;
+					}
+				}
+				--remaining[v];
+				newCache[newCount++] = static_cast<int>(v);
+			}
+			for (int c = 0; c < cacheCount; ++c)
+			{
+				const int v = cache[c];
+				if (v != newCache[0] && v != newCache[1] && v != newCache[2])
+					newCache[newCount++] = v;
+			}
 
-			for (j = start; j < nTriangles; ++j)
+			// Rescore everything which was or is in the cache, and their triangles
+			bestTriangle = nTriangles;
+			float bestScore = -1.0f;
+			for (int c = 0; c < newCount; ++c)
 			{
-				if (visited[j]) continue;
-				
-				if (triangles[ti].sharesEdge(triangles[j]))
+				const uint32 v = static_cast<uint32>(newCache[c]);
+				cachePosition[v] = c < FORSYTH_CACHE_SIZE ? c : -1;
+				vertexScore[v] = forsythVertexScore(cachePosition[v], remaining[v]);
+			}
+			for (int c = 0; c < newCount; ++c)
+			{
+				const uint32 v = static_cast<uint32>(newCache[c]);
+				for (uint32 a = adjacencyStart[v]; a < adjacencyStart[v] + remaining[v]; ++a)
 				{
-					found = true;
-					ti = static_cast<uint32>(j);
-					break;
+					const uint32 t = adjacency[a];
+					triangleScore[t] = vertexScore[indexes[t * 3]] + vertexScore[indexes[t * 3 + 1]] +
+						vertexScore[indexes[t * 3 + 2]];
+					if (triangleScore[t] > bestScore)
+					{
+						bestScore = triangleScore[t];
+						bestTriangle = t;
+					}
 				}
 			}
+			cacheCount = std::min(newCount, FORSYTH_CACHE_SIZE);
+			memcpy(cache, newCache, cacheCount * sizeof(int));
 		}
 
-		if (indexBuffer->getType() == HardwareIndexBuffer::IT_16BIT)
+		// Write the triangles back in their new order
+		for (size_t t = 0; t < nTriangles; ++t)
 		{
-			// reorder the indexbuffer
-			j = 0;
-			for (i = 0; i < nTriangles; ++i)
+			for (size_t c = 0; c < 3; ++c)
 			{
-				Triangle *t = &triangles[destlist[i]];
-                if(source)
-                {
-                    source[j++] = (uint16)t->a;
-                    source[j++] = (uint16)t->b;
-                    source[j++] = (uint16)t->c;
-                }
+				const uint32 index = indexes[order[t] * 3 + c];
+				if (use32bit)
+					static_cast<uint32*>(buffer)[t * 3 + c] = index;
+				else
+					static_cast<uint16*>(buffer)[t * 3 + c] = static_cast<uint16>(index);
 			}
-			OGRE_FREE(triangles, MEMCATEGORY_GEOMETRY);
+		}
+
+		indexBuffer->unlock();
+	}
+	//-----------------------------------------------------------------------
+	void IndexData::remapIndexes(const vector<uint32>::type& vertexRemap)
+	{
+		if (indexBuffer.isNull() || indexCount == 0) return;
+
+		void *buffer = indexBuffer->lock(indexStart * indexBuffer->getIndexSize(),
+			indexCount * indexBuffer->getIndexSize(), HardwareBuffer::HBL_NORMAL);
+		if (indexBuffer->getType() == HardwareIndexBuffer::IT_32BIT)
+		{
+			uint32* pIdx = static_cast<uint32*>(buffer);
+			for (size_t i = 0; i < indexCount; ++i)
+				pIdx[i] = vertexRemap[pIdx[i]];
 		}
 		else
 		{
-			uint32 *reflist = OGRE_ALLOC_T(uint32, nTriangles, MEMCATEGORY_GEOMETRY);
+			uint16* pIdx = static_cast<uint16*>(buffer);
+			for (size_t i = 0; i < indexCount; ++i)
+				pIdx[i] = static_cast<uint16>(vertexRemap[pIdx[i]]);
+		}
+		indexBuffer->unlock();
+	}
+	//-----------------------------------------------------------------------
+	void VertexData::optimiseVertexFetch(const vector<IndexData*>::type& indexDataList,
+		vector<uint32>::type& outVertexRemap)
+	{
+		const uint32 unassigned = static_cast<uint32>(-1);
+		outVertexRemap.assign(vertexCount, unassigned);
+		uint32 nextVertex = 0;
 
-			// fill the referencebuffer
-			for (i = 0; i < nTriangles; ++i)
-				reflist[destlist[i]] = static_cast<uint32>(i);
-			
-			// reorder the indexbuffer
-			for (i = 0; i < nTriangles; ++i)
+		// Number the vertices by first use
+		for (vector<IndexData*>::type::const_iterator i = indexDataList.begin(); i != indexDataList.end(); ++i)
+		{
+			const IndexData* indexData = *i;
+			if (indexData->indexBuffer.isNull() || indexData->indexCount == 0)
+				continue;
+			const HardwareIndexBufferSharedPtr& ibuf = indexData->indexBuffer;
+			const void* buffer = ibuf->lock(indexData->indexStart * ibuf->getIndexSize(),
+				indexData->indexCount * ibuf->getIndexSize(), HardwareBuffer::HBL_READ_ONLY);
+			const bool use32bit = ibuf->getType() == HardwareIndexBuffer::IT_32BIT;
+			for (size_t n = 0; n < indexData->indexCount; ++n)
 			{
-				j = destlist[i];
-				if (i == j) continue; // do not move triangle
-
-				// swap triangles
-
-				Triangle t = triangles[i];
-				triangles[i] = triangles[j];
-				triangles[j] = t;
-
-				// change reference
-				destlist[reflist[i]] = static_cast<uint32>(j);
-				// destlist[i] = i; // not needed, it will not be used
+				const uint32 index = use32bit ? static_cast<const uint32*>(buffer)[n] :
+					static_cast<const uint16*>(buffer)[n];
+				if (index < vertexCount && outVertexRemap[index] == unassigned)
+					outVertexRemap[index] = nextVertex++;
 			}
+			ibuf->unlock();
+		}
+		for (size_t v = 0; v < vertexCount; ++v)
+		{
+			if (outVertexRemap[v] == unassigned)
+				outVertexRemap[v] = nextVertex++;
+		}
 
-			OGRE_FREE(reflist, MEMCATEGORY_GEOMETRY);
+		// Move the vertices in every bound buffer
+		const VertexBufferBinding::VertexBufferBindingMap& bindings = vertexBufferBinding->getBindings();
+		for (VertexBufferBinding::VertexBufferBindingMap::const_iterator b = bindings.begin(); b != bindings.end(); ++b)
+		{
+			const HardwareVertexBufferSharedPtr& vbuf = b->second;
+			const size_t vertexSize = vbuf->getVertexSize();
+			uchar* pData = static_cast<uchar*>(vbuf->lock(vertexStart * vertexSize,
+				vertexCount * vertexSize, HardwareBuffer::HBL_NORMAL));
+			vector<uchar>::type original(pData, pData + vertexCount * vertexSize);
+			for (size_t v = 0; v < vertexCount; ++v)
+				memcpy(pData + outVertexRemap[v] * vertexSize, &original[v * vertexSize], vertexSize);
+			vbuf->unlock();
 		}
 
-		OGRE_FREE(destlist, MEMCATEGORY_GEOMETRY);
-		OGRE_FREE(visited, MEMCATEGORY_GEOMETRY);
-					
-		indexBuffer->unlock();
+		for (vector<IndexData*>::type::const_iterator i = indexDataList.begin(); i != indexDataList.end(); ++i)
+		{
+			(*i)->remapIndexes(outVertexRemap);
+		}
 	}
 	//-----------------------------------------------------------------------
 	//-----------------------------------------------------------------------
@@ -954,6 +1237,23 @@ namespace Ogre {
 		indexBuffer->unlock();
 	}
 
+	//-----------------------------------------------------------------------
+	void VertexCacheProfiler::profile(const IndexData* indexData)
+	{
+		const HardwareIndexBufferSharedPtr& indexBuffer = indexData->indexBuffer;
+		if (indexBuffer.isNull() || indexBuffer->isLocked() || indexData->indexCount == 0) return;
+
+		const void* buffer = indexBuffer->lock(indexData->indexStart * indexBuffer->getIndexSize(),
+			indexData->indexCount * indexBuffer->getIndexSize(), HardwareBuffer::HBL_READ_ONLY);
+		if (indexBuffer->getType() == HardwareIndexBuffer::IT_16BIT)
+			for (size_t i = 0; i < indexData->indexCount; ++i)
+				inCache(static_cast<const uint16*>(buffer)[i]);
+		else
+			for (size_t i = 0; i < indexData->indexCount; ++i)
+				inCache(static_cast<const uint32*>(buffer)[i]);
+
+		indexBuffer->unlock();
+	}
 	//-----------------------------------------------------------------------
 	bool VertexCacheProfiler::inCache(unsigned int index)
 	{
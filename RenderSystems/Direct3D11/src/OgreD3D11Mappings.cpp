@@ -509,6 +509,18 @@ namespace Ogre
 		case VET_UBYTE4:
 			return DXGI_FORMAT_R8G8B8A8_UINT;
 			break;
+		case VET_HALF2:
+			return DXGI_FORMAT_R16G16_FLOAT;
+			break;
+		case VET_HALF4:
+			return DXGI_FORMAT_R16G16B16A16_FLOAT;
+			break;
+		case VET_SHORT2_SNORM:
+			return DXGI_FORMAT_R16G16_SNORM;
+			break;
+		case VET_SHORT4_SNORM:
+			return DXGI_FORMAT_R16G16B16A16_SNORM;
+			break;
 		}
 		// to keep compiler happy
 		return DXGI_FORMAT_R32G32B32_FLOAT;
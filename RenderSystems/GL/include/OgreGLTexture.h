@@ -91,6 +91,14 @@ namespace Ogre {
         */
         LoadedImages mLoadedImages;
 
+        /** File read into memory by prepareImpl which loadImpl decodes straight
+            into the texture, see Texture::_loadFromStream. Null when mLoadedImages is used.
+        */
+        DataStreamPtr mLoadedStream;
+
+        /// Adjusts the texture type and mipmaps to an image loaded from a single file
+        void applyImageProperties(const Image& image);
+
 
     private:
         GLuint mTextureID;
@@ -3830,6 +3830,10 @@ GL_RGB_SCALE : GL_ALPHA_SCALE, 1);
                 typeCount = 4;
                 normalised = GL_TRUE;
                 break;
+            case VET_SHORT2_SNORM:
+            case VET_SHORT4_SNORM:
+                normalised = GL_TRUE;
+                break;
             default:
                 break;
             };
@@ -294,6 +294,19 @@ namespace Ogre {
         if( pos != String::npos )
             ext = mName.substr(pos+1);
 
+        // A file which can be decoded straight into the texture is only read here, so
+        // that the file access stays off the render thread. Holding the file's bytes
+        // until loadImpl costs its size on disk rather than a whole decoded image.
+        bool singleFile = mTextureType != TEX_TYPE_CUBE_MAP || getSourceFileType() == "dds";
+        if (singleFile && !mStreaming && _canLoadFromStream(ext))
+        {
+            mLoadedStream = ResourceGroupManager::getSingleton().openResource(mName, mGroup, true, this);
+            // fully prebuffer into host RAM, unless the stream is there already (e.g. mapped)
+            if (!mLoadedStream->size() || !mLoadedStream->peek(mLoadedStream->size()))
+                mLoadedStream = DataStreamPtr(OGRE_NEW MemoryDataStream(mName, mLoadedStream));
+            return;
+        }
+
         LoadedImages loadedImages = LoadedImages(new vector<Image>::type());
 
         if(mTextureType == TEX_TYPE_1D || mTextureType == TEX_TYPE_2D || 
@@ -301,26 +314,7 @@ namespace Ogre {
         {
 
             do_image_io(mName, mGroup, ext, *loadedImages, this);
-
-            // If this is a cube map, set the texture type flag accordingly.
-            if ((*loadedImages)[0].hasFlag(IF_CUBEMAP))
-                mTextureType = TEX_TYPE_CUBE_MAP;
-            // If this is a volumetric texture set the texture type flag accordingly.
-            if((*loadedImages)[0].getDepth() > 1 && mTextureType != TEX_TYPE_2D_ARRAY)
-                mTextureType = TEX_TYPE_3D;
-            // If compressed and 0 custom mipmaps disable auto mip generation and disable software mipmap creation
-            PixelFormat imageFormat = (*loadedImages)[0].getFormat();
-			if (PixelUtil::isCompressed(imageFormat))
-			{
-                size_t imageMips = (*loadedImages)[0].getNumMipmaps();
-                if (imageMips == 0)
-                {
-                    mNumMipmaps = mNumRequestedMipmaps = imageMips;
-                    // Disable flag for auto mip generation
-                    mUsage &= ~TU_AUTOMIPMAP;
-                }
-			}
-
+            applyImageProperties((*loadedImages)[0]);
         }
         else if (mTextureType == TEX_TYPE_CUBE_MAP)
         {
@@ -353,9 +347,32 @@ namespace Ogre {
         mLoadedImages = loadedImages;
     }
 	
+    void GLTexture::applyImageProperties(const Image& image)
+    {
+        // If this is a cube map, set the texture type flag accordingly.
+        if (image.hasFlag(IF_CUBEMAP))
+            mTextureType = TEX_TYPE_CUBE_MAP;
+        // If this is a volumetric texture set the texture type flag accordingly.
+        if(image.getDepth() > 1 && mTextureType != TEX_TYPE_2D_ARRAY)
+            mTextureType = TEX_TYPE_3D;
+        // If compressed and 0 custom mipmaps disable auto mip generation and disable software mipmap creation
+        PixelFormat imageFormat = image.getFormat();
+		if (PixelUtil::isCompressed(imageFormat))
+		{
+            size_t imageMips = image.getNumMipmaps();
+            if (imageMips == 0)
+            {
+                mNumMipmaps = mNumRequestedMipmaps = imageMips;
+                // Disable flag for auto mip generation
+                mUsage &= ~TU_AUTOMIPMAP;
+            }
+		}
+    }
+
     void GLTexture::unprepareImpl()
     {
         mLoadedImages.setNull();
+        mLoadedStream.setNull();
     }
 
     void GLTexture::loadImpl()
@@ -366,6 +383,19 @@ namespace Ogre {
             return;
         }
 
+        if (!mLoadedStream.isNull())
+        {
+            DataStreamPtr stream = mLoadedStream;
+            mLoadedStream.setNull();
+            if (_loadFromStream(stream, getSourceFileType()))
+                return;
+
+            // Needs converting on the way, decode the file into an image after all
+            mLoadedImages = LoadedImages(new vector<Image>::type(1));
+            (*mLoadedImages)[0].load(stream, getSourceFileType());
+            applyImageProperties((*mLoadedImages)[0]);
+        }
+
         // Now the only copy is on the stack and will be cleaned in case of
         // exceptions being thrown from _loadImages
         LoadedImages loadedImages = mLoadedImages;
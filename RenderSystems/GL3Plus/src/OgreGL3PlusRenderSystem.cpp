@@ -2699,6 +2699,10 @@ namespace Ogre {
                     typeCount = 4;
                     normalised = GL_TRUE;
                     break;
+                case VET_SHORT2_SNORM:
+                case VET_SHORT4_SNORM:
+                    normalised = GL_TRUE;
+                    break;
                 default:
                     break;
             };
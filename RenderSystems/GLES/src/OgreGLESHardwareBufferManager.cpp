@@ -139,6 +139,8 @@ namespace Ogre {
             case VET_SHORT2:
             case VET_SHORT3:
             case VET_SHORT4:
+            case VET_SHORT2_SNORM:
+            case VET_SHORT4_SNORM:
                 return GL_SHORT;
             case VET_COLOUR:
             case VET_COLOUR_ABGR:
@@ -159,7 +159,12 @@ namespace Ogre {
             case VET_SHORT2:
             case VET_SHORT3:
             case VET_SHORT4:
+            case VET_SHORT2_SNORM:
+            case VET_SHORT4_SNORM:
                 return GL_SHORT;
+            case VET_HALF2:
+            case VET_HALF4:
+                return GL_HALF_FLOAT_OES;
             case VET_COLOUR:
             case VET_COLOUR_ABGR:
             case VET_COLOUR_ARGB:
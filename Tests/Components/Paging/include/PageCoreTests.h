@@ -39,6 +39,9 @@ class PageCoreTests : public CppUnit::TestFixture
 	// CppUnit macros for setting up the test suite
 	CPPUNIT_TEST_SUITE( PageCoreTests );
 	CPPUNIT_TEST(testSimpleCreateSaveLoadWorld);
+	CPPUNIT_TEST(testPagePrepareLimit);
+	CPPUNIT_TEST(testPrefetchWaypointsPerCamera);
+	CPPUNIT_TEST(testPrefetchRequestLimit);
 	CPPUNIT_TEST_SUITE_END();
 
 	Root* mRoot;
@@ -49,4 +52,7 @@ public:
 	void tearDown();
 	void testSimpleCreateSaveLoadWorld();
 	void testLoadWorld();
+	void testPagePrepareLimit();
+	void testPrefetchWaypointsPerCamera();
+	void testPrefetchRequestLimit();
 };
@@ -96,3 +96,148 @@ void PageCoreTests::testSimpleCreateSaveLoadWorld()
 
 }
 
+void PageCoreTests::testPagePrepareLimit()
+{
+	PagedWorld* world = mPageManager->createWorld("LimitWorld");
+	PagedWorldSection* section = world->createSection("Grid2D", mSceneMgr, "Section1");
+
+	mPageManager->setMaxConcurrentPagePrepares(1);
+
+	// Responses are only processed at the end of a frame, so nothing completes here
+	section->loadPage(1, false);
+	section->loadPage(2, false);
+	section->loadPage(3, false);
+
+	CPPUNIT_ASSERT_EQUAL((size_t)1, mPageManager->getPagePreparesInProgress());
+	CPPUNIT_ASSERT_EQUAL((size_t)2, mPageManager->getPendingPagePrepareCount());
+
+	// Queued pages must be forgotten when they are destroyed
+	section->unloadPage(2);
+	CPPUNIT_ASSERT_EQUAL((size_t)1, mPageManager->getPendingPagePrepareCount());
+
+	// Destroying the page in flight frees its slot, but a new request must still
+	// wait behind page 3 until the queue is served from its head at frame start
+	section->unloadPage(1);
+	CPPUNIT_ASSERT_EQUAL((size_t)0, mPageManager->getPagePreparesInProgress());
+	section->loadPage(4, false);
+	CPPUNIT_ASSERT_EQUAL((size_t)0, mPageManager->getPagePreparesInProgress());
+	CPPUNIT_ASSERT_EQUAL((size_t)2, mPageManager->getPendingPagePrepareCount());
+
+	// Frame start dispatches page 3, so unloading it frees the slot again
+	mRoot->_fireFrameStarted();
+	CPPUNIT_ASSERT_EQUAL((size_t)1, mPageManager->getPagePreparesInProgress());
+	CPPUNIT_ASSERT_EQUAL((size_t)1, mPageManager->getPendingPagePrepareCount());
+	section->unloadPage(3);
+	CPPUNIT_ASSERT_EQUAL((size_t)0, mPageManager->getPagePreparesInProgress());
+	CPPUNIT_ASSERT_EQUAL((size_t)1, mPageManager->getPendingPagePrepareCount());
+
+	mPageManager->destroyWorld(world);
+	CPPUNIT_ASSERT_EQUAL((size_t)0, mPageManager->getPagePreparesInProgress());
+	CPPUNIT_ASSERT_EQUAL((size_t)0, mPageManager->getPendingPagePrepareCount());
+}
+
+/// Puts the pages of a single row along X within load range of a position
+class RowPageRange : public PagePrefetchPredictor::PageRange
+{
+public:
+	void getPagesInLoadRange(const Vector3& worldPos, PagePrefetchPredictor::PageIDList& outPages)
+	{
+		PageID x = (PageID)(worldPos.x / 1000);
+		outPages.push_back(x);
+		outPages.push_back(x + 1);
+	}
+};
+
+void PageCoreTests::testPrefetchWaypointsPerCamera()
+{
+	// Cameras can't be created without a render system, they are only keys here
+	int a, b;
+	const Camera* camA = reinterpret_cast<const Camera*>(&a);
+	const Camera* camB = reinterpret_cast<const Camera*>(&b);
+
+	PagePrefetchPredictor predictor;
+	predictor.setLookaheadTime(2);
+	predictor.updateCamera(camA, Vector3::ZERO);
+	predictor.updateCamera(camB, Vector3::ZERO);
+
+	// both cameras move along +X at the same speed
+	predictor.advanceTime(1);
+	predictor.updateCamera(camA, Vector3(100, 0, 0));
+	predictor.updateCamera(camB, Vector3(100, 0, 0));
+
+	// only camera A is told to turn
+	predictor.addWaypoint(camA, Vector3(100, 0, -1000));
+	CPPUNIT_ASSERT_EQUAL((size_t)1, predictor.getWaypoints(camA).size());
+	CPPUNIT_ASSERT(predictor.getWaypoints(camB).empty());
+
+	PagePrefetchPredictor::PositionList pathA, pathB;
+	predictor.getPredictedPath(camA, 10, pathA);
+	predictor.getPredictedPath(camB, 10, pathB);
+	CPPUNIT_ASSERT(!pathA.empty());
+	CPPUNIT_ASSERT(!pathB.empty());
+
+	for (PagePrefetchPredictor::PositionList::iterator i = pathA.begin(); i != pathA.end(); ++i)
+	{
+		CPPUNIT_ASSERT(Math::RealEqual(100, i->x));
+		CPPUNIT_ASSERT(i->z < 0);
+	}
+	for (PagePrefetchPredictor::PositionList::iterator i = pathB.begin(); i != pathB.end(); ++i)
+	{
+		CPPUNIT_ASSERT(i->x > 100);
+		CPPUNIT_ASSERT(Math::RealEqual(0, i->z));
+	}
+	// the waypoint of camera A is still ahead of it
+	CPPUNIT_ASSERT_EQUAL((size_t)1, predictor.getWaypoints(camA).size());
+
+	predictor.clearWaypoints(camA);
+	CPPUNIT_ASSERT(predictor.getWaypoints(camA).empty());
+}
+
+void PageCoreTests::testPrefetchRequestLimit()
+{
+#if OGRE_THREAD_SUPPORT
+	PagedWorld* world = mPageManager->createWorld("PrefetchWorld");
+	PagedWorldSection* section = world->createSection("Grid2D", mSceneMgr, "Section1");
+
+	int c;
+	const Camera* cam = reinterpret_cast<const Camera*>(&c);
+	RowPageRange range;
+	PagePrefetchPredictor predictor;
+	predictor.setLookaheadTime(10);
+	predictor.setMaxPrefetchRequests(2);
+
+	// Responses are only processed at the end of a frame, so these regular
+	// pages are all still loading; they must not use up the limit
+	section->loadPage(0, false);
+	section->loadPage(1, false);
+	section->loadPage(2, false);
+
+	predictor.prefetchPages(cam, Vector3::ZERO, section, 1000, range);
+	// no velocity yet, so nothing is predicted
+	CPPUNIT_ASSERT_EQUAL((size_t)0, predictor.getPrefetchRequestsInProgress());
+
+	predictor.advanceTime(1);
+	predictor.prefetchPages(cam, Vector3(1000, 0, 0), section, 1000, range);
+	// the nearest missing pages are requested first
+	CPPUNIT_ASSERT_EQUAL((size_t)2, predictor.getPrefetchRequestsInProgress());
+	CPPUNIT_ASSERT(section->getPage(3) != 0);
+	CPPUNIT_ASSERT(section->getPage(4) != 0);
+	CPPUNIT_ASSERT(section->getPage(5) == 0);
+
+	// further updates must not exceed the limit while those are loading
+	predictor.advanceTime(1);
+	predictor.prefetchPages(cam, Vector3(1000, 0, 0), section, 1000, range);
+	CPPUNIT_ASSERT_EQUAL((size_t)2, predictor.getPrefetchRequestsInProgress());
+	CPPUNIT_ASSERT(section->getPage(5) == 0);
+
+	// once a prefetched page is gone it no longer counts
+	section->unloadPage(3);
+	predictor.advanceTime(1);
+	predictor.prefetchPages(cam, Vector3(1000, 0, 0), section, 1000, range);
+	CPPUNIT_ASSERT_EQUAL((size_t)2, predictor.getPrefetchRequestsInProgress());
+	CPPUNIT_ASSERT(section->getPage(3) != 0);
+	CPPUNIT_ASSERT(section->getPage(5) == 0);
+
+	mPageManager->destroyWorld(world);
+#endif
+}
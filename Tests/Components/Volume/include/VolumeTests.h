@@ -0,0 +1,64 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "OgreVolumeOctreeNode.h"
+#include "OgreVolumeSource.h"
+
+using namespace Ogre; 
+
+class VolumeTests : public CppUnit::TestFixture
+{
+	// CppUnit macros for setting up the test suite
+	CPPUNIT_TEST_SUITE( VolumeTests );
+	CPPUNIT_TEST(testParallelSplit);
+	CPPUNIT_TEST(testParallelSplitCached);
+	CPPUNIT_TEST(testBatchValues);
+	CPPUNIT_TEST(testBatchPrimitives);
+	CPPUNIT_TEST_SUITE_END();
+
+	Volume::Source* mSphere;
+	Volume::Source* mNoise;
+	Real mFrequencies[2];
+	Real mAmplitudes[2];
+
+	/// Splits the octree of the given source serially and in parallel and compares both.
+	void splitAndCompare(const Volume::Source* src, size_t threadCount);
+	/// Whether both trees have the same structure and leaf values.
+	bool isSameTree(const Volume::OctreeNode* a, const Volume::OctreeNode* b);
+	/// Compares the batch evaluation of the given source with the evaluation per position.
+	void compareBatch(const Volume::Source* src);
+public:
+	void setUp();
+	void tearDown();
+	void testParallelSplit();
+	void testParallelSplitCached();
+	void testBatchValues();
+	void testBatchPrimitives();
+};
@@ -0,0 +1,166 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "VolumeTests.h"
+#include "OgreVolumeCSGSource.h"
+#include "OgreVolumeCacheSource.h"
+#include "OgreVolumeGridSource.h"
+#include "OgreVolumeOctreeNodeSplitPolicy.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION( VolumeTests );
+
+/// A grid whose values come from a formula, so no texture or file is needed.
+class TestGridSource : public Volume::GridSource
+{
+public:
+	TestGridSource(bool trilinear) : Volume::GridSource(trilinear, trilinear, trilinear)
+	{
+		mWidth = mHeight = mDepth = 17;
+		mPosXScale = mPosYScale = mPosZScale = (Real)0.25;
+	}
+
+protected:
+	float getVolumeGridValue(int x, int y, int z) const
+	{
+		return (float)(x * x - 3 * y + z * (x - y)) * 0.1f;
+	}
+
+	void setVolumeGridValue(int x, int y, int z, float value)
+	{
+	}
+};
+
+void VolumeTests::setUp()
+{
+	mSphere = new Volume::CSGSphereSource((Real)24.0, Vector3((Real)32.0, (Real)32.0, (Real)32.0));
+	mFrequencies[0] = (Real)1.01;
+	mFrequencies[1] = (Real)0.48;
+	mAmplitudes[0] = (Real)0.25;
+	mAmplitudes[1] = (Real)0.5;
+	mNoise = new Volume::CSGNoiseSource(mSphere, mFrequencies, mAmplitudes, 2, 42);
+}
+
+void VolumeTests::tearDown()
+{
+	delete mNoise;
+	delete mSphere;
+}
+
+bool VolumeTests::isSameTree(const Volume::OctreeNode* a, const Volume::OctreeNode* b)
+{
+	if (a->isSubdivided() != b->isSubdivided())
+	{
+		return false;
+	}
+	if (!a->isSubdivided())
+	{
+		return a->getCenterValue() == b->getCenterValue();
+	}
+	for (size_t i = 0; i < Volume::OctreeNode::OCTREE_CHILDREN_COUNT; ++i)
+	{
+		if (!isSameTree(a->getChild(i), b->getChild(i)))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void VolumeTests::splitAndCompare(const Volume::Source* src, size_t threadCount)
+{
+	const Vector3 from((Real)0.0), to((Real)64.0);
+	const Real error = (Real)0.5;
+	Volume::OctreeNodeSplitPolicy policy(src, error);
+	Volume::OctreeNode serialRoot(from, to);
+	Volume::OctreeNode parallelRoot(from, to);
+
+	serialRoot.split(&policy, src, error);
+	parallelRoot.splitParallel(&policy, src, error, threadCount);
+
+	CPPUNIT_ASSERT(serialRoot.isSubdivided());
+	CPPUNIT_ASSERT(isSameTree(&serialRoot, &parallelRoot));
+}
+
+void VolumeTests::testParallelSplit()
+{
+	splitAndCompare(mNoise, 4);
+	// More threads than children
+	splitAndCompare(mNoise, 16);
+}
+
+void VolumeTests::testParallelSplitCached()
+{
+	Volume::CacheSource cache(mNoise);
+	splitAndCompare(&cache, 4);
+}
+
+void VolumeTests::testBatchValues()
+{
+	Volume::CSGCubeSource cube(Vector3((Real)8.0), Vector3((Real)40.0));
+	Volume::CSGPlaneSource plane((Real)30.0, Vector3::UNIT_Y);
+	Volume::CSGDifferenceSource difference(&cube, mNoise);
+	Volume::CSGScaleSource scale(&difference, (Real)0.5);
+	Volume::CSGNegateSource negate(&plane);
+	Volume::CSGUnionSource unionSource(&scale, &negate);
+	Volume::CSGIntersectionSource intersection(&unionSource, mSphere);
+	compareBatch(&intersection);
+}
+
+void VolumeTests::compareBatch(const Volume::Source* src)
+{
+	// More positions than one batch to cover the blockwise evaluation.
+	const size_t count = Volume::Source::BATCH_SIZE * 2 + 7;
+	vector<Real>::type x(count), y(count), z(count), values(count);
+	vector<Vector4>::type results(count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		x[i] = (Real)(i % 13) * (Real)5.0;
+		y[i] = (Real)(i % 7) * (Real)9.0;
+		z[i] = (Real)(i % 11) * (Real)6.0;
+	}
+	src->getValues(&x[0], &y[0], &z[0], &values[0], count);
+	src->getValuesAndGradients(&x[0], &y[0], &z[0], &results[0], count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		const Vector3 position(x[i], y[i], z[i]);
+		CPPUNIT_ASSERT_EQUAL(src->getValue(position), values[i]);
+		CPPUNIT_ASSERT(src->getValueAndGradient(position) == results[i]);
+	}
+}
+
+void VolumeTests::testBatchPrimitives()
+{
+	// The sources with their own batch loops, evaluated directly rather than through an operation.
+	compareBatch(mSphere);
+	compareBatch(mNoise);
+	Volume::CSGCubeSource cube(Vector3((Real)8.0), Vector3((Real)40.0));
+	compareBatch(&cube);
+	TestGridSource trilinear(true);
+	compareBatch(&trilinear);
+	TestGridSource nearest(false);
+	compareBatch(&nearest);
+}
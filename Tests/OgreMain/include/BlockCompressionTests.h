@@ -0,0 +1,66 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "OgrePixelFormat.h"
+
+class BlockCompressionTests : public CppUnit::TestFixture
+{
+    // CppUnit macros for setting up the test suite
+    CPPUNIT_TEST_SUITE( BlockCompressionTests );
+    CPPUNIT_TEST(testCanCompressTo);
+    CPPUNIT_TEST(testDXT1FlatColour);
+    CPPUNIT_TEST(testDXT1Transparency);
+    CPPUNIT_TEST(testGradientQuality);
+    CPPUNIT_TEST(testSignedFormats);
+    CPPUNIT_TEST(testPartialBlocks);
+    CPPUNIT_TEST(testParallelMatchesSerial);
+    CPPUNIT_TEST(testBulkPixelConversion);
+    CPPUNIT_TEST(testImageCompress);
+    CPPUNIT_TEST_SUITE_END();
+protected:
+    /// Decode compressed data back to RGBA bytes, with reference decoders
+    void decode(const Ogre::uint8* data, size_t width, size_t height, Ogre::PixelFormat format,
+        Ogre::uint8* rgba);
+    /// Root mean square error over the channels the format stores
+    float rmsError(const Ogre::uint8* a, const Ogre::uint8* b, size_t pixels, size_t channels);
+    void makeGradient(Ogre::uint8* rgba, size_t width, size_t height);
+public:
+    void setUp();
+    void tearDown();
+
+    void testCanCompressTo();
+    void testDXT1FlatColour();
+    void testDXT1Transparency();
+    void testGradientQuality();
+    void testSignedFormats();
+    void testPartialBlocks();
+    void testParallelMatchesSerial();
+    void testBulkPixelConversion();
+    void testImageCompress();
+};
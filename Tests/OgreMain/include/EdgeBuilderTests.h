@@ -39,6 +39,7 @@ class EdgeBuilderTests : public CppUnit::TestFixture
     CPPUNIT_TEST(testSingleIndexBufSingleVertexBuf);
     CPPUNIT_TEST(testMultiIndexBufSingleVertexBuf);
     CPPUNIT_TEST(testMultiIndexBufMultiVertexBuf);
+    CPPUNIT_TEST(testLargeUnweldedGrid);
     CPPUNIT_TEST_SUITE_END();
 protected:
     HardwareBufferManager* mBufMgr;
@@ -49,5 +50,6 @@ public:
     void testSingleIndexBufSingleVertexBuf();
     void testMultiIndexBufSingleVertexBuf();
     void testMultiIndexBufMultiVertexBuf();
+    void testLargeUnweldedGrid();
 
 };
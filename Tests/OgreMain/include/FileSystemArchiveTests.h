@@ -44,6 +44,7 @@ class FileSystemArchiveTests : public CppUnit::TestFixture
     CPPUNIT_TEST(testFindFileInfoNonRecursive);
     CPPUNIT_TEST(testFindFileInfoRecursive);
     CPPUNIT_TEST(testFileRead);
+    CPPUNIT_TEST(testMappedFileRead);
     CPPUNIT_TEST(testReadInterleave);
 	CPPUNIT_TEST(testCreateAndRemoveFile);
     CPPUNIT_TEST_SUITE_END();
@@ -62,6 +63,7 @@ public:
     void testFindFileInfoNonRecursive();
     void testFindFileInfoRecursive();
     void testFileRead();
+    void testMappedFileRead();
     void testReadInterleave();
 	void testCreateAndRemoveFile();
 
@@ -28,6 +28,7 @@ THE SOFTWARE.
 #include <cppunit/TestFixture.h>
 #include <cppunit/extensions/HelperMacros.h>
 #include "OgreLogManager.h"
+#include "OgreMesh.h"
 
 using namespace Ogre;
 using Ogre::ushort;
@@ -47,6 +48,12 @@ class MeshWithoutIndexDataTests : public CppUnit::TestFixture
     CPPUNIT_TEST(testGenerateExtremes);
     CPPUNIT_TEST(testBuildTangentVectors);
     CPPUNIT_TEST(testGenerateLodLevels);
+    CPPUNIT_TEST(testBuildClusters);
+    CPPUNIT_TEST(testEdgeListLodLevels);
+    CPPUNIT_TEST(testQuantiseVertexData);
+    CPPUNIT_TEST(testQuantisedPositionConsumers);
+    CPPUNIT_TEST(testImportInPlace);
+    CPPUNIT_TEST(testImportDeferredPayloads);
     CPPUNIT_TEST_SUITE_END();
 
 protected:
@@ -54,6 +61,9 @@ protected:
     MeshManager* mMeshMgr;
     ArchiveManager* archiveMgr;
 
+    /// A small bumpy grid with normals, tangents and texture coordinates, as a mesh
+    MeshPtr createQuantiseGrid(const String& fileName, const String& materialName);
+
 public:
     void setUp();
     void tearDown();
@@ -68,5 +78,11 @@ public:
     void testGenerateExtremes();
     void testBuildTangentVectors();
     void testGenerateLodLevels();
+    void testBuildClusters();
+    void testEdgeListLodLevels();
+    void testQuantiseVertexData();
+    void testQuantisedPositionConsumers();
+    void testImportInPlace();
+    void testImportDeferredPayloads();
 
 };
@@ -38,6 +38,7 @@ class PixelFormatTests : public CppUnit::TestFixture
     CPPUNIT_TEST( testIntegerPackUnpack );
     CPPUNIT_TEST( testFloatPackUnpack );
     CPPUNIT_TEST( testBulkConversion );
+    CPPUNIT_TEST( testParallelConversion );
     CPPUNIT_TEST_SUITE_END();
 public:
     void setUp();
@@ -46,6 +47,7 @@ public:
     void testIntegerPackUnpack();
     void testFloatPackUnpack();
     void testBulkConversion();
+    void testParallelConversion();
 
     // Utils
     void setupBoxes(PixelFormat srcFormat, PixelFormat dstFormat);
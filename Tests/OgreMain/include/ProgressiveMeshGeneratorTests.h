@@ -0,0 +1,62 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "OgreLogManager.h"
+#include "OgreHardwareBufferManager.h"
+#include "OgreMesh.h"
+#include "OgreLodConfig.h"
+
+using namespace Ogre;
+
+class ProgressiveMeshGeneratorTests : public CppUnit::TestFixture
+{
+    // CppUnit macros for setting up the test suite
+    CPPUNIT_TEST_SUITE( ProgressiveMeshGeneratorTests );
+    CPPUNIT_TEST(testCollapseCostHeap);
+    CPPUNIT_TEST(testCostThreadsMatchSerial);
+    CPPUNIT_TEST(testQuadricKeepsBorder);
+    CPPUNIT_TEST_SUITE_END();
+
+protected:
+    HardwareBufferManager* mBufMgr;
+    MeshManager* mMeshMgr;
+
+    /// A grid of quads, bumpy unless flat is set, big enough to give every cost thread some vertices
+    MeshPtr createGrid(const String& name, size_t size, bool flat = false);
+    /// Generates three proportionally reduced Lod levels
+    void generateLods(MeshPtr& mesh, size_t costThreads,
+        LodConfig::ErrorMetric errorMetric = LodConfig::EM_CURVATURE);
+
+public:
+    void setUp();
+    void tearDown();
+    void testCollapseCostHeap();
+    void testCostThreadsMatchSerial();
+    void testQuadricKeepsBorder();
+};
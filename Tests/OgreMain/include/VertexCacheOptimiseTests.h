@@ -0,0 +1,67 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "OgreHardwareBufferManager.h"
+#include "OgreVertexIndexData.h"
+
+using namespace Ogre;
+
+class VertexCacheOptimiseTests : public CppUnit::TestFixture
+{
+    // CppUnit macros for setting up the test suite
+    CPPUNIT_TEST_SUITE( VertexCacheOptimiseTests );
+    CPPUNIT_TEST(testShuffledGrid);
+    CPPUNIT_TEST(testOrderedGrid);
+    CPPUNIT_TEST(testVertexFetch);
+    CPPUNIT_TEST_SUITE_END();
+protected:
+    HardwareBufferManager* mBufMgr;
+
+    /// A triangle with its winding kept, rotated so the smallest index comes first
+    typedef vector<uint32>::type Triangle;
+    typedef vector<Triangle>::type TriangleList;
+
+    /** Creates a grid of quads as a triangle list, in row order or shuffled.
+    @param padding Unused indexes before and after the grid, filled with the index 0
+    */
+    void createGrid(IndexData& indexData, size_t quads, bool shuffle,
+        HardwareIndexBuffer::IndexType type, size_t padding);
+    /// Reads the indexes in the used range of the index data
+    vector<uint32>::type readIndexes(const IndexData& indexData);
+    /// Sorted list of the triangles in the used range of the index data
+    TriangleList getTriangles(const IndexData& indexData);
+    /// Average cache miss ratio of the index data on a 16 entry FIFO cache
+    Real getACMR(const IndexData& indexData);
+public:
+    void setUp();
+    void tearDown();
+    void testShuffledGrid();
+    void testOrderedGrid();
+    void testVertexFetch();
+};
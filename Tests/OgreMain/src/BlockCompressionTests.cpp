@@ -0,0 +1,381 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "BlockCompressionTests.h"
+#include "OgreImage.h"
+#include "OgreException.h"
+#include <cmath>
+
+using namespace Ogre;
+
+// Register the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( BlockCompressionTests );
+
+namespace
+{
+    void decodeBC1(const uint8* block, bool fourColourOnly, uint8* rgba /* 16 pixels */)
+    {
+        const uint16 c0 = block[0] | (block[1] << 8), c1 = block[2] | (block[3] << 8);
+        int pal[4][4];
+        const uint16 c[2] = { c0, c1 };
+        for (int i = 0; i < 2; ++i)
+        {
+            const int r = c[i] >> 11, g = (c[i] >> 5) & 63, b = c[i] & 31;
+            pal[i][0] = (r << 3) | (r >> 2);
+            pal[i][1] = (g << 2) | (g >> 4);
+            pal[i][2] = (b << 3) | (b >> 2);
+            pal[i][3] = 255;
+        }
+        const bool four = fourColourOnly || c0 > c1;
+        for (int ch = 0; ch < 3; ++ch)
+        {
+            pal[2][ch] = four ? (2 * pal[0][ch] + pal[1][ch]) / 3 : (pal[0][ch] + pal[1][ch]) / 2;
+            pal[3][ch] = four ? (pal[0][ch] + 2 * pal[1][ch]) / 3 : 0;
+        }
+        pal[2][3] = 255;
+        pal[3][3] = four ? 255 : 0;
+        const uint32 bits = block[4] | (block[5] << 8) | (block[6] << 16) | (uint32(block[7]) << 24);
+        for (int i = 0; i < 16; ++i)
+            for (int ch = 0; ch < 4; ++ch)
+                rgba[i * 4 + ch] = static_cast<uint8>(pal[(bits >> (2 * i)) & 3][ch]);
+    }
+
+    void decodeBC4(const uint8* block, bool isSigned, uint8* values, size_t stride)
+    {
+        int a0 = block[0], a1 = block[1];
+        if (isSigned)
+        {
+            a0 = static_cast<int8>(block[0]);
+            a1 = static_cast<int8>(block[1]);
+        }
+        int pal[8] = { a0, a1 };
+        if (a0 > a1)
+        {
+            for (int i = 2; i < 8; ++i)
+                pal[i] = ((8 - i) * a0 + (i - 1) * a1) / 7;
+        }
+        else
+        {
+            for (int i = 2; i < 6; ++i)
+                pal[i] = ((6 - i) * a0 + (i - 1) * a1) / 5;
+            pal[6] = isSigned ? -127 : 0;
+            pal[7] = isSigned ? 127 : 255;
+        }
+        uint64 bits = 0;
+        for (int i = 0; i < 6; ++i)
+            bits |= uint64(block[2 + i]) << (8 * i);
+        for (int i = 0; i < 16; ++i)
+        {
+            const int v = pal[(bits >> (3 * i)) & 7];
+            // Signed values come back in the 0..255 range they were encoded from
+            values[i * stride] = static_cast<uint8>(isSigned ? ((v + 127) * 255 + 127) / 254 : v);
+        }
+    }
+
+    uint32 readBits(const uint8* block, size_t& pos, size_t count)
+    {
+        uint32 value = 0;
+        for (size_t i = 0; i < count; ++i, ++pos)
+            value |= uint32((block[pos >> 3] >> (pos & 7)) & 1) << i;
+        return value;
+    }
+
+    /// Only mode 6, which is all the encoder writes
+    bool decodeBC7(const uint8* block, uint8* rgba)
+    {
+        size_t pos = 0;
+        if (readBits(block, pos, 7) != 64)
+            return false;
+        int e[2][4];
+        for (int ch = 0; ch < 4; ++ch)
+        {
+            e[0][ch] = readBits(block, pos, 7) << 1;
+            e[1][ch] = readBits(block, pos, 7) << 1;
+        }
+        const int p0 = readBits(block, pos, 1), p1 = readBits(block, pos, 1);
+        static const int weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+        for (int i = 0; i < 16; ++i)
+        {
+            const int w = weights[readBits(block, pos, i ? 4 : 3)];
+            for (int ch = 0; ch < 4; ++ch)
+                rgba[i * 4 + ch] = static_cast<uint8>(((64 - w) * (e[0][ch] | p0) + w * (e[1][ch] | p1) + 32) >> 6);
+        }
+        return true;
+    }
+}
+
+void BlockCompressionTests::setUp()
+{
+}
+void BlockCompressionTests::tearDown()
+{
+    PixelUtil::setBulkConversionThreads(0);
+}
+void BlockCompressionTests::decode(const uint8* data, size_t width, size_t height, PixelFormat format, uint8* rgba)
+{
+    const size_t blockBytes = (format == PF_DXT1 || format == PF_BC4_UNORM || format == PF_BC4_SNORM) ? 8 : 16;
+    const bool isSigned = format == PF_BC4_SNORM || format == PF_BC5_SNORM;
+    for (size_t by = 0; by < (height + 3) / 4; ++by)
+    {
+        for (size_t bx = 0; bx < (width + 3) / 4; ++bx, data += blockBytes)
+        {
+            uint8 block[64];
+            memset(block, 0, sizeof(block));
+            switch (format)
+            {
+            case PF_DXT1:
+                decodeBC1(data, false, block);
+                break;
+            case PF_DXT3:
+                decodeBC1(data + 8, true, block);
+                for (int i = 0; i < 16; ++i)
+                    block[i * 4 + 3] = static_cast<uint8>(((data[i / 2] >> (4 * (i & 1))) & 15) * 17);
+                break;
+            case PF_DXT5:
+                decodeBC1(data + 8, true, block);
+                decodeBC4(data, false, block + 3, 4);
+                break;
+            case PF_BC4_UNORM:
+            case PF_BC4_SNORM:
+                decodeBC4(data, isSigned, block, 4);
+                break;
+            case PF_BC5_UNORM:
+            case PF_BC5_SNORM:
+                decodeBC4(data, isSigned, block, 4);
+                decodeBC4(data + 8, isSigned, block + 1, 4);
+                break;
+            case PF_BC7_UNORM:
+                CPPUNIT_ASSERT(decodeBC7(data, block));
+                break;
+            default:
+                CPPUNIT_FAIL("No reference decoder");
+            }
+            for (size_t y = 0; y < 4 && by * 4 + y < height; ++y)
+                for (size_t x = 0; x < 4 && bx * 4 + x < width; ++x)
+                    memcpy(rgba + ((by * 4 + y) * width + bx * 4 + x) * 4, block + (y * 4 + x) * 4, 4);
+        }
+    }
+}
+float BlockCompressionTests::rmsError(const uint8* a, const uint8* b, size_t pixels, size_t channels)
+{
+    double sum = 0;
+    for (size_t i = 0; i < pixels; ++i)
+    {
+        for (size_t ch = 0; ch < channels; ++ch)
+        {
+            const double d = double(a[i * 4 + ch]) - double(b[i * 4 + ch]);
+            sum += d * d;
+        }
+    }
+    return static_cast<float>(std::sqrt(sum / (pixels * channels)));
+}
+void BlockCompressionTests::makeGradient(uint8* rgba, size_t width, size_t height)
+{
+    for (size_t y = 0; y < height; ++y)
+    {
+        for (size_t x = 0; x < width; ++x)
+        {
+            uint8* p = rgba + (y * width + x) * 4;
+            p[0] = static_cast<uint8>(x * 255 / (width - 1));
+            p[1] = static_cast<uint8>(y * 255 / (height - 1));
+            p[2] = static_cast<uint8>(128 + 100 * std::sin(x * 0.1) * std::cos(y * 0.07));
+            p[3] = static_cast<uint8>((x + y) * 255 / (width + height - 2));
+        }
+    }
+}
+void BlockCompressionTests::testCanCompressTo()
+{
+    CPPUNIT_ASSERT(PixelUtil::canCompressTo(PF_DXT1));
+    CPPUNIT_ASSERT(PixelUtil::canCompressTo(PF_DXT5));
+    CPPUNIT_ASSERT(PixelUtil::canCompressTo(PF_BC5_SNORM));
+    CPPUNIT_ASSERT(PixelUtil::canCompressTo(PF_BC7_UNORM_SRGB));
+    CPPUNIT_ASSERT(!PixelUtil::canCompressTo(PF_BC6H_UF16));
+    CPPUNIT_ASSERT(!PixelUtil::canCompressTo(PF_A8R8G8B8));
+    CPPUNIT_ASSERT(!PixelUtil::canCompressTo(PF_PVRTC_RGB4));
+}
+void BlockCompressionTests::testDXT1FlatColour()
+{
+    uint8 src[8 * 8 * 4], decoded[8 * 8 * 4];
+    for (size_t i = 0; i < 64; ++i)
+    {
+        src[i * 4] = 201;
+        src[i * 4 + 1] = 99;
+        src[i * 4 + 2] = 47;
+        src[i * 4 + 3] = 255;
+    }
+    uint8 dst[4 * 8];
+    PixelUtil::compressPixels(PixelBox(8, 8, 1, PF_BYTE_RGBA, src), PixelBox(8, 8, 1, PF_DXT1, dst));
+    decode(dst, 8, 8, PF_DXT1, decoded);
+
+    // The interpolated colour gets closer than either rounded endpoint could
+    for (size_t i = 0; i < 64; ++i)
+    {
+        CPPUNIT_ASSERT(std::abs(decoded[i * 4] - 201) <= 1);
+        CPPUNIT_ASSERT(std::abs(decoded[i * 4 + 1] - 99) <= 1);
+        CPPUNIT_ASSERT(std::abs(decoded[i * 4 + 2] - 47) <= 1);
+        CPPUNIT_ASSERT_EQUAL(255, (int)decoded[i * 4 + 3]);
+    }
+}
+void BlockCompressionTests::testDXT1Transparency()
+{
+    uint8 src[4 * 4 * 4], decoded[4 * 4 * 4];
+    for (size_t i = 0; i < 16; ++i)
+    {
+        src[i * 4] = static_cast<uint8>(i * 16);
+        src[i * 4 + 1] = 40;
+        src[i * 4 + 2] = static_cast<uint8>(255 - i * 16);
+        src[i * 4 + 3] = (i % 3) ? 255 : 0;
+    }
+    uint8 dst[8];
+    PixelUtil::compressPixels(PixelBox(4, 4, 1, PF_BYTE_RGBA, src), PixelBox(4, 4, 1, PF_DXT1, dst), CQ_BEST);
+
+    // The 3 colour mode is selected by c0 <= c1
+    CPPUNIT_ASSERT((dst[0] | (dst[1] << 8)) <= (dst[2] | (dst[3] << 8)));
+    decode(dst, 4, 4, PF_DXT1, decoded);
+    for (size_t i = 0; i < 16; ++i)
+        CPPUNIT_ASSERT_EQUAL((int)src[i * 4 + 3], (int)decoded[i * 4 + 3]);
+}
+void BlockCompressionTests::testGradientQuality()
+{
+    const size_t size = 64;
+    std::vector<uint8> src(size * size * 4), dst(size * size * 4), decoded(size * size * 4);
+    makeGradient(&src[0], size, size);
+
+    const PixelFormat formats[] = { PF_DXT1, PF_DXT3, PF_DXT5, PF_BC4_UNORM, PF_BC5_UNORM, PF_BC7_UNORM };
+    const size_t channels[] = { 3, 4, 4, 1, 2, 4 };
+    // Generous bounds, the point is to catch broken blocks rather than grade the encoder
+    const float limits[] = { 5, 5, 4, 1, 1, 4 };
+    for (size_t f = 0; f < sizeof(formats) / sizeof(formats[0]); ++f)
+    {
+        // DXT1 would punch out the pixels with low alpha
+        if (formats[f] == PF_DXT1)
+            for (size_t i = 0; i < size * size; ++i)
+                src[i * 4 + 3] = 255;
+        float previous = 1e10f;
+        for (int q = CQ_FASTEST; q <= CQ_BEST; ++q)
+        {
+            PixelUtil::compressPixels(PixelBox(size, size, 1, PF_BYTE_RGBA, &src[0]),
+                PixelBox(size, size, 1, formats[f], &dst[0]), static_cast<CompressionQuality>(q));
+            decode(&dst[0], size, size, formats[f], &decoded[0]);
+            const float error = rmsError(&src[0], &decoded[0], size * size, channels[f]);
+            CPPUNIT_ASSERT(error < limits[f]);
+            // Better presets should never be noticeably worse
+            CPPUNIT_ASSERT(error <= previous + 0.05f);
+            previous = error;
+        }
+    }
+}
+void BlockCompressionTests::testSignedFormats()
+{
+    // A flat normal map, 0.5 in the source is 0 in the signed format
+    uint8 src[4 * 4 * 4], decoded[4 * 4 * 4];
+    for (size_t i = 0; i < 16; ++i)
+    {
+        src[i * 4] = 128;
+        src[i * 4 + 1] = static_cast<uint8>(i < 8 ? 0 : 255);
+        src[i * 4 + 2] = 255;
+        src[i * 4 + 3] = 255;
+    }
+    uint8 dst[16];
+    PixelUtil::compressPixels(PixelBox(4, 4, 1, PF_BYTE_RGBA, src), PixelBox(4, 4, 1, PF_BC5_SNORM, dst));
+    CPPUNIT_ASSERT_EQUAL(0, (int)static_cast<int8>(dst[0]));
+    decode(dst, 4, 4, PF_BC5_SNORM, decoded);
+    for (size_t i = 0; i < 16; ++i)
+    {
+        CPPUNIT_ASSERT(std::abs(decoded[i * 4] - 128) <= 1);
+        CPPUNIT_ASSERT_EQUAL((int)src[i * 4 + 1], (int)decoded[i * 4 + 1]);
+    }
+}
+void BlockCompressionTests::testPartialBlocks()
+{
+    // Encodes the same as the image padded by repeating its last column and row
+    const size_t width = 6, height = 5;
+    std::vector<uint8> src(width * height * 4), padded(8 * 8 * 4);
+    makeGradient(&src[0], width, height);
+    for (size_t y = 0; y < 8; ++y)
+        for (size_t x = 0; x < 8; ++x)
+            memcpy(&padded[(y * 8 + x) * 4], &src[(std::min(y, height - 1) * width + std::min(x, width - 1)) * 4], 4);
+
+    CPPUNIT_ASSERT_EQUAL((size_t)(2 * 2 * 16), PixelUtil::getMemorySize(width, height, 1, PF_BC7_UNORM));
+    uint8 dst[2 * 2 * 16], paddedDst[2 * 2 * 16];
+    PixelUtil::compressPixels(PixelBox(width, height, 1, PF_BYTE_RGBA, &src[0]),
+        PixelBox(width, height, 1, PF_BC7_UNORM, dst), CQ_BEST);
+    PixelUtil::compressPixels(PixelBox(8, 8, 1, PF_BYTE_RGBA, &padded[0]),
+        PixelBox(8, 8, 1, PF_BC7_UNORM, paddedDst), CQ_BEST);
+    CPPUNIT_ASSERT(memcmp(dst, paddedDst, sizeof(dst)) == 0);
+}
+void BlockCompressionTests::testParallelMatchesSerial()
+{
+    const size_t size = 256;
+    std::vector<uint8> src(size * size * 4);
+    makeGradient(&src[0], size, size);
+    const size_t bytes = PixelUtil::getMemorySize(size, size, 1, PF_DXT5);
+    std::vector<uint8> serial(bytes), parallel(bytes);
+
+    PixelUtil::setBulkConversionThreads(1);
+    PixelUtil::compressPixels(PixelBox(size, size, 1, PF_BYTE_RGBA, &src[0]), PixelBox(size, size, 1, PF_DXT5, &serial[0]));
+    PixelUtil::setBulkConversionThreads(4);
+    PixelUtil::compressPixels(PixelBox(size, size, 1, PF_BYTE_RGBA, &src[0]), PixelBox(size, size, 1, PF_DXT5, &parallel[0]));
+    CPPUNIT_ASSERT(serial == parallel);
+}
+void BlockCompressionTests::testBulkPixelConversion()
+{
+    // Any readable source format goes, it is unpacked to bytes first
+    const size_t size = 32;
+    std::vector<uint8> rgba(size * size * 4), argb(size * size * 4);
+    makeGradient(&rgba[0], size, size);
+    PixelUtil::bulkPixelConversion(PixelBox(size, size, 1, PF_BYTE_RGBA, &rgba[0]), PixelBox(size, size, 1, PF_A8R8G8B8, &argb[0]));
+
+    const size_t bytes = PixelUtil::getMemorySize(size, size, 1, PF_DXT5);
+    std::vector<uint8> viaCompress(bytes), viaConversion(bytes);
+    PixelUtil::compressPixels(PixelBox(size, size, 1, PF_BYTE_RGBA, &rgba[0]), PixelBox(size, size, 1, PF_DXT5, &viaCompress[0]));
+    PixelUtil::bulkPixelConversion(PixelBox(size, size, 1, PF_A8R8G8B8, &argb[0]), PixelBox(size, size, 1, PF_DXT5, &viaConversion[0]));
+    CPPUNIT_ASSERT(viaCompress == viaConversion);
+
+    // Decompression is still not supported
+    CPPUNIT_ASSERT_THROW(PixelUtil::bulkPixelConversion(PixelBox(size, size, 1, PF_DXT5, &viaConversion[0]),
+        PixelBox(size, size, 1, PF_A8R8G8B8, &argb[0])), Exception);
+}
+void BlockCompressionTests::testImageCompress()
+{
+    const size_t size = 16;
+    std::vector<uint8> src(size * size * 4);
+    makeGradient(&src[0], size, size);
+    Image img;
+    img.loadDynamicImage(&src[0], size, size, 1, PF_BYTE_RGBA);
+    CPPUNIT_ASSERT(img.generateMipmaps(2));
+    CPPUNIT_ASSERT(img.compress(PF_DXT1, CQ_FASTEST));
+
+    CPPUNIT_ASSERT_EQUAL(PF_DXT1, img.getFormat());
+    CPPUNIT_ASSERT(img.hasFlag(IF_COMPRESSED));
+    CPPUNIT_ASSERT_EQUAL((size_t)2, img.getNumMipmaps());
+    CPPUNIT_ASSERT_EQUAL(Image::calculateSize(2, 1, size, size, 1, PF_DXT1), img.getSize());
+    CPPUNIT_ASSERT_EQUAL((size_t)(16 * 8 + 4 * 8 + 8), img.getSize());
+
+    // Already compressed
+    CPPUNIT_ASSERT(!img.compress(PF_DXT5));
+}
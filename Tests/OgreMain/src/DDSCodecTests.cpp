@@ -0,0 +1,156 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "DDSCodecTests.h"
+#include "OgreDDSCodec.h"
+#include "OgreImage.h"
+#include "OgreException.h"
+
+using namespace Ogre;
+
+// Register the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( DDSCodecTests );
+
+namespace
+{
+    /// Hands out boxes with padded rows, like locked hardware buffers may have
+    class PaddedTarget : public ImageCodec::DecodeTarget
+    {
+    public:
+        PaddedTarget(bool accept) : mAccept(accept), mBegun(false), mLocks(0) { mLevels.reserve(16); }
+
+        bool begin(const ImageCodec::ImageData& data, size_t numFaces)
+        {
+            mBegun = true;
+            mData = data;
+            return mAccept;
+        }
+        PixelBox lock(size_t face, size_t mipmap)
+        {
+            size_t width = std::max<size_t>(mData.width >> mipmap, 1);
+            size_t height = std::max<size_t>(mData.height >> mipmap, 1);
+            PixelBox box(width, height, 1, mData.format);
+            box.rowPitch = width + 3;
+            box.slicePitch = box.rowPitch * height;
+            mLevels.push_back(vector<uint32>::type(box.slicePitch, 0xdeadbeef));
+            box.data = &mLevels.back()[0];
+            mBoxes.push_back(box);
+            ++mLocks;
+            return box;
+        }
+        void unlock(size_t face, size_t mipmap) { --mLocks; }
+
+        bool mAccept;
+        bool mBegun;
+        int mLocks;
+        ImageCodec::ImageData mData;
+        vector<vector<uint32>::type>::type mLevels;
+        vector<PixelBox>::type mBoxes;
+    };
+}
+
+void DDSCodecTests::setUp()
+{
+    DDSCodec::startup();
+}
+void DDSCodecTests::tearDown()
+{
+    DDSCodec::shutdown();
+}
+DataStreamPtr DDSCodecTests::createFile()
+{
+    // 8x4 A8R8G8B8 with 2 mipmaps
+    uint32 header[32] = { 0 };
+    header[0] = 0x20534444; // 'DDS '
+    header[1] = 124;
+    header[2] = 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000;
+    header[3] = 4;
+    header[4] = 8;
+    header[7] = 3;
+    header[19] = 32;
+    header[20] = 0x40 | 0x1;
+    header[22] = 32;
+    header[23] = 0x00ff0000;
+    header[24] = 0x0000ff00;
+    header[25] = 0x000000ff;
+    header[26] = 0xff000000;
+    header[27] = 0x1000 | 0x400000 | 0x8;
+
+    const size_t texels = 8 * 4 + 4 * 2 + 2 * 1;
+    MemoryDataStream* file = OGRE_NEW MemoryDataStream(sizeof(header) + texels * 4);
+    memcpy(file->getPtr(), header, sizeof(header));
+    uint32* pixels = reinterpret_cast<uint32*>(file->getPtr() + sizeof(header));
+    for (size_t i = 0; i < texels; ++i)
+        pixels[i] = 0x01020304 * (uint32)(i + 1);
+    return DataStreamPtr(file);
+}
+void DDSCodecTests::testDecodeToMatchesDecode()
+{
+    DataStreamPtr file = createFile();
+    Image img;
+    img.load(file, "dds");
+    CPPUNIT_ASSERT_EQUAL((size_t)2, img.getNumMipmaps());
+
+    file = createFile();
+    PaddedTarget target(true);
+    ImageCodec* codec = static_cast<ImageCodec*>(Codec::getCodec("dds"));
+    CPPUNIT_ASSERT(codec->canDecodeTo());
+    CPPUNIT_ASSERT(codec->decodeTo(file, target));
+    CPPUNIT_ASSERT_EQUAL(img.getFormat(), target.mData.format);
+    CPPUNIT_ASSERT_EQUAL((size_t)3, target.mBoxes.size());
+    CPPUNIT_ASSERT_EQUAL(0, target.mLocks);
+    CPPUNIT_ASSERT(file->eof());
+
+    for (size_t mip = 0; mip <= 2; ++mip)
+    {
+        PixelBox src = img.getPixelBox(0, mip);
+        const PixelBox& dst = target.mBoxes[mip];
+        for (size_t y = 0; y < src.getHeight(); ++y)
+        {
+            const uint32* srcRow = static_cast<const uint32*>(src.data) + y * src.rowPitch;
+            const uint32* dstRow = static_cast<const uint32*>(dst.data) + y * dst.rowPitch;
+            CPPUNIT_ASSERT(memcmp(srcRow, dstRow, src.getWidth() * 4) == 0);
+            // The padding is left alone
+            CPPUNIT_ASSERT_EQUAL((uint32)0xdeadbeef, dstRow[src.getWidth()]);
+        }
+    }
+}
+void DDSCodecTests::testDecodeToRefused()
+{
+    DataStreamPtr file = createFile();
+    PaddedTarget target(false);
+    ImageCodec* codec = static_cast<ImageCodec*>(Codec::getCodec("dds"));
+    CPPUNIT_ASSERT(!codec->decodeTo(file, target));
+    CPPUNIT_ASSERT(target.mBegun);
+    CPPUNIT_ASSERT(target.mBoxes.empty());
+
+    // The stream is rewound for decoding through an image
+    CPPUNIT_ASSERT_EQUAL((size_t)0, file->tell());
+    Image img;
+    img.load(file, "dds");
+    CPPUNIT_ASSERT_EQUAL((size_t)8, img.getWidth());
+}
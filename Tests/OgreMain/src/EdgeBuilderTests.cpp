@@ -288,3 +288,84 @@ void EdgeBuilderTests::testMultiIndexBufMultiVertexBuf()
 
 
 }
+
+void EdgeBuilderTests::testLargeUnweldedGrid()
+{
+    /* This tests welding and edge matching on a mesh big enough to be split
+    over several threads. Every quad of a flat grid has its own 4 vertices, so
+    all the connectivity has to come from welding equal positions.
+    */
+    const size_t quads = 160;
+    const size_t vertexCount = quads * quads * 4;
+    const size_t indexCount = quads * quads * 6;
+    VertexData vd;
+    IndexData id;
+    vd.vertexCount = vertexCount;
+    vd.vertexStart = 0;
+    vd.vertexDeclaration = HardwareBufferManager::getSingleton().createVertexDeclaration();
+    vd.vertexDeclaration->addElement(0, 0, VET_FLOAT3, VES_POSITION);
+    HardwareVertexBufferSharedPtr vbuf = HardwareBufferManager::getSingleton().createVertexBuffer(sizeof(float)*3, vertexCount, HardwareBuffer::HBU_STATIC,true);
+    vd.vertexBufferBinding->setBinding(0, vbuf);
+    id.indexBuffer = HardwareBufferManager::getSingleton().createIndexBuffer(
+        HardwareIndexBuffer::IT_32BIT, indexCount, HardwareBuffer::HBU_STATIC, true);
+    id.indexCount = indexCount;
+    id.indexStart = 0;
+
+    float* pFloat = static_cast<float*>(vbuf->lock(HardwareBuffer::HBL_DISCARD));
+    uint32* pIdx = static_cast<uint32*>(id.indexBuffer->lock(HardwareBuffer::HBL_DISCARD));
+    uint32 base = 0;
+    for (size_t y = 0; y < quads; ++y)
+    {
+        for (size_t x = 0; x < quads; ++x)
+        {
+            *pFloat++ = (float)x    ; *pFloat++ = (float)y    ; *pFloat++ = 0;
+            *pFloat++ = (float)x + 1; *pFloat++ = (float)y    ; *pFloat++ = 0;
+            *pFloat++ = (float)x + 1; *pFloat++ = (float)y + 1; *pFloat++ = 0;
+            *pFloat++ = (float)x    ; *pFloat++ = (float)y + 1; *pFloat++ = 0;
+            *pIdx++ = base; *pIdx++ = base + 1; *pIdx++ = base + 2;
+            *pIdx++ = base; *pIdx++ = base + 2; *pIdx++ = base + 3;
+            base += 4;
+        }
+    }
+    vbuf->unlock();
+    id.indexBuffer->unlock();
+
+    EdgeListBuilder edgeBuilder;
+    edgeBuilder.addVertexData(&vd);
+    edgeBuilder.addIndexData(&id);
+    EdgeData* edgeData = edgeBuilder.build();
+
+    CPPUNIT_ASSERT(edgeData->triangles.size() == quads * quads * 2);
+    CPPUNIT_ASSERT(edgeData->triangleFaceNormals.size() == edgeData->triangles.size());
+    // A grid is open along its border
+    CPPUNIT_ASSERT(!edgeData->isClosed);
+    const EdgeData::EdgeList& edges = edgeData->edgeGroups[0].edges;
+    CPPUNIT_ASSERT(edges.size() == quads * quads * 3 + quads * 2);
+
+    size_t degenerateCount = 0;
+    for (size_t e = 0; e < edges.size(); ++e)
+    {
+        const EdgeData::Edge& edge = edges[e];
+        // Edges are created in triangle order
+        if (e > 0)
+            CPPUNIT_ASSERT(edges[e - 1].triIndex[0] <= edge.triIndex[0]);
+        if (edge.degenerate)
+        {
+            ++degenerateCount;
+            continue;
+        }
+        // The second triangle runs the other way along the edge
+        const EdgeData::Triangle& tri = edgeData->triangles[edge.triIndex[1]];
+        bool found = false;
+        for (size_t side = 0; side < 3; ++side)
+        {
+            found = found ||
+                (tri.sharedVertIndex[side] == edge.sharedVertIndex[1] &&
+                tri.sharedVertIndex[(side + 1) % 3] == edge.sharedVertIndex[0]);
+        }
+        CPPUNIT_ASSERT(found);
+    }
+    CPPUNIT_ASSERT(degenerateCount == quads * 4);
+
+    delete edgeData;
+}
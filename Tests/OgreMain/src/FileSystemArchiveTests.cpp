@@ -241,6 +241,31 @@ void FileSystemArchiveTests::testFileRead()
     CPPUNIT_ASSERT(stream->eof());
 
 }
+void FileSystemArchiveTests::testMappedFileRead()
+{
+    FileSystemArchive arch(testPath, "FileSystem", true);
+    arch.load();
+
+    FileSystemArchive::setUseMemoryMapping(true);
+    DataStreamPtr stream = arch.open("rootfile.txt");
+    FileSystemArchive::setUseMemoryMapping(false);
+
+    // The whole file is available in place
+    const char* data = static_cast<const char*>(stream->peek(stream->size()));
+    CPPUNIT_ASSERT(data != 0);
+    CPPUNIT_ASSERT_EQUAL(String("this is line 1 in file 1"), String(data, 24));
+
+    CPPUNIT_ASSERT_EQUAL(String("this is line 1 in file 1"), stream->getLine());
+    CPPUNIT_ASSERT_EQUAL(String("this is line 2 in file 1"), stream->getLine());
+    stream->skipLine();
+    stream->skipLine();
+    CPPUNIT_ASSERT_EQUAL(String("this is line 5 in file 1"), stream->getLine());
+    CPPUNIT_ASSERT_EQUAL(StringUtil::BLANK, stream->getLine()); // blank at end of file
+    CPPUNIT_ASSERT(stream->eof());
+
+    stream->seek(0);
+    CPPUNIT_ASSERT_EQUAL(String("this is line 1 in file 1"), stream->getLine());
+}
 void FileSystemArchiveTests::testReadInterleave()
 {
     // Test overlapping reads from same archive
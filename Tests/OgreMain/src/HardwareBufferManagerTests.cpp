@@ -0,0 +1,146 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "HardwareBufferManagerTests.h"
+#include "OgreDefaultHardwareBufferManager.h"
+#include "OgreException.h"
+
+using namespace Ogre;
+
+// Register the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( HardwareBufferManagerTests );
+
+void HardwareBufferManagerTests::setUp()
+{
+    mBufMgr = OGRE_NEW DefaultHardwareBufferManager();
+}
+void HardwareBufferManagerTests::tearDown()
+{
+    OGRE_DELETE mBufMgr;
+}
+
+void HardwareBufferManagerTests::testStagingRing()
+{
+    mBufMgr->setUploadStagingSize(1024);
+
+    uchar* a = static_cast<uchar*>(mBufMgr->reserveUploadStaging(400));
+    uchar* b = static_cast<uchar*>(mBufMgr->reserveUploadStaging(400));
+    CPPUNIT_ASSERT(a && b);
+    CPPUNIT_ASSERT(b >= a + 400);
+    // Full, and too large whatever is free
+    CPPUNIT_ASSERT(!mBufMgr->reserveUploadStaging(400));
+    CPPUNIT_ASSERT(!mBufMgr->reserveUploadStaging(2048));
+    CPPUNIT_ASSERT_THROW(mBufMgr->setUploadStagingSize(2048), Exception);
+
+    // Nothing was queued before, so released memory is free again at once
+    // and the next reservation wraps around to the start
+    mBufMgr->releaseUploadStaging(a);
+    uchar* c = static_cast<uchar*>(mBufMgr->reserveUploadStaging(400));
+    CPPUNIT_ASSERT(c == a);
+    CPPUNIT_ASSERT_THROW(mBufMgr->releaseUploadStaging(a + 1), Exception);
+
+    mBufMgr->releaseUploadStaging(b);
+    mBufMgr->releaseUploadStaging(c);
+    mBufMgr->setUploadStagingSize(2048);
+}
+
+void HardwareBufferManagerTests::testQueuedUploads()
+{
+    HardwareVertexBufferSharedPtr vbuf = mBufMgr->createVertexBuffer(
+        sizeof(uint32), 64, HardwareBuffer::HBU_STATIC_WRITE_ONLY);
+    mBufMgr->setUploadStagingSize(1024);
+    mBufMgr->setUploadBytesPerFrame(128);
+
+    uint32* staging = static_cast<uint32*>(mBufMgr->reserveUploadStaging(256));
+    CPPUNIT_ASSERT(staging);
+    for (uint32 i = 0; i < 64; ++i)
+        staging[i] = i;
+    HardwareBufferManager::UploadTicket first = mBufMgr->queueUpload(vbuf, 0, 128, staging);
+    HardwareBufferManager::UploadTicket second = mBufMgr->queueUpload(vbuf, 128, 128, staging + 32);
+    mBufMgr->releaseUploadStaging(staging);
+    CPPUNIT_ASSERT_EQUAL((size_t)2, mBufMgr->getPendingUploadCount());
+
+    // Still in use by the queued uploads
+    CPPUNIT_ASSERT(!mBufMgr->reserveUploadStaging(1024));
+
+    // One frame's worth of bytes at a time
+    mBufMgr->_flushUploads();
+    CPPUNIT_ASSERT(mBufMgr->isUploadComplete(first));
+    CPPUNIT_ASSERT(!mBufMgr->isUploadComplete(second));
+    mBufMgr->_flushUploads();
+    CPPUNIT_ASSERT(mBufMgr->isUploadComplete(second));
+    CPPUNIT_ASSERT_EQUAL((size_t)0, mBufMgr->getPendingUploadCount());
+
+    uint32 result[64];
+    vbuf->readData(0, sizeof(result), result);
+    for (uint32 i = 0; i < 64; ++i)
+        CPPUNIT_ASSERT_EQUAL(i, result[i]);
+
+    // All of the staging memory is free again
+    void* whole = mBufMgr->reserveUploadStaging(1024);
+    CPPUNIT_ASSERT(whole);
+    mBufMgr->releaseUploadStaging(whole);
+}
+
+void HardwareBufferManagerTests::testCancelledUploads()
+{
+    HardwareVertexBufferSharedPtr kept = mBufMgr->createVertexBuffer(
+        sizeof(uint32), 16, HardwareBuffer::HBU_STATIC_WRITE_ONLY);
+    HardwareVertexBufferSharedPtr dropped = mBufMgr->createVertexBuffer(
+        sizeof(uint32), 16, HardwareBuffer::HBU_STATIC_WRITE_ONLY);
+    uint32 zeros[16] = { 0 };
+    dropped->writeData(0, sizeof(zeros), zeros);
+    mBufMgr->setUploadStagingSize(1024);
+
+    uint32* staging = static_cast<uint32*>(mBufMgr->reserveUploadStaging(sizeof(uint32) * 16));
+    CPPUNIT_ASSERT(staging);
+    for (uint32 i = 0; i < 16; ++i)
+        staging[i] = i + 1;
+    HardwareBufferManager::UploadTicket droppedTicket = mBufMgr->queueUpload(dropped, 0, 64, staging);
+    HardwareBufferManager::UploadTicket keptTicket = mBufMgr->queueUpload(kept, 0, 64, staging);
+    mBufMgr->releaseUploadStaging(staging);
+
+    // The queue lets go of the buffer, which can then be destroyed
+    mBufMgr->_cancelUploads(dropped.get());
+    CPPUNIT_ASSERT_EQUAL((unsigned int)1, dropped.useCount());
+
+    mBufMgr->_flushUploads();
+    CPPUNIT_ASSERT(mBufMgr->isUploadComplete(droppedTicket));
+    CPPUNIT_ASSERT(mBufMgr->isUploadComplete(keptTicket));
+
+    uint32 result[16];
+    dropped->readData(0, sizeof(result), result);
+    CPPUNIT_ASSERT(memcmp(result, zeros, sizeof(result)) == 0);
+    kept->readData(0, sizeof(result), result);
+    for (uint32 i = 0; i < 16; ++i)
+        CPPUNIT_ASSERT_EQUAL(i + 1, result[i]);
+
+    // The staging memory is reused once the queue has moved past the cancelled upload
+    void* whole = mBufMgr->reserveUploadStaging(1024);
+    CPPUNIT_ASSERT(whole);
+    mBufMgr->releaseUploadStaging(whole);
+}
@@ -0,0 +1,226 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "ImageMipmapTests.h"
+#include "OgreImage.h"
+#include "OgreException.h"
+#include <cstdlib>
+
+using namespace Ogre;
+
+// Register the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( ImageMipmapTests );
+
+void ImageMipmapTests::setUp()
+{
+}
+void ImageMipmapTests::tearDown()
+{
+}
+void ImageMipmapTests::testBoxFilter()
+{
+    uchar pixels[4 * 2 * 4] = {
+        0, 0, 0, 255,       255, 255, 255, 255, 10, 20, 30, 40, 10, 20, 30, 40,
+        255, 255, 255, 255, 0, 0, 0, 255,       10, 20, 30, 40, 10, 20, 30, 40 };
+    Image img;
+    img.loadDynamicImage(pixels, 4, 2, 1, PF_A8B8G8R8);
+    CPPUNIT_ASSERT(img.generateMipmaps(1));
+
+    // The caller's buffer is left alone, the image now owns a copy
+    CPPUNIT_ASSERT(img.getData() != pixels);
+    CPPUNIT_ASSERT_EQUAL((uchar)255, pixels[4]);
+
+    PixelBox mip = img.getPixelBox(0, 1);
+    CPPUNIT_ASSERT_EQUAL((size_t)2, mip.getWidth());
+    CPPUNIT_ASSERT_EQUAL((size_t)1, mip.getHeight());
+    const uchar* data = static_cast<const uchar*>(mip.data);
+    CPPUNIT_ASSERT_EQUAL(128, (int)data[0]);
+    CPPUNIT_ASSERT_EQUAL(128, (int)data[2]);
+    CPPUNIT_ASSERT_EQUAL(255, (int)data[3]);
+    CPPUNIT_ASSERT_EQUAL(10, (int)data[4]);
+    CPPUNIT_ASSERT_EQUAL(20, (int)data[5]);
+    CPPUNIT_ASSERT_EQUAL(30, (int)data[6]);
+    CPPUNIT_ASSERT_EQUAL(40, (int)data[7]);
+}
+void ImageMipmapTests::testChainSize()
+{
+    size_t size = PixelUtil::getMemorySize(64, 16, 1, PF_R8G8B8A8);
+    Image img;
+    img.loadDynamicImage(OGRE_ALLOC_T(uchar, size, MEMCATEGORY_GENERAL),
+        64, 16, 1, PF_R8G8B8A8, true);
+    memset(img.getData(), 0x40, size);
+    CPPUNIT_ASSERT(img.generateMipmaps(100));
+
+    // Asking for more than the full chain stops at 1x1
+    CPPUNIT_ASSERT_EQUAL((size_t)6, img.getNumMipmaps());
+    CPPUNIT_ASSERT_EQUAL((size_t)32, img.getPixelBox(0, 1).getWidth());
+    CPPUNIT_ASSERT_EQUAL((size_t)8, img.getPixelBox(0, 1).getHeight());
+    CPPUNIT_ASSERT_EQUAL((size_t)2, img.getPixelBox(0, 5).getWidth());
+    CPPUNIT_ASSERT_EQUAL((size_t)1, img.getPixelBox(0, 5).getHeight());
+    CPPUNIT_ASSERT_EQUAL((size_t)1, img.getPixelBox(0, 6).getWidth());
+    CPPUNIT_ASSERT_EQUAL(Image::calculateSize(6, 1, 64, 16, 1, PF_R8G8B8A8), img.getSize());
+    CPPUNIT_ASSERT_EQUAL(0x40, (int)*static_cast<uchar*>(img.getPixelBox(0, 6).data));
+}
+void ImageMipmapTests::testGammaCorrect()
+{
+    uchar pixels[2] = { 0, 255 };
+    Image linear;
+    linear.loadDynamicImage(pixels, 2, 1, 1, PF_L8);
+    linear.generateMipmaps(1);
+    CPPUNIT_ASSERT_EQUAL(128, (int)*static_cast<uchar*>(linear.getPixelBox(0, 1).data));
+
+    // Averaging in linear space gives a brighter result for sRGB data
+    Image srgb;
+    srgb.loadDynamicImage(pixels, 2, 1, 1, PF_L8);
+    srgb.generateMipmaps(1, Image::FILTER_BOX, true);
+    CPPUNIT_ASSERT_EQUAL(188, (int)*static_cast<uchar*>(srgb.getPixelBox(0, 1).data));
+}
+void ImageMipmapTests::testKaiserFilterKeepsFlatColour()
+{
+    size_t size = PixelUtil::getMemorySize(64, 64, 1, PF_R8G8B8A8);
+    Image img;
+    img.loadDynamicImage(OGRE_ALLOC_T(uchar, size, MEMCATEGORY_GENERAL),
+        64, 64, 1, PF_R8G8B8A8, true);
+    memset(img.getData(), 100, size);
+    CPPUNIT_ASSERT(img.generateMipmaps(100, Image::FILTER_KAISER));
+    CPPUNIT_ASSERT_EQUAL((size_t)6, img.getNumMipmaps());
+
+    for (size_t mip = 1; mip <= img.getNumMipmaps(); ++mip)
+    {
+        PixelBox box = img.getPixelBox(0, mip);
+        const uchar* data = static_cast<const uchar*>(box.data);
+        for (size_t i = 0; i < box.getConsecutiveSize(); ++i)
+            CPPUNIT_ASSERT_EQUAL(100, (int)data[i]);
+    }
+}
+void ImageMipmapTests::testVolume()
+{
+    uchar voxels[8] = { 0, 10, 20, 30, 40, 50, 60, 70 };
+    Image img;
+    img.loadDynamicImage(voxels, 2, 2, 2, PF_L8);
+    CPPUNIT_ASSERT(img.generateMipmaps(5));
+    CPPUNIT_ASSERT_EQUAL((size_t)1, img.getNumMipmaps());
+    CPPUNIT_ASSERT_EQUAL((size_t)1, img.getPixelBox(0, 1).getDepth());
+    CPPUNIT_ASSERT_EQUAL(35, (int)*static_cast<uchar*>(img.getPixelBox(0, 1).data));
+}
+void ImageMipmapTests::testCubeMap()
+{
+    uchar faces[6 * 4];
+    for (size_t face = 0; face < 6; ++face)
+        for (size_t i = 0; i < 4; ++i)
+            faces[face * 4 + i] = (uchar)(face * 40 + i * 2);
+    Image img;
+    img.loadDynamicImage(faces, 2, 2, 1, PF_L8, false, 6);
+    CPPUNIT_ASSERT(img.generateMipmaps(1));
+    CPPUNIT_ASSERT_EQUAL((size_t)6, img.getNumFaces());
+
+    // Each face is filtered on its own
+    for (size_t face = 0; face < 6; ++face)
+    {
+        CPPUNIT_ASSERT_EQUAL((int)(face * 40), (int)*static_cast<uchar*>(img.getPixelBox(face, 0).data));
+        CPPUNIT_ASSERT_EQUAL((int)(face * 40 + 3), (int)*static_cast<uchar*>(img.getPixelBox(face, 1).data));
+    }
+}
+void ImageMipmapTests::testCopyMipmapTail()
+{
+    uchar faces[6 * 16];
+    for (size_t i = 0; i < sizeof(faces); ++i)
+        faces[i] = (uchar)(i * 3);
+    Image img;
+    img.loadDynamicImage(faces, 4, 4, 1, PF_L8, false, 6);
+    CPPUNIT_ASSERT(img.generateMipmaps(2));
+
+    Image tail;
+    img.copyMipmapTail(1, tail);
+    CPPUNIT_ASSERT_EQUAL((size_t)2, tail.getWidth());
+    CPPUNIT_ASSERT_EQUAL((size_t)1, tail.getNumMipmaps());
+    CPPUNIT_ASSERT_EQUAL((size_t)6, tail.getNumFaces());
+    for (size_t face = 0; face < 6; ++face)
+    {
+        for (size_t mip = 0; mip <= 1; ++mip)
+        {
+            PixelBox src = img.getPixelBox(face, mip + 1);
+            PixelBox dst = tail.getPixelBox(face, mip);
+            CPPUNIT_ASSERT(memcmp(src.data, dst.data, src.getConsecutiveSize()) == 0);
+        }
+    }
+
+    CPPUNIT_ASSERT_THROW(img.copyMipmapTail(3, tail), Exception);
+}
+void ImageMipmapTests::testScaleHalves()
+{
+    const size_t width = 64, height = 32;
+    uchar pixels[width * height * 4];
+    for (size_t i = 0; i < sizeof(pixels); ++i)
+        pixels[i] = (uchar)((i * 37) ^ (i >> 5));
+    uchar halved[width / 2 * height / 2 * 4];
+    PixelBox src(width, height, 1, PF_A8B8G8R8, pixels);
+    PixelBox dst(width / 2, height / 2, 1, PF_A8B8G8R8, halved);
+    Image::scale(src, dst, Image::FILTER_BILINEAR);
+
+    // Bilinear halving is a 2x2 average
+    for (size_t y = 0; y < height / 2; ++y)
+    {
+        for (size_t x = 0; x < width / 2; ++x)
+        {
+            for (size_t k = 0; k < 4; ++k)
+            {
+                const uchar* p = pixels + ((2 * y) * width + 2 * x) * 4 + k;
+                const int expected = (p[0] + p[4] + p[width * 4] + p[width * 4 + 4] + 2) / 4;
+                const int actual = halved[(y * width / 2 + x) * 4 + k];
+                CPPUNIT_ASSERT(std::abs(expected - actual) <= 1);
+            }
+        }
+    }
+}
+void ImageMipmapTests::testScaleBands()
+{
+    // Big enough to be split into several bands of rows
+    const size_t width = 300, height = 200;
+    const size_t scaledWidth = 700, scaledHeight = 500;
+    vector<uchar>::type pixels(width * height * 3);
+    for (size_t i = 0; i < pixels.size(); ++i)
+        pixels[i] = (uchar)((i * 13) ^ (i >> 7));
+    PixelBox src(width, height, 1, PF_R8G8B8, &pixels[0]);
+
+    const Image::Filter filters[2] = { Image::FILTER_NEAREST, Image::FILTER_BILINEAR };
+    const PixelFormat formats[2] = { PF_R8G8B8, PF_FLOAT32_RGB };
+    for (size_t f = 0; f < 2; ++f)
+    {
+        for (size_t i = 0; i < 2; ++i)
+        {
+            const size_t size = PixelUtil::getMemorySize(scaledWidth, scaledHeight, 1, formats[i]);
+            vector<uchar>::type serial(size), banded(size);
+            PixelUtil::setBulkConversionThreads(1);
+            Image::scale(src, PixelBox(scaledWidth, scaledHeight, 1, formats[i], &serial[0]), filters[f]);
+            PixelUtil::setBulkConversionThreads(4);
+            Image::scale(src, PixelBox(scaledWidth, scaledHeight, 1, formats[i], &banded[0]), filters[f]);
+            PixelUtil::setBulkConversionThreads(0);
+            CPPUNIT_ASSERT(serial == banded);
+        }
+    }
+}
@@ -0,0 +1,250 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "MeshLodStreamingTests.h"
+#include "OgreMeshManager.h"
+#include "OgreSubMesh.h"
+#include "OgreEntity.h"
+#include "OgreSceneManager.h"
+#include "OgreMaterialManager.h"
+#include "OgreResourceBackgroundQueue.h"
+#include "OgreDefaultHardwareBufferManager.h"
+#include "OgreLogManager.h"
+#include "OgreWorkQueue.h"
+#include "OgreMeshSerializer.h"
+
+// Register the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( MeshLodStreamingTests );
+
+namespace
+{
+    /// Builds a single submesh of 100 positions
+    class PointsLoader : public ManualResourceLoader
+    {
+    public:
+        void loadResource(Resource* resource)
+        {
+            Mesh* mesh = static_cast<Mesh*>(resource);
+            SubMesh* sub = mesh->createSubMesh();
+            sub->useSharedVertices = false;
+            sub->operationType = RenderOperation::OT_POINT_LIST;
+            sub->vertexData = OGRE_NEW VertexData();
+            sub->vertexData->vertexCount = 100;
+            sub->vertexData->vertexDeclaration->addElement(0, 0, VET_FLOAT3, VES_POSITION);
+            HardwareVertexBufferSharedPtr vbuf = HardwareBufferManager::getSingleton().createVertexBuffer(
+                sizeof(float) * 3, 100, HardwareBuffer::HBU_STATIC_WRITE_ONLY);
+            sub->vertexData->vertexBufferBinding->setBinding(0, vbuf);
+            mesh->_setBounds(AxisAlignedBox(-1, -1, -1, 1, 1, 1));
+        }
+    };
+}
+//--------------------------------------------------------------------------
+void MeshLodStreamingTests::setUp()
+{
+    if(LogManager::getSingletonPtr() == 0)
+    {
+        LogManager* logManager = OGRE_NEW LogManager();
+        logManager->createLog("MeshLodStreamingTests.log", true, false);
+    }
+    LogManager::getSingleton().setLogDetail(LL_LOW);
+
+    mRoot = OGRE_NEW Root("");
+    mBufMgr = OGRE_NEW DefaultHardwareBufferManager();
+    // Usually done by Root::initialise with the first render window
+    mRoot->getWorkQueue()->startup();
+    ResourceBackgroundQueue::getSingleton().initialise();
+    MaterialManager::getSingleton().initialise();
+
+    mLoader = OGRE_NEW PointsLoader();
+    MeshManager& meshMgr = MeshManager::getSingleton();
+    mMesh = meshMgr.createManual("Streamed.mesh", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME, mLoader);
+    for (int i = 1; i <= 3; ++i)
+    {
+        String lodName = "Streamed" + StringConverter::toString(i) + ".mesh";
+        meshMgr.createManual(lodName, ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME, mLoader);
+        mMesh->createManualLodLevel(Real(100 * i), lodName);
+    }
+    mMesh->setLodStreaming(true);
+    mMesh->load();
+}
+//--------------------------------------------------------------------------
+void MeshLodStreamingTests::tearDown()
+{
+    mMesh.setNull();
+    ResourceBackgroundQueue::getSingleton().shutdown();
+    mRoot->getWorkQueue()->shutdown();
+    OGRE_DELETE mRoot;
+    OGRE_DELETE mBufMgr;
+    OGRE_DELETE mLoader;
+}
+//--------------------------------------------------------------------------
+void MeshLodStreamingTests::renderFrame()
+{
+    mRoot->_fireFrameStarted();
+    mRoot->_fireFrameRenderingQueued();
+    mRoot->_fireFrameEnded();
+}
+//--------------------------------------------------------------------------
+bool MeshLodStreamingTests::streamLodLevel(const MeshPtr& mesh, ushort index)
+{
+    for (int i = 0; i < 1000; ++i)
+    {
+        if (mesh->_requestLodLevel(index) == index)
+            return true;
+        renderFrame();
+        OGRE_THREAD_SLEEP(1);
+    }
+    return false;
+}
+//--------------------------------------------------------------------------
+void MeshLodStreamingTests::testEvictOnlyStreamedMeshes()
+{
+    // Loaded by the application, streaming leaves it alone
+    MeshPtr preloaded = MeshManager::getSingleton().getByName("Streamed1.mesh");
+    preloaded->load();
+    CPPUNIT_ASSERT(preloaded == mMesh->getLodLevel(1).manualMesh);
+    MeshPtr streamed = mMesh->getLodLevel(2).manualMesh;
+    CPPUNIT_ASSERT(!streamed->isLoaded());
+
+    CPPUNIT_ASSERT(streamLodLevel(mMesh, 1));
+    CPPUNIT_ASSERT(streamLodLevel(mMesh, 2));
+    CPPUNIT_ASSERT_EQUAL(streamed->getSize(), MeshManager::getSingleton().getLodStreamingMemoryUsage());
+
+    // Still displayed, so kept until it wasn't needed for a frame
+    MeshManager::getSingleton().setLodStreamingBudget(0);
+    CPPUNIT_ASSERT(streamed->isLoaded());
+    renderFrame();
+    renderFrame();
+    CPPUNIT_ASSERT(!streamed->isLoaded());
+    CPPUNIT_ASSERT(preloaded->isLoaded());
+    CPPUNIT_ASSERT_EQUAL((size_t)0, MeshManager::getSingleton().getLodStreamingMemoryUsage());
+
+    // The nearest coarser level in memory is displayed until it's streamed in
+    // again, without thread support it's loaded right away
+#if OGRE_THREAD_SUPPORT
+    CPPUNIT_ASSERT_EQUAL((ushort)3, mMesh->_requestLodLevel(2));
+#endif
+    CPPUNIT_ASSERT(streamLodLevel(mMesh, 2));
+}
+//--------------------------------------------------------------------------
+void MeshLodStreamingTests::testDeinitialiseLodEntities()
+{
+    SceneManager* sceneMgr = mRoot->createSceneManager(ST_GENERIC);
+    Entity* ent = sceneMgr->createEntity(mMesh);
+    CPPUNIT_ASSERT_EQUAL((size_t)3, ent->getNumManualLodLevels());
+    Entity* lodEnt = ent->getManualLodLevel(1);
+    CPPUNIT_ASSERT(!lodEnt->isInitialised());
+
+    // As done by the parent entity when the level is displayed
+    CPPUNIT_ASSERT(streamLodLevel(mMesh, 2));
+    lodEnt->_initialise(true);
+    CPPUNIT_ASSERT(lodEnt->isInitialised());
+    CPPUNIT_ASSERT_EQUAL((size_t)1, lodEnt->getNumSubEntities());
+
+    // The entity lets go of the submeshes before they are unloaded
+    MeshManager::getSingleton().setLodStreamingBudget(0);
+    renderFrame();
+    renderFrame();
+    CPPUNIT_ASSERT(!lodEnt->getMesh()->isLoaded());
+    CPPUNIT_ASSERT(!lodEnt->isInitialised());
+
+    // Destroying it unregisters its LOD entities
+    sceneMgr->destroyEntity(ent);
+    mRoot->destroySceneManager(sceneMgr);
+    renderFrame();
+}
+//--------------------------------------------------------------------------
+void MeshLodStreamingTests::testStreamFullDetail()
+{
+    // Only the coarsest level is loaded up front, the mesh's own geometry isn't
+    SubMesh* sub = mMesh->getSubMesh(0);
+    CPPUNIT_ASSERT(mMesh->isFullDetailStreamed());
+    CPPUNIT_ASSERT(!mMesh->isLodLevelResident(0));
+    CPPUNIT_ASSERT_EQUAL((size_t)0, sub->vertexData->vertexCount);
+#if OGRE_THREAD_SUPPORT
+    CPPUNIT_ASSERT_EQUAL((ushort)3, mMesh->_requestLodLevel(0));
+#endif
+    CPPUNIT_ASSERT(mMesh->isLodLevelResident(3));
+
+    CPPUNIT_ASSERT(streamLodLevel(mMesh, 0));
+    CPPUNIT_ASSERT_EQUAL((size_t)100, sub->vertexData->vertexCount);
+    CPPUNIT_ASSERT(mMesh->_getFullDetailSize() > 0);
+    CPPUNIT_ASSERT_EQUAL(mMesh->_getFullDetailSize(), MeshManager::getSingleton().getLodStreamingMemoryUsage());
+
+    // Streamed out like the finer levels, while the coarsest level stays
+    MeshManager::getSingleton().setLodStreamingBudget(0);
+    renderFrame();
+    renderFrame();
+    CPPUNIT_ASSERT(!mMesh->isLodLevelResident(0));
+    CPPUNIT_ASSERT_EQUAL((size_t)0, sub->vertexData->vertexCount);
+    CPPUNIT_ASSERT(mMesh->isLodLevelResident(3));
+    CPPUNIT_ASSERT_EQUAL((size_t)0, MeshManager::getSingleton().getLodStreamingMemoryUsage());
+
+    // Entities are built without it, and again once it's back
+    SceneManager* sceneMgr = mRoot->createSceneManager(ST_GENERIC);
+    Entity* ent = sceneMgr->createEntity(mMesh);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, ent->getNumSubEntities());
+    CPPUNIT_ASSERT(streamLodLevel(mMesh, 0));
+    CPPUNIT_ASSERT_EQUAL((size_t)100, sub->vertexData->vertexCount);
+    sceneMgr->destroyEntity(ent);
+    mRoot->destroySceneManager(sceneMgr);
+
+    // Without streaming it's loaded again and kept
+    renderFrame();
+    renderFrame();
+    CPPUNIT_ASSERT(!mMesh->isLodLevelResident(0));
+    mMesh->setLodStreaming(false);
+    CPPUNIT_ASSERT(mMesh->isLodLevelResident(0));
+    CPPUNIT_ASSERT_EQUAL((size_t)100, mMesh->getSubMesh(0)->vertexData->vertexCount);
+}
+//--------------------------------------------------------------------------
+void MeshLodStreamingTests::testStreamFullDetailFromFile()
+{
+    // Loaded and streamed from a file, with the LOD levels it refers to
+    CPPUNIT_ASSERT(streamLodLevel(mMesh, 0));
+    String fileName = "StreamedFile.mesh";
+    MeshSerializer serializer;
+    serializer.exportMesh(mMesh.get(), fileName);
+    ResourceGroupManager::getSingleton().addResourceLocation(".", "FileSystem");
+
+    MeshPtr fileMesh = MeshManager::getSingleton().createOrRetrieve(fileName,
+        ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME).first;
+    fileMesh->setLodStreaming(true);
+    fileMesh->load();
+    CPPUNIT_ASSERT_EQUAL((ushort)4, fileMesh->getNumLodLevels());
+    CPPUNIT_ASSERT(fileMesh->isFullDetailStreamed());
+    CPPUNIT_ASSERT(!fileMesh->isLodLevelResident(0));
+
+    CPPUNIT_ASSERT(streamLodLevel(fileMesh, 0));
+    remove(fileName.c_str());
+    CPPUNIT_ASSERT_EQUAL((size_t)100, fileMesh->getSubMesh(0)->vertexData->vertexCount);
+    CPPUNIT_ASSERT(fileMesh->getSubMesh(0)->vertexData->vertexBufferBinding->getBufferCount() == 1);
+
+    // The mesh it was streamed through goes along with it
+    MeshManager::getSingleton().remove(fileName);
+    CPPUNIT_ASSERT(MeshManager::getSingleton().getByName(fileName + "/FullDetail").isNull());
+}
@@ -496,3 +496,573 @@ void MeshWithoutIndexDataTests::testGenerateLodLevels()
 
     mMeshMgr->remove( fileName );
 }
+
+void MeshWithoutIndexDataTests::testBuildClusters()
+{
+    const size_t GRID_SIZE = 16;
+    const size_t MAX_TRIANGLES = 32;
+    ManualObject* grid = OGRE_NEW ManualObject("grid");
+    grid->begin("BaseWhiteNoLighting", RenderOperation::OT_TRIANGLE_LIST);
+    for (size_t y = 0; y <= GRID_SIZE; ++y)
+    {
+        for (size_t x = 0; x <= GRID_SIZE; ++x)
+            grid->position(Real(x), Real(y), 0);
+    }
+    for (size_t y = 0; y < GRID_SIZE; ++y)
+    {
+        for (size_t x = 0; x < GRID_SIZE; ++x)
+        {
+            uint32 corner = static_cast<uint32>(y * (GRID_SIZE + 1) + x);
+            grid->quad(corner, corner + 1, corner + GRID_SIZE + 2, corner + GRID_SIZE + 1);
+        }
+    }
+    grid->end();
+    String fileName = "testBuildClusters.mesh";
+    MeshPtr gridMesh = grid->convertToMesh(fileName);
+    OGRE_DELETE grid;
+
+    SubMesh* subMesh = gridMesh->getSubMesh(0);
+    subMesh->buildClusters(MAX_TRIANGLES);
+    const SubMesh::TriangleClusterList& clusters = subMesh->getClusters();
+    CPPUNIT_ASSERT(clusters.size() >= GRID_SIZE * GRID_SIZE * 2 / MAX_TRIANGLES);
+
+    // Clusters follow each other through the whole index buffer
+    HardwareIndexBufferSharedPtr ibuf = subMesh->indexData->indexBuffer;
+    const uint16* indexes = static_cast<const uint16*>(ibuf->lock(HardwareBuffer::HBL_READ_ONLY));
+    uint32 nextIndex = 0;
+    for (SubMesh::TriangleClusterList::const_iterator c = clusters.begin(); c != clusters.end(); ++c)
+    {
+        CPPUNIT_ASSERT_EQUAL(nextIndex, c->indexStart);
+        CPPUNIT_ASSERT(c->indexCount > 0 && c->indexCount <= MAX_TRIANGLES * 3);
+        nextIndex += c->indexCount;
+
+        // The sphere holds every vertex and the flat grid faces +Z
+        for (uint32 i = c->indexStart; i < c->indexStart + c->indexCount; ++i)
+        {
+            Vector3 pos(Real(indexes[i] % (GRID_SIZE + 1)), Real(indexes[i] / (GRID_SIZE + 1)), 0);
+            CPPUNIT_ASSERT(pos.distance(c->center) <= c->radius + 1e-3f);
+        }
+        CPPUNIT_ASSERT(c->coneAxis.positionEquals(Vector3::UNIT_Z));
+        CPPUNIT_ASSERT(c->coneCutoff < 1e-3f);
+    }
+    ibuf->unlock();
+    CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(subMesh->indexData->indexCount), nextIndex);
+
+    MeshSerializer meshWriter;
+    meshWriter.exportMesh(gridMesh.get(), fileName);
+    mMeshMgr->remove( fileName );
+
+    ResourceGroupManager::getSingleton().addResourceLocation(".", "FileSystem");
+    MeshPtr loadedGrid = mMeshMgr->load(fileName, "General");
+    remove(fileName.c_str());
+
+    const SubMesh::TriangleClusterList& loadedClusters = loadedGrid->getSubMesh(0)->getClusters();
+    CPPUNIT_ASSERT_EQUAL(clusters.size(), loadedClusters.size());
+    CPPUNIT_ASSERT_EQUAL(clusters.back().indexStart, loadedClusters.back().indexStart);
+    CPPUNIT_ASSERT(clusters.back().center.positionEquals(loadedClusters.back().center));
+    mMeshMgr->remove( fileName );
+
+    // Versions before 1.10 leave the clusters out
+    meshWriter.exportMesh(gridMesh.get(), fileName, MESH_VERSION_1_8);
+    MeshPtr oldGrid = mMeshMgr->load(fileName, "General");
+    remove(fileName.c_str());
+    CPPUNIT_ASSERT(oldGrid->getSubMesh(0)->getClusters().empty());
+    CPPUNIT_ASSERT_EQUAL(subMesh->indexData->indexCount, oldGrid->getSubMesh(0)->indexData->indexCount);
+
+    mMeshMgr->remove( fileName );
+}
+void MeshWithoutIndexDataTests::testEdgeListLodLevels()
+{
+    const size_t GRID_SIZE = 8;
+    ManualObject* grid = OGRE_NEW ManualObject("grid");
+    grid->begin("BaseWhiteNoLighting", RenderOperation::OT_TRIANGLE_LIST);
+    for (size_t y = 0; y <= GRID_SIZE; ++y)
+    {
+        for (size_t x = 0; x <= GRID_SIZE; ++x)
+            grid->position(Real(x), Real(y), Real((x * y) % 3));
+    }
+    for (size_t y = 0; y < GRID_SIZE; ++y)
+    {
+        for (size_t x = 0; x < GRID_SIZE; ++x)
+        {
+            uint32 corner = static_cast<uint32>(y * (GRID_SIZE + 1) + x);
+            grid->quad(corner, corner + 1, corner + GRID_SIZE + 2, corner + GRID_SIZE + 1);
+        }
+    }
+    grid->end();
+    String fileName = "testEdgeListLodLevels.mesh";
+    MeshPtr gridMesh = grid->convertToMesh(fileName);
+    OGRE_DELETE grid;
+
+    // Several generated levels, whose edge lists are read concurrently
+    LodConfig lodConfig;
+    lodConfig.mesh = gridMesh;
+    lodConfig.strategy = DistanceLodStrategy::getSingletonPtr();
+    LodLevel lodLevel;
+    lodLevel.reductionMethod = LodLevel::VRM_PROPORTIONAL;
+    for (int i = 1; i <= 3; ++i)
+    {
+        lodLevel.distance = Real(i * 100);
+        lodLevel.reductionValue = Real(i) * 0.2f;
+        lodConfig.levels.push_back(lodLevel);
+    }
+    ProgressiveMeshGenerator pm;
+    pm.generateLodLevels(lodConfig);
+    CPPUNIT_ASSERT_EQUAL((ushort)4, gridMesh->getNumLodLevels());
+    gridMesh->buildEdgeList();
+
+    MeshSerializer meshWriter;
+    meshWriter.exportMesh(gridMesh.get(), fileName);
+    mMeshMgr->remove( fileName );
+
+    ResourceGroupManager::getSingleton().addResourceLocation(".", "FileSystem");
+    MeshPtr loadedGrid = mMeshMgr->load(fileName, "General");
+    remove(fileName.c_str());
+
+    CPPUNIT_ASSERT_EQUAL(gridMesh->getNumLodLevels(), loadedGrid->getNumLodLevels());
+    for (ushort lod = 0; lod < gridMesh->getNumLodLevels(); ++lod)
+    {
+        const EdgeData* edges = gridMesh->getEdgeList(lod);
+        const EdgeData* loadedEdges = loadedGrid->getEdgeList(lod);
+        CPPUNIT_ASSERT(loadedEdges);
+        CPPUNIT_ASSERT_EQUAL(edges->triangles.size(), loadedEdges->triangles.size());
+        for (size_t t = 0; t < edges->triangles.size(); ++t)
+        {
+            for (int v = 0; v < 3; ++v)
+                CPPUNIT_ASSERT_EQUAL(edges->triangles[t].vertIndex[v], loadedEdges->triangles[t].vertIndex[v]);
+        }
+        CPPUNIT_ASSERT_EQUAL(edges->edgeGroups.size(), loadedEdges->edgeGroups.size());
+        for (size_t g = 0; g < edges->edgeGroups.size(); ++g)
+        {
+            const EdgeData::EdgeList& edgeList = edges->edgeGroups[g].edges;
+            const EdgeData::EdgeList& loadedEdgeList = loadedEdges->edgeGroups[g].edges;
+            CPPUNIT_ASSERT_EQUAL(edgeList.size(), loadedEdgeList.size());
+            for (size_t e = 0; e < edgeList.size(); ++e)
+            {
+                CPPUNIT_ASSERT_EQUAL(edgeList[e].triIndex[0], loadedEdgeList[e].triIndex[0]);
+                CPPUNIT_ASSERT_EQUAL(edgeList[e].degenerate, loadedEdgeList[e].degenerate);
+                // Unpaired edges have no partner, stored as a 32 bit index
+                if (!edgeList[e].degenerate)
+                    CPPUNIT_ASSERT_EQUAL(edgeList[e].triIndex[1], loadedEdgeList[e].triIndex[1]);
+            }
+            CPPUNIT_ASSERT(loadedEdges->edgeGroups[g].vertexData == loadedGrid->getSubMesh(0)->vertexData);
+        }
+    }
+
+    mMeshMgr->remove( fileName );
+}
+/// GPU program manager for tests, only null high level programs exist without a render system
+class TestGpuProgram : public GpuProgram
+{
+public:
+    TestGpuProgram(ResourceManager* creator, const String& name, ResourceHandle handle,
+        const String& group, bool isManual, ManualResourceLoader* loader)
+        : GpuProgram(creator, name, handle, group, isManual, loader)
+    {
+    }
+protected:
+    void loadFromSource(void) {}
+    void unloadImpl(void) {}
+};
+
+class TestGpuProgramManager : public GpuProgramManager
+{
+protected:
+    Resource* createImpl(const String& name, ResourceHandle handle,
+        const String& group, bool isManual, ManualResourceLoader* loader,
+        const NameValuePairList* createParams)
+    {
+        return OGRE_NEW TestGpuProgram(this, name, handle, group, isManual, loader);
+    }
+    Resource* createImpl(const String& name, ResourceHandle handle,
+        const String& group, bool isManual, ManualResourceLoader* loader,
+        GpuProgramType gptype, const String& syntaxCode)
+    {
+        return OGRE_NEW TestGpuProgram(this, name, handle, group, isManual, loader);
+    }
+};
+
+MeshPtr MeshWithoutIndexDataTests::createQuantiseGrid(const String& fileName, const String& materialName)
+{
+    const size_t GRID_SIZE = 4;
+    ManualObject* grid = OGRE_NEW ManualObject("grid");
+    grid->begin(materialName, RenderOperation::OT_TRIANGLE_LIST);
+    for (size_t y = 0; y <= GRID_SIZE; ++y)
+    {
+        for (size_t x = 0; x <= GRID_SIZE; ++x)
+        {
+            grid->position(Real(x), Real(y), Real(x * y) * 0.1f);
+            grid->normal(0, 0, 1);
+            grid->tangent(1, 0, 0);
+            grid->textureCoord(Real(x) / GRID_SIZE, Real(y) / GRID_SIZE);
+        }
+    }
+    for (size_t y = 0; y < GRID_SIZE; ++y)
+    {
+        for (size_t x = 0; x < GRID_SIZE; ++x)
+        {
+            uint32 corner = static_cast<uint32>(y * (GRID_SIZE + 1) + x);
+            grid->quad(corner, corner + 1, corner + GRID_SIZE + 2, corner + GRID_SIZE + 1);
+        }
+    }
+    grid->end();
+    MeshPtr gridMesh = grid->convertToMesh(fileName);
+    OGRE_DELETE grid;
+    return gridMesh;
+}
+void MeshWithoutIndexDataTests::testQuantiseVertexData()
+{
+    const size_t GRID_SIZE = 4;
+
+    // Without a vertex program applying scale and bias, positions have to stay float
+    MeshPtr plainMesh = createQuantiseGrid("testQuantisePlain.mesh", "BaseWhiteNoLighting");
+    CPPUNIT_ASSERT(plainMesh->quantiseVertexData());
+    const VertexDeclaration* plainDecl = plainMesh->getSubMesh(0)->vertexData->vertexDeclaration;
+    CPPUNIT_ASSERT_EQUAL(VET_FLOAT3, plainDecl->findElementBySemantic(VES_POSITION)->getType());
+    CPPUNIT_ASSERT_EQUAL(VET_SHORT4_SNORM, plainDecl->findElementBySemantic(VES_NORMAL)->getType());
+    mMeshMgr->remove("testQuantisePlain.mesh");
+
+    // A material binding both custom parameters in its vertex program
+    TestGpuProgramManager* gpuProgramMgr = OGRE_NEW TestGpuProgramManager();
+    HighLevelGpuProgramManager* highLevelMgr = OGRE_NEW HighLevelGpuProgramManager();
+    gpuProgramMgr->createProgramFromString("DequantiseVP", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME,
+        "", GPT_VERTEX_PROGRAM, "vs_1_1");
+    MaterialPtr material = MaterialManager::getSingleton().create("Dequantise",
+        ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    Pass* pass = material->getTechnique(0)->getPass(0);
+    pass->setVertexProgram("DequantiseVP");
+    pass->getVertexProgramParameters()->setAutoConstant(0, GpuProgramParameters::ACT_CUSTOM,
+        SubEntity::CUSTOM_PARAM_POSITION_SCALE);
+    pass->getVertexProgramParameters()->setAutoConstant(1, GpuProgramParameters::ACT_CUSTOM,
+        SubEntity::CUSTOM_PARAM_POSITION_BIAS);
+
+    String fileName = "testQuantiseVertexData.mesh";
+    MeshPtr gridMesh = createQuantiseGrid(fileName, "Dequantise");
+    CPPUNIT_ASSERT(gridMesh->quantiseVertexData());
+    const VertexData* vertexData = gridMesh->getSubMesh(0)->vertexData;
+    const VertexDeclaration* decl = vertexData->vertexDeclaration;
+    const VertexElement* posElem = decl->findElementBySemantic(VES_POSITION);
+    const VertexElement* tanElem = decl->findElementBySemantic(VES_TANGENT);
+    const VertexElement* uvElem = decl->findElementBySemantic(VES_TEXTURE_COORDINATES);
+    CPPUNIT_ASSERT_EQUAL(VET_SHORT4_SNORM, posElem->getType());
+    CPPUNIT_ASSERT_EQUAL(VET_SHORT4_SNORM, decl->findElementBySemantic(VES_NORMAL)->getType());
+    CPPUNIT_ASSERT_EQUAL(VET_SHORT4_SNORM, tanElem->getType());
+    CPPUNIT_ASSERT_EQUAL(VET_HALF2, uvElem->getType());
+
+    // Scale and bias give the positions back, three component tangents get a parity of 1
+    HardwareVertexBufferSharedPtr vbuf = vertexData->vertexBufferBinding->getBuffer(posElem->getSource());
+    const uchar* pVertex = static_cast<const uchar*>(vbuf->lock(HardwareBuffer::HBL_READ_ONLY));
+    for (size_t v = 0; v < vertexData->vertexCount; ++v, pVertex += vbuf->getVertexSize())
+    {
+        const int16* pPos = reinterpret_cast<const int16*>(pVertex + posElem->getOffset());
+        const size_t x = v % (GRID_SIZE + 1);
+        const size_t y = v / (GRID_SIZE + 1);
+        const Vector3 original(Real(x), Real(y), Real(x * y) * 0.1f);
+        for (size_t i = 0; i < 3; ++i)
+        {
+            Real decoded = Real(pPos[i]) / 32767 * vertexData->positionScale[i] + vertexData->positionBias[i];
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(original[i], decoded, vertexData->positionScale[i] / 32767);
+        }
+
+        const int16* pTangent = reinterpret_cast<const int16*>(pVertex + tanElem->getOffset());
+        CPPUNIT_ASSERT_EQUAL((int16)32767, pTangent[0]);
+        CPPUNIT_ASSERT_EQUAL((int16)32767, pTangent[3]);
+    }
+    vbuf->unlock();
+
+    // The quantised layout and transform survive a round trip through the latest version
+    MeshSerializer meshWriter;
+    meshWriter.exportMesh(gridMesh.get(), fileName);
+    mMeshMgr->remove( fileName );
+    ResourceGroupManager::getSingleton().addResourceLocation(".", "FileSystem");
+    MeshPtr loadedGrid = mMeshMgr->load(fileName, "General");
+    remove(fileName.c_str());
+
+    const VertexData* loadedData = loadedGrid->getSubMesh(0)->vertexData;
+    CPPUNIT_ASSERT(vertexData->positionScale == loadedData->positionScale);
+    CPPUNIT_ASSERT(vertexData->positionBias == loadedData->positionBias);
+    CPPUNIT_ASSERT_EQUAL(decl->getElementCount(), loadedData->vertexDeclaration->getElementCount());
+    for (unsigned short i = 0; i < decl->getElementCount(); ++i)
+        CPPUNIT_ASSERT(*decl->getElement(i) == *loadedData->vertexDeclaration->getElement(i));
+    HardwareVertexBufferSharedPtr loadedBuf = loadedData->vertexBufferBinding->getBuffer(posElem->getSource());
+    CPPUNIT_ASSERT_EQUAL(vbuf->getSizeInBytes(), loadedBuf->getSizeInBytes());
+    const void* pData = vbuf->lock(HardwareBuffer::HBL_READ_ONLY);
+    const void* pLoadedData = loadedBuf->lock(HardwareBuffer::HBL_READ_ONLY);
+    CPPUNIT_ASSERT(memcmp(pData, pLoadedData, vbuf->getSizeInBytes()) == 0);
+    loadedBuf->unlock();
+    vbuf->unlock();
+
+    // Versions before 1.10 do not know the formats
+    String oldFileName = "testQuantiseVertexData_v1_8.mesh";
+    CPPUNIT_ASSERT_THROW(meshWriter.exportMesh(gridMesh.get(), oldFileName, MESH_VERSION_1_8), Exception);
+    remove(oldFileName.c_str());
+
+    mMeshMgr->remove( fileName );
+    material.setNull();
+    MaterialManager::getSingleton().remove("Dequantise");
+    OGRE_DELETE highLevelMgr;
+    OGRE_DELETE gpuProgramMgr;
+}
+void MeshWithoutIndexDataTests::testQuantisedPositionConsumers()
+{
+    // Edge lists, Lod generation and tangents read quantised positions like float ones
+    MeshPtr floatMesh = createQuantiseGrid("testConsumersFloat.mesh", "BaseWhiteNoLighting");
+    MeshPtr quantisedMesh = createQuantiseGrid("testConsumersQuantised.mesh", "BaseWhiteNoLighting");
+    VertexData* quantisedData = quantisedMesh->getSubMesh(0)->vertexData;
+    CPPUNIT_ASSERT(quantisedData->quantise(true, false, false));
+    CPPUNIT_ASSERT_EQUAL(VET_SHORT4_SNORM,
+        quantisedData->vertexDeclaration->findElementBySemantic(VES_POSITION)->getType());
+
+    floatMesh->buildEdgeList();
+    quantisedMesh->buildEdgeList();
+    const EdgeData* floatEdges = floatMesh->getEdgeList();
+    const EdgeData* quantisedEdges = quantisedMesh->getEdgeList();
+    CPPUNIT_ASSERT_EQUAL(floatEdges->triangles.size(), quantisedEdges->triangles.size());
+    CPPUNIT_ASSERT_EQUAL(floatEdges->edgeGroups[0].edges.size(), quantisedEdges->edgeGroups[0].edges.size());
+    CPPUNIT_ASSERT_EQUAL(floatEdges->isClosed, quantisedEdges->isClosed);
+    for (size_t t = 0; t < floatEdges->triangles.size(); ++t)
+    {
+        const Vector4& a = floatEdges->triangleFaceNormals[t];
+        const Vector4& b = quantisedEdges->triangleFaceNormals[t];
+        for (size_t i = 0; i < 4; ++i)
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(a[i], b[i], 0.01f);
+    }
+
+    floatMesh->buildTangentVectors();
+    quantisedMesh->buildTangentVectors();
+    const VertexData* floatData = floatMesh->getSubMesh(0)->vertexData;
+    const VertexElement* floatTangent = floatData->vertexDeclaration->findElementBySemantic(VES_TANGENT);
+    const VertexElement* quantisedTangent = quantisedData->vertexDeclaration->findElementBySemantic(VES_TANGENT);
+    HardwareVertexBufferSharedPtr floatBuf = floatData->vertexBufferBinding->getBuffer(floatTangent->getSource());
+    HardwareVertexBufferSharedPtr quantisedBuf = quantisedData->vertexBufferBinding->getBuffer(quantisedTangent->getSource());
+    uchar* pFloatVertex = static_cast<uchar*>(floatBuf->lock(HardwareBuffer::HBL_READ_ONLY));
+    uchar* pQuantisedVertex = static_cast<uchar*>(quantisedBuf->lock(HardwareBuffer::HBL_READ_ONLY));
+    for (size_t v = 0; v < floatData->vertexCount; ++v)
+    {
+        float *pA, *pB;
+        floatTangent->baseVertexPointerToElement(pFloatVertex + v * floatBuf->getVertexSize(), &pA);
+        quantisedTangent->baseVertexPointerToElement(pQuantisedVertex + v * quantisedBuf->getVertexSize(), &pB);
+        for (size_t i = 0; i < 3; ++i)
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(pA[i], pB[i], 0.01f);
+    }
+    quantisedBuf->unlock();
+    floatBuf->unlock();
+
+    LodConfig lodConfig;
+    lodConfig.mesh = quantisedMesh;
+    lodConfig.strategy = DistanceLodStrategy::getSingletonPtr();
+    LodLevel lodLevel;
+    lodLevel.reductionMethod = LodLevel::VRM_PROPORTIONAL;
+    lodLevel.distance = 600.0;
+    lodLevel.reductionValue = 0.5f;
+    lodConfig.levels.push_back(lodLevel);
+    ProgressiveMeshGenerator quantisedPm;
+    quantisedPm.generateLodLevels(lodConfig);
+    lodConfig.mesh = floatMesh;
+    ProgressiveMeshGenerator floatPm;
+    floatPm.generateLodLevels(lodConfig);
+    CPPUNIT_ASSERT_EQUAL((ushort)2, quantisedMesh->getNumLodLevels());
+    CPPUNIT_ASSERT_EQUAL(floatMesh->getSubMesh(0)->mLodFaceList[0]->indexCount,
+        quantisedMesh->getSubMesh(0)->mLodFaceList[0]->indexCount);
+
+    // Quantised normals can't be used to derive tangents
+    VertexData* normalData = floatMesh->getSubMesh(0)->vertexData;
+    CPPUNIT_ASSERT(normalData->quantise(false, true, false));
+    CPPUNIT_ASSERT_THROW(floatMesh->buildTangentVectors(VES_BINORMAL), InvalidParametersException);
+
+    mMeshMgr->remove("testConsumersFloat.mesh");
+    mMeshMgr->remove("testConsumersQuantised.mesh");
+}
+
+/// Memory stream which counts the payloads read in place, or refuses to provide them
+class PeekCountingDataStream : public MemoryDataStream
+{
+public:
+    PeekCountingDataStream(DataStreamPtr& source, bool allowPeek)
+        : MemoryDataStream(source), mAllowPeek(allowPeek), mPeekCount(0) {}
+
+    const void* peek(size_t count)
+    {
+        if (!mAllowPeek)
+            return 0;
+        const void* data = MemoryDataStream::peek(count);
+        if (data)
+            ++mPeekCount;
+        return data;
+    }
+
+    size_t getPeekCount() const { return mPeekCount; }
+
+protected:
+    bool mAllowPeek;
+    size_t mPeekCount;
+};
+
+static bool buffersEqual(HardwareBuffer* a, HardwareBuffer* b)
+{
+    if (a->getSizeInBytes() != b->getSizeInBytes())
+        return false;
+    const void* dataA = a->lock(HardwareBuffer::HBL_READ_ONLY);
+    const void* dataB = b->lock(HardwareBuffer::HBL_READ_ONLY);
+    bool equal = memcmp(dataA, dataB, a->getSizeInBytes()) == 0;
+    a->unlock();
+    b->unlock();
+    return equal;
+}
+
+static bool meshBuffersEqual(const MeshPtr& a, const MeshPtr& b)
+{
+    SubMesh* subA = a->getSubMesh(0);
+    SubMesh* subB = b->getSubMesh(0);
+    return subA->vertexData->vertexCount == subB->vertexData->vertexCount &&
+        buffersEqual(subA->vertexData->vertexBufferBinding->getBuffer(0).get(),
+            subB->vertexData->vertexBufferBinding->getBuffer(0).get()) &&
+        buffersEqual(subA->indexData->indexBuffer.get(), subB->indexData->indexBuffer.get());
+}
+
+void MeshWithoutIndexDataTests::testImportInPlace()
+{
+    const size_t GRID_SIZE = 4;
+    ManualObject* grid = OGRE_NEW ManualObject("grid");
+    grid->begin("BaseWhiteNoLighting", RenderOperation::OT_TRIANGLE_LIST);
+    for (size_t y = 0; y <= GRID_SIZE; ++y)
+    {
+        for (size_t x = 0; x <= GRID_SIZE; ++x)
+        {
+            grid->position(Real(x), Real(y), 0);
+            grid->normal(Vector3::UNIT_Z);
+        }
+    }
+    for (size_t y = 0; y < GRID_SIZE; ++y)
+    {
+        for (size_t x = 0; x < GRID_SIZE; ++x)
+        {
+            uint32 corner = static_cast<uint32>(y * (GRID_SIZE + 1) + x);
+            grid->quad(corner, corner + 1, corner + GRID_SIZE + 2, corner + GRID_SIZE + 1);
+        }
+    }
+    grid->end();
+    String fileName = "testImportInPlace.mesh";
+    MeshPtr gridMesh = grid->convertToMesh(fileName);
+    OGRE_DELETE grid;
+
+    MeshSerializer meshWriter;
+    meshWriter.exportMesh(gridMesh.get(), fileName);
+
+    Archive* arch = archiveMgr->load(".", "FileSystem", true);
+    MeshSerializer meshReader;
+
+    // Memory backed streams hand the vertex and index payloads over in place
+    DataStreamPtr file = arch->open(fileName);
+    PeekCountingDataStream* inPlace = OGRE_NEW PeekCountingDataStream(file, true);
+    DataStreamPtr stream(inPlace);
+    MeshPtr inPlaceMesh = mMeshMgr->createManual("testImportInPlace1.mesh", "General");
+    meshReader.importMesh(stream, inPlaceMesh.get());
+    CPPUNIT_ASSERT(inPlace->getPeekCount() >= 2);
+    CPPUNIT_ASSERT(meshBuffersEqual(gridMesh, inPlaceMesh));
+
+    // Other streams go through a locked copy with the same result
+    file = arch->open(fileName);
+    stream = DataStreamPtr(OGRE_NEW PeekCountingDataStream(file, false));
+    MeshPtr copiedMesh = mMeshMgr->createManual("testImportInPlace2.mesh", "General");
+    meshReader.importMesh(stream, copiedMesh.get());
+    CPPUNIT_ASSERT(meshBuffersEqual(gridMesh, copiedMesh));
+
+    // Regular FileSystem streams can't be used in place, so Mesh copies them to
+    // the heap first; mapped ones can
+    file = arch->open(fileName);
+    CPPUNIT_ASSERT(file->peek(file->size()) == 0);
+    FileSystemArchive::setUseMemoryMapping(true);
+    file = arch->open(fileName);
+    FileSystemArchive::setUseMemoryMapping(false);
+    CPPUNIT_ASSERT(file->peek(file->size()) != 0);
+    stream = file;
+    MeshPtr mappedMesh = mMeshMgr->createManual("testImportInPlace3.mesh", "General");
+    meshReader.importMesh(stream, mappedMesh.get());
+    CPPUNIT_ASSERT(meshBuffersEqual(gridMesh, mappedMesh));
+
+    file.setNull();
+    stream.setNull();
+    archiveMgr->unload(arch);
+    remove(fileName.c_str());
+
+    mMeshMgr->remove(fileName);
+    mMeshMgr->remove("testImportInPlace1.mesh");
+    mMeshMgr->remove("testImportInPlace2.mesh");
+    mMeshMgr->remove("testImportInPlace3.mesh");
+}
+static bool posesEqual(const Pose* a, const Pose* b)
+{
+    return a->getTarget() == b->getTarget() &&
+        a->getVertexOffsets() == b->getVertexOffsets() &&
+        a->getNormals() == b->getNormals();
+}
+
+void MeshWithoutIndexDataTests::testImportDeferredPayloads()
+{
+    String fileName = "testImportDeferredPayloads.mesh";
+    MeshPtr gridMesh = createQuantiseGrid(fileName, "BaseWhiteNoLighting");
+    VertexData* vertexData = gridMesh->getSubMesh(0)->vertexData;
+
+    // Poses with and without normals, and a morph animation of the submesh
+    Pose* offsetPose = gridMesh->createPose(1, "offsets");
+    Pose* normalPose = gridMesh->createPose(1, "normals");
+    for (size_t v = 0; v < vertexData->vertexCount; v += 2)
+    {
+        offsetPose->addVertex(v, Vector3(Real(v), 0, 1));
+        normalPose->addVertex(v + 1, Vector3(0, Real(v), 0), Vector3::UNIT_X);
+    }
+    Animation* anim = gridMesh->createAnimation("morph", 1);
+    VertexAnimationTrack* track = anim->createVertexTrack(1, vertexData, VAT_MORPH);
+    for (int k = 0; k < 2; ++k)
+    {
+        VertexMorphKeyFrame* kf = track->createVertexMorphKeyFrame(Real(k));
+        HardwareVertexBufferSharedPtr vbuf = mBufMgr->createVertexBuffer(
+            sizeof(float) * 3, vertexData->vertexCount, HardwareBuffer::HBU_STATIC, true);
+        float* pFloat = static_cast<float*>(vbuf->lock(HardwareBuffer::HBL_DISCARD));
+        for (size_t f = 0; f < vertexData->vertexCount * 3; ++f)
+            pFloat[f] = float(f + k);
+        vbuf->unlock();
+        kf->setVertexBuffer(vbuf);
+    }
+
+    Archive* arch = archiveMgr->load(".", "FileSystem", true);
+    MeshSerializer meshSerializer;
+    const Serializer::Endian endians[] = { Serializer::ENDIAN_NATIVE, Serializer::ENDIAN_BIG,
+        Serializer::ENDIAN_LITTLE };
+    for (size_t e = 0; e < 3; ++e)
+    {
+        meshSerializer.exportMesh(gridMesh.get(), fileName, endians[e]);
+
+        // Payloads of memory backed streams are decoded after reading the mesh,
+        // other streams are read straight through; both give the same mesh
+        for (int allowPeek = 0; allowPeek < 2; ++allowPeek)
+        {
+            DataStreamPtr file = arch->open(fileName);
+            DataStreamPtr stream(OGRE_NEW PeekCountingDataStream(file, allowPeek != 0));
+            MeshPtr loaded = mMeshMgr->createManual("testImportDeferredPayloads2.mesh", "General");
+            meshSerializer.importMesh(stream, loaded.get());
+
+            CPPUNIT_ASSERT(meshBuffersEqual(gridMesh, loaded));
+            CPPUNIT_ASSERT_EQUAL(gridMesh->getPoseCount(), loaded->getPoseCount());
+            for (ushort p = 0; p < gridMesh->getPoseCount(); ++p)
+                CPPUNIT_ASSERT(posesEqual(gridMesh->getPose(p), loaded->getPose(p)));
+            VertexAnimationTrack* loadedTrack = loaded->getAnimation("morph")->getVertexTrack(1);
+            CPPUNIT_ASSERT_EQUAL(track->getNumKeyFrames(), loadedTrack->getNumKeyFrames());
+            for (unsigned short k = 0; k < track->getNumKeyFrames(); ++k)
+            {
+                CPPUNIT_ASSERT(buffersEqual(
+                    track->getVertexMorphKeyFrame(k)->getVertexBuffer().get(),
+                    loadedTrack->getVertexMorphKeyFrame(k)->getVertexBuffer().get()));
+            }
+
+            file.setNull();
+            stream.setNull();
+            mMeshMgr->remove("testImportDeferredPayloads2.mesh");
+        }
+    }
+
+    archiveMgr->unload(arch);
+    remove(fileName.c_str());
+    mMeshMgr->remove(fileName);
+}
@@ -0,0 +1,229 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "PackArchiveTests.h"
+#include "OgrePackArchive.h"
+#include "OgreFileSystem.h"
+#include "OgreStringConverter.h"
+#include <fstream>
+#include <stddef.h>
+
+using namespace Ogre;
+
+// Register the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( PackArchiveTests );
+
+void PackArchiveTests::setUp()
+{
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+    sourcePath = "../../../../Tests/OgreMain/misc/ArchiveTest/";
+#else
+    sourcePath = "../Tests/OgreMain/misc/ArchiveTest/";
+#endif
+    packPath = "PackArchiveTest.pack";
+    uncompressedPackPath = "PackArchiveTestUncompressed.pack";
+    writePack(packPath, true);
+    writePack(uncompressedPackPath, false);
+}
+void PackArchiveTests::tearDown()
+{
+    std::remove(packPath.c_str());
+    std::remove(uncompressedPackPath.c_str());
+}
+void PackArchiveTests::writePack(const String& path, bool compress)
+{
+    FileSystemArchive source(sourcePath, "FileSystem", true);
+    source.load();
+    StringVectorPtr files = source.list(true);
+
+    PackArchiveWriter writer(path, 64);
+    for (StringVector::iterator i = files->begin(); i != files->end(); ++i)
+        writer.addFile(*i, source.open(*i), source.getModifiedTime(*i), compress);
+    writer.finish();
+}
+void PackArchiveTests::testListNonRecursive()
+{
+    PackArchive arch(packPath, "Pack");
+    arch.load();
+    StringVectorPtr vec = arch.list(false);
+
+    CPPUNIT_ASSERT_EQUAL((size_t)2, vec->size());
+    CPPUNIT_ASSERT_EQUAL(String("rootfile.txt"), vec->at(0));
+    CPPUNIT_ASSERT_EQUAL(String("rootfile2.txt"), vec->at(1));
+}
+void PackArchiveTests::testListRecursive()
+{
+    PackArchive arch(packPath, "Pack");
+    arch.load();
+    StringVectorPtr vec = arch.list(true);
+
+    CPPUNIT_ASSERT_EQUAL((size_t)6, vec->size());
+    CPPUNIT_ASSERT_EQUAL(String("level1/materials/scripts/file.material"), vec->at(0));
+    CPPUNIT_ASSERT_EQUAL(String("level1/materials/scripts/file2.material"), vec->at(1));
+    CPPUNIT_ASSERT_EQUAL(String("level2/materials/scripts/file3.material"), vec->at(2));
+    CPPUNIT_ASSERT_EQUAL(String("level2/materials/scripts/file4.material"), vec->at(3));
+    CPPUNIT_ASSERT_EQUAL(String("rootfile.txt"), vec->at(4));
+    CPPUNIT_ASSERT_EQUAL(String("rootfile2.txt"), vec->at(5));
+}
+void PackArchiveTests::testFindRecursive()
+{
+    PackArchive arch(packPath, "Pack");
+    arch.load();
+    StringVectorPtr vec = arch.find("*.material", true);
+
+    CPPUNIT_ASSERT_EQUAL((size_t)4, vec->size());
+    CPPUNIT_ASSERT_EQUAL(String("level1/materials/scripts/file.material"), vec->at(0));
+    CPPUNIT_ASSERT_EQUAL(String("level2/materials/scripts/file4.material"), vec->at(3));
+}
+void PackArchiveTests::testFindFileInfoNonRecursive()
+{
+    PackArchive arch(packPath, "Pack");
+    arch.load();
+    FileInfoListPtr vec = arch.findFileInfo("*.txt", false);
+
+    CPPUNIT_ASSERT_EQUAL((size_t)2, vec->size());
+    FileInfo& fi1 = vec->at(0);
+    CPPUNIT_ASSERT_EQUAL(String("rootfile.txt"), fi1.filename);
+    CPPUNIT_ASSERT_EQUAL(String("rootfile.txt"), fi1.basename);
+    CPPUNIT_ASSERT_EQUAL(StringUtil::BLANK, fi1.path);
+    CPPUNIT_ASSERT_EQUAL((size_t)125, fi1.uncompressedSize);
+}
+void PackArchiveTests::testFileRead()
+{
+    PackArchive arch(packPath, "Pack");
+    arch.load();
+
+    DataStreamPtr stream = arch.open("rootfile.txt");
+    CPPUNIT_ASSERT_EQUAL(String("this is line 1 in file 1"), stream->getLine());
+    CPPUNIT_ASSERT_EQUAL(String("this is line 2 in file 1"), stream->getLine());
+    CPPUNIT_ASSERT_EQUAL(String("this is line 3 in file 1"), stream->getLine());
+    CPPUNIT_ASSERT_EQUAL(String("this is line 4 in file 1"), stream->getLine());
+    CPPUNIT_ASSERT_EQUAL(String("this is line 5 in file 1"), stream->getLine());
+    CPPUNIT_ASSERT_EQUAL(StringUtil::BLANK, stream->getLine()); // blank at end of file
+    CPPUNIT_ASSERT(stream->eof());
+
+    stream = arch.open("level2/materials/scripts/file4.material");
+    FileSystemArchive source(sourcePath, "FileSystem", true);
+    source.load();
+    CPPUNIT_ASSERT_EQUAL(source.open("level2/materials/scripts/file4.material")->getAsString(),
+        stream->getAsString());
+}
+void PackArchiveTests::testUncompressedFileRead()
+{
+    PackArchive arch(uncompressedPackPath, "Pack");
+    arch.load();
+
+    DataStreamPtr stream = arch.open("rootfile2.txt");
+    // Uncompressed files are aligned, and read in place when the pack is mapped
+    const void* data = stream->peek(stream->size());
+    CPPUNIT_ASSERT(data != 0);
+    CPPUNIT_ASSERT_EQUAL(String("this is line 1 in file 2"), stream->getLine());
+    CPPUNIT_ASSERT_EQUAL(String("this is line 2 in file 2"), stream->getLine());
+
+    // Streams outlive the archive
+    arch.unload();
+    CPPUNIT_ASSERT_EQUAL(String("this is line 3 in file 2"), stream->getLine());
+}
+void PackArchiveTests::testExists()
+{
+    PackArchive arch(packPath, "Pack");
+    arch.load();
+
+    CPPUNIT_ASSERT(arch.exists("rootfile2.txt"));
+    CPPUNIT_ASSERT(arch.exists("level1/materials/scripts/file2.material"));
+    CPPUNIT_ASSERT(!arch.exists("file2.material"));
+    CPPUNIT_ASSERT(!arch.exists("ROOTFILE2.TXT"));
+    CPPUNIT_ASSERT(!arch.exists("rootfile3.txt"));
+}
+void PackArchiveTests::testLz4RoundTrip()
+{
+    String text;
+    for (int i = 0; i < 1000; ++i)
+        text += "line " + StringConverter::toString(i % 17) + " of some repetitive text\n";
+
+    vector<uchar>::type compressed(PackArchive::getLz4Bound(text.size()));
+    size_t compressedSize = PackArchive::compressLz4(text.data(), text.size(), &compressed[0], compressed.size());
+    CPPUNIT_ASSERT(compressedSize > 0);
+    CPPUNIT_ASSERT(compressedSize < text.size() / 4);
+
+    String result(text.size(), ' ');
+    CPPUNIT_ASSERT(PackArchive::decompressLz4(&compressed[0], compressedSize, &result[0], result.size()));
+    CPPUNIT_ASSERT_EQUAL(text, result);
+
+    // Damaged data is rejected
+    CPPUNIT_ASSERT(!PackArchive::decompressLz4(&compressed[0], compressedSize / 2, &result[0], result.size()));
+}
+bool PackArchiveTests::rejectsDamagedPack(size_t entryIndex, size_t fieldOffset, uint64 value, size_t fieldSize)
+{
+    std::ifstream in(packPath.c_str(), std::ios::in | std::ios::binary);
+    String data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+
+    // Packs are little endian, as are the hosts the tests run on
+    PackArchive::PackHeader header;
+    memcpy(&header, data.data(), sizeof(header));
+    size_t fieldPos = static_cast<size_t>(header.entriesOffset) +
+        entryIndex * sizeof(PackArchive::PackEntry) + fieldOffset;
+    memcpy(&data[fieldPos], &value, fieldSize);
+
+    String damagedPath = "PackArchiveTestDamaged.pack";
+    std::ofstream out(damagedPath.c_str(), std::ios::out | std::ios::binary);
+    out.write(data.data(), data.size());
+    out.close();
+
+    bool rejected = false;
+    {
+        PackArchive arch(damagedPath, "Pack");
+        try
+        {
+            arch.load();
+        }
+        catch (InvalidParametersException&)
+        {
+            rejected = true;
+        }
+        // Nothing of the damaged table is kept
+        rejected = rejected && arch.list(true)->empty() && !arch.exists("rootfile.txt");
+    }
+    std::remove(damagedPath.c_str());
+    return rejected;
+}
+void PackArchiveTests::testDamagedTableOfContents()
+{
+    // The untouched pack loads
+    CPPUNIT_ASSERT(!rejectsDamagedPack(0, offsetof(PackArchive::PackEntry, reserved), 0, sizeof(uint32)));
+
+    // Entry 4 is the compressed rootfile.txt, the material files before it are empty.
+    // A compressed size which wraps around when added to the offset
+    CPPUNIT_ASSERT(rejectsDamagedPack(4, offsetof(PackArchive::PackEntry, compressedSize),
+        ~(uint64)0, sizeof(uint64)));
+    // An uncompressed size the compressed data can't decompress to, which would be allocated
+    CPPUNIT_ASSERT(rejectsDamagedPack(4, offsetof(PackArchive::PackEntry, size),
+        (uint64)1 << 40, sizeof(uint64)));
+    // An empty name after the first, out of the order binary search relies on
+    CPPUNIT_ASSERT(rejectsDamagedPack(1, offsetof(PackArchive::PackEntry, nameLength), 0, sizeof(uint32)));
+}
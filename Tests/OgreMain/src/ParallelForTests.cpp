@@ -0,0 +1,161 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "ParallelForTests.h"
+#include "OgreParallelFor.h"
+#include "OgreException.h"
+#include <stdexcept>
+
+using namespace Ogre;
+
+// Register the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( ParallelForTests );
+
+namespace
+{
+    /// Sums a range of numbers
+    struct SumWorker
+    {
+        size_t begin;
+        size_t end;
+        size_t sum;
+
+        SumWorker(size_t first, size_t last) : begin(first), end(last), sum(0) {}
+        void run()
+        {
+            for (size_t i = begin; i < end; ++i)
+                sum += i;
+        }
+    };
+
+    /// Marks its items as run and fails on some of them
+    class FailingTask : public ParallelFor::Task
+    {
+    public:
+        vector<int>::type done;
+
+        FailingTask(size_t count) : done(count, 0) {}
+        void run(size_t index)
+        {
+            done[index] = 1;
+            if (index % 3 == 1)
+                OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Failed item", "FailingTask::run");
+        }
+    };
+
+    /// Throws an exception of a derived type from one item
+    class DerivedFailureTask : public ParallelFor::Task
+    {
+    public:
+        bool ogre;
+
+        DerivedFailureTask(bool ogreException) : ogre(ogreException) {}
+        void run(size_t index)
+        {
+            if (index != 2)
+                return;
+            if (ogre)
+                OGRE_EXCEPT(Exception::ERR_FILE_NOT_FOUND, "Missing", "DerivedFailureTask::run");
+            throw std::out_of_range("Out of range");
+        }
+    };
+
+    /// Starts a run of its own from every item
+    class NestedTask : public ParallelFor::Task
+    {
+    public:
+        size_t count;
+        vector<SumWorker>::type workers;
+
+        NestedTask(size_t c) : count(c)
+        {
+            for (size_t i = 0; i < count * count; ++i)
+                workers.push_back(SumWorker(i * 100, (i + 1) * 100));
+        }
+        void run(size_t index)
+        {
+            vector<SumWorker>::type inner(workers.begin() + index * count,
+                workers.begin() + (index + 1) * count);
+            ParallelFor::runWorkers(inner);
+            std::copy(inner.begin(), inner.end(), workers.begin() + index * count);
+        }
+    };
+}
+
+void ParallelForTests::setUp()
+{
+}
+void ParallelForTests::tearDown()
+{
+}
+
+void ParallelForTests::testRunsEveryItem()
+{
+    const size_t count = 8;
+    vector<SumWorker>::type workers;
+    for (size_t i = 0; i < count; ++i)
+        workers.push_back(SumWorker(i * 1000, (i + 1) * 1000));
+    ParallelFor::runWorkers(workers);
+
+    size_t total = 0;
+    for (size_t i = 0; i < count; ++i)
+        total += workers[i].sum;
+    CPPUNIT_ASSERT_EQUAL(count * 1000 * (count * 1000 - 1) / 2, total);
+    CPPUNIT_ASSERT(ParallelFor::getHardwareThreadCount() >= 1);
+}
+
+void ParallelForTests::testRethrowsOnCaller()
+{
+    FailingTask task(7);
+    CPPUNIT_ASSERT_THROW(ParallelFor::run(task, task.done.size()), Exception);
+    // The items which did not fail still ran
+    for (size_t i = 0; i < task.done.size(); ++i)
+        CPPUNIT_ASSERT_EQUAL(1, task.done[i]);
+}
+
+void ParallelForTests::testRethrowsOriginalType()
+{
+    DerivedFailureTask ogreTask(true);
+    CPPUNIT_ASSERT_THROW(ParallelFor::run(ogreTask, 5), FileNotFoundException);
+    DerivedFailureTask stdTask(false);
+    CPPUNIT_ASSERT_THROW(ParallelFor::run(stdTask, 5), std::out_of_range);
+}
+
+void ParallelForTests::testNestedRuns()
+{
+    const size_t count = 6;
+    NestedTask task(count);
+    // Repeated, as the threads are kept between runs; the sums add up
+    const size_t repeats = 3;
+    for (size_t repeat = 0; repeat < repeats; ++repeat)
+        ParallelFor::run(task, count);
+
+    size_t total = 0;
+    for (size_t i = 0; i < task.workers.size(); ++i)
+        total += task.workers[i].sum;
+    CPPUNIT_ASSERT_EQUAL(repeats * count * count * 100 * (count * count * 100 - 1) / 2, total);
+}
@@ -223,7 +223,71 @@ void PixelFormatTests::testBulkConversion()
 	testCase(PF_X8B8G8R8, PF_A8B8G8R8);
 	testCase(PF_X8B8G8R8, PF_B8G8R8A8);
 	testCase(PF_X8B8G8R8, PF_R8G8B8A8);
+    testCase(PF_L8, PF_R8G8B8A8);
+    testCase(PF_A8, PF_A8R8G8B8);
+    testCase(PF_A8, PF_A8B8G8R8);
+    testCase(PF_A8, PF_B8G8R8A8);
+    testCase(PF_A8, PF_R8G8B8A8);
+    testCase(PF_BYTE_LA, PF_A8B8G8R8);
+    testCase(PF_BYTE_LA, PF_A8R8G8B8);
+    testCase(PF_A8R8G8B8, PF_FLOAT32_RGBA);
+    testCase(PF_A8B8G8R8, PF_FLOAT32_RGBA);
+    testCase(PF_B8G8R8A8, PF_FLOAT32_RGBA);
+    testCase(PF_R8G8B8A8, PF_FLOAT32_RGBA);
+    testCase(PF_FLOAT32_RGBA, PF_A8R8G8B8);
+    testCase(PF_FLOAT32_RGBA, PF_A8B8G8R8);
+    testCase(PF_FLOAT32_RGBA, PF_B8G8R8A8);
+    testCase(PF_FLOAT32_RGBA, PF_R8G8B8A8);
+    testCase(PF_A8R8G8B8, PF_FLOAT16_RGBA);
+    testCase(PF_A8B8G8R8, PF_FLOAT16_RGBA);
+    testCase(PF_B8G8R8A8, PF_FLOAT16_RGBA);
+    testCase(PF_R8G8B8A8, PF_FLOAT16_RGBA);
+    testCase(PF_FLOAT16_RGBA, PF_A8R8G8B8);
+    testCase(PF_FLOAT16_RGBA, PF_A8B8G8R8);
+    testCase(PF_FLOAT16_RGBA, PF_B8G8R8A8);
+    testCase(PF_FLOAT16_RGBA, PF_R8G8B8A8);
+    testCase(PF_BYTE_RGB, PF_FLOAT32_RGB);
+    testCase(PF_BYTE_BGR, PF_FLOAT32_RGB);
+    testCase(PF_FLOAT32_RGB, PF_BYTE_RGB);
+    testCase(PF_FLOAT32_RGB, PF_BYTE_BGR);
 
     //CPPUNIT_ASSERT_MESSAGE("Conversion mismatch", false);
 }
 
+void PixelFormatTests::testParallelConversion()
+{
+    // Big enough to be split into bands, with a sub box so the bands have to honour the pitches
+    const size_t width = 700, height = 600, pitch = 720;
+    uint8 *srcData = new uint8[pitch * height * 4];
+    uint8 *dstData1 = new uint8[pitch * height * 4];
+    uint8 *dstData2 = new uint8[pitch * height * 4];
+    for(size_t x = 0; x < pitch * height * 4; ++x)
+        srcData[x] = (uint8)rand();
+    memset(dstData1, 0, pitch * height * 4);
+    memset(dstData2, 0, pitch * height * 4);
+
+    PixelBox srcBox(Box(10, 0, width + 10, height), PF_A8R8G8B8, srcData);
+    srcBox.rowPitch = pitch;
+    srcBox.slicePitch = pitch * height;
+    PixelBox dstBox1 = srcBox, dstBox2 = srcBox;
+    dstBox1.format = dstBox2.format = PF_R8G8B8A8;
+    dstBox1.data = dstData1;
+    dstBox2.data = dstData2;
+
+    const size_t oldThreads = PixelUtil::getBulkConversionThreads();
+    PixelUtil::setBulkConversionThreads(4);
+    PixelUtil::bulkPixelConversion(srcBox, dstBox1);
+    PixelUtil::setBulkConversionThreads(1);
+    PixelUtil::bulkPixelConversion(srcBox, dstBox2);
+    PixelUtil::setBulkConversionThreads(oldThreads);
+
+    CPPUNIT_ASSERT(memcmp(dstData1, dstData2, pitch * height * 4) == 0);
+    // Pixels outside the box are left alone
+    CPPUNIT_ASSERT_EQUAL((uint8)0, dstData1[0]);
+    CPPUNIT_ASSERT_EQUAL((uint8)0, dstData1[(pitch * height - 1) * 4]);
+
+    delete [] srcData;
+    delete [] dstData1;
+    delete [] dstData2;
+}
+
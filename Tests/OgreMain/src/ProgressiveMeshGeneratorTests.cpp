@@ -0,0 +1,243 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "ProgressiveMeshGeneratorTests.h"
+#include "OgreProgressiveMeshGenerator.h"
+#include "OgreDistanceLodStrategy.h"
+#include "OgreLodStrategyManager.h"
+#include "OgreDefaultHardwareBufferManager.h"
+#include "OgreManualObject.h"
+#include "OgreMaterialManager.h"
+#include "OgreMeshManager.h"
+#include "OgreResourceGroupManager.h"
+#include "OgreSubMesh.h"
+
+// Register the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( ProgressiveMeshGeneratorTests );
+
+namespace
+{
+    /// Gives the tests access to the internals of the generator
+    class TestGenerator : public ProgressiveMeshGenerator
+    {
+    public:
+        typedef PMVertex Vertex;
+        typedef PMCollapseCostHeap Heap;
+    };
+}
+
+void ProgressiveMeshGeneratorTests::setUp()
+{
+    LogManager::getSingleton().createLog("ProgressiveMeshGeneratorTests.log", false);
+    OGRE_NEW ResourceGroupManager();
+    OGRE_NEW LodStrategyManager();
+    mBufMgr = OGRE_NEW DefaultHardwareBufferManager();
+    mMeshMgr = OGRE_NEW MeshManager();
+    MaterialManager* matMgr = OGRE_NEW MaterialManager();
+    matMgr->initialise();
+}
+void ProgressiveMeshGeneratorTests::tearDown()
+{
+    OGRE_DELETE mMeshMgr;
+    OGRE_DELETE mBufMgr;
+    OGRE_DELETE MaterialManager::getSingletonPtr();
+    OGRE_DELETE LodStrategyManager::getSingletonPtr();
+    OGRE_DELETE ResourceGroupManager::getSingletonPtr();
+}
+MeshPtr ProgressiveMeshGeneratorTests::createGrid(const String& name, size_t size, bool flat)
+{
+    ManualObject* grid = OGRE_NEW ManualObject(name);
+    grid->begin("BaseWhiteNoLighting", RenderOperation::OT_TRIANGLE_LIST);
+    for (size_t y = 0; y <= size; ++y)
+    {
+        for (size_t x = 0; x <= size; ++x)
+            grid->position(Real(x), Real(y), flat ? 0.0f : Math::Sin(Real(x) * 0.7f) * Math::Cos(Real(y) * 0.3f));
+    }
+    for (size_t y = 0; y < size; ++y)
+    {
+        for (size_t x = 0; x < size; ++x)
+        {
+            uint32 corner = static_cast<uint32>(y * (size + 1) + x);
+            grid->quad(corner, corner + 1, corner + size + 2, corner + size + 1);
+        }
+    }
+    grid->end();
+    MeshPtr mesh = grid->convertToMesh(name);
+    OGRE_DELETE grid;
+    return mesh;
+}
+void ProgressiveMeshGeneratorTests::generateLods(MeshPtr& mesh, size_t costThreads,
+    LodConfig::ErrorMetric errorMetric)
+{
+    LodConfig lodConfig;
+    lodConfig.mesh = mesh;
+    lodConfig.errorMetric = errorMetric;
+    lodConfig.strategy = DistanceLodStrategy::getSingletonPtr();
+    LodLevel lodLevel;
+    lodLevel.reductionMethod = LodLevel::VRM_PROPORTIONAL;
+    for (int i = 1; i <= 3; ++i)
+    {
+        lodLevel.distance = Real(i * 100);
+        lodLevel.reductionValue = Real(i) * 0.25f;
+        lodConfig.levels.push_back(lodLevel);
+    }
+    ProgressiveMeshGenerator pm;
+    pm.setCostThreadCount(costThreads);
+    pm.generateLodLevels(lodConfig);
+}
+void ProgressiveMeshGeneratorTests::testCollapseCostHeap()
+{
+    const size_t COUNT = 200;
+    vector<TestGenerator::Vertex>::type vertices(COUNT);
+    vector<Real>::type costs(COUNT);
+    TestGenerator::Heap heap;
+    for (size_t i = 0; i < COUNT; ++i)
+    {
+        costs[i] = Real((i * 7919) % COUNT);
+        heap.pushUnordered(&vertices[i], costs[i]);
+    }
+    heap.build();
+
+    // Raise and lower costs, remove vertices and add some of them back
+    for (size_t i = 0; i < COUNT; i += 3)
+    {
+        costs[i] = (i % 2) ? costs[i] * 0.5f : costs[i] + 1000.0f;
+        heap.update(&vertices[i], costs[i]);
+    }
+    size_t expectedSize = COUNT;
+    for (size_t i = 0; i < COUNT; i += 5)
+    {
+        heap.erase(&vertices[i]);
+        CPPUNIT_ASSERT_EQUAL(TestGenerator::Heap::NOT_IN_HEAP, vertices[i].costHeapPosition);
+        if (i % 10 == 0)
+        {
+            costs[i] = -Real(i);
+            heap.push(&vertices[i], costs[i]);
+        }
+        else
+        {
+            costs[i] = -1.0f; // gone
+            --expectedSize;
+        }
+    }
+    CPPUNIT_ASSERT_EQUAL(expectedSize, heap.size());
+
+    // Every vertex knows where it is
+    const TestGenerator::Heap::EntryList& entries = heap.getEntries();
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        CPPUNIT_ASSERT_EQUAL(i, entries[i].vertex->costHeapPosition);
+        CPPUNIT_ASSERT_EQUAL(costs[entries[i].vertex - &vertices[0]], entries[i].cost);
+    }
+
+    // Taking the top off yields the costs in order
+    Real lastCost = -std::numeric_limits<Real>::max();
+    while (!heap.empty())
+    {
+        const TestGenerator::Heap::Entry top = heap.top();
+        CPPUNIT_ASSERT(lastCost <= top.cost);
+        CPPUNIT_ASSERT_EQUAL(top.cost, heap.getCost(top.vertex));
+        lastCost = top.cost;
+        heap.erase(top.vertex);
+    }
+}
+void ProgressiveMeshGeneratorTests::testCostThreadsMatchSerial()
+{
+    MeshPtr serial = createGrid("serialGrid", 48);
+    MeshPtr threaded = createGrid("threadedGrid", 48);
+    generateLods(serial, 1);
+    generateLods(threaded, 4);
+
+    CPPUNIT_ASSERT_EQUAL((ushort)4, serial->getNumLodLevels());
+    CPPUNIT_ASSERT_EQUAL(serial->getNumLodLevels(), threaded->getNumLodLevels());
+    const SubMesh* serialSub = serial->getSubMesh(0);
+    const SubMesh* threadedSub = threaded->getSubMesh(0);
+    for (size_t lod = 0; lod < serialSub->mLodFaceList.size(); ++lod)
+    {
+        const IndexData* a = serialSub->mLodFaceList[lod];
+        const IndexData* b = threadedSub->mLodFaceList[lod];
+        CPPUNIT_ASSERT_EQUAL(a->indexCount, b->indexCount);
+        CPPUNIT_ASSERT(a->indexCount < serialSub->indexData->indexCount);
+        const size_t bytes = a->indexCount * a->indexBuffer->getIndexSize();
+        const void* pa = a->indexBuffer->lock(HardwareBuffer::HBL_READ_ONLY);
+        const void* pb = b->indexBuffer->lock(HardwareBuffer::HBL_READ_ONLY);
+        CPPUNIT_ASSERT(memcmp(pa, pb, bytes) == 0);
+        a->indexBuffer->unlock();
+        b->indexBuffer->unlock();
+    }
+    mMeshMgr->remove("serialGrid");
+    mMeshMgr->remove("threadedGrid");
+}
+void ProgressiveMeshGeneratorTests::testQuadricKeepsBorder()
+{
+    // Inside a flat grid every collapse is free, but the border planes must keep its outline,
+    // so each Lod level still covers the whole square.
+    const size_t size = 16;
+    MeshPtr mesh = createGrid("quadricGrid", size, true);
+    generateLods(mesh, 1, LodConfig::EM_QUADRIC);
+
+    CPPUNIT_ASSERT_EQUAL((ushort)4, mesh->getNumLodLevels());
+    const SubMesh* sub = mesh->getSubMesh(0);
+    const VertexData* vertexData = sub->vertexData;
+    const VertexElement* posElem = vertexData->vertexDeclaration->findElementBySemantic(VES_POSITION);
+    HardwareVertexBufferSharedPtr vbuf = vertexData->vertexBufferBinding->getBuffer(posElem->getSource());
+    const unsigned char* vertex = static_cast<const unsigned char*>(vbuf->lock(HardwareBuffer::HBL_READ_ONLY));
+    size_t lastIndexCount = sub->indexData->indexCount;
+    for (size_t lod = 0; lod < sub->mLodFaceList.size(); ++lod)
+    {
+        const IndexData* indexData = sub->mLodFaceList[lod];
+        CPPUNIT_ASSERT(indexData->indexCount < lastIndexCount);
+        lastIndexCount = indexData->indexCount;
+
+        const HardwareIndexBufferSharedPtr& ibuf = indexData->indexBuffer;
+        const bool use32bit = ibuf->getType() == HardwareIndexBuffer::IT_32BIT;
+        const void* indexes = ibuf->lock(indexData->indexStart * ibuf->getIndexSize(),
+            indexData->indexCount * ibuf->getIndexSize(), HardwareBuffer::HBL_READ_ONLY);
+        Real area = 0.0f;
+        for (size_t i = 0; i < indexData->indexCount; i += 3)
+        {
+            Vector3 corners[3];
+            for (size_t c = 0; c < 3; ++c)
+            {
+                const uint32 index = use32bit ? static_cast<const uint32*>(indexes)[i + c] :
+                    static_cast<const uint16*>(indexes)[i + c];
+                float* pFloat;
+                posElem->baseVertexPointerToElement(
+                    const_cast<unsigned char*>(vertex) + index * vbuf->getVertexSize(), &pFloat);
+                corners[c] = Vector3(pFloat[0], pFloat[1], pFloat[2]);
+            }
+            const Vector3 normal = (corners[1] - corners[0]).crossProduct(corners[2] - corners[0]);
+            // Nothing folded over. Slivers along straight lines may remain, as with curvature.
+            CPPUNIT_ASSERT(normal.z >= 0.0f);
+            area += normal.z * 0.5f;
+        }
+        ibuf->unlock();
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(Real(size * size), area, 0.001f);
+    }
+    vbuf->unlock();
+    mMeshMgr->remove("quadricGrid");
+}
@@ -0,0 +1,217 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "ResourceGroupManagerTests.h"
+#include "OgreResourceManager.h"
+#include "OgreResourceGroupManager.h"
+#include "OgreLogManager.h"
+#include "OgreWorkQueue.h"
+
+// Register the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( ResourceGroupManagerTests );
+
+namespace
+{
+    /// Counts how often it was prepared, one of them fails to prepare
+    class CountingResource : public Resource
+    {
+    public:
+        size_t mPrepareCount;
+        bool mBroken;
+
+        CountingResource(ResourceManager* creator, const String& name, ResourceHandle handle,
+            const String& group, bool isManual, ManualResourceLoader* loader)
+            : Resource(creator, name, handle, group, isManual, loader), mPrepareCount(0), mBroken(false) {}
+
+    protected:
+        void prepareImpl(void)
+        {
+            ++mPrepareCount;
+            if (mBroken)
+            {
+                OGRE_EXCEPT(Exception::ERR_FILE_NOT_FOUND, "Cannot prepare " + mName,
+                    "CountingResource::prepareImpl");
+            }
+        }
+        void loadImpl(void) {}
+        void unloadImpl(void) {}
+        size_t calculateSize(void) const { return 0; }
+    };
+
+    class CountingResourceManager : public ResourceManager
+    {
+    public:
+        CountingResourceManager()
+        {
+            mResourceType = "CountingResource";
+            ResourceGroupManager::getSingleton()._registerResourceManager(mResourceType, this);
+        }
+        ~CountingResourceManager()
+        {
+            removeAll();
+            ResourceGroupManager::getSingleton()._unregisterResourceManager(mResourceType);
+        }
+
+    protected:
+        Resource* createImpl(const String& name, ResourceHandle handle, const String& group,
+            bool isManual, ManualResourceLoader* loader, const NameValuePairList* createParams)
+        {
+            return OGRE_NEW CountingResource(this, name, handle, group, isManual, loader);
+        }
+    };
+
+    /// Creates a file in the group of each stream opened, while the lookup still holds the index
+    class CreatingLoadingListener : public ResourceLoadingListener
+    {
+    public:
+        String mFileName;
+
+        DataStreamPtr resourceLoading(const String &name, const String &group, Resource *resource)
+        {
+            return DataStreamPtr();
+        }
+        void resourceStreamOpened(const String &name, const String &group, Resource *resource, DataStreamPtr& dataStream)
+        {
+            if (!mFileName.empty())
+                ResourceGroupManager::getSingleton().createResource(mFileName, group);
+            mFileName.clear();
+        }
+        bool resourceCollision(Resource *resource, ResourceManager *resourceManager)
+        {
+            return false;
+        }
+    };
+}
+//--------------------------------------------------------------------------
+void ResourceGroupManagerTests::setUp()
+{
+    if(LogManager::getSingletonPtr() == 0)
+    {
+        LogManager* logManager = OGRE_NEW LogManager();
+        logManager->createLog("ResourceGroupManagerTests.log", true, false);
+    }
+    LogManager::getSingleton().setLogDetail(LL_LOW);
+
+    mRoot = OGRE_NEW Root("");
+    // Usually started with the first render window
+    mRoot->getWorkQueue()->startup();
+    mResourceMgr = OGRE_NEW CountingResourceManager();
+}
+//--------------------------------------------------------------------------
+void ResourceGroupManagerTests::tearDown()
+{
+    OGRE_DELETE mResourceMgr;
+    OGRE_DELETE mRoot;
+}
+//--------------------------------------------------------------------------
+void ResourceGroupManagerTests::createResources(const String& group, size_t count, size_t broken)
+{
+    ResourceGroupManager::getSingleton().createResourceGroup(group);
+    for (size_t i = 0; i < count; ++i)
+    {
+        ResourcePtr res = mResourceMgr->create(group + StringConverter::toString(i), group);
+        static_cast<CountingResource*>(res.get())->mBroken = (i == broken);
+    }
+}
+//--------------------------------------------------------------------------
+void ResourceGroupManagerTests::testPrepareGroupInParallel()
+{
+    const size_t COUNT = 64;
+    createResources("Parallel", COUNT, COUNT);
+
+    ResourceGroupManager::getSingleton().setResourcePrepareThreads(4);
+    ResourceGroupManager::getSingleton().loadResourceGroup("Parallel");
+
+    // Every resource is prepared exactly once, loading does not prepare it again
+    for (size_t i = 0; i < COUNT; ++i)
+    {
+        ResourcePtr res = mResourceMgr->getByName("Parallel" + StringConverter::toString(i), "Parallel");
+        CPPUNIT_ASSERT(res->isLoaded());
+        CPPUNIT_ASSERT_EQUAL((size_t)1, static_cast<CountingResource*>(res.get())->mPrepareCount);
+    }
+}
+//--------------------------------------------------------------------------
+void ResourceGroupManagerTests::testPrepareFailureRaisedByLoad()
+{
+    const size_t COUNT = 16;
+    createResources("Failing", COUNT, 0);
+
+    ResourceGroupManager::getSingleton().setResourcePrepareThreads(4);
+    CPPUNIT_ASSERT_THROW(ResourceGroupManager::getSingleton().loadResourceGroup("Failing"), Exception);
+
+    // Failing in the parallel pass left it unloaded, the load tried again and raised
+    ResourcePtr broken = mResourceMgr->getByName("Failing0", "Failing");
+    CPPUNIT_ASSERT(!broken->isLoaded());
+    CPPUNIT_ASSERT_EQUAL((size_t)2, static_cast<CountingResource*>(broken.get())->mPrepareCount);
+}
+//--------------------------------------------------------------------------
+void ResourceGroupManagerTests::testIndexChangedInPlace()
+{
+    ResourceGroupManager& rgm = ResourceGroupManager::getSingleton();
+    rgm.addResourceLocation(".", "FileSystem", "Index", false, false);
+    rgm.resetResourceLookupStats();
+
+    rgm.createResource("IndexInPlace.txt", "Index");
+    CPPUNIT_ASSERT(rgm.resourceExists("Index", "IndexInPlace.txt"));
+    rgm.deleteResource("IndexInPlace.txt", "Index");
+    CPPUNIT_ASSERT(!rgm.resourceExists("Index", "IndexInPlace.txt"));
+
+    // No lookup was running during the changes, so nothing had to be copied
+    ResourceGroupManager::ResourceLookupStats stats = rgm.getResourceLookupStats();
+    CPPUNIT_ASSERT_EQUAL((size_t)2, stats.indexUpdates);
+    CPPUNIT_ASSERT_EQUAL((size_t)0, stats.indexCopies);
+}
+//--------------------------------------------------------------------------
+void ResourceGroupManagerTests::testIndexCopiedWhileInUse()
+{
+    ResourceGroupManager& rgm = ResourceGroupManager::getSingleton();
+    rgm.addResourceLocation(".", "FileSystem", "Index", false, false);
+    rgm.createResource("IndexInUse1.txt", "Index");
+
+    CreatingLoadingListener listener;
+    listener.mFileName = "IndexInUse2.txt";
+    rgm.setLoadingListener(&listener);
+    rgm.resetResourceLookupStats();
+
+    // The listener adds a file while openResource still holds the index it used
+    DataStreamPtr stream = rgm.openResource("IndexInUse1.txt", "Index");
+    stream.setNull();
+    rgm.setLoadingListener(0);
+
+    ResourceGroupManager::ResourceLookupStats stats = rgm.getResourceLookupStats();
+    CPPUNIT_ASSERT_EQUAL((size_t)1, stats.indexUpdates);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, stats.indexCopies);
+
+    // Later lookups see the new file without searching the archives
+    CPPUNIT_ASSERT(rgm.resourceExists("Index", "IndexInUse2.txt"));
+    CPPUNIT_ASSERT(rgm.resourceExists("Index", "IndexInUse1.txt"));
+    CPPUNIT_ASSERT_EQUAL((size_t)0, rgm.getResourceLookupStats().archiveSearches);
+
+    rgm.deleteResource("IndexInUse1.txt", "Index");
+    rgm.deleteResource("IndexInUse2.txt", "Index");
+    CPPUNIT_ASSERT(!rgm.resourceExists("Index", "IndexInUse2.txt"));
+}
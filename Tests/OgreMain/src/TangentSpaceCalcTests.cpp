@@ -0,0 +1,236 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "TangentSpaceCalcTests.h"
+#include "OgreDefaultHardwareBufferManager.h"
+#include "OgreTangentSpaceCalc.h"
+#include "OgreVertexIndexData.h"
+
+using namespace Ogre;
+
+// Register the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( TangentSpaceCalcTests );
+
+void TangentSpaceCalcTests::setUp()
+{
+    mBufMgr = OGRE_NEW DefaultHardwareBufferManager();
+}
+void TangentSpaceCalcTests::tearDown()
+{
+    OGRE_DELETE mBufMgr;
+}
+
+void TangentSpaceCalcTests::createGrids(size_t quads, size_t copies, bool mirror,
+    VertexData*& vertexData, IndexData*& indexData)
+{
+    const size_t side = quads + 1;
+    const size_t gridVertices = side * side;
+
+    vertexData = OGRE_NEW VertexData();
+    vertexData->vertexCount = gridVertices * copies;
+    VertexDeclaration* decl = vertexData->vertexDeclaration;
+    size_t offset = 0;
+    offset += decl->addElement(0, offset, VET_FLOAT3, VES_POSITION).getSize();
+    offset += decl->addElement(0, offset, VET_FLOAT3, VES_NORMAL).getSize();
+    decl->addElement(0, offset, VET_FLOAT2, VES_TEXTURE_COORDINATES, 0);
+    HardwareVertexBufferSharedPtr vbuf = mBufMgr->createVertexBuffer(
+        decl->getVertexSize(0), vertexData->vertexCount, HardwareBuffer::HBU_STATIC, true);
+    vertexData->vertexBufferBinding->setBinding(0, vbuf);
+
+    // Every copy is identical, they only differ by the vertices they index
+    float* pVert = static_cast<float*>(vbuf->lock(HardwareBuffer::HBL_DISCARD));
+    for (size_t c = 0; c < copies; ++c)
+    {
+        for (size_t y = 0; y < side; ++y)
+        {
+            for (size_t x = 0; x < side; ++x)
+            {
+                float fx = float(x) / quads;
+                float fy = float(y) / quads;
+                float slope = 0.5f * Math::Cos(fx * 6 + fy * 2);
+                Vector3 normal = Vector3(-slope * 3, -slope, 1).normalisedCopy();
+                *pVert++ = fx;
+                *pVert++ = fy;
+                *pVert++ = 0.25f * Math::Sin(fx * 6 + fy * 2);
+                *pVert++ = normal.x;
+                *pVert++ = normal.y;
+                *pVert++ = normal.z;
+                *pVert++ = (mirror && x > quads / 2) ? 1.0f - fx : fx;
+                *pVert++ = fy;
+            }
+        }
+    }
+    vbuf->unlock();
+
+    indexData = OGRE_NEW IndexData();
+    indexData->indexCount = quads * quads * 6 * copies;
+    indexData->indexBuffer = mBufMgr->createIndexBuffer(HardwareIndexBuffer::IT_32BIT,
+        indexData->indexCount, HardwareBuffer::HBU_STATIC, true);
+    uint32* pIdx = static_cast<uint32*>(indexData->indexBuffer->lock(HardwareBuffer::HBL_DISCARD));
+    for (size_t c = 0; c < copies; ++c)
+    {
+        uint32 base = static_cast<uint32>(c * gridVertices);
+        for (size_t y = 0; y < quads; ++y)
+        {
+            for (size_t x = 0; x < quads; ++x)
+            {
+                uint32 v = base + static_cast<uint32>(y * side + x);
+                *pIdx++ = v;
+                *pIdx++ = v + 1;
+                *pIdx++ = v + static_cast<uint32>(side) + 1;
+                *pIdx++ = v;
+                *pIdx++ = v + static_cast<uint32>(side) + 1;
+                *pIdx++ = v + static_cast<uint32>(side);
+            }
+        }
+    }
+    indexData->indexBuffer->unlock();
+}
+
+vector<Vector4>::type TangentSpaceCalcTests::readTangents(VertexData* vertexData)
+{
+    const VertexElement* elem = vertexData->vertexDeclaration->findElementBySemantic(VES_TANGENT, 1);
+    CPPUNIT_ASSERT(elem);
+    HardwareVertexBufferSharedPtr vbuf = vertexData->vertexBufferBinding->getBuffer(elem->getSource());
+    size_t components = VertexElement::getTypeCount(elem->getType());
+
+    vector<Vector4>::type tangents(vertexData->vertexCount, Vector4(0, 0, 0, 1));
+    const uchar* pVert = static_cast<const uchar*>(vbuf->lock(HardwareBuffer::HBL_READ_ONLY));
+    for (size_t v = 0; v < vertexData->vertexCount; ++v, pVert += vbuf->getVertexSize())
+    {
+        float* pTangent;
+        elem->baseVertexPointerToElement(const_cast<uchar*>(pVert), &pTangent);
+        for (size_t i = 0; i < components; ++i)
+            tangents[v][i] = pTangent[i];
+    }
+    vbuf->unlock();
+    return tangents;
+}
+
+void TangentSpaceCalcTests::testParallelMatchesSerial()
+{
+    // One grid is too small to be split between threads, many copies of it are
+    const size_t quads = 24;
+    VertexData* singleVertices;
+    IndexData* singleIndexes;
+    createGrids(quads, 1, false, singleVertices, singleIndexes);
+    TangentSpaceCalc single;
+    single.setVertexData(singleVertices);
+    single.addIndexData(singleIndexes);
+    single.build();
+    vector<Vector4>::type expected = readTangents(singleVertices);
+
+    const size_t copies = 48;
+    VertexData* vertices;
+    IndexData* indexes;
+    createGrids(quads, copies, false, vertices, indexes);
+    TangentSpaceCalc calc;
+    calc.setVertexData(vertices);
+    calc.addIndexData(indexes);
+    calc.build();
+    vector<Vector4>::type tangents = readTangents(vertices);
+
+    CPPUNIT_ASSERT_EQUAL(expected.size() * copies, tangents.size());
+    for (size_t v = 0; v < tangents.size(); ++v)
+        CPPUNIT_ASSERT(tangents[v] == expected[v % expected.size()]);
+
+    OGRE_DELETE singleVertices;
+    OGRE_DELETE singleIndexes;
+    OGRE_DELETE vertices;
+    OGRE_DELETE indexes;
+}
+
+void TangentSpaceCalcTests::testAdjacencyMatchesFaceOrder()
+{
+    // Mirror splitting adds faces one at a time, but nothing splits on this grid,
+    // so the vertex to face table has to give the same sums
+    const size_t quads = 96;
+    VertexData* adjVertices;
+    IndexData* adjIndexes;
+    createGrids(quads, 1, false, adjVertices, adjIndexes);
+    TangentSpaceCalc adjacency;
+    adjacency.setVertexData(adjVertices);
+    adjacency.addIndexData(adjIndexes);
+    adjacency.build();
+
+    VertexData* vertices;
+    IndexData* indexes;
+    createGrids(quads, 1, false, vertices, indexes);
+    TangentSpaceCalc faceOrder;
+    faceOrder.setSplitMirrored(true);
+    faceOrder.setVertexData(vertices);
+    faceOrder.addIndexData(indexes);
+    TangentSpaceCalc::Result res = faceOrder.build();
+    CPPUNIT_ASSERT(res.vertexSplits.empty());
+
+    vector<Vector4>::type expected = readTangents(vertices);
+    vector<Vector4>::type tangents = readTangents(adjVertices);
+    CPPUNIT_ASSERT_EQUAL(expected.size(), tangents.size());
+    for (size_t v = 0; v < tangents.size(); ++v)
+    {
+        Vector3 tangent(tangents[v].ptr());
+        CPPUNIT_ASSERT(tangent.positionEquals(Vector3(expected[v].ptr()), 1e-5f));
+        CPPUNIT_ASSERT(Math::RealEqual(tangent.length(), 1, 1e-4f));
+    }
+
+    OGRE_DELETE adjVertices;
+    OGRE_DELETE adjIndexes;
+    OGRE_DELETE vertices;
+    OGRE_DELETE indexes;
+}
+
+void TangentSpaceCalcTests::testMirroredSplit()
+{
+    // U runs backwards past the middle column, whose vertices have to split
+    const size_t quads = 8;
+    VertexData* vertices;
+    IndexData* indexes;
+    createGrids(quads, 1, true, vertices, indexes);
+    size_t vertexCount = vertices->vertexCount;
+
+    TangentSpaceCalc calc;
+    calc.setSplitMirrored(true);
+    calc.setStoreParityInW(true);
+    calc.setVertexData(vertices);
+    calc.addIndexData(indexes);
+    TangentSpaceCalc::Result res = calc.build();
+
+    // One split per vertex of the middle column, faces using them are remapped
+    CPPUNIT_ASSERT_EQUAL(quads + 1, res.vertexSplits.size());
+    CPPUNIT_ASSERT(!res.indexesRemapped.empty());
+    CPPUNIT_ASSERT_EQUAL(vertexCount + quads + 1, vertices->vertexCount);
+
+    vector<Vector4>::type tangents = readTangents(vertices);
+    for (TangentSpaceCalc::VertexSplits::iterator i = res.vertexSplits.begin(); i != res.vertexSplits.end(); ++i)
+    {
+        CPPUNIT_ASSERT_EQUAL(quads / 2, i->first % (quads + 1));
+        CPPUNIT_ASSERT_EQUAL(-tangents[i->first].w, tangents[i->second].w);
+    }
+
+    OGRE_DELETE vertices;
+    OGRE_DELETE indexes;
+}
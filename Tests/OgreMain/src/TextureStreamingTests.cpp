@@ -0,0 +1,350 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "TextureStreamingTests.h"
+#include "OgreHardwarePixelBuffer.h"
+#include "OgreDefaultHardwareBufferManager.h"
+#include "OgreArchiveManager.h"
+#include "OgreLogManager.h"
+#include "OgreWorkQueue.h"
+
+// Register the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( TextureStreamingTests );
+
+namespace
+{
+    const String GROUP = "TextureStreamingTests";
+
+    /// Pixel buffer in system memory
+    class MemoryPixelBuffer : public HardwarePixelBuffer
+    {
+    public:
+        MemoryPixelBuffer(size_t width, size_t height, size_t depth, PixelFormat format)
+            : HardwarePixelBuffer(width, height, depth, format, HBU_STATIC, true, false)
+            , mData(mSizeInBytes) {}
+
+        void blitFromMemory(const PixelBox& src, const Image::Box& dstBox)
+        {
+            PixelUtil::bulkPixelConversion(src, lock(dstBox, HBL_NORMAL));
+            unlock();
+        }
+        void blitToMemory(const Image::Box& srcBox, const PixelBox& dst)
+        {
+            PixelUtil::bulkPixelConversion(lock(srcBox, HBL_READ_ONLY), dst);
+            unlock();
+        }
+
+    protected:
+        vector<uchar>::type mData;
+
+        PixelBox lockImpl(const Image::Box lockBox, LockOptions options)
+        {
+            return PixelBox(lockBox, mFormat, &mData[0] +
+                PixelUtil::getMemorySize(lockBox.left, 1, 1, mFormat) +
+                PixelUtil::getMemorySize(mWidth, lockBox.top, 1, mFormat) +
+                PixelUtil::getMemorySize(mWidth, mHeight, lockBox.front, mFormat));
+        }
+        void unlockImpl(void) {}
+    };
+
+    /// Texture in system memory loading its image file
+    class MemoryTexture : public Texture
+    {
+    public:
+        MemoryTexture(ResourceManager* creator, const String& name, ResourceHandle handle,
+            const String& group, bool isManual, ManualResourceLoader* loader)
+            : Texture(creator, name, handle, group, isManual, loader) {}
+        ~MemoryTexture()
+        {
+            if (isLoaded())
+                unload();
+            else
+                freeInternalResources();
+        }
+
+        HardwarePixelBufferSharedPtr getBuffer(size_t face, size_t mipmap)
+        {
+            return mSurfaces[face * (mNumMipmaps + 1) + mipmap];
+        }
+
+    protected:
+        vector<HardwarePixelBufferSharedPtr>::type mSurfaces;
+
+        void loadImpl(void)
+        {
+            Image img;
+            img.load(mName, mGroup);
+            ConstImagePtrList imagePtrs;
+            imagePtrs.push_back(&img);
+            _loadImages(imagePtrs);
+        }
+        void createInternalResourcesImpl(void)
+        {
+            for (size_t face = 0; face < getNumFaces(); ++face)
+            {
+                for (size_t mip = 0; mip <= mNumMipmaps; ++mip)
+                {
+                    mSurfaces.push_back(HardwarePixelBufferSharedPtr(OGRE_NEW MemoryPixelBuffer(
+                        std::max<size_t>(mWidth >> mip, 1), std::max<size_t>(mHeight >> mip, 1),
+                        std::max<size_t>(mDepth >> mip, 1), mFormat)));
+                }
+            }
+        }
+        void freeInternalResourcesImpl(void)
+        {
+            mSurfaces.clear();
+        }
+    };
+
+    class MemoryTextureManager : public TextureManager
+    {
+    public:
+        MemoryTextureManager()
+        {
+            ResourceGroupManager::getSingleton()._registerResourceManager(mResourceType, this);
+        }
+        ~MemoryTextureManager()
+        {
+            removeAll();
+            ResourceGroupManager::getSingleton()._unregisterResourceManager(mResourceType);
+        }
+
+        PixelFormat getNativeFormat(TextureType ttype, PixelFormat format, int usage) { return format; }
+        bool isHardwareFilteringSupported(TextureType ttype, PixelFormat format, int usage,
+            bool preciseFormatOnly) { return true; }
+
+    protected:
+        Resource* createImpl(const String& name, ResourceHandle handle, const String& group,
+            bool isManual, ManualResourceLoader* loader, const NameValuePairList* createParams)
+        {
+            return OGRE_NEW MemoryTexture(this, name, handle, group, isManual, loader);
+        }
+    };
+
+    /// Writes a 64x64 A8R8G8B8 DDS file with all 7 levels
+    void writeTexture(Archive* archive, const String& name)
+    {
+        uint32 header[32] = { 0 };
+        header[0] = 0x20534444; // 'DDS '
+        header[1] = 124;
+        header[2] = 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000;
+        header[3] = 64;
+        header[4] = 64;
+        header[7] = 7;
+        header[19] = 32;
+        header[20] = 0x40 | 0x1;
+        header[22] = 32;
+        header[23] = 0x00ff0000;
+        header[24] = 0x0000ff00;
+        header[25] = 0x000000ff;
+        header[26] = 0xff000000;
+        header[27] = 0x1000 | 0x400000 | 0x8;
+
+        vector<uint32>::type texels(64 * 64 + 32 * 32 + 16 * 16 + 8 * 8 + 4 * 4 + 2 * 2 + 1);
+        for (size_t i = 0; i < texels.size(); ++i)
+            texels[i] = (uint32)i;
+        DataStreamPtr file = archive->create(name);
+        file->write(header, sizeof(header));
+        file->write(&texels[0], texels.size() * sizeof(uint32));
+        file->close();
+    }
+}
+//--------------------------------------------------------------------------
+void TextureStreamingTests::setUp()
+{
+    if(LogManager::getSingletonPtr() == 0)
+    {
+        LogManager* logManager = OGRE_NEW LogManager();
+        logManager->createLog("TextureStreamingTests.log", true, false);
+    }
+    LogManager::getSingleton().setLogDetail(LL_LOW);
+
+    mRoot = OGRE_NEW Root("");
+    mBufMgr = OGRE_NEW DefaultHardwareBufferManager();
+    // Usually started with the first render window
+    mRoot->getWorkQueue()->startup();
+    mTexMgr = OGRE_NEW MemoryTextureManager();
+    mTexMgr->setDefaultStreaming(true);
+    // Textures start with their 8x8 level
+    mTexMgr->setStreamingInitialSize(8);
+
+    mArchive = ArchiveManager::getSingleton().load(".", "FileSystem", false);
+    for (int i = 0; i < 3; ++i)
+        writeTexture(mArchive, GROUP + StringConverter::toString(i) + ".dds");
+    ResourceGroupManager::getSingleton().addResourceLocation(".", "FileSystem", GROUP);
+}
+//--------------------------------------------------------------------------
+void TextureStreamingTests::tearDown()
+{
+    for (int i = 0; i < 3; ++i)
+        mArchive->remove(GROUP + StringConverter::toString(i) + ".dds");
+    OGRE_DELETE mTexMgr;
+    mRoot->getWorkQueue()->shutdown();
+    OGRE_DELETE mRoot;
+    OGRE_DELETE mBufMgr;
+}
+//--------------------------------------------------------------------------
+TexturePtr TextureStreamingTests::loadTexture(const String& name)
+{
+    TexturePtr tex = mTexMgr->load(GROUP + name + ".dds", GROUP);
+    CPPUNIT_ASSERT(tex->isStreaming());
+    CPPUNIT_ASSERT_EQUAL((size_t)3, tex->getStreamingTopMip());
+    return tex;
+}
+//--------------------------------------------------------------------------
+void TextureStreamingTests::renderFrame()
+{
+    mRoot->_fireFrameStarted();
+    mRoot->_fireFrameRenderingQueued();
+    mRoot->_fireFrameEnded();
+}
+//--------------------------------------------------------------------------
+bool TextureStreamingTests::finishStreaming()
+{
+    for (int i = 0; i < 1000; ++i)
+    {
+        if (mTexMgr->getStreamingStatistics().pendingRequests == 0)
+            return true;
+        renderFrame();
+        OGRE_THREAD_SLEEP(1);
+    }
+    return false;
+}
+//--------------------------------------------------------------------------
+void TextureStreamingTests::checkTexels(const TexturePtr& tex)
+{
+    // Texels are numbered through the whole mip chain of the file
+    uint32 first = 0;
+    for (size_t mip = 0; mip < tex->getStreamingTopMip(); ++mip)
+        first += (uint32)((64 >> mip) * (64 >> mip));
+    CPPUNIT_ASSERT_EQUAL((size_t)6 - tex->getStreamingTopMip(), tex->getNumMipmaps());
+    for (size_t mip = 0; mip <= tex->getNumMipmaps(); ++mip)
+    {
+        HardwarePixelBufferSharedPtr buf = tex->getBuffer(0, mip);
+        CPPUNIT_ASSERT_EQUAL((size_t)64 >> (tex->getStreamingTopMip() + mip), buf->getWidth());
+        const size_t count = buf->getWidth() * buf->getHeight();
+        vector<uint32>::type texels(count);
+        buf->blitToMemory(PixelBox(buf->getWidth(), buf->getHeight(), 1, PF_A8R8G8B8, &texels[0]));
+        for (size_t i = 0; i < count; ++i)
+            CPPUNIT_ASSERT_EQUAL(first + (uint32)i, texels[i]);
+        first += (uint32)count;
+    }
+}
+//--------------------------------------------------------------------------
+void TextureStreamingTests::testBudgetClampsRequest()
+{
+    TexturePtr tex = loadTexture("0");
+    CPPUNIT_ASSERT_EQUAL(tex->getStreamingSize(3), mTexMgr->getStreamingStatistics().residentBytes);
+
+    // Only the 16x16 level fits, so that is what is loaded
+    mTexMgr->setStreamingBudget(tex->getStreamingSize(2));
+    mTexMgr->_requestStreamedMip(tex.get(), 0);
+    CPPUNIT_ASSERT(finishStreaming());
+    CPPUNIT_ASSERT_EQUAL((size_t)2, tex->getStreamingTopMip());
+    CPPUNIT_ASSERT_EQUAL((size_t)16, tex->getWidth());
+
+    // Nothing finer fits, so nothing more is requested
+    mTexMgr->_requestStreamedMip(tex.get(), 0);
+    CPPUNIT_ASSERT_EQUAL((size_t)0, mTexMgr->getStreamingStatistics().pendingRequests);
+    CPPUNIT_ASSERT_EQUAL(tex->getStreamingSize(2), mTexMgr->getStreamingStatistics().residentBytes);
+}
+//--------------------------------------------------------------------------
+void TextureStreamingTests::testEvictLeastRecentlyUsed()
+{
+    TexturePtr first = loadTexture("0");
+    TexturePtr second = loadTexture("1");
+    TexturePtr third = loadTexture("2");
+
+    // Room for two of them at 32x32
+    mTexMgr->setStreamingBudget(first->getStreamingSize(1) * 2 + first->getStreamingSize(3));
+    mTexMgr->_requestStreamedMip(first.get(), 1);
+    mTexMgr->_requestStreamedMip(second.get(), 1);
+    CPPUNIT_ASSERT(finishStreaming());
+    CPPUNIT_ASSERT_EQUAL((size_t)1, first->getStreamingTopMip());
+    CPPUNIT_ASSERT_EQUAL((size_t)1, second->getStreamingTopMip());
+
+    // The first one is no longer displayed
+    renderFrame();
+    mTexMgr->_requestStreamedMip(second.get(), 1);
+    renderFrame();
+    mTexMgr->_requestStreamedMip(second.get(), 1);
+
+    // Making room for the third one evicts the first, which has been out of use longest
+    mTexMgr->_requestStreamedMip(third.get(), 1);
+    CPPUNIT_ASSERT_EQUAL((size_t)3, first->getStreamingTopMip());
+    CPPUNIT_ASSERT_EQUAL((size_t)8, first->getWidth());
+    CPPUNIT_ASSERT(finishStreaming());
+    CPPUNIT_ASSERT_EQUAL((size_t)1, second->getStreamingTopMip());
+    CPPUNIT_ASSERT_EQUAL((size_t)1, third->getStreamingTopMip());
+}
+//--------------------------------------------------------------------------
+void TextureStreamingTests::testDropEvictedLoad()
+{
+    // Loads are only done in the background with thread support
+#if OGRE_THREAD_SUPPORT
+    TexturePtr tex = loadTexture("0");
+    mTexMgr->_requestStreamedMip(tex.get(), 0);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, mTexMgr->getStreamingStatistics().pendingRequests);
+
+    // Let the load finish in the background, then evict the texture before its
+    // response is processed; frames pass without processing responses
+    OGRE_THREAD_SLEEP(100);
+    mRoot->_fireFrameRenderingQueued();
+    mRoot->_fireFrameRenderingQueued();
+    mTexMgr->setStreamingBudget(0);
+    CPPUNIT_ASSERT_EQUAL((size_t)0, mTexMgr->getStreamingStatistics().pendingRequests);
+
+    // The response is dropped and hands back its staging memory
+    for (int i = 0; i < 10; ++i)
+    {
+        renderFrame();
+        OGRE_THREAD_SLEEP(10);
+    }
+    CPPUNIT_ASSERT_EQUAL((size_t)3, tex->getStreamingTopMip());
+    CPPUNIT_ASSERT_EQUAL((size_t)8, tex->getWidth());
+    void* whole = mBufMgr->reserveUploadStaging(mBufMgr->getUploadStagingSize());
+    CPPUNIT_ASSERT(whole);
+    mBufMgr->releaseUploadStaging(whole);
+#endif
+}
+//--------------------------------------------------------------------------
+void TextureStreamingTests::testStreamedLevelsMatchFile()
+{
+    TexturePtr tex = loadTexture("0");
+    checkTexels(tex);
+
+    // The new levels are read from the file, the resident ones copied over
+    mTexMgr->_requestStreamedMip(tex.get(), 2);
+    CPPUNIT_ASSERT(finishStreaming());
+    CPPUNIT_ASSERT_EQUAL((size_t)2, tex->getStreamingTopMip());
+    checkTexels(tex);
+
+    mTexMgr->_requestStreamedMip(tex.get(), 0);
+    CPPUNIT_ASSERT(finishStreaming());
+    CPPUNIT_ASSERT_EQUAL((size_t)0, tex->getStreamingTopMip());
+    checkTexels(tex);
+}
@@ -0,0 +1,204 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "VertexCacheOptimiseTests.h"
+#include "OgreDefaultHardwareBufferManager.h"
+
+// Register the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( VertexCacheOptimiseTests );
+
+void VertexCacheOptimiseTests::setUp()
+{
+    mBufMgr = OGRE_NEW DefaultHardwareBufferManager();
+}
+void VertexCacheOptimiseTests::tearDown()
+{
+    OGRE_DELETE mBufMgr;
+}
+
+void VertexCacheOptimiseTests::createGrid(IndexData& indexData, size_t quads, bool shuffle,
+    HardwareIndexBuffer::IndexType type, size_t padding)
+{
+    const size_t rowVertices = quads + 1;
+    vector<uint32>::type indexes;
+    for (size_t y = 0; y < quads; ++y)
+    {
+        for (size_t x = 0; x < quads; ++x)
+        {
+            const uint32 v = static_cast<uint32>(y * rowVertices + x);
+            const uint32 quad[6] = { v, v + 1, v + rowVertices, v + 1, v + rowVertices + 1, v + rowVertices };
+            indexes.insert(indexes.end(), quad, quad + 6);
+        }
+    }
+    if (shuffle)
+    {
+        // Fixed linear congruential generator, so the test doesn't depend on rand()
+        uint32 seed = 12345;
+        for (size_t t = indexes.size() / 3 - 1; t > 0; --t)
+        {
+            seed = seed * 1103515245 + 12345;
+            const size_t other = (seed >> 8) % (t + 1);
+            for (size_t c = 0; c < 3; ++c)
+                std::swap(indexes[t * 3 + c], indexes[other * 3 + c]);
+        }
+    }
+
+    indexData.indexStart = padding;
+    indexData.indexCount = indexes.size();
+    indexData.indexBuffer = HardwareBufferManager::getSingleton().createIndexBuffer(
+        type, indexes.size() + padding * 2, HardwareBuffer::HBU_STATIC, true);
+    void* buffer = indexData.indexBuffer->lock(HardwareBuffer::HBL_DISCARD);
+    for (size_t i = 0; i < indexes.size() + padding * 2; ++i)
+    {
+        const uint32 index = (i < padding || i >= padding + indexes.size()) ? 0 : indexes[i - padding];
+        if (type == HardwareIndexBuffer::IT_32BIT)
+            static_cast<uint32*>(buffer)[i] = index;
+        else
+            static_cast<uint16*>(buffer)[i] = static_cast<uint16>(index);
+    }
+    indexData.indexBuffer->unlock();
+}
+
+vector<uint32>::type VertexCacheOptimiseTests::readIndexes(const IndexData& indexData)
+{
+    const HardwareIndexBufferSharedPtr& ibuf = indexData.indexBuffer;
+    vector<uint32>::type indexes(indexData.indexCount);
+    const void* buffer = ibuf->lock(indexData.indexStart * ibuf->getIndexSize(),
+        indexData.indexCount * ibuf->getIndexSize(), HardwareBuffer::HBL_READ_ONLY);
+    for (size_t i = 0; i < indexData.indexCount; ++i)
+    {
+        indexes[i] = ibuf->getType() == HardwareIndexBuffer::IT_32BIT ?
+            static_cast<const uint32*>(buffer)[i] : static_cast<const uint16*>(buffer)[i];
+    }
+    ibuf->unlock();
+    return indexes;
+}
+
+VertexCacheOptimiseTests::TriangleList VertexCacheOptimiseTests::getTriangles(const IndexData& indexData)
+{
+    const vector<uint32>::type indexes = readIndexes(indexData);
+    TriangleList triangles;
+    for (size_t t = 0; t + 2 < indexes.size(); t += 3)
+    {
+        Triangle triangle(indexes.begin() + t, indexes.begin() + t + 3);
+        std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+        triangles.push_back(triangle);
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+Real VertexCacheOptimiseTests::getACMR(const IndexData& indexData)
+{
+    VertexCacheProfiler profiler(16, VertexCacheProfiler::FIFO);
+    profiler.profile(&indexData);
+    return profiler.getACMR(indexData.indexCount / 3);
+}
+
+void VertexCacheOptimiseTests::testShuffledGrid()
+{
+    // Random triangle order is the worst case for the cache, the optimiser has to win clearly
+    IndexData indexData;
+    createGrid(indexData, 40, true, HardwareIndexBuffer::IT_16BIT, 6);
+    const TriangleList before = getTriangles(indexData);
+    const Real acmrBefore = getACMR(indexData);
+
+    indexData.optimiseVertexCacheTriList();
+
+    CPPUNIT_ASSERT(getTriangles(indexData) == before);
+    const Real acmrAfter = getACMR(indexData);
+    CPPUNIT_ASSERT(acmrAfter < acmrBefore);
+    CPPUNIT_ASSERT(acmrAfter < (Real)1.0);
+
+    // Only the used range may be touched
+    const uint16* buffer = static_cast<const uint16*>(indexData.indexBuffer->lock(HardwareBuffer::HBL_READ_ONLY));
+    for (size_t i = 0; i < 6; ++i)
+    {
+        CPPUNIT_ASSERT_EQUAL((uint16)0, buffer[i]);
+        CPPUNIT_ASSERT_EQUAL((uint16)0, buffer[indexData.indexStart + indexData.indexCount + i]);
+    }
+    indexData.indexBuffer->unlock();
+}
+
+void VertexCacheOptimiseTests::testOrderedGrid()
+{
+    // Row order is already reasonable, the optimiser must not make it worse
+    IndexData indexData;
+    createGrid(indexData, 40, false, HardwareIndexBuffer::IT_32BIT, 0);
+    const TriangleList before = getTriangles(indexData);
+    const Real acmrBefore = getACMR(indexData);
+
+    indexData.optimiseVertexCacheTriList();
+
+    CPPUNIT_ASSERT(getTriangles(indexData) == before);
+    CPPUNIT_ASSERT(getACMR(indexData) <= acmrBefore);
+}
+
+void VertexCacheOptimiseTests::testVertexFetch()
+{
+    const size_t quads = 8;
+    const size_t vertexCount = (quads + 1) * (quads + 1);
+    VertexData vertexData;
+    vertexData.vertexCount = vertexCount;
+    vertexData.vertexDeclaration->addElement(0, 0, VET_FLOAT3, VES_POSITION);
+    HardwareVertexBufferSharedPtr vbuf = HardwareBufferManager::getSingleton().createVertexBuffer(
+        sizeof(float) * 3, vertexCount, HardwareBuffer::HBU_STATIC, true);
+    vertexData.vertexBufferBinding->setBinding(0, vbuf);
+    float* pFloat = static_cast<float*>(vbuf->lock(HardwareBuffer::HBL_DISCARD));
+    for (size_t v = 0; v < vertexCount; ++v)
+    {
+        *pFloat++ = (float)(v % (quads + 1));
+        *pFloat++ = (float)(v / (quads + 1));
+        *pFloat++ = (float)v;
+    }
+    vbuf->unlock();
+
+    IndexData indexData;
+    createGrid(indexData, quads, true, HardwareIndexBuffer::IT_16BIT, 0);
+    const vector<uint32>::type indexesBefore = readIndexes(indexData);
+
+    vector<IndexData*>::type indexDataList;
+    indexDataList.push_back(&indexData);
+    vector<uint32>::type remap;
+    vertexData.optimiseVertexFetch(indexDataList, remap);
+
+    // Vertices are numbered by first use and still hold the same data
+    const vector<uint32>::type indexesAfter = readIndexes(indexData);
+    CPPUNIT_ASSERT_EQUAL(indexesBefore.size(), indexesAfter.size());
+    const float* positions = static_cast<const float*>(vbuf->lock(HardwareBuffer::HBL_READ_ONLY));
+    uint32 nextVertex = 0;
+    for (size_t i = 0; i < indexesAfter.size(); ++i)
+    {
+        CPPUNIT_ASSERT_EQUAL(remap[indexesBefore[i]], indexesAfter[i]);
+        CPPUNIT_ASSERT(indexesAfter[i] <= nextVertex);
+        if (indexesAfter[i] == nextVertex)
+            ++nextVertex;
+        CPPUNIT_ASSERT_EQUAL((float)indexesBefore[i], positions[indexesAfter[i] * 3 + 2]);
+    }
+    vbuf->unlock();
+    CPPUNIT_ASSERT_EQUAL((uint32)vertexCount, nextVertex);
+}
@@ -66,8 +66,13 @@ void help(void)
 	cout << "-srcgl     = Interpret ambiguous colours as GL style" << endl;
 	cout << "-E endian  = Set endian mode 'big' 'little' or 'native' (default)" << endl;
 	cout << "-b         = Recalculate bounding box (static meshes only)" << endl;
+	cout << "-o         = Optimise triangle and vertex order for the vertex cache" << endl;
+	cout << "-c         = Build triangle clusters for per-cluster culling" << endl;
+	cout << "-q         = Quantise normals, tangents and texture coordinates" << endl;
+	cout << "-qp        = As -q, plus positions where the loaded materials apply the" << endl;
+	cout << "             scale / bias in a vertex program; they stay float otherwise" << endl;
 	cout << "-V version = Specify OGRE version format to write instead of latest" << endl;
-	cout << "             Options are: 1.8, 1.7, 1.4, 1.0" << endl;
+	cout << "             Options are: 1.10, 1.8, 1.7, 1.4, 1.0" << endl;
     cout << "sourcefile = name of file to convert" << endl;
     cout << "destfile   = optional name of file to write to. If you don't" << endl;
     cout << "             specify this OGRE overwrites the existing file." << endl;
@@ -96,6 +101,10 @@ struct UpgradeOptions
 	bool usePercent;
 	Serializer::Endian endian;
 	bool recalcBounds;
+	bool optimiseVertexCache;
+	bool buildClusters;
+	bool quantiseVertices;
+	bool quantisePositions;
 	MeshVersion targetVersion;
 
 };
@@ -136,6 +145,10 @@ void parseOpts(UnaryOptionList& unOpts, BinaryOptionList& binOpts)
 	opts.numLods = 0;
 	opts.usePercent = true;
 	opts.recalcBounds = false;
+	opts.optimiseVertexCache = false;
+	opts.buildClusters = false;
+	opts.quantiseVertices = false;
+	opts.quantisePositions = false;
 	opts.targetVersion = MESH_VERSION_LATEST;
 
 
@@ -176,6 +189,18 @@ void parseOpts(UnaryOptionList& unOpts, BinaryOptionList& binOpts)
 		opts.srcColourFormatSet = true;
 		opts.srcColourFormat = VET_COLOUR_ABGR;
 	}
+	ui = unOpts.find("-o");
+	opts.optimiseVertexCache = ui->second;
+	ui = unOpts.find("-c");
+	opts.buildClusters = ui->second;
+	ui = unOpts.find("-q");
+	opts.quantiseVertices = ui->second;
+	ui = unOpts.find("-qp");
+	if (ui->second)
+	{
+		opts.quantiseVertices = true;
+		opts.quantisePositions = true;
+	}
 	ui = unOpts.find("-b");
 	if (ui->second)
 	{
@@ -238,7 +263,9 @@ void parseOpts(UnaryOptionList& unOpts, BinaryOptionList& binOpts)
 	bi = binOpts.find("-V");
 	if (!bi->second.empty())
 	{
-		if (bi->second == "1.8")
+		if (bi->second == "1.10")
+			opts.targetVersion = MESH_VERSION_1_10;
+		else if (bi->second == "1.8")
 			opts.targetVersion = MESH_VERSION_1_8;
 		else if (bi->second == "1.7")
 			opts.targetVersion = MESH_VERSION_1_7;
@@ -920,6 +947,31 @@ void recalcBounds(Mesh* mesh)
 	mesh->_setBoundingSphereRadius(radius);
 }
 
+void printVertexCacheStats(Mesh* mesh)
+{
+	VertexCacheProfiler profiler;
+	size_t triangles = 0, vertices = 0;
+
+	if (mesh->sharedVertexData)
+		vertices += mesh->sharedVertexData->vertexCount;
+	for (unsigned short i = 0; i < mesh->getNumSubMeshes(); ++i)
+	{
+		SubMesh* sm = mesh->getSubMesh(i);
+		if (!sm->useSharedVertices)
+			vertices += sm->vertexData->vertexCount;
+		if (sm->operationType == RenderOperation::OT_TRIANGLE_LIST)
+		{
+			// Every submesh starts off with a cold cache, like a separate draw call
+			profiler.flush();
+			profiler.profile(sm->indexData);
+			triangles += sm->indexData->indexCount / 3;
+		}
+	}
+
+	cout << "  ACMR " << profiler.getACMR(triangles) <<
+		", ATVR " << profiler.getATVR(vertices) << std::endl;
+}
+
 int main(int numargs, char** args)
 {
     if (numargs < 2)
@@ -961,6 +1013,10 @@ int main(int numargs, char** args)
 		unOptList["-srcgl"] = false;
 		unOptList["-srcd3d"] = false;
 		unOptList["-b"] = false;
+		unOptList["-o"] = false;
+		unOptList["-c"] = false;
+		unOptList["-q"] = false;
+		unOptList["-qp"] = false;
 		binOptList["-l"] = "";
 		binOptList["-d"] = "";
 		binOptList["-p"] = "";
@@ -1073,9 +1129,35 @@ int main(int numargs, char** args)
 		}
 
 
+		if (opts.optimiseVertexCache)
+		{
+			cout << "Optimising for the vertex cache...." << std::endl;
+			printVertexCacheStats(&mesh);
+			mesh.optimiseVertexCache();
+			printVertexCacheStats(&mesh);
+		}
+
+		if (opts.buildClusters)
+		{
+			cout << "Building triangle clusters...." << std::endl;
+			for (unsigned short i = 0; i < mesh.getNumSubMeshes(); ++i)
+				mesh.getSubMesh(i)->buildClusters();
+		}
+
 		if (opts.recalcBounds)
 			recalcBounds(&mesh);
 
+		// Last, everything above reads float vertex data
+		if (opts.quantiseVertices)
+		{
+			cout << "Quantising vertex data...." << std::endl;
+			if (!mesh.quantiseVertexData(opts.quantisePositions))
+			{
+				cout << "Nothing to quantise, skeletal, pose and morph animated "
+					"meshes keep their formats." << std::endl;
+			}
+		}
+
 		meshSerializer->exportMesh(&mesh, dest, opts.targetVersion, opts.endian);
     
 	}
@@ -0,0 +1,132 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "Ogre.h"
+
+#include <iostream>
+
+using namespace std;
+using namespace Ogre;
+
+void help(void)
+{
+    // Print help message
+    cout << endl << "OgreMipmapBenchmark: Times Image::generateMipmaps on large textures." << endl << endl;
+    cout << "Usage: OgreMipmapBenchmark [opts] [size...]" << endl;
+    cout << "-f format      = Pixel format name (default PF_A8R8G8B8)" << endl;
+    cout << "-r repeats     = Number of runs per case, the best one is reported (default 3)" << endl;
+    cout << "size           = Width and height of the top level (default 4096 8192)" << endl;
+
+    cout << endl;
+}
+
+void benchmarkMipmaps(size_t size, PixelFormat format, Image::Filter filter, bool gammaCorrect, size_t repeats)
+{
+    size_t bytes = PixelUtil::getMemorySize(size, size, 1, format);
+    uchar* data = OGRE_ALLOC_T(uchar, bytes, MEMCATEGORY_GENERAL);
+    // Some noise so the filters cannot take any shortcuts
+    uint32 seed = 12345;
+    for (size_t i = 0; i < bytes; ++i)
+    {
+        seed = seed * 1664525 + 1013904223;
+        data[i] = static_cast<uchar>(seed >> 24);
+    }
+
+    unsigned long best = 0;
+    for (size_t run = 0; run < repeats; ++run)
+    {
+        Image img;
+        img.loadDynamicImage(data, size, size, 1, format);
+        Timer timer;
+        if (!img.generateMipmaps(100, filter, gammaCorrect))
+        {
+            cout << "Mipmaps cannot be generated for " << PixelUtil::getFormatName(format) << endl;
+            break;
+        }
+        unsigned long time = timer.getMicroseconds();
+        if (!run || time < best)
+            best = time;
+    }
+    OGRE_FREE(data, MEMCATEGORY_GENERAL);
+
+    cout << size << "x" << size << " " << PixelUtil::getFormatName(format) << " "
+        << (filter == Image::FILTER_KAISER ? "kaiser" : "box") << (gammaCorrect ? " gamma" : "")
+        << ": " << best / 1000.0 << " ms" << endl;
+}
+
+int main(int numargs, char** args)
+{
+	int retCode = 0;
+    LogManager* logMgr = 0;
+	try 
+	{
+		logMgr = new LogManager();
+		logMgr->createLog("OgreMipmapBenchmark.log", true, false);
+
+		UnaryOptionList unOptList;
+		BinaryOptionList binOptList;
+
+		binOptList["-f"] = "PF_A8R8G8B8";
+		binOptList["-r"] = "3";
+
+		int startIdx = findCommandLineOpts(numargs, args, unOptList, binOptList);
+		PixelFormat format = PixelUtil::getFormatFromName(binOptList["-f"]);
+		if (format == PF_UNKNOWN)
+		{
+			help();
+			delete logMgr;
+			return -1;
+		}
+		size_t repeats = std::max(1u, StringConverter::parseUnsignedInt(binOptList["-r"], 3));
+
+		Ogre::vector<size_t>::type sizes;
+		for (int i = startIdx; i < numargs; ++i)
+			sizes.push_back(StringConverter::parseUnsignedInt(args[i]));
+		if (sizes.empty())
+		{
+			sizes.push_back(4096);
+			sizes.push_back(8192);
+		}
+
+		for (size_t i = 0; i < sizes.size(); ++i)
+		{
+			benchmarkMipmaps(sizes[i], format, Image::FILTER_BOX, false, repeats);
+			benchmarkMipmaps(sizes[i], format, Image::FILTER_BOX, true, repeats);
+			benchmarkMipmaps(sizes[i], format, Image::FILTER_KAISER, false, repeats);
+		}
+	}
+	catch (Exception& e)
+	{
+		cout << "Exception caught: " << e.getDescription() << endl;
+		retCode = 1;
+	}
+
+	delete logMgr;
+
+	return retCode;
+}
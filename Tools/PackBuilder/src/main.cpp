@@ -0,0 +1,180 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+
+#include "Ogre.h"
+#include "OgrePackArchive.h"
+#include "OgreFileSystem.h"
+#if OGRE_NO_ZIP_ARCHIVE == 0
+#include "OgreZip.h"
+#endif
+
+#include <iostream>
+
+using namespace std;
+using namespace Ogre;
+
+void help(void)
+{
+    // Print help message
+    cout << endl << "OgrePackBuilder: Builds pack files for the 'Pack' archive type." << endl << endl;
+    cout << "Usage: OgrePackBuilder [opts] sourcedir packfile" << endl;
+    cout << "       OgrePackBuilder -b packfile [zipfile]" << endl;
+    cout << "-u             = Store all files uncompressed" << endl;
+    cout << "-a alignment   = Alignment of uncompressed files (default 4096)" << endl;
+    cout << "-b             = Benchmark loading, listing and reading every file" << endl;
+    cout << "                 of a pack, and of a zip with the same files if given" << endl;
+    cout << "sourcedir      = directory holding the files to pack, recursively" << endl;
+    cout << "packfile       = name of the pack file to write" << endl;
+
+    cout << endl;
+}
+
+void buildPack(const String& sourceDir, const String& packFile, bool compress, uint32 alignment)
+{
+    FileSystemArchive source(sourceDir, "FileSystem", true);
+    source.load();
+    FileInfoListPtr files = source.listFileInfo(true);
+
+    PackArchiveWriter writer(packFile, alignment);
+    size_t totalSize = 0;
+    for (FileInfoList::iterator i = files->begin(); i != files->end(); ++i)
+    {
+        writer.addFile(i->filename, source.open(i->filename), 
+            source.getModifiedTime(i->filename), compress);
+        totalSize += i->uncompressedSize;
+    }
+    writer.finish();
+
+    cout << "Packed " << writer.getFileCount() << " files, " << totalSize << " bytes, into "
+        << packFile << endl;
+}
+
+void benchmarkArchive(Archive& arch)
+{
+    Timer timer;
+
+    arch.load();
+    unsigned long loadTime = timer.getMicroseconds();
+
+    timer.reset();
+    StringVectorPtr files = arch.list(true);
+    unsigned long listTime = timer.getMicroseconds();
+
+    timer.reset();
+    size_t bytes = 0;
+    uchar buffer[16384];
+    for (StringVector::iterator i = files->begin(); i != files->end(); ++i)
+    {
+        DataStreamPtr stream = arch.open(*i);
+        while (!stream->eof())
+        {
+            size_t count = stream->read(buffer, sizeof(buffer));
+            if (!count)
+                break;
+            bytes += count;
+        }
+    }
+    unsigned long readTime = timer.getMicroseconds();
+    arch.unload();
+
+    double mb = bytes / (1024.0 * 1024.0);
+    cout << arch.getType() << " " << arch.getName() << ": " << files->size() << " files, "
+        << bytes << " bytes" << endl;
+    cout << "  load " << loadTime / 1000.0 << " ms, list " << listTime / 1000.0 << " ms, read "
+        << readTime / 1000.0 << " ms (" << (readTime ? mb / (readTime / 1000000.0) : 0.0) << " MB/s)" << endl;
+}
+
+int main(int numargs, char** args)
+{
+    if (numargs < 3)
+    {
+        help();
+        return -1;
+    }
+
+	int retCode = 0;
+    LogManager* logMgr = 0;
+	try 
+	{
+		logMgr = new LogManager();
+		logMgr->createLog("OgrePackBuilder.log", true, false);
+
+		UnaryOptionList unOptList;
+		BinaryOptionList binOptList;
+
+		unOptList["-u"] = false;
+		unOptList["-b"] = false;
+		binOptList["-a"] = "";
+
+		int startIdx = findCommandLineOpts(numargs, args, unOptList, binOptList);
+		if (startIdx >= numargs)
+		{
+			help();
+			delete logMgr;
+			return -1;
+		}
+
+		if (unOptList["-b"])
+		{
+			PackArchive pack(args[startIdx], "Pack");
+			benchmarkArchive(pack);
+			if (startIdx + 1 < numargs)
+			{
+#if OGRE_NO_ZIP_ARCHIVE == 0
+				ZipArchive zip(args[startIdx + 1], "Zip");
+				benchmarkArchive(zip);
+#else
+				cout << "Zip archives are not supported by this build" << endl;
+#endif
+			}
+		}
+		else
+		{
+			if (startIdx + 1 >= numargs)
+			{
+				help();
+				delete logMgr;
+				return -1;
+			}
+			uint32 alignment = 4096;
+			if (!binOptList["-a"].empty())
+				alignment = StringConverter::parseUnsignedInt(binOptList["-a"], 4096);
+			buildPack(args[startIdx], args[startIdx + 1], !unOptList["-u"], alignment);
+		}
+	}
+	catch (Exception& e)
+	{
+		cout << "Exception caught: " << e.getDescription() << endl;
+		retCode = 1;
+	}
+
+	delete logMgr;
+
+	return retCode;
+}
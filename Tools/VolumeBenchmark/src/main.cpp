@@ -0,0 +1,153 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "Ogre.h"
+#include "OgreParallelFor.h"
+#include "OgreVolumeCSGSource.h"
+#include "OgreVolumeOctreeNode.h"
+#include "OgreVolumeOctreeNodeSplitPolicy.h"
+
+#include <iostream>
+
+using namespace std;
+using namespace Ogre;
+using namespace Ogre::Volume;
+
+void help(void)
+{
+    // Print help message
+    cout << endl << "OgreVolumeBenchmark: Times OctreeNode::splitParallel on a large CSG scene." << endl << endl;
+    cout << "Usage: OgreVolumeBenchmark [opts] [size...]" << endl;
+    cout << "-c cellsize    = Maximum size of the finest cells (default 2)" << endl;
+    cout << "-e error       = Geometric error of the split (default 2)" << endl;
+    cout << "-r repeats     = Number of runs per case, the best one is reported (default 3)" << endl;
+    cout << "-t threads     = Number of threads of the parallel case (default hardware threads)" << endl;
+    cout << "size           = Edge length of the volume (default 512)" << endl;
+
+    cout << endl;
+}
+
+size_t countNodes(const OctreeNode *node)
+{
+    if (!node->isSubdivided())
+        return 1;
+    size_t count = 1;
+    for (size_t i = 0; i < OctreeNode::OCTREE_CHILDREN_COUNT; ++i)
+        count += countNodes(node->getChild(i));
+    return count;
+}
+
+void benchmarkSplit(Real size, const Source *src, Real cellSize, Real error, size_t threadCount, size_t repeats)
+{
+    OctreeNodeSplitPolicy policy(src, cellSize);
+    unsigned long best = 0;
+    size_t nodes = 0;
+    for (size_t run = 0; run < repeats; ++run)
+    {
+        OctreeNode root(Vector3::ZERO, Vector3(size));
+        Timer timer;
+        root.splitParallel(&policy, src, error, threadCount);
+        unsigned long time = timer.getMicroseconds();
+        if (!run || time < best)
+            best = time;
+        nodes = countNodes(&root);
+    }
+
+    cout << size << "^3 " << threadCount << (threadCount == 1 ? " thread" : " threads")
+        << ", " << nodes << " nodes: " << best / 1000.0 << " ms" << endl;
+}
+
+void benchmarkScene(Real size, Real cellSize, Real error, size_t threadCount, size_t repeats)
+{
+    // A noisy sphere with a cube cut out of it and a smaller sphere added, so the
+    // surface and the empty space are spread unevenly over the octree
+    const Vector3 center(size / (Real)2.0);
+    CSGSphereSource sphere(size * (Real)0.4, center);
+    CSGCubeSource cube(center, Vector3(size));
+    CSGSphereSource moon(size * (Real)0.15, Vector3(size * (Real)0.2));
+    Real frequencies[] = {(Real)1.01, (Real)0.48, (Real)0.06};
+    Real amplitudes[] = {(Real)0.25, (Real)0.5, (Real)6.0};
+    CSGNoiseSource noise(&sphere, frequencies, amplitudes, 3, 42);
+    CSGDifferenceSource difference(&noise, &cube);
+    CSGUnionSource scene(&difference, &moon);
+
+    benchmarkSplit(size, &scene, cellSize, error, 1, repeats);
+    if (threadCount > 1)
+        benchmarkSplit(size, &scene, cellSize, error, threadCount, repeats);
+}
+
+int main(int numargs, char** args)
+{
+	int retCode = 0;
+    LogManager* logMgr = 0;
+	try 
+	{
+		logMgr = new LogManager();
+		logMgr->createLog("OgreVolumeBenchmark.log", true, false);
+
+		UnaryOptionList unOptList;
+		BinaryOptionList binOptList;
+
+		binOptList["-c"] = "2";
+		binOptList["-e"] = "2";
+		binOptList["-r"] = "3";
+		binOptList["-t"] = StringConverter::toString(ParallelFor::getHardwareThreadCount());
+
+		int startIdx = findCommandLineOpts(numargs, args, unOptList, binOptList);
+		Real cellSize = StringConverter::parseReal(binOptList["-c"]);
+		if (cellSize <= (Real)0.0)
+		{
+			help();
+			delete logMgr;
+			return -1;
+		}
+		Real error = StringConverter::parseReal(binOptList["-e"]);
+		size_t repeats = std::max(1u, StringConverter::parseUnsignedInt(binOptList["-r"], 3));
+		size_t threadCount = std::max(1u, StringConverter::parseUnsignedInt(binOptList["-t"], 1));
+
+		Ogre::vector<Real>::type sizes;
+		for (int i = startIdx; i < numargs; ++i)
+			sizes.push_back(StringConverter::parseReal(args[i]));
+		if (sizes.empty())
+			sizes.push_back((Real)512.0);
+
+		for (size_t i = 0; i < sizes.size(); ++i)
+		{
+			benchmarkScene(sizes[i], cellSize, error, threadCount, repeats);
+		}
+	}
+	catch (Exception& e)
+	{
+		cout << "Exception caught: " << e.getDescription() << endl;
+		retCode = 1;
+	}
+
+	delete logMgr;
+
+	return retCode;
+}